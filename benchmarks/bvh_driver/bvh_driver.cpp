@@ -11,6 +11,8 @@
 
 #include <ArborXBenchmark_PointClouds.hpp>
 #include <ArborX_BoostRTreeHelpers.hpp>
+#include <ArborX_DetailsLegacy.hpp>
+#include <ArborX_KDOP.hpp>
 #include <ArborX_LinearBVH.hpp>
 #include <ArborX_Version.hpp>
 
@@ -35,6 +37,70 @@ struct BenchmarkRegistration
   BenchmarkRegistration(Spec const &, std::string const &) {}
 };
 
+// Adapter giving a hierarchy with a non-default bounding volume the same
+// points-in/indices-out interface as ArborX::BVH, so that it can reuse the
+// registration helpers
+template <typename MemorySpace, typename BoundingVolume>
+class BVHWithVolume
+    : public ArborX::BoundingVolumeHierarchy<
+          MemorySpace, ArborX::PairValueIndex<BoundingVolume>,
+          ArborX::Details::DefaultIndexableGetter, BoundingVolume>
+{
+  using Base = ArborX::BoundingVolumeHierarchy<
+      MemorySpace, ArborX::PairValueIndex<BoundingVolume>,
+      ArborX::Details::DefaultIndexableGetter, BoundingVolume>;
+
+public:
+  BVHWithVolume() = default;
+
+  template <typename ExecutionSpace, typename Primitives>
+  BVHWithVolume(ExecutionSpace const &space, Primitives const &primitives)
+      : Base(space,
+             ArborX::Details::LegacyValues<Primitives, BoundingVolume>{
+                 primitives})
+  {}
+
+  template <typename ExecutionSpace, typename Predicates, typename Callback,
+            typename... Args>
+  std::enable_if_t<!Kokkos::is_view_v<std::decay_t<Callback>>>
+  query(ExecutionSpace const &space, Predicates const &predicates,
+        Callback const &callback, Args &&...args) const
+  {
+    Base::query(space, predicates,
+                ArborX::Details::LegacyCallbackWrapper<Callback>{callback},
+                std::forward<Args>(args)...);
+  }
+
+  template <typename ExecutionSpace, typename Predicates, typename View,
+            typename... Args>
+  std::enable_if_t<Kokkos::is_view_v<std::decay_t<View>>>
+  query(ExecutionSpace const &space, Predicates const &predicates, View &&view,
+        Args &&...args) const
+  {
+    Base::query(space, predicates, ArborX::Details::LegacyDefaultCallback{},
+                std::forward<View>(view), std::forward<Args>(args)...);
+  }
+};
+
+// The discrete orientation polytopes do not define a distance, so only the
+// construction and the spatial queries are registered
+template <typename ExecutionSpace, typename MemorySpace,
+          typename BoundingVolume>
+struct BenchmarkRegistration<ExecutionSpace,
+                             BVHWithVolume<MemorySpace, BoundingVolume>>
+{
+  using TreeType = BVHWithVolume<MemorySpace, BoundingVolume>;
+  BenchmarkRegistration(Spec const &spec, std::string const &description)
+  {
+    register_benchmark_construction<ExecutionSpace, TreeType>(spec,
+                                                              description);
+    register_benchmark_spatial_query_no_callback<ExecutionSpace, TreeType>(
+        spec, description);
+    register_benchmark_spatial_query_callback<ExecutionSpace, TreeType>(
+        spec, description);
+  }
+};
+
 template <typename ExecutionSpace, typename MemorySpace>
 struct BenchmarkRegistration<ExecutionSpace, ArborX::BVH<MemorySpace>>
 {
@@ -134,6 +200,61 @@ void register_bvh_benchmarks(Spec const &spec)
 #endif
 }
 
+template <typename ExecutionSpace>
+void register_kdop_benchmarks_for_backend(Spec const &spec,
+                                          std::string const &backend_name)
+{
+  using MemorySpace = typename ExecutionSpace::memory_space;
+  using KDOP14 = ArborX::Experimental::KDOP<3, 14>;
+  using KDOP18 = ArborX::Experimental::KDOP<3, 18>;
+  BenchmarkRegistration<ExecutionSpace, BVHWithVolume<MemorySpace, KDOP14>>(
+      spec, "ArborX::BVH<" + backend_name + ", KDOP14>");
+  BenchmarkRegistration<ExecutionSpace, BVHWithVolume<MemorySpace, KDOP18>>(
+      spec, "ArborX::BVH<" + backend_name + ", KDOP18>");
+}
+
+// Compare boxes against 14- and 18-DOPs on the same workloads: the box
+// numbers come from register_bvh_benchmarks
+void register_kdop_benchmarks(Spec const &spec)
+{
+#ifdef KOKKOS_ENABLE_SERIAL
+  if (spec.backends == "all" || spec.backends == "serial")
+    register_kdop_benchmarks_for_backend<Kokkos::Serial>(spec, "Serial");
+#endif
+
+#ifdef KOKKOS_ENABLE_OPENMP
+  if (spec.backends == "all" || spec.backends == "openmp")
+    register_kdop_benchmarks_for_backend<Kokkos::OpenMP>(spec, "OpenMP");
+#endif
+
+#ifdef KOKKOS_ENABLE_THREADS
+  if (spec.backends == "all" || spec.backends == "threads")
+    register_kdop_benchmarks_for_backend<Kokkos::Threads>(spec, "Threads");
+#endif
+
+#ifdef KOKKOS_ENABLE_CUDA
+  if (spec.backends == "all" || spec.backends == "cuda")
+    register_kdop_benchmarks_for_backend<Kokkos::Cuda>(spec, "Cuda");
+#endif
+
+#ifdef KOKKOS_ENABLE_HIP
+  if (spec.backends == "all" || spec.backends == "hip")
+    register_kdop_benchmarks_for_backend<Kokkos::HIP>(spec, "HIP");
+#endif
+
+#ifdef KOKKOS_ENABLE_OPENMPTARGET
+  if (spec.backends == "all" || spec.backends == "openmptarget")
+    register_kdop_benchmarks_for_backend<Kokkos::Experimental::OpenMPTarget>(
+        spec, "OpenMPTarget");
+#endif
+
+#ifdef KOKKOS_ENABLE_SYCL
+  if (spec.backends == "all" || spec.backends == "sycl")
+    register_kdop_benchmarks_for_backend<Kokkos::Experimental::SYCL>(spec,
+                                                                     "SYCL");
+#endif
+}
+
 void register_boostrtree_benchmarks(Spec const &spec)
 {
 #ifdef KOKKOS_ENABLE_SERIAL
@@ -286,6 +407,7 @@ int main(int argc, char *argv[])
   for (auto const &spec : specs)
   {
     register_bvh_benchmarks(spec);
+    register_kdop_benchmarks(spec);
     register_boostrtree_benchmarks(spec);
   }
 
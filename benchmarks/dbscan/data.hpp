@@ -19,8 +19,64 @@
 #include <random>
 #include <vector>
 
+#if defined(__unix__) || defined(__APPLE__)
+#define ARBORX_BENCHMARK_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 using ArborX::ExperimentalHyperGeometry::Point;
 
+#ifdef ARBORX_BENCHMARK_HAS_MMAP
+// Read-only memory mapping of a data file. Pages are faulted in lazily by the
+// kernel as they are accessed, and already consumed ranges can be dropped, so
+// walking the mapping front to back works for files larger than host memory.
+struct MappedFile
+{
+  unsigned char const *_data = nullptr;
+  std::size_t _size = 0;
+
+  explicit MappedFile(std::string const &filename)
+  {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    ARBORX_ASSERT(fd >= 0);
+
+    struct stat file_status;
+    int rv = ::fstat(fd, &file_status);
+    ARBORX_ASSERT(rv == 0);
+    _size = file_status.st_size;
+
+    void *map = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    ARBORX_ASSERT(map != MAP_FAILED);
+    _data = static_cast<unsigned char const *>(map);
+
+    // The loaders walk the file front to back exactly once
+    ::madvise(const_cast<unsigned char *>(_data), _size, MADV_SEQUENTIAL);
+  }
+
+  MappedFile(MappedFile const &) = delete;
+  MappedFile &operator=(MappedFile const &) = delete;
+
+  ~MappedFile() { ::munmap(const_cast<unsigned char *>(_data), _size); }
+
+  // Tell the kernel a consumed byte range is not needed anymore so that its
+  // pages can be reclaimed. madvise() only accepts page-aligned addresses,
+  // so shrink the range to the fully covered pages.
+  void release(std::size_t offset, std::size_t length) const
+  {
+    std::size_t const page_size = ::sysconf(_SC_PAGESIZE);
+    auto begin = (offset + page_size - 1) / page_size * page_size;
+    auto end = (offset + length) / page_size * page_size;
+    if (begin < end)
+      ::madvise(const_cast<unsigned char *>(_data) + begin, end - begin,
+                MADV_DONTNEED);
+  }
+};
+#endif
+
 template <int DIM>
 std::vector<Point<DIM>> sampleData(std::vector<Point<DIM>> const &data,
                                    int num_samples)
@@ -81,7 +81,10 @@ int main(int argc, char *argv[])
 
   std::vector<std::string> allowed_algorithms = {"dbscan", "hdbscan", "mst"};
   std::vector<std::string> allowed_dendrograms = {"boruvka", "union-find"};
-  std::vector<std::string> allowed_impls = {"fdbscan", "fdbscan-densebox"};
+  std::vector<std::string> allowed_impls = {"fdbscan", "fdbscan-densebox",
+                                            "fdbscan-grid", "rho-approximate"};
+  std::vector<std::string> allowed_distributions = {"gan-tao", "clustered",
+                                                    "fractal", "surface"};
 
   bpo::options_description desc("Allowed options");
   // clang-format off
@@ -93,6 +96,7 @@ int main(int argc, char *argv[])
       ( "core-min-size", bpo::value<int>(&params.core_min_size)->default_value(2), "DBSCAN min_pts")
       ( "dendrogram", bpo::value<std::string>(&params.dendrogram)->default_value("boruvka"), ("dendrogram " + vec2string(allowed_dendrograms, " | ")).c_str() )
       ( "dimension", bpo::value<int>(&dim)->default_value(3), "dimension of points to generate" )
+      ( "distribution", bpo::value<std::string>(&params.distribution)->default_value("gan-tao"), ("distribution of points to generate " + vec2string(allowed_distributions, " | ")).c_str() )
       ( "eps", bpo::value<float>(&params.eps), "DBSCAN eps" )
       ( "filename", bpo::value<std::string>(&params.filename), "filename containing data" )
       ( "impl", bpo::value<std::string>(&params.implementation)->default_value("fdbscan"), ("implementation " + vec2string(allowed_impls, " | ")).c_str() )
@@ -143,6 +147,12 @@ int main(int argc, char *argv[])
               << "\n";
     return 4;
   }
+  if (!found(allowed_distributions, params.distribution))
+  {
+    std::cerr << "Distribution must be one of "
+              << vec2string(allowed_distributions) << "\n";
+    return 5;
+  }
 
   std::stringstream ss;
   ss << params.implementation;
@@ -172,8 +182,12 @@ int main(int argc, char *argv[])
   else
   {
     // Data is generated
-    printf("generator         : n = %d, dim = %d, density = %s\n", params.n,
-           dim, (params.variable_density ? "variable" : "constant"));
+    if (params.distribution == "gan-tao")
+      printf("generator         : n = %d, dim = %d, density = %s\n", params.n,
+             dim, (params.variable_density ? "variable" : "constant"));
+    else
+      printf("generator         : n = %d, dim = %d, distribution = %s\n",
+             params.n, dim, params.distribution.c_str());
   }
   if (!params.filename_labels.empty())
     printf("filename [labels] : %s [binary]\n", params.filename_labels.c_str());
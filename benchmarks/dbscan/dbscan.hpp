@@ -21,6 +21,7 @@ struct Parameters
   int cluster_min_size;
   int core_min_size;
   std::string dendrogram;
+  std::string distribution;
   float eps;
   std::string filename;
   std::string filename_labels;
@@ -9,6 +9,7 @@
  * SPDX-License-Identifier: BSD-3-Clause                                    *
  ****************************************************************************/
 
+#include <ArborXBenchmark_Workloads.hpp>
 #include <ArborX_DBSCAN.hpp>
 #include <ArborX_DBSCANVerification.hpp>
 #include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
@@ -18,7 +19,9 @@
 
 #include <Kokkos_Core.hpp>
 
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 
 #include "data.hpp"
@@ -157,6 +160,63 @@ auto vec2view(std::vector<T> const &in, std::string const &label = "")
   return out;
 }
 
+#ifdef ARBORX_BENCHMARK_HAS_MMAP
+// Load a binary point file into a device view through a memory mapping. The
+// binary payload is laid out exactly like the points in memory, so there is
+// nothing to parse: the payload is streamed from the page cache straight into
+// device memory in bounded chunks, dropping each chunk's pages once copied.
+// This keeps the host footprint at the chunk size no matter the file size and
+// avoids the serial read into a staging vector.
+template <int DIM, typename MemorySpace>
+auto loadMappedBinaryData(std::string const &filename, int max_num_points)
+{
+  using Point = ArborX::ExperimentalHyperGeometry::Point<DIM>;
+
+  std::cout << "Mapping \"" << filename << "\"...";
+  std::cout.flush();
+
+  MappedFile mapped(filename);
+  std::size_t const header_size = 2 * sizeof(int);
+  ARBORX_ASSERT(mapped._size >= header_size);
+
+  int num_points;
+  int dim;
+  std::memcpy(&num_points, mapped._data, sizeof(int));
+  std::memcpy(&dim, mapped._data + sizeof(int), sizeof(int));
+  ARBORX_ASSERT(dim == DIM);
+
+  if (max_num_points > 0 && max_num_points < num_points)
+    num_points = max_num_points;
+  ARBORX_ASSERT(mapped._size >=
+                header_size + (std::size_t)num_points * sizeof(Point));
+
+  Kokkos::View<Point *, MemorySpace> points(
+      Kokkos::view_alloc("Benchmark::primitives", Kokkos::WithoutInitializing),
+      num_points);
+
+  auto const *payload =
+      reinterpret_cast<Point const *>(mapped._data + header_size);
+  std::size_t const chunk_size = ((std::size_t)1 << 30) / sizeof(Point);
+  for (std::size_t first = 0; first < (std::size_t)num_points;
+       first += chunk_size)
+  {
+    auto const last = std::min((std::size_t)num_points, first + chunk_size);
+    Kokkos::deep_copy(
+        Kokkos::subview(points, std::make_pair(first, last)),
+        Kokkos::View<Point const *, Kokkos::HostSpace,
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged>>{payload + first,
+                                                              last - first});
+    mapped.release(header_size + first * sizeof(Point),
+                   (last - first) * sizeof(Point));
+  }
+
+  std::cout << "done\nRead in " << num_points << " " << dim << "D points"
+            << std::endl;
+
+  return points;
+}
+#endif
+
 template <int DIM>
 bool ArborXBenchmark::run(ArborXBenchmark::Parameters const &params)
 {
@@ -173,20 +233,43 @@ bool ArborXBenchmark::run(ArborXBenchmark::Parameters const &params)
 
   ExecutionSpace exec_space;
 
-  std::vector<ArborX::ExperimentalHyperGeometry::Point<DIM>> data;
-  if (!params.filename.empty())
+  Kokkos::View<ArborX::ExperimentalHyperGeometry::Point<DIM> *, MemorySpace>
+      primitives;
+#ifdef ARBORX_BENCHMARK_HAS_MMAP
+  if (!params.filename.empty() && params.binary && params.num_samples <= 0)
   {
-    // Read in data
-    data = loadData<DIM>(params.filename, params.binary, params.max_num_points,
-                         params.num_samples);
+    // Binary files go through a memory mapping straight into the device view;
+    // sampling needs the whole dataset on the host and takes the regular path
+    primitives = loadMappedBinaryData<DIM, MemorySpace>(params.filename,
+                                                        params.max_num_points);
   }
   else
+#endif
+  if (params.filename.empty() && params.distribution != "gan-tao")
   {
-    // Generate data
-    data = GanTao<DIM>(params.n, params.variable_density);
+    // Generate data directly on the device, in the same domain as the Gan-Tao
+    // generator so the recommended eps values stay in a comparable range
+    Kokkos::resize(Kokkos::WithoutInitializing, primitives, params.n);
+    ArborXBenchmark::generateWorkload(
+        exec_space, ArborXBenchmark::to_workload_enum(params.distribution),
+        ArborXBenchmark::WorkloadParameters{}, 1e6, primitives);
+  }
+  else
+  {
+    std::vector<ArborX::ExperimentalHyperGeometry::Point<DIM>> data;
+    if (!params.filename.empty())
+    {
+      // Read in data
+      data = loadData<DIM>(params.filename, params.binary,
+                           params.max_num_points, params.num_samples);
+    }
+    else
+    {
+      // Generate data
+      data = GanTao<DIM>(params.n, params.variable_density);
+    }
+    primitives = vec2view<MemorySpace>(data, "Benchmark::primitives");
   }
-
-  auto const primitives = vec2view<MemorySpace>(data, "Benchmark::primitives");
 
   using Primitives = decltype(primitives);
 
@@ -198,6 +281,10 @@ bool ArborXBenchmark::run(ArborXBenchmark::Parameters const &params)
     Implementation implementation = Implementation::FDBSCAN;
     if (params.implementation == "fdbscan-densebox")
       implementation = Implementation::FDBSCAN_DenseBox;
+    else if (params.implementation == "fdbscan-grid")
+      implementation = Implementation::FDBSCAN_Grid;
+    else if (params.implementation == "rho-approximate")
+      implementation = Implementation::RhoApproximate;
 
     ArborX::DBSCAN::Parameters dbscan_params;
     dbscan_params.setVerbosity(params.verbose)
@@ -227,8 +314,15 @@ bool ArborXBenchmark::run(ArborXBenchmark::Parameters const &params)
       if (implementation == ArborX::DBSCAN::Implementation::FDBSCAN_DenseBox)
         printf("-- dense cells      : %10.3f\n",
                ArborX_Benchmark::get_time("ArborX::DBSCAN::dense_cells"));
-      printf("-- construction     : %10.3f\n",
-             ArborX_Benchmark::get_time("ArborX::DBSCAN::tree_construction"));
+      if (implementation == ArborX::DBSCAN::Implementation::FDBSCAN_Grid)
+        printf("-- grid             : %10.3f\n",
+               ArborX_Benchmark::get_time("ArborX::DBSCAN::grid"));
+      else if (implementation == ArborX::DBSCAN::Implementation::RhoApproximate)
+        printf("-- cells            : %10.3f\n",
+               ArborX_Benchmark::get_time("ArborX::DBSCAN::cells"));
+      else
+        printf("-- construction     : %10.3f\n",
+               ArborX_Benchmark::get_time("ArborX::DBSCAN::tree_construction"));
       printf("-- query+cluster    : %10.3f\n",
              ArborX_Benchmark::get_time("ArborX::DBSCAN::clusters"));
       if (!is_special_case)
@@ -257,7 +351,7 @@ bool ArborXBenchmark::run(ArborXBenchmark::Parameters const &params)
 
     if (params.verify)
     {
-      success = ArborX::Details::verifyDBSCAN(
+      success = ArborX::Experimental::verifyDBSCAN(
           exec_space, primitives, params.eps, params.core_min_size, labels);
       printf("Verification %s\n", (success ? "passed" : "failed"));
     }
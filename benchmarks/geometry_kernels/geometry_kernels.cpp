@@ -0,0 +1,363 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+// Microbenchmarks for the geometry kernels in ArborX_DetailsAlgorithms.hpp
+// (expand, intersects, distance). The tree drivers only exercise these
+// kernels mixed with traversal, so a regression in a single kernel (say, a
+// costlier ray-box test) disappears into their noise; here each kernel runs
+// alone over arrays of random geometry pairs and a slowdown shows up as a
+// drop of its own rate counter.
+
+#include <ArborX_Box.hpp>
+#include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtVersion.hpp>
+#include <ArborX_HyperTriangle.hpp>
+#include <ArborX_KDOP.hpp>
+#include <ArborX_Point.hpp>
+#include <ArborX_Ray.hpp>
+#include <ArborX_Sphere.hpp>
+#include <ArborX_Version.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Random.hpp>
+
+#include <chrono>
+#include <iostream>
+
+#include <benchmark/benchmark.h>
+
+using ExecutionSpace = Kokkos::DefaultExecutionSpace;
+using MemorySpace = ExecutionSpace::memory_space;
+
+using Triangle = ArborX::ExperimentalHyperGeometry::Triangle<3>;
+
+// The geometries live in the unit cube with extents a few percent of it, so
+// that the intersection tests are a mix of hits and misses rather than all
+// of one branch
+template <typename ExecutionSpace>
+auto makePoints(ExecutionSpace const &exec_space, int n)
+{
+  Kokkos::View<ArborX::Point *, MemorySpace> points(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "Benchmark::points"),
+      n);
+  Kokkos::Random_XorShift1024_Pool<ExecutionSpace> rand_pool(1984);
+  Kokkos::parallel_for(
+      "Benchmark::init_points",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        auto rand_gen = rand_pool.get_state();
+        points(i) = {rand_gen.frand(), rand_gen.frand(), rand_gen.frand()};
+        rand_pool.free_state(rand_gen);
+      });
+  return points;
+}
+
+template <typename ExecutionSpace>
+auto makeBoxes(ExecutionSpace const &exec_space, int n, unsigned seed)
+{
+  Kokkos::View<ArborX::Box *, MemorySpace> boxes(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "Benchmark::boxes"),
+      n);
+  Kokkos::Random_XorShift1024_Pool<ExecutionSpace> rand_pool(seed);
+  Kokkos::parallel_for(
+      "Benchmark::init_boxes",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        auto rand_gen = rand_pool.get_state();
+        ArborX::Point const center{rand_gen.frand(), rand_gen.frand(),
+                                   rand_gen.frand()};
+        float const h = 0.01f + 0.05f * rand_gen.frand();
+        boxes(i) = {{center[0] - h, center[1] - h, center[2] - h},
+                    {center[0] + h, center[1] + h, center[2] + h}};
+        rand_pool.free_state(rand_gen);
+      });
+  return boxes;
+}
+
+template <typename ExecutionSpace>
+auto makeSpheres(ExecutionSpace const &exec_space, int n)
+{
+  Kokkos::View<ArborX::Sphere *, MemorySpace> spheres(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "Benchmark::spheres"),
+      n);
+  Kokkos::Random_XorShift1024_Pool<ExecutionSpace> rand_pool(1959);
+  Kokkos::parallel_for(
+      "Benchmark::init_spheres",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        auto rand_gen = rand_pool.get_state();
+        spheres(i) = {{rand_gen.frand(), rand_gen.frand(), rand_gen.frand()},
+                      0.01f + 0.05f * rand_gen.frand()};
+        rand_pool.free_state(rand_gen);
+      });
+  return spheres;
+}
+
+template <typename ExecutionSpace>
+auto makeRays(ExecutionSpace const &exec_space, int n)
+{
+  Kokkos::View<ArborX::Experimental::Ray *, MemorySpace> rays(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "Benchmark::rays"),
+      n);
+  Kokkos::Random_XorShift1024_Pool<ExecutionSpace> rand_pool(1307);
+  Kokkos::parallel_for(
+      "Benchmark::init_rays",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        auto rand_gen = rand_pool.get_state();
+        // the third direction component never vanishes, so the direction is
+        // normalizable
+        rays(i) = {{rand_gen.frand(), rand_gen.frand(), rand_gen.frand()},
+                   {rand_gen.frand() - 0.5f, rand_gen.frand() - 0.5f,
+                    rand_gen.frand() + 0.5f}};
+        rand_pool.free_state(rand_gen);
+      });
+  return rays;
+}
+
+template <typename ExecutionSpace>
+auto makeTriangles(ExecutionSpace const &exec_space, int n)
+{
+  Kokkos::View<Triangle *, MemorySpace> triangles(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "Benchmark::triangles"),
+      n);
+  Kokkos::Random_XorShift1024_Pool<ExecutionSpace> rand_pool(1597);
+  Kokkos::parallel_for(
+      "Benchmark::init_triangles",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        auto rand_gen = rand_pool.get_state();
+        float const x = rand_gen.frand();
+        float const y = rand_gen.frand();
+        float const z = rand_gen.frand();
+        triangles(i) = {
+            {x, y, z},
+            {x + 0.1f * rand_gen.frand(), y + 0.1f * rand_gen.frand(), z},
+            {x, y + 0.1f * rand_gen.frand(), z + 0.1f * rand_gen.frand()}};
+        rand_pool.free_state(rand_gen);
+      });
+  return triangles;
+}
+
+template <typename KDOP_t, typename ExecutionSpace>
+auto makeKDOPs(ExecutionSpace const &exec_space, int n, unsigned seed)
+{
+  auto boxes = makeBoxes(exec_space, n, seed);
+  Kokkos::View<KDOP_t *, MemorySpace> kdops(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "Benchmark::kdops"),
+      n);
+  Kokkos::parallel_for(
+      "Benchmark::init_kdops",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        KDOP_t kdop{};
+        ArborX::Details::expand(kdop, boxes(i));
+        kdops(i) = kdop;
+      });
+  return kdops;
+}
+
+// Run kernel(i) over every index, timing the kernel alone; the results views
+// the kernels write to keep the calls from being optimized away
+template <typename Kernel>
+void runKernel(benchmark::State &state, ExecutionSpace const &exec_space,
+               int n, Kernel const &kernel)
+{
+  for (auto _ : state)
+  {
+    exec_space.fence();
+    auto const start = std::chrono::high_resolution_clock::now();
+
+    Kokkos::parallel_for("Benchmark::geometry_kernel",
+                         Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+                         kernel);
+
+    exec_space.fence();
+    auto const end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed_seconds = end - start;
+    state.SetIterationTime(elapsed_seconds.count());
+  }
+  state.counters["rate"] =
+      benchmark::Counter(n, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+void BM_intersects_box_box(benchmark::State &state)
+{
+  ExecutionSpace exec_space;
+  int const n = state.range(0);
+  auto as = makeBoxes(exec_space, n, 1799);
+  auto bs = makeBoxes(exec_space, n, 1847);
+  Kokkos::View<char *, MemorySpace> results("Benchmark::results", n);
+  runKernel(state, exec_space, n, KOKKOS_LAMBDA(int i) {
+    results(i) = ArborX::Details::intersects(as(i), bs(i));
+  });
+}
+
+void BM_intersects_sphere_box(benchmark::State &state)
+{
+  ExecutionSpace exec_space;
+  int const n = state.range(0);
+  auto as = makeSpheres(exec_space, n);
+  auto bs = makeBoxes(exec_space, n, 1847);
+  Kokkos::View<char *, MemorySpace> results("Benchmark::results", n);
+  runKernel(state, exec_space, n, KOKKOS_LAMBDA(int i) {
+    results(i) = ArborX::Details::intersects(as(i), bs(i));
+  });
+}
+
+void BM_intersects_ray_box(benchmark::State &state)
+{
+  ExecutionSpace exec_space;
+  int const n = state.range(0);
+  auto as = makeRays(exec_space, n);
+  auto bs = makeBoxes(exec_space, n, 1847);
+  Kokkos::View<char *, MemorySpace> results("Benchmark::results", n);
+  runKernel(state, exec_space, n, KOKKOS_LAMBDA(int i) {
+    using ArborX::Experimental::intersects;
+    results(i) = intersects(as(i), bs(i));
+  });
+}
+
+template <typename KDOP_t>
+void BM_intersects_kdop_box(benchmark::State &state)
+{
+  ExecutionSpace exec_space;
+  int const n = state.range(0);
+  auto as = makeKDOPs<KDOP_t>(exec_space, n, 1799);
+  auto bs = makeBoxes(exec_space, n, 1847);
+  Kokkos::View<char *, MemorySpace> results("Benchmark::results", n);
+  runKernel(state, exec_space, n, KOKKOS_LAMBDA(int i) {
+    results(i) = ArborX::Details::intersects(as(i), bs(i));
+  });
+}
+
+template <typename KDOP_t>
+void BM_intersects_kdop_kdop(benchmark::State &state)
+{
+  ExecutionSpace exec_space;
+  int const n = state.range(0);
+  auto as = makeKDOPs<KDOP_t>(exec_space, n, 1799);
+  auto bs = makeKDOPs<KDOP_t>(exec_space, n, 1847);
+  Kokkos::View<char *, MemorySpace> results("Benchmark::results", n);
+  runKernel(state, exec_space, n, KOKKOS_LAMBDA(int i) {
+    results(i) = ArborX::Details::intersects(as(i), bs(i));
+  });
+}
+
+void BM_distance_point_box(benchmark::State &state)
+{
+  ExecutionSpace exec_space;
+  int const n = state.range(0);
+  auto as = makePoints(exec_space, n);
+  auto bs = makeBoxes(exec_space, n, 1847);
+  Kokkos::View<float *, MemorySpace> results("Benchmark::results", n);
+  runKernel(state, exec_space, n, KOKKOS_LAMBDA(int i) {
+    results(i) = ArborX::Details::distance(as(i), bs(i));
+  });
+}
+
+void BM_distance_point_triangle(benchmark::State &state)
+{
+  ExecutionSpace exec_space;
+  int const n = state.range(0);
+  auto as = makePoints(exec_space, n);
+  auto bs = makeTriangles(exec_space, n);
+  Kokkos::View<float *, MemorySpace> results("Benchmark::results", n);
+  runKernel(state, exec_space, n, KOKKOS_LAMBDA(int i) {
+    results(i) = ArborX::Details::distance(as(i), bs(i));
+  });
+}
+
+void BM_expand_box_box(benchmark::State &state)
+{
+  ExecutionSpace exec_space;
+  int const n = state.range(0);
+  auto as = makeBoxes(exec_space, n, 1799);
+  auto bs = makeBoxes(exec_space, n, 1847);
+  Kokkos::View<ArborX::Box *, MemorySpace> results(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "Benchmark::results"),
+      n);
+  runKernel(state, exec_space, n, KOKKOS_LAMBDA(int i) {
+    auto box = as(i);
+    ArborX::Details::expand(box, bs(i));
+    results(i) = box;
+  });
+}
+
+template <typename KDOP_t>
+void BM_expand_kdop_box(benchmark::State &state)
+{
+  ExecutionSpace exec_space;
+  int const n = state.range(0);
+  auto as = makeKDOPs<KDOP_t>(exec_space, n, 1799);
+  auto bs = makeBoxes(exec_space, n, 1847);
+  Kokkos::View<KDOP_t *, MemorySpace> results(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "Benchmark::results"),
+      n);
+  runKernel(state, exec_space, n, KOKKOS_LAMBDA(int i) {
+    auto kdop = as(i);
+    ArborX::Details::expand(kdop, bs(i));
+    results(i) = kdop;
+  });
+}
+
+#define REGISTER(benchmark_function)                                          \
+  BENCHMARK(benchmark_function)                                               \
+      ->RangeMultiplier(10)                                                   \
+      ->Range(100000, 1000000)                                                \
+      ->UseManualTime()                                                       \
+      ->Unit(benchmark::kMicrosecond)
+
+#define REGISTER_TEMPLATE(benchmark_function, ...)                            \
+  BENCHMARK_TEMPLATE1(benchmark_function, __VA_ARGS__)                        \
+      ->RangeMultiplier(10)                                                   \
+      ->Range(100000, 1000000)                                                \
+      ->UseManualTime()                                                       \
+      ->Unit(benchmark::kMicrosecond)
+
+int main(int argc, char *argv[])
+{
+  Kokkos::ScopeGuard guard(argc, argv);
+
+  std::cout << "ArborX version    : " << ArborX::version() << std::endl;
+  std::cout << "ArborX hash       : " << ArborX::gitCommitHash() << std::endl;
+  std::cout << "Kokkos version    : " << ArborX::Details::KokkosExt::version()
+            << std::endl;
+
+  benchmark::Initialize(&argc, argv);
+
+  using ArborX::Experimental::KDOP;
+
+  REGISTER(BM_intersects_box_box);
+  REGISTER(BM_intersects_sphere_box);
+  REGISTER(BM_intersects_ray_box);
+  REGISTER_TEMPLATE(BM_intersects_kdop_box, KDOP<3, 14>);
+  REGISTER_TEMPLATE(BM_intersects_kdop_box, KDOP<3, 26>);
+  REGISTER_TEMPLATE(BM_intersects_kdop_kdop, KDOP<3, 14>);
+  REGISTER_TEMPLATE(BM_intersects_kdop_kdop, KDOP<3, 26>);
+  REGISTER(BM_distance_point_box);
+  REGISTER(BM_distance_point_triangle);
+  REGISTER(BM_expand_box_box);
+  REGISTER_TEMPLATE(BM_expand_kdop_box, KDOP<3, 14>);
+  REGISTER_TEMPLATE(BM_expand_kdop_box, KDOP<3, 26>);
+
+  benchmark::RunSpecifiedBenchmarks();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,264 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+// Nightly performance suite covering the subsystems that have no dedicated
+// benchmark driver: neighbor lists, minimum spanning tree and dendrogram
+// construction, and moving least squares interpolation. Run with
+// --benchmark_out=<file>.json --benchmark_out_format=json and feed the
+// output to compare_benchmarks.py to gate against a stored baseline.
+// DistributedTree is exercised by the MPI-based distributed_tree_driver and
+// is intentionally not duplicated here.
+
+#include <ArborXBenchmark_PointClouds.hpp>
+#include <ArborX_Dendrogram.hpp>
+#include <ArborX_DetailsKokkosExtVersion.hpp>
+#include <ArborX_InterpMovingLeastSquares.hpp>
+#include <ArborX_MinimumSpanningTree.hpp>
+#include <ArborX_NeighborList.hpp>
+#include <ArborX_Version.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include <benchmark/benchmark.h>
+
+using ExecutionSpace = Kokkos::DefaultExecutionSpace;
+using MemorySpace = ExecutionSpace::memory_space;
+
+template <typename ExecutionSpace>
+auto makePoints(ExecutionSpace const &exec_space, int n)
+{
+  Kokkos::View<ArborX::Point *, MemorySpace> points(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "Benchmark::points"),
+      n);
+  // Unit density cloud, so a fixed radius yields the same expected number of
+  // neighbors regardless of the problem size
+  ArborXBenchmark::generatePointCloud(
+      exec_space, ArborXBenchmark::PointCloudType::filled_box,
+      std::cbrt(static_cast<double>(n)), points);
+  return points;
+}
+
+struct HalfList
+{};
+struct FullList
+{};
+
+template <typename Tag>
+void BM_neighbor_list(benchmark::State &state)
+{
+  ExecutionSpace exec_space;
+
+  auto const n = state.range(0);
+  float const radius = 1.f;
+
+  auto points = makePoints(exec_space, n);
+
+  for (auto _ : state)
+  {
+    Kokkos::View<int *, MemorySpace> offsets("Benchmark::offsets", 0);
+    Kokkos::View<int *, MemorySpace> indices("Benchmark::indices", 0);
+
+    exec_space.fence();
+    auto const start = std::chrono::high_resolution_clock::now();
+
+    if constexpr (std::is_same_v<Tag, HalfList>)
+      ArborX::Experimental::findHalfNeighborList(exec_space, points, radius,
+                                                 offsets, indices);
+    else
+      ArborX::Experimental::findFullNeighborList(exec_space, points, radius,
+                                                 offsets, indices);
+
+    exec_space.fence();
+    auto const end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed_seconds = end - start;
+    state.SetIterationTime(elapsed_seconds.count());
+  }
+  state.counters["rate"] =
+      benchmark::Counter(n, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+void BM_minimum_spanning_tree(benchmark::State &state)
+{
+  ExecutionSpace exec_space;
+
+  auto const n = state.range(0);
+
+  auto points = makePoints(exec_space, n);
+
+  for (auto _ : state)
+  {
+    exec_space.fence();
+    auto const start = std::chrono::high_resolution_clock::now();
+
+    ArborX::Details::MinimumSpanningTree<MemorySpace> mst(exec_space, points);
+
+    exec_space.fence();
+    auto const end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed_seconds = end - start;
+    state.SetIterationTime(elapsed_seconds.count());
+
+    benchmark::DoNotOptimize(mst.edges);
+  }
+  state.counters["rate"] =
+      benchmark::Counter(n, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+void BM_dendrogram(benchmark::State &state)
+{
+  ExecutionSpace exec_space;
+
+  auto const n = state.range(0);
+
+  auto points = makePoints(exec_space, n);
+  // The edges are built once outside the timed loop; only the dendrogram
+  // construction is measured
+  ArborX::Details::MinimumSpanningTree<MemorySpace> mst(exec_space, points);
+
+  for (auto _ : state)
+  {
+    exec_space.fence();
+    auto const start = std::chrono::high_resolution_clock::now();
+
+    ArborX::Experimental::Dendrogram<MemorySpace> dendrogram(exec_space,
+                                                             mst.edges);
+
+    exec_space.fence();
+    auto const end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed_seconds = end - start;
+    state.SetIterationTime(elapsed_seconds.count());
+
+    benchmark::DoNotOptimize(dendrogram._parents);
+  }
+  state.counters["rate"] =
+      benchmark::Counter(n, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+struct Construction
+{};
+struct Interpolation
+{};
+
+template <typename Tag>
+void BM_moving_least_squares(benchmark::State &state)
+{
+  ExecutionSpace exec_space;
+
+  auto const n = state.range(0);
+
+  auto source_points = makePoints(exec_space, n);
+  auto target_points = makePoints(exec_space, n / 2);
+
+  Kokkos::View<float *, MemorySpace> source_values(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "Benchmark::source_values"),
+      n);
+  Kokkos::View<float *, MemorySpace> target_values(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "Benchmark::target_values"),
+      n / 2);
+  Kokkos::parallel_for(
+      "Benchmark::init_source_values",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        auto const &p = source_points(i);
+        source_values(i) = Kokkos::cos(p[0] + p[1] / 4 + p[2] / 16);
+      });
+
+  if constexpr (std::is_same_v<Tag, Construction>)
+  {
+    for (auto _ : state)
+    {
+      exec_space.fence();
+      auto const start = std::chrono::high_resolution_clock::now();
+
+      ArborX::Interpolation::MovingLeastSquares<MemorySpace> mls(
+          exec_space, source_points, target_points);
+
+      exec_space.fence();
+      auto const end = std::chrono::high_resolution_clock::now();
+      std::chrono::duration<double> elapsed_seconds = end - start;
+      state.SetIterationTime(elapsed_seconds.count());
+    }
+  }
+  else
+  {
+    ArborX::Interpolation::MovingLeastSquares<MemorySpace> mls(
+        exec_space, source_points, target_points);
+
+    for (auto _ : state)
+    {
+      exec_space.fence();
+      auto const start = std::chrono::high_resolution_clock::now();
+
+      mls.interpolate(exec_space, source_values, target_values);
+
+      exec_space.fence();
+      auto const end = std::chrono::high_resolution_clock::now();
+      std::chrono::duration<double> elapsed_seconds = end - start;
+      state.SetIterationTime(elapsed_seconds.count());
+    }
+  }
+  state.counters["rate"] =
+      benchmark::Counter(n, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+int main(int argc, char *argv[])
+{
+  Kokkos::ScopeGuard guard(argc, argv);
+
+  std::cout << "ArborX version    : " << ArborX::version() << std::endl;
+  std::cout << "ArborX hash       : " << ArborX::gitCommitHash() << std::endl;
+  std::cout << "Kokkos version    : " << ArborX::Details::KokkosExt::version()
+            << std::endl;
+
+  benchmark::Initialize(&argc, argv);
+
+  BENCHMARK_TEMPLATE1(BM_neighbor_list, HalfList)
+      ->RangeMultiplier(10)
+      ->Range(10000, 1000000)
+      ->UseManualTime()
+      ->Unit(benchmark::kMicrosecond);
+  BENCHMARK_TEMPLATE1(BM_neighbor_list, FullList)
+      ->RangeMultiplier(10)
+      ->Range(10000, 1000000)
+      ->UseManualTime()
+      ->Unit(benchmark::kMicrosecond);
+  BENCHMARK(BM_minimum_spanning_tree)
+      ->RangeMultiplier(10)
+      ->Range(10000, 1000000)
+      ->UseManualTime()
+      ->Unit(benchmark::kMicrosecond);
+  BENCHMARK(BM_dendrogram)
+      ->RangeMultiplier(10)
+      ->Range(10000, 1000000)
+      ->UseManualTime()
+      ->Unit(benchmark::kMicrosecond);
+  BENCHMARK_TEMPLATE1(BM_moving_least_squares, Construction)
+      ->RangeMultiplier(10)
+      ->Range(10000, 100000)
+      ->UseManualTime()
+      ->Unit(benchmark::kMicrosecond);
+  BENCHMARK_TEMPLATE1(BM_moving_least_squares, Interpolation)
+      ->RangeMultiplier(10)
+      ->Range(10000, 100000)
+      ->UseManualTime()
+      ->Unit(benchmark::kMicrosecond);
+
+  benchmark::RunSpecifiedBenchmarks();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,266 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <ArborX_CrsGraphWrapper.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_PairValueIndex.hpp>
+#include <ArborX_Sphere.hpp>
+#include <ArborX_Version.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// The other drivers measure the throughput of large batches, where the fixed
+// per-call costs amortize away. An online lookup service issues one small
+// query at a time and pays them in full on every call: the predicate upload,
+// the batched-query machinery, the kernel launches and the result copy-back
+// all sit on the critical path of a single lookup, and the service target is
+// a percentile, not a mean. This harness runs that closed loop -- one
+// predicate per call, result copied back to the host before the next call
+// starts -- and reports percentile latencies per predicate type, for both
+// the allocating query and the preallocated query_into() path.
+
+struct LatencySummary
+{
+  double p50;
+  double p90;
+  double p99;
+  double max;
+};
+
+template <typename Sample>
+LatencySummary measureLatency(int num_warmup, int num_samples,
+                              Sample const &sample)
+{
+  std::vector<double> latencies(num_samples);
+  for (int i = -num_warmup; i < num_samples; ++i)
+  {
+    auto const start = std::chrono::steady_clock::now();
+    sample(std::abs(i));
+    auto const stop = std::chrono::steady_clock::now();
+    if (i >= 0)
+      latencies[i] =
+          std::chrono::duration<double, std::micro>(stop - start).count();
+  }
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](double q) {
+    int const n = latencies.size();
+    return latencies[std::min((int)std::ceil(q * n) - 1, n - 1)];
+  };
+  return {percentile(.50), percentile(.90), percentile(.99), latencies.back()};
+}
+
+void report(std::string const &name, LatencySummary const &summary)
+{
+  std::cout << std::left << std::setw(26) << name << std::right << std::fixed
+            << std::setprecision(1) << std::setw(10) << summary.p50
+            << std::setw(10) << summary.p90 << std::setw(10) << summary.p99
+            << std::setw(10) << summary.max << '\n';
+}
+
+int main(int argc, char *argv[])
+{
+  using ExecutionSpace = Kokkos::DefaultExecutionSpace;
+  using MemorySpace = typename ExecutionSpace::memory_space;
+
+  Kokkos::ScopeGuard guard(argc, argv);
+
+  std::cout << "ArborX version: " << ArborX::version() << std::endl;
+  std::cout << "ArborX hash   : " << ArborX::gitCommitHash() << std::endl;
+
+  namespace bpo = boost::program_options;
+
+  int num_values;
+  int num_samples;
+  int num_warmup;
+  int num_neighbors;
+  int capacity;
+  float radius;
+
+  bpo::options_description desc("Allowed options");
+  // clang-format off
+    desc.add_options()
+        ( "help", "produce help message" )
+        ( "values", bpo::value<int>(&num_values)->default_value(100000), "Number of indexable values in the tree." )
+        ( "samples", bpo::value<int>(&num_samples)->default_value(1000), "Number of measured single-query calls." )
+        ( "warmup", bpo::value<int>(&num_warmup)->default_value(100), "Number of unmeasured calls issued first." )
+        ( "neighbors", bpo::value<int>(&num_neighbors)->default_value(8), "Number of neighbors per nearest query." )
+        ( "radius", bpo::value<float>(&radius)->default_value(0.1f), "Radius of the spatial queries." )
+        ( "capacity", bpo::value<int>(&capacity)->default_value(256), "Result capacity of the preallocated spatial path." )
+        ;
+  // clang-format on
+  bpo::variables_map vm;
+  bpo::store(bpo::command_line_parser(argc, argv).options(desc).run(), vm);
+  bpo::notify(vm);
+
+  if (vm.count("help") > 0)
+  {
+    std::cout << desc << '\n';
+    return 1;
+  }
+
+  std::cout << "\nRunning with arguments:"
+            << "\n#values in the tree   : " << num_values
+            << "\n#measured calls       : " << num_samples
+            << "\n#warmup calls         : " << num_warmup
+            << "\n#neighbors (nearest)  : " << num_neighbors
+            << "\nradius (spatial)      : " << radius
+            << "\ncapacity (query_into) : " << capacity << '\n';
+
+  // Uniform cloud in [-1, 1]^3
+  std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+  std::default_random_engine generator;
+  auto random = [&distribution, &generator]() {
+    return distribution(generator);
+  };
+
+  Kokkos::View<ArborX::Point *, MemorySpace> points(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "Benchmark::points"),
+      num_values);
+  auto points_host = Kokkos::create_mirror_view(points);
+  for (int i = 0; i < num_values; ++i)
+    points_host(i) = {random(), random(), random()};
+  Kokkos::deep_copy(points, points_host);
+
+  ExecutionSpace space;
+
+  using Value = ArborX::PairValueIndex<ArborX::Point>;
+  ArborX::BoundingVolumeHierarchy<MemorySpace, Value> tree(
+      space, ArborX::Experimental::attach_indices(points));
+  space.fence();
+
+  // Query centers are stored points in random order, so every call has work
+  // to do and consecutive calls do not hit the same part of the tree
+  std::uniform_int_distribution<int> pick(0, num_values - 1);
+  std::vector<ArborX::Point> centers(std::max(num_samples, num_warmup + 1));
+  for (auto &center : centers)
+    center = points_host(pick(generator));
+
+  std::cout << '\n'
+            << std::left << std::setw(26) << "latency (us)" << std::right
+            << std::setw(10) << "p50" << std::setw(10) << "p90" << std::setw(10)
+            << "p99" << std::setw(10) << "max" << '\n';
+
+  using SpatialPredicate = decltype(ArborX::intersects(ArborX::Sphere{}));
+  Kokkos::View<SpatialPredicate *, MemorySpace> spatial_predicate(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                         "Benchmark::spatial_predicate"),
+      1);
+  auto spatial_predicate_host = Kokkos::create_mirror_view(spatial_predicate);
+
+  using NearestPredicate = decltype(ArborX::nearest(ArborX::Point{}, 0));
+  Kokkos::View<NearestPredicate *, MemorySpace> nearest_predicate(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                         "Benchmark::nearest_predicate"),
+      1);
+  auto nearest_predicate_host = Kokkos::create_mirror_view(nearest_predicate);
+
+  // Allocating path: the query sizes and allocates the result views on every
+  // call, and the copy-back allocates the host mirrors, same as a naive
+  // service loop would
+  {
+    Kokkos::View<Value *, MemorySpace> values("Benchmark::values", 0);
+    Kokkos::View<int *, MemorySpace> offset("Benchmark::offset", 0);
+    report("intersects / query",
+           measureLatency(num_warmup, num_samples, [&](int i) {
+             spatial_predicate_host(0) =
+                 ArborX::intersects(ArborX::Sphere{centers[i], radius});
+             Kokkos::deep_copy(space, spatial_predicate,
+                               spatial_predicate_host);
+             ArborX::query(tree, space, spatial_predicate, values, offset);
+             auto values_host = Kokkos::create_mirror_view(values);
+             Kokkos::deep_copy(space, values_host, values);
+             space.fence();
+           }));
+
+    report("nearest / query",
+           measureLatency(num_warmup, num_samples, [&](int i) {
+             nearest_predicate_host(0) =
+                 ArborX::nearest(centers[i], num_neighbors);
+             Kokkos::deep_copy(space, nearest_predicate,
+                               nearest_predicate_host);
+             ArborX::query(tree, space, nearest_predicate, values, offset);
+             auto values_host = Kokkos::create_mirror_view(values);
+             Kokkos::deep_copy(space, values_host, values);
+             space.fence();
+           }));
+  }
+
+  // Preallocated path: every view is sized once and reused, so a call is
+  // the two traversal passes plus two copy-backs (the count, then that many
+  // results) with no allocation anywhere
+  {
+    int num_overflows = 0;
+    Kokkos::View<Value *, MemorySpace> values(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "Benchmark::values"),
+        std::max(capacity, num_neighbors));
+    auto values_host = Kokkos::create_mirror_view(values);
+    Kokkos::View<int *, MemorySpace> offset(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "Benchmark::offset"),
+        2);
+    auto offset_host = Kokkos::create_mirror_view(offset);
+    Kokkos::View<int *, MemorySpace> counts(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "Benchmark::counts"),
+        1);
+    auto counts_host = Kokkos::create_mirror_view(counts);
+
+    auto sample = [&](auto &predicate, auto &predicate_host) {
+      Kokkos::deep_copy(space, predicate, predicate_host);
+      num_overflows += (int)ArborX::Experimental::query_into(
+          tree, space, predicate, values, offset, counts);
+      Kokkos::deep_copy(space, counts_host, counts);
+      space.fence();
+      int const num_results = counts_host(0);
+      Kokkos::deep_copy(
+          space,
+          Kokkos::subview(values_host, std::make_pair(0, num_results)),
+          Kokkos::subview(values, std::make_pair(0, num_results)));
+      space.fence();
+    };
+
+    offset_host(0) = 0;
+    offset_host(1) = capacity;
+    Kokkos::deep_copy(offset, offset_host);
+    report("intersects / query_into",
+           measureLatency(num_warmup, num_samples, [&](int i) {
+             spatial_predicate_host(0) =
+                 ArborX::intersects(ArborX::Sphere{centers[i], radius});
+             sample(spatial_predicate, spatial_predicate_host);
+           }));
+    if (num_overflows > 0)
+      std::cout << "WARNING: " << num_overflows
+                << " spatial calls overflowed the capacity; raise --capacity "
+                   "for faithful numbers\n";
+
+    offset_host(1) = num_neighbors;
+    Kokkos::deep_copy(offset, offset_host);
+    report("nearest / query_into",
+           measureLatency(num_warmup, num_samples, [&](int i) {
+             nearest_predicate_host(0) =
+                 ArborX::nearest(centers[i], num_neighbors);
+             sample(nearest_predicate, nearest_predicate_host);
+           }));
+  }
+
+  return EXIT_SUCCESS;
+}
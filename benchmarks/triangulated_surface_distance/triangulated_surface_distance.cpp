@@ -26,6 +26,8 @@
 
 using Point = ArborX::ExperimentalHyperGeometry::Point<3>;
 using Triangle = ArborX::ExperimentalHyperGeometry::Triangle<3>;
+using PrecomputedTriangle =
+    ArborX::ExperimentalHyperGeometry::PrecomputedTriangle<3>;
 
 template <typename MemorySpace>
 struct Triangles
@@ -49,8 +51,11 @@ public:
   static KOKKOS_FUNCTION auto get(Self const &self, int i)
   {
     auto const &vertices = self._triangle_vertices;
-    return Triangle{self._points(vertices(i)[0]), self._points(vertices(i)[1]),
-                    self._points(vertices(i)[2])};
+    // Precompute the edge vectors once at construction so that the
+    // traversal-side distance computations reuse them
+    return ArborX::ExperimentalHyperGeometry::makePrecomputed(
+        Triangle{self._points(vertices(i)[0]), self._points(vertices(i)[1]),
+                 self._points(vertices(i)[2])});
   }
 };
 
@@ -166,7 +171,7 @@ int main(int argc, char *argv[])
   std::cout << "#triangles        : " << triangles.size() << '\n';
   std::cout << "#queries          : " << random_points.size() << '\n';
 
-  ArborX::BVH<MemorySpace, Triangle> index(
+  ArborX::BVH<MemorySpace, PrecomputedTriangle> index(
       space, Triangles<MemorySpace>{vertices, triangles});
 
   Kokkos::View<int *, MemorySpace> offset("Benchmark::offsets", 0);
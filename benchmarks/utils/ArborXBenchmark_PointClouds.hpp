@@ -12,6 +12,8 @@
 #ifndef ARBORX_BENCHMARK_POINT_CLOUDS_HPP
 #define ARBORX_BENCHMARK_POINT_CLOUDS_HPP
 
+#include "ArborXBenchmark_Workloads.hpp"
+
 #include <ArborX_GeometryTraits.hpp>
 
 #include <Kokkos_Core.hpp>
@@ -27,7 +29,13 @@ enum class PointCloudType
   filled_box,
   hollow_box,
   filled_sphere,
-  hollow_sphere
+  hollow_sphere,
+  // Workload distributions (see ArborXBenchmark_Workloads.hpp) with default
+  // parameters, so that every driver taking a point cloud type can be run
+  // against them
+  clustered,
+  fractal,
+  surface
 };
 
 inline PointCloudType to_point_cloud_enum(std::string const &str)
@@ -40,6 +48,12 @@ inline PointCloudType to_point_cloud_enum(std::string const &str)
     return PointCloudType::filled_sphere;
   if (str == "hollow_sphere")
     return PointCloudType::hollow_sphere;
+  if (str == "clustered")
+    return PointCloudType::clustered;
+  if (str == "fractal")
+    return PointCloudType::fractal;
+  if (str == "surface")
+    return PointCloudType::surface;
   throw std::runtime_error(str +
                            " doesn't correspond to any known PointCloudType!");
 }
@@ -192,6 +206,24 @@ void generatePointCloud(ExecutionSpace const &exec,
   check_valid_geometry_traits(Point{});
   static_assert(is_point_v<Point>, "ArborX: View must contain point values");
 
+  switch (point_cloud_type)
+  {
+  case PointCloudType::clustered:
+    generateWorkload(exec, WorkloadType::clustered, WorkloadParameters{},
+                     length, random_points);
+    return;
+  case PointCloudType::fractal:
+    generateWorkload(exec, WorkloadType::fractal, WorkloadParameters{}, length,
+                     random_points);
+    return;
+  case PointCloudType::surface:
+    generateWorkload(exec, WorkloadType::surface, WorkloadParameters{}, length,
+                     random_points);
+    return;
+  default:
+    break;
+  }
+
   KOKKOS_ASSERT(point_cloud_type == PointCloudType::filled_box ||
                 point_cloud_type == PointCloudType::hollow_box ||
                 point_cloud_type == PointCloudType::filled_sphere ||
@@ -0,0 +1,241 @@
+/****************************************************************************
+ * Copyright (c) 2017-2022 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_BENCHMARK_WORKLOADS_HPP
+#define ARBORX_BENCHMARK_WORKLOADS_HPP
+
+#include <ArborX_GeometryTraits.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Random.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+// Workload generators mimicking production data distributions. The uniform
+// clouds in ArborXBenchmark_PointClouds.hpp produce trees with evenly sized
+// nodes and little traversal divergence, which makes benchmark numbers on
+// them poor predictors for clustered or surface-concentrated inputs. The
+// generators here are shared by the benchmark drivers so that all of them
+// can be run against the same parameterized distributions.
+
+namespace ArborXBenchmark
+{
+
+enum class WorkloadType
+{
+  // Evenly sized Gaussian blobs at uniformly distributed locations
+  clustered,
+  // Clusters of clusters: every cluster is surrounded by smaller child
+  // clusters, repeated over several levels (galaxy-like clustering)
+  fractal,
+  // Thin shell around a sphere (surface-concentrated particles)
+  surface
+};
+
+inline WorkloadType to_workload_enum(std::string const &str)
+{
+  if (str == "clustered")
+    return WorkloadType::clustered;
+  if (str == "fractal")
+    return WorkloadType::fractal;
+  if (str == "surface")
+    return WorkloadType::surface;
+  throw std::runtime_error(str +
+                           " doesn't correspond to any known WorkloadType!");
+}
+
+struct WorkloadParameters
+{
+  // clustered: number of blobs the points are spread over evenly
+  int num_clusters = 100;
+  // clustered: blob standard deviation relative to the domain half-width
+  double cluster_spread = 0.02;
+  // fractal: levels of nesting, including the root level
+  int fractal_levels = 3;
+  // fractal: clusters surrounding every cluster of the previous level
+  int fractal_branching = 16;
+  // fractal: cluster size reduction from one level to the next
+  double fractal_contraction = 0.2;
+  // surface: shell thickness relative to the domain half-width
+  double surface_thickness = 0.01;
+  // seed for reproducible clouds; a matched query set derives its own from it
+  unsigned int seed = 0;
+};
+
+namespace Details
+{
+
+// Sample every point around a cluster center, assigned round-robin so the
+// clusters are evenly sized
+template <typename ExecutionSpace, typename GeneratorPool, typename Centers,
+          typename Points>
+void sampleAroundCenters(ExecutionSpace const &exec, GeneratorPool &random_pool,
+                         Centers const &centers, double sigma, Points &points)
+{
+  using Point = typename Points::value_type;
+  static constexpr int DIM = ArborX::GeometryTraits::dimension_v<Point>;
+  using Coordinate = ArborX::GeometryTraits::coordinate_type_t<Point>;
+
+  int const num_centers = centers.extent(0);
+  Kokkos::parallel_for(
+      "ArborXBenchmark::generateWorkload::sample_around_centers",
+      Kokkos::RangePolicy<ExecutionSpace>(exec, 0, points.extent(0)),
+      KOKKOS_LAMBDA(int i) {
+        auto generator = random_pool.get_state();
+        Point p = centers(i % num_centers);
+        for (int d = 0; d < DIM; ++d)
+          p[d] += (Coordinate)(sigma * generator.normal());
+        points(i) = p;
+        random_pool.free_state(generator);
+      });
+}
+
+template <typename ExecutionSpace, typename GeneratorPool, typename Centers>
+void uniformCenters(ExecutionSpace const &exec, GeneratorPool &random_pool,
+                    double length, Centers &centers)
+{
+  using Point = typename Centers::value_type;
+  static constexpr int DIM = ArborX::GeometryTraits::dimension_v<Point>;
+  using Coordinate = ArborX::GeometryTraits::coordinate_type_t<Point>;
+
+  Kokkos::parallel_for(
+      "ArborXBenchmark::generateWorkload::uniform_centers",
+      Kokkos::RangePolicy<ExecutionSpace>(exec, 0, centers.extent(0)),
+      KOKKOS_LAMBDA(int i) {
+        auto generator = random_pool.get_state();
+        for (int d = 0; d < DIM; ++d)
+          centers(i)[d] = Kokkos::rand<decltype(generator), Coordinate>::draw(
+              generator, -(Coordinate)length, (Coordinate)length);
+        random_pool.free_state(generator);
+      });
+}
+
+} // namespace Details
+
+// Generate points within the [-length, length]^DIM domain (up to the tails
+// of the Gaussian cluster spreads) following the requested distribution
+template <typename ExecutionSpace, typename Points>
+void generateWorkload(ExecutionSpace const &exec,
+                      WorkloadType const workload_type,
+                      WorkloadParameters const &params, double const length,
+                      Points &points)
+{
+  static_assert(Kokkos::is_view_v<Points>);
+
+  using Point = typename Points::value_type;
+  using MemorySpace = typename Points::memory_space;
+
+  using namespace ArborX::GeometryTraits;
+  check_valid_geometry_traits(Point{});
+  static_assert(is_point_v<Point>, "ArborX: View must contain point values");
+
+  static constexpr int DIM = dimension_v<Point>;
+  using Coordinate = coordinate_type_t<Point>;
+
+  using GeneratorPool = Kokkos::Random_XorShift1024_Pool<ExecutionSpace>;
+  GeneratorPool random_pool(params.seed);
+
+  int const n = points.extent(0);
+
+  switch (workload_type)
+  {
+  case WorkloadType::clustered:
+  {
+    Kokkos::View<Point *, MemorySpace> centers(
+        Kokkos::view_alloc(exec, Kokkos::WithoutInitializing,
+                           "ArborXBenchmark::generateWorkload::centers"),
+        params.num_clusters);
+    Details::uniformCenters(exec, random_pool, length, centers);
+    Details::sampleAroundCenters(exec, random_pool, centers,
+                                 params.cluster_spread * length, points);
+    break;
+  }
+  case WorkloadType::fractal:
+  {
+    // Refine the cluster centers level by level: every center of the
+    // previous level is surrounded by `branching` centers of a
+    // `contraction` times smaller cluster
+    Kokkos::View<Point *, MemorySpace> centers(
+        Kokkos::view_alloc(exec, Kokkos::WithoutInitializing,
+                           "ArborXBenchmark::generateWorkload::centers"),
+        std::min(params.fractal_branching, n));
+    Details::uniformCenters(exec, random_pool, length, centers);
+    double scale = length;
+    for (int level = 1; level < params.fractal_levels; ++level)
+    {
+      scale *= params.fractal_contraction;
+      // Tracking more clusters than points adds nothing
+      long long const num_children =
+          std::min((long long)centers.extent(0) * params.fractal_branching,
+                   (long long)n);
+      Kokkos::View<Point *, MemorySpace> children(
+          Kokkos::view_alloc(exec, Kokkos::WithoutInitializing,
+                             "ArborXBenchmark::generateWorkload::centers"),
+          num_children);
+      Details::sampleAroundCenters(exec, random_pool, centers, scale,
+                                   children);
+      centers = children;
+    }
+    Details::sampleAroundCenters(exec, random_pool, centers,
+                                 scale * params.fractal_contraction, points);
+    break;
+  }
+  case WorkloadType::surface:
+  {
+    auto const thickness = params.surface_thickness;
+    Kokkos::parallel_for(
+        "ArborXBenchmark::generateWorkload::surface",
+        Kokkos::RangePolicy<ExecutionSpace>(exec, 0, n),
+        KOKKOS_LAMBDA(int i) {
+          auto generator = random_pool.get_state();
+          Point p;
+          Coordinate norm_squared;
+          do
+          {
+            norm_squared = 0;
+            for (int d = 0; d < DIM; ++d)
+            {
+              p[d] = generator.normal();
+              norm_squared += p[d] * p[d];
+            }
+          } while (norm_squared == 0);
+          auto const radius_over_norm =
+              (Coordinate)(length * (1 + thickness * generator.normal())) /
+              Kokkos::sqrt(norm_squared);
+          for (int d = 0; d < DIM; ++d)
+            p[d] *= radius_over_norm;
+          points(i) = p;
+          random_pool.free_state(generator);
+        });
+    break;
+  }
+  }
+}
+
+// Generate query centers drawn from the same distribution as the data (with
+// a seed of its own), so that a matched predicate set hits the dense regions
+// with the same frequency the data does -- the situation production queries
+// are in, and the one uniform query sets fail to reproduce
+template <typename ExecutionSpace, typename Points>
+void generateMatchedQueryCenters(ExecutionSpace const &exec,
+                                 WorkloadType const workload_type,
+                                 WorkloadParameters params, double const length,
+                                 Points &centers)
+{
+  params.seed = params.seed * 2654435761u + 1;
+  generateWorkload(exec, workload_type, params, length, centers);
+}
+
+} // namespace ArborXBenchmark
+
+#endif
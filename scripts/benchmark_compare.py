@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+"""benchmark_compare.py
+
+Compare two Google Benchmark JSON outputs (produced with
+--benchmark_out=<file>.json --benchmark_out_format=json) and flag
+regressions against a stored baseline. Intended as a nightly gate:
+
+  benchmark_compare.py baseline.json current.json [--tolerance 0.10]
+
+Benchmarks are matched by name. A benchmark regresses when its time grows
+by more than the tolerance relative to the baseline. The exit code is the
+number of regressed benchmarks, so a nonzero status fails the nightly job.
+Benchmarks present in only one of the two files are reported but do not
+affect the exit code.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_benchmarks(filename):
+    with open(filename) as f:
+        data = json.load(f)
+    benchmarks = {}
+    for benchmark in data['benchmarks']:
+        # Skip the *_mean/_median/_stddev aggregates emitted with repetitions
+        if benchmark.get('run_type', 'iteration') != 'iteration':
+            continue
+        time = benchmark.get('real_time')
+        benchmarks[benchmark['name']] = {
+            'time': time,
+            'time_unit': benchmark.get('time_unit', 'ns')
+        }
+    return benchmarks
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Flag benchmark regressions against a stored baseline')
+    parser.add_argument('baseline', help='baseline JSON file')
+    parser.add_argument('current', help='current JSON file')
+    parser.add_argument('-t', '--tolerance', type=float, default=0.10,
+                        help='allowed relative slowdown (default: 0.10)')
+    args = parser.parse_args()
+
+    baseline = load_benchmarks(args.baseline)
+    current = load_benchmarks(args.current)
+
+    regressions = []
+    name_width = max(map(len, list(baseline) + list(current) or ['']))
+    print('{:{width}}  {:>12}  {:>12}  {:>8}'.format(
+        'benchmark', 'baseline', 'current', 'ratio', width=name_width))
+    for name in sorted(set(baseline) | set(current)):
+        if name not in current:
+            print('{:{width}}  {:>12.1f}  {:>12}  {:>8}'.format(
+                name, baseline[name]['time'], 'missing', '-',
+                width=name_width))
+            continue
+        if name not in baseline:
+            print('{:{width}}  {:>12}  {:>12.1f}  {:>8}'.format(
+                name, 'missing', current[name]['time'], '-',
+                width=name_width))
+            continue
+        if baseline[name]['time_unit'] != current[name]['time_unit']:
+            raise Exception('Time unit mismatch for "' + name + '"')
+        ratio = current[name]['time'] / baseline[name]['time']
+        regressed = ratio > 1 + args.tolerance
+        print('{:{width}}  {:>12.1f}  {:>12.1f}  {:>8.3f}{}'.format(
+            name, baseline[name]['time'], current[name]['time'], ratio,
+            '  REGRESSED' if regressed else '', width=name_width))
+        if regressed:
+            regressions.append(name)
+
+    if regressions:
+        print('\n{} benchmark(s) regressed by more than {:.0%}:'.format(
+            len(regressions), args.tolerance))
+        for name in regressions:
+            print('  ' + name)
+
+    return len(regressions)
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -17,6 +17,7 @@
 #include <ArborX_Box.hpp>
 #include <ArborX_BruteForce.hpp>
 #ifdef ARBORX_ENABLE_MPI
+#include <ArborX_DistributedDBSCAN.hpp>
 #include <ArborX_DistributedTree.hpp>
 #endif
 #include <ArborX_CrsGraphWrapper.hpp>
@@ -0,0 +1,118 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_AUTO_INDEX_HPP
+#define ARBORX_AUTO_INDEX_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_BruteForce.hpp>
+#include <ArborX_DetailsKokkosExtAccessibilityTraits.hpp>
+#include <ArborX_LinearBVH.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <utility>
+
+namespace ArborX::Experimental
+{
+
+// Adaptive index that dispatches to BruteForce below a problem-size
+// crossover and to BoundingVolumeHierarchy above it. For small primitive
+// counts checking every predicate against every primitive is faster than
+// building and traversing a hierarchy (see benchmarks/brute_force_vs_bvh);
+// the crossover depends on the backend, so the default model distinguishes
+// host and device execution spaces and can be overridden per instance when
+// a measured value is available.
+template <typename MemorySpace, typename Value,
+          typename IndexableGetter = Details::DefaultIndexableGetter>
+class AutoIndex
+{
+private:
+  using BruteForceIndex = BruteForce<MemorySpace, Value, IndexableGetter>;
+  using TreeIndex =
+      BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter>;
+
+public:
+  using memory_space = MemorySpace;
+  static_assert(Kokkos::is_memory_space<MemorySpace>::value);
+  using size_type = typename MemorySpace::size_type;
+  using bounding_volume_type = typename TreeIndex::bounding_volume_type;
+  using value_type = Value;
+
+  // Modeled crossover below which the quadratic scan wins. Device backends
+  // amortize the all-pairs work over many threads and profit from the
+  // avoided build until several thousand primitives; on host backends the
+  // build is cheap relative to the scan much earlier.
+  template <typename ExecutionSpace>
+  static int defaultCrossover()
+  {
+    constexpr bool is_host_like = Details::KokkosExt::is_accessible_from<
+        Kokkos::HostSpace, ExecutionSpace>::value;
+    return is_host_like ? 256 : 8192;
+  }
+
+  AutoIndex() = default; // build an empty index
+
+  template <typename ExecutionSpace, typename Values>
+  AutoIndex(ExecutionSpace const &space, Values const &values,
+            IndexableGetter const &indexable_getter = IndexableGetter(),
+            int crossover = -1)
+  {
+    if (crossover < 0)
+      crossover = defaultCrossover<ExecutionSpace>();
+
+    auto const n = AccessTraits<Values, PrimitivesTag>::size(values);
+    _use_brute_force = ((decltype(crossover))n <= crossover);
+    if (_use_brute_force)
+      _brute_force = BruteForceIndex(space, values, indexable_getter);
+    else
+      _tree = TreeIndex(space, values, indexable_getter);
+  }
+
+  KOKKOS_FUNCTION
+  size_type size() const noexcept
+  {
+    return _use_brute_force ? _brute_force.size() : _tree.size();
+  }
+
+  KOKKOS_FUNCTION
+  bool empty() const noexcept { return size() == 0; }
+
+  KOKKOS_FUNCTION
+  bounding_volume_type bounds() const noexcept
+  {
+    return _use_brute_force ? _brute_force.bounds() : _tree.bounds();
+  }
+
+  template <typename ExecutionSpace, typename... Args>
+  void query(ExecutionSpace const &space, Args &&...args) const
+  {
+    if (_use_brute_force)
+      _brute_force.query(space, std::forward<Args>(args)...);
+    else
+      _tree.query(space, std::forward<Args>(args)...);
+  }
+
+  KOKKOS_FUNCTION auto const &indexable_get() const
+  {
+    return _use_brute_force ? _brute_force.indexable_get()
+                            : _tree.indexable_get();
+  }
+
+private:
+  bool _use_brute_force = false;
+  BruteForceIndex _brute_force;
+  TreeIndex _tree;
+};
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -0,0 +1,688 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_BVH_FOREST_HPP
+#define ARBORX_BVH_FOREST_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_Callbacks.hpp>
+#include <ArborX_CrsGraphWrapper.hpp>
+#include <ArborX_DetailsCrsGraphWrapperImpl.hpp>
+#include <ArborX_DetailsKokkosExtAccessibilityTraits.hpp>
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DetailsLegacy.hpp>
+#include <ArborX_DetailsNearestBufferProvider.hpp>
+#include <ArborX_DetailsNode.hpp>
+#include <ArborX_DetailsPriorityQueue.hpp>
+#include <ArborX_DetailsSortUtils.hpp>
+#include <ArborX_DetailsTreeConstruction.hpp>
+#include <ArborX_Exception.hpp>
+#include <ArborX_GeometryTraits.hpp>
+#include <ArborX_HyperBox.hpp>
+#include <ArborX_IndexableGetter.hpp>
+#include <ArborX_PairValueIndex.hpp>
+#include <ArborX_Predicates.hpp>
+#include <ArborX_SpaceFillingCurves.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+namespace ArborX::Experimental
+{
+
+// A batch of independent bounding volume hierarchies built in one fused
+// construction sweep. Building many small trees through the
+// BoundingVolumeHierarchy constructor serializes on kernel-launch latency and
+// on one scene-bounds reduction per tree; the forest instead computes all
+// per-tree bounds in one kernel, sorts all values once by a composite
+// (tree, Morton) key, and generates every hierarchy in a single launch. The
+// composite key confines each tree to a contiguous code range, which the
+// Karras-style construction necessarily emits as a complete subtree, so each
+// tree is recovered as a (root, rope exit) pair and traversed independently.
+// Predicates either target a single tree (spatial only) or fan out across
+// the whole forest, in which case the per-tree subtrees are searched through
+// their shared global hierarchy: spatial matches from all trees merge into
+// one result set, and the distance bound of a nearest query tightened in one
+// tree prunes every other tree for free.
+template <typename MemorySpace, typename Value,
+          typename IndexableGetter = Details::DefaultIndexableGetter>
+class BVHForest
+{
+private:
+  using indexable_type =
+      std::decay_t<std::invoke_result_t<IndexableGetter, Value>>;
+
+public:
+  using memory_space = MemorySpace;
+  static_assert(Kokkos::is_memory_space<MemorySpace>::value);
+  using size_type = typename MemorySpace::size_type;
+  using value_type = Value;
+  using bounding_volume_type = ExperimentalHyperGeometry::Box<
+      GeometryTraits::dimension_v<indexable_type>,
+      typename GeometryTraits::coordinate_type_t<indexable_type>>;
+
+  BVHForest() = default; // build an empty forest
+
+  // Tree t owns the values in [offsets(t), offsets(t + 1))
+  template <typename ExecutionSpace, typename UserValues, typename Offsets>
+  BVHForest(ExecutionSpace const &space, UserValues const &user_values,
+            Offsets const &offsets,
+            IndexableGetter const &indexable_getter = IndexableGetter());
+
+  KOKKOS_FUNCTION
+  size_type size() const noexcept { return _size; }
+
+  KOKKOS_FUNCTION
+  bool empty() const noexcept { return size() == 0; }
+
+  KOKKOS_FUNCTION
+  int numTrees() const noexcept { return _roots.extent_int(0); }
+
+  // Bounds of all trees together
+  KOKKOS_FUNCTION
+  bounding_volume_type bounds() const noexcept { return _bounds; }
+
+  // Bounds of a single tree, or an invalid box for an empty tree
+  KOKKOS_FUNCTION
+  bounding_volume_type bounds(int t) const noexcept
+  {
+    int const root = _roots(t);
+    int const n = _leaf_nodes.extent_int(0);
+    bounding_volume_type box{};
+    if (root < 0)
+      return box;
+    if (root < n)
+    {
+      Details::expand(box, _indexable_getter(_leaf_nodes(root).value));
+      return box;
+    }
+    return _internal_nodes(root - n).bounding_volume;
+  }
+
+  // Each predicate queries the single tree given by the aligned entry of
+  // tree_indices
+  template <typename ExecutionSpace, typename UserPredicates,
+            typename TreeIndices, typename Callback>
+  std::enable_if_t<!Kokkos::is_view_v<Callback>>
+  query(ExecutionSpace const &space, UserPredicates const &user_predicates,
+        TreeIndices const &tree_indices, Callback const &callback) const;
+
+  // Each predicate queries all trees of the forest. The trees share one
+  // global hierarchy, so spatial matches merge naturally and the pruning
+  // radius of a nearest query carries across tree boundaries.
+  template <typename ExecutionSpace, typename UserPredicates, typename Callback,
+            typename Ignore = int>
+  std::enable_if_t<!Kokkos::is_view_v<Callback>>
+  query(ExecutionSpace const &space, UserPredicates const &user_predicates,
+        Callback const &callback, Ignore = Ignore()) const;
+
+  template <typename ExecutionSpace, typename UserPredicates,
+            typename CallbackOrView, typename View, typename... Args>
+  std::enable_if_t<Kokkos::is_view_v<std::decay_t<View>>>
+  query(ExecutionSpace const &space, UserPredicates const &user_predicates,
+        CallbackOrView &&callback_or_view, View &&view, Args &&...args) const
+  {
+    Kokkos::Profiling::ScopedRegion guard("ArborX::BVHForest::query_crs");
+
+    Details::CrsGraphWrapperImpl::
+        check_valid_callback_if_first_argument_is_not_a_view<value_type>(
+            callback_or_view, user_predicates, view);
+
+    using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+    using Tag = typename Predicates::value_type::Tag;
+
+    // Automatically add LegacyDefaultCallback if
+    //   1. A user does not provide a callback
+    //   2. The index is constructed on PairValueIndex
+    //   3. The output value_type is an integral type
+    constexpr bool use_convenient_shortcut = []() {
+      if constexpr (!Kokkos::is_view_v<std::decay_t<CallbackOrView>>)
+        return false;
+      else if constexpr (!Details::is_pair_value_index_v<value_type>)
+        return false;
+      else
+        return std::is_integral_v<
+            typename std::decay_t<CallbackOrView>::value_type>;
+    }();
+
+    if constexpr (use_convenient_shortcut)
+    {
+      // Simplified way to get APIv1 result using APIv2 interface
+      Details::CrsGraphWrapperImpl::queryDispatch(
+          Tag{}, *this, space, Predicates{user_predicates},
+          Details::LegacyDefaultCallback{}, // inject legacy callback arg
+          std::forward<CallbackOrView>(callback_or_view),
+          std::forward<View>(view), std::forward<Args>(args)...);
+      return;
+    }
+    else
+    {
+      Details::CrsGraphWrapperImpl::queryDispatch(
+          Tag{}, *this, space, Predicates{user_predicates},
+          std::forward<CallbackOrView>(callback_or_view),
+          std::forward<View>(view), std::forward<Args>(args)...);
+    }
+  }
+
+  KOKKOS_FUNCTION auto const &indexable_get() const
+  {
+    return _indexable_getter;
+  }
+
+private:
+  template <typename Predicates, typename TreeIndices, typename Callback>
+  struct SpatialQuery
+  {
+    BVHForest _forest;
+    Predicates _predicates;
+    TreeIndices _tree_indices;
+    Callback _callback;
+
+    KOKKOS_FUNCTION void operator()(int query_index) const
+    {
+      auto const &predicate = _predicates(query_index);
+
+      int node = _forest._roots(_tree_indices(query_index));
+      if (node < 0) // empty tree
+        return;
+      // Ropes of the right-most path of a subtree all point to the first
+      // node past the subtree, so the tree's traversal terminates there
+      // instead of at the global rope sentinel
+      int const exit = _forest._exits(_tree_indices(query_index));
+      int const n = _forest._leaf_nodes.extent_int(0);
+      while (node != exit)
+      {
+        if (node < n)
+        {
+          auto const &leaf = _forest._leaf_nodes(node);
+          if (predicate(_forest._indexable_getter(leaf.value)) &&
+              Details::invoke_callback_and_check_early_exit(
+                  _callback, predicate, leaf.value))
+            return;
+          node = leaf.rope;
+        }
+        else
+        {
+          auto const &internal = _forest._internal_nodes(node - n);
+          node = (predicate(internal.bounding_volume) ? internal.left_child
+                                                      : internal.rope);
+        }
+      }
+    }
+  };
+
+  // The global root is the first internal node, or the only leaf of a
+  // single-value forest
+  KOKKOS_FUNCTION int globalRoot() const
+  {
+    int const n = _leaf_nodes.extent_int(0);
+    return n > 1 ? n : 0;
+  }
+
+  template <typename Predicates, typename Callback>
+  struct AllTreesSpatialQuery
+  {
+    BVHForest _forest;
+    Predicates _predicates;
+    Callback _callback;
+
+    KOKKOS_FUNCTION void operator()(int query_index) const
+    {
+      auto const &predicate = _predicates(query_index);
+
+      // All trees are subtrees of the global hierarchy, so searching the
+      // whole forest is a plain traversal from the global root
+      int const n = _forest._leaf_nodes.extent_int(0);
+      int node = _forest.globalRoot();
+      while (node != Details::ROPE_SENTINEL)
+      {
+        if (node < n)
+        {
+          auto const &leaf = _forest._leaf_nodes(node);
+          if (predicate(_forest._indexable_getter(leaf.value)) &&
+              Details::invoke_callback_and_check_early_exit(
+                  _callback, predicate, leaf.value))
+            return;
+          node = leaf.rope;
+        }
+        else
+        {
+          auto const &internal = _forest._internal_nodes(node - n);
+          node = (predicate(internal.bounding_volume) ? internal.left_child
+                                                      : internal.rope);
+        }
+      }
+    }
+  };
+
+  template <typename Predicates, typename Callback>
+  struct AllTreesNearestQuery
+  {
+    using PairIndexDistance =
+        typename Details::NearestBufferProvider<MemorySpace>::PairIndexDistance;
+
+    BVHForest _forest;
+    Predicates _predicates;
+    Callback _callback;
+    Details::NearestBufferProvider<MemorySpace> _buffer;
+
+    KOKKOS_FUNCTION void operator()(int query_index) const
+    {
+      auto const &predicate = _predicates(query_index);
+      int const k = getK(predicate);
+
+      if (k < 1)
+        return;
+
+      auto const buffer = _buffer(query_index);
+      KOKKOS_ASSERT(k == (int)buffer.size());
+
+      struct CompareDistance
+      {
+        KOKKOS_INLINE_FUNCTION bool
+        operator()(PairIndexDistance const &lhs,
+                   PairIndexDistance const &rhs) const
+        {
+          return lhs.second < rhs.second;
+        }
+      };
+      Details::PriorityQueue<PairIndexDistance, CompareDistance,
+                             Details::UnmanagedStaticVector<PairIndexDistance>>
+          heap(Details::UnmanagedStaticVector<PairIndexDistance>(
+              buffer.data(), buffer.size()));
+
+      int const n = _forest._leaf_nodes.extent_int(0);
+      auto const &forest = _forest;
+      auto const distance = [&predicate, &forest, n](int j) {
+        return j < n ? predicate.distance(forest._indexable_getter(
+                           forest._leaf_nodes(j).value))
+                     : predicate.distance(
+                           forest._internal_nodes(j - n).bounding_volume);
+      };
+
+      // The bound tightened in one tree prunes all the others, since the
+      // trees are traversed through the hierarchy they share
+      auto radius =
+          Details::KokkosExt::ArithmeticTraits::infinity<float>::value;
+      auto const insert = [&](int leaf, float leaf_distance) {
+        auto leaf_pair = Kokkos::make_pair(leaf, leaf_distance);
+        if ((int)heap.size() < k)
+          heap.push(leaf_pair);
+        else
+          heap.popPush(leaf_pair);
+        if ((int)heap.size() == k)
+          radius = heap.top().second;
+      };
+
+      if (n == 1)
+      {
+        insert(0, distance(0));
+      }
+      else
+      {
+        constexpr int SENTINEL = -1;
+        int stack[64];
+        auto *stack_ptr = stack;
+        *stack_ptr++ = SENTINEL;
+
+        int node = _forest.globalRoot();
+        float distance_node = 0.f;
+
+        do
+        {
+          bool traverse_left = false;
+          bool traverse_right = false;
+
+          int left_child;
+          int right_child;
+          float distance_left = 0.f;
+          float distance_right = 0.f;
+
+          if (distance_node < radius)
+          {
+            left_child = _forest._internal_nodes(node - n).left_child;
+            // The rope of the left child points to its right sibling
+            right_child =
+                (left_child < n
+                     ? _forest._leaf_nodes(left_child).rope
+                     : _forest._internal_nodes(left_child - n).rope);
+
+            distance_left = distance(left_child);
+            distance_right = distance(right_child);
+
+            if (distance_left < radius)
+            {
+              if (left_child < n)
+                insert(left_child, distance_left);
+              else
+                traverse_left = true;
+            }
+
+            // Note: radius may have been already updated here from the left
+            // child
+            if (distance_right < radius)
+            {
+              if (right_child < n)
+                insert(right_child, distance_right);
+              else
+                traverse_right = true;
+            }
+          }
+
+          if (!traverse_left && !traverse_right)
+          {
+            node = *--stack_ptr;
+            if (node != SENTINEL)
+              distance_node = distance(node);
+          }
+          else
+          {
+            node = (traverse_left &&
+                    (distance_left <= distance_right || !traverse_right))
+                       ? left_child
+                       : right_child;
+            distance_node =
+                (node == left_child ? distance_left : distance_right);
+            if (traverse_left && traverse_right)
+              *stack_ptr++ = (node == left_child ? right_child : left_child);
+          }
+        } while (node != SENTINEL);
+      }
+
+      // Ascending-distance output, consistent with the single-tree traversal
+      Details::sortHeap(heap.data(), heap.data() + heap.size(),
+                        heap.valueComp());
+      for (decltype(heap.size()) i = 0; i < heap.size(); ++i)
+        _callback(predicate,
+                  _forest._leaf_nodes((heap.data() + i)->first).value);
+    }
+  };
+
+  size_type _size{0};
+  bounding_volume_type _bounds;
+  Kokkos::View<Details::LeafNode<Value> *, MemorySpace> _leaf_nodes;
+  Kokkos::View<Details::InternalNode<bounding_volume_type> *, MemorySpace>
+      _internal_nodes;
+  // Combined node index of every tree's subtree root (-1 for empty trees)
+  // and of the first node past the subtree
+  Kokkos::View<int *, MemorySpace> _roots;
+  Kokkos::View<int *, MemorySpace> _exits;
+  IndexableGetter _indexable_getter;
+};
+
+template <typename MemorySpace, typename Value, typename IndexableGetter>
+template <typename ExecutionSpace, typename UserValues, typename Offsets>
+BVHForest<MemorySpace, Value, IndexableGetter>::BVHForest(
+    ExecutionSpace const &space, UserValues const &user_values,
+    Offsets const &offsets, IndexableGetter const &indexable_getter)
+    : _size(AccessTraits<UserValues, PrimitivesTag>::size(user_values))
+    , _leaf_nodes(Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                                     "ArborX::BVHForest::leaf_nodes"),
+                  _size)
+    , _internal_nodes(Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                                         "ArborX::BVHForest::internal_nodes"),
+                      _size > 1 ? _size - 1 : 0)
+    , _indexable_getter(indexable_getter)
+{
+  static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
+                                                       ExecutionSpace>::value);
+  static_assert(Kokkos::is_view_v<Offsets> &&
+                std::is_same_v<typename Offsets::non_const_value_type, int>);
+  Details::check_valid_access_traits<UserValues>(
+      PrimitivesTag{}, user_values, Details::DoNotCheckGetReturnType());
+
+  using Values = Details::AccessValues<UserValues, PrimitivesTag>;
+  Values values{user_values}; // NOLINT
+
+  static_assert(
+      Details::KokkosExt::is_accessible_from<typename Values::memory_space,
+                                             ExecutionSpace>::value,
+      "Values must be accessible from the execution space");
+
+  Kokkos::Profiling::ScopedRegion guard("ArborX::BVHForest::BVHForest");
+
+  // On multi-socket hosts, place the node pages with the threads that will
+  // sweep the same index ranges in later statically scheduled kernels
+  Details::KokkosExt::firstTouch(space, _leaf_nodes);
+  Details::KokkosExt::firstTouch(space, _internal_nodes);
+
+  int const n = _size;
+  int const num_trees = offsets.extent_int(0) - 1;
+  ARBORX_ASSERT(num_trees >= 1);
+  ARBORX_ASSERT(Details::KokkosExt::lastElement(space, offsets) == n);
+
+  _roots = Kokkos::View<int *, MemorySpace>(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::BVHForest::roots"),
+      num_trees);
+  _exits = Kokkos::View<int *, MemorySpace>(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::BVHForest::exits"),
+      num_trees);
+
+  auto const &getter = _indexable_getter;
+
+  if (n > 0)
+  {
+    // One sweep for all per-tree scene bounds instead of one reduction per
+    // tree; the trees are small, so the serial inner loop is cheap
+    Kokkos::View<bounding_volume_type *, MemorySpace> tree_boxes(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::BVHForest::tree_boxes"),
+        num_trees);
+    Kokkos::View<int *, MemorySpace> tree_ids(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::BVHForest::tree_ids"),
+        n);
+    Kokkos::parallel_for(
+        "ArborX::BVHForest::BVHForest::compute_tree_bounds",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_trees),
+        KOKKOS_LAMBDA(int t) {
+          bounding_volume_type box{};
+          for (int j = offsets(t); j < offsets(t + 1); ++j)
+          {
+            tree_ids(j) = t;
+            Details::expand(box, getter(values(j)));
+          }
+          tree_boxes(t) = box;
+        });
+
+    // Shared sort: the tree index occupies the high bits, so values group by
+    // tree and order by the Morton code within their own tree's bounds. The
+    // cross-tree key distance always exceeds any within-tree distance, which
+    // makes the hierarchy construction emit every tree as a complete subtree.
+    Kokkos::View<unsigned long long *, MemorySpace> keys(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::BVHForest::keys"),
+        n);
+    Kokkos::parallel_for(
+        "ArborX::BVHForest::BVHForest::compute_keys",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+          int const t = tree_ids(i);
+          keys(i) = ((unsigned long long)t << 32) |
+                    Morton32{}(tree_boxes(t), getter(values(i)));
+        });
+
+    auto permutation = Details::sortObjects(space, keys);
+
+    if (n > 1)
+    {
+      Details::TreeConstruction::generateHierarchy(
+          space, values, _indexable_getter, permutation, keys, _leaf_nodes,
+          _internal_nodes, _bounds);
+    }
+    else
+    {
+      Details::TreeConstruction::initializeSingleLeafTree(
+          space, values, _indexable_getter, _leaf_nodes, _bounds);
+    }
+  }
+
+  // Recover every tree's subtree root by narrowing down from the global
+  // root, keeping track of the current node's range: the left child's range
+  // ends at the leftmost leaf under the right child. A tree's range cannot
+  // straddle a split since it forms a complete subtree.
+  auto const &leaf_nodes = _leaf_nodes;
+  auto const &internal_nodes = _internal_nodes;
+  auto const &roots = _roots;
+  auto const &exits = _exits;
+  Kokkos::parallel_for(
+      "ArborX::BVHForest::BVHForest::locate_tree_roots",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_trees),
+      KOKKOS_LAMBDA(int t) {
+        int const b = offsets(t);
+        int const e = offsets(t + 1);
+        if (b == e)
+        {
+          roots(t) = -1;
+          exits(t) = -1;
+          return;
+        }
+
+        int node = (n > 1 ? n : 0); // global root
+        int range_begin = 0;
+        int range_end = n;
+        while (range_begin != b || range_end != e)
+        {
+          int const left = internal_nodes(node - n).left_child;
+          int const right = (left < n ? leaf_nodes(left).rope
+                                      : internal_nodes(left - n).rope);
+          int split = right;
+          while (split >= n)
+            split = internal_nodes(split - n).left_child;
+          if (e <= split)
+          {
+            node = left;
+            range_end = split;
+          }
+          else
+          {
+            node = right;
+            range_begin = split;
+          }
+        }
+        roots(t) = node;
+        exits(t) =
+            (node < n ? leaf_nodes(node).rope : internal_nodes(node - n).rope);
+      });
+}
+
+template <typename MemorySpace, typename Value, typename IndexableGetter>
+template <typename ExecutionSpace, typename UserPredicates,
+          typename TreeIndices, typename Callback>
+std::enable_if_t<!Kokkos::is_view_v<Callback>>
+BVHForest<MemorySpace, Value, IndexableGetter>::query(
+    ExecutionSpace const &space, UserPredicates const &user_predicates,
+    TreeIndices const &tree_indices, Callback const &callback) const
+{
+  static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
+                                                       ExecutionSpace>::value);
+  static_assert(Kokkos::is_view_v<TreeIndices> &&
+                std::is_same_v<typename TreeIndices::non_const_value_type, int>);
+  Details::check_valid_access_traits(PredicatesTag{}, user_predicates);
+  Details::check_valid_callback<value_type>(callback, user_predicates);
+
+  using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+  static_assert(
+      Details::KokkosExt::is_accessible_from<typename Predicates::memory_space,
+                                             ExecutionSpace>::value,
+      "Predicates must be accessible from the execution space");
+  Predicates predicates{user_predicates}; // NOLINT
+
+  using Tag = typename Predicates::value_type::Tag;
+  static_assert(std::is_same_v<Tag, Details::SpatialPredicateTag>,
+                "BVHForest only supports spatial predicates");
+
+  ARBORX_ASSERT(tree_indices.extent(0) == predicates.size());
+
+  Kokkos::Profiling::ScopedRegion guard("ArborX::BVHForest::query::spatial");
+
+  if (empty())
+  {
+    return;
+  }
+
+  Kokkos::parallel_for(
+      "ArborX::BVHForest::query::spatial",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, predicates.size()),
+      SpatialQuery<Predicates, TreeIndices, Callback>{*this, predicates,
+                                                      tree_indices, callback});
+}
+
+template <typename MemorySpace, typename Value, typename IndexableGetter>
+template <typename ExecutionSpace, typename UserPredicates, typename Callback,
+          typename Ignore>
+std::enable_if_t<!Kokkos::is_view_v<Callback>>
+BVHForest<MemorySpace, Value, IndexableGetter>::query(
+    ExecutionSpace const &space, UserPredicates const &user_predicates,
+    Callback const &callback, Ignore) const
+{
+  static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
+                                                       ExecutionSpace>::value);
+  Details::check_valid_access_traits(PredicatesTag{}, user_predicates);
+  Details::check_valid_callback<value_type>(callback, user_predicates);
+
+  using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+  static_assert(
+      Details::KokkosExt::is_accessible_from<typename Predicates::memory_space,
+                                             ExecutionSpace>::value,
+      "Predicates must be accessible from the execution space");
+  Predicates predicates{user_predicates}; // NOLINT
+
+  using Tag = typename Predicates::value_type::Tag;
+  static_assert(std::is_same_v<Tag, Details::SpatialPredicateTag> ||
+                    std::is_same_v<Tag, Details::NearestPredicateTag>,
+                "Forest-wide queries support spatial and nearest predicates");
+
+  if (empty())
+  {
+    return;
+  }
+
+  if constexpr (std::is_same_v<Tag, Details::SpatialPredicateTag>)
+  {
+    Kokkos::Profiling::ScopedRegion guard("ArborX::BVHForest::query::spatial");
+
+    Kokkos::parallel_for(
+        "ArborX::BVHForest::query::spatial",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, predicates.size()),
+        AllTreesSpatialQuery<Predicates, Callback>{*this, predicates,
+                                                   callback});
+  }
+  else
+  {
+    Kokkos::Profiling::ScopedRegion guard("ArborX::BVHForest::query::nearest");
+
+    Details::NearestBufferProvider<MemorySpace> buffer(space, predicates);
+
+    Kokkos::parallel_for(
+        "ArborX::BVHForest::query::nearest",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, predicates.size()),
+        AllTreesNearestQuery<Predicates, Callback>{*this, predicates, callback,
+                                                   buffer});
+  }
+}
+
+} // namespace ArborX::Experimental
+
+namespace ArborX::Details
+{
+// The forest traversals process each predicate on a single thread, so the
+// CRS machinery does not need atomic insertion
+template <typename MemorySpace, typename Value, typename IndexableGetter>
+struct TraversalInvokesCallbacksConcurrently<
+    Experimental::BVHForest<MemorySpace, Value, IndexableGetter>>
+    : std::false_type
+{};
+} // namespace ArborX::Details
+
+#endif
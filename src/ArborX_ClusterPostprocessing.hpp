@@ -0,0 +1,172 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_CLUSTER_POSTPROCESSING_HPP
+#define ARBORX_CLUSTER_POSTPROCESSING_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_Exception.hpp>
+#include <ArborX_GeometryTraits.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+namespace ArborX::Experimental
+{
+
+// Post-processing for the labels produced by the clustering algorithms
+// (dbscan(), DBSCANSweep, ...): the raw labels are representative point
+// indices scattered over [0, n), which every consumer then compacts with
+// its own multi-pass relabeling. relabelClusters() does the compaction in
+// the library with flat passes over the labels: it rewrites the labels to
+// dense cluster ids in [0, num_clusters), returns num_clusters, and fills
+// the per-cluster sizes. Clusters smaller than cluster_min_size are
+// demoted to noise (-1), matching the cluster_min_size filtering of the
+// dbscan benchmark driver. The ids are assigned in the order of the
+// representative indices, so the output is deterministic.
+template <typename ExecutionSpace, typename LabelsView, typename SizesView>
+int relabelClusters(ExecutionSpace const &space, LabelsView const &labels,
+                    SizesView &cluster_sizes, int cluster_min_size = 1)
+{
+  namespace KokkosExt = Details::KokkosExt;
+
+  static_assert(Kokkos::is_view_v<LabelsView>);
+  static_assert(Kokkos::is_view_v<SizesView>);
+  static_assert(std::is_same_v<typename LabelsView::value_type, int>);
+  static_assert(std::is_same_v<typename SizesView::value_type, int>);
+
+  using MemorySpace = typename LabelsView::memory_space;
+  static_assert(
+      KokkosExt::is_accessible_from<MemorySpace, ExecutionSpace>::value);
+
+  ARBORX_ASSERT(cluster_min_size >= 1);
+
+  Kokkos::Profiling::ScopedRegion guard("ArborX::relabelClusters");
+
+  int const n = labels.extent_int(0);
+
+  Kokkos::View<int *, MemorySpace> counts("ArborX::relabelClusters::counts",
+                                          n);
+  Kokkos::parallel_for(
+      "ArborX::relabelClusters::count_labels",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        if (labels(i) >= 0)
+          Kokkos::atomic_increment(&counts(labels(i)));
+      });
+
+  // A representative (the point whose label is its own index) of a cluster
+  // that survives the size filter gets the next dense id; everybody else
+  // resolves through its representative in the relabeling pass
+  Kokkos::View<int *, MemorySpace> dense_ids(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::relabelClusters::dense_ids"),
+      n);
+  int num_clusters;
+  Kokkos::parallel_scan(
+      "ArborX::relabelClusters::assign_dense_ids",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i, int &update, bool final_pass) {
+        bool const is_cluster =
+            (labels(i) == i && counts(i) >= cluster_min_size);
+        if (final_pass)
+          dense_ids(i) = (is_cluster ? update : -1);
+        if (is_cluster)
+          ++update;
+      },
+      num_clusters);
+
+  KokkosExt::reallocWithoutInitializing(space, cluster_sizes, num_clusters);
+  auto sizes = cluster_sizes;
+  Kokkos::parallel_for(
+      "ArborX::relabelClusters::relabel",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        int const label = labels(i);
+        if (label < 0)
+          return;
+        int const dense = dense_ids(label);
+        labels(i) = dense;
+        if (dense >= 0 && label == i)
+          sizes(dense) = counts(i);
+      });
+
+  return num_clusters;
+}
+
+// Overload also producing the cluster centroids in one extra pass over the
+// points. The centroids view holds one point per cluster; the coordinate
+// sums are accumulated with atomics, so the low bits of the centroids may
+// vary from run to run on backends with nondeterministic atomic ordering.
+template <typename ExecutionSpace, typename LabelsView, typename Primitives,
+          typename SizesView, typename CentroidsView>
+int relabelClusters(ExecutionSpace const &space, LabelsView const &labels,
+                    Primitives const &primitives, SizesView &cluster_sizes,
+                    CentroidsView &centroids, int cluster_min_size = 1)
+{
+  namespace KokkosExt = Details::KokkosExt;
+
+  static_assert(Kokkos::is_view_v<CentroidsView>);
+  using Point = typename CentroidsView::value_type;
+  static_assert(GeometryTraits::is_point_v<Point>);
+  constexpr int DIM = GeometryTraits::dimension_v<Point>;
+  using Coordinate = GeometryTraits::coordinate_type_t<Point>;
+
+  Details::check_valid_access_traits<Primitives>(
+      PrimitivesTag{}, primitives, Details::DoNotCheckGetReturnType());
+  using Points = Details::AccessValues<Primitives, PrimitivesTag>;
+  static_assert(
+      KokkosExt::is_accessible_from<typename Points::memory_space,
+                                    ExecutionSpace>::value,
+      "Primitives must be accessible from the execution space");
+  Points points{primitives}; // NOLINT
+
+  int const n = labels.extent_int(0);
+  ARBORX_ASSERT((int)points.size() == n);
+
+  int const num_clusters =
+      relabelClusters(space, labels, cluster_sizes, cluster_min_size);
+
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::relabelClusters::centroids");
+
+  KokkosExt::reallocWithoutInitializing(space, centroids, num_clusters);
+  Kokkos::parallel_for(
+      "ArborX::relabelClusters::init_centroids",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_clusters),
+      KOKKOS_LAMBDA(int c) {
+        for (int d = 0; d < DIM; ++d)
+          centroids(c)[d] = 0;
+      });
+  Kokkos::parallel_for(
+      "ArborX::relabelClusters::accumulate_centroids",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        int const label = labels(i);
+        if (label < 0)
+          return;
+        auto const &point = points(i);
+        for (int d = 0; d < DIM; ++d)
+          Kokkos::atomic_add(&centroids(label)[d], (Coordinate)point[d]);
+      });
+  auto const sizes = cluster_sizes;
+  Kokkos::parallel_for(
+      "ArborX::relabelClusters::normalize_centroids",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_clusters),
+      KOKKOS_LAMBDA(int c) {
+        for (int d = 0; d < DIM; ++d)
+          centroids(c)[d] /= sizes(c);
+      });
+
+  return num_clusters;
+}
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -12,6 +12,11 @@
 #ifndef ARBORX_CRS_GRAPH_WRAPPER_HPP
 #define ARBORX_CRS_GRAPH_WRAPPER_HPP
 
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_DetailsCrsGraphWrapperImpl.hpp>
+#include <ArborX_Exception.hpp>
+#include <ArborX_TraversalPolicy.hpp>
+
 #include <Kokkos_Core.hpp>
 
 namespace ArborX
@@ -30,6 +35,186 @@ inline void query(Tree const &tree, ExecutionSpace const &space,
              std::forward<View>(view), std::forward<Args>(args)...);
 }
 
+namespace Experimental
+{
+
+// Query into caller-preallocated storage. 'offset' holds the CRS layout of
+// the per-query result capacities (one more entry than there are predicates)
+// and is left untouched; on return the first counts(i) entries of query i's
+// slice of 'values' hold its results. Returns true if at least one query
+// produced more results than its capacity, in which case the extra results of
+// that query are dropped and counts(i) is clamped to the capacity. No view is
+// ever resized, so steady-state callers whose result sizes are stable can
+// reuse the same three views on every call without allocating.
+template <typename Tree, typename ExecutionSpace, typename UserPredicates,
+          typename Callback, typename Values, typename Offset, typename Counts>
+std::enable_if_t<!Kokkos::is_view_v<Callback>, bool>
+query_into(Tree const &tree, ExecutionSpace const &space,
+           UserPredicates const &user_predicates, Callback const &callback,
+           Values const &values, Offset const &offset, Counts const &counts,
+           TraversalPolicy const &policy = TraversalPolicy())
+{
+  static_assert(Kokkos::is_execution_space<ExecutionSpace>::value);
+  static_assert(Kokkos::is_view_v<Values> && Kokkos::is_view_v<Offset> &&
+                Kokkos::is_view_v<Counts>);
+
+  Details::check_valid_access_traits(PredicatesTag{}, user_predicates);
+
+  using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+  return Details::CrsGraphWrapperImpl::queryIntoPreallocated(
+      tree, space, Predicates{user_predicates}, callback, values, offset,
+      counts, policy);
+}
+
+template <typename Tree, typename ExecutionSpace, typename UserPredicates,
+          typename Values, typename Offset, typename Counts>
+std::enable_if_t<Kokkos::is_view_v<Values>, bool>
+query_into(Tree const &tree, ExecutionSpace const &space,
+           UserPredicates const &user_predicates, Values const &values,
+           Offset const &offset, Counts const &counts,
+           TraversalPolicy const &policy = TraversalPolicy())
+{
+  return query_into(tree, space, user_predicates, Details::DefaultCallback{},
+                    values, offset, counts, policy);
+}
+
+// Count-only query: runs just the counting traversal and the scan, skipping
+// the result allocation and the fill pass of the regular two-pass query. On
+// return 'offset' holds one more entry than there are predicates, with
+// offset(i + 1) - offset(i) the number of results query i would produce
+// (i.e., the number of insertions the callback would perform). Intended for
+// callers that only consume the counts, e.g. density estimation or choosing
+// a radius adaptively before a full query.
+template <typename Tree, typename ExecutionSpace, typename UserPredicates,
+          typename Callback, typename Offset>
+std::enable_if_t<!Kokkos::is_view_v<Callback>>
+query_counts(Tree const &tree, ExecutionSpace const &space,
+             UserPredicates const &user_predicates, Callback const &callback,
+             Offset &offset, TraversalPolicy const &policy = TraversalPolicy())
+{
+  static_assert(Kokkos::is_execution_space<ExecutionSpace>::value);
+  static_assert(Kokkos::is_view_v<Offset>);
+
+  Details::check_valid_access_traits(PredicatesTag{}, user_predicates);
+
+  using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+  Details::CrsGraphWrapperImpl::queryCounts(
+      tree, space, Predicates{user_predicates}, callback, offset, policy);
+}
+
+template <typename Tree, typename ExecutionSpace, typename UserPredicates,
+          typename Offset>
+std::enable_if_t<Kokkos::is_view_v<Offset>>
+query_counts(Tree const &tree, ExecutionSpace const &space,
+             UserPredicates const &user_predicates, Offset &offset,
+             TraversalPolicy const &policy = TraversalPolicy())
+{
+  query_counts(tree, space, user_predicates, Details::DefaultCallback{}, offset,
+               policy);
+}
+
+// Streamed query for result sets larger than the device memory, which the
+// regular query would fail to allocate. The count pass runs over all
+// predicates (the offsets are one integer per predicate), then the fill pass
+// runs in predicate chunks whose results fit in 'buffer_capacity' entries of
+// device memory, draining each chunk's slice of the output to the host views
+// while the next chunk traverses on a second execution space instance. On
+// return 'values' and 'offset' hold the same CRS result the regular query
+// would have produced, only in host memory. Allocate them in
+// Kokkos::SharedHostPinnedSpace for the drains to overlap with the
+// traversals; with pageable memory the copies serialize, but the device
+// footprint still holds. A chunk must hold every result of each of its
+// predicates, so that footprint is at most twice max(buffer_capacity,
+// largest single-predicate count) entries.
+template <typename Tree, typename ExecutionSpace, typename UserPredicates,
+          typename Callback, typename HostValues, typename HostOffset>
+std::enable_if_t<!Kokkos::is_view_v<Callback>>
+query_to_host(Tree const &tree, ExecutionSpace const &space,
+              UserPredicates const &user_predicates, Callback const &callback,
+              HostValues &values, HostOffset &offset, size_t buffer_capacity,
+              TraversalPolicy const &policy = TraversalPolicy())
+{
+  static_assert(Kokkos::is_execution_space<ExecutionSpace>::value);
+  static_assert(Kokkos::is_view_v<HostValues> && Kokkos::is_view_v<HostOffset>);
+  static_assert(
+      Kokkos::SpaceAccessibility<Kokkos::DefaultHostExecutionSpace,
+                                 typename HostValues::memory_space>::accessible &&
+          Kokkos::SpaceAccessibility<
+              Kokkos::DefaultHostExecutionSpace,
+              typename HostOffset::memory_space>::accessible,
+      "Output views must be accessible from the host");
+
+  ARBORX_ASSERT(buffer_capacity > 0);
+
+  Details::check_valid_access_traits(PredicatesTag{}, user_predicates);
+
+  using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+  Details::CrsGraphWrapperImpl::queryToHost(tree, space,
+                                            Predicates{user_predicates},
+                                            callback, values, offset,
+                                            buffer_capacity, policy);
+}
+
+template <typename Tree, typename ExecutionSpace, typename UserPredicates,
+          typename HostValues, typename HostOffset>
+std::enable_if_t<Kokkos::is_view_v<HostValues>>
+query_to_host(Tree const &tree, ExecutionSpace const &space,
+              UserPredicates const &user_predicates, HostValues &values,
+              HostOffset &offset, size_t buffer_capacity,
+              TraversalPolicy const &policy = TraversalPolicy())
+{
+  query_to_host(tree, space, user_predicates, Details::DefaultCallback{},
+                values, offset, buffer_capacity, policy);
+}
+
+// Fused query over a heterogeneous predicate batch: a spatial, a nearest and
+// an ordered-spatial set run against the same tree in one pipeline, sharing
+// the fixed per-call costs (the permutation computations, the offsets scan,
+// the host synchronization and the result allocation) that three separate
+// query calls would pay three times. Any of the sets may be empty. On return
+// 'offset' holds one row per predicate across all three sets, segmented by
+// type in argument order — rows [0, n_spatial) belong to the spatial
+// queries, followed by the nearest and the ordered ones — and 'values' holds
+// the combined results, with each nearest query's segment ordered by
+// ascending distance as in the regular query.
+template <typename Tree, typename ExecutionSpace, typename SpatialPredicates,
+          typename NearestPredicates, typename OrderedPredicates,
+          typename Values, typename Offset>
+void query_mixed(Tree const &tree, ExecutionSpace const &space,
+                 SpatialPredicates const &spatial_predicates,
+                 NearestPredicates const &nearest_predicates,
+                 OrderedPredicates const &ordered_predicates, Values &values,
+                 Offset &offset, TraversalPolicy const &policy =
+                                     TraversalPolicy())
+{
+  static_assert(Kokkos::is_execution_space<ExecutionSpace>::value);
+  static_assert(Kokkos::is_view_v<Values> && Kokkos::is_view_v<Offset>);
+
+  Details::check_valid_access_traits(PredicatesTag{}, spatial_predicates);
+  Details::check_valid_access_traits(PredicatesTag{}, nearest_predicates);
+  Details::check_valid_access_traits(PredicatesTag{}, ordered_predicates);
+
+  using Spatial = Details::AccessValues<SpatialPredicates, PredicatesTag>;
+  using Nearest = Details::AccessValues<NearestPredicates, PredicatesTag>;
+  using Ordered = Details::AccessValues<OrderedPredicates, PredicatesTag>;
+
+  static_assert(std::is_same_v<typename Spatial::value_type::Tag,
+                               SpatialPredicateTag>,
+                "The first predicate set must be spatial");
+  static_assert(std::is_same_v<typename Nearest::value_type::Tag,
+                               NearestPredicateTag>,
+                "The second predicate set must be nearest");
+  static_assert(std::is_same_v<typename Ordered::value_type::Tag,
+                               OrderedSpatialPredicateTag>,
+                "The third predicate set must be ordered spatial");
+
+  Details::CrsGraphWrapperImpl::queryMixed(
+      tree, space, Spatial{spatial_predicates}, Nearest{nearest_predicates},
+      Ordered{ordered_predicates}, values, offset, policy);
+}
+
+} // namespace Experimental
+
 } // namespace ArborX
 
 #endif
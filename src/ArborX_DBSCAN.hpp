@@ -14,8 +14,10 @@
 
 #include <ArborX_AccessTraits.hpp>
 #include <ArborX_DetailsCartesianGrid.hpp>
+#include <ArborX_DetailsDBSCANRhoApproximate.hpp>
 #include <ArborX_DetailsFDBSCAN.hpp>
 #include <ArborX_DetailsFDBSCANDenseBox.hpp>
+#include <ArborX_DetailsFDBSCANGrid.hpp>
 #include <ArborX_DetailsHalfTraversal.hpp>
 #include <ArborX_DetailsKokkosExtAccessibilityTraits.hpp>
 #include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
@@ -181,14 +183,20 @@ namespace DBSCAN
 enum class Implementation
 {
   FDBSCAN,
-  FDBSCAN_DenseBox
+  FDBSCAN_DenseBox,
+  FDBSCAN_Grid,
+  // Approximate: clusters cell occupancy on an eps/sqrt(dim) grid instead of
+  // raw points, trading bounded label error near the eps boundary for
+  // skipping all point-level neighbor queries
+  RhoApproximate
 };
 
 struct Parameters
 {
   // Print timers to standard output
   bool _verbose = false;
-  // Algorithm implementation (FDBSCAN or FDBSCAN-DenseBox)
+  // Algorithm implementation (FDBSCAN, FDBSCAN-DenseBox, FDBSCAN-Grid or
+  // rho-approximate)
   Implementation _implementation = Implementation::FDBSCAN_DenseBox;
 
   Parameters &setVerbosity(bool verbose)
@@ -339,6 +347,7 @@ dbscan(ExecutionSpace const &exec_space, Primitives const &primitives,
 
     int num_nonempty_cells;
     int num_points_in_dense_cells;
+    int dense_cell_min_size;
     {
       // Reorder indices and permutation so that the dense cells go first
       Kokkos::View<int *, MemorySpace> cell_offsets(
@@ -347,8 +356,14 @@ dbscan(ExecutionSpace const &exec_space, Primitives const &primitives,
                                            cell_offsets);
       num_nonempty_cells = cell_offsets.size() - 1;
 
+      // core_min_size is only the floor for a cell to be merged directly;
+      // the cutoff is tuned from the occupancy distribution so that a long
+      // tail of barely-dense cells does not flood the tree with boxes
+      dense_cell_min_size = Details::tuneDenseCellCutoff(
+          exec_space, cell_offsets, core_min_size);
+
       num_points_in_dense_cells = Details::reorderDenseAndSparseCells(
-          exec_space, cell_offsets, core_min_size, sorted_cell_indices,
+          exec_space, cell_offsets, dense_cell_min_size, sorted_cell_indices,
           permute);
     }
     int num_points_in_sparse_cells = n - num_points_in_dense_cells;
@@ -368,6 +383,7 @@ dbscan(ExecutionSpace const &exec_space, Primitives const &primitives,
         printf(", %zu", grid.extent(d));
       printf("]\n");
       printf("#nonempty cells     : %10d\n", num_nonempty_cells);
+      printf("dense cell cutoff   : %10d\n", dense_cell_min_size);
       printf("#dense cells        : %10d [%.2f%%]\n", num_dense_cells,
              (100.f * num_dense_cells) / num_nonempty_cells);
       printf("#dense cell points  : %10d [%.2f%%]\n", num_points_in_dense_cells,
@@ -460,6 +476,147 @@ dbscan(ExecutionSpace const &exec_space, Primitives const &primitives,
       Kokkos::Profiling::popRegion();
     }
   }
+  else if (parameters._implementation == DBSCAN::Implementation::FDBSCAN_Grid)
+  {
+    // Bin the points into a grid, skipping hierarchy construction altogether.
+    // This is advantageous when most cells are populated, i.e., when the data
+    // is dense at the eps scale, as the stencil scans below then do little
+    // work beyond the unavoidable distance computations.
+    Kokkos::Profiling::pushRegion("ArborX::DBSCAN::grid");
+    Box bounds;
+    Details::TreeConstruction::calculateBoundingBoxOfTheScene(
+        exec_space,
+        Details::Indexables<Points, Details::DefaultIndexableGetter>{
+            points, Details::DefaultIndexableGetter{}},
+        bounds);
+
+    // The cell length is chosen to be eps, so that the neighbors of any point
+    // are guaranteed to be found in the 3^dim cells surrounding its own.
+    Details::CartesianGrid<dim> const grid(bounds, eps);
+
+    auto cell_indices = Details::computeCellIndices(exec_space, points, grid);
+
+    auto permute = Details::sortObjects(exec_space, cell_indices);
+    auto &sorted_cell_indices = cell_indices; // alias
+
+    Kokkos::Profiling::popRegion();
+
+    Kokkos::resize(Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing),
+                   labels, n);
+    KokkosExt::iota(exec_space, labels);
+
+    Kokkos::Profiling::pushRegion("ArborX::DBSCAN::clusters");
+
+    if (is_special_case)
+    {
+      using CorePoints = Details::CCSCorePoints;
+      Kokkos::Profiling::pushRegion("ArborX::DBSCAN::clusters::query");
+      Details::unionFindWithinGridStencil(exec_space, points, grid,
+                                          sorted_cell_indices, permute, eps,
+                                          CorePoints{}, UnionFind{labels});
+      Kokkos::Profiling::popRegion();
+    }
+    else
+    {
+      // Determine core points
+      Kokkos::Profiling::pushRegion("ArborX::DBSCAN::clusters::num_neigh");
+      Kokkos::resize(Kokkos::view_alloc(exec_space), num_neigh, n);
+      Details::countNeighborsWithinGridStencil(exec_space, points, grid,
+                                               sorted_cell_indices, permute,
+                                               eps, core_min_size, num_neigh);
+      Kokkos::Profiling::popRegion();
+
+      using CorePoints = Details::DBSCANCorePoints<MemorySpace>;
+
+      // Build clusters by scanning the stencil of every core point
+      Kokkos::Profiling::pushRegion("ArborX::DBSCAN::clusters::query");
+      Details::unionFindWithinGridStencil(
+          exec_space, points, grid, sorted_cell_indices, permute, eps,
+          CorePoints{num_neigh, core_min_size}, UnionFind{labels});
+      Kokkos::Profiling::popRegion();
+    }
+  }
+
+  else if (parameters._implementation == DBSCAN::Implementation::RhoApproximate)
+  {
+    // Snap the points to a grid of cell length eps/sqrt(dimension), so that
+    // the points of a cell are pairwise within eps, and cluster cell
+    // occupancy instead of raw points: neighbor counts and merges are decided
+    // from cell-to-cell distances alone and no point-to-point distance is
+    // ever computed. Labels may differ from exact DBSCAN for points near the
+    // eps boundary (two points are guaranteed to be merged within eps and may
+    // be merged up to eps plus two cell diagonals apart), the usual
+    // rho-approximate trade of bounded label error for speed.
+    Kokkos::Profiling::pushRegion("ArborX::DBSCAN::cells");
+    Box bounds;
+    Details::TreeConstruction::calculateBoundingBoxOfTheScene(
+        exec_space,
+        Details::Indexables<Points, Details::DefaultIndexableGetter>{
+            points, Details::DefaultIndexableGetter{}},
+        bounds);
+
+    float const h = eps / std::sqrt(dim);
+    Details::CartesianGrid<dim> const grid(bounds, h);
+
+    auto cell_indices = Details::computeCellIndices(exec_space, points, grid);
+
+    auto permute = Details::sortObjects(exec_space, cell_indices);
+    auto &sorted_cell_indices = cell_indices; // alias
+
+    Kokkos::View<int *, MemorySpace> cell_offsets(
+        "ArborX::DBSCAN::cell_offsets", 0);
+    Details::computeOffsetsInOrderedView(exec_space, sorted_cell_indices,
+                                         cell_offsets);
+    int const num_cells = cell_offsets.size() - 1;
+
+    Kokkos::View<size_t *, MemorySpace> unique_cell_indices(
+        Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                           "ArborX::DBSCAN::unique_cell_indices"),
+        num_cells);
+    Kokkos::parallel_for(
+        "ArborX::DBSCAN::extract_unique_cell_indices",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_cells),
+        KOKKOS_LAMBDA(int c) {
+          unique_cell_indices(c) = sorted_cell_indices(cell_offsets(c));
+        });
+
+    Kokkos::View<int *, MemorySpace> cell_counts(
+        Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                           "ArborX::DBSCAN::cell_counts"),
+        num_cells);
+    Details::countCellOccupancyWithinRadius(exec_space, grid,
+                                            unique_cell_indices, cell_offsets,
+                                            h, eps, cell_counts);
+    Kokkos::Profiling::popRegion();
+
+    Kokkos::resize(Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing),
+                   labels, n);
+    KokkosExt::iota(exec_space, labels);
+
+    Kokkos::Profiling::pushRegion("ArborX::DBSCAN::clusters");
+
+    if (!is_special_case)
+    {
+      // The noise marking below needs per-point neighbor counts; every point
+      // of a cell shares its cell's approximate count
+      Kokkos::Profiling::pushRegion("ArborX::DBSCAN::clusters::num_neigh");
+      Kokkos::resize(Kokkos::view_alloc(exec_space), num_neigh, n);
+      Kokkos::parallel_for(
+          "ArborX::DBSCAN::scatter_cell_counts",
+          Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_cells),
+          KOKKOS_LAMBDA(int c) {
+            for (int jj = cell_offsets(c); jj < cell_offsets(c + 1); ++jj)
+              num_neigh(permute(jj)) = cell_counts(c);
+          });
+      Kokkos::Profiling::popRegion();
+    }
+
+    Kokkos::Profiling::pushRegion("ArborX::DBSCAN::clusters::query");
+    Details::unionFindCells(exec_space, grid, unique_cell_indices,
+                            cell_offsets, permute, h, eps, cell_counts,
+                            core_min_size, UnionFind{labels});
+    Kokkos::Profiling::popRegion();
+  }
 
   // Per [1]:
   //
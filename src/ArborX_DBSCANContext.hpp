@@ -0,0 +1,225 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DBSCAN_CONTEXT_HPP
+#define ARBORX_DBSCAN_CONTEXT_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_DBSCAN.hpp>
+#include <ArborX_DetailsFDBSCAN.hpp>
+#include <ArborX_DetailsHalfTraversal.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DetailsUnionFind.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_PairValueIndex.hpp>
+#include <ArborX_PredicateHelpers.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Experimental
+{
+
+// Persistent context for clustering a stream of frames with identical DBSCAN
+// parameters. A one-shot ArborX::dbscan() allocates and first-touches its
+// tree and every workspace view on each call; the context instead owns the
+// tree and the label, neighbor-count and cluster-size arrays, rebuilding the
+// tree into the retained node storage and growing the views only when a
+// frame is larger than every previous one. The FDBSCAN algorithm is used, as
+// its workspace is sized by the point count alone and thus reusable across
+// frames. The returned labels view aliases the context workspace: it is
+// valid until the next cluster() call and follows the ArborX::dbscan()
+// convention (cluster indices are non-negative, noise points get -1).
+template <typename MemorySpace, typename Point>
+class DBSCANContext
+{
+  static_assert(GeometryTraits::is_point_v<Point>);
+
+  BoundingVolumeHierarchy<MemorySpace, PairValueIndex<Point>> _bvh;
+  Kokkos::View<int *, MemorySpace> _labels;
+  Kokkos::View<int *, MemorySpace> _num_neigh;
+  Kokkos::View<int *, MemorySpace> _cluster_sizes;
+  float _eps;
+  int _core_min_size;
+
+public:
+  using memory_space = MemorySpace;
+
+  DBSCANContext(float eps, int core_min_size)
+      : _labels("ArborX::DBSCANContext::labels", 0)
+      , _num_neigh("ArborX::DBSCANContext::num_neighbors", 0)
+      , _cluster_sizes("ArborX::DBSCANContext::cluster_sizes", 0)
+      , _eps(eps)
+      , _core_min_size(core_min_size)
+  {
+    ARBORX_ASSERT(eps > 0);
+    ARBORX_ASSERT(core_min_size >= 2);
+  }
+
+  template <typename ExecutionSpace, typename Primitives>
+  Kokkos::View<int *, MemorySpace> cluster(ExecutionSpace const &exec_space,
+                                           Primitives const &primitives)
+  {
+    Kokkos::Profiling::pushRegion("ArborX::DBSCANContext::cluster");
+
+    namespace KokkosExt = ArborX::Details::KokkosExt;
+
+    using Points = Details::AccessValues<Primitives, PrimitivesTag>;
+
+    static_assert(
+        KokkosExt::is_accessible_from<MemorySpace, ExecutionSpace>::value,
+        "Memory space must be accessible from the execution space");
+    static_assert(
+        KokkosExt::is_accessible_from<typename Points::memory_space,
+                                      ExecutionSpace>::value,
+        "Primitives must be accessible from the execution space");
+    static_assert(std::is_same_v<typename Points::value_type, Point>,
+                  "Primitives elements must match the context point type");
+
+#ifdef KOKKOS_ENABLE_SERIAL
+    using UnionFind = Details::UnionFind<
+        MemorySpace,
+        /*DoSerial=*/std::is_same_v<ExecutionSpace, Kokkos::Serial>>;
+#else
+    using UnionFind = Details::UnionFind<MemorySpace>;
+#endif
+
+    Points points{primitives}; // NOLINT
+    int const n = points.size();
+
+    bool const is_special_case = (_core_min_size == 2);
+
+    Kokkos::Profiling::pushRegion(
+        "ArborX::DBSCANContext::tree_construction");
+    _bvh.rebuild(exec_space, attach_indices(points));
+    Kokkos::Profiling::popRegion();
+
+    if (_labels.extent_int(0) < n)
+      KokkosExt::reallocWithoutInitializing(exec_space, _labels, n);
+    Kokkos::View<int *, MemorySpace> labels =
+        Kokkos::subview(_labels, Kokkos::make_pair(0, n));
+    KokkosExt::iota(exec_space, labels);
+
+    Kokkos::View<int *, MemorySpace> num_neigh;
+
+    Kokkos::Profiling::pushRegion("ArborX::DBSCANContext::clusters");
+    if (is_special_case)
+    {
+      using CorePoints = Details::CCSCorePoints;
+#if defined(KOKKOS_COMPILER_NVCC) && (KOKKOS_COMPILER_NVCC < 1140)
+      // Workaround a compiler bug
+      using HalfTraversal = Details::HalfTraversal<
+          decltype(_bvh), Details::FDBSCANCallback<UnionFind, CorePoints>,
+          Details::WithinRadiusGetter>;
+#else
+      using Details::HalfTraversal;
+#endif
+      Kokkos::Profiling::pushRegion("ArborX::DBSCANContext::clusters::query");
+      HalfTraversal(
+          exec_space, _bvh,
+          Details::FDBSCANCallback<UnionFind, CorePoints>{labels, CorePoints{}},
+          Details::WithinRadiusGetter{_eps});
+      Kokkos::Profiling::popRegion();
+    }
+    else
+    {
+      auto const predicates =
+          attach_indices(make_intersects(points, _eps));
+
+      // Determine core points
+      Kokkos::Profiling::pushRegion(
+          "ArborX::DBSCANContext::clusters::num_neigh");
+      if (_num_neigh.extent_int(0) < n)
+        KokkosExt::reallocWithoutInitializing(exec_space, _num_neigh, n);
+      num_neigh = Kokkos::subview(_num_neigh, Kokkos::make_pair(0, n));
+      Kokkos::deep_copy(exec_space, num_neigh, 0);
+      _bvh.query(exec_space, predicates,
+                 Details::CountUpToN<MemorySpace>{num_neigh, _core_min_size});
+      Kokkos::Profiling::popRegion();
+
+      using CorePoints = Details::DBSCANCorePoints<MemorySpace>;
+#if defined(KOKKOS_COMPILER_NVCC) && (KOKKOS_COMPILER_NVCC < 1140)
+      // Workaround a compiler bug
+      using HalfTraversal = Details::HalfTraversal<
+          decltype(_bvh), Details::FDBSCANCallback<UnionFind, CorePoints>,
+          Details::WithinRadiusGetter>;
+#else
+      using Details::HalfTraversal;
+#endif
+
+      // Perform the queries and build clusters through callback
+      Kokkos::Profiling::pushRegion("ArborX::DBSCANContext::clusters::query");
+      HalfTraversal(exec_space, _bvh,
+                    Details::FDBSCANCallback<UnionFind, CorePoints>{
+                        labels, CorePoints{num_neigh, _core_min_size}},
+                    Details::WithinRadiusGetter{_eps});
+      Kokkos::Profiling::popRegion();
+    }
+    Kokkos::Profiling::popRegion();
+
+    Kokkos::Profiling::pushRegion("ArborX::DBSCANContext::finalize");
+
+    if (_cluster_sizes.extent_int(0) < n)
+      KokkosExt::reallocWithoutInitializing(exec_space, _cluster_sizes, n);
+    Kokkos::View<int *, MemorySpace> cluster_sizes =
+        Kokkos::subview(_cluster_sizes, Kokkos::make_pair(0, n));
+    Kokkos::deep_copy(exec_space, cluster_sizes, 0);
+
+    Kokkos::parallel_for(
+        "ArborX::DBSCANContext::finalize_labels",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+        KOKKOS_LAMBDA(int const i) {
+          // ##### ECL license (see LICENSE.ECL) #####
+          int next;
+          int vstat = labels(i);
+          int const old = vstat;
+          while (vstat > (next = labels(vstat)))
+          {
+            vstat = next;
+          }
+          if (vstat != old)
+            labels(i) = vstat;
+
+          Kokkos::atomic_increment(&cluster_sizes(labels(i)));
+        });
+    if (is_special_case)
+    {
+      Kokkos::parallel_for(
+          "ArborX::DBSCANContext::mark_noise",
+          Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+          KOKKOS_LAMBDA(int const i) {
+            if (cluster_sizes(labels(i)) == 1)
+              labels(i) = -1;
+          });
+    }
+    else
+    {
+      Details::DBSCANCorePoints<MemorySpace> is_core{num_neigh,
+                                                     _core_min_size};
+      Kokkos::parallel_for(
+          "ArborX::DBSCANContext::mark_noise",
+          Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+          KOKKOS_LAMBDA(int const i) {
+            if (cluster_sizes(labels(i)) == 1 && !is_core(i))
+              labels(i) = -1;
+          });
+    }
+    Kokkos::Profiling::popRegion();
+
+    Kokkos::Profiling::popRegion();
+
+    return labels;
+  }
+};
+
+} // namespace ArborX::Experimental
+
+#endif
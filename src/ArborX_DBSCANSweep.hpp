@@ -0,0 +1,191 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DBSCAN_SWEEP_HPP
+#define ARBORX_DBSCAN_SWEEP_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_DBSCAN.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsUnionFind.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_PairValueIndex.hpp>
+#include <ArborX_PredicateHelpers.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX
+{
+
+namespace Details
+{
+
+struct DBSCANSweepExtractIndex
+{
+  template <typename Query, typename Value, typename Index, typename Output>
+  KOKKOS_FUNCTION void operator()(Query const &,
+                                  PairValueIndex<Value, Index> const &value,
+                                  Output const &out) const
+  {
+    out((int)value.index);
+  }
+};
+
+} // namespace Details
+
+namespace Experimental
+{
+
+// Materializes the epsilon-neighborhood graph of a point cloud once, and
+// re-derives DBSCAN labels for any core_min_size value from the stored
+// adjacency without touching the BVH again. Useful for parameter sweeps: a
+// sweep over k values of core_min_size costs one tree construction and one
+// set of neighbor traversals instead of k.
+//
+// Note that the graph stores all epsilon-neighbors of every point, whereas
+// ArborX::dbscan() caps the neighbor counting at core_min_size and prunes
+// traversals through dense boxes. For very dense datasets with small eps the
+// one-time graph construction can therefore be more expensive than a single
+// regular run, but the sweep still amortizes it.
+template <typename MemorySpace>
+class DBSCANSweep
+{
+  Kokkos::View<int *, MemorySpace> _indices;
+  Kokkos::View<int *, MemorySpace> _offset;
+
+public:
+  using memory_space = MemorySpace;
+
+  template <typename ExecutionSpace, typename Primitives>
+  DBSCANSweep(ExecutionSpace const &space, Primitives const &primitives,
+              float eps)
+      : _indices("ArborX::DBSCANSweep::indices", 0)
+      , _offset("ArborX::DBSCANSweep::offset", 0)
+  {
+    Kokkos::Profiling::ScopedRegion guard("ArborX::DBSCANSweep::construction");
+
+    ARBORX_ASSERT(eps > 0);
+
+    using Points = Details::AccessValues<Primitives, PrimitivesTag>;
+    using Point = typename Points::value_type;
+    static_assert(GeometryTraits::is_point_v<Point>);
+
+    Points points{primitives}; // NOLINT
+
+    BoundingVolumeHierarchy<MemorySpace, PairValueIndex<Point>> bvh(
+        space, Experimental::attach_indices(points));
+    bvh.query(space, Experimental::make_intersects(points, eps),
+              Details::DBSCANSweepExtractIndex{}, _indices, _offset);
+  }
+
+  auto size() const { return _offset.size() - 1; }
+
+  template <typename ExecutionSpace>
+  Kokkos::View<int *, MemorySpace> labels(ExecutionSpace const &space,
+                                          int core_min_size) const
+  {
+    Kokkos::Profiling::ScopedRegion guard("ArborX::DBSCANSweep::labels");
+
+    namespace KokkosExt = Details::KokkosExt;
+
+    ARBORX_ASSERT(core_min_size >= 2);
+
+#ifdef KOKKOS_ENABLE_SERIAL
+    using UnionFind = Details::UnionFind<
+        MemorySpace,
+        /*DoSerial=*/std::is_same_v<ExecutionSpace, Kokkos::Serial>>;
+#else
+    using UnionFind = Details::UnionFind<MemorySpace>;
+#endif
+
+    int const n = size();
+
+    Kokkos::View<int *, MemorySpace> labels(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::DBSCANSweep::labels"),
+        n);
+    KokkosExt::iota(space, labels);
+
+    auto indices = _indices;
+    auto offset = _offset;
+    UnionFind union_find{labels};
+    Kokkos::parallel_for(
+        "ArborX::DBSCANSweep::clusters",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int const i) {
+          // The neighbor lists include the point itself, so the degree can be
+          // compared directly against core_min_size, matching the counting
+          // semantics of ArborX::dbscan()
+          bool const is_core = (offset(i + 1) - offset(i) >= core_min_size);
+          for (int e = offset(i); e < offset(i + 1); ++e)
+          {
+            int const j = indices(e);
+            if (j == i)
+              continue;
+            bool const neighbor_is_core =
+                (offset(j + 1) - offset(j) >= core_min_size);
+
+            // Same logic as FDBSCANCallback
+            if (!is_core)
+            {
+              if (neighbor_is_core)
+              {
+                union_find.merge_into(i, j);
+                break;
+              }
+            }
+            else
+            {
+              if (neighbor_is_core)
+                union_find.merge(i, j);
+              else
+                union_find.merge_into(j, i);
+            }
+          }
+        });
+
+    Kokkos::View<int *, MemorySpace> cluster_sizes(
+        Kokkos::view_alloc(space, "ArborX::DBSCANSweep::cluster_sizes"), n);
+    Kokkos::parallel_for(
+        "ArborX::DBSCANSweep::finalize_labels",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int const i) {
+          // ##### ECL license (see LICENSE.ECL) #####
+          int next;
+          int vstat = labels(i);
+          int const old = vstat;
+          while (vstat > (next = labels(vstat)))
+          {
+            vstat = next;
+          }
+          if (vstat != old)
+            labels(i) = vstat;
+
+          Kokkos::atomic_increment(&cluster_sizes(labels(i)));
+        });
+    Kokkos::parallel_for(
+        "ArborX::DBSCANSweep::mark_noise",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int const i) {
+          bool const is_core = (offset(i + 1) - offset(i) >= core_min_size);
+          if (cluster_sizes(labels(i)) == 1 && !is_core)
+            labels(i) = -1;
+        });
+
+    return labels;
+  }
+};
+
+} // namespace Experimental
+
+} // namespace ArborX
+
+#endif
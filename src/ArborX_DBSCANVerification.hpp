@@ -9,17 +9,17 @@
  * SPDX-License-Identifier: BSD-3-Clause                                    *
  ****************************************************************************/
 
-#ifndef ARBORX_DETAILSDBSCANVERIFICATION_HPP
-#define ARBORX_DETAILSDBSCANVERIFICATION_HPP
+#ifndef ARBORX_DBSCAN_VERIFICATION_HPP
+#define ARBORX_DBSCAN_VERIFICATION_HPP
 
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
 #include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DetailsSortUtils.hpp>
+#include <ArborX_DetailsUnionFind.hpp>
 #include <ArborX_LinearBVH.hpp>
 
 #include <Kokkos_Core.hpp>
 
-#include <iostream>
-#include <set>
-#include <stack>
 #include <vector>
 
 namespace ArborX
@@ -150,107 +150,92 @@ bool verifyBorderAndNoisePoints(ExecutionSpace const &exec_space,
   return (num_incorrect == 0);
 }
 
-// Check that cluster indices are unique
+// Check that cluster indices are unique, i.e., that no label spans two
+// connected components of the core-point graph. The components are rebuilt
+// with a union-find independent of the one the clustering ran. Restricting
+// the graph to core-core edges catches clusters bridged only through a
+// border point: such clusters stay separate components, so the shared label
+// is detected. This check runs after verifyConnectedCorePointsShareIndex(),
+// which guarantees that every component carries a single label; what remains
+// to verify is that no two components carry the same one, done by sorting
+// the (label, component) pairs of the core points and comparing neighbors.
 template <typename ExecutionSpace, typename IndicesView, typename OffsetView,
           typename LabelsView>
 bool verifyClustersAreUnique(ExecutionSpace const &exec_space,
                              IndicesView indices, OffsetView offset,
                              LabelsView labels, int core_min_size)
 {
+  using MemorySpace = typename LabelsView::memory_space;
+
   int n = labels.size();
 
-  // FIXME we don't want to modify the labels view in this check. What we
-  // want here is to create a view on the host, and deep_copy into it.
-  // create_mirror_view_and_copy won't work, because it is a no-op if labels
-  // is already on the host.
-  decltype(Kokkos::create_mirror_view(Kokkos::HostSpace{},
-                                      std::declval<LabelsView>()))
-      labels_host(Kokkos::view_alloc(Kokkos::WithoutInitializing,
-                                     "ArborX::DBSCAN::labels_host"),
-                  labels.size());
-  Kokkos::deep_copy(exec_space, labels_host, labels);
-  auto offset_host =
-      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
-  auto indices_host =
-      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
-
-  auto is_core_point = [&](int i) {
-    return offset_host(i + 1) - offset_host(i) >= core_min_size;
-  };
-
-  // Remove all border points from consideration (noise points are already -1)
-  // The idea is that this way if labels were bridged through a border
-  // point, we will count them as separate labels but with a shared cluster
-  // index, which will fail the unique labels check
-  for (int i = 0; i < n; ++i)
-  {
-    if (!is_core_point(i))
-    {
-      for (int jj = offset_host(i); jj < offset_host(i + 1); ++jj)
-      {
-        int j = indices_host(jj);
-        if (is_core_point(j))
+#ifdef KOKKOS_ENABLE_SERIAL
+  using UnionFind = Details::UnionFind<
+      MemorySpace,
+      /*DoSerial=*/std::is_same_v<ExecutionSpace, Kokkos::Serial>>;
+#else
+  using UnionFind = Details::UnionFind<MemorySpace>;
+#endif
+
+  Kokkos::View<int *, MemorySpace> components(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::DBSCAN::verification::components"),
+      n);
+  KokkosExt::iota(exec_space, components);
+  UnionFind union_find(components);
+  Kokkos::parallel_for(
+      "ArborX::DBSCAN::verification::compute_core_components",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        bool self_is_core_point = (offset(i + 1) - offset(i) >= core_min_size);
+        if (!self_is_core_point)
+          return;
+        for (int jj = offset(i); jj < offset(i + 1); ++jj)
         {
-          // The point is a border point
-          labels_host(i) = -1;
-          break;
+          int j = indices(jj);
+          bool neigh_is_core_point =
+              (offset(j + 1) - offset(j) >= core_min_size);
+          if (neigh_is_core_point)
+            union_find.merge(i, j);
         }
-      }
-    }
-  }
-
-  // Record all unique cluster indices
-  std::set<int> unique_cluster_indices;
-  for (int i = 0; i < n; ++i)
-    if (labels_host(i) != -1)
-      unique_cluster_indices.insert(labels_host(i));
-  auto num_unique_cluster_indices = unique_cluster_indices.size();
-
-  // Record all cluster indices, assigning a unique index to each (which is
-  // different from the original cluster index). This will only use noise and
-  // core points (see above).
-  unsigned int num_clusters = 0;
-  std::set<int> cluster_sets;
-  for (int i = 0; i < n; ++i)
-  {
-    if (labels_host(i) >= 0)
-    {
-      auto id = labels_host(i);
-      cluster_sets.insert(id);
-      num_clusters++;
-
-      // DFS search
-      std::stack<int> stack;
-      stack.push(i);
-      while (!stack.empty())
-      {
-        auto k = stack.top();
-        stack.pop();
-        if (labels_host(k) >= 0)
+      });
+  Kokkos::parallel_for(
+      "ArborX::DBSCAN::verification::flatten_core_components",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int i) { components(i) = union_find.representative(i); });
+
+  // Non-core points are assigned the noise label, which sorts first and is
+  // skipped by the comparison; core labels are nonnegative at this point
+  Kokkos::View<int *, MemorySpace> sorted_labels(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::DBSCAN::verification::sorted_labels"),
+      n);
+  Kokkos::parallel_for(
+      "ArborX::DBSCAN::verification::mask_non_core_points",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        bool self_is_core_point = (offset(i + 1) - offset(i) >= core_min_size);
+        sorted_labels(i) = (self_is_core_point ? labels(i) : -1);
+      });
+  Details::sortObjects(exec_space, sorted_labels, components);
+
+  int num_incorrect;
+  Kokkos::parallel_reduce(
+      "ArborX::DBSCAN::verify_unique_clusters",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, (n > 0 ? 1 : 0), n),
+      KOKKOS_LAMBDA(int i, int &update) {
+        if (sorted_labels(i) >= 0 && sorted_labels(i) == sorted_labels(i - 1) &&
+            components(i) != components(i - 1))
         {
-          labels_host(k) = -1;
-          for (int jj = offset_host(k); jj < offset_host(k + 1); ++jj)
-          {
-            int j = indices_host(jj);
-            if (is_core_point(j) || (labels_host(j) == id))
-              stack.push(j);
-          }
+          Kokkos::printf(
+              "Different clusters share the same label: %d [%d] and %d [%d]\n",
+              components(i - 1), sorted_labels(i - 1), components(i),
+              sorted_labels(i));
+          update++;
         }
-      }
-    }
-  }
-  if (cluster_sets.size() != num_unique_cluster_indices)
-  {
-    std::cerr << "Number of components does not match\n";
-    return false;
-  }
-  if (num_clusters != num_unique_cluster_indices)
-  {
-    std::cerr << "Cluster IDs are not unique\n";
-    return false;
-  }
-
-  return true;
+      },
+      num_incorrect);
+  return (num_incorrect == 0);
 }
 
 template <typename ExecutionSpace, typename IndicesView, typename OffsetView,
@@ -266,6 +251,9 @@ bool verifyClusters(ExecutionSpace const &exec_space, IndicesView indices,
   using Verify = bool (*)(ExecutionSpace const &, IndicesView, OffsetView,
                           LabelsView, int);
 
+  // The checks build on each other (the uniqueness check relies on the core
+  // labels being nonnegative and consistent within a component), so the
+  // evaluation must short-circuit on the first failure
   std::vector<Verify> verify{
       static_cast<Verify>(verifyCorePointsNonnegativeIndex),
       static_cast<Verify>(verifyConnectedCorePointsShareIndex),
@@ -276,6 +264,14 @@ bool verifyClusters(ExecutionSpace const &exec_space, IndicesView indices,
   });
 }
 
+} // namespace Details
+
+namespace Experimental
+{
+
+// Check that the labels form a valid DBSCAN clustering of the points. The
+// neighborhoods are recomputed with a BVH and every check runs on the
+// device, so verifying a large run costs a fraction of computing it.
 template <typename ExecutionSpace, typename Primitives, typename LabelsView>
 bool verifyDBSCAN(ExecutionSpace exec_space, Primitives const &primitives,
                   float eps, int core_min_size, LabelsView const &labels)
@@ -314,7 +310,8 @@ bool verifyDBSCAN(ExecutionSpace exec_space, Primitives const &primitives,
 
   return passed;
 }
-} // namespace Details
+
+} // namespace Experimental
 } // namespace ArborX
 
 #endif
@@ -0,0 +1,597 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DISTRIBUTED_DBSCAN_HPP
+#define ARBORX_DISTRIBUTED_DBSCAN_HPP
+
+#include <ArborX_DBSCAN.hpp>
+#include <ArborX_DetailsDistributor.hpp>
+#include <ArborX_DetailsFDBSCAN.hpp>
+#include <ArborX_DetailsHalfTraversal.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsUnionFind.hpp>
+#include <ArborX_DistributedTree.hpp>
+#include <ArborX_HyperBox.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_PredicateHelpers.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <climits>
+#include <vector>
+
+#include <mpi.h>
+
+namespace ArborX
+{
+
+namespace Details
+{
+
+template <typename Point>
+struct DBSCANGhost
+{
+  Point point;
+  int rank;
+  int index;
+};
+
+// Ship the local points matching the eps-expanded bounding boxes of the other
+// ranks, together with enough information to address them on their owner
+struct GhostPointsCallback
+{
+  int _rank;
+
+  template <typename Predicate, typename Value, typename Output>
+  KOKKOS_FUNCTION void operator()(Predicate const &predicate,
+                                  Value const &value, Output const &out) const
+  {
+    // Do not ship our own points back to us
+    if (getData(predicate) == _rank)
+      return;
+
+    using Point = std::decay_t<decltype(value.value)>;
+    out(DBSCANGhost<Point>{value.value, _rank, (int)value.index});
+  }
+};
+
+template <typename MemorySpace>
+struct DistributedCorePoints
+{
+  Kokkos::View<int *, MemorySpace> _num_neigh;
+  Kokkos::View<char *, MemorySpace> _ghost_is_core;
+  int _num_local;
+  int _core_min_size;
+
+  KOKKOS_FUNCTION bool operator()(int const i) const
+  {
+    return (i < _num_local ? _num_neigh(i) >= _core_min_size
+                           : (bool)_ghost_is_core(i - _num_local));
+  }
+};
+
+// Same logic as FDBSCANCallback, except that border points owned by other
+// ranks are left alone: their cluster assignment is decided by their owner,
+// and assigning them here could form a bridge between different clusters
+// during the label exchange.
+template <typename UnionFind, typename CorePointsType>
+struct DistributedFDBSCANCallback
+{
+  UnionFind _union_find;
+  CorePointsType _is_core_point;
+  int _num_local;
+
+  template <typename Value, typename Index>
+  KOKKOS_FUNCTION auto
+  operator()(PairValueIndex<Value, Index> const &value1,
+             PairValueIndex<Value, Index> const &value2) const
+  {
+    int i = value1.index;
+    int j = value2.index;
+
+    bool const i_is_core_point = _is_core_point(i);
+    bool const j_is_core_point = _is_core_point(j);
+    if (i_is_core_point && j_is_core_point)
+    {
+      _union_find.merge(i, j);
+    }
+    else if (i_is_core_point)
+    {
+      if (j < _num_local)
+        _union_find.merge_into(j, i);
+    }
+    else if (j_is_core_point)
+    {
+      if (i < _num_local)
+      {
+        _union_find.merge_into(i, j);
+
+        // Once a border point is assigned to a cluster, can terminate the
+        // associated traversal
+        return CallbackTreeTraversalControl::early_exit;
+      }
+    }
+
+    return CallbackTreeTraversalControl::normal_continuation;
+  }
+};
+
+} // namespace Details
+
+// Distributed DBSCAN. Each rank contributes its local points, and the
+// returned labels are globally consistent: points of the same cluster have
+// the same label regardless of the rank they live on. Labels are global
+// point indices (dense numbering by rank), with noise points labeled -1.
+//
+// The algorithm runs the local FDBSCAN machinery on the local points plus
+// the ghost points collected from the other ranks within eps of the local
+// bounding box, and then resolves the labels of the clusters spanning
+// multiple ranks by iteratively exchanging the labels of the ghost points
+// with their owners until a global fixed point is reached.
+//
+// Must be called as collective over all processes in the communicator.
+template <typename ExecutionSpace, typename Primitives>
+Kokkos::View<long long *,
+             typename AccessTraits<Primitives, PrimitivesTag>::memory_space>
+dbscan(MPI_Comm comm, ExecutionSpace const &exec_space,
+       Primitives const &primitives, float eps, int core_min_size)
+{
+  std::string prefix = "ArborX::DistributedDBSCAN";
+  Kokkos::Profiling::pushRegion(prefix);
+
+  namespace KokkosExt = Details::KokkosExt;
+
+  using Points = Details::AccessValues<Primitives, PrimitivesTag>;
+  using MemorySpace = typename Points::memory_space;
+
+  static_assert(
+      KokkosExt::is_accessible_from<MemorySpace, ExecutionSpace>::value,
+      "Primitives must be accessible from the execution space");
+
+  ARBORX_ASSERT(eps > 0);
+  ARBORX_ASSERT(core_min_size >= 2);
+
+#ifdef KOKKOS_ENABLE_SERIAL
+  using UnionFind = Details::UnionFind<
+      MemorySpace,
+      /*DoSerial=*/std::is_same_v<ExecutionSpace, Kokkos::Serial>>;
+#else
+  using UnionFind = Details::UnionFind<MemorySpace>;
+#endif
+
+  using Point = typename Points::value_type;
+  static_assert(GeometryTraits::is_point_v<Point>);
+  constexpr int dim = GeometryTraits::dimension_v<Point>;
+  using Box = ExperimentalHyperGeometry::Box<dim>;
+
+  bool const is_special_case = (core_min_size == 2);
+
+  Points points{primitives}; // NOLINT
+  int const n = points.size();
+
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+  int comm_size;
+  MPI_Comm_size(comm, &comm_size);
+
+  // Assign global ids to the points using dense numbering by rank
+  Kokkos::View<long long *, MemorySpace> rank_offsets(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                         prefix + "::rank_offsets"),
+      comm_size);
+  {
+    long long num_local = n;
+    std::vector<long long> rank_sizes(comm_size);
+    MPI_Allgather(&num_local, sizeof(long long), MPI_BYTE, rank_sizes.data(),
+                  sizeof(long long), MPI_BYTE, comm);
+
+    auto rank_offsets_host = Kokkos::create_mirror_view(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing), rank_offsets);
+    long long offset = 0;
+    for (int r = 0; r < comm_size; ++r)
+    {
+      rank_offsets_host(r) = offset;
+      offset += rank_sizes[r];
+    }
+    Kokkos::deep_copy(exec_space, rank_offsets, rank_offsets_host);
+  }
+
+  // Collect the points of the other ranks within eps of the local bounding
+  // box. They are exactly the remote points that may be within eps of a
+  // local point, so the local neighborhoods over the combined set are exact.
+  Kokkos::Profiling::pushRegion(prefix + "::ghost_exchange");
+
+  using GhostPoint = Details::DBSCANGhost<Point>;
+  Kokkos::View<GhostPoint *, MemorySpace> ghosts(prefix + "::ghosts", 0);
+  {
+    DistributedTree<MemorySpace, PairValueIndex<Point, int>> tree(
+        comm, exec_space, Experimental::attach_indices<int>(points));
+
+    Box local_box;
+    Details::TreeConstruction::calculateBoundingBoxOfTheScene(
+        exec_space,
+        Details::Indexables<Points, Details::DefaultIndexableGetter>{
+            points, Details::DefaultIndexableGetter{}},
+        local_box);
+    for (int d = 0; d < dim; ++d)
+    {
+      local_box.minCorner()[d] -= eps;
+      local_box.maxCorner()[d] += eps;
+    }
+
+    using BoxPredicate = decltype(attach(intersects(local_box), int{}));
+    Kokkos::View<BoxPredicate *, MemorySpace> box_predicates(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                           prefix + "::box_predicates"),
+        1);
+    auto box_predicates_host = Kokkos::create_mirror_view(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing), box_predicates);
+    box_predicates_host(0) = attach(intersects(local_box), comm_rank);
+    Kokkos::deep_copy(exec_space, box_predicates, box_predicates_host);
+
+    Kokkos::View<int *, MemorySpace> ghost_offsets(prefix + "::ghost_offsets",
+                                                   0);
+    tree.query(exec_space, box_predicates,
+               Details::GhostPointsCallback{comm_rank}, ghosts, ghost_offsets);
+  }
+  int const num_ghosts = ghosts.size();
+
+  Kokkos::View<int *, MemorySpace> ghost_ranks(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         prefix + "::ghost_ranks"),
+      num_ghosts);
+  Kokkos::View<int *, MemorySpace> ghost_indices(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         prefix + "::ghost_indices"),
+      num_ghosts);
+  Kokkos::View<Point *, MemorySpace> combined_points(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         prefix + "::combined_points"),
+      n + num_ghosts);
+  Kokkos::parallel_for(
+      prefix + "::unpack_ghosts",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n + num_ghosts),
+      KOKKOS_LAMBDA(int i) {
+        if (i < n)
+        {
+          combined_points(i) = points(i);
+          return;
+        }
+        auto const &ghost = ghosts(i - n);
+        combined_points(i) = ghost.point;
+        ghost_ranks(i - n) = ghost.rank;
+        ghost_indices(i - n) = ghost.index;
+      });
+
+  // Set up the communication plans for addressing the ghost points on their
+  // owners and back. The requests received through `to_owners` and the
+  // replies sent through `to_ghosts` stay element-wise aligned across
+  // exchanges.
+  Details::Distributor<MemorySpace> to_owners(comm);
+  to_owners.createFromSends(exec_space, ghost_ranks);
+  int const num_requests = to_owners.getTotalReceiveLength();
+
+  Kokkos::View<int *, MemorySpace> request_indices(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         prefix + "::request_indices"),
+      num_requests);
+  to_owners.doPostsAndWaits(exec_space, ghost_indices, request_indices);
+
+  Kokkos::View<int *, MemorySpace> request_ranks(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         prefix + "::request_ranks"),
+      num_requests);
+  {
+    Kokkos::View<int *, MemorySpace> export_ranks(
+        Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                           prefix + "::export_ranks"),
+        num_ghosts);
+    Kokkos::deep_copy(exec_space, export_ranks, comm_rank);
+    to_owners.doPostsAndWaits(exec_space, export_ranks, request_ranks);
+  }
+
+  Kokkos::View<int *, MemorySpace> request_slots(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         prefix + "::request_slots"),
+      num_requests);
+  {
+    Kokkos::View<int *, MemorySpace> export_slots(
+        Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                           prefix + "::export_slots"),
+        num_ghosts);
+    KokkosExt::iota(exec_space, export_slots);
+    to_owners.doPostsAndWaits(exec_space, export_slots, request_slots);
+  }
+
+  Details::Distributor<MemorySpace> to_ghosts(comm);
+  to_ghosts.createFromSends(exec_space, request_ranks);
+
+  Kokkos::Profiling::popRegion();
+
+  // Build the tree over the local and ghost points, and determine the core
+  // points. Local neighborhoods are exact; the core status of the ghost
+  // points is fetched from their owners, whose neighborhoods of them are
+  // exact in turn.
+  Kokkos::Profiling::pushRegion(prefix + "::clusters");
+
+  BoundingVolumeHierarchy<MemorySpace, PairValueIndex<Point>> bvh(
+      exec_space, Experimental::attach_indices(combined_points));
+
+  Kokkos::View<int *, MemorySpace> num_neigh(prefix + "::num_neighbors", 0);
+  Kokkos::View<char *, MemorySpace> ghost_is_core(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         prefix + "::ghost_is_core"),
+      num_ghosts);
+  if (is_special_case)
+  {
+    Kokkos::deep_copy(exec_space, ghost_is_core, (char)1);
+  }
+  else
+  {
+    Kokkos::Profiling::pushRegion(prefix + "::clusters::num_neigh");
+    Kokkos::resize(Kokkos::view_alloc(exec_space), num_neigh, n);
+    auto const predicates = ArborX::Experimental::attach_indices(
+        ArborX::Experimental::make_intersects(points, eps));
+    bvh.query(exec_space, predicates,
+              Details::CountUpToN<MemorySpace>{num_neigh, core_min_size});
+
+    // Answer the core status of the local points requested as ghosts by the
+    // other ranks
+    Kokkos::View<char *, MemorySpace> core_replies(
+        Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                           prefix + "::core_replies"),
+        num_requests);
+    Kokkos::parallel_for(
+        prefix + "::fill_core_replies",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_requests),
+        KOKKOS_LAMBDA(int r) {
+          core_replies(r) = (num_neigh(request_indices(r)) >= core_min_size);
+        });
+
+    Kokkos::View<char *, MemorySpace> core_imports(
+        Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                           prefix + "::core_imports"),
+        num_ghosts);
+    to_ghosts.doPostsAndWaits(exec_space, core_replies, core_imports);
+
+    Kokkos::View<int *, MemorySpace> slot_imports(
+        Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                           prefix + "::slot_imports"),
+        num_ghosts);
+    to_ghosts.doPostsAndWaits(exec_space, request_slots, slot_imports);
+
+    Kokkos::parallel_for(
+        prefix + "::scatter_ghost_core_status",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_ghosts),
+        KOKKOS_LAMBDA(int k) {
+          ghost_is_core(slot_imports(k)) = core_imports(k);
+        });
+    Kokkos::Profiling::popRegion();
+  }
+
+  // Perform the local clustering over the combined set through the half
+  // traversal callback
+  Kokkos::View<int *, MemorySpace> labels(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         prefix + "::labels"),
+      n + num_ghosts);
+  KokkosExt::iota(exec_space, labels);
+
+  Kokkos::Profiling::pushRegion(prefix + "::clusters::query");
+  if (is_special_case)
+  {
+    using CorePoints = Details::CCSCorePoints;
+    Details::HalfTraversal(
+        exec_space, bvh,
+        Details::DistributedFDBSCANCallback<UnionFind, CorePoints>{
+            UnionFind{labels}, CorePoints{}, n},
+        Details::WithinRadiusGetter{eps});
+  }
+  else
+  {
+    using CorePoints = Details::DistributedCorePoints<MemorySpace>;
+    Details::HalfTraversal(
+        exec_space, bvh,
+        Details::DistributedFDBSCANCallback<UnionFind, CorePoints>{
+            UnionFind{labels},
+            CorePoints{num_neigh, ghost_is_core, n, core_min_size}, n},
+        Details::WithinRadiusGetter{eps});
+  }
+  Kokkos::Profiling::popRegion();
+
+  // Flatten the union-find and compute the cluster sizes over the combined
+  // set (see the corresponding kernel in dbscan())
+  Kokkos::View<int *, MemorySpace> cluster_sizes(
+      Kokkos::view_alloc(exec_space, prefix + "::cluster_sizes"),
+      n + num_ghosts);
+  Kokkos::parallel_for(
+      prefix + "::finalize_labels",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n + num_ghosts),
+      KOKKOS_LAMBDA(int const i) {
+        // ##### ECL license (see LICENSE.ECL) #####
+        int next;
+        int vstat = labels(i);
+        int const old = vstat;
+        while (vstat > (next = labels(vstat)))
+        {
+          vstat = next;
+        }
+        if (vstat != old)
+          labels(i) = vstat;
+
+        Kokkos::atomic_increment(&cluster_sizes(labels(i)));
+      });
+
+  Kokkos::Profiling::popRegion();
+
+  // Resolve the global labels. Every point starts with its global id, and
+  // the smallest id in each cluster is propagated within the combined local
+  // components and across ranks through the ghost points until no label
+  // changes anywhere. Clusters spanning multiple ranks are connected through
+  // core-core merges that are present on both ranks sharing the pair, so the
+  // minimum reaches every member.
+  Kokkos::Profiling::pushRegion(prefix + "::label_exchange");
+
+  Kokkos::View<long long *, MemorySpace> global_labels(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         prefix + "::global_labels"),
+      n + num_ghosts);
+  Kokkos::parallel_for(
+      prefix + "::init_global_labels",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n + num_ghosts),
+      KOKKOS_LAMBDA(int i) {
+        global_labels(i) =
+            (i < n ? rank_offsets(comm_rank) + i
+                   : rank_offsets(ghost_ranks(i - n)) + ghost_indices(i - n));
+      });
+
+  Kokkos::View<long long *, MemorySpace> component_labels(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         prefix + "::component_labels"),
+      n + num_ghosts);
+
+  using PairIndexLabel = Kokkos::pair<int, long long>;
+  Kokkos::View<PairIndexLabel *, MemorySpace> push_exports(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         prefix + "::push_exports"),
+      num_ghosts);
+  Kokkos::View<PairIndexLabel *, MemorySpace> push_imports(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         prefix + "::push_imports"),
+      num_requests);
+  Kokkos::View<PairIndexLabel *, MemorySpace> pull_exports(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         prefix + "::pull_exports"),
+      num_requests);
+  Kokkos::View<PairIndexLabel *, MemorySpace> pull_imports(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         prefix + "::pull_imports"),
+      num_ghosts);
+
+  while (true)
+  {
+    int changed = 0;
+
+    // Propagate the smallest label within the combined local components
+    Kokkos::deep_copy(exec_space, component_labels, LLONG_MAX);
+    Kokkos::parallel_for(
+        prefix + "::reduce_component_labels",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n + num_ghosts),
+        KOKKOS_LAMBDA(int i) {
+          Kokkos::atomic_min(&component_labels(labels(i)), global_labels(i));
+        });
+    int local_changed;
+    Kokkos::parallel_reduce(
+        prefix + "::scatter_component_labels",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n + num_ghosts),
+        KOKKOS_LAMBDA(int i, int &update) {
+          auto const label = component_labels(labels(i));
+          if (label < global_labels(i))
+          {
+            global_labels(i) = label;
+            ++update;
+          }
+        },
+        local_changed);
+    changed += local_changed;
+
+    // Push the ghost labels to their owners
+    Kokkos::parallel_for(
+        prefix + "::fill_push_exports",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_ghosts),
+        KOKKOS_LAMBDA(int k) {
+          push_exports(k) = {ghost_indices(k), global_labels(n + k)};
+        });
+    to_owners.doPostsAndWaits(exec_space, push_exports, push_imports);
+    Kokkos::parallel_reduce(
+        prefix + "::apply_push_imports",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_requests),
+        KOKKOS_LAMBDA(int r, int &update) {
+          auto const &import = push_imports(r);
+          auto const old =
+              Kokkos::atomic_fetch_min(&global_labels(import.first),
+                                       import.second);
+          if (import.second < old)
+            ++update;
+        },
+        local_changed);
+    changed += local_changed;
+
+    // Pull the owner labels back to the ghost copies
+    Kokkos::parallel_for(
+        prefix + "::fill_pull_exports",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_requests),
+        KOKKOS_LAMBDA(int r) {
+          pull_exports(r) = {request_slots(r),
+                             global_labels(request_indices(r))};
+        });
+    to_ghosts.doPostsAndWaits(exec_space, pull_exports, pull_imports);
+    Kokkos::parallel_reduce(
+        prefix + "::apply_pull_imports",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_ghosts),
+        KOKKOS_LAMBDA(int k, int &update) {
+          auto const &import = pull_imports(k);
+          if (import.second < global_labels(n + import.first))
+          {
+            global_labels(n + import.first) = import.second;
+            ++update;
+          }
+        },
+        local_changed);
+    changed += local_changed;
+
+    int global_changed;
+    MPI_Allreduce(&changed, &global_changed, 1, MPI_INT, MPI_MAX, comm);
+    if (global_changed == 0)
+      break;
+  }
+
+  Kokkos::Profiling::popRegion();
+
+  // Mark the noise points. A local point whose combined component is a
+  // singleton has no core point within eps (all of its potential neighbors,
+  // including the remote ones, participated in the combined clustering), so
+  // the purely local criterion is globally exact.
+  Kokkos::View<long long *, MemorySpace> cluster_labels(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedDBSCAN::labels"),
+      n);
+  if (is_special_case)
+  {
+    Kokkos::parallel_for(
+        prefix + "::mark_noise",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+        KOKKOS_LAMBDA(int const i) {
+          cluster_labels(i) =
+              (cluster_sizes(labels(i)) == 1 ? -1 : global_labels(i));
+        });
+  }
+  else
+  {
+    Details::DBSCANCorePoints<MemorySpace> is_core{num_neigh, core_min_size};
+    Kokkos::parallel_for(
+        prefix + "::mark_noise",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+        KOKKOS_LAMBDA(int const i) {
+          cluster_labels(i) =
+              (cluster_sizes(labels(i)) == 1 && !is_core(i) ? -1
+                                                            : global_labels(i));
+        });
+  }
+
+  Kokkos::Profiling::popRegion();
+
+  return cluster_labels;
+}
+
+} // namespace ArborX
+
+#endif
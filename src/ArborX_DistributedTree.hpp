@@ -14,22 +14,109 @@
 
 #include <ArborX_AccessTraits.hpp>
 #include <ArborX_Box.hpp>
+#include <ArborX_DetailsAlgorithms.hpp>
 #include <ArborX_DetailsDistributedTreeNearest.hpp>
+#include <ArborX_DetailsDistributedTreeOrdered.hpp>
 #include <ArborX_DetailsDistributedTreeSpatial.hpp>
+#include <ArborX_DetailsDistributor.hpp>
+#include <ArborX_DetailsHappyTreeFriends.hpp>
 #include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DistributorTelemetry.hpp>
+#include <ArborX_Exception.hpp>
 #include <ArborX_LinearBVH.hpp>
 #include <ArborX_PairIndexRank.hpp>
 #include <ArborX_PairValueIndex.hpp>
+#include <ArborX_QueryLoadTelemetry.hpp>
+#include <ArborX_TreeSerialization.hpp>
 
 #include <Kokkos_Core.hpp>
 
+#include <chrono>
+#include <cstdint>
+#include <future>
 #include <memory>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 #include <mpi.h>
 
 namespace ArborX
 {
 
+namespace Experimental
+{
+
+// Completion handle returned by DistributedTree::queryAsync(). The query
+// (including all its MPI phases) runs on a helper thread; the handle lets the
+// caller overlap unrelated work before blocking on the results. The
+// destructor waits for completion, so an abandoned handle still drains the
+// communication.
+class QueryFuture
+{
+public:
+  explicit QueryFuture(std::future<void> &&future)
+      : _future(std::move(future))
+  {}
+
+  // Block until the query has completed and the output views are ready
+  void wait() { _future.wait(); }
+
+  // Indicate whether the query has already completed
+  bool ready() const
+  {
+    return _future.wait_for(std::chrono::seconds(0)) ==
+           std::future_status::ready;
+  }
+
+private:
+  std::future<void> _future;
+};
+
+// Construction-time option for DistributedTree: replicate copies of the
+// values lying within halo_width of a neighbor rank's bounds into that rank,
+// so that spatial queries whose geometry stays within halo_width of the
+// local bounds are answered entirely locally, with zero communication.
+// Queries reaching further fall back transparently to the regular top-tree
+// forwarding path; the ghosts live in a separate local tree, so nothing is
+// double counted. The values must be self-contained, as a replicated value
+// does not remember its owner rank.
+struct HaloReplication
+{
+  float halo_width;
+};
+
+} // namespace Experimental
+
+namespace Details
+{
+
+struct DistributedTreeSerialization;
+
+// DistributedTreeBase specializes parts of its construction (rank summaries,
+// sample centroids) on whether the per-rank index exposes the BVH internals
+template <typename Tree>
+struct is_bounding_volume_hierarchy : std::false_type
+{};
+
+template <typename MemorySpace, typename Value, typename IndexableGetter,
+          typename BoundingVolume>
+struct is_bounding_volume_hierarchy<BoundingVolumeHierarchy<
+    MemorySpace, Value, IndexableGetter, BoundingVolume>> : std::true_type
+{};
+
+} // namespace Details
+
+// Base of the distributed index, templated on the per-rank (bottom) index.
+// The top-tree forwarding logic only relies on the generic index interface
+// (construction from values, bounds(), size(), query()), so local indexes
+// other than the default BoundingVolumeHierarchy can back a rank: BruteForce
+// in particular wins for small per-rank primitive counts and some query
+// shapes (see benchmarks/brute_force_vs_bvh). DistributedTree below is the
+// BVH-bottomed version with the usual value/getter template surface.
 template <typename BottomTree>
 class DistributedTreeBase
 {
@@ -56,6 +143,14 @@ public:
   DistributedTreeBase(MPI_Comm comm, ExecutionSpace const &space,
                       Args &&...args);
 
+  template <typename ExecutionSpace, typename... Args>
+  DistributedTreeBase(MPI_Comm comm, ExecutionSpace const &space,
+                      Experimental::HaloReplication const &halo, Args &&...args)
+      : DistributedTreeBase(comm, space, std::forward<Args>(args)...)
+  {
+    replicateHalo(space, halo.halo_width);
+  }
+
   // Return the smallest axis-aligned box able to contain all the objects
   // stored in the tree or an invalid box if the tree is empty.
   bounding_volume_type bounds() const noexcept { return _top_tree.bounds(); }
@@ -97,24 +192,161 @@ public:
     Predicates predicates{user_predicates}; // NOLINT
 
     using Tag = typename Predicates::value_type::Tag;
+    if (_plan_cache)
+      _plan_cache->reset();
+    if (_telemetry)
+      _telemetry->beginQuery();
+    Details::ScopedDistributorTelemetry telemetry_scope(_telemetry);
+    Details::ScopedQueryLoadTelemetry load_scope(_load_telemetry);
     Details::DistributedTreeImpl::queryDispatch(Tag{}, *this, space, predicates,
                                                 std::forward<Args>(args)...);
   }
 
+  // Same as query() for spatial predicates, but additionally hands every
+  // responding rank's batch of results to `on_segment` as soon as its
+  // messages land, driven by MPI_Waitsome inside the receive loop. With rank
+  // imbalance, this lets post-processing of the early responders overlap the
+  // wait for the stragglers instead of idling until the slowest rank answers.
+  //
+  // The callback is invoked on the host as
+  //     on_segment(source_rank, segment_ids, segment_values)
+  // where segment_ids(i) is the index of the local predicate that
+  // segment_values(i) satisfies. Both views live in MemorySpace and are ready
+  // with respect to `space`: kernels the callback submits on `space` see the
+  // segment data, while reading it on the host requires fencing `space`
+  // first. The segments cover exactly the results computed on other ranks
+  // (plus this rank's own forwarded batch); the complete merged results are
+  // returned in `values`/`offset` as with query(). Queries answered entirely
+  // from a replicated halo exchange no messages and invoke no callback.
+  template <typename ExecutionSpace, typename UserPredicates,
+            typename Callback, typename Values, typename Offset,
+            typename SegmentCallback>
+  void queryStreaming(ExecutionSpace const &space,
+                      UserPredicates const &user_predicates,
+                      Callback const &callback, Values &values, Offset &offset,
+                      SegmentCallback const &on_segment) const
+  {
+    static_assert(
+        Details::KokkosExt::is_accessible_from<MemorySpace,
+                                               ExecutionSpace>::value);
+
+    using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+    static_assert(Details::KokkosExt::is_accessible_from<
+                      typename Predicates::memory_space, ExecutionSpace>::value,
+                  "Predicates must be accessible from the execution space");
+
+    Predicates predicates{user_predicates}; // NOLINT
+
+    using Tag = typename Predicates::value_type::Tag;
+    static_assert(std::is_same_v<Tag, Details::SpatialPredicateTag>,
+                  "Streaming delivery is only available for spatial queries");
+
+    if (_plan_cache)
+      _plan_cache->reset();
+    if (_telemetry)
+      _telemetry->beginQuery();
+    Details::ScopedDistributorTelemetry telemetry_scope(_telemetry);
+    Details::ScopedQueryLoadTelemetry load_scope(_load_telemetry);
+    Details::DistributedTreeImpl::queryDispatchStreaming(
+        Tag{}, *this, space, predicates, callback, values, offset, on_segment);
+  }
+
+  template <typename ExecutionSpace, typename UserPredicates, typename Values,
+            typename Offset, typename SegmentCallback>
+  std::enable_if_t<Kokkos::is_view_v<Values> && Kokkos::is_view_v<Offset>>
+  queryStreaming(ExecutionSpace const &space,
+                 UserPredicates const &user_predicates, Values &values,
+                 Offset &offset, SegmentCallback const &on_segment) const
+  {
+    queryStreaming(space, user_predicates, Details::DefaultCallback{}, values,
+                   offset, on_segment);
+  }
+
   auto const &indexable_get() const { return _bottom_tree.indexable_get(); }
 
+  // Opt-in: retain the communication plans built during a query and reuse
+  // them (after a cheap revalidation of the send pattern) in subsequent
+  // queries. Profitable when the query pattern repeats across many queries,
+  // e.g. a halo exchange performed every timestep.
+  void enablePlanCaching()
+  {
+    if (!_plan_cache)
+      _plan_cache =
+          std::make_shared<Details::DistributorPlanCache<MemorySpace>>();
+  }
+
+  void disablePlanCaching() { _plan_cache.reset(); }
+
+  // Opt-in: record the MPI exchanges of every query into the user-owned
+  // telemetry object (see the telemetry header for the contents). Each query
+  // overwrites the previous record; the telemetry must outlive the tree or
+  // be detached before being destroyed.
+  void
+  attachDistributorTelemetry(Experimental::DistributorTelemetry &telemetry)
+  {
+    _telemetry = &telemetry;
+  }
+
+  void detachDistributorTelemetry() { _telemetry = nullptr; }
+
+  // Opt-in: accumulate into the user-owned telemetry object, across queries,
+  // the per-rank query load this rank asks others to serve (see the
+  // query-load telemetry header for the contents); the telemetry must
+  // outlive the tree or be detached before being destroyed
+  void attachLoadTelemetry(Experimental::QueryLoadTelemetry &telemetry)
+  {
+    _load_telemetry = &telemetry;
+  }
+
+  void detachLoadTelemetry() { _load_telemetry = nullptr; }
+
+  // Collective over the tree's communicator. Combine the query load all
+  // ranks accumulated in their attached telemetries into partition-quality
+  // metrics and per-rank splitting weights for a load balancer (see
+  // RepartitioningHints); every rank receives the same hints. A static
+  // decomposition balanced on primitive counts can serve very imbalanced
+  // query load, and the weights quantify by how much each rank's primitives
+  // should count when re-splitting.
+  Experimental::RepartitioningHints
+  repartitioningHints(Experimental::QueryLoadTelemetry const &telemetry) const;
+
 protected:
   MPI_Comm getComm() const { return *_comm_ptr; }
 
 private:
   friend struct Details::DistributedTreeImpl;
+  friend struct Details::DistributedTreeSerialization;
+
+  Details::DistributorPlanCache<MemorySpace> *getPlanCache() const
+  {
+    return _plan_cache.get();
+  }
+
+  template <typename ExecutionSpace>
+  void replicateHalo(ExecutionSpace const &space, float halo_width);
 
   std::shared_ptr<MPI_Comm> _comm_ptr{
       std::make_unique<MPI_Comm>(MPI_COMM_NULL)};
   BottomTree _bottom_tree; // local
+  // Local copies of the neighbor values within _halo_width of the local
+  // bounds (empty unless constructed with Experimental::HaloReplication)
+  BottomTree _ghost_tree;
+  float _halo_width{0};
   TopTree _top_tree;       // replicated
   size_type _top_tree_size{0};
   Kokkos::View<size_type *, MemorySpace> _bottom_tree_sizes;
+  // Replicated per-rank sample centroids, stored as degenerate bounding
+  // volumes; nearest queries use them to tighten the phase one estimate
+  static constexpr int sample_centroids_per_rank = 16;
+  Kokkos::View<BoundingVolume *, MemorySpace> _sample_centroids;
+  // Opt-in cache of communication plans, shared so that tree copies reuse
+  // the same plans
+  std::shared_ptr<Details::DistributorPlanCache<MemorySpace>> _plan_cache;
+  // Opt-in user-owned record of the MPI exchanges of the last query
+  Experimental::DistributorTelemetry *_telemetry = nullptr;
+  // Opt-in user-owned accumulator of the per-rank query load; the input of
+  // repartitioningHints()
+  Experimental::QueryLoadTelemetry *_load_telemetry = nullptr;
 };
 
 // NOTE: query() must be called as collective over all processes in the
@@ -149,6 +381,14 @@ public:
                   IndexableGetter const &indexable_getter = IndexableGetter())
       : base_type(comm, space, values, indexable_getter)
   {}
+
+  template <typename ExecutionSpace, typename Values>
+  DistributedTree(MPI_Comm comm, ExecutionSpace const &space,
+                  Values const &values,
+                  Experimental::HaloReplication const &halo,
+                  IndexableGetter const &indexable_getter = IndexableGetter())
+      : base_type(comm, space, halo, values, indexable_getter)
+  {}
 };
 
 template <typename MemorySpace>
@@ -200,6 +440,23 @@ public:
                      std::forward<OffsetView>(offset));
   }
 
+  template <typename ExecutionSpace, typename UserPredicates,
+            typename IndicesAndRanks, typename OffsetView,
+            typename SegmentCallback>
+  void queryStreaming(ExecutionSpace const &space,
+                      UserPredicates const &user_predicates,
+                      IndicesAndRanks &indices_and_ranks, OffsetView &offset,
+                      SegmentCallback const &on_segment) const
+  {
+    int comm_rank = -1;
+    if (base_type::getComm() != MPI_COMM_NULL)
+      MPI_Comm_rank(base_type::getComm(), &comm_rank);
+
+    base_type::queryStreaming(space, user_predicates,
+                              Details::DefaultCallbackWithRank{comm_rank},
+                              indices_and_ranks, offset, on_segment);
+  }
+
   template <typename ExecutionSpace, typename UserPredicates, typename Callback>
   void query(ExecutionSpace const &space, UserPredicates const &user_predicates,
              Callback &&callback) const
@@ -248,47 +505,22 @@ DistributedTreeBase<BottomTree>::DistributedTreeBase(
   _bottom_tree = BottomTree(space, std::forward<Args>(args)...);
 
   Kokkos::Profiling::popRegion();
-  Kokkos::Profiling::pushRegion("ArborX::DistributedTree::DistributedTree::"
-                                "top_tree_construction");
 
   int comm_rank;
   MPI_Comm_rank(getComm(), &comm_rank);
   int comm_size;
   MPI_Comm_size(getComm(), &comm_size);
 
-  Kokkos::View<BoundingVolume *, MemorySpace> volumes(
-      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
-                         "ArborX::DistributedTree::DistributedTree::"
-                         "rank_bounding_volumes"),
-      comm_size);
-
   Kokkos::DefaultHostExecutionSpace host_exec;
-#ifdef ARBORX_ENABLE_GPU_AWARE_MPI
-  Kokkos::deep_copy(space, Kokkos::subview(volumes, comm_rank),
-                    _bottom_tree.bounds());
-  space.fence("ArborX::DistributedTree::DistributedTree"
-              " (fill on device done before MPI_Allgather)");
 
-  MPI_Allgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
-                static_cast<void *>(volumes.data()), sizeof(BoundingVolume),
-                MPI_BYTE, getComm());
-#else
-  auto volumes_host = Kokkos::create_mirror_view(
-      Kokkos::view_alloc(host_exec, Kokkos::WithoutInitializing), volumes);
-  host_exec.fence();
-  volumes_host(comm_rank) = _bottom_tree.bounds();
-
-  MPI_Allgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
-                static_cast<void *>(volumes_host.data()),
-                sizeof(BoundingVolume), MPI_BYTE, getComm());
-
-  Kokkos::deep_copy(space, volumes, volumes_host);
-#endif
-
-  // Build top tree with attached ranks
-  _top_tree = TopTree{space, Experimental::attach_indices<int>(volumes)};
-
-  Kokkos::Profiling::popRegion();
+  // The remaining phases exchange three independent pieces of data: the
+  // replicated sizes, the sample centroids and the top tree itself. Only the
+  // top-tree chain is internally ordered (the gather feeds the build, the
+  // build feeds the broadcast), so the two allgathers are posted as
+  // nonblocking collectives as soon as their send buffers are ready — the
+  // sizes before the device has even finished the bottom-tree build — and
+  // are completed at the very end, having progressed through the extraction
+  // kernels and the whole top-tree chain instead of serializing behind them.
   Kokkos::Profiling::pushRegion("ArborX::DistributedTree::DistributedTree::"
                                 "size_calculation");
 
@@ -302,17 +534,470 @@ DistributedTreeBase<BottomTree>::DistributedTreeBase(
       _bottom_tree_sizes);
   host_exec.fence();
   bottom_tree_sizes_host(comm_rank) = _bottom_tree.size();
-  MPI_Allgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
-                static_cast<void *>(bottom_tree_sizes_host.data()),
-                sizeof(size_type), MPI_BYTE, getComm());
+  MPI_Request sizes_request;
+  MPI_Iallgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
+                 static_cast<void *>(bottom_tree_sizes_host.data()),
+                 sizeof(size_type), MPI_BYTE, getComm(), &sizes_request);
+
+  Kokkos::Profiling::popRegion();
+  Kokkos::Profiling::pushRegion("ArborX::DistributedTree::DistributedTree::"
+                                "sample_centroids");
+
+  // Summarize each rank further by the centroids of a handful of its stored
+  // objects, evenly spaced in the leaf (space-filling curve) order so they
+  // spread over the rank's domain. A sampled centroid is never closer to a
+  // query than the object it came from, so the k-th closest sample yields a
+  // valid upper bound on the k-th nearest-neighbor distance without any
+  // communication. Nearest queries use it to tighten the phase one estimate
+  // on irregular domains where rank bounding volumes reach far beyond the
+  // data they actually contain. The centroids are stored as degenerate
+  // bounding volumes so that they support the same predicate geometries as
+  // the top tree; slots past a rank's size keep invalid (default
+  // constructed) volumes and are skipped using the replicated sizes.
+  int const num_local_samples =
+      Kokkos::min((int)_bottom_tree.size(), sample_centroids_per_rank);
+  Kokkos::View<BoundingVolume *, MemorySpace> local_samples(
+      Kokkos::view_alloc(space, "ArborX::DistributedTree::DistributedTree::"
+                                "local_sample_centroids"),
+      sample_centroids_per_rank);
+  if constexpr (Details::is_bounding_volume_hierarchy<BottomTree>::value)
+  {
+    auto const bottom_tree = _bottom_tree;
+    Kokkos::parallel_for(
+        "ArborX::DistributedTree::DistributedTree::extract_sample_centroids",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_local_samples),
+        KOKKOS_LAMBDA(int i) {
+          int const leaf =
+              (int)((long long)i * bottom_tree.size() / num_local_samples);
+          BoundingVolume volume{};
+          Details::expand(volume,
+                          Details::returnCentroid(
+                              Details::HappyTreeFriends::getIndexable(
+                                  bottom_tree, leaf)));
+          local_samples(i) = volume;
+        });
+  }
+  else if (num_local_samples > 0)
+  {
+    // Without a leaf order to sample evenly from, scan the local objects
+    // through the index's own query interface and keep the first ones to
+    // claim a slot. Any stored object makes a valid sample (the upper bound
+    // argument above only needs the sample to be a real centroid), the
+    // spread over the rank's domain is just less even.
+    using Predicate = decltype(intersects(std::declval<BoundingVolume>()));
+    Kokkos::View<Predicate *, MemorySpace> everything(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::DistributedTree::DistributedTree::"
+                           "sample_scan_predicate"),
+        1);
+    auto const local_bounds = _bottom_tree.bounds();
+    Kokkos::parallel_for(
+        "ArborX::DistributedTree::DistributedTree::setup_sample_scan",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, 1),
+        KOKKOS_LAMBDA(int) { everything(0) = intersects(local_bounds); });
+
+    Kokkos::View<int, MemorySpace> next_slot(
+        Kokkos::view_alloc(space, "ArborX::DistributedTree::DistributedTree::"
+                                  "next_sample_slot"));
+    auto const indexable_getter = _bottom_tree.indexable_get();
+    _bottom_tree.query(
+        space, everything,
+        KOKKOS_LAMBDA(Predicate const &, value_type const &value) {
+          int const slot = Kokkos::atomic_fetch_inc(&next_slot());
+          if (slot < num_local_samples)
+          {
+            BoundingVolume volume{};
+            Details::expand(volume,
+                            Details::returnCentroid(indexable_getter(value)));
+            local_samples(slot) = volume;
+          }
+        });
+  }
+
+  auto local_samples_host = Kokkos::create_mirror_view(
+      Kokkos::view_alloc(host_exec, Kokkos::WithoutInitializing),
+      local_samples);
+  Kokkos::deep_copy(space, local_samples_host, local_samples);
+  space.fence("ArborX::DistributedTree::DistributedTree"
+              " (copy to host done before MPI_Iallgather)");
+
+  Kokkos::View<BoundingVolume *, Kokkos::HostSpace> samples_host(
+      Kokkos::view_alloc(host_exec, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedTree::DistributedTree::"
+                         "gathered_sample_centroids"),
+      comm_size * sample_centroids_per_rank);
+  MPI_Request samples_request;
+  MPI_Iallgather(static_cast<void const *>(local_samples_host.data()),
+                 sample_centroids_per_rank * sizeof(BoundingVolume), MPI_BYTE,
+                 static_cast<void *>(samples_host.data()),
+                 sample_centroids_per_rank * sizeof(BoundingVolume), MPI_BYTE,
+                 getComm(), &samples_request);
+
+  Kokkos::Profiling::popRegion();
+  Kokkos::Profiling::pushRegion("ArborX::DistributedTree::DistributedTree::"
+                                "top_tree_construction");
+
+  // Summarize every rank by a handful of subtree bounding volumes rather than
+  // a single box. The tighter summary prunes more ranks during the top-tree
+  // traversal, which matters for large search radii at high rank counts where
+  // the forwarded predicate volume dominates the query time. Ranks with fewer
+  // subtrees than the budget repeat their last volume; empty ranks keep
+  // invalid (default constructed) volumes.
+  constexpr int summary_size = 4;
+
+  Kokkos::View<BoundingVolume *, MemorySpace> local_summary(
+      Kokkos::view_alloc(space, "ArborX::DistributedTree::DistributedTree::"
+                                "rank_bounding_volumes"),
+      summary_size);
+
+  if constexpr (Details::is_bounding_volume_hierarchy<BottomTree>::value)
+  {
+    if (_bottom_tree.size() > 1)
+    {
+      auto const bottom_tree = _bottom_tree;
+      Kokkos::parallel_for(
+          "ArborX::DistributedTree::DistributedTree::extract_rank_summary",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, 1), KOKKOS_LAMBDA(int) {
+            // Breadth-first expansion of the shallowest subtree roots until
+            // the budget is filled or only leaves remain
+            int nodes[summary_size];
+            int count = 1;
+            int head = 0;
+            nodes[0] = Details::HappyTreeFriends::getRoot(bottom_tree);
+            while (head < count && count < summary_size)
+            {
+              int const node = nodes[head];
+              if (Details::HappyTreeFriends::isLeaf(bottom_tree, node))
+              {
+                ++head;
+                continue;
+              }
+              for (int i = head; i < count - 1; ++i)
+                nodes[i] = nodes[i + 1];
+              --count;
+              nodes[count++] =
+                  Details::HappyTreeFriends::getLeftChild(bottom_tree, node);
+              nodes[count++] =
+                  Details::HappyTreeFriends::getRightChild(bottom_tree, node);
+            }
+            for (int i = 0; i < summary_size; ++i)
+            {
+              int const node = nodes[i < count ? i : count - 1];
+              BoundingVolume volume{};
+              if (Details::HappyTreeFriends::isLeaf(bottom_tree, node))
+                Details::expand(
+                    volume,
+                    Details::HappyTreeFriends::getIndexable(bottom_tree, node));
+              else
+                volume = Details::HappyTreeFriends::getInternalBoundingVolume(
+                    bottom_tree, node);
+              local_summary(i) = volume;
+            }
+          });
+    }
+    else if (_bottom_tree.size() == 1)
+    {
+      for (int i = 0; i < summary_size; ++i)
+        Kokkos::deep_copy(space, Kokkos::subview(local_summary, i),
+                          _bottom_tree.bounds());
+    }
+  }
+  else
+  {
+    // A bottom index that does not expose subtrees is summarized by its
+    // overall bounds repeated across the budget, same as a single-object BVH
+    if (_bottom_tree.size() > 0)
+      for (int i = 0; i < summary_size; ++i)
+        Kokkos::deep_copy(space, Kokkos::subview(local_summary, i),
+                          _bottom_tree.bounds());
+  }
+
+  // Gather the rank summaries on one rank, build the top tree there once,
+  // and broadcast the serialized result. Compared to a flat allgather of the
+  // summaries followed by every rank redundantly building the same
+  // O(comm_size) tree, both collectives are tree-structured and the build
+  // cost is paid once, so construction scales logarithmically with the rank
+  // count. The raw node broadcast assumes the node layout is identical
+  // across ranks, same as the byte-level exchanges elsewhere.
+  int const root = 0;
+
+  auto local_summary_host = Kokkos::create_mirror_view(
+      Kokkos::view_alloc(host_exec, Kokkos::WithoutInitializing),
+      local_summary);
+  Kokkos::deep_copy(space, local_summary_host, local_summary);
+  space.fence("ArborX::DistributedTree::DistributedTree"
+              " (copy to host done before MPI_Gather)");
+
+  Kokkos::View<BoundingVolume *, Kokkos::HostSpace> volumes_host(
+      Kokkos::view_alloc(host_exec, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedTree::DistributedTree::"
+                         "gathered_rank_bounding_volumes"),
+      comm_rank == root ? comm_size * summary_size : 0);
+  MPI_Gather(static_cast<void const *>(local_summary_host.data()),
+             summary_size * sizeof(BoundingVolume), MPI_BYTE,
+             static_cast<void *>(volumes_host.data()),
+             summary_size * sizeof(BoundingVolume), MPI_BYTE, root, getComm());
+
+  std::string top_tree_blob;
+  std::uint64_t top_tree_blob_size = 0;
+  if (comm_rank == root)
+  {
+    Kokkos::View<BoundingVolume *, MemorySpace> volumes(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::DistributedTree::DistributedTree::"
+                           "rank_bounding_volumes"),
+        comm_size * summary_size);
+    Kokkos::deep_copy(space, volumes, volumes_host);
+
+    // Build top tree with the owning rank attached to every summary volume
+    Kokkos::View<PairValueIndex<BoundingVolume, int> *, MemorySpace>
+        rank_summaries(Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                                          "ArborX::DistributedTree::"
+                                          "DistributedTree::rank_summaries"),
+                       comm_size * summary_size);
+    Kokkos::parallel_for(
+        "ArborX::DistributedTree::DistributedTree::attach_ranks",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, comm_size * summary_size),
+        KOKKOS_LAMBDA(int i) {
+          rank_summaries(i) = {volumes(i), i / summary_size};
+        });
+
+    _top_tree = TopTree{space, rank_summaries};
+
+    std::ostringstream os;
+    Details::TreeSerialization::save(_top_tree, os);
+    top_tree_blob = os.str();
+    top_tree_blob_size = top_tree_blob.size();
+  }
+
+  MPI_Bcast(&top_tree_blob_size, sizeof(top_tree_blob_size), MPI_BYTE, root,
+            getComm());
+  if (comm_rank != root)
+    top_tree_blob.resize(top_tree_blob_size);
+  MPI_Bcast(top_tree_blob.data(), top_tree_blob_size, MPI_BYTE, root,
+            getComm());
+  if (comm_rank != root)
+  {
+    std::istringstream is(top_tree_blob);
+    _top_tree = Details::TreeSerialization::load<TopTree>(space, is);
+  }
+
+  Kokkos::Profiling::popRegion();
+  Kokkos::Profiling::pushRegion("ArborX::DistributedTree::DistributedTree::"
+                                "size_calculation");
+
+  MPI_Wait(&sizes_request, MPI_STATUS_IGNORE);
   Kokkos::deep_copy(space, _bottom_tree_sizes, bottom_tree_sizes_host);
 
   _top_tree_size = Details::KokkosExt::reduce(space, _bottom_tree_sizes, 0);
 
   Kokkos::Profiling::popRegion();
+  Kokkos::Profiling::pushRegion("ArborX::DistributedTree::DistributedTree::"
+                                "sample_centroids");
+
+  MPI_Wait(&samples_request, MPI_STATUS_IGNORE);
+  _sample_centroids = Kokkos::View<BoundingVolume *, MemorySpace>(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedTree::DistributedTree::"
+                         "sample_centroids"),
+      comm_size * sample_centroids_per_rank);
+  Kokkos::deep_copy(space, _sample_centroids, samples_host);
+
   Kokkos::Profiling::popRegion();
+  Kokkos::Profiling::popRegion();
+}
+
+template <typename BottomTree>
+template <typename ExecutionSpace>
+void DistributedTreeBase<BottomTree>::replicateHalo(ExecutionSpace const &space,
+                                                    float halo_width)
+{
+  std::string const prefix =
+      "ArborX::DistributedTree::DistributedTree::halo_replication";
+
+  Kokkos::Profiling::ScopedRegion guard(prefix);
+
+  ARBORX_ASSERT(halo_width > 0);
+  _halo_width = halo_width;
+
+  using Value = value_type;
+  constexpr int DIM = GeometryTraits::dimension_v<BoundingVolume>;
+
+  int comm_rank;
+  MPI_Comm_rank(getComm(), &comm_rank);
+  int comm_size;
+  MPI_Comm_size(getComm(), &comm_size);
+
+  Kokkos::DefaultHostExecutionSpace host_exec;
+
+  // Every rank publishes its local bounds; a neighbor's halo-expanded bounds
+  // select the local values that have to be ghosted to it
+  Kokkos::View<BoundingVolume *, Kokkos::HostSpace> rank_bounds(
+      Kokkos::view_alloc(host_exec, Kokkos::WithoutInitializing,
+                         prefix + "::rank_bounds"),
+      comm_size);
+  host_exec.fence();
+  rank_bounds(comm_rank) = _bottom_tree.bounds();
+  MPI_Allgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
+                static_cast<void *>(rank_bounds.data()), sizeof(BoundingVolume),
+                MPI_BYTE, getComm());
+
+  // One box predicate per rank; the local rank and empty ranks keep invalid
+  // boxes that match nothing
+  using Predicate = decltype(intersects(std::declval<BoundingVolume>()));
+  Kokkos::View<Predicate *, MemorySpace> rank_predicates(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         prefix + "::rank_predicates"),
+      comm_size);
+  auto rank_predicates_host = Kokkos::create_mirror_view(
+      Kokkos::view_alloc(host_exec, Kokkos::WithoutInitializing),
+      rank_predicates);
+  host_exec.fence();
+  for (int r = 0; r < comm_size; ++r)
+  {
+    auto box = rank_bounds(r);
+    if (r == comm_rank || !Details::isValid(box))
+      box = BoundingVolume{};
+    else
+      for (int d = 0; d < DIM; ++d)
+      {
+        box.minCorner()[d] -= halo_width;
+        box.maxCorner()[d] += halo_width;
+      }
+    rank_predicates_host(r) = intersects(box);
+  }
+  Kokkos::deep_copy(space, rank_predicates, rank_predicates_host);
+
+  Kokkos::View<Value *, MemorySpace> export_values(
+      prefix + "::export_values", 0);
+  Kokkos::View<int *, MemorySpace> offset(prefix + "::offset", 0);
+  _bottom_tree.query(space, rank_predicates, export_values, offset);
+
+  int const n_exports = Details::KokkosExt::lastElement(space, offset);
+  Kokkos::View<int *, MemorySpace> export_ranks(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         prefix + "::export_ranks"),
+      n_exports);
+  Kokkos::parallel_for(
+      prefix + "::fill_export_ranks",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, comm_size),
+      KOKKOS_LAMBDA(int r) {
+        for (int i = offset(r); i < offset(r + 1); ++i)
+          export_ranks(i) = r;
+      });
+
+  Details::Distributor<MemorySpace> distributor(getComm());
+  distributor.createFromSends(space, export_ranks);
+  int const n_imports = distributor.getTotalReceiveLength();
+
+  Kokkos::View<Value *, MemorySpace> ghost_values(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         prefix + "::ghost_values"),
+      n_imports);
+  distributor.doPostsAndWaits(space, export_values, ghost_values);
+
+  _ghost_tree = BottomTree(space, ghost_values, _bottom_tree.indexable_get());
 }
 
+template <typename BottomTree>
+Experimental::RepartitioningHints
+DistributedTreeBase<BottomTree>::repartitioningHints(
+    Experimental::QueryLoadTelemetry const &telemetry) const
+{
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::DistributedTree::repartitioningHints");
+
+  auto comm = getComm();
+  int comm_size;
+  MPI_Comm_size(comm, &comm_size);
+
+  Experimental::RepartitioningHints hints;
+
+  // Every rank recorded the cost it asked others to serve; summing the
+  // contributions attributes the cost to the rank that served it
+  std::vector<long long> local_cost(comm_size, 0);
+  for (int r = 0; r < (int)telemetry.predicates_sent.size(); ++r)
+    local_cost[r] += telemetry.predicates_sent[r];
+  for (int r = 0; r < (int)telemetry.results_received.size(); ++r)
+    local_cost[r] += telemetry.results_received[r];
+  hints.served_cost.resize(comm_size);
+  MPI_Allreduce(local_cost.data(), hints.served_cost.data(), comm_size,
+                MPI_LONG_LONG, MPI_SUM, comm);
+
+  hints.primitive_counts.resize(comm_size);
+  long long const local_count = _bottom_tree.size();
+  MPI_Allgather(&local_count, 1, MPI_LONG_LONG, hints.primitive_counts.data(),
+                1, MPI_LONG_LONG, comm);
+
+  long long total_cost = 0;
+  long long max_cost = 0;
+  long long total_count = 0;
+  for (int r = 0; r < comm_size; ++r)
+  {
+    total_cost += hints.served_cost[r];
+    if (hints.served_cost[r] > max_cost)
+      max_cost = hints.served_cost[r];
+    total_count += hints.primitive_counts[r];
+  }
+  if (total_cost > 0)
+    hints.imbalance = (double)max_cost * comm_size / total_cost;
+
+  // Served cost per currently stored primitive, normalized so that the mean
+  // cost per primitive weighs one. Ranks that store nothing keep the neutral
+  // weight, leaving the balancer free to move work onto them.
+  hints.weights.assign(comm_size, 1.);
+  if (total_cost > 0 && total_count > 0)
+  {
+    double const mean_cost_per_primitive = (double)total_cost / total_count;
+    for (int r = 0; r < comm_size; ++r)
+      if (hints.primitive_counts[r] > 0)
+        hints.weights[r] = (double)hints.served_cost[r] /
+                           hints.primitive_counts[r] / mean_cost_per_primitive;
+  }
+
+  return hints;
+}
+
+namespace Experimental
+{
+
+// Same as tree.query() but returns immediately with a handle, running the
+// query (kernels and MPI phases alike) on a helper thread so that
+// independent work submitted on other execution space instances overlaps
+// the search. The tree and the output views must stay alive, and the views
+// must not be read, until wait() returns.
+//
+// Requires MPI to be initialized with MPI_THREAD_MULTIPLE. The caller must
+// not submit work to `space` or issue other collectives on the tree's
+// communicator while the query is in flight.
+template <typename Tree, typename ExecutionSpace, typename UserPredicates,
+          typename... Args>
+[[nodiscard]] QueryFuture queryAsync(Tree const &tree,
+                                     ExecutionSpace const &space,
+                                     UserPredicates const &user_predicates,
+                                     Args &&...args)
+{
+  int provided;
+  MPI_Query_thread(&provided);
+  ARBORX_ASSERT(provided == MPI_THREAD_MULTIPLE);
+
+  return QueryFuture(std::async(
+      std::launch::async,
+      [&tree, space, user_predicates,
+       args = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+        std::apply(
+            [&](auto &&...unpacked) {
+              tree.query(space, user_predicates,
+                         std::forward<decltype(unpacked)>(unpacked)...);
+            },
+            std::move(args));
+        space.fence("ArborX::Experimental::queryAsync"
+                    " (results ready before completing the handle)");
+      }));
+}
+
+} // namespace Experimental
+
 } // namespace ArborX
 
 #endif
@@ -0,0 +1,325 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DISTRIBUTED_TREE_SERIALIZATION_HPP
+#define ARBORX_DISTRIBUTED_TREE_SERIALIZATION_HPP
+
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DistributedTree.hpp>
+#include <ArborX_Exception.hpp>
+#include <ArborX_TreeSerialization.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <mpi.h>
+
+namespace ArborX
+{
+
+namespace Details
+{
+
+// On-disk layout (version 1) of a distributed tree checkpoint, a single
+// shared file written collectively with MPI-IO:
+//
+//   [ header                  ]  padded to the section alignment
+//   [ per-rank blob sizes     ]  comm_size x uint64, padded
+//   [ top tree blob           ]  single-tree format, padded
+//   [ bottom tree sizes       ]  comm_size x size_type, padded
+//   [ sample centroids        ]  padded
+//   [ rank 0 bottom tree blob ]  single-tree format, padded
+//   [ rank 1 bottom tree blob ]  ...
+//
+// The replicated sections (top tree, sizes, samples) are identical on every
+// rank, so rank 0 writes them once and every rank reads them back; the
+// bottom tree blobs are partitioned across the file and written and read
+// with a single collective call at precomputed offsets, so the I/O scales
+// with the rank count. Loading skips the entire construction (bottom tree
+// builds, rank summary exchange, top tree build and broadcast), which is
+// what makes restarting on unchanged geometry cheap. Like the single-tree
+// format the dump is raw memory, not portable across architectures with
+// different layouts, and the file must be loaded on the same number of
+// ranks it was saved on.
+struct DistributedTreeSerialization
+{
+  static constexpr std::uint64_t section_alignment =
+      TreeSerialization::section_alignment;
+  static constexpr std::uint32_t format_version = 1;
+  static constexpr char expected_magic[8] = {'A', 'r', 'b', 'o',
+                                             'r', 'X', 'D', '\0'};
+
+  struct Header
+  {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t comm_size;
+    std::uint64_t top_tree_blob_bytes;
+    std::uint64_t bottom_tree_sizes_bytes;
+    std::uint64_t sample_centroids_bytes;
+  };
+  static_assert(sizeof(Header) == 40);
+
+  static constexpr std::uint64_t aligned(std::uint64_t bytes)
+  {
+    return (bytes + section_alignment - 1) / section_alignment *
+           section_alignment;
+  }
+
+  template <typename Tree>
+  static void save(Tree const &tree, std::string const &filename)
+  {
+    using BoundingVolume = typename Tree::bounding_volume_type;
+    using size_type = typename Tree::size_type;
+
+    MPI_Comm comm = *tree._comm_ptr;
+    int comm_rank;
+    MPI_Comm_rank(comm, &comm_rank);
+    int comm_size;
+    MPI_Comm_size(comm, &comm_size);
+
+    // Serialize everything into memory first; the MPI-IO calls are then pure
+    // byte dumps at precomputed offsets
+    std::string blob;
+    {
+      std::ostringstream os;
+      TreeSerialization::save(tree._bottom_tree, os);
+      blob = os.str();
+    }
+    std::uint64_t const blob_bytes = blob.size();
+    ARBORX_ASSERT(blob_bytes <= (std::uint64_t)INT_MAX);
+
+    // The top tree is replicated, so every rank serializes identical bytes
+    // and knows the replicated section extents without communicating
+    std::string top_blob;
+    {
+      std::ostringstream os;
+      TreeSerialization::save(tree._top_tree, os);
+      top_blob = os.str();
+    }
+
+    std::vector<std::uint64_t> blob_sizes(comm_size);
+    MPI_Allgather(&blob_bytes, sizeof(std::uint64_t), MPI_BYTE,
+                  static_cast<void *>(blob_sizes.data()),
+                  sizeof(std::uint64_t), MPI_BYTE, comm);
+
+    std::uint64_t const sizes_bytes = comm_size * sizeof(size_type);
+    std::uint64_t const samples_bytes =
+        tree._sample_centroids.size() * sizeof(BoundingVolume);
+
+    std::uint64_t const table_offset = aligned(sizeof(Header));
+    std::uint64_t const top_tree_offset =
+        table_offset + aligned(comm_size * sizeof(std::uint64_t));
+    std::uint64_t const sizes_offset =
+        top_tree_offset + aligned(top_blob.size());
+    std::uint64_t const samples_offset = sizes_offset + aligned(sizes_bytes);
+    std::uint64_t blob_offset = samples_offset + aligned(samples_bytes);
+    for (int r = 0; r < comm_rank; ++r)
+      blob_offset += aligned(blob_sizes[r]);
+
+    MPI_File fh;
+    int const ret =
+        MPI_File_open(comm, filename.c_str(),
+                      MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fh);
+    ARBORX_ASSERT(ret == MPI_SUCCESS);
+    // Truncate in case the file already exists and is longer
+    MPI_File_set_size(fh, 0);
+
+    if (comm_rank == 0)
+    {
+      Header header{};
+      std::memcpy(header.magic, expected_magic, sizeof(header.magic));
+      header.version = format_version;
+      header.comm_size = comm_size;
+      header.top_tree_blob_bytes = top_blob.size();
+      header.bottom_tree_sizes_bytes = sizes_bytes;
+      header.sample_centroids_bytes = samples_bytes;
+      MPI_File_write_at(fh, 0, &header, sizeof(Header), MPI_BYTE,
+                        MPI_STATUS_IGNORE);
+      MPI_File_write_at(fh, table_offset, blob_sizes.data(),
+                        comm_size * sizeof(std::uint64_t), MPI_BYTE,
+                        MPI_STATUS_IGNORE);
+      MPI_File_write_at(fh, top_tree_offset, top_blob.data(), top_blob.size(),
+                        MPI_BYTE, MPI_STATUS_IGNORE);
+
+      auto sizes_host = Kokkos::create_mirror_view_and_copy(
+          Kokkos::HostSpace{}, tree._bottom_tree_sizes);
+      MPI_File_write_at(fh, sizes_offset, sizes_host.data(), sizes_bytes,
+                        MPI_BYTE, MPI_STATUS_IGNORE);
+
+      auto samples_host = Kokkos::create_mirror_view_and_copy(
+          Kokkos::HostSpace{}, tree._sample_centroids);
+      MPI_File_write_at(fh, samples_offset, samples_host.data(), samples_bytes,
+                        MPI_BYTE, MPI_STATUS_IGNORE);
+    }
+
+    MPI_File_write_at_all(fh, blob_offset, blob.data(), (int)blob_bytes,
+                          MPI_BYTE, MPI_STATUS_IGNORE);
+    MPI_File_close(&fh);
+  }
+
+  template <typename Tree, typename ExecutionSpace>
+  static Tree load(MPI_Comm comm, ExecutionSpace const &space,
+                   std::string const &filename)
+  {
+    using MemorySpace = typename Tree::memory_space;
+    using BoundingVolume = typename Tree::bounding_volume_type;
+    using size_type = typename Tree::size_type;
+    using BottomTree = typename Tree::bottom_tree_type;
+    using TopTree = typename Tree::top_tree_type;
+
+    Tree tree;
+
+    // Same communicator isolation as construction from values
+    tree._comm_ptr.reset(
+        [comm]() {
+          auto p = std::make_unique<MPI_Comm>();
+          MPI_Comm_dup(comm, p.get());
+          return p.release();
+        }(),
+        [](MPI_Comm *p) {
+          MPI_Comm_free(p);
+          delete p;
+        });
+
+    int comm_rank;
+    MPI_Comm_rank(*tree._comm_ptr, &comm_rank);
+    int comm_size;
+    MPI_Comm_size(*tree._comm_ptr, &comm_size);
+
+    MPI_File fh;
+    int const ret = MPI_File_open(*tree._comm_ptr, filename.c_str(),
+                                  MPI_MODE_RDONLY, MPI_INFO_NULL, &fh);
+    ARBORX_ASSERT(ret == MPI_SUCCESS);
+
+    Header header;
+    MPI_File_read_at(fh, 0, &header, sizeof(Header), MPI_BYTE,
+                     MPI_STATUS_IGNORE);
+    ARBORX_ASSERT(std::memcmp(header.magic, expected_magic,
+                              sizeof(header.magic)) == 0);
+    ARBORX_ASSERT(header.version == format_version);
+    ARBORX_ASSERT((int)header.comm_size == comm_size);
+    ARBORX_ASSERT(header.bottom_tree_sizes_bytes ==
+                  comm_size * sizeof(size_type));
+
+    std::uint64_t const table_offset = aligned(sizeof(Header));
+    std::vector<std::uint64_t> blob_sizes(comm_size);
+    MPI_File_read_at(fh, table_offset, blob_sizes.data(),
+                     comm_size * sizeof(std::uint64_t), MPI_BYTE,
+                     MPI_STATUS_IGNORE);
+
+    std::uint64_t const top_tree_offset =
+        table_offset + aligned(comm_size * sizeof(std::uint64_t));
+    std::uint64_t const sizes_offset =
+        top_tree_offset + aligned(header.top_tree_blob_bytes);
+    std::uint64_t const samples_offset =
+        sizes_offset + aligned(header.bottom_tree_sizes_bytes);
+    std::uint64_t blob_offset =
+        samples_offset + aligned(header.sample_centroids_bytes);
+    for (int r = 0; r < comm_rank; ++r)
+      blob_offset += aligned(blob_sizes[r]);
+
+    {
+      std::string top_blob(header.top_tree_blob_bytes, '\0');
+      MPI_File_read_at(fh, top_tree_offset, top_blob.data(), top_blob.size(),
+                       MPI_BYTE, MPI_STATUS_IGNORE);
+      std::istringstream is(top_blob);
+      tree._top_tree = TreeSerialization::load<TopTree>(space, is);
+    }
+
+    Kokkos::View<size_type *, Kokkos::HostSpace> sizes_host(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                           "ArborX::DistributedTree::"
+                           "leave_count_in_local_trees"),
+        comm_size);
+    MPI_File_read_at(fh, sizes_offset, sizes_host.data(),
+                     header.bottom_tree_sizes_bytes, MPI_BYTE,
+                     MPI_STATUS_IGNORE);
+    tree._bottom_tree_sizes = Kokkos::View<size_type *, MemorySpace>(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::DistributedTree::"
+                           "leave_count_in_local_trees"),
+        comm_size);
+    Kokkos::deep_copy(space, tree._bottom_tree_sizes, sizes_host);
+
+    std::uint64_t const num_samples =
+        header.sample_centroids_bytes / sizeof(BoundingVolume);
+    Kokkos::View<BoundingVolume *, Kokkos::HostSpace> samples_host(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                           "ArborX::DistributedTree::sample_centroids"),
+        num_samples);
+    MPI_File_read_at(fh, samples_offset, samples_host.data(),
+                     header.sample_centroids_bytes, MPI_BYTE,
+                     MPI_STATUS_IGNORE);
+    tree._sample_centroids = Kokkos::View<BoundingVolume *, MemorySpace>(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::DistributedTree::sample_centroids"),
+        num_samples);
+    Kokkos::deep_copy(space, tree._sample_centroids, samples_host);
+
+    {
+      std::uint64_t const blob_bytes = blob_sizes[comm_rank];
+      ARBORX_ASSERT(blob_bytes <= (std::uint64_t)INT_MAX);
+      std::string blob(blob_bytes, '\0');
+      MPI_File_read_at_all(fh, blob_offset, blob.data(), (int)blob_bytes,
+                           MPI_BYTE, MPI_STATUS_IGNORE);
+      std::istringstream is(blob);
+      tree._bottom_tree = TreeSerialization::load<BottomTree>(space, is);
+    }
+
+    MPI_File_close(&fh);
+
+    tree._top_tree_size =
+        Details::KokkosExt::reduce(space, tree._bottom_tree_sizes, 0);
+
+    return tree;
+  }
+};
+
+} // namespace Details
+
+namespace Experimental
+{
+
+// Collective over the tree's communicator: checkpoint a distributed tree
+// into a single shared file and restore it without rebuilding anything,
+// which on unchanged geometry replaces the full construction at restart.
+// The file records the communicator size and must be loaded on that many
+// ranks. Opt-in state (halo replication, plan caches, telemetry
+// attachments) is not part of the checkpoint; re-enable it after loading.
+// The same indexable getter restriction applies as for saveTree().
+
+template <typename Tree>
+void saveDistributedTree(Tree const &tree, std::string const &filename)
+{
+  Details::DistributedTreeSerialization::save(tree, filename);
+}
+
+template <typename Tree, typename ExecutionSpace>
+Tree loadDistributedTree(MPI_Comm comm, ExecutionSpace const &space,
+                         std::string const &filename)
+{
+  return Details::DistributedTreeSerialization::load<Tree>(comm, space,
+                                                           filename);
+}
+
+} // namespace Experimental
+
+} // namespace ArborX
+
+#endif
@@ -12,6 +12,7 @@
 #define ARBORX_HDBSCAN_HPP
 
 #include <ArborX_Dendrogram.hpp>
+#include <ArborX_DetailsFlatClustering.hpp>
 #include <ArborX_MinimumSpanningTree.hpp>
 
 #include <Kokkos_Profiling_ScopedRegion.hpp>
@@ -51,6 +52,21 @@ auto hdbscan(ExecutionSpace const &exec_space, Primitives const &primitives,
   return dendrogram;
 }
 
+// Extract flat clusters from the dendrogram using excess-of-mass stability
+// selection. Returns per-vertex cluster labels, with -1 denoting noise.
+template <typename ExecutionSpace, typename MemorySpace>
+Kokkos::View<int *, MemorySpace>
+extractFlatClusters(ExecutionSpace const &exec_space,
+                    Dendrogram<MemorySpace> const &dendrogram,
+                    int min_cluster_size)
+{
+  Kokkos::Profiling::ScopedRegion guard("ArborX::HDBSCAN::flat_clusters");
+
+  return Details::extractEOMClusters(exec_space, dendrogram._parents,
+                                     dendrogram._parent_heights,
+                                     min_cluster_size);
+}
+
 } // namespace ArborX::Experimental
 
 #endif
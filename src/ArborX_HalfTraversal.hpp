@@ -0,0 +1,58 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_HALF_TRAVERSAL_HPP
+#define ARBORX_HALF_TRAVERSAL_HPP
+
+#include <ArborX_DetailsHalfTraversal.hpp>
+#include <ArborX_DetailsKokkosExtAccessibilityTraits.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+namespace ArborX::Experimental
+{
+
+// Enumerate each qualifying pair of tree values exactly once and hand it
+// straight to the callback, without materializing a neighbor list. For
+// pairwise interactions (forces, collision response) this skips both the
+// storage of the CRS list and the extra pass over it that a query-based
+// formulation pays.
+//
+// predicate_getter maps a tree value to the predicate selecting its
+// partners (e.g. intersects(sphere) around it, as in the neighbor list
+// searches); callback(value_a, value_b) is invoked from within the
+// traversal kernel and must be thread-safe. Each pair (a, b) with the
+// predicate of a matching b is visited once, in one orientation only: when
+// the predicates are symmetric -- the predicate of a matches b exactly when
+// the predicate of b matches a, as with a common radius -- this is every
+// unordered pair exactly once. A value is never paired with itself, and
+// values removed by remove_if() take part in no pair.
+template <typename ExecutionSpace, typename Tree, typename PredicateGetter,
+          typename Callback>
+void halfTraversal(ExecutionSpace const &space, Tree const &tree,
+                   PredicateGetter const &predicate_getter,
+                   Callback const &callback)
+{
+  static_assert(
+      Details::KokkosExt::is_accessible_from<typename Tree::memory_space,
+                                             ExecutionSpace>::value,
+      "Tree must be accessible from the execution space");
+
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::Experimental::halfTraversal");
+
+  Details::HalfTraversal(space, tree, callback, predicate_getter);
+}
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -0,0 +1,278 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_HARDWARE_RAY_TRACER_HPP
+#define ARBORX_HARDWARE_RAY_TRACER_HPP
+
+#include <ArborX_Config.hpp> // ARBORX_ENABLE_HIPRT
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_AttachIndices.hpp>
+#include <ArborX_Callbacks.hpp>
+#include <ArborX_DetailsKokkosExtAccessibilityTraits.hpp>
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_Exception.hpp>
+#include <ArborX_HyperTriangle.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_PairValueIndex.hpp>
+#include <ArborX_Predicates.hpp>
+#include <ArborX_Ray.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#ifdef ARBORX_ENABLE_HIPRT
+#include <memory>
+
+#include <hiprt/hiprt.h>
+#ifdef __HIPCC__
+#include <hiprt/hiprt_device.h>
+#endif
+#endif
+
+namespace ArborX::Experimental
+{
+
+// Triangle-mesh accelerator that lowers batches of intersects(Ray) and
+// intersects(BoundedRay) predicates onto the vendor ray-tracing runtime when
+// one was enabled at configure time (currently HIP RT on AMD GPUs, where the
+// hardware traversal units are otherwise idle during query()), and onto the
+// software BVH traversal everywhere else. Non-ray predicates always take the
+// software path, so the tracer is a drop-in replacement for a tree built
+// over the same triangles. Hits are reported through the usual callback
+// interface as PairValueIndex{triangle, triangle index}, in unspecified
+// order within a query, matching the spatial traversal contract.
+template <typename MemorySpace>
+class HardwareRayTracer
+{
+public:
+  using memory_space = MemorySpace;
+  static_assert(Kokkos::is_memory_space<MemorySpace>::value);
+  using triangle_type = ExperimentalHyperGeometry::Triangle<3, float>;
+  using value_type = PairValueIndex<triangle_type>;
+  using size_type = typename MemorySpace::size_type;
+
+  HardwareRayTracer() = default;
+
+  template <typename ExecutionSpace>
+  HardwareRayTracer(ExecutionSpace const &space,
+                    Kokkos::View<triangle_type *, MemorySpace> const &triangles)
+      : _triangles(triangles)
+      , _bvh(space, attach_indices(triangles))
+  {
+#ifdef ARBORX_ENABLE_HIPRT
+    if constexpr (std::is_same_v<ExecutionSpace, Kokkos::HIP>)
+      if (!_bvh.empty())
+        buildGeometry(space);
+#endif
+  }
+
+  KOKKOS_FUNCTION
+  size_type size() const noexcept { return _triangles.extent(0); }
+
+  KOKKOS_FUNCTION
+  bool empty() const noexcept { return size() == 0; }
+
+  KOKKOS_FUNCTION
+  auto bounds() const noexcept { return _bvh.bounds(); }
+
+  template <typename ExecutionSpace, typename Predicates, typename Callback>
+  void query(ExecutionSpace const &space, Predicates const &user_predicates,
+             Callback const &callback) const
+  {
+    static_assert(
+        Details::KokkosExt::is_accessible_from<MemorySpace,
+                                               ExecutionSpace>::value);
+    Details::check_valid_access_traits(PredicatesTag{}, user_predicates);
+
+    using Predicate =
+        typename Details::AccessValues<Predicates, PredicatesTag>::value_type;
+    using Geometry = std::decay_t<decltype(getGeometry(
+        std::declval<Predicate const &>()))>;
+
+#ifdef ARBORX_ENABLE_HIPRT
+    // The runtime only traces on the device it was created on, so host
+    // execution spaces fall through to the software traversal even for rays
+    constexpr bool is_ray_predicate =
+        std::is_same_v<Geometry, Ray> || std::is_same_v<Geometry, BoundedRay>;
+    if constexpr (is_ray_predicate &&
+                  std::is_same_v<ExecutionSpace, Kokkos::HIP>)
+    {
+      if (_hiprt)
+      {
+        trace(space, user_predicates, callback);
+        return;
+      }
+    }
+#endif
+
+    Kokkos::Profiling::ScopedRegion guard(
+        "ArborX::HardwareRayTracer::query::software");
+    _bvh.query(space, user_predicates, callback);
+  }
+
+private:
+#ifdef ARBORX_ENABLE_HIPRT
+  // Context and geometry are destroyed together once the last shallow tracer
+  // copy goes away; the vertex and index buffers they reference are kept
+  // alive by the corresponding view members
+  struct HiprtHandles
+  {
+    hiprtContext context = nullptr;
+    hiprtGeometry geometry = nullptr;
+
+    ~HiprtHandles()
+    {
+      if (geometry != nullptr)
+        hiprtDestroyGeometry(context, geometry);
+      if (context != nullptr)
+        hiprtDestroyContext(context);
+    }
+  };
+
+  void buildGeometry(Kokkos::HIP const &space)
+  {
+    Kokkos::Profiling::ScopedRegion guard(
+        "ArborX::HardwareRayTracer::build_geometry");
+
+    int const n = _triangles.extent(0);
+
+    // Flatten the triangles into the vertex/index layout the runtime expects
+    _vertices = Kokkos::View<hiprtFloat3 *, MemorySpace>(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::HardwareRayTracer::vertices"),
+        3 * n);
+    _indices = Kokkos::View<hiprtInt3 *, MemorySpace>(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::HardwareRayTracer::indices"),
+        n);
+    auto triangles = _triangles;
+    auto vertices = _vertices;
+    auto indices = _indices;
+    Kokkos::parallel_for(
+        "ArborX::HardwareRayTracer::flatten_triangles",
+        Kokkos::RangePolicy<Kokkos::HIP>(space, 0, n), KOKKOS_LAMBDA(int i) {
+          auto const &t = triangles(i);
+          vertices(3 * i + 0) = {t.a[0], t.a[1], t.a[2]};
+          vertices(3 * i + 1) = {t.b[0], t.b[1], t.b[2]};
+          vertices(3 * i + 2) = {t.c[0], t.c[1], t.c[2]};
+          indices(i) = {3 * i, 3 * i + 1, 3 * i + 2};
+        });
+
+    _hiprt = std::make_shared<HiprtHandles>();
+
+    hiprtContextCreationInput context_input{};
+    context_input.ctxt = nullptr; // primary context of the active device
+    ARBORX_ASSERT(hipGetDevice(&context_input.device) == hipSuccess);
+    context_input.deviceType = hiprtDeviceAMD;
+    auto error = hiprtCreateContext(HIPRT_API_VERSION, context_input,
+                                    _hiprt->context);
+    ARBORX_ASSERT(error == hiprtSuccess);
+
+    hiprtTriangleMeshPrimitive mesh{};
+    mesh.vertices = _vertices.data();
+    mesh.vertexCount = 3 * n;
+    mesh.vertexStride = sizeof(hiprtFloat3);
+    mesh.triangleIndices = _indices.data();
+    mesh.triangleCount = n;
+    mesh.triangleStride = sizeof(hiprtInt3);
+
+    hiprtGeometryBuildInput build_input{};
+    build_input.type = hiprtPrimitiveTypeTriangleMesh;
+    build_input.primitive.triangleMesh = mesh;
+
+    hiprtBuildOptions options{};
+    options.buildFlags = hiprtBuildFlagBitPreferHighQualityBuild;
+
+    size_t temp_size;
+    error = hiprtGetGeometryBuildTemporaryBufferSize(_hiprt->context,
+                                                     build_input, options,
+                                                     temp_size);
+    ARBORX_ASSERT(error == hiprtSuccess);
+    Kokkos::View<char *, MemorySpace> temp(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::HardwareRayTracer::build_temp"),
+        temp_size);
+
+    error = hiprtCreateGeometry(_hiprt->context, build_input, options,
+                                _hiprt->geometry);
+    ARBORX_ASSERT(error == hiprtSuccess);
+    error = hiprtBuildGeometry(_hiprt->context, hiprtBuildOperationBuild,
+                               build_input, options, temp.data(),
+                               space.hip_stream(), _hiprt->geometry);
+    ARBORX_ASSERT(error == hiprtSuccess);
+
+    // The build is asynchronous on the stream and the temporary buffer is
+    // released on return
+    space.fence("ArborX::HardwareRayTracer::build_geometry");
+  }
+
+  template <typename Predicates, typename Callback>
+  void trace(Kokkos::HIP const &space, Predicates const &user_predicates,
+             Callback const &callback) const
+  {
+    Kokkos::Profiling::ScopedRegion guard(
+        "ArborX::HardwareRayTracer::query::hardware");
+
+    Details::AccessValues<Predicates, PredicatesTag> predicates{
+        user_predicates};
+
+    auto geometry_handle = _hiprt->geometry;
+    auto triangles = _triangles;
+    Kokkos::parallel_for(
+        "ArborX::HardwareRayTracer::trace",
+        Kokkos::RangePolicy<Kokkos::HIP>(space, 0, predicates.size()),
+        KOKKOS_LAMBDA(int i) {
+          auto const &predicate = predicates(i);
+          auto const &geometry = getGeometry(predicate);
+
+          hiprtRay ray;
+          ray.origin = {geometry.origin()[0], geometry.origin()[1],
+                        geometry.origin()[2]};
+          ray.direction = {geometry.direction()[0], geometry.direction()[1],
+                           geometry.direction()[2]};
+          ray.minT = 0.f;
+          if constexpr (std::is_same_v<std::decay_t<decltype(geometry)>,
+                                       BoundedRay>)
+            ray.maxT = geometry.tmax();
+          else
+            ray.maxT =
+                Details::KokkosExt::ArithmeticTraits::infinity<float>::value;
+
+          // Enumerate every hit in the interval; the callback may still
+          // terminate the query early (e.g., for occlusion tests)
+          hiprtGeomTraversalAnyHit traversal(geometry_handle, ray);
+          while (true)
+          {
+            hiprtHit const hit = traversal.getNextHit();
+            if (!hit.hasHit())
+              break;
+            if (Details::invoke_callback_and_check_early_exit(
+                    callback, predicate,
+                    value_type{triangles(hit.primID),
+                               (unsigned int)hit.primID}))
+              break;
+          }
+        });
+  }
+
+  std::shared_ptr<HiprtHandles> _hiprt;
+  Kokkos::View<hiprtFloat3 *, MemorySpace> _vertices;
+  Kokkos::View<hiprtInt3 *, MemorySpace> _indices;
+#endif
+
+  Kokkos::View<triangle_type *, MemorySpace> _triangles;
+  BoundingVolumeHierarchy<MemorySpace, value_type> _bvh;
+};
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -0,0 +1,308 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_INCREMENTAL_DBSCAN_HPP
+#define ARBORX_INCREMENTAL_DBSCAN_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_DBSCAN.hpp>
+#include <ArborX_DetailsFDBSCAN.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DetailsUnionFind.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_PairValueIndex.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX
+{
+
+namespace Details
+{
+
+// Count the neighbors gained by an insertion batch. A query is run for every
+// inserted point, so an inserted point accumulates its full neighbor count
+// (including itself, matching CountUpToN), while a pre-existing point is
+// bumped once for every inserted point that finds it.
+template <typename MemorySpace>
+struct IncrementalNeighborCount
+{
+  Kokkos::View<int *, MemorySpace> _counts;
+  int _num_old_points;
+
+  template <typename Query, typename Value, typename Index>
+  KOKKOS_FUNCTION void operator()(Query const &query,
+                                  PairValueIndex<Value, Index> const &value) const
+  {
+    int const i = getData(query);
+    int const j = (int)value.index;
+    Kokkos::atomic_increment(&_counts(i));
+    if (j < _num_old_points)
+      Kokkos::atomic_increment(&_counts(j));
+  }
+};
+
+// Same cluster merging logic as FDBSCANCallback, but invoked through a
+// regular query with the global point index attached to the predicate
+// instead of through HalfTraversal.
+template <typename UnionFind, typename CorePointsType>
+struct IncrementalDBSCANCallback
+{
+  UnionFind _union_find;
+  CorePointsType _is_core_point;
+
+  template <typename Query, typename Value, typename Index>
+  KOKKOS_FUNCTION auto operator()(Query const &query,
+                                  PairValueIndex<Value, Index> const &value) const
+  {
+    int const i = getData(query);
+    int const j = (int)value.index;
+
+    bool const is_border_point = !_is_core_point(i);
+    bool const neighbor_is_core_point = _is_core_point(j);
+    if (is_border_point)
+    {
+      if (neighbor_is_core_point)
+      {
+        // See FDBSCANCallback for why merge_into() and not merge()
+        _union_find.merge_into(i, j);
+        return CallbackTreeTraversalControl::early_exit;
+      }
+    }
+    else
+    {
+      if (neighbor_is_core_point)
+        _union_find.merge(i, j);
+      else
+        _union_find.merge_into(j, i);
+    }
+
+    return CallbackTreeTraversalControl::normal_continuation;
+  }
+};
+
+} // namespace Details
+
+namespace Experimental
+{
+
+// Incremental DBSCAN for workloads that append small batches of points to a
+// large mostly static cloud. The class keeps the points, the per-point
+// neighbor counts and the union-find label structure alive between batches,
+// so an insertion only runs neighbor queries for the inserted points and for
+// the pre-existing points they promote to core status, instead of
+// re-clustering from scratch. The search tree is still reconstructed over all
+// points, but construction is cheap compared to the O(n) neighbor queries a
+// full re-clustering would perform.
+template <typename MemorySpace, typename Point>
+class IncrementalDBSCAN
+{
+  static_assert(GeometryTraits::is_point_v<Point>);
+
+  Kokkos::View<Point *, MemorySpace> _points;
+  Kokkos::View<int *, MemorySpace> _labels;
+  Kokkos::View<int *, MemorySpace> _num_neigh;
+  BoundingVolumeHierarchy<MemorySpace, PairValueIndex<Point>> _bvh;
+  float _eps;
+  int _core_min_size;
+
+public:
+  using memory_space = MemorySpace;
+
+  IncrementalDBSCAN(float eps, int core_min_size)
+      : _points("ArborX::IncrementalDBSCAN::points", 0)
+      , _labels("ArborX::IncrementalDBSCAN::labels", 0)
+      , _num_neigh("ArborX::IncrementalDBSCAN::num_neighbors", 0)
+      , _eps(eps)
+      , _core_min_size(core_min_size)
+  {
+    ARBORX_ASSERT(eps > 0);
+    ARBORX_ASSERT(core_min_size >= 2);
+  }
+
+  auto size() const { return _points.size(); }
+
+  template <typename ExecutionSpace, typename Primitives>
+  void insert(ExecutionSpace const &space, Primitives const &primitives)
+  {
+    Kokkos::Profiling::ScopedRegion guard("ArborX::IncrementalDBSCAN::insert");
+
+    namespace KokkosExt = Details::KokkosExt;
+
+    static_assert(
+        KokkosExt::is_accessible_from<MemorySpace, ExecutionSpace>::value);
+
+    Details::AccessValues<Primitives, PrimitivesTag> new_points{primitives};
+    static_assert(
+        std::is_same_v<typename decltype(new_points)::value_type, Point>);
+
+    int const num_old_points = _points.size();
+    int const num_new_points = new_points.size();
+    if (num_new_points == 0)
+      return;
+    int const n = num_old_points + num_new_points;
+
+#ifdef KOKKOS_ENABLE_SERIAL
+    using UnionFind = Details::UnionFind<
+        MemorySpace,
+        /*DoSerial=*/std::is_same_v<ExecutionSpace, Kokkos::Serial>>;
+#else
+    using UnionFind = Details::UnionFind<MemorySpace>;
+#endif
+
+    Kokkos::resize(Kokkos::view_alloc(space, Kokkos::WithoutInitializing),
+                   _points, n);
+    auto points = _points;
+    Kokkos::parallel_for(
+        "ArborX::IncrementalDBSCAN::append_points",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_new_points),
+        KOKKOS_LAMBDA(int i) { points(num_old_points + i) = new_points(i); });
+
+    // New points start out as singleton clusters
+    Kokkos::resize(Kokkos::view_alloc(space, Kokkos::WithoutInitializing),
+                   _labels, n);
+    auto labels = _labels;
+    Kokkos::parallel_for(
+        "ArborX::IncrementalDBSCAN::init_new_labels",
+        Kokkos::RangePolicy<ExecutionSpace>(space, num_old_points, n),
+        KOKKOS_LAMBDA(int i) { labels(i) = i; });
+
+    // Remember which points were already core, so that the ones promoted by
+    // this batch can be identified below (new entries are zero-initialized)
+    Kokkos::resize(Kokkos::view_alloc(space), _num_neigh, n);
+    auto num_neigh = _num_neigh;
+    int const core_min_size = _core_min_size;
+    Kokkos::View<bool *, MemorySpace> was_core(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::IncrementalDBSCAN::was_core"),
+        num_old_points);
+    Kokkos::parallel_for(
+        "ArborX::IncrementalDBSCAN::snapshot_core_points",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_old_points),
+        KOKKOS_LAMBDA(int i) { was_core(i) = (num_neigh(i) >= core_min_size); });
+
+    Kokkos::Profiling::pushRegion(
+        "ArborX::IncrementalDBSCAN::tree_construction");
+    _bvh = BoundingVolumeHierarchy<MemorySpace, PairValueIndex<Point>>(
+        space, Experimental::attach_indices(_points));
+    Kokkos::Profiling::popRegion();
+
+    // Update the neighbor counts using only queries for the inserted points
+    Kokkos::Profiling::pushRegion("ArborX::IncrementalDBSCAN::num_neigh");
+    Kokkos::View<int *, MemorySpace> new_indices(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::IncrementalDBSCAN::new_indices"),
+        num_new_points);
+    KokkosExt::iota(space, new_indices, num_old_points);
+    _bvh.query(space,
+               Details::PrimitivesWithRadiusReorderedAndFiltered<
+                   decltype(points), decltype(new_indices)>{points, _eps,
+                                                            new_indices},
+               Details::IncrementalNeighborCount<MemorySpace>{num_neigh,
+                                                              num_old_points});
+    Kokkos::Profiling::popRegion();
+
+    // The inserted points need their neighborhood edges processed, and so do
+    // the pre-existing points that just became core: their edges were not
+    // merged when they were border points
+    Kokkos::View<int *, MemorySpace> query_indices(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::IncrementalDBSCAN::query_indices"),
+        n);
+    Kokkos::View<int, MemorySpace> counter(
+        Kokkos::view_alloc(space, "ArborX::IncrementalDBSCAN::counter"));
+    Kokkos::parallel_for(
+        "ArborX::IncrementalDBSCAN::gather_query_indices",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int i) {
+          bool const is_new = (i >= num_old_points);
+          bool const is_promoted = !is_new && !was_core(i) &&
+                                   num_neigh(i) >= core_min_size;
+          if (is_new || is_promoted)
+            query_indices(Kokkos::atomic_fetch_add(&counter(), 1)) = i;
+        });
+    int num_queries;
+    Kokkos::View<int, Kokkos::HostSpace> counter_host(
+        "ArborX::IncrementalDBSCAN::counter_host");
+    Kokkos::deep_copy(space, counter_host, counter);
+    space.fence("ArborX::IncrementalDBSCAN (counter copied to host)");
+    num_queries = counter_host();
+    Kokkos::resize(Kokkos::view_alloc(space, Kokkos::WithoutInitializing),
+                   query_indices, num_queries);
+
+    Kokkos::Profiling::pushRegion("ArborX::IncrementalDBSCAN::clusters");
+    _bvh.query(
+        space,
+        Details::PrimitivesWithRadiusReorderedAndFiltered<
+            decltype(points), decltype(query_indices)>{points, _eps,
+                                                       query_indices},
+        Details::IncrementalDBSCANCallback<
+            UnionFind, Details::DBSCANCorePoints<MemorySpace>>{
+            UnionFind{_labels},
+            Details::DBSCANCorePoints<MemorySpace>{num_neigh, core_min_size}});
+    Kokkos::Profiling::popRegion();
+  }
+
+  // Return finalized labels (representatives flattened, noise marked with
+  // -1). The internal label structure is left untouched so that later
+  // insertions can keep merging into it.
+  template <typename ExecutionSpace>
+  Kokkos::View<int *, MemorySpace> labels(ExecutionSpace const &space) const
+  {
+    Kokkos::Profiling::ScopedRegion guard("ArborX::IncrementalDBSCAN::labels");
+
+    namespace KokkosExt = Details::KokkosExt;
+
+    int const n = size();
+
+    auto labels =
+        KokkosExt::clone(space, _labels, "ArborX::IncrementalDBSCAN::labels");
+
+    Kokkos::View<int *, MemorySpace> cluster_sizes(
+        Kokkos::view_alloc(space, "ArborX::IncrementalDBSCAN::cluster_sizes"),
+        n);
+    Kokkos::parallel_for(
+        "ArborX::IncrementalDBSCAN::finalize_labels",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int const i) {
+          // ##### ECL license (see LICENSE.ECL) #####
+          int next;
+          int vstat = labels(i);
+          int const old = vstat;
+          while (vstat > (next = labels(vstat)))
+          {
+            vstat = next;
+          }
+          if (vstat != old)
+            labels(i) = vstat;
+
+          Kokkos::atomic_increment(&cluster_sizes(labels(i)));
+        });
+
+    Details::DBSCANCorePoints<MemorySpace> is_core{_num_neigh, _core_min_size};
+    Kokkos::parallel_for(
+        "ArborX::IncrementalDBSCAN::mark_noise",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int const i) {
+          if (cluster_sizes(labels(i)) == 1 && !is_core(i))
+            labels(i) = -1;
+        });
+
+    return labels;
+  }
+};
+
+} // namespace Experimental
+
+} // namespace ArborX
+
+#endif
@@ -0,0 +1,249 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_INSTANCED_BVH_HPP
+#define ARBORX_INSTANCED_BVH_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_DetailsKokkosExtAccessibilityTraits.hpp>
+#include <ArborX_GeometryTraits.hpp>
+#include <ArborX_HyperBox.hpp>
+#include <ArborX_HyperPoint.hpp>
+#include <ArborX_HyperSphere.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_PairValueIndex.hpp>
+#include <ArborX_Predicates.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+namespace ArborX::Experimental
+{
+
+// Rigid (rotation + translation) transform placing an object-space tree into
+// the scene. The rotation matrix is expected to be orthonormal so that the
+// inverse is the transpose.
+template <int DIM, typename Coordinate = float>
+struct RigidTransform
+{
+  Coordinate rotation[DIM][DIM];
+  Coordinate translation[DIM];
+
+  KOKKOS_DEFAULTED_FUNCTION RigidTransform() = default;
+
+  static KOKKOS_FUNCTION RigidTransform identity()
+  {
+    RigidTransform t;
+    for (int i = 0; i < DIM; ++i)
+    {
+      for (int j = 0; j < DIM; ++j)
+        t.rotation[i][j] = (i == j);
+      t.translation[i] = 0;
+    }
+    return t;
+  }
+
+  template <typename Point>
+  KOKKOS_FUNCTION auto apply(Point const &p) const
+  {
+    static_assert(GeometryTraits::is_point_v<Point>);
+    static_assert(GeometryTraits::dimension_v<Point> == DIM);
+    Point r;
+    for (int i = 0; i < DIM; ++i)
+    {
+      Coordinate x = translation[i];
+      for (int j = 0; j < DIM; ++j)
+        x += rotation[i][j] * p[j];
+      r[i] = x;
+    }
+    return r;
+  }
+
+  template <typename Point>
+  KOKKOS_FUNCTION auto applyInverse(Point const &p) const
+  {
+    static_assert(GeometryTraits::is_point_v<Point>);
+    static_assert(GeometryTraits::dimension_v<Point> == DIM);
+    Point r;
+    for (int i = 0; i < DIM; ++i)
+    {
+      Coordinate x = 0;
+      for (int j = 0; j < DIM; ++j)
+        x += rotation[j][i] * (p[j] - translation[j]);
+      r[i] = x;
+    }
+    return r;
+  }
+};
+
+// Two-level hierarchy: a top-level tree over rigidly transformed instances of
+// bottom-level trees. Moving an instance only requires rebuilding the
+// top-level tree, whose size is the number of instances, not the number of
+// primitives. Bottom-level trees may be shared between instances (tree copies
+// are shallow). Only spatial predicates with point or sphere geometries are
+// supported, as those transform exactly under rigid motion.
+template <typename MemorySpace, typename BottomTree>
+class InstancedBVH
+{
+public:
+  using memory_space = MemorySpace;
+  static_assert(Kokkos::is_memory_space<MemorySpace>::value);
+  using size_type = typename MemorySpace::size_type;
+  using bottom_tree_type = BottomTree;
+  using bounding_volume_type = typename BottomTree::bounding_volume_type;
+  using value_type =
+      PairValueIndex<typename BottomTree::value_type, unsigned int>;
+
+  static constexpr int DIM =
+      GeometryTraits::dimension_v<bounding_volume_type>;
+  using coordinate_type =
+      typename GeometryTraits::coordinate_type_t<bounding_volume_type>;
+  using transform_type = RigidTransform<DIM, coordinate_type>;
+
+  InstancedBVH() = default;
+
+  template <typename ExecutionSpace>
+  InstancedBVH(ExecutionSpace const &space,
+               Kokkos::View<BottomTree *, MemorySpace> const &bottom_trees,
+               Kokkos::View<transform_type *, MemorySpace> const &transforms)
+      : _bottom_trees(bottom_trees)
+      , _transforms(transforms)
+  {
+    ARBORX_ASSERT(bottom_trees.extent(0) == transforms.extent(0));
+    buildTopTree(space);
+  }
+
+  KOKKOS_FUNCTION
+  size_type size() const noexcept { return _bottom_trees.extent(0); }
+
+  KOKKOS_FUNCTION
+  bool empty() const noexcept { return size() == 0; }
+
+  // Reposition the instances and rebuild the top-level tree. The cost is
+  // proportional to the number of instances.
+  template <typename ExecutionSpace>
+  void update(ExecutionSpace const &space,
+              Kokkos::View<transform_type *, MemorySpace> const &transforms)
+  {
+    ARBORX_ASSERT(transforms.extent(0) == _bottom_trees.extent(0));
+    _transforms = transforms;
+    buildTopTree(space);
+  }
+
+  template <typename ExecutionSpace, typename Predicates, typename Callback>
+  void query(ExecutionSpace const &space, Predicates const &user_predicates,
+             Callback const &callback) const
+  {
+    static_assert(
+        Details::KokkosExt::is_accessible_from<MemorySpace,
+                                               ExecutionSpace>::value);
+    Details::check_valid_access_traits(PredicatesTag{}, user_predicates);
+
+    Kokkos::Profiling::ScopedRegion guard(
+        "ArborX::InstancedBVH::query::spatial");
+
+    _top_tree.query(
+        space, user_predicates,
+        TopLevelCallback<Callback>{_bottom_trees, _transforms, callback});
+  }
+
+private:
+  using box_type = ExperimentalHyperGeometry::Box<DIM, coordinate_type>;
+  using top_value_type = PairValueIndex<box_type, unsigned int>;
+
+  template <typename Callback>
+  struct TopLevelCallback
+  {
+    Kokkos::View<BottomTree *, MemorySpace> _bottom_trees;
+    Kokkos::View<transform_type *, MemorySpace> _transforms;
+    Callback _callback;
+
+    template <typename Predicate, typename Geometry>
+    KOKKOS_FUNCTION auto transformGeometry(Predicate const &,
+                                           Geometry const &geometry,
+                                           transform_type const &t) const
+    {
+      if constexpr (GeometryTraits::is_point_v<Geometry>)
+      {
+        return t.applyInverse(geometry);
+      }
+      else
+      {
+        static_assert(GeometryTraits::is_sphere_v<Geometry>,
+                      "InstancedBVH only supports spatial predicates with "
+                      "point or sphere geometries");
+        return Geometry{t.applyInverse(geometry.centroid()),
+                        geometry.radius()};
+      }
+    }
+
+    template <typename Predicate>
+    KOKKOS_FUNCTION void operator()(Predicate const &predicate,
+                                    top_value_type const &top_value) const
+    {
+      auto const instance = top_value.index;
+      auto const &transform = _transforms(instance);
+      auto const &callback = _callback;
+      auto object_space_geometry = transformGeometry(
+          predicate, getGeometry(predicate), transform);
+      _bottom_trees(instance).query(
+          PerThread{}, intersects(object_space_geometry),
+          [&predicate, &callback,
+           instance](auto const &, typename BottomTree::value_type const &value)
+          { callback(predicate, value_type{value, instance}); });
+    }
+  };
+
+  template <typename ExecutionSpace>
+  void buildTopTree(ExecutionSpace const &space)
+  {
+    Kokkos::Profiling::ScopedRegion guard(
+        "ArborX::InstancedBVH::build_top_tree");
+
+    auto const n = _bottom_trees.extent(0);
+    Kokkos::View<top_value_type *, MemorySpace> instance_boxes(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::InstancedBVH::instance_boxes"),
+        n);
+    auto bottom_trees = _bottom_trees;
+    auto transforms = _transforms;
+    Kokkos::parallel_for(
+        "ArborX::InstancedBVH::compute_instance_boxes",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(unsigned int i) {
+          using Details::expand;
+          auto const object_bounds = bottom_trees(i).bounds();
+          // Transform the corners of the object-space bounds and wrap them in
+          // an axis-aligned world-space box
+          box_type world_bounds;
+          for (int corner = 0; corner < (1 << DIM); ++corner)
+          {
+            ExperimentalHyperGeometry::Point<DIM, coordinate_type> p;
+            for (int d = 0; d < DIM; ++d)
+              p[d] = (corner & (1 << d)) ? object_bounds.maxCorner()[d]
+                                         : object_bounds.minCorner()[d];
+            expand(world_bounds, transforms(i).apply(p));
+          }
+          instance_boxes(i) = {world_bounds, i};
+        });
+
+    _top_tree = BoundingVolumeHierarchy<MemorySpace, top_value_type>(
+        space, instance_boxes);
+  }
+
+  Kokkos::View<BottomTree *, MemorySpace> _bottom_trees;
+  Kokkos::View<transform_type *, MemorySpace> _transforms;
+  BoundingVolumeHierarchy<MemorySpace, top_value_type> _top_tree;
+};
+
+} // namespace ArborX::Experimental
+
+#endif
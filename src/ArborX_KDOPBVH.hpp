@@ -0,0 +1,161 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_KDOP_BVH_HPP
+#define ARBORX_KDOP_BVH_HPP
+
+#include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_GeometryTraits.hpp>
+#include <ArborX_IndexableGetter.hpp>
+#include <ArborX_KDOP.hpp>
+#include <ArborX_LinearBVH.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <utility>
+
+namespace ArborX::Experimental
+{
+
+// Bounding volume shape selected at run time
+enum class KDOPBVHVolume
+{
+  box,
+  kdop14,
+  kdop18
+};
+
+// Hierarchy whose bounding volume shape is chosen at construction rather
+// than through the BoundingVolumeHierarchy template parameter, so that a
+// single index type can switch between boxes and discrete orientation
+// polytopes without template plumbing through the whole program. Tighter
+// volumes trade a more expensive node test (the slab loops have constant
+// trip counts and unroll) for fewer traversed nodes and leaf tests, which
+// pays off for thin or diagonal geometry that axis-aligned boxes overlap
+// badly. Only spatial predicates are supported: the polytopes do not define
+// a distance.
+template <typename MemorySpace, typename Value,
+          typename IndexableGetter = Details::DefaultIndexableGetter>
+class KDOPBVH
+{
+private:
+  using indexable_type =
+      std::decay_t<std::invoke_result_t<IndexableGetter, Value>>;
+  static_assert(GeometryTraits::dimension_v<indexable_type> == 3,
+                "KDOPBVH only supports three-dimensional indexables");
+  using coordinate_type = GeometryTraits::coordinate_type_t<indexable_type>;
+
+  using BoxTree = BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter>;
+  using KDOP14Tree =
+      BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter,
+                              KDOP<3, 14, coordinate_type>>;
+  using KDOP18Tree =
+      BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter,
+                              KDOP<3, 18, coordinate_type>>;
+
+public:
+  using memory_space = MemorySpace;
+  static_assert(Kokkos::is_memory_space<MemorySpace>::value);
+  using size_type = typename MemorySpace::size_type;
+  using bounding_volume_type = typename BoxTree::bounding_volume_type;
+  using value_type = Value;
+
+  KDOPBVH() = default; // build an empty tree
+
+  template <typename ExecutionSpace, typename Values>
+  KDOPBVH(ExecutionSpace const &space, Values const &values,
+          IndexableGetter const &indexable_getter = IndexableGetter(),
+          KDOPBVHVolume volume = KDOPBVHVolume::box)
+      : _volume(volume)
+  {
+    switch (_volume)
+    {
+    case KDOPBVHVolume::box:
+      _box_tree = BoxTree(space, values, indexable_getter);
+      break;
+    case KDOPBVHVolume::kdop14:
+      _kdop14_tree = KDOP14Tree(space, values, indexable_getter);
+      break;
+    case KDOPBVHVolume::kdop18:
+      _kdop18_tree = KDOP18Tree(space, values, indexable_getter);
+      break;
+    }
+  }
+
+  KOKKOS_FUNCTION
+  size_type size() const noexcept
+  {
+    switch (_volume)
+    {
+    case KDOPBVHVolume::kdop14:
+      return _kdop14_tree.size();
+    case KDOPBVHVolume::kdop18:
+      return _kdop18_tree.size();
+    default:
+      return _box_tree.size();
+    }
+  }
+
+  KOKKOS_FUNCTION
+  bool empty() const noexcept { return size() == 0; }
+
+  KOKKOS_FUNCTION
+  bounding_volume_type bounds() const noexcept
+  {
+    bounding_volume_type box{};
+    switch (_volume)
+    {
+    case KDOPBVHVolume::kdop14:
+      Details::expand(box, _kdop14_tree.bounds());
+      break;
+    case KDOPBVHVolume::kdop18:
+      Details::expand(box, _kdop18_tree.bounds());
+      break;
+    default:
+      box = _box_tree.bounds();
+      break;
+    }
+    return box;
+  }
+
+  template <typename ExecutionSpace, typename UserPredicates, typename... Args>
+  void query(ExecutionSpace const &space, UserPredicates const &user_predicates,
+             Args &&...args) const
+  {
+    using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+    using Tag = typename Predicates::value_type::Tag;
+    static_assert(std::is_same_v<Tag, Details::SpatialPredicateTag>,
+                  "KDOPBVH only supports spatial predicates");
+
+    switch (_volume)
+    {
+    case KDOPBVHVolume::kdop14:
+      _kdop14_tree.query(space, user_predicates, std::forward<Args>(args)...);
+      break;
+    case KDOPBVHVolume::kdop18:
+      _kdop18_tree.query(space, user_predicates, std::forward<Args>(args)...);
+      break;
+    default:
+      _box_tree.query(space, user_predicates, std::forward<Args>(args)...);
+      break;
+    }
+  }
+
+private:
+  KDOPBVHVolume _volume = KDOPBVHVolume::box;
+  BoxTree _box_tree;
+  KDOP14Tree _kdop14_tree;
+  KDOP18Tree _kdop18_tree;
+};
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -0,0 +1,511 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_KDTREE_HPP
+#define ARBORX_KDTREE_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_Callbacks.hpp>
+#include <ArborX_DetailsContainers.hpp>
+#include <ArborX_DetailsCrsGraphWrapperImpl.hpp>
+#include <ArborX_DetailsHeap.hpp>
+#include <ArborX_DetailsKokkosExtAccessibilityTraits.hpp>
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsNearestBufferProvider.hpp>
+#include <ArborX_DetailsPriorityQueue.hpp>
+#include <ArborX_DetailsSortUtils.hpp>
+#include <ArborX_DetailsTreeConstruction.hpp>
+#include <ArborX_GeometryTraits.hpp>
+#include <ArborX_HyperBox.hpp>
+#include <ArborX_IndexableGetter.hpp>
+#include <ArborX_Predicates.hpp>
+#include <ArborX_TraversalPolicy.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+namespace ArborX::Experimental
+{
+
+// Left-balanced k-d tree with implicit layout. The only per-node storage is
+// the value itself: node i is stored at index i of a single array, with the
+// children of node i at 2*i+1 and 2*i+2, the splitting dimension cycling
+// with the depth, and the node's own indexable serving as the splitting
+// plane. Compared to an LBVH there are no bounding boxes, halving (or
+// better) the memory footprint for point data, at the cost of weaker
+// traversal pruning (half-spaces instead of boxes). Only point indexables
+// are supported.
+template <typename MemorySpace, typename Value,
+          typename IndexableGetter = Details::DefaultIndexableGetter>
+class KDTree
+{
+private:
+  using indexable_type =
+      std::decay_t<std::invoke_result_t<IndexableGetter, Value>>;
+  static_assert(GeometryTraits::is_point_v<indexable_type>,
+                "KDTree requires point indexables");
+
+public:
+  using memory_space = MemorySpace;
+  static_assert(Kokkos::is_memory_space<MemorySpace>::value);
+  using size_type = typename MemorySpace::size_type;
+  using value_type = Value;
+
+  static constexpr int DIM = GeometryTraits::dimension_v<indexable_type>;
+  using coordinate_type =
+      typename GeometryTraits::coordinate_type_t<indexable_type>;
+  using bounding_volume_type =
+      ExperimentalHyperGeometry::Box<DIM, coordinate_type>;
+
+  // The construction sort packs the coordinate bits next to the node index
+  // into a single 64-bit key
+  static_assert(std::is_same_v<coordinate_type, float>,
+                "KDTree requires single precision coordinates");
+
+  KDTree() = default; // build an empty tree
+
+  template <typename ExecutionSpace, typename UserValues>
+  KDTree(ExecutionSpace const &space, UserValues const &user_values,
+         IndexableGetter const &indexable_getter = IndexableGetter());
+
+  KOKKOS_FUNCTION
+  size_type size() const noexcept { return _size; }
+
+  KOKKOS_FUNCTION
+  bool empty() const noexcept { return size() == 0; }
+
+  KOKKOS_FUNCTION
+  bounding_volume_type bounds() const noexcept { return _bounds; }
+
+  template <typename ExecutionSpace, typename UserPredicates,
+            typename Callback>
+  void query(ExecutionSpace const &space, UserPredicates const &user_predicates,
+             Callback const &callback,
+             Experimental::TraversalPolicy const & =
+                 Experimental::TraversalPolicy()) const;
+
+  template <typename ExecutionSpace, typename UserPredicates,
+            typename CallbackOrView, typename View, typename... Args>
+  std::enable_if_t<Kokkos::is_view_v<std::decay_t<View>>>
+  query(ExecutionSpace const &space, UserPredicates const &user_predicates,
+        CallbackOrView &&callback_or_view, View &&view, Args &&...args) const
+  {
+    Kokkos::Profiling::ScopedRegion guard("ArborX::KDTree::query_crs");
+
+    Details::CrsGraphWrapperImpl::
+        check_valid_callback_if_first_argument_is_not_a_view<value_type>(
+            callback_or_view, user_predicates, view);
+
+    using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+    using Tag = typename Predicates::value_type::Tag;
+
+    Details::CrsGraphWrapperImpl::queryDispatch(
+        Tag{}, *this, space, Predicates{user_predicates},
+        std::forward<CallbackOrView>(callback_or_view),
+        std::forward<View>(view), std::forward<Args>(args)...);
+  }
+
+  KOKKOS_FUNCTION auto const &indexable_get() const
+  {
+    return _indexable_getter;
+  }
+
+private:
+  // With 32-bit node indices the tree depth does not exceed 31, and the
+  // depth-first traversals hold at most one pending entry per level
+  static constexpr int MAX_STACK_DEPTH = 64;
+
+  // Elements assigned to the subtrees of one level occupy computable
+  // contiguous ranges once sorted by (node id, split coordinate): the bottom
+  // row of the implicit tree fills left to right, so subtree s of the level
+  // gets full_size nodes plus its share of the bottom row
+  struct LevelLayout
+  {
+    int num_done;        // nodes on the levels above, placed one per index
+    int full_size;       // per-subtree node count excluding the bottom row
+    int bottom_capacity; // per-subtree bottom row capacity
+    int bottom_size;     // population of the bottom row of the whole tree
+
+    KOKKOS_FUNCTION int begin(int s) const
+    {
+      return num_done + s * full_size +
+             Kokkos::min(bottom_size, s * bottom_capacity);
+    }
+
+    KOKKOS_FUNCTION int size(int s) const
+    {
+      return full_size +
+             Kokkos::clamp(bottom_size - s * bottom_capacity, 0,
+                           bottom_capacity);
+    }
+
+    KOKKOS_FUNCTION int segment(int i) const
+    {
+      int j = i - num_done;
+      int const num_full = bottom_size / bottom_capacity;
+      if (j < num_full * (full_size + bottom_capacity))
+        return j / (full_size + bottom_capacity);
+      j -= num_full * (full_size + bottom_capacity);
+      int s = num_full;
+      int const partial = bottom_size - num_full * bottom_capacity;
+      if (partial > 0)
+      {
+        if (j < full_size + partial)
+          return s;
+        j -= full_size + partial;
+        ++s;
+      }
+      return s + j / full_size;
+    }
+  };
+
+  // Index of the left-balanced root within a sorted segment of m elements,
+  // which is also the size of its left subtree
+  KOKKOS_FUNCTION static int leftSubtreeSize(int m)
+  {
+    if (m <= 1)
+      return 0;
+    int p = 1;
+    while (2 * p <= m)
+      p *= 2;
+    return p / 2 - 1 + Kokkos::min(m - (p - 1), p / 2);
+  }
+
+  // Order-preserving map from float to unsigned
+  KOKKOS_FUNCTION static unsigned int orderedFloatBits(float x)
+  {
+    auto bits = Kokkos::bit_cast<unsigned int>(x);
+    return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+  }
+
+  template <typename Predicates, typename Callback>
+  struct SpatialQuery
+  {
+    KDTree _tree;
+    Predicates _predicates;
+    Callback _callback;
+
+    KOKKOS_FUNCTION void operator()(int query_index) const
+    {
+      auto const &predicate = _predicates(query_index);
+
+      // Bounding box of the query region, used for the half-space tests;
+      // the exact predicate is still evaluated at every visited node
+      bounding_volume_type query_box;
+      using Details::expand;
+      expand(query_box, getGeometry(predicate));
+
+      int const n = _tree._size;
+      Kokkos::pair<int, int> stack[MAX_STACK_DEPTH]; // (node, dimension)
+      int stack_size = 0;
+      stack[stack_size++] = {0, 0};
+      while (stack_size > 0)
+      {
+        int const node = stack[--stack_size].first;
+        int const dim = stack[stack_size].second;
+
+        auto const &value = _tree._nodes(node);
+        decltype(auto) point = _tree._indexable_getter(value);
+        if (predicate(point) &&
+            Details::invoke_callback_and_check_early_exit(_callback, predicate,
+                                                          value))
+          return;
+
+        auto const split = point[dim];
+        int const next_dim = (dim + 1 == DIM ? 0 : dim + 1);
+        int const left = 2 * node + 1;
+        if (left + 1 < n && query_box.maxCorner()[dim] >= split)
+          stack[stack_size++] = {left + 1, next_dim};
+        if (left < n && query_box.minCorner()[dim] <= split)
+          stack[stack_size++] = {left, next_dim};
+      }
+    }
+  };
+
+  template <typename Predicates, typename Callback>
+  struct NearestQuery
+  {
+    KDTree _tree;
+    Predicates _predicates;
+    Callback _callback;
+    Details::NearestBufferProvider<MemorySpace> _buffer_provider;
+
+    struct Entry
+    {
+      int node;
+      int dim;
+      coordinate_type bound; // lower bound on the distance to the subtree
+    };
+
+    KOKKOS_FUNCTION void operator()(int query_index) const
+    {
+      auto const &predicate = _predicates(query_index);
+      auto const k = getK(predicate);
+      if (k < 1)
+        return;
+
+      using PairIndexDistance = typename Details::NearestBufferProvider<
+          MemorySpace>::PairIndexDistance;
+      struct CompareDistance
+      {
+        KOKKOS_FUNCTION bool operator()(PairIndexDistance const &lhs,
+                                        PairIndexDistance const &rhs) const
+        {
+          return lhs.second < rhs.second;
+        }
+      };
+
+      auto const buffer = _buffer_provider(query_index);
+      Details::PriorityQueue<PairIndexDistance, CompareDistance,
+                             Details::UnmanagedStaticVector<PairIndexDistance>>
+          heap(Details::UnmanagedStaticVector<PairIndexDistance>(
+              buffer.data(), buffer.size()));
+
+      bounding_volume_type query_box;
+      using Details::expand;
+      expand(query_box, getGeometry(predicate));
+
+      auto radius =
+          Details::KokkosExt::ArithmeticTraits::infinity<float>::value;
+
+      int const n = _tree._size;
+      Entry stack[MAX_STACK_DEPTH];
+      int stack_size = 0;
+      stack[stack_size++] = {0, 0, 0};
+      while (stack_size > 0)
+      {
+        auto const entry = stack[--stack_size];
+        if ((int)heap.size() == k && entry.bound >= radius)
+          continue;
+
+        auto const &value = _tree._nodes(entry.node);
+        decltype(auto) point = _tree._indexable_getter(value);
+        auto const distance = predicate.distance(point);
+        if ((int)heap.size() < k)
+        {
+          heap.push(Kokkos::make_pair(entry.node, distance));
+          if ((int)heap.size() == k)
+            radius = heap.top().second;
+        }
+        else if (distance < radius)
+        {
+          heap.popPush(Kokkos::make_pair(entry.node, distance));
+          radius = heap.top().second;
+        }
+
+        auto const split = point[entry.dim];
+        int const next_dim = (entry.dim + 1 == DIM ? 0 : entry.dim + 1);
+        int const left = 2 * entry.node + 1;
+        if (left >= n)
+          continue;
+
+        // One-dimensional distances from the query region to each half-space
+        auto const to_left = Kokkos::max(
+            query_box.minCorner()[entry.dim] - split, (coordinate_type)0);
+        auto const to_right = Kokkos::max(
+            split - query_box.maxCorner()[entry.dim], (coordinate_type)0);
+
+        // Push the farther child first so that the nearer one is visited
+        // next and tightens the radius early
+        Entry const left_entry = {left, next_dim,
+                                  Kokkos::max(entry.bound, to_left)};
+        Entry const right_entry = {left + 1, next_dim,
+                                   Kokkos::max(entry.bound, to_right)};
+        if (to_left <= to_right)
+        {
+          if (left + 1 < n)
+            stack[stack_size++] = right_entry;
+          stack[stack_size++] = left_entry;
+        }
+        else
+        {
+          stack[stack_size++] = left_entry;
+          if (left + 1 < n)
+            stack[stack_size++] = right_entry;
+        }
+      }
+
+      // Drain the heap in order so results come back closest first, as with
+      // the other nearest engines
+      Details::sortHeap(heap.data(), heap.data() + heap.size(),
+                        heap.valueComp());
+      for (decltype(heap.size()) q = 0; q < heap.size(); ++q)
+        _callback(predicate, _tree._nodes((heap.data() + q)->first));
+    }
+  };
+
+  size_type _size{0};
+  bounding_volume_type _bounds;
+  Kokkos::View<Value *, MemorySpace> _nodes;
+  IndexableGetter _indexable_getter;
+};
+
+template <typename MemorySpace, typename Value, typename IndexableGetter>
+template <typename ExecutionSpace, typename UserValues>
+KDTree<MemorySpace, Value, IndexableGetter>::KDTree(
+    ExecutionSpace const &space, UserValues const &user_values,
+    IndexableGetter const &indexable_getter)
+    : _size(AccessTraits<UserValues, PrimitivesTag>::size(user_values))
+    , _nodes(Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                                "ArborX::KDTree::nodes"),
+             _size)
+    , _indexable_getter(indexable_getter)
+{
+  static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
+                                                       ExecutionSpace>::value);
+  Details::check_valid_access_traits<UserValues>(
+      PrimitivesTag{}, user_values, Details::DoNotCheckGetReturnType());
+
+  using Values = Details::AccessValues<UserValues, PrimitivesTag>;
+  Values values{user_values}; // NOLINT
+
+  static_assert(
+      Details::KokkosExt::is_accessible_from<typename Values::memory_space,
+                                             ExecutionSpace>::value,
+      "Values must be accessible from the execution space");
+
+  Kokkos::Profiling::ScopedRegion guard("ArborX::KDTree::KDTree");
+
+  if (empty())
+  {
+    return;
+  }
+
+  Details::TreeConstruction::calculateBoundingBoxOfTheScene(
+      space, Details::Indexables<Values, IndexableGetter>{values,
+                                                          _indexable_getter},
+      _bounds);
+
+  int const n = _size;
+
+  int num_levels = 1;
+  while ((1LL << num_levels) - 1 < n)
+    ++num_levels;
+  int const bottom_row_size = n - ((1 << (num_levels - 1)) - 1);
+
+  Kokkos::View<unsigned long long *, MemorySpace> keys(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::KDTree::keys"),
+      n);
+  // The implicit node every element is currently assigned to; all elements
+  // start at the root, and an element's assignment becomes final when it is
+  // the left-balanced median of its node's segment
+  Kokkos::View<int *, MemorySpace> node_ids(
+      Kokkos::view_alloc(space, "ArborX::KDTree::node_ids"), n);
+  Kokkos::View<int *, MemorySpace> element_ids(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::KDTree::element_ids"),
+      n);
+  Details::KokkosExt::iota(space, element_ids);
+
+  auto const &getter = _indexable_getter;
+  for (int level = 0; level < num_levels; ++level)
+  {
+    int const num_done = (1 << level) - 1;
+    int const split_dim = level % DIM;
+
+    // Elements with a final assignment keep their position through the node
+    // id alone (one element per done node); active elements group by node
+    // and order by the level's split coordinate within it
+    Kokkos::parallel_for(
+        "ArborX::KDTree::KDTree::compute_keys",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int i) {
+          auto key = ((unsigned long long)node_ids(i)) << 32;
+          if (node_ids(i) >= num_done)
+            key += orderedFloatBits(getter(values(element_ids(i)))[split_dim]);
+          keys(i) = key;
+        });
+
+    auto permute = Details::sortObjects(space, keys);
+    Details::applyPermutation(space, permute, node_ids);
+    Details::applyPermutation(space, permute, element_ids);
+
+    LevelLayout const layout{num_done, (1 << (num_levels - 1 - level)) - 1,
+                             1 << (num_levels - 1 - level), bottom_row_size};
+    Kokkos::parallel_for(
+        "ArborX::KDTree::KDTree::assign_nodes",
+        Kokkos::RangePolicy<ExecutionSpace>(space, num_done, n),
+        KOKKOS_LAMBDA(int i) {
+          int const s = layout.segment(i);
+          int const node = num_done + s;
+          int const pos = i - layout.begin(s);
+          int const left_size = leftSubtreeSize(layout.size(s));
+          if (pos == left_size)
+            node_ids(i) = node;
+          else
+            node_ids(i) = 2 * node + 1 + (pos > left_size);
+        });
+  }
+
+  auto nodes = _nodes;
+  Kokkos::parallel_for(
+      "ArborX::KDTree::KDTree::fill_nodes",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i) { nodes(node_ids(i)) = values(element_ids(i)); });
+}
+
+template <typename MemorySpace, typename Value, typename IndexableGetter>
+template <typename ExecutionSpace, typename UserPredicates, typename Callback>
+void KDTree<MemorySpace, Value, IndexableGetter>::query(
+    ExecutionSpace const &space, UserPredicates const &user_predicates,
+    Callback const &callback, Experimental::TraversalPolicy const &) const
+{
+  static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
+                                                       ExecutionSpace>::value);
+  Details::check_valid_access_traits(PredicatesTag{}, user_predicates);
+  Details::check_valid_callback<value_type>(callback, user_predicates);
+
+  using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+  static_assert(
+      Details::KokkosExt::is_accessible_from<typename Predicates::memory_space,
+                                             ExecutionSpace>::value,
+      "Predicates must be accessible from the execution space");
+  Predicates predicates{user_predicates}; // NOLINT
+
+  using Tag = typename Predicates::value_type::Tag;
+  static_assert(std::is_same_v<Tag, Details::SpatialPredicateTag> ||
+                    std::is_same_v<Tag, Details::NearestPredicateTag>,
+                "KDTree only supports spatial and nearest predicates");
+
+  if (empty())
+  {
+    return;
+  }
+
+  if constexpr (std::is_same_v<Tag, Details::SpatialPredicateTag>)
+  {
+    Kokkos::Profiling::ScopedRegion guard("ArborX::KDTree::query::spatial");
+
+    Kokkos::parallel_for(
+        "ArborX::KDTree::query::spatial",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, predicates.size()),
+        SpatialQuery<Predicates, Callback>{*this, predicates, callback});
+  }
+  else
+  {
+    Kokkos::Profiling::ScopedRegion guard("ArborX::KDTree::query::nearest");
+
+    Details::NearestBufferProvider<MemorySpace> buffer_provider(space,
+                                                                predicates);
+
+    Kokkos::parallel_for(
+        "ArborX::KDTree::query::nearest",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, predicates.size()),
+        NearestQuery<Predicates, Callback>{*this, predicates, callback,
+                                           buffer_provider});
+  }
+}
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -20,16 +20,25 @@
 #include <ArborX_DetailsBatchedQueries.hpp>
 #include <ArborX_DetailsCrsGraphWrapperImpl.hpp>
 #include <ArborX_DetailsKokkosExtAccessibilityTraits.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
 #include <ArborX_DetailsLegacy.hpp>
 #include <ArborX_DetailsNode.hpp>
 #include <ArborX_DetailsPermutedData.hpp>
 #include <ArborX_DetailsSortUtils.hpp>
+#include <ArborX_DetailsSubtreeRebuild.hpp>
 #include <ArborX_DetailsTreeConstruction.hpp>
+#include <ArborX_DetailsTreeConstructionFused.hpp>
+#include <ArborX_DetailsTreeConstructionPLOC.hpp>
 #include <ArborX_DetailsTreeTraversal.hpp>
+#include <ArborX_DetailsTreeletRestructuring.hpp>
+#include <ArborX_DetailsTreeTraversalPacket.hpp>
+#include <ArborX_DetailsTreeTraversalWorkQueue.hpp>
 #include <ArborX_HyperBox.hpp>
 #include <ArborX_IndexableGetter.hpp>
 #include <ArborX_PairValueIndex.hpp>
 #include <ArborX_PredicateHelpers.hpp>
+#include <ArborX_PredicateSortingAutoTuner.hpp>
 #include <ArborX_SpaceFillingCurves.hpp>
 #include <ArborX_TraversalPolicy.hpp>
 
@@ -48,16 +57,19 @@ struct PerThread
 namespace Details
 {
 struct HappyTreeFriends;
+struct TreeSerialization;
 } // namespace Details
 
 template <typename MemorySpace,
           typename Value = Details::LegacyDefaultTemplateValue,
           typename IndexableGetter = Details::DefaultIndexableGetter,
           typename BoundingVolume = ExperimentalHyperGeometry::Box<
-              GeometryTraits::dimension_v<
-                  std::decay_t<std::invoke_result_t<IndexableGetter, Value>>>,
+              GeometryTraits::dimension_v<std::decay_t<std::invoke_result_t<
+                  IndexableGetter, Details::implicit_index_storage_t<Value>>>>,
               typename GeometryTraits::coordinate_type_t<
-                  std::decay_t<std::invoke_result_t<IndexableGetter, Value>>>>>
+                  std::decay_t<std::invoke_result_t<
+                      IndexableGetter,
+                      Details::implicit_index_storage_t<Value>>>>>>
 class BoundingVolumeHierarchy
 {
 public:
@@ -65,7 +77,13 @@ public:
   static_assert(Kokkos::is_memory_space<MemorySpace>::value);
   using size_type = typename MemorySpace::size_type;
   using bounding_volume_type = BoundingVolume;
-  using value_type = Value;
+  // With an Experimental::ImplicitIndex value template argument the tree is
+  // built over the plain values, the leaves store no index, and queries
+  // produce PairValueIndex values whose index is reconstructed from the
+  // permutation retained at construction
+  static constexpr bool has_implicit_index =
+      Details::is_implicit_index_v<Value>;
+  using value_type = Details::implicit_index_value_t<Value>;
 
   BoundingVolumeHierarchy() = default; // build an empty tree
 
@@ -76,6 +94,29 @@ public:
       IndexableGetter const &indexable_getter = IndexableGetter(),
       SpaceFillingCurve const &curve = SpaceFillingCurve());
 
+  // Build with the agglomerative PLOC builder instead of the LBVH one:
+  // modestly slower construction for tighter internal boxes and faster
+  // traversals, worthwhile for static geometry queried many times (see
+  // Experimental::PLOC)
+  template <typename ExecutionSpace, typename Values,
+            typename SpaceFillingCurve = Experimental::Morton64>
+  BoundingVolumeHierarchy(
+      ExecutionSpace const &space, Values const &values,
+      Experimental::PLOC const &ploc,
+      IndexableGetter const &indexable_getter = IndexableGetter(),
+      SpaceFillingCurve const &curve = SpaceFillingCurve());
+
+  // Rebuild the tree over a new set of values, reusing the node storage when
+  // the number of values is unchanged. Per-frame workloads that reconstruct
+  // over a cloud of fixed cardinality skip the allocation and first-touch of
+  // the node arrays this way; when the cardinality changes the storage is
+  // reallocated to the exact new size. Tombstones accumulated by remove_if()
+  // are dropped.
+  template <typename ExecutionSpace, typename Values,
+            typename SpaceFillingCurve = Experimental::Morton64>
+  void rebuild(ExecutionSpace const &space, Values const &values,
+               SpaceFillingCurve const &curve = SpaceFillingCurve());
+
   KOKKOS_FUNCTION
   size_type size() const noexcept { return _size; }
 
@@ -85,6 +126,81 @@ public:
   KOKKOS_FUNCTION
   bounding_volume_type bounds() const noexcept { return _bounds; }
 
+  // Refit the bounding volumes bottom-up without rebuilding the hierarchy.
+  // Only meaningful when the indexable getter references storage that the
+  // user updated in place (with the default indexable getter the indexables
+  // are stored by value inside the tree and cannot change). The tree topology
+  // is preserved, so its quality degrades as the values drift from the
+  // positions the tree was built with.
+  template <typename ExecutionSpace>
+  void update(ExecutionSpace const &space);
+
+  // Rebuild in place the smallest subtree covering every leaf whose
+  // indexable currently intersects the region, re-sorting those leaves
+  // along the space-filling curve and regenerating that slice of the
+  // hierarchy. Restores local tree quality after a batch of localized
+  // modifications at a cost proportional to the subtree plus one refit
+  // sweep, filling the gap between update() (cheap, quality degrades where
+  // values moved) and a rebuild (expensive, full quality). The call ends
+  // with a refit of the whole tree, so the bounding volumes are valid
+  // afterwards even for modified leaves the region missed; the region only
+  // directs where the topology is rebuilt.
+  template <typename ExecutionSpace, typename Region,
+            typename SpaceFillingCurve = Experimental::Morton64>
+  void partialRebuild(ExecutionSpace const &space, Region const &region,
+                      SpaceFillingCurve const &curve = SpaceFillingCurve());
+
+  // Restructure small treelets in place to improve the quality of an
+  // LBVH-built tree (TRBVH-style). The extra cost is bounded and paid once,
+  // while the tighter topology keeps benefiting every subsequent traversal,
+  // so this pays off for long-lived trees. An in-place alternative to
+  // rebuilding with Experimental::PLOC when the tree already exists.
+  template <typename ExecutionSpace>
+  void optimize(ExecutionSpace const &space);
+
+  // Same restructuring driven by per-node visit counts recorded with
+  // Experimental::recordNodeVisits() over a representative query batch: the
+  // treelet optimizer minimizes the visit-weighted boundary measure instead
+  // of plain SAH, tightening the hot regions of the tree at the expense of
+  // the ones the recorded queries never reached. Worthwhile when the query
+  // distribution is spatially skewed and stable; for uniform queries it
+  // reduces to optimize(space). The counts view is left untouched and stays
+  // meaningful as an epoch to keep accumulating into.
+  template <typename ExecutionSpace, typename Visits>
+  void optimize(ExecutionSpace const &space, Visits const &visits);
+
+  // Graft another hierarchy over the same value type onto this one by
+  // joining the two trees under a fresh root. Inserting a batch this way
+  // costs one copy of the node arrays instead of a space-filling curve sort
+  // and hierarchy generation over the combined values, which is what a
+  // streaming ingest of small batches into a large tree wants. The grafted
+  // subtree sits beside the existing one regardless of spatial overlap, so
+  // the quality drifts as batches accumulate; monitor with
+  // Experimental::computeTreeQuality() and rebuild from scratch (or run
+  // optimize()) when the cost degrades.
+  template <typename ExecutionSpace>
+  void graft(ExecutionSpace const &space, BoundingVolumeHierarchy const &other);
+
+  // Mark every value that satisfies the predicate (a device-callable
+  // bool(Value)) as removed and return how many this call removed. Removed
+  // values are skipped by subsequent queries and the refitted volumes let
+  // traversals prune emptied subtrees, but the values keep their leaf slots
+  // and still count towards size(): the cost is one marking sweep and one
+  // refit, not a rebuild.
+  template <typename ExecutionSpace, typename Predicate>
+  size_type remove_if(ExecutionSpace const &space, Predicate const &predicate);
+
+  // Rebuild the tree over the live values only, dropping the tombstones
+  // accumulated by remove_if(). The live values are extracted in the
+  // space-filling curve order of the previous build, so the rebuild detects
+  // the sorted input and skips the sort. Schedule it when numRemoved()
+  // grows to a noticeable fraction of size().
+  template <typename ExecutionSpace>
+  void compact(ExecutionSpace const &space);
+
+  KOKKOS_FUNCTION
+  size_type numRemoved() const noexcept { return _num_tombstones; }
+
   template <typename ExecutionSpace, typename Predicates, typename Callback>
   void query(ExecutionSpace const &space, Predicates const &predicates,
              Callback const &callback,
@@ -158,10 +274,12 @@ public:
 
 private:
   friend struct Details::HappyTreeFriends;
+  friend struct Details::TreeSerialization;
 
+  using leaf_value_type = Details::implicit_index_storage_t<Value>;
   using indexable_type =
-      std::decay_t<std::invoke_result_t<IndexableGetter, Value>>;
-  using leaf_node_type = Details::LeafNode<value_type>;
+      std::decay_t<std::invoke_result_t<IndexableGetter, leaf_value_type>>;
+  using leaf_node_type = Details::LeafNode<leaf_value_type>;
   using internal_node_type = Details::InternalNode<bounding_volume_type>;
 
   size_type _size{0};
@@ -169,6 +287,20 @@ private:
   Kokkos::View<leaf_node_type *, MemorySpace> _leaf_nodes;
   Kokkos::View<internal_node_type *, MemorySpace> _internal_nodes;
   IndexableGetter _indexable_getter;
+  // Allocated lazily by the first remove_if(); an empty view means that all
+  // leaves are live
+  Kokkos::View<char *, MemorySpace> _tombstones;
+  size_type _num_tombstones{0};
+  // Leaf position to original index; only allocated in the implicit index
+  // mode and only touched when a leaf is hit
+  Kokkos::View<unsigned int *, MemorySpace> _leaf_permutation;
+
+  // Construction pipeline over already-sized node storage, shared by the
+  // LBVH constructor and rebuild()
+  template <typename ExecutionSpace, typename UserValues,
+            typename SpaceFillingCurve>
+  void buildImpl(ExecutionSpace const &space, UserValues const &user_values,
+                 SpaceFillingCurve const &curve);
 };
 
 // The partial template specialization parameters *must* match the default ones
@@ -269,10 +401,12 @@ template <typename MemorySpace,
           typename Value = Details::LegacyDefaultTemplateValue,
           typename IndexableGetter = Details::DefaultIndexableGetter,
           typename BoundingVolume = ExperimentalHyperGeometry::Box<
-              GeometryTraits::dimension_v<
-                  std::decay_t<std::invoke_result_t<IndexableGetter, Value>>>,
+              GeometryTraits::dimension_v<std::decay_t<std::invoke_result_t<
+                  IndexableGetter, Details::implicit_index_storage_t<Value>>>>,
               typename GeometryTraits::coordinate_type_t<
-                  std::decay_t<std::invoke_result_t<IndexableGetter, Value>>>>>
+                  std::decay_t<std::invoke_result_t<
+                      IndexableGetter,
+                      Details::implicit_index_storage_t<Value>>>>>>
 using BVH = BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter,
                                     BoundingVolume>;
 
@@ -293,6 +427,76 @@ BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter, BoundingVolume>::
                                          "ArborX::BVH::internal_nodes"),
                       _size > 1 ? _size - 1 : 0)
     , _indexable_getter(indexable_getter)
+{
+  Kokkos::Profiling::ScopedRegion guard("ArborX::BVH::BVH");
+
+  if (!empty())
+  {
+    // Commit the node pages before any construction kernel writes them.
+    // The hierarchy generation fills internal nodes bottom-up from whichever
+    // thread finishes a subtree first, which on a multi-socket host would
+    // scatter page ownership across NUMA domains; touching the pages in index
+    // order first places them on the socket whose threads traverse the
+    // matching subtree range later.
+    Details::KokkosExt::firstTouch(space, _leaf_nodes);
+    Details::KokkosExt::firstTouch(space, _internal_nodes);
+  }
+
+  buildImpl(space, user_values, curve);
+}
+
+template <typename MemorySpace, typename Value, typename IndexableGetter,
+          typename BoundingVolume>
+template <typename ExecutionSpace, typename UserValues,
+          typename SpaceFillingCurve>
+void BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter,
+                             BoundingVolume>::rebuild(ExecutionSpace const
+                                                          &space,
+                                                      UserValues const
+                                                          &user_values,
+                                                      SpaceFillingCurve const
+                                                          &curve)
+{
+  static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
+                                                       ExecutionSpace>::value);
+
+  Kokkos::Profiling::ScopedRegion guard("ArborX::BVH::rebuild");
+
+  auto const n =
+      (size_type)AccessTraits<UserValues, PrimitivesTag>::size(user_values);
+  if (n != _size)
+  {
+    // The construction kernels and the tree mutators derive the leaf count
+    // from the node view extents, so the storage is kept exactly sized and
+    // only reused when the cardinality is unchanged
+    _size = n;
+    Details::KokkosExt::reallocWithoutInitializing(space, _leaf_nodes, _size);
+    Details::KokkosExt::reallocWithoutInitializing(
+        space, _internal_nodes, _size > 1 ? _size - 1 : 0);
+    if (!empty())
+    {
+      Details::KokkosExt::firstTouch(space, _leaf_nodes);
+      Details::KokkosExt::firstTouch(space, _internal_nodes);
+    }
+  }
+  _bounds = BoundingVolume{};
+  _tombstones = decltype(_tombstones){};
+  _num_tombstones = 0;
+
+  buildImpl(space, user_values, curve);
+}
+
+template <typename MemorySpace, typename Value, typename IndexableGetter,
+          typename BoundingVolume>
+template <typename ExecutionSpace, typename UserValues,
+          typename SpaceFillingCurve>
+void BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter,
+                             BoundingVolume>::buildImpl(ExecutionSpace const
+                                                            &space,
+                                                        UserValues const
+                                                            &user_values,
+                                                        SpaceFillingCurve const
+                                                            &curve)
 {
   static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
                                                        ExecutionSpace>::value);
@@ -312,8 +516,6 @@ BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter, BoundingVolume>::
 
   Details::check_valid_space_filling_curve<DIM>(curve);
 
-  Kokkos::Profiling::ScopedRegion guard("ArborX::BVH::BVH");
-
   if (empty())
   {
     return;
@@ -323,27 +525,57 @@ BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter, BoundingVolume>::
   {
     Details::TreeConstruction::initializeSingleLeafTree(
         space, values, _indexable_getter, _leaf_nodes, _bounds);
+    if constexpr (has_implicit_index)
+      _leaf_permutation = Kokkos::View<unsigned int *, MemorySpace>(
+          Kokkos::view_alloc(space, "ArborX::BVH::leaf_permutation"), 1);
     return;
   }
 
+  using SceneBox = ExperimentalHyperGeometry::Box<
+      DIM, typename GeometryTraits::coordinate_type_t<BoundingVolume>>;
+  using LinearOrderingValueType =
+      std::invoke_result_t<SpaceFillingCurve, SceneBox, indexable_type>;
+
+  if constexpr (!Details::KokkosExt::is_accessible_from<
+                    Kokkos::HostSpace, ExecutionSpace>::value &&
+                std::is_unsigned_v<LinearOrderingValueType>)
+  {
+    // On device backends, building a small tree costs more in kernel
+    // launches and synchronization than in compute, so it is done by a
+    // single fused kernel instead of the phase-per-kernel pipeline below
+    if (size() <= Details::TreeConstruction::max_fused_construction_size)
+    {
+      if constexpr (has_implicit_index)
+        _leaf_permutation = Kokkos::View<unsigned int *, MemorySpace>(
+            Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                               "ArborX::BVH::leaf_permutation"),
+            size());
+      Details::TreeConstruction::buildSmallTreeFused(
+          space, values, _indexable_getter, curve, _leaf_permutation,
+          _leaf_nodes, _internal_nodes, _bounds);
+      return;
+    }
+  }
+
   Details::Indexables<Values, IndexableGetter> indexables{values,
-                                                          indexable_getter};
+                                                          _indexable_getter};
 
   Kokkos::Profiling::pushRegion(
       "ArborX::BVH::BVH::calculate_scene_bounding_box");
 
-  // determine the bounding box of the scene
-  ExperimentalHyperGeometry::Box<
-      DIM, typename GeometryTraits::coordinate_type_t<BoundingVolume>>
-      bbox{};
+  // Determine the bounding box of the scene. The result stays in device
+  // memory: reducing into a host scalar would block this thread until the
+  // kernel completes, serializing constructions that are enqueued on one
+  // instance while another one serves queries.
+  Kokkos::View<SceneBox, MemorySpace> bbox(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::BVH::BVH::scene_bounding_box"));
   Details::TreeConstruction::calculateBoundingBoxOfTheScene(space, indexables,
                                                             bbox);
   Kokkos::Profiling::popRegion();
   Kokkos::Profiling::pushRegion("ArborX::BVH::BVH::compute_linear_ordering");
 
   // Map indexables from multidimensional domain to one-dimensional interval
-  using LinearOrderingValueType =
-      std::invoke_result_t<SpaceFillingCurve, decltype(bbox), indexable_type>;
   Kokkos::View<LinearOrderingValueType *, MemorySpace> linear_ordering_indices(
       Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
                          "ArborX::BVH::BVH::linear_ordering"),
@@ -354,9 +586,13 @@ BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter, BoundingVolume>::
   Kokkos::Profiling::popRegion();
   Kokkos::Profiling::pushRegion("ArborX::BVH::BVH::sort_linearized_order");
 
-  // Compute the ordering of the indexables along the space-filling curve
+  // Compute the ordering of the indexables along the space-filling curve.
+  // Rebuilds on data that is still ordered from a previous build detect the
+  // (near-)sortedness and skip or repair instead of paying the full sort.
   auto permutation_indices =
-      Details::sortObjects(space, linear_ordering_indices);
+      Details::sortObjectsAdaptive(space, linear_ordering_indices);
+  if constexpr (has_implicit_index)
+    _leaf_permutation = permutation_indices;
 
   Kokkos::Profiling::popRegion();
   Kokkos::Profiling::pushRegion("ArborX::BVH::BVH::generate_hierarchy");
@@ -369,6 +605,479 @@ BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter, BoundingVolume>::
   Kokkos::Profiling::popRegion();
 }
 
+template <typename MemorySpace, typename Value, typename IndexableGetter,
+          typename BoundingVolume>
+template <typename ExecutionSpace, typename UserValues,
+          typename SpaceFillingCurve>
+BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter, BoundingVolume>::
+    BoundingVolumeHierarchy(ExecutionSpace const &space,
+                            UserValues const &user_values,
+                            Experimental::PLOC const &ploc,
+                            IndexableGetter const &indexable_getter,
+                            SpaceFillingCurve const &curve)
+    : _size(AccessTraits<UserValues, PrimitivesTag>::size(user_values))
+    , _leaf_nodes(Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                                     "ArborX::BVH::leaf_nodes"),
+                  _size)
+    , _internal_nodes(Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                                         "ArborX::BVH::internal_nodes"),
+                      _size > 1 ? _size - 1 : 0)
+    , _indexable_getter(indexable_getter)
+{
+  static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
+                                                       ExecutionSpace>::value);
+  Details::check_valid_access_traits<UserValues>(
+      PrimitivesTag{}, user_values, Details::DoNotCheckGetReturnType());
+
+  using Values = Details::AccessValues<UserValues, PrimitivesTag>;
+  Values values{user_values}; // NOLINT
+
+  static_assert(
+      Details::KokkosExt::is_accessible_from<typename Values::memory_space,
+                                             ExecutionSpace>::value,
+      "Values must be accessible from the execution space");
+
+  constexpr int DIM = GeometryTraits::dimension_v<BoundingVolume>;
+
+  Details::check_valid_space_filling_curve<DIM>(curve);
+
+  Kokkos::Profiling::ScopedRegion guard("ArborX::BVH::BVH(PLOC)");
+
+  if (empty())
+  {
+    return;
+  }
+
+  if (size() == 1)
+  {
+    Details::TreeConstruction::initializeSingleLeafTree(
+        space, values, _indexable_getter, _leaf_nodes, _bounds);
+    if constexpr (has_implicit_index)
+      _leaf_permutation = Kokkos::View<unsigned int *, MemorySpace>(
+          Kokkos::view_alloc(space, "ArborX::BVH::leaf_permutation"), 1);
+    return;
+  }
+
+  Details::Indexables<Values, IndexableGetter> indexables{values,
+                                                          indexable_getter};
+
+  // The space-filling curve only seeds the merge order here; the topology
+  // comes out of the clustering, not out of the code splits
+  using SceneBox = ExperimentalHyperGeometry::Box<
+      DIM, typename GeometryTraits::coordinate_type_t<BoundingVolume>>;
+  Kokkos::View<SceneBox, MemorySpace> bbox(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::BVH::BVH::scene_bounding_box"));
+  Details::TreeConstruction::calculateBoundingBoxOfTheScene(space, indexables,
+                                                            bbox);
+
+  using LinearOrderingValueType =
+      std::invoke_result_t<SpaceFillingCurve, SceneBox, indexable_type>;
+  Kokkos::View<LinearOrderingValueType *, MemorySpace> linear_ordering_indices(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::BVH::BVH::linear_ordering"),
+      size());
+  Details::TreeConstruction::projectOntoSpaceFillingCurve(
+      space, indexables, curve, bbox, linear_ordering_indices);
+
+  auto permutation_indices =
+      Details::sortObjectsAdaptive(space, linear_ordering_indices);
+  if constexpr (has_implicit_index)
+    _leaf_permutation = permutation_indices;
+
+  Kokkos::Profiling::pushRegion("ArborX::BVH::BVH::generate_hierarchy_ploc");
+
+  Details::TreeConstruction::generateHierarchyPLOC(
+      space, values, _indexable_getter, permutation_indices, _leaf_nodes,
+      _internal_nodes, _bounds, ploc.search_radius);
+
+  Kokkos::Profiling::popRegion();
+}
+
+template <typename MemorySpace, typename Value, typename IndexableGetter,
+          typename BoundingVolume>
+template <typename ExecutionSpace>
+void BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter,
+                             BoundingVolume>::update(ExecutionSpace const
+                                                         &space)
+{
+  static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
+                                                       ExecutionSpace>::value);
+
+  Kokkos::Profiling::ScopedRegion guard("ArborX::BVH::update");
+
+  if (empty())
+  {
+    return;
+  }
+
+  if (size() == 1)
+  {
+    auto leaf_nodes = _leaf_nodes;
+    auto indexable_getter = _indexable_getter;
+    Kokkos::View<BoundingVolume, MemorySpace> bounding_volume(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::BVH::update::bounding_volume"));
+    Kokkos::parallel_for(
+        "ArborX::BVH::update::refit_single_leaf_tree",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, 1), KOKKOS_LAMBDA(int) {
+          BoundingVolume bv{};
+          using Details::expand;
+          expand(bv, indexable_getter(leaf_nodes(0).value));
+          bounding_volume() = bv;
+        });
+    Kokkos::deep_copy(
+        space,
+        Kokkos::View<BoundingVolume, Kokkos::HostSpace,
+                     Kokkos::MemoryUnmanaged>(&_bounds),
+        bounding_volume);
+    return;
+  }
+
+  Details::TreeConstruction::refitHierarchy(space, _indexable_getter,
+                                            _leaf_nodes, _internal_nodes,
+                                            _bounds);
+}
+
+template <typename MemorySpace, typename Value, typename IndexableGetter,
+          typename BoundingVolume>
+template <typename ExecutionSpace, typename Region, typename SpaceFillingCurve>
+void BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter,
+                             BoundingVolume>::partialRebuild(ExecutionSpace
+                                                                 const &space,
+                                                             Region const
+                                                                 &region,
+                                                             SpaceFillingCurve
+                                                                 const &curve)
+{
+  static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
+                                                       ExecutionSpace>::value);
+  // Re-sorting the leaves would invalidate the retained permutation
+  static_assert(!has_implicit_index,
+                "partialRebuild() is not available with implicit indices");
+
+  Kokkos::Profiling::ScopedRegion guard("ArborX::BVH::partialRebuild");
+
+  // With two leaves or fewer there is only one topology; refitting the
+  // volumes is the whole job
+  if (size() <= 2)
+  {
+    update(space);
+    return;
+  }
+
+  Details::TreeConstruction::rebuildSubtree(space, _indexable_getter, curve,
+                                            region, _leaf_nodes,
+                                            _internal_nodes, _tombstones);
+
+  // The regenerated subtree has fresh volumes, but the volumes on the path
+  // from the subtree root up are stale, as may be those of any modified
+  // leaves the region missed; one refit sweep settles all of them
+  Details::TreeConstruction::refitHierarchy(space, _indexable_getter,
+                                            _leaf_nodes, _internal_nodes,
+                                            _bounds, _tombstones);
+}
+
+template <typename MemorySpace, typename Value, typename IndexableGetter,
+          typename BoundingVolume>
+template <typename ExecutionSpace>
+void BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter,
+                             BoundingVolume>::optimize(ExecutionSpace const
+                                                           &space)
+{
+  static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
+                                                       ExecutionSpace>::value);
+
+  Kokkos::Profiling::ScopedRegion guard("ArborX::BVH::optimize");
+
+  // With two leaves or fewer there is only one topology
+  if (size() <= 2)
+  {
+    return;
+  }
+
+  Details::TreeConstruction::restructureTreelets(
+      space, _indexable_getter, _leaf_nodes, _internal_nodes, _bounds);
+}
+
+template <typename MemorySpace, typename Value, typename IndexableGetter,
+          typename BoundingVolume>
+template <typename ExecutionSpace, typename Visits>
+void BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter,
+                             BoundingVolume>::optimize(ExecutionSpace const
+                                                           &space,
+                                                       Visits const &visits)
+{
+  static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
+                                                       ExecutionSpace>::value);
+  static_assert(Kokkos::is_view_v<Visits>);
+
+  Kokkos::Profiling::ScopedRegion guard("ArborX::BVH::optimize");
+
+  // With two leaves or fewer there is only one topology
+  if (size() <= 2)
+  {
+    return;
+  }
+
+  // The restructuring propagates estimated frequencies into the internal
+  // node slots it rewrites, so it works on a scratch copy of the counts
+  auto scratch = Details::KokkosExt::clone(space, visits);
+  Details::TreeConstruction::restructureTreelets(space, _indexable_getter,
+                                                 _leaf_nodes, _internal_nodes,
+                                                 _bounds, scratch);
+}
+
+template <typename MemorySpace, typename Value, typename IndexableGetter,
+          typename BoundingVolume>
+template <typename ExecutionSpace>
+void BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter,
+                             BoundingVolume>::graft(ExecutionSpace const &space,
+                                                    BoundingVolumeHierarchy
+                                                        const &other)
+{
+  static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
+                                                       ExecutionSpace>::value);
+  // The two trees' indices refer to different value sets
+  static_assert(!has_implicit_index,
+                "graft() is not available with implicit indices");
+
+  Kokkos::Profiling::ScopedRegion guard("ArborX::BVH::graft");
+
+  if (other.empty())
+  {
+    return;
+  }
+
+  if (empty())
+  {
+    // Usual view semantics: the node storage is shared with the other tree
+    *this = other;
+    return;
+  }
+
+  int const n1 = size();
+  int const n2 = other.size();
+  int const n = n1 + n2;
+
+  // Node ids of the merged tree: the leaves of this tree keep their index,
+  // the leaves of the grafted tree follow at [n1, n), the new root claims
+  // internal slot zero, this tree's internal nodes shift to slots [1, n1),
+  // and the grafted tree's to [n1, n - 1). A tree of size one has no
+  // internal nodes and its root is its only leaf.
+  int const root_1 = (n1 > 1 ? n + 1 : 0);
+  int const root_2 = (n2 > 1 ? n + n1 : n1);
+
+  Kokkos::View<leaf_node_type *, MemorySpace> leaf_nodes(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::BVH::leaf_nodes"),
+      n);
+  Kokkos::View<internal_node_type *, MemorySpace> internal_nodes(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::BVH::internal_nodes"),
+      n - 1);
+
+  auto const first_leaf_nodes = _leaf_nodes;
+  auto const first_internal_nodes = _internal_nodes;
+  auto const second_leaf_nodes = other._leaf_nodes;
+  auto const second_internal_nodes = other._internal_nodes;
+
+  Kokkos::parallel_for(
+      "ArborX::BVH::graft::remap_first_tree",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n1), KOKKOS_LAMBDA(int i) {
+        // Ropes that ran off this tree's right edge now continue into the
+        // grafted subtree, which follows it in traversal order
+        auto leaf = first_leaf_nodes(i);
+        leaf.rope = (leaf.rope == Details::ROPE_SENTINEL)
+                        ? root_2
+                        : (leaf.rope < n1 ? leaf.rope : leaf.rope + n2 + 1);
+        leaf_nodes(i) = leaf;
+        if (i < n1 - 1)
+        {
+          auto node = first_internal_nodes(i);
+          node.left_child = (node.left_child < n1 ? node.left_child
+                                                  : node.left_child + n2 + 1);
+          node.rope = (node.rope == Details::ROPE_SENTINEL)
+                          ? root_2
+                          : (node.rope < n1 ? node.rope : node.rope + n2 + 1);
+          internal_nodes(1 + i) = node;
+        }
+      });
+
+  Kokkos::parallel_for(
+      "ArborX::BVH::graft::remap_second_tree",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n2), KOKKOS_LAMBDA(int i) {
+        auto leaf = second_leaf_nodes(i);
+        if (leaf.rope != Details::ROPE_SENTINEL)
+          leaf.rope = (leaf.rope < n2 ? leaf.rope + n1 : leaf.rope + 2 * n1);
+        leaf_nodes(n1 + i) = leaf;
+        if (i < n2 - 1)
+        {
+          auto node = second_internal_nodes(i);
+          node.left_child = (node.left_child < n2 ? node.left_child + n1
+                                                  : node.left_child + 2 * n1);
+          if (node.rope != Details::ROPE_SENTINEL)
+            node.rope = (node.rope < n2 ? node.rope + n1 : node.rope + 2 * n1);
+          internal_nodes(n1 + i) = node;
+        }
+      });
+
+  BoundingVolume bounds = _bounds;
+  using Details::expand;
+  expand(bounds, other._bounds);
+
+  internal_node_type root_node;
+  root_node.left_child = root_1;
+  root_node.rope = Details::ROPE_SENTINEL;
+  root_node.bounding_volume = bounds;
+  Kokkos::parallel_for(
+      "ArborX::BVH::graft::write_root",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, 1),
+      KOKKOS_LAMBDA(int) { internal_nodes(0) = root_node; });
+
+  if (_tombstones.extent(0) != 0 || other._tombstones.extent(0) != 0)
+  {
+    // Tombstones follow their leaves into the merged layout
+    Kokkos::View<char *, MemorySpace> tombstones(
+        Kokkos::view_alloc(space, "ArborX::BVH::tombstones"), n);
+    if (_tombstones.extent(0) != 0)
+      Kokkos::deep_copy(
+          space, Kokkos::subview(tombstones, Kokkos::make_pair(0, n1)),
+          _tombstones);
+    if (other._tombstones.extent(0) != 0)
+      Kokkos::deep_copy(
+          space, Kokkos::subview(tombstones, Kokkos::make_pair(n1, n)),
+          other._tombstones);
+    _tombstones = tombstones;
+    _num_tombstones += other._num_tombstones;
+  }
+
+  _size = n;
+  _bounds = bounds;
+  _leaf_nodes = leaf_nodes;
+  _internal_nodes = internal_nodes;
+}
+
+template <typename MemorySpace, typename Value, typename IndexableGetter,
+          typename BoundingVolume>
+template <typename ExecutionSpace, typename Predicate>
+typename BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter,
+                                 BoundingVolume>::size_type
+BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter,
+                        BoundingVolume>::remove_if(ExecutionSpace const &space,
+                                                   Predicate const &predicate)
+{
+  static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
+                                                       ExecutionSpace>::value);
+
+  Kokkos::Profiling::ScopedRegion guard("ArborX::BVH::remove_if");
+
+  if (empty())
+  {
+    return 0;
+  }
+
+  int const n = size();
+
+  if (_tombstones.extent(0) == 0)
+    _tombstones = Kokkos::View<char *, MemorySpace>(
+        Kokkos::view_alloc(space, "ArborX::BVH::tombstones"), n);
+
+  auto const leaf_nodes = _leaf_nodes;
+  auto const tombstones = _tombstones;
+  int num_removed;
+  Kokkos::parallel_reduce(
+      "ArborX::BVH::remove_if::mark",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i, int &update) {
+        if (tombstones(i) == 0 && predicate(leaf_nodes(i).value))
+        {
+          tombstones(i) = 1;
+          ++update;
+        }
+      },
+      num_removed);
+
+  if (num_removed == 0)
+  {
+    return 0;
+  }
+  _num_tombstones += num_removed;
+
+  if (n == 1)
+  {
+    // The only leaf is gone
+    _bounds = BoundingVolume{};
+    return num_removed;
+  }
+
+  // Shrink the internal volumes over the live leaves so that traversals
+  // prune emptied subtrees
+  Details::TreeConstruction::refitHierarchy(space, _indexable_getter,
+                                            _leaf_nodes, _internal_nodes,
+                                            _bounds, _tombstones);
+
+  return num_removed;
+}
+
+template <typename MemorySpace, typename Value, typename IndexableGetter,
+          typename BoundingVolume>
+template <typename ExecutionSpace>
+void BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter,
+                             BoundingVolume>::compact(ExecutionSpace const
+                                                          &space)
+{
+  static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
+                                                       ExecutionSpace>::value);
+  // Dropping leaf slots would invalidate the retained permutation
+  static_assert(!has_implicit_index,
+                "compact() is not available with implicit indices");
+
+  Kokkos::Profiling::ScopedRegion guard("ArborX::BVH::compact");
+
+  if (_num_tombstones == 0)
+  {
+    return;
+  }
+
+  if (_num_tombstones == _size)
+  {
+    *this = BoundingVolumeHierarchy();
+    return;
+  }
+
+  int const n = size();
+  int const num_live = n - (int)_num_tombstones;
+
+  // A scan over the liveness assigns every surviving value its slot while
+  // preserving the space-filling curve order of the previous build, so the
+  // construction below detects the sorted input and skips the sort
+  Kokkos::View<int *, MemorySpace> offsets(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::BVH::compact::offsets"),
+      n);
+  auto const tombstones = _tombstones;
+  Kokkos::parallel_for(
+      "ArborX::BVH::compact::liveness",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i) { offsets(i) = (tombstones(i) == 0); });
+  Details::KokkosExt::exclusive_scan(space, offsets, offsets, 0);
+
+  Kokkos::View<Value *, MemorySpace> live_values(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::BVH::compact::live_values"),
+      num_live);
+  auto const leaf_nodes = _leaf_nodes;
+  Kokkos::parallel_for(
+      "ArborX::BVH::compact::gather",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        if (tombstones(i) == 0)
+          live_values(offsets(i)) = leaf_nodes(i).value;
+      });
+
+  *this = BoundingVolumeHierarchy(space, live_values, _indexable_getter);
+}
+
 template <typename MemorySpace, typename Value, typename IndexableGetter,
           typename BoundingVolume>
 template <typename ExecutionSpace, typename UserPredicates, typename Callback>
@@ -412,7 +1121,29 @@ void BoundingVolumeHierarchy<
 
   Kokkos::Profiling::pushRegion(profiling_prefix);
 
-  if (policy._sort_predicates)
+  auto dispatch = [&](auto const &predicates_arg) {
+    if constexpr (std::is_same_v<Tag, Details::SpatialPredicateTag>)
+    {
+      if (policy._persistent_work_queue)
+      {
+        Details::traverseWithWorkQueue(space, *this, predicates_arg, callback);
+        return;
+      }
+      if (policy._packet_traversal)
+      {
+        Details::traverseWithPackets(space, *this, predicates_arg, callback);
+        return;
+      }
+    }
+    Details::traverse(space, *this, predicates_arg, callback);
+  };
+
+  auto *auto_tuner = policy._sorting_auto_tuner;
+  bool const sort_predicates =
+      (auto_tuner != nullptr ? auto_tuner->beginSample(space, predicates.size())
+                             : policy._sort_predicates);
+
+  if (sort_predicates)
   {
     Kokkos::Profiling::pushRegion(profiling_prefix + "::compute_permutation");
     using DeviceType = Kokkos::Device<ExecutionSpace, MemorySpace>;
@@ -422,21 +1153,24 @@ void BoundingVolumeHierarchy<
         scene_bounding_box{};
     using namespace Details;
     expand(scene_bounding_box, bounds());
-    auto permute = Details::BatchedQueries<DeviceType>::
-        sortPredicatesAlongSpaceFillingCurve(space, Experimental::Morton32(),
-                                             scene_bounding_box, predicates);
+    auto permute =
+        Details::BatchedQueries<DeviceType>::getOrComputePermutation(
+            space, Experimental::Morton32(), scene_bounding_box, predicates,
+            policy._sorting_cache);
     Kokkos::Profiling::popRegion();
 
     using PermutedPredicates =
         Details::PermutedData<Predicates, decltype(permute)>;
-    Details::traverse(space, *this, PermutedPredicates{predicates, permute},
-                      callback);
+    dispatch(PermutedPredicates{predicates, permute});
   }
   else
   {
-    Details::traverse(space, *this, predicates, callback);
+    dispatch(predicates);
   }
 
+  if (auto_tuner != nullptr)
+    auto_tuner->endSample(space);
+
   Kokkos::Profiling::popRegion();
 }
 
@@ -0,0 +1,468 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_MANAGED_BVH_HPP
+#define ARBORX_MANAGED_BVH_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_DetailsBatchedQueries.hpp>
+#include <ArborX_DetailsHappyTreeFriends.hpp>
+#include <ArborX_DetailsKokkosExtAccessibilityTraits.hpp>
+#include <ArborX_Exception.hpp>
+#include <ArborX_IndexableGetter.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_Predicates.hpp>
+#include <ArborX_SpaceFillingCurves.hpp>
+#include <ArborX_TraversalPolicy.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace ArborX::Details
+{
+
+// Residency hints for views living in unified (managed) memory. They are
+// plain hints: correctness never depends on them, so every overload
+// degenerates to a no-op when the execution space is not CUDA or the build
+// has no shared space, and the callers do not need to guard their call
+// sites.
+template <typename ExecutionSpace, typename View>
+inline void adviseViewPreferDevice(ExecutionSpace const &space,
+                                   View const &view)
+{
+#if defined(KOKKOS_ENABLE_CUDA) && defined(KOKKOS_HAS_SHARED_SPACE)
+  if constexpr (std::is_same_v<ExecutionSpace, Kokkos::Cuda>)
+  {
+    if (view.span() > 0)
+      cudaMemAdvise(view.data(), view.span() * sizeof(typename View::value_type),
+                    cudaMemAdviseSetPreferredLocation, space.cuda_device());
+    return;
+  }
+#endif
+  (void)space;
+  (void)view;
+}
+
+template <typename ExecutionSpace, typename View>
+inline void prefetchViewRangeToDevice(ExecutionSpace const &space,
+                                      View const &view, int begin, int end)
+{
+#if defined(KOKKOS_ENABLE_CUDA) && defined(KOKKOS_HAS_SHARED_SPACE)
+  if constexpr (std::is_same_v<ExecutionSpace, Kokkos::Cuda>)
+  {
+    if (begin < end)
+      cudaMemPrefetchAsync(view.data() + begin,
+                           (end - begin) * sizeof(typename View::value_type),
+                           space.cuda_device(), space.cuda_stream());
+    return;
+  }
+#endif
+  (void)space;
+  (void)view;
+  (void)begin;
+  (void)end;
+}
+
+template <typename ExecutionSpace, typename View>
+inline void adviseViewRangePreferDevice(ExecutionSpace const &space,
+                                        View const &view, int begin, int end)
+{
+#if defined(KOKKOS_ENABLE_CUDA) && defined(KOKKOS_HAS_SHARED_SPACE)
+  if constexpr (std::is_same_v<ExecutionSpace, Kokkos::Cuda>)
+  {
+    if (begin < end)
+      cudaMemAdvise(view.data() + begin,
+                    (end - begin) * sizeof(typename View::value_type),
+                    cudaMemAdviseSetPreferredLocation, space.cuda_device());
+    return;
+  }
+#endif
+  (void)space;
+  (void)view;
+  (void)begin;
+  (void)end;
+}
+
+template <typename ExecutionSpace, typename View>
+inline void adviseViewRangePreferHost(ExecutionSpace const &space,
+                                      View const &view, int begin, int end)
+{
+#if defined(KOKKOS_ENABLE_CUDA) && defined(KOKKOS_HAS_SHARED_SPACE)
+  if constexpr (std::is_same_v<ExecutionSpace, Kokkos::Cuda>)
+  {
+    if (begin < end)
+    {
+      auto *data = view.data() + begin;
+      std::size_t const bytes =
+          (end - begin) * sizeof(typename View::value_type);
+      cudaMemAdvise(data, bytes, cudaMemAdviseSetPreferredLocation,
+                    cudaCpuDeviceId);
+      // Keep the device mapping so traversals read the host-resident pages
+      // over the interconnect instead of faulting them back in
+      cudaMemAdvise(data, bytes, cudaMemAdviseSetAccessedBy,
+                    space.cuda_device());
+    }
+    return;
+  }
+#endif
+  (void)space;
+  (void)view;
+  (void)begin;
+  (void)end;
+}
+
+} // namespace ArborX::Details
+
+namespace ArborX::Experimental
+{
+
+// Hierarchy stored in unified (managed) memory so that trees larger than
+// device memory remain queryable through demand paging. Naive paging
+// thrashes during traversal -- incoherent predicates touch leaf pages all
+// over the tree faster than the driver migrates them -- so the queries are
+// made coherent and the paging is told where to go: the internal nodes,
+// which every traversal walks, are advised device-resident at construction,
+// and query() sorts the predicates along the space-filling curve of the
+// build, cuts them into chunks, and prefetches each chunk's leaf range
+// (found by mapping the chunk's bounding box to a range of the sorted leaf
+// codes) on a second execution space instance while the previous chunk
+// traverses on the first. On hardware without unified memory the hints
+// vanish and this behaves like a plain tree in the default memory space.
+// Only spatial predicates are supported; the callback-only query interface
+// matches OutOfCoreBVH.
+template <typename Value,
+          typename IndexableGetter = Details::DefaultIndexableGetter>
+class ManagedBVH
+{
+public:
+#ifdef KOKKOS_HAS_SHARED_SPACE
+  using memory_space = Kokkos::SharedSpace;
+#else
+  using memory_space = typename Kokkos::DefaultExecutionSpace::memory_space;
+#endif
+  using size_type = typename memory_space::size_type;
+  using value_type = Value;
+  using bvh_type =
+      BoundingVolumeHierarchy<memory_space, Value, IndexableGetter>;
+  using bounding_volume_type = typename bvh_type::bounding_volume_type;
+
+  ManagedBVH() = default; // build an empty tree
+
+  template <typename ExecutionSpace, typename UserValues>
+  ManagedBVH(ExecutionSpace const &space, UserValues const &user_values,
+             IndexableGetter const &indexable_getter = IndexableGetter(),
+             int chunk_size = 4096);
+
+  KOKKOS_FUNCTION
+  size_type size() const noexcept { return _bvh.size(); }
+
+  KOKKOS_FUNCTION
+  bool empty() const noexcept { return _bvh.empty(); }
+
+  bounding_volume_type bounds() const noexcept { return _bvh.bounds(); }
+
+  template <typename ExecutionSpace, typename UserPredicates,
+            typename Callback>
+  void query(ExecutionSpace const &space, UserPredicates const &user_predicates,
+             Callback const &callback) const;
+
+  // Explicitly tier the node storage between the fast and the capacity
+  // memory pools using per-node visit counts recorded with
+  // Experimental::recordNodeVisits() over a representative query batch. The
+  // internal nodes claim the fast pool first, since every traversal walks
+  // them; the remaining budget is filled with the most visited leaf blocks,
+  // and every other block is advised resident in capacity memory, where the
+  // device reads it in place instead of paging it in. This complements the
+  // per-chunk prefetches of query(): steadily hot treelets stop migrating
+  // back and forth, and cold regions stop competing for the fast pool. Call
+  // it again with fresh counts when the query distribution drifts. Like the
+  // construction-time hints this is advisory, and a no-op on hardware
+  // without unified memory.
+  template <typename ExecutionSpace, typename Visits>
+  void tierStorage(ExecutionSpace const &space, Visits const &visits,
+                   std::size_t fast_pool_bytes);
+
+private:
+  bvh_type _bvh;
+  // Space-filling curve codes of the leaves in leaf order (non-decreasing by
+  // construction), kept on the host to turn a chunk's bounding box into a
+  // leaf range without touching managed pages
+  Kokkos::View<unsigned long long *, Kokkos::HostSpace> _leaf_codes;
+  int _chunk_size = 4096;
+};
+
+template <typename Value, typename IndexableGetter>
+template <typename ExecutionSpace, typename UserValues>
+ManagedBVH<Value, IndexableGetter>::ManagedBVH(
+    ExecutionSpace const &space, UserValues const &user_values,
+    IndexableGetter const &indexable_getter, int chunk_size)
+    : _bvh(space, user_values, indexable_getter)
+    , _chunk_size(chunk_size)
+{
+  ARBORX_ASSERT(chunk_size > 0);
+
+  Kokkos::Profiling::ScopedRegion guard("ArborX::ManagedBVH::ManagedBVH");
+
+  int const n = size();
+  if (n <= 1)
+    return;
+
+  // The internal nodes are a small fraction of the footprint and every
+  // traversal walks them from the root, so they are the part that must not
+  // page out under oversubscription. The Karras layout does not store tree
+  // levels contiguously, so rather than pinning "top levels" the whole
+  // internal array is advised device-resident and prefetched up front; the
+  // leaves, which carry the values and dominate the footprint, are left to
+  // the per-chunk prefetches of query().
+  auto const &internal_nodes =
+      Details::HappyTreeFriends::getInternalNodes(_bvh);
+  Details::adviseViewPreferDevice(space, internal_nodes);
+  Details::prefetchViewRangeToDevice(space, internal_nodes, 0,
+                                     internal_nodes.extent_int(0));
+
+  auto const scene_box = bounds();
+  auto const &bvh = _bvh;
+  Kokkos::View<unsigned long long *, memory_space> codes(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::ManagedBVH::ManagedBVH::leaf_codes"),
+      n);
+  Kokkos::parallel_for(
+      "ArborX::ManagedBVH::ManagedBVH::compute_leaf_codes",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        codes(i) = Morton64{}(
+            scene_box, Details::HappyTreeFriends::getIndexable(bvh, i));
+      });
+
+  _leaf_codes = Kokkos::View<unsigned long long *, Kokkos::HostSpace>(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                         "ArborX::ManagedBVH::leaf_codes"),
+      n);
+  Kokkos::deep_copy(space, _leaf_codes, codes);
+  space.fence("ArborX::ManagedBVH::ManagedBVH (leaf codes copied to host)");
+}
+
+template <typename Value, typename IndexableGetter>
+template <typename ExecutionSpace, typename Visits>
+void ManagedBVH<Value, IndexableGetter>::tierStorage(
+    ExecutionSpace const &space, Visits const &visits,
+    std::size_t fast_pool_bytes)
+{
+  static_assert(Kokkos::is_view_v<Visits>);
+
+  Kokkos::Profiling::ScopedRegion guard("ArborX::ManagedBVH::tierStorage");
+
+  int const n = size();
+  if (n <= 1)
+    return;
+
+  // The counters are indexed like the nodes (see recordNodeVisits()); only
+  // the leaf entries matter here, the internal nodes are placed wholesale
+  ARBORX_ASSERT(visits.extent_int(0) == 2 * n - 1);
+
+  auto const &leaf_nodes = Details::HappyTreeFriends::getLeafNodes(_bvh);
+  auto const &internal_nodes =
+      Details::HappyTreeFriends::getInternalNodes(_bvh);
+  using leaf_node_type =
+      typename std::decay_t<decltype(leaf_nodes)>::value_type;
+  using internal_node_type =
+      typename std::decay_t<decltype(internal_nodes)>::value_type;
+
+  Details::adviseViewPreferDevice(space, internal_nodes);
+  std::size_t const internal_bytes =
+      internal_nodes.extent(0) * sizeof(internal_node_type);
+  std::size_t leaf_budget =
+      fast_pool_bytes > internal_bytes ? fast_pool_bytes - internal_bytes : 0;
+
+  // Aggregate the leaf heat in blocks matching the granularity the driver
+  // migrates at; finer advice would be ignored anyway. The leaves sit in
+  // space-filling curve order, so a block is a spatially compact treelet and
+  // its summed count is a faithful hotness measure.
+  int const leaves_per_block =
+      Kokkos::max((int)((std::size_t{2} << 20) / sizeof(leaf_node_type)), 1);
+  int const num_blocks = (n + leaves_per_block - 1) / leaves_per_block;
+
+  Kokkos::View<unsigned long long *, memory_space> block_heat(
+      Kokkos::view_alloc(space,
+                         "ArborX::ManagedBVH::tierStorage::block_heat"),
+      num_blocks);
+  Kokkos::parallel_for(
+      "ArborX::ManagedBVH::tierStorage::accumulate_block_heat",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        if (visits(i) > 0)
+          Kokkos::atomic_add(&block_heat(i / leaves_per_block),
+                             (unsigned long long)visits(i));
+      });
+  auto block_heat_host =
+      Kokkos::create_mirror_view(Kokkos::WithoutInitializing, block_heat);
+  Kokkos::deep_copy(space, block_heat_host, block_heat);
+  space.fence("ArborX::ManagedBVH::tierStorage (block heat copied to host)");
+
+  std::vector<int> order(num_blocks);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](int a, int b) {
+    return block_heat_host(a) > block_heat_host(b);
+  });
+
+  std::size_t const block_bytes =
+      (std::size_t)leaves_per_block * sizeof(leaf_node_type);
+  for (int b : order)
+  {
+    int const begin = b * leaves_per_block;
+    int const end = Kokkos::min(begin + leaves_per_block, n);
+    if (leaf_budget >= block_bytes && block_heat_host(b) > 0)
+    {
+      Details::adviseViewRangePreferDevice(space, leaf_nodes, begin, end);
+      Details::prefetchViewRangeToDevice(space, leaf_nodes, begin, end);
+      leaf_budget -= block_bytes;
+    }
+    else
+      Details::adviseViewRangePreferHost(space, leaf_nodes, begin, end);
+  }
+}
+
+template <typename Value, typename IndexableGetter>
+template <typename ExecutionSpace, typename UserPredicates, typename Callback>
+void ManagedBVH<Value, IndexableGetter>::query(
+    ExecutionSpace const &space, UserPredicates const &user_predicates,
+    Callback const &callback) const
+{
+  static_assert(
+      Details::KokkosExt::is_accessible_from<memory_space,
+                                             ExecutionSpace>::value);
+  Details::check_valid_access_traits(PredicatesTag{}, user_predicates);
+  using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+  static_assert(
+      Details::KokkosExt::is_accessible_from<typename Predicates::memory_space,
+                                             ExecutionSpace>::value,
+      "Predicates must be accessible from the execution space");
+  Predicates predicates{user_predicates}; // NOLINT
+
+  using Tag = typename Predicates::value_type::Tag;
+  static_assert(std::is_same_v<Tag, Details::SpatialPredicateTag>,
+                "ManagedBVH only supports spatial predicates");
+
+  Kokkos::Profiling::ScopedRegion guard("ArborX::ManagedBVH::query::spatial");
+
+  if (empty())
+    return;
+
+  int const n_queries = predicates.size();
+
+  // A single chunk has nothing to overlap with; let the regular query sort
+  // the predicates itself
+  if (n_queries <= _chunk_size || (int)size() <= 1)
+  {
+    _bvh.query(space, user_predicates, callback);
+    return;
+  }
+
+  using DeviceType = Kokkos::Device<ExecutionSpace, memory_space>;
+  auto const scene_box = bounds();
+
+  auto permute =
+      Details::BatchedQueries<DeviceType>::sortPredicatesAlongSpaceFillingCurve(
+          space, Morton64{}, scene_box, predicates);
+  auto permuted_predicates =
+      Details::BatchedQueries<DeviceType>::applyPermutation(space, permute,
+                                                            predicates);
+
+  int const chunk_size = _chunk_size;
+  int const num_chunks = (n_queries + chunk_size - 1) / chunk_size;
+
+  // Bounding box of each chunk's predicate geometries; the curve sort makes
+  // the chunks spatially compact, which is what keeps their leaf ranges
+  // small
+  Kokkos::View<bounding_volume_type *, memory_space> chunk_boxes(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::ManagedBVH::query::chunk_boxes"),
+      num_chunks);
+  constexpr int DIM = GeometryTraits::dimension_v<bounding_volume_type>;
+  Kokkos::parallel_for(
+      "ArborX::ManagedBVH::query::init_chunk_boxes",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_chunks),
+      KOKKOS_LAMBDA(int c) { chunk_boxes(c) = bounding_volume_type{}; });
+  Kokkos::parallel_for(
+      "ArborX::ManagedBVH::query::reduce_chunk_boxes",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int i) {
+        bounding_volume_type box{};
+        using Details::expand;
+        expand(box, getGeometry(permuted_predicates(i)));
+        auto &chunk_box = chunk_boxes(i / chunk_size);
+        for (int d = 0; d < DIM; ++d)
+        {
+          Kokkos::atomic_min(&chunk_box.minCorner()[d], box.minCorner()[d]);
+          Kokkos::atomic_max(&chunk_box.maxCorner()[d], box.maxCorner()[d]);
+        }
+      });
+
+  auto chunk_boxes_host =
+      Kokkos::create_mirror_view(Kokkos::WithoutInitializing, chunk_boxes);
+  Kokkos::deep_copy(space, chunk_boxes_host, chunk_boxes);
+  space.fence("ArborX::ManagedBVH::query (chunk boxes copied to host)");
+
+  auto const &leaf_nodes = Details::HappyTreeFriends::getLeafNodes(_bvh);
+  int const n = size();
+
+  // Two execution space instances: the prefetch of the next chunk's leaf
+  // range overlaps with the traversal of the current chunk; a chunk's
+  // traversal queues behind its own prefetch because they share an instance
+  auto instances = Kokkos::Experimental::partition_space(space, 1, 1);
+
+  for (int c = 0; c < num_chunks; ++c)
+  {
+    auto const &instance = instances[c % 2];
+
+    // Componentwise dominance implies Morton order, so every leaf whose
+    // centroid falls inside the chunk box has a code within the codes of
+    // the box corners (clamped to the scene so the scaling stays in range)
+    auto box = chunk_boxes_host(c);
+    for (int d = 0; d < DIM; ++d)
+    {
+      box.minCorner()[d] = Kokkos::max(box.minCorner()[d],
+                                       scene_box.minCorner()[d]);
+      box.maxCorner()[d] = Kokkos::min(box.maxCorner()[d],
+                                       scene_box.maxCorner()[d]);
+    }
+    int leaf_begin = 0;
+    int leaf_end = 0;
+    if (box.minCorner()[0] <= box.maxCorner()[0])
+    {
+      auto const lo = Morton64{}(scene_box, box.minCorner());
+      auto const hi = Morton64{}(scene_box, box.maxCorner());
+      auto const *first = _leaf_codes.data();
+      leaf_begin = std::lower_bound(first, first + n, lo) - first;
+      leaf_end = std::upper_bound(first, first + n, hi) - first;
+    }
+    Details::prefetchViewRangeToDevice(instance, leaf_nodes, leaf_begin,
+                                       leaf_end);
+
+    int const first = c * chunk_size;
+    int const last = Kokkos::min(first + chunk_size, n_queries);
+    _bvh.query(instance,
+               Kokkos::subview(permuted_predicates,
+                               std::make_pair(first, last)),
+               callback, TraversalPolicy().setPredicateSorting(false));
+  }
+
+  instances[0].fence("ArborX::ManagedBVH::query (chunks done)");
+  instances[1].fence("ArborX::ManagedBVH::query (chunks done)");
+}
+
+} // namespace ArborX::Experimental
+
+#endif
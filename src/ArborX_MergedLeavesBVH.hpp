@@ -0,0 +1,266 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_MERGED_LEAVES_BVH_HPP
+#define ARBORX_MERGED_LEAVES_BVH_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_Callbacks.hpp>
+#include <ArborX_DetailsKokkosExtAccessibilityTraits.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DetailsSortUtils.hpp>
+#include <ArborX_DetailsTreeConstruction.hpp>
+#include <ArborX_GeometryTraits.hpp>
+#include <ArborX_HyperBox.hpp>
+#include <ArborX_IndexableGetter.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_PairValueIndex.hpp>
+#include <ArborX_SpaceFillingCurves.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+namespace ArborX::Experimental
+{
+
+// Bounding volume hierarchy with multi-value leaves. Values that project onto
+// the same space-filling curve code are merged into a single leaf before the
+// hierarchy is built over one bounding box per merged group. With many
+// coincident values (scans with duplicated points), identical codes otherwise
+// force degenerate splits whose long node chains slow every traversal down;
+// merging bounds the tree size by the number of distinct codes, and the
+// traversal iterates over the contents of a matching leaf instead. Only
+// spatial predicates are supported.
+template <typename MemorySpace, typename Value,
+          typename IndexableGetter = Details::DefaultIndexableGetter>
+class MergedLeavesBVH
+{
+private:
+  using indexable_type =
+      std::decay_t<std::invoke_result_t<IndexableGetter, Value>>;
+
+public:
+  using memory_space = MemorySpace;
+  static_assert(Kokkos::is_memory_space<MemorySpace>::value);
+  using size_type = typename MemorySpace::size_type;
+  using value_type = Value;
+  using bounding_volume_type = ExperimentalHyperGeometry::Box<
+      GeometryTraits::dimension_v<indexable_type>,
+      typename GeometryTraits::coordinate_type_t<indexable_type>>;
+
+  MergedLeavesBVH() = default; // build an empty tree
+
+  template <typename ExecutionSpace, typename UserValues>
+  MergedLeavesBVH(ExecutionSpace const &space, UserValues const &user_values,
+                  IndexableGetter const &indexable_getter = IndexableGetter());
+
+  KOKKOS_FUNCTION
+  size_type size() const noexcept { return _size; }
+
+  KOKKOS_FUNCTION
+  bool empty() const noexcept { return size() == 0; }
+
+  KOKKOS_FUNCTION
+  bounding_volume_type bounds() const noexcept { return _bvh.bounds(); }
+
+  template <typename ExecutionSpace, typename UserPredicates, typename Callback>
+  void query(ExecutionSpace const &space, UserPredicates const &user_predicates,
+             Callback const &callback) const;
+
+  KOKKOS_FUNCTION auto const &indexable_get() const
+  {
+    return _indexable_getter;
+  }
+
+private:
+  using GroupValue = PairValueIndex<bounding_volume_type, int>;
+
+  // Replays a leaf hit as one callback invocation per group member that
+  // individually satisfies the predicate. The group box only proves overlap
+  // with the quantization cell, so members must be re-tested exactly.
+  template <typename Callback>
+  struct ExpandGroups
+  {
+    Kokkos::View<Value *, MemorySpace> _values;
+    Kokkos::View<int *, MemorySpace> _offsets;
+    IndexableGetter _indexable_getter;
+    Callback _callback;
+
+    template <typename Predicate>
+    KOKKOS_FUNCTION CallbackTreeTraversalControl
+    operator()(Predicate const &predicate, GroupValue const &group) const
+    {
+      for (int j = _offsets(group.index); j < _offsets(group.index + 1); ++j)
+      {
+        auto const &value = _values(j);
+        if (predicate(_indexable_getter(value)) &&
+            Details::invoke_callback_and_check_early_exit(_callback, predicate,
+                                                          value))
+          return CallbackTreeTraversalControl::early_exit;
+      }
+      return CallbackTreeTraversalControl::normal_continuation;
+    }
+  };
+
+  size_type _size{0};
+  Kokkos::View<Value *, MemorySpace> _values;
+  Kokkos::View<int *, MemorySpace> _offsets;
+  IndexableGetter _indexable_getter;
+  BoundingVolumeHierarchy<MemorySpace, GroupValue,
+                          Details::DefaultIndexableGetter,
+                          bounding_volume_type>
+      _bvh;
+};
+
+template <typename MemorySpace, typename Value, typename IndexableGetter>
+template <typename ExecutionSpace, typename UserValues>
+MergedLeavesBVH<MemorySpace, Value, IndexableGetter>::MergedLeavesBVH(
+    ExecutionSpace const &space, UserValues const &user_values,
+    IndexableGetter const &indexable_getter)
+    : _size(AccessTraits<UserValues, PrimitivesTag>::size(user_values))
+    , _values(Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                                 "ArborX::MergedLeavesBVH::values"),
+              _size)
+    , _indexable_getter(indexable_getter)
+{
+  static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
+                                                       ExecutionSpace>::value);
+  Details::check_valid_access_traits<UserValues>(
+      PrimitivesTag{}, user_values, Details::DoNotCheckGetReturnType());
+
+  using Values = Details::AccessValues<UserValues, PrimitivesTag>;
+  Values values{user_values}; // NOLINT
+
+  static_assert(
+      Details::KokkosExt::is_accessible_from<typename Values::memory_space,
+                                             ExecutionSpace>::value,
+      "Values must be accessible from the execution space");
+
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::MergedLeavesBVH::MergedLeavesBVH");
+
+  if (empty())
+  {
+    return;
+  }
+
+  int const n = _size;
+
+  bounding_volume_type scene_bounding_box{};
+  auto const &getter = _indexable_getter;
+  auto local_values = _values;
+  Kokkos::parallel_for(
+      "ArborX::MergedLeavesBVH::MergedLeavesBVH::copy_values",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i) { local_values(i) = values(i); });
+  Details::TreeConstruction::calculateBoundingBoxOfTheScene(
+      space,
+      Details::Indexables<Values, IndexableGetter>{values, _indexable_getter},
+      scene_bounding_box);
+
+  // Project onto the same space-filling curve the hierarchy construction
+  // uses, so that merged groups are exactly the values the binary build
+  // would fail to separate
+  Kokkos::View<unsigned long long *, MemorySpace> codes(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::MergedLeavesBVH::codes"),
+      n);
+  Details::TreeConstruction::projectOntoSpaceFillingCurve(
+      space,
+      Details::Indexables<Values, IndexableGetter>{values, _indexable_getter},
+      Morton64{}, scene_bounding_box, codes);
+
+  Details::sortObjects(space, codes, local_values);
+
+  // Number the groups of identical codes; after the scan, entry i + 1 holds
+  // one plus the group of element i
+  Kokkos::View<int *, MemorySpace> group_ids(
+      Kokkos::view_alloc(space, "ArborX::MergedLeavesBVH::group_ids"), n + 1);
+  Kokkos::parallel_for(
+      "ArborX::MergedLeavesBVH::MergedLeavesBVH::flag_group_starts",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        group_ids(i) = (i == 0 || codes(i) != codes(i - 1));
+      });
+  Details::KokkosExt::exclusive_scan(space, group_ids, group_ids, 0);
+
+  int const num_groups = Details::KokkosExt::lastElement(space, group_ids);
+
+  _offsets = Kokkos::View<int *, MemorySpace>(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::MergedLeavesBVH::offsets"),
+      num_groups + 1);
+  auto offsets = _offsets;
+  Kokkos::parallel_for(
+      "ArborX::MergedLeavesBVH::MergedLeavesBVH::fill_offsets",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        if (group_ids(i) != group_ids(i + 1))
+          offsets(group_ids(i + 1) - 1) = i;
+        if (i == n - 1)
+          offsets(num_groups) = n;
+      });
+
+  Kokkos::View<GroupValue *, MemorySpace> groups(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::MergedLeavesBVH::groups"),
+      num_groups);
+  Kokkos::parallel_for(
+      "ArborX::MergedLeavesBVH::MergedLeavesBVH::compute_group_boxes",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_groups),
+      KOKKOS_LAMBDA(int g) {
+        bounding_volume_type box{};
+        for (int j = offsets(g); j < offsets(g + 1); ++j)
+          Details::expand(box, getter(local_values(j)));
+        groups(g) = {box, g};
+      });
+
+  _bvh = BoundingVolumeHierarchy<MemorySpace, GroupValue,
+                                 Details::DefaultIndexableGetter,
+                                 bounding_volume_type>(space, groups);
+}
+
+template <typename MemorySpace, typename Value, typename IndexableGetter>
+template <typename ExecutionSpace, typename UserPredicates, typename Callback>
+void MergedLeavesBVH<MemorySpace, Value, IndexableGetter>::query(
+    ExecutionSpace const &space, UserPredicates const &user_predicates,
+    Callback const &callback) const
+{
+  static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
+                                                       ExecutionSpace>::value);
+  Details::check_valid_access_traits(PredicatesTag{}, user_predicates);
+  Details::check_valid_callback<value_type>(callback, user_predicates);
+
+  using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+  static_assert(
+      Details::KokkosExt::is_accessible_from<typename Predicates::memory_space,
+                                             ExecutionSpace>::value,
+      "Predicates must be accessible from the execution space");
+
+  using Tag = typename Predicates::value_type::Tag;
+  static_assert(std::is_same_v<Tag, Details::SpatialPredicateTag>,
+                "MergedLeavesBVH only supports spatial predicates");
+
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::MergedLeavesBVH::query::spatial");
+
+  if (empty())
+  {
+    return;
+  }
+
+  _bvh.query(space, user_predicates,
+             ExpandGroups<Callback>{_values, _offsets, _indexable_getter,
+                                    callback});
+}
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -0,0 +1,143 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#ifndef ARBORX_OPTICS_HPP
+#define ARBORX_OPTICS_HPP
+
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_DetailsWeightedEdge.hpp>
+#include <ArborX_Exception.hpp>
+#include <ArborX_MinimumSpanningTree.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <queue>
+#include <vector>
+
+namespace ArborX::Experimental
+{
+
+// Reachability ordering produced by OPTICS. _ordering lists the points in
+// the order they were reached, and _reachability(i) is the reachability
+// distance of point _ordering(i), with infinity marking the start of the
+// expansion. A DBSCAN clustering for any eps can be read off as the
+// horizontal cut of the reachability plot at that value.
+template <typename MemorySpace>
+struct OPTICS
+{
+  using memory_space = MemorySpace;
+  static_assert(Kokkos::is_memory_space<MemorySpace>::value);
+
+  Kokkos::View<int *, MemorySpace> _ordering;
+  Kokkos::View<float *, MemorySpace> _reachability;
+};
+
+template <typename ExecutionSpace, typename Primitives>
+auto optics(ExecutionSpace const &exec_space, Primitives const &primitives,
+            int core_min_size = 1)
+{
+  Kokkos::Profiling::ScopedRegion guard("ArborX::OPTICS");
+
+  using MemorySpace = typename Primitives::memory_space;
+
+  // OPTICS with unbounded eps always expands to the point with the smallest
+  // reachability from the already ordered set, which is exactly Prim's
+  // algorithm on the mutual reachability graph. The minimum spanning tree
+  // contains every edge that expansion can take, so running Prim on the tree
+  // produces the same reachability plot while reusing the Boruvka machinery
+  // and its core distance computation.
+  Kokkos::Profiling::pushRegion("ArborX::OPTICS::mst");
+  Details::MinimumSpanningTree<MemorySpace> mst(exec_space, primitives,
+                                                core_min_size);
+  Kokkos::Profiling::popRegion();
+
+  int const num_edges = mst.edges.size();
+  int const n = num_edges + 1;
+
+  OPTICS<MemorySpace> optics{
+      Kokkos::View<int *, MemorySpace>(
+          Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                             "ArborX::OPTICS::ordering"),
+          n),
+      Kokkos::View<float *, MemorySpace>(
+          Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                             "ArborX::OPTICS::reachability"),
+          n)};
+
+  // The expansion pops the globally smallest frontier edge and is inherently
+  // sequential, but only processes the n-1 tree edges and thus runs on host
+  // in negligible time compared to the tree construction
+  Kokkos::Profiling::pushRegion("ArborX::OPTICS::expansion");
+
+  auto edges_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, mst.edges);
+
+  std::vector<int> offsets(n + 1);
+  for (int e = 0; e < num_edges; ++e)
+  {
+    ++offsets[edges_host(e).source + 1];
+    ++offsets[edges_host(e).target + 1];
+  }
+  for (int i = 0; i < n; ++i)
+    offsets[i + 1] += offsets[i];
+  std::vector<int> incident(2 * num_edges);
+  {
+    auto slots = offsets;
+    for (int e = 0; e < num_edges; ++e)
+    {
+      incident[slots[edges_host(e).source]++] = e;
+      incident[slots[edges_host(e).target]++] = e;
+    }
+  }
+
+  auto ordering_host = Kokkos::create_mirror_view(optics._ordering);
+  auto reachability_host = Kokkos::create_mirror_view(optics._reachability);
+
+  using Frontier = std::pair<float, int>;
+  std::priority_queue<Frontier, std::vector<Frontier>, std::greater<Frontier>>
+      frontier;
+  std::vector<bool> visited(n);
+  int count = 0;
+  frontier.emplace(
+      Details::KokkosExt::ArithmeticTraits::infinity<float>::value, 0);
+  while (!frontier.empty())
+  {
+    auto [reachability, v] = frontier.top();
+    frontier.pop();
+    if (visited[v])
+      continue;
+    visited[v] = true;
+
+    ordering_host(count) = v;
+    reachability_host(count) = reachability;
+    ++count;
+
+    for (int j = offsets[v]; j < offsets[v + 1]; ++j)
+    {
+      auto const &edge = edges_host(incident[j]);
+      int const u = (edge.source == v ? edge.target : edge.source);
+      if (!visited[u])
+        frontier.emplace(edge.weight, u);
+    }
+  }
+  ARBORX_ASSERT(count == n);
+
+  Kokkos::deep_copy(exec_space, optics._ordering, ordering_host);
+  Kokkos::deep_copy(exec_space, optics._reachability, reachability_host);
+
+  Kokkos::Profiling::popRegion();
+
+  return optics;
+}
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -0,0 +1,516 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_OUT_OF_CORE_BVH_HPP
+#define ARBORX_OUT_OF_CORE_BVH_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_Callbacks.hpp>
+#include <ArborX_DetailsKokkosExtAccessibilityTraits.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DetailsNode.hpp>
+#include <ArborX_DetailsSortUtils.hpp>
+#include <ArborX_DetailsTreeConstruction.hpp>
+#include <ArborX_Exception.hpp>
+#include <ArborX_GeometryTraits.hpp>
+#include <ArborX_HyperBox.hpp>
+#include <ArborX_IndexableGetter.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_PairValueIndex.hpp>
+#include <ArborX_Predicates.hpp>
+#include <ArborX_SpaceFillingCurves.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace ArborX::Experimental
+{
+
+// Hierarchy for datasets whose tree does not fit in device memory. The values
+// are ordered once along a space-filling curve on the host and cut into
+// contiguous shards of at most shard_size values; each shard's subtree is
+// built on the device and parked in host-pinned memory. Queries are routed to
+// shards through a small device-resident tree over the shard bounds, and the
+// shards with work are streamed through two device staging buffers so that
+// the upload of the next shard overlaps with the traversal of the current
+// one. The space-filling-curve order keeps shard bounds compact, which is
+// what makes the routing selective. Only spatial predicates are supported,
+// and the callback may be invoked for the same predicate from different
+// shards concurrently.
+template <typename MemorySpace, typename Value,
+          typename IndexableGetter = Details::DefaultIndexableGetter>
+class OutOfCoreBVH
+{
+private:
+  using indexable_type =
+      std::decay_t<std::invoke_result_t<IndexableGetter, Value>>;
+
+public:
+  using memory_space = MemorySpace;
+  static_assert(Kokkos::is_memory_space<MemorySpace>::value);
+  using size_type = typename MemorySpace::size_type;
+  using value_type = Value;
+  using bounding_volume_type = ExperimentalHyperGeometry::Box<
+      GeometryTraits::dimension_v<indexable_type>,
+      typename GeometryTraits::coordinate_type_t<indexable_type>>;
+#ifdef KOKKOS_HAS_SHARED_HOST_PINNED_SPACE
+  using shard_storage_space = Kokkos::SharedHostPinnedSpace;
+#else
+  using shard_storage_space = Kokkos::HostSpace;
+#endif
+
+  OutOfCoreBVH() = default; // build an empty tree
+
+  template <typename ExecutionSpace, typename UserValues>
+  OutOfCoreBVH(ExecutionSpace const &space, UserValues const &user_values,
+               int shard_size,
+               IndexableGetter const &indexable_getter = IndexableGetter());
+
+  KOKKOS_FUNCTION
+  size_type size() const noexcept { return _size; }
+
+  KOKKOS_FUNCTION
+  bool empty() const noexcept { return size() == 0; }
+
+  int numShards() const noexcept
+  {
+    return _shard_leaf_offsets.extent_int(0) - 1;
+  }
+
+  bounding_volume_type bounds() const noexcept { return _bounds; }
+
+  template <typename ExecutionSpace, typename UserPredicates,
+            typename Callback>
+  void query(ExecutionSpace const &space, UserPredicates const &user_predicates,
+             Callback const &callback) const;
+
+private:
+  using leaf_node_type = Details::LeafNode<Value>;
+  using internal_node_type = Details::InternalNode<bounding_volume_type>;
+  using top_value_type = PairValueIndex<bounding_volume_type, int>;
+
+  // Emit the shard index of every shard whose bounds satisfy the predicate
+  struct ShardRouteCallback
+  {
+    template <typename Predicate, typename OutputFunctor>
+    KOKKOS_FUNCTION void operator()(Predicate const &,
+                                    top_value_type const &value,
+                                    OutputFunctor const &out) const
+    {
+      out(value.index);
+    }
+  };
+
+  // Rope traversal of one staged shard by the predicates routed to it
+  template <typename Predicates, typename Callback>
+  struct ShardQuery
+  {
+    Kokkos::View<leaf_node_type *, MemorySpace> _leaf_nodes;
+    Kokkos::View<internal_node_type *, MemorySpace> _internal_nodes;
+    Kokkos::View<int *, MemorySpace> _routed_queries;
+    Predicates _predicates;
+    Callback _callback;
+    IndexableGetter _indexable_getter;
+    int _num_leaves;
+
+    KOKKOS_FUNCTION void operator()(int k) const
+    {
+      auto const &predicate = _predicates(_routed_queries(k));
+
+      int const n = _num_leaves;
+      int node = (n > 1 ? n : 0);
+      while (node != Details::ROPE_SENTINEL)
+      {
+        if (node < n)
+        {
+          auto const &leaf = _leaf_nodes(node);
+          if (predicate(_indexable_getter(leaf.value)) &&
+              Details::invoke_callback_and_check_early_exit(
+                  _callback, predicate, leaf.value))
+            return;
+          node = leaf.rope;
+        }
+        else
+        {
+          auto const &internal = _internal_nodes(node - n);
+          node = (predicate(internal.bounding_volume) ? internal.left_child
+                                                      : internal.rope);
+        }
+      }
+    }
+  };
+
+  size_type _size{0};
+  bounding_volume_type _bounds;
+  // Shard s owns the leaves in [_shard_leaf_offsets(s),
+  // _shard_leaf_offsets(s + 1)) and the internal nodes in the aligned range
+  // of _shard_internal_offsets; node indices within a shard are shard-local
+  Kokkos::View<leaf_node_type *, shard_storage_space> _leaf_nodes;
+  Kokkos::View<internal_node_type *, shard_storage_space> _internal_nodes;
+  Kokkos::View<int *, Kokkos::HostSpace> _shard_leaf_offsets;
+  Kokkos::View<int *, Kokkos::HostSpace> _shard_internal_offsets;
+  int _max_shard_size{0};
+  BoundingVolumeHierarchy<MemorySpace, top_value_type> _top_tree;
+  IndexableGetter _indexable_getter;
+};
+
+template <typename MemorySpace, typename Value, typename IndexableGetter>
+template <typename ExecutionSpace, typename UserValues>
+OutOfCoreBVH<MemorySpace, Value, IndexableGetter>::OutOfCoreBVH(
+    ExecutionSpace const &space, UserValues const &user_values, int shard_size,
+    IndexableGetter const &indexable_getter)
+    : _size(AccessTraits<UserValues, PrimitivesTag>::size(user_values))
+    , _indexable_getter(indexable_getter)
+{
+  static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
+                                                       ExecutionSpace>::value);
+  Details::check_valid_access_traits<UserValues>(
+      PrimitivesTag{}, user_values, Details::DoNotCheckGetReturnType());
+
+  using Values = Details::AccessValues<UserValues, PrimitivesTag>;
+  Values values{user_values}; // NOLINT
+
+  using HostExecutionSpace = Kokkos::DefaultHostExecutionSpace;
+  static_assert(
+      Details::KokkosExt::is_accessible_from<typename Values::memory_space,
+                                             HostExecutionSpace>::value,
+      "Values must be accessible from the host; data larger than device "
+      "memory necessarily originates there");
+
+  ARBORX_ASSERT(shard_size > 0);
+
+  Kokkos::Profiling::ScopedRegion guard("ArborX::OutOfCoreBVH::OutOfCoreBVH");
+
+  int const n = _size;
+  int const num_shards = (n > 0 ? (n + shard_size - 1) / shard_size : 0);
+
+  _shard_leaf_offsets = Kokkos::View<int *, Kokkos::HostSpace>(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                         "ArborX::OutOfCoreBVH::shard_leaf_offsets"),
+      num_shards + 1);
+  _shard_internal_offsets = Kokkos::View<int *, Kokkos::HostSpace>(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                         "ArborX::OutOfCoreBVH::shard_internal_offsets"),
+      num_shards + 1);
+  _shard_leaf_offsets(0) = 0;
+  _shard_internal_offsets(0) = 0;
+  for (int s = 0; s < num_shards; ++s)
+  {
+    int const m = std::min(shard_size, n - s * shard_size);
+    _shard_leaf_offsets(s + 1) = _shard_leaf_offsets(s) + m;
+    _shard_internal_offsets(s + 1) =
+        _shard_internal_offsets(s) + (m > 1 ? m - 1 : 0);
+    _max_shard_size = std::max(_max_shard_size, m);
+  }
+
+  if (n == 0)
+    return;
+
+  HostExecutionSpace host_space;
+
+  // Order the values along a space-filling curve on the host so that
+  // contiguous shards cover compact regions of space. Compact shard bounds
+  // are what makes the predicate routing selective.
+  Kokkos::Profiling::pushRegion("ArborX::OutOfCoreBVH::OutOfCoreBVH::order");
+
+  Details::Indexables<Values, IndexableGetter> indexables{values,
+                                                          indexable_getter};
+
+  bounding_volume_type scene_bounds{};
+  Details::TreeConstruction::calculateBoundingBoxOfTheScene(
+      host_space, indexables, scene_bounds);
+
+  Morton64 curve;
+  using LinearOrderingValueType =
+      std::invoke_result_t<Morton64, bounding_volume_type, indexable_type>;
+  Kokkos::View<LinearOrderingValueType *, Kokkos::HostSpace> linear_ordering(
+      Kokkos::view_alloc(host_space, Kokkos::WithoutInitializing,
+                         "ArborX::OutOfCoreBVH::linear_ordering"),
+      n);
+  Details::TreeConstruction::projectOntoSpaceFillingCurve(
+      host_space, indexables, curve, scene_bounds, linear_ordering);
+
+  auto permutation = Details::sortObjects(host_space, linear_ordering);
+
+  Kokkos::View<Value *, shard_storage_space> sorted_values(
+      Kokkos::view_alloc(host_space, Kokkos::WithoutInitializing,
+                         "ArborX::OutOfCoreBVH::sorted_values"),
+      n);
+  Kokkos::parallel_for(
+      "ArborX::OutOfCoreBVH::OutOfCoreBVH::apply_permutation",
+      Kokkos::RangePolicy<HostExecutionSpace>(host_space, 0, n),
+      KOKKOS_LAMBDA(int i) { sorted_values(i) = values(permutation(i)); });
+  host_space.fence();
+
+  Kokkos::Profiling::popRegion();
+
+  // Build every shard's subtree on the device through a staging buffer and
+  // park the nodes in host-pinned storage
+  Kokkos::Profiling::pushRegion(
+      "ArborX::OutOfCoreBVH::OutOfCoreBVH::build_shards");
+
+  _leaf_nodes = Kokkos::View<leaf_node_type *, shard_storage_space>(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                         "ArborX::OutOfCoreBVH::leaf_nodes"),
+      n);
+  _internal_nodes = Kokkos::View<internal_node_type *, shard_storage_space>(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                         "ArborX::OutOfCoreBVH::internal_nodes"),
+      _shard_internal_offsets(num_shards));
+
+  int const m_max = _max_shard_size;
+  Kokkos::View<Value *, MemorySpace> staging_values(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::OutOfCoreBVH::staging_values"),
+      m_max);
+  Kokkos::View<leaf_node_type *, MemorySpace> staging_leaf_nodes(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::OutOfCoreBVH::staging_leaf_nodes"),
+      m_max);
+  Kokkos::View<internal_node_type *, MemorySpace> staging_internal_nodes(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::OutOfCoreBVH::staging_internal_nodes"),
+      m_max > 1 ? m_max - 1 : 0);
+
+  Kokkos::View<top_value_type *, Kokkos::HostSpace> shard_boxes_host(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                         "ArborX::OutOfCoreBVH::shard_boxes_host"),
+      num_shards);
+
+  for (int s = 0; s < num_shards; ++s)
+  {
+    int const m = _shard_leaf_offsets(s + 1) - _shard_leaf_offsets(s);
+    auto const leaf_range =
+        std::make_pair(_shard_leaf_offsets(s), _shard_leaf_offsets(s + 1));
+
+    auto shard_values = Kokkos::subview(staging_values, std::make_pair(0, m));
+    auto shard_leaf_nodes =
+        Kokkos::subview(staging_leaf_nodes, std::make_pair(0, m));
+    Kokkos::deep_copy(space, shard_values,
+                      Kokkos::subview(sorted_values, leaf_range));
+
+    bounding_volume_type shard_bounds{};
+    if (m == 1)
+    {
+      Details::TreeConstruction::initializeSingleLeafTree(
+          space, shard_values, _indexable_getter, shard_leaf_nodes,
+          shard_bounds);
+    }
+    else
+    {
+      Details::Indexables<decltype(shard_values), IndexableGetter>
+          shard_indexables{shard_values, _indexable_getter};
+
+      bounding_volume_type shard_scene_bounds{};
+      Details::TreeConstruction::calculateBoundingBoxOfTheScene(
+          space, shard_indexables, shard_scene_bounds);
+
+      // Re-project within the shard's own bounds: the per-shard codes have
+      // a much finer resolution than the global ordering computed above
+      Kokkos::View<LinearOrderingValueType *, MemorySpace> shard_codes(
+          Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                             "ArborX::OutOfCoreBVH::shard_codes"),
+          m);
+      Details::TreeConstruction::projectOntoSpaceFillingCurve(
+          space, shard_indexables, curve, shard_scene_bounds, shard_codes);
+
+      auto shard_permutation = Details::sortObjects(space, shard_codes);
+
+      auto shard_internal_nodes =
+          Kokkos::subview(staging_internal_nodes, std::make_pair(0, m - 1));
+      Details::TreeConstruction::generateHierarchy(
+          space, shard_values, _indexable_getter, shard_permutation,
+          shard_codes, shard_leaf_nodes, shard_internal_nodes, shard_bounds);
+
+      Kokkos::deep_copy(
+          space,
+          Kokkos::subview(_internal_nodes,
+                          std::make_pair(_shard_internal_offsets(s),
+                                         _shard_internal_offsets(s + 1))),
+          shard_internal_nodes);
+    }
+    Kokkos::deep_copy(space, Kokkos::subview(_leaf_nodes, leaf_range),
+                      shard_leaf_nodes);
+
+    // The staging buffers are reused by the next iteration and shard_bounds
+    // is only valid on the host past this point
+    space.fence(
+        "ArborX::OutOfCoreBVH::OutOfCoreBVH (shard construction done)");
+
+    Details::expand(_bounds, shard_bounds);
+    shard_boxes_host(s) = {shard_bounds, s};
+  }
+
+  Kokkos::Profiling::popRegion();
+
+  // Small device-resident tree over the shard bounds used to route
+  // predicates to the shards they may touch
+  Kokkos::View<top_value_type *, MemorySpace> shard_boxes(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::OutOfCoreBVH::shard_boxes"),
+      num_shards);
+  Kokkos::deep_copy(space, shard_boxes, shard_boxes_host);
+  _top_tree = BoundingVolumeHierarchy<MemorySpace, top_value_type>(
+      space, shard_boxes);
+}
+
+template <typename MemorySpace, typename Value, typename IndexableGetter>
+template <typename ExecutionSpace, typename UserPredicates, typename Callback>
+void OutOfCoreBVH<MemorySpace, Value, IndexableGetter>::query(
+    ExecutionSpace const &space, UserPredicates const &user_predicates,
+    Callback const &callback) const
+{
+  static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
+                                                       ExecutionSpace>::value);
+  Details::check_valid_access_traits(PredicatesTag{}, user_predicates);
+  Details::check_valid_callback<value_type>(callback, user_predicates);
+
+  using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+  static_assert(
+      Details::KokkosExt::is_accessible_from<typename Predicates::memory_space,
+                                             ExecutionSpace>::value,
+      "Predicates must be accessible from the execution space");
+  Predicates predicates{user_predicates}; // NOLINT
+
+  using Tag = typename Predicates::value_type::Tag;
+  static_assert(std::is_same_v<Tag, Details::SpatialPredicateTag>,
+                "OutOfCoreBVH only supports spatial predicates");
+
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::OutOfCoreBVH::query::spatial");
+
+  if (empty())
+    return;
+
+  int const n_queries = predicates.size();
+  int const num_shards = numShards();
+
+  // Route each predicate to the shards whose bounds it may intersect
+  Kokkos::View<int *, MemorySpace> shard_ids(
+      "ArborX::OutOfCoreBVH::query::shard_ids", 0);
+  Kokkos::View<int *, MemorySpace> query_offsets(
+      "ArborX::OutOfCoreBVH::query::query_offsets", 0);
+  _top_tree.query(space, user_predicates, ShardRouteCallback{}, shard_ids,
+                  query_offsets);
+
+  int const n_routed = shard_ids.extent(0);
+  if (n_routed == 0)
+    return;
+
+  // Invert the predicate-major routing into shard-major lists so that each
+  // shard is uploaded once and traversed by all its predicates
+  Kokkos::View<int *, MemorySpace> routed_queries(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::OutOfCoreBVH::query::routed_queries"),
+      n_routed);
+  Kokkos::View<int *, MemorySpace> shard_offsets(
+      Kokkos::view_alloc(space, "ArborX::OutOfCoreBVH::query::shard_offsets"),
+      num_shards + 1);
+  Kokkos::parallel_for(
+      "ArborX::OutOfCoreBVH::query::count_shard_queries",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int i) {
+        for (int j = query_offsets(i); j < query_offsets(i + 1); ++j)
+        {
+          routed_queries(j) = i;
+          Kokkos::atomic_increment(&shard_offsets(shard_ids(j)));
+        }
+      });
+  Details::KokkosExt::exclusive_scan(space, shard_offsets, shard_offsets, 0);
+
+  auto shard_cursors = Details::KokkosExt::clone(space, shard_offsets);
+  Kokkos::View<int *, MemorySpace> shard_queries(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::OutOfCoreBVH::query::shard_queries"),
+      n_routed);
+  Kokkos::parallel_for(
+      "ArborX::OutOfCoreBVH::query::fill_shard_queries",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_routed),
+      KOKKOS_LAMBDA(int j) {
+        int const pos =
+            Kokkos::atomic_fetch_add(&shard_cursors(shard_ids(j)), 1);
+        shard_queries(pos) = routed_queries(j);
+      });
+
+  auto shard_offsets_host = Kokkos::create_mirror_view(shard_offsets);
+  Kokkos::deep_copy(space, shard_offsets_host, shard_offsets);
+  space.fence("ArborX::OutOfCoreBVH::query (copy shard offsets to host)");
+
+  // Two staging buffers on two execution space instances: the upload of the
+  // next shard with work overlaps with the traversal of the current one.
+  // A kernel and the upload it depends on share an instance, so they run in
+  // order without explicit fences.
+  auto instances = Kokkos::Experimental::partition_space(space, 1, 1);
+
+  int const m_max = _max_shard_size;
+  Kokkos::View<leaf_node_type *, MemorySpace> staging_leaf_nodes[2] = {
+      {Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                          "ArborX::OutOfCoreBVH::query::staging_leaf_nodes_0"),
+       (size_t)m_max},
+      {Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                          "ArborX::OutOfCoreBVH::query::staging_leaf_nodes_1"),
+       (size_t)m_max}};
+  Kokkos::View<internal_node_type *, MemorySpace> staging_internal_nodes[2] = {
+      {Kokkos::view_alloc(
+           space, Kokkos::WithoutInitializing,
+           "ArborX::OutOfCoreBVH::query::staging_internal_nodes_0"),
+       (size_t)(m_max > 1 ? m_max - 1 : 0)},
+      {Kokkos::view_alloc(
+           space, Kokkos::WithoutInitializing,
+           "ArborX::OutOfCoreBVH::query::staging_internal_nodes_1"),
+       (size_t)(m_max > 1 ? m_max - 1 : 0)}};
+  space.fence("ArborX::OutOfCoreBVH::query (staging buffers ready)");
+
+  int round = 0;
+  for (int s = 0; s < num_shards; ++s)
+  {
+    if (shard_offsets_host(s + 1) == shard_offsets_host(s))
+      continue;
+
+    int const buf = round++ % 2;
+    auto const &instance = instances[buf];
+
+    int const m = _shard_leaf_offsets(s + 1) - _shard_leaf_offsets(s);
+    Kokkos::deep_copy(
+        instance, Kokkos::subview(staging_leaf_nodes[buf], std::make_pair(0, m)),
+        Kokkos::subview(_leaf_nodes,
+                        std::make_pair(_shard_leaf_offsets(s),
+                                       _shard_leaf_offsets(s + 1))));
+    if (m > 1)
+      Kokkos::deep_copy(
+          instance,
+          Kokkos::subview(staging_internal_nodes[buf],
+                          std::make_pair(0, m - 1)),
+          Kokkos::subview(_internal_nodes,
+                          std::make_pair(_shard_internal_offsets(s),
+                                         _shard_internal_offsets(s + 1))));
+
+    Kokkos::parallel_for(
+        "ArborX::OutOfCoreBVH::query::spatial",
+        Kokkos::RangePolicy<ExecutionSpace>(instance, shard_offsets_host(s),
+                                            shard_offsets_host(s + 1)),
+        ShardQuery<Predicates, Callback>{staging_leaf_nodes[buf],
+                                         staging_internal_nodes[buf],
+                                         shard_queries, predicates, callback,
+                                         _indexable_getter, m});
+  }
+
+  instances[0].fence("ArborX::OutOfCoreBVH::query (shards done)");
+  instances[1].fence("ArborX::OutOfCoreBVH::query (shards done)");
+}
+
+} // namespace ArborX::Experimental
+
+#endif
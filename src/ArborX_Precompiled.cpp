@@ -0,0 +1,25 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <ArborX_Precompiled.hpp>
+
+namespace ArborX::Experimental
+{
+
+// The only definitions of the common configurations in a program built with
+// ARBORX_ENABLE_EXPLICIT_INSTANTIATION; the header's extern declarations
+// suppress them everywhere else
+ARBORX_PRECOMPILED_INSTANTIATIONS(, 2, float)
+ARBORX_PRECOMPILED_INSTANTIATIONS(, 3, float)
+ARBORX_PRECOMPILED_INSTANTIATIONS(, 2, double)
+ARBORX_PRECOMPILED_INSTANTIATIONS(, 3, double)
+
+} // namespace ArborX::Experimental
@@ -0,0 +1,128 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_PRECOMPILED_HPP
+#define ARBORX_PRECOMPILED_HPP
+
+#include <ArborX_AttachIndices.hpp>
+#include <ArborX_Config.hpp>
+#include <ArborX_DetailsLegacy.hpp>
+#include <ArborX_HyperPoint.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_PairValueIndex.hpp>
+#include <ArborX_PredicateHelpers.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Experimental
+{
+
+// Stable entry points around the most common configuration: a BVH over
+// index-carrying points in the default device memory, queried with radius or
+// k-nearest searches producing indices in CRS format. Every translation unit
+// calling query() directly instantiates the full traversal and CRS
+// construction stack; routing the common cases through these functions keeps
+// a single instantiation per program, and with
+// ARBORX_ENABLE_EXPLICIT_INSTANTIATION the definitions below for 2D/3D
+// float/double points are compiled once into the ArborX_Precompiled library
+// and skipped in application translation units entirely.
+
+template <int DIM, typename Coordinate>
+using PrecompiledPoint = ExperimentalHyperGeometry::Point<DIM, Coordinate>;
+
+template <int DIM, typename Coordinate>
+using PrecompiledTree =
+    BoundingVolumeHierarchy<Kokkos::DefaultExecutionSpace::memory_space,
+                            PairValueIndex<PrecompiledPoint<DIM, Coordinate>>>;
+
+template <int DIM, typename Coordinate>
+PrecompiledTree<DIM, Coordinate>
+buildTree(Kokkos::DefaultExecutionSpace const &space,
+          Kokkos::View<PrecompiledPoint<DIM, Coordinate> *,
+                       Kokkos::DefaultExecutionSpace::memory_space> const
+              &points)
+{
+  return {space, attach_indices(points)};
+}
+
+// Indices of the stored points within radius of every query point
+template <int DIM, typename Coordinate>
+void radiusSearch(Kokkos::DefaultExecutionSpace const &space,
+                  PrecompiledTree<DIM, Coordinate> const &tree,
+                  Kokkos::View<PrecompiledPoint<DIM, Coordinate> *,
+                               Kokkos::DefaultExecutionSpace::memory_space>
+                      const &queries,
+                  Coordinate radius,
+                  Kokkos::View<int *,
+                               Kokkos::DefaultExecutionSpace::memory_space>
+                      &indices,
+                  Kokkos::View<int *,
+                               Kokkos::DefaultExecutionSpace::memory_space>
+                      &offsets)
+{
+  tree.query(space, make_intersects(queries, radius),
+             Details::LegacyDefaultCallback{}, indices, offsets);
+}
+
+// Indices of the k stored points nearest to every query point
+template <int DIM, typename Coordinate>
+void nearestSearch(Kokkos::DefaultExecutionSpace const &space,
+                   PrecompiledTree<DIM, Coordinate> const &tree,
+                   Kokkos::View<PrecompiledPoint<DIM, Coordinate> *,
+                                Kokkos::DefaultExecutionSpace::memory_space>
+                       const &queries,
+                   int k,
+                   Kokkos::View<int *,
+                                Kokkos::DefaultExecutionSpace::memory_space>
+                       &indices,
+                   Kokkos::View<int *,
+                                Kokkos::DefaultExecutionSpace::memory_space>
+                       &offsets)
+{
+  tree.query(space, make_nearest(queries, k),
+             Details::LegacyDefaultCallback{}, indices, offsets);
+}
+
+// One line per configuration, shared between the extern declarations here
+// and the instantiation definitions in ArborX_Precompiled.cpp
+#define ARBORX_PRECOMPILED_INSTANTIATIONS(EXTERN, DIM, COORDINATE)             \
+  EXTERN template PrecompiledTree<DIM, COORDINATE>                             \
+  buildTree<DIM, COORDINATE>(                                                  \
+      Kokkos::DefaultExecutionSpace const &,                                   \
+      Kokkos::View<PrecompiledPoint<DIM, COORDINATE> *,                        \
+                   Kokkos::DefaultExecutionSpace::memory_space> const &);      \
+  EXTERN template void radiusSearch<DIM, COORDINATE>(                          \
+      Kokkos::DefaultExecutionSpace const &,                                   \
+      PrecompiledTree<DIM, COORDINATE> const &,                                \
+      Kokkos::View<PrecompiledPoint<DIM, COORDINATE> *,                        \
+                   Kokkos::DefaultExecutionSpace::memory_space> const &,       \
+      COORDINATE,                                                              \
+      Kokkos::View<int *, Kokkos::DefaultExecutionSpace::memory_space> &,      \
+      Kokkos::View<int *, Kokkos::DefaultExecutionSpace::memory_space> &);     \
+  EXTERN template void nearestSearch<DIM, COORDINATE>(                         \
+      Kokkos::DefaultExecutionSpace const &,                                   \
+      PrecompiledTree<DIM, COORDINATE> const &,                                \
+      Kokkos::View<PrecompiledPoint<DIM, COORDINATE> *,                        \
+                   Kokkos::DefaultExecutionSpace::memory_space> const &,       \
+      int,                                                                     \
+      Kokkos::View<int *, Kokkos::DefaultExecutionSpace::memory_space> &,      \
+      Kokkos::View<int *, Kokkos::DefaultExecutionSpace::memory_space> &);
+
+#ifdef ARBORX_ENABLE_EXPLICIT_INSTANTIATION
+ARBORX_PRECOMPILED_INSTANTIATIONS(extern, 2, float)
+ARBORX_PRECOMPILED_INSTANTIATIONS(extern, 3, float)
+ARBORX_PRECOMPILED_INSTANTIATIONS(extern, 2, double)
+ARBORX_PRECOMPILED_INSTANTIATIONS(extern, 3, double)
+#endif
+
+} // namespace ArborX::Experimental
+
+#endif
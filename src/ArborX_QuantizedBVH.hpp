@@ -0,0 +1,284 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_QUANTIZED_BVH_HPP
+#define ARBORX_QUANTIZED_BVH_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_Callbacks.hpp>
+#include <ArborX_DetailsHappyTreeFriends.hpp>
+#include <ArborX_DetailsKokkosExtAccessibilityTraits.hpp>
+#include <ArborX_DetailsNode.hpp>
+#include <ArborX_IndexableGetter.hpp>
+#include <ArborX_LinearBVH.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <cstdint>
+
+namespace ArborX::Experimental
+{
+
+// Compressed read-only copy of a BoundingVolumeHierarchy for bandwidth-bound
+// traversal. Internal node boxes are quantized to 16 bits per coordinate on a
+// uniform grid over the scene bounds and decompressed on the fly during
+// traversal. Quantization is conservative (minima rounded down, maxima up),
+// so traversal may visit slightly more nodes but never misses a result; the
+// exact leaf indexables are kept at full precision. The boxes are quantized
+// against the scene rather than the parent because the rope-based stackless
+// traversal does not have the parent box in hand when following a rope.
+// Only spatial predicates are supported.
+template <typename MemorySpace, typename Value,
+          typename IndexableGetter = Details::DefaultIndexableGetter,
+          typename BoundingVolume = ExperimentalHyperGeometry::Box<
+              GeometryTraits::dimension_v<
+                  std::decay_t<std::invoke_result_t<IndexableGetter, Value>>>,
+              typename GeometryTraits::coordinate_type_t<
+                  std::decay_t<std::invoke_result_t<IndexableGetter, Value>>>>>
+class QuantizedBVH
+{
+public:
+  using memory_space = MemorySpace;
+  static_assert(Kokkos::is_memory_space<MemorySpace>::value);
+  using size_type = typename MemorySpace::size_type;
+  using bounding_volume_type = BoundingVolume;
+  using value_type = Value;
+
+  static_assert(GeometryTraits::is_box_v<BoundingVolume>,
+                "QuantizedBVH requires box bounding volumes");
+
+  static constexpr int DIM = GeometryTraits::dimension_v<BoundingVolume>;
+  using coordinate_type =
+      typename GeometryTraits::coordinate_type_t<BoundingVolume>;
+
+  QuantizedBVH() = default; // build an empty tree
+
+  template <typename ExecutionSpace>
+  QuantizedBVH(ExecutionSpace const &space,
+               BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter,
+                                       BoundingVolume> const &bvh);
+
+  KOKKOS_FUNCTION
+  size_type size() const noexcept { return _size; }
+
+  KOKKOS_FUNCTION
+  bool empty() const noexcept { return size() == 0; }
+
+  KOKKOS_FUNCTION
+  bounding_volume_type bounds() const noexcept { return _bounds; }
+
+  template <typename ExecutionSpace, typename Predicates, typename Callback>
+  void query(ExecutionSpace const &space, Predicates const &predicates,
+             Callback const &callback) const;
+
+private:
+  static constexpr std::uint16_t MAX_QUANTIZED = 65535;
+
+  struct QuantizedInternalNode
+  {
+    std::uint16_t min_corner[DIM];
+    std::uint16_t max_corner[DIM];
+    int left_child = -1;
+    int rope = Details::ROPE_SENTINEL;
+  };
+
+  KOKKOS_FUNCTION BoundingVolume
+  decompress(QuantizedInternalNode const &node) const
+  {
+    BoundingVolume box;
+    for (int d = 0; d < DIM; ++d)
+    {
+      box.minCorner()[d] =
+          _bounds.minCorner()[d] + node.min_corner[d] * _cell_size[d];
+      box.maxCorner()[d] =
+          _bounds.minCorner()[d] + node.max_corner[d] * _cell_size[d];
+    }
+    return box;
+  }
+
+  template <typename Predicates, typename Callback>
+  struct SpatialQuery
+  {
+    QuantizedBVH _tree;
+    Predicates _predicates;
+    Callback _callback;
+
+    KOKKOS_FUNCTION void operator()(int query_index) const
+    {
+      auto const &predicate = _predicates(query_index);
+
+      int const n = _tree._size;
+      int node = n; // root
+      do
+      {
+        if (node < n) // leaf
+        {
+          auto const &leaf_node = _tree._leaf_nodes(node);
+          if (predicate(_tree._indexable_getter(leaf_node.value)) &&
+              Details::invoke_callback_and_check_early_exit(
+                  _callback, predicate, leaf_node.value))
+            return;
+          node = leaf_node.rope;
+        }
+        else
+        {
+          auto const &internal_node = _tree._internal_nodes(node - n);
+          node = (predicate(_tree.decompress(internal_node))
+                      ? internal_node.left_child
+                      : internal_node.rope);
+        }
+      } while (node != Details::ROPE_SENTINEL);
+    }
+  };
+
+  size_type _size{0};
+  bounding_volume_type _bounds;
+  coordinate_type _cell_size[DIM];
+  Kokkos::View<Details::LeafNode<Value> *, MemorySpace> _leaf_nodes;
+  Kokkos::View<QuantizedInternalNode *, MemorySpace> _internal_nodes;
+  IndexableGetter _indexable_getter;
+};
+
+template <typename MemorySpace, typename Value, typename IndexableGetter,
+          typename BoundingVolume>
+template <typename ExecutionSpace>
+QuantizedBVH<MemorySpace, Value, IndexableGetter, BoundingVolume>::
+    QuantizedBVH(ExecutionSpace const &space,
+                 BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter,
+                                         BoundingVolume> const &bvh)
+    : _size(bvh.size())
+    , _bounds(bvh.bounds())
+    , _leaf_nodes(Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                                     "ArborX::QuantizedBVH::leaf_nodes"),
+                  _size)
+    , _internal_nodes(Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                                         "ArborX::QuantizedBVH::internal_nodes"),
+                      _size > 1 ? _size - 1 : 0)
+    , _indexable_getter(bvh.indexable_get())
+{
+  static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
+                                                       ExecutionSpace>::value);
+
+  Kokkos::Profiling::ScopedRegion guard("ArborX::QuantizedBVH::QuantizedBVH");
+
+  for (int d = 0; d < DIM; ++d)
+    _cell_size[d] = (_bounds.maxCorner()[d] - _bounds.minCorner()[d]) /
+                    (coordinate_type)MAX_QUANTIZED;
+
+  if (empty())
+  {
+    return;
+  }
+
+  int const n = _size;
+  auto leaf_nodes = _leaf_nodes;
+  auto internal_nodes = _internal_nodes;
+  auto const bounds = _bounds;
+  Kokkos::Array<coordinate_type, DIM> cell_size;
+  for (int d = 0; d < DIM; ++d)
+    cell_size[d] = _cell_size[d];
+
+  Kokkos::parallel_for(
+      "ArborX::QuantizedBVH::QuantizedBVH::compress",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, Kokkos::max(2 * n - 1, 1)),
+      KOKKOS_LAMBDA(int i) {
+        using Details::HappyTreeFriends;
+        if (i < n)
+        {
+          auto leaf_node =
+              Details::makeLeafNode(HappyTreeFriends::getValue(bvh, i));
+          leaf_node.rope =
+              (n > 1 ? HappyTreeFriends::getRope(bvh, i)
+                     : Details::ROPE_SENTINEL);
+          leaf_nodes(i) = leaf_node;
+        }
+        else
+        {
+          auto const &box =
+              HappyTreeFriends::getInternalBoundingVolume(bvh, i);
+          QuantizedInternalNode node;
+          for (int d = 0; d < DIM; ++d)
+          {
+            auto const inv_cell =
+                (cell_size[d] > 0 ? 1 / cell_size[d] : (coordinate_type)0);
+            auto lo = Kokkos::floor((box.minCorner()[d] -
+                                     bounds.minCorner()[d]) *
+                                    inv_cell);
+            auto hi = Kokkos::ceil(
+                (box.maxCorner()[d] - bounds.minCorner()[d]) * inv_cell);
+            node.min_corner[d] = (std::uint16_t)Kokkos::clamp(
+                lo, (decltype(lo))0, (decltype(lo))MAX_QUANTIZED);
+            node.max_corner[d] = (std::uint16_t)Kokkos::clamp(
+                hi, (decltype(hi))0, (decltype(hi))MAX_QUANTIZED);
+          }
+          node.left_child = HappyTreeFriends::getLeftChild(bvh, i);
+          node.rope = HappyTreeFriends::getRope(bvh, i);
+          internal_nodes(i - n) = node;
+        }
+      });
+}
+
+template <typename MemorySpace, typename Value, typename IndexableGetter,
+          typename BoundingVolume>
+template <typename ExecutionSpace, typename UserPredicates, typename Callback>
+void QuantizedBVH<MemorySpace, Value, IndexableGetter, BoundingVolume>::query(
+    ExecutionSpace const &space, UserPredicates const &user_predicates,
+    Callback const &callback) const
+{
+  static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
+                                                       ExecutionSpace>::value);
+  Details::check_valid_access_traits(PredicatesTag{}, user_predicates);
+  Details::check_valid_callback<value_type>(callback, user_predicates);
+
+  using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+  static_assert(
+      Details::KokkosExt::is_accessible_from<typename Predicates::memory_space,
+                                             ExecutionSpace>::value,
+      "Predicates must be accessible from the execution space");
+  Predicates predicates{user_predicates}; // NOLINT
+
+  using Tag = typename Predicates::value_type::Tag;
+  static_assert(std::is_same_v<Tag, Details::SpatialPredicateTag>,
+                "QuantizedBVH only supports spatial predicates");
+
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::QuantizedBVH::query::spatial");
+
+  if (empty())
+  {
+    return;
+  }
+
+  if (size() == 1)
+  {
+    auto leaf_nodes = _leaf_nodes;
+    auto indexable_getter = _indexable_getter;
+    Kokkos::parallel_for(
+        "ArborX::QuantizedBVH::query::spatial::degenerated_one_leaf_tree",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, predicates.size()),
+        KOKKOS_LAMBDA(int i) {
+          auto const &predicate = predicates(i);
+          if (predicate(indexable_getter(leaf_nodes(0).value)))
+            callback(predicate, leaf_nodes(0).value);
+        });
+    return;
+  }
+
+  Kokkos::parallel_for(
+      "ArborX::QuantizedBVH::query::spatial",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, predicates.size()),
+      SpatialQuery<Predicates, Callback>{*this, predicates, callback});
+}
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -0,0 +1,144 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_QUERY_RESULT_CACHE_HPP
+#define ARBORX_QUERY_RESULT_CACHE_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <cstdint>
+
+namespace ArborX::Experimental
+{
+
+// Memoizes the CRS output of a query against an immutable tree. Parameter
+// sweeps issue literally identical predicate batches against the same tree
+// over and over; a traversal is pure repeated work then, so the first call
+// stores the output here and later calls replay it after a cheap device-side
+// hash check of the predicate batch.
+//
+// The key is the raw byte image of the predicates together with their count
+// and the tree size. The tree structure itself is not hashed: updating or
+// rebuilding the tree in place requires calling clear(), or the replayed
+// output silently goes stale. A changed predicate batch (different bytes or
+// count) falls through to a regular traversal and refreshes the cache.
+//
+// The output views passed to query() are resized and filled from the cached
+// copy, so the caller may modify them freely without corrupting the cache.
+//
+// Typical use:
+//
+//   Experimental::QueryResultCache<Kokkos::View<int *, MemorySpace>> cache;
+//   for (auto const &parameters : sweep)
+//   {
+//     cache.query(space, tree, predicates, indices, offsets);
+//     postprocess(indices, offsets, parameters);
+//   }
+template <typename Values,
+          typename Offsets = Kokkos::View<int *, typename Values::memory_space>>
+class QueryResultCache
+{
+  static_assert(Kokkos::is_view_v<Values> && Kokkos::is_view_v<Offsets>);
+
+public:
+  template <typename ExecutionSpace, typename Tree, typename Predicates>
+  void query(ExecutionSpace const &space, Tree const &tree,
+             Predicates const &predicates, Values &values, Offsets &offsets)
+  {
+    namespace KokkosExt = ArborX::Details::KokkosExt;
+
+    Kokkos::Profiling::ScopedRegion guard("ArborX::QueryResultCache::query");
+
+    auto const hash = hashPredicates(space, predicates);
+    auto const num_predicates =
+        AccessTraits<Predicates, PredicatesTag>::size(predicates);
+
+    if (_valid && hash == _hash && num_predicates == _num_predicates &&
+        tree.size() == _tree_size)
+    {
+      Kokkos::Profiling::ScopedRegion replay_guard(
+          "ArborX::QueryResultCache::replay");
+      KokkosExt::reallocWithoutInitializing(space, values, _values.size());
+      KokkosExt::reallocWithoutInitializing(space, offsets, _offsets.size());
+      Kokkos::deep_copy(space, values, _values);
+      Kokkos::deep_copy(space, offsets, _offsets);
+      return;
+    }
+
+    tree.query(space, predicates, values, offsets);
+
+    KokkosExt::reallocWithoutInitializing(space, _values, values.size());
+    KokkosExt::reallocWithoutInitializing(space, _offsets, offsets.size());
+    Kokkos::deep_copy(space, _values, values);
+    Kokkos::deep_copy(space, _offsets, offsets);
+    _hash = hash;
+    _num_predicates = num_predicates;
+    _tree_size = tree.size();
+    _valid = true;
+  }
+
+  void clear() { _valid = false; }
+
+private:
+  template <typename ExecutionSpace, typename Predicates>
+  static std::uint64_t hashPredicates(ExecutionSpace const &space,
+                                      Predicates const &user_predicates)
+  {
+    Details::AccessValues<Predicates, PredicatesTag> predicates{
+        user_predicates};
+    using Predicate = typename decltype(predicates)::value_type;
+    static_assert(std::is_trivially_copyable_v<Predicate>);
+
+    std::uint64_t hash;
+    Kokkos::parallel_reduce(
+        "ArborX::QueryResultCache::hash_predicates",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, predicates.size()),
+        KOKKOS_LAMBDA(int i, std::uint64_t &update) {
+          // FNV-1a over the position followed by the byte image of the
+          // predicate. The position has to run through the hash state, not
+          // be XOR-ed onto the result: separate XOR terms cancel pairwise
+          // under the XOR combine, so any two batches in which every
+          // distinct predicate appears an even number of times would
+          // collide. Hashed through the state, identical predicates at
+          // different positions contribute unrelated terms, which also
+          // keeps permuted batches from colliding.
+          auto const predicate = predicates(i);
+          std::uint64_t const position = i;
+          auto const *position_bytes =
+              reinterpret_cast<unsigned char const *>(&position);
+          auto const *bytes =
+              reinterpret_cast<unsigned char const *>(&predicate);
+          std::uint64_t h = 14695981039346656037ull;
+          for (std::size_t b = 0; b < sizeof(position); ++b)
+            h = (h ^ position_bytes[b]) * 1099511628211ull;
+          for (std::size_t b = 0; b < sizeof(Predicate); ++b)
+            h = (h ^ bytes[b]) * 1099511628211ull;
+          update ^= h;
+        },
+        Kokkos::BXor<std::uint64_t>(hash));
+    return hash;
+  }
+
+  Values _values;
+  Offsets _offsets;
+  std::uint64_t _hash = 0;
+  std::size_t _num_predicates = 0;
+  std::size_t _tree_size = 0;
+  bool _valid = false;
+};
+
+} // namespace ArborX::Experimental
+
+#endif
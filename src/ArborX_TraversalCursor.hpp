@@ -0,0 +1,104 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_TRAVERSAL_CURSOR_HPP
+#define ARBORX_TRAVERSAL_CURSOR_HPP
+
+#include <ArborX_DetailsHappyTreeFriends.hpp>
+#include <ArborX_DetailsNode.hpp>
+#include <ArborX_Predicates.hpp>
+
+#include <Kokkos_Macros.hpp>
+
+#include <type_traits>
+
+namespace ArborX::Experimental
+{
+
+// Resumable, stackless spatial traversal over a single predicate, the
+// re-entrant counterpart of query(PerThread, ...). Instead of invoking a
+// callback for every match inline, the cursor yields after each leaf hit
+// and can be re-entered, letting a kernel interleave the processing of one
+// neighbor with the search for the next without materializing a neighbor
+// list. The whole traversal state is the current node index: the ropes make
+// both the descent and the sibling advance stackless, exactly as in the
+// inline traversal.
+template <typename Tree, typename Predicate>
+struct SpatialTraversalCursor
+{
+  using value_type = typename Tree::value_type;
+
+  Tree _tree;
+  Predicate _predicate;
+  int _node = Details::ROPE_SENTINEL;
+
+  KOKKOS_FUNCTION
+  SpatialTraversalCursor(Tree const &tree, Predicate const &predicate)
+      : _tree(tree)
+      , _predicate(predicate)
+  {
+    static_assert(
+        std::is_same_v<typename Predicate::Tag, Details::SpatialPredicateTag>,
+        "SpatialTraversalCursor requires a spatial predicate");
+    if (!_tree.empty())
+    {
+      // A single-leaf tree has no internal nodes; start at the leaf itself
+      _node = (_tree.size() == 1 ? 0
+                                 : Details::HappyTreeFriends::getRoot(_tree));
+    }
+  }
+
+  // Advance to the next value whose indexable satisfies the predicate.
+  // Returns false once the traversal is exhausted.
+  KOKKOS_FUNCTION bool next(value_type &value)
+  {
+    using Details::HappyTreeFriends;
+    while (_node != Details::ROPE_SENTINEL)
+    {
+      if (HappyTreeFriends::isLeaf(_tree, _node))
+      {
+        bool const hit =
+            _predicate(HappyTreeFriends::getIndexable(_tree, _node));
+        int const leaf = _node;
+        _node = HappyTreeFriends::getRope(_tree, _node);
+        if (hit)
+        {
+          value = HappyTreeFriends::getValue(_tree, leaf);
+          return true;
+        }
+      }
+      else
+      {
+        _node = (_predicate(
+                     HappyTreeFriends::getInternalBoundingVolume(_tree, _node))
+                     ? HappyTreeFriends::getLeftChild(_tree, _node)
+                     : HappyTreeFriends::getRope(_tree, _node));
+      }
+    }
+    return false;
+  }
+
+  KOKKOS_FUNCTION bool done() const
+  {
+    return _node == Details::ROPE_SENTINEL;
+  }
+};
+
+template <typename Tree, typename Predicate>
+KOKKOS_FUNCTION auto make_spatial_cursor(Tree const &tree,
+                                         Predicate const &predicate)
+{
+  return SpatialTraversalCursor<Tree, Predicate>{tree, predicate};
+}
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -0,0 +1,351 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_TREE_SERIALIZATION_HPP
+#define ARBORX_TREE_SERIALIZATION_HPP
+
+#include <ArborX_Config.hpp> // ARBORX_ENABLE_CUFILE
+
+#include <ArborX_DetailsNode.hpp>
+#include <ArborX_Exception.hpp>
+#include <ArborX_LinearBVH.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <string>
+
+#ifdef ARBORX_ENABLE_CUFILE
+#include <cufile.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace ArborX
+{
+
+namespace Details
+{
+
+// On-disk layout (version 2):
+//
+//   [ header                 ]  padded to the section alignment
+//   [ bounding volume        ]  padded to the section alignment
+//   [ leaf nodes             ]  padded to the section alignment
+//   [ internal nodes         ]
+//
+// Every section starts on a 4 KiB boundary — the direct-I/O granularity of
+// NVMe block devices — and node arrays are raw dumps of the in-memory
+// representation, so a file may be mmap-ed and the arrays used in place (on
+// a host-accessible memory space), transferred with a single deep_copy per
+// array, or streamed straight into device memory with O_DIRECT reads. The
+// stored type sizes guard against loading a file produced with a different
+// value or bounding volume type, but the format is not portable across
+// architectures with different layouts.
+struct TreeSerialization
+{
+  static constexpr std::uint64_t section_alignment = 4096;
+  static constexpr std::uint32_t format_version = 2;
+  static constexpr char expected_magic[8] = {'A', 'r', 'b', 'o',
+                                             'r', 'X', 'T', '\0'};
+
+  struct Header
+  {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t unused;
+    std::uint64_t num_leaves;
+    std::uint64_t leaf_node_bytes;
+    std::uint64_t internal_node_bytes;
+    std::uint64_t bounding_volume_bytes;
+  };
+  static_assert(sizeof(Header) == 48);
+
+  static void padSection(std::ostream &os, std::uint64_t written)
+  {
+    char const zeros[section_alignment] = {};
+    auto const remainder = written % section_alignment;
+    if (remainder != 0)
+      os.write(zeros, section_alignment - remainder);
+  }
+
+  static void skipPadding(std::istream &is, std::uint64_t read)
+  {
+    auto const remainder = read % section_alignment;
+    if (remainder != 0)
+      is.seekg(section_alignment - remainder, std::ios_base::cur);
+  }
+
+  template <typename Tree>
+  static void save(Tree const &tree, std::ostream &os)
+  {
+    using leaf_node_type = LeafNode<typename Tree::value_type>;
+    using internal_node_type = InternalNode<typename Tree::bounding_volume_type>;
+
+    std::uint64_t const n = tree.size();
+
+    Header header{};
+    std::memcpy(header.magic, expected_magic, sizeof(header.magic));
+    header.version = format_version;
+    header.num_leaves = n;
+    header.leaf_node_bytes = sizeof(leaf_node_type);
+    header.internal_node_bytes = sizeof(internal_node_type);
+    header.bounding_volume_bytes = sizeof(typename Tree::bounding_volume_type);
+    os.write(reinterpret_cast<char const *>(&header), sizeof(Header));
+    padSection(os, sizeof(Header));
+
+    auto const bounds = tree.bounds();
+    os.write(reinterpret_cast<char const *>(&bounds), sizeof(bounds));
+    padSection(os, sizeof(bounds));
+
+    auto leaf_nodes = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{},
+                                                          tree._leaf_nodes);
+    if (n > 0)
+      os.write(reinterpret_cast<char const *>(leaf_nodes.data()),
+               n * sizeof(leaf_node_type));
+    padSection(os, n * sizeof(leaf_node_type));
+
+    auto internal_nodes = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace{}, tree._internal_nodes);
+    if (internal_nodes.size() > 0)
+      os.write(reinterpret_cast<char const *>(internal_nodes.data()),
+               internal_nodes.size() * sizeof(internal_node_type));
+
+    ARBORX_ASSERT(os.good());
+  }
+
+  template <typename Tree, typename ExecutionSpace>
+  static Tree load(ExecutionSpace const &space, std::istream &is)
+  {
+    using MemorySpace = typename Tree::memory_space;
+    using leaf_node_type = LeafNode<typename Tree::value_type>;
+    using internal_node_type = InternalNode<typename Tree::bounding_volume_type>;
+
+    Header header;
+    is.read(reinterpret_cast<char *>(&header), sizeof(Header));
+    ARBORX_ASSERT(is.good());
+    ARBORX_ASSERT(std::memcmp(header.magic, expected_magic,
+                              sizeof(header.magic)) == 0);
+    ARBORX_ASSERT(header.version == format_version);
+    ARBORX_ASSERT(header.leaf_node_bytes == sizeof(leaf_node_type));
+    ARBORX_ASSERT(header.internal_node_bytes == sizeof(internal_node_type));
+    ARBORX_ASSERT(header.bounding_volume_bytes ==
+                  sizeof(typename Tree::bounding_volume_type));
+    skipPadding(is, sizeof(Header));
+
+    Tree tree;
+
+    is.read(reinterpret_cast<char *>(&tree._bounds), sizeof(tree._bounds));
+    skipPadding(is, sizeof(tree._bounds));
+
+    std::uint64_t const n = header.num_leaves;
+    tree._size = n;
+
+    Kokkos::View<leaf_node_type *, MemorySpace> leaf_nodes(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::BVH::leaf_nodes"),
+        n);
+    auto leaf_nodes_host = Kokkos::create_mirror_view(leaf_nodes);
+    if (n > 0)
+      is.read(reinterpret_cast<char *>(leaf_nodes_host.data()),
+              n * sizeof(leaf_node_type));
+    skipPadding(is, n * sizeof(leaf_node_type));
+    Kokkos::deep_copy(space, leaf_nodes, leaf_nodes_host);
+    tree._leaf_nodes = leaf_nodes;
+
+    Kokkos::View<internal_node_type *, MemorySpace> internal_nodes(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::BVH::internal_nodes"),
+        n > 1 ? n - 1 : 0);
+    auto internal_nodes_host = Kokkos::create_mirror_view(internal_nodes);
+    if (internal_nodes.size() > 0)
+      is.read(reinterpret_cast<char *>(internal_nodes_host.data()),
+              internal_nodes.size() * sizeof(internal_node_type));
+    Kokkos::deep_copy(space, internal_nodes, internal_nodes_host);
+    tree._internal_nodes = internal_nodes;
+
+    ARBORX_ASSERT(is.good());
+
+    return tree;
+  }
+
+#ifdef ARBORX_ENABLE_CUFILE
+  static constexpr std::uint64_t alignedSize(std::uint64_t size)
+  {
+    return ((size + section_alignment - 1) / section_alignment) *
+           section_alignment;
+  }
+
+  static void ensureDriverOpen()
+  {
+    static bool const opened = [] {
+      auto const status = cuFileDriverOpen();
+      ARBORX_ASSERT(status.err == CU_FILE_SUCCESS);
+      return true;
+    }();
+    (void)opened;
+  }
+
+  static void readDirect(CUfileHandle_t handle, void *device_ptr,
+                         std::uint64_t size, std::uint64_t file_offset)
+  {
+    if (size == 0)
+      return;
+    auto const status = cuFileBufRegister(device_ptr, size, 0);
+    ARBORX_ASSERT(status.err == CU_FILE_SUCCESS);
+    auto const count =
+        cuFileRead(handle, device_ptr, size, (off_t)file_offset, 0);
+    cuFileBufDeregister(device_ptr);
+    ARBORX_ASSERT(count == (ssize_t)size);
+  }
+
+  // Stream the node arrays from storage directly into device memory through
+  // GPUDirect Storage, without bouncing through host buffers or the page
+  // cache. The section offsets are fixed by the header, so only the tiny
+  // metadata sections go through a regular stream read.
+  template <typename Tree>
+  static Tree loadDirect(Kokkos::Cuda const &space,
+                         std::string const &filename)
+  {
+    using MemorySpace = typename Tree::memory_space;
+    static_assert(std::is_same_v<MemorySpace, Kokkos::CudaSpace>,
+                  "GPUDirect Storage loads target CUDA device memory");
+    using leaf_node_type = LeafNode<typename Tree::value_type>;
+    using internal_node_type =
+        InternalNode<typename Tree::bounding_volume_type>;
+
+    ensureDriverOpen();
+
+    Header header;
+    Tree tree;
+    {
+      std::ifstream ifs(filename, std::ios_base::binary);
+      ARBORX_ASSERT(ifs.is_open());
+      ifs.read(reinterpret_cast<char *>(&header), sizeof(Header));
+      ARBORX_ASSERT(ifs.good());
+      ARBORX_ASSERT(std::memcmp(header.magic, expected_magic,
+                                sizeof(header.magic)) == 0);
+      ARBORX_ASSERT(header.version == format_version);
+      ARBORX_ASSERT(header.leaf_node_bytes == sizeof(leaf_node_type));
+      ARBORX_ASSERT(header.internal_node_bytes == sizeof(internal_node_type));
+      ARBORX_ASSERT(header.bounding_volume_bytes ==
+                    sizeof(typename Tree::bounding_volume_type));
+      skipPadding(ifs, sizeof(Header));
+      ifs.read(reinterpret_cast<char *>(&tree._bounds), sizeof(tree._bounds));
+      ARBORX_ASSERT(ifs.good());
+    }
+
+    std::uint64_t const n = header.num_leaves;
+    tree._size = n;
+
+    Kokkos::View<leaf_node_type *, MemorySpace> leaf_nodes(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::BVH::leaf_nodes"),
+        n);
+    Kokkos::View<internal_node_type *, MemorySpace> internal_nodes(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::BVH::internal_nodes"),
+        n > 1 ? n - 1 : 0);
+    // cuFile transfers are not stream-ordered, so the asynchronous
+    // allocations must have materialized before the reads start
+    space.fence("ArborX::TreeSerialization::load_direct");
+
+    int const fd = ::open(filename.c_str(), O_RDONLY | O_DIRECT);
+    ARBORX_ASSERT(fd >= 0);
+    CUfileDescr_t descriptor{};
+    descriptor.handle.fd = fd;
+    descriptor.type = CU_FILE_HANDLE_TYPE_OPAQUE_FD;
+    CUfileHandle_t handle;
+    auto const status = cuFileHandleRegister(&handle, &descriptor);
+    ARBORX_ASSERT(status.err == CU_FILE_SUCCESS);
+
+    std::uint64_t const leaf_offset =
+        alignedSize(sizeof(Header)) +
+        alignedSize(sizeof(typename Tree::bounding_volume_type));
+    readDirect(handle, leaf_nodes.data(), n * sizeof(leaf_node_type),
+               leaf_offset);
+    readDirect(handle, internal_nodes.data(),
+               internal_nodes.size() * sizeof(internal_node_type),
+               leaf_offset + alignedSize(n * sizeof(leaf_node_type)));
+
+    cuFileHandleDeregister(handle);
+    ::close(fd);
+
+    tree._leaf_nodes = leaf_nodes;
+    tree._internal_nodes = internal_nodes;
+
+    return tree;
+  }
+#endif
+};
+
+} // namespace Details
+
+namespace Experimental
+{
+
+// Serialization is only supported for trees whose indexable getter carries no
+// state (the default getter reads the indexable straight out of the stored
+// values), as the getter is not part of the dump.
+
+template <typename Tree>
+void saveTree(Tree const &tree, std::ostream &os)
+{
+  Details::TreeSerialization::save(tree, os);
+}
+
+template <typename Tree>
+void saveTree(Tree const &tree, std::string const &filename)
+{
+  std::ofstream ofs(filename, std::ios_base::binary);
+  ARBORX_ASSERT(ofs.is_open());
+  saveTree(tree, ofs);
+}
+
+template <typename Tree, typename ExecutionSpace>
+Tree loadTree(ExecutionSpace const &space, std::istream &is)
+{
+  return Details::TreeSerialization::load<Tree>(space, is);
+}
+
+template <typename Tree, typename ExecutionSpace>
+Tree loadTree(ExecutionSpace const &space, std::string const &filename)
+{
+  std::ifstream ifs(filename, std::ios_base::binary);
+  ARBORX_ASSERT(ifs.is_open());
+  return loadTree<Tree>(space, ifs);
+}
+
+// Load a saved tree with the node arrays streamed from storage directly into
+// device memory (GPUDirect Storage), bypassing the host page cache and
+// bounce buffers. Takes effect when ArborX is configured with
+// ARBORX_ENABLE_CUFILE and the tree lives in CUDA device memory; every other
+// configuration silently takes the regular stream-based load.
+template <typename Tree, typename ExecutionSpace>
+Tree loadTreeDirect(ExecutionSpace const &space, std::string const &filename)
+{
+#ifdef ARBORX_ENABLE_CUFILE
+  if constexpr (std::is_same_v<ExecutionSpace, Kokkos::Cuda> &&
+                std::is_same_v<typename Tree::memory_space, Kokkos::CudaSpace>)
+    return Details::TreeSerialization::loadDirect<Tree>(space, filename);
+#endif
+  return loadTree<Tree>(space, filename);
+}
+
+} // namespace Experimental
+
+} // namespace ArborX
+
+#endif
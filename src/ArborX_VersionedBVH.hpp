@@ -0,0 +1,210 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_VERSIONED_BVH_HPP
+#define ARBORX_VERSIONED_BVH_HPP
+
+#include <ArborX_DetailsHappyTreeFriends.hpp>
+#include <ArborX_IndexableGetter.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_SpaceFillingCurves.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace ArborX::Experimental
+{
+
+// Hierarchy for services that must keep answering queries while the geometry
+// keeps changing. Every mutation runs on a private clone of the node storage
+// (a standby generation) and becomes visible through an atomic pointer swing
+// that bumps an epoch counter; a query takes a snapshot of the generation
+// published at the time of the call, finishes on it no matter how many
+// publishes happen meanwhile, and never waits for a writer. The price is one
+// copy of the node arrays per mutation, and writers serialize among
+// themselves.
+//
+// The snapshot isolation covers the tree's own storage only. With an
+// indexable getter that references external user storage, geometry the user
+// moves in place is seen by every generation at once; the old generation
+// then pairs its frozen bounding volumes with the moved positions until it
+// drains, exactly as an un-refitted tree would.
+template <typename MemorySpace, typename Value,
+          typename IndexableGetter = Details::DefaultIndexableGetter>
+class VersionedBVH
+{
+public:
+  using memory_space = MemorySpace;
+  using value_type = Value;
+  using bvh_type = BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter>;
+  using size_type = typename bvh_type::size_type;
+  using bounding_volume_type = typename bvh_type::bounding_volume_type;
+
+  VersionedBVH()
+      : _state(std::make_shared<State>())
+  {}
+
+  template <typename ExecutionSpace, typename UserValues,
+            typename SpaceFillingCurve = Morton64>
+  VersionedBVH(ExecutionSpace const &space, UserValues const &user_values,
+               IndexableGetter const &indexable_getter = IndexableGetter(),
+               SpaceFillingCurve const &curve = SpaceFillingCurve())
+      : _state(std::make_shared<State>())
+  {
+    auto tree = std::make_shared<bvh_type const>(space, user_values,
+                                                 indexable_getter, curve);
+    space.fence("ArborX::VersionedBVH (initial generation ready)");
+    // No readers can hold the state yet, so no atomics and no epoch bump
+    _state->published = std::move(tree);
+  }
+
+  // Number of publishes since construction. Two equal readings with a
+  // snapshot taken in between certify that the snapshot was current for the
+  // whole interval.
+  unsigned long long epoch() const { return _state->epoch.load(); }
+
+  size_type size() const { return std::atomic_load(&_state->published)->size(); }
+
+  bool empty() const { return size() == 0; }
+
+  // The generation published at the time of the call. The returned tree
+  // shares its storage through the views' reference counts, so it stays
+  // valid and immutable for as long as the caller keeps it, however many
+  // generations are published afterwards.
+  bvh_type snapshot() const { return *std::atomic_load(&_state->published); }
+
+  // Runs against the snapshot taken on entry; any of the
+  // BoundingVolumeHierarchy query signatures can follow the predicates
+  template <typename ExecutionSpace, typename UserPredicates, typename... Args>
+  void query(ExecutionSpace const &space, UserPredicates const &user_predicates,
+             Args &&...args) const
+  {
+    snapshot().query(space, user_predicates, std::forward<Args>(args)...);
+  }
+
+  // Build a fresh generation over new values and publish it; the replacement
+  // for a stop-the-world rebuild
+  template <typename ExecutionSpace, typename UserValues,
+            typename SpaceFillingCurve = Morton64>
+  void rebuild(ExecutionSpace const &space, UserValues const &user_values,
+               SpaceFillingCurve const &curve = SpaceFillingCurve())
+  {
+    std::lock_guard<std::mutex> lock(_state->writer_mutex);
+    IndexableGetter const indexable_getter =
+        std::atomic_load(&_state->published)->indexable_get();
+    publish(space,
+            std::make_shared<bvh_type>(space, user_values, indexable_getter,
+                                       curve));
+  }
+
+  // The in-place mutators of BoundingVolumeHierarchy, each applied to a
+  // standby clone and published on completion
+
+  template <typename ExecutionSpace>
+  void update(ExecutionSpace const &space)
+  {
+    modifyAndPublish(space,
+                     [&space](bvh_type &tree) { tree.update(space); });
+  }
+
+  template <typename ExecutionSpace, typename Region,
+            typename SpaceFillingCurve = Morton64>
+  void partialRebuild(ExecutionSpace const &space, Region const &region,
+                      SpaceFillingCurve const &curve = SpaceFillingCurve())
+  {
+    modifyAndPublish(space, [&space, &region, &curve](bvh_type &tree) {
+      tree.partialRebuild(space, region, curve);
+    });
+  }
+
+  template <typename ExecutionSpace>
+  void optimize(ExecutionSpace const &space)
+  {
+    modifyAndPublish(space,
+                     [&space](bvh_type &tree) { tree.optimize(space); });
+  }
+
+  template <typename ExecutionSpace, typename Predicate>
+  size_type remove_if(ExecutionSpace const &space, Predicate const &predicate)
+  {
+    return modifyAndPublish(space, [&space, &predicate](bvh_type &tree) {
+      return tree.remove_if(space, predicate);
+    });
+  }
+
+  template <typename ExecutionSpace>
+  void compact(ExecutionSpace const &space)
+  {
+    modifyAndPublish(space,
+                     [&space](bvh_type &tree) { tree.compact(space); });
+  }
+
+private:
+  struct State
+  {
+    // Read with std::atomic_load, swung with std::atomic_store once a
+    // standby generation is complete; readers never take the mutex
+    std::shared_ptr<bvh_type const> published =
+        std::make_shared<bvh_type const>();
+    std::atomic<unsigned long long> epoch{0};
+    std::mutex writer_mutex;
+  };
+
+  template <typename ExecutionSpace, typename Modification>
+  auto modifyAndPublish(ExecutionSpace const &space,
+                        Modification const &modification)
+  {
+    std::lock_guard<std::mutex> lock(_state->writer_mutex);
+
+    auto standby =
+        std::make_shared<bvh_type>(*std::atomic_load(&_state->published));
+    // The copy above still shares the node arrays with the published
+    // generation; give the standby its own before mutating them
+    Details::HappyTreeFriends::detachNodeStorage(space, *standby);
+
+    if constexpr (std::is_void_v<
+                      std::invoke_result_t<Modification const &, bvh_type &>>)
+    {
+      modification(*standby);
+      publish(space, std::move(standby));
+    }
+    else
+    {
+      auto result = modification(*standby);
+      publish(space, std::move(standby));
+      return result;
+    }
+  }
+
+  template <typename ExecutionSpace>
+  void publish(ExecutionSpace const &space, std::shared_ptr<bvh_type> standby)
+  {
+    // The fence orders the standby's construction kernels before any query
+    // that observes the new pointer; without it a traversal enqueued on
+    // another execution space instance right after the swing could overtake
+    // them
+    space.fence("ArborX::VersionedBVH (standby generation ready)");
+    std::atomic_store(&_state->published,
+                      std::shared_ptr<bvh_type const>(std::move(standby)));
+    ++_state->epoch;
+  }
+
+  std::shared_ptr<State> _state;
+};
+
+} // namespace ArborX::Experimental
+
+#endif
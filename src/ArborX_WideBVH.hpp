@@ -0,0 +1,329 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_WIDE_BVH_HPP
+#define ARBORX_WIDE_BVH_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_Callbacks.hpp>
+#include <ArborX_DetailsHappyTreeFriends.hpp>
+#include <ArborX_DetailsKokkosExtAccessibilityTraits.hpp>
+#include <ArborX_IndexableGetter.hpp>
+#include <ArborX_LinearBVH.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+namespace ArborX::Experimental
+{
+
+// Wide bounding volume hierarchy with Arity children per node, collapsed from
+// the binary tree built by BoundingVolumeHierarchy. Each traversal step tests
+// the predicate against all children of a node at once, trading the rope-based
+// stackless traversal for shorter trees and more instruction-level
+// parallelism. Only spatial predicates are supported.
+template <typename MemorySpace, typename Value,
+          typename IndexableGetter = Details::DefaultIndexableGetter,
+          typename BoundingVolume = ExperimentalHyperGeometry::Box<
+              GeometryTraits::dimension_v<
+                  std::decay_t<std::invoke_result_t<IndexableGetter, Value>>>,
+              typename GeometryTraits::coordinate_type_t<
+                  std::decay_t<std::invoke_result_t<IndexableGetter, Value>>>>,
+          int Arity = 4>
+class WideBVH
+{
+public:
+  using memory_space = MemorySpace;
+  static_assert(Kokkos::is_memory_space<MemorySpace>::value);
+  using size_type = typename MemorySpace::size_type;
+  using bounding_volume_type = BoundingVolume;
+  using value_type = Value;
+
+  static_assert(Arity == 4 || Arity == 8);
+
+  WideBVH() = default; // build an empty tree
+
+  template <typename ExecutionSpace>
+  WideBVH(ExecutionSpace const &space,
+          BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter,
+                                  BoundingVolume> const &bvh);
+
+  KOKKOS_FUNCTION
+  size_type size() const noexcept { return _size; }
+
+  KOKKOS_FUNCTION
+  bool empty() const noexcept { return size() == 0; }
+
+  KOKKOS_FUNCTION
+  bounding_volume_type bounds() const noexcept { return _bounds; }
+
+  template <typename ExecutionSpace, typename Predicates, typename Callback>
+  void query(ExecutionSpace const &space, Predicates const &predicates,
+             Callback const &callback) const;
+
+private:
+  struct WideNode
+  {
+    // Children bounding volumes are stored in the parent so that a single
+    // traversal step loads and tests all of them together.
+    BoundingVolume bounding_volumes[Arity];
+    // Non-negative entries are wide node indices, negative entries are
+    // one's complement of the index into the values array.
+    int children[Arity];
+    int num_children = 0;
+  };
+
+  template <typename Predicates, typename Callback>
+  struct SpatialQuery
+  {
+    WideBVH _tree;
+    Predicates _predicates;
+    Callback _callback;
+
+    KOKKOS_FUNCTION void operator()(int query_index) const
+    {
+      auto const &predicate = _predicates(query_index);
+
+      int stack[64];
+      int stack_size = 0;
+      stack[stack_size++] = 0; // root
+      while (stack_size > 0)
+      {
+        auto const &node = _tree._nodes(stack[--stack_size]);
+        for (int j = 0; j < node.num_children; ++j)
+        {
+          int const child = node.children[j];
+          if (child < 0)
+          {
+            auto const &value = _tree._values(~child);
+            if (predicate(_tree._indexable_getter(value)) &&
+                Details::invoke_callback_and_check_early_exit(
+                    _callback, predicate, value))
+              return;
+          }
+          else if (predicate(node.bounding_volumes[j]))
+          {
+            stack[stack_size++] = child;
+          }
+        }
+      }
+    }
+  };
+
+  size_type _size{0};
+  bounding_volume_type _bounds;
+  Kokkos::View<WideNode *, MemorySpace> _nodes;
+  Kokkos::View<Value *, MemorySpace> _values;
+  IndexableGetter _indexable_getter;
+};
+
+template <typename MemorySpace, typename Value, typename IndexableGetter,
+          typename BoundingVolume, int Arity>
+template <typename ExecutionSpace>
+WideBVH<MemorySpace, Value, IndexableGetter, BoundingVolume, Arity>::WideBVH(
+    ExecutionSpace const &space,
+    BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter,
+                            BoundingVolume> const &bvh)
+    : _size(bvh.size())
+    , _bounds(bvh.bounds())
+    , _nodes(Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                                "ArborX::WideBVH::nodes"),
+             _size > 1 ? _size - 1 : 0)
+    , _values(Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                                 "ArborX::WideBVH::values"),
+              _size)
+    , _indexable_getter(bvh.indexable_get())
+{
+  static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
+                                                       ExecutionSpace>::value);
+
+  Kokkos::Profiling::ScopedRegion guard("ArborX::WideBVH::WideBVH");
+
+  if (empty())
+  {
+    return;
+  }
+
+  if (_size == 1 && bvh.numRemoved() > 0)
+  {
+    // The only leaf is tombstoned, so the collapsed tree holds nothing
+    _size = 0;
+    return;
+  }
+
+  int const n = _size;
+  auto values = _values;
+  Kokkos::parallel_for(
+      "ArborX::WideBVH::WideBVH::copy_values",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        values(i) = Details::HappyTreeFriends::getValue(bvh, i);
+      });
+
+  if (_size == 1)
+  {
+    return;
+  }
+
+  auto nodes = _nodes;
+
+  // Collapse the binary tree top-down, one level of the wide tree at a time.
+  // Each frontier entry pairs a binary node with the wide node slot it was
+  // assigned; processing an entry greedily expands binary nodes breadth-first
+  // until the wide node is full, emitting unexpanded internal descendants
+  // into the next frontier.
+  Kokkos::View<int, MemorySpace> counter("ArborX::WideBVH::WideBVH::counter");
+  Kokkos::deep_copy(space, counter, 1);
+
+  using FrontierEntry = Kokkos::pair<int, int>;
+  Kokkos::View<FrontierEntry *, MemorySpace> frontier(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::WideBVH::WideBVH::frontier"),
+      1);
+  Kokkos::parallel_for(
+      "ArborX::WideBVH::WideBVH::initialize_frontier",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, 1), KOKKOS_LAMBDA(int) {
+        frontier(0) = {Details::HappyTreeFriends::getRoot(bvh), 0};
+      });
+
+  int frontier_size = 1;
+  while (frontier_size > 0)
+  {
+    Kokkos::View<FrontierEntry *, MemorySpace> next_frontier(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::WideBVH::WideBVH::next_frontier"),
+        frontier_size * Arity);
+    Kokkos::View<int, MemorySpace> next_frontier_size(
+        Kokkos::view_alloc(space, "ArborX::WideBVH::WideBVH::next_size"));
+
+    Kokkos::parallel_for(
+        "ArborX::WideBVH::WideBVH::collapse_level",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, frontier_size),
+        KOKKOS_LAMBDA(int f) {
+          using Details::HappyTreeFriends;
+
+          int slots[Arity];
+          int count = 1;
+          slots[0] = frontier(f).first;
+
+          while (count < Arity)
+          {
+            int expand_pos = -1;
+            for (int j = 0; j < count; ++j)
+              if (!HappyTreeFriends::isLeaf(bvh, slots[j]))
+              {
+                expand_pos = j;
+                break;
+              }
+            if (expand_pos == -1)
+              break;
+            int const expanded = slots[expand_pos];
+            slots[expand_pos] = HappyTreeFriends::getLeftChild(bvh, expanded);
+            slots[count++] = HappyTreeFriends::getRightChild(bvh, expanded);
+          }
+
+          WideNode node;
+          int num_children = 0;
+          for (int j = 0; j < count; ++j)
+          {
+            int const binary_child = slots[j];
+            BoundingVolume bounding_volume{};
+            if (HappyTreeFriends::isLeaf(bvh, binary_child))
+            {
+              // Leaves tombstoned by remove_if() are dropped during the
+              // collapse instead of resurfacing in the wide tree
+              if (!HappyTreeFriends::isLive(bvh, binary_child))
+                continue;
+              using Details::expand;
+              expand(bounding_volume,
+                     HappyTreeFriends::getIndexable(bvh, binary_child));
+              node.children[num_children] = ~binary_child;
+            }
+            else
+            {
+              bounding_volume = HappyTreeFriends::getInternalBoundingVolume(
+                  bvh, binary_child);
+              int const wide_child = Kokkos::atomic_fetch_add(&counter(), 1);
+              node.children[num_children] = wide_child;
+              int const pos =
+                  Kokkos::atomic_fetch_add(&next_frontier_size(), 1);
+              next_frontier(pos) = {binary_child, wide_child};
+            }
+            node.bounding_volumes[num_children] = bounding_volume;
+            ++num_children;
+          }
+          node.num_children = num_children;
+          nodes(frontier(f).second) = node;
+        });
+
+    Kokkos::deep_copy(frontier_size, next_frontier_size);
+    frontier = next_frontier;
+  }
+
+  int num_nodes;
+  Kokkos::deep_copy(num_nodes, counter);
+  Kokkos::resize(Kokkos::view_alloc(space), _nodes, num_nodes);
+}
+
+template <typename MemorySpace, typename Value, typename IndexableGetter,
+          typename BoundingVolume, int Arity>
+template <typename ExecutionSpace, typename UserPredicates, typename Callback>
+void WideBVH<MemorySpace, Value, IndexableGetter, BoundingVolume,
+             Arity>::query(ExecutionSpace const &space,
+                           UserPredicates const &user_predicates,
+                           Callback const &callback) const
+{
+  static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
+                                                       ExecutionSpace>::value);
+  Details::check_valid_access_traits(PredicatesTag{}, user_predicates);
+  Details::check_valid_callback<value_type>(callback, user_predicates);
+
+  using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+  static_assert(
+      Details::KokkosExt::is_accessible_from<typename Predicates::memory_space,
+                                             ExecutionSpace>::value,
+      "Predicates must be accessible from the execution space");
+  Predicates predicates{user_predicates}; // NOLINT
+
+  using Tag = typename Predicates::value_type::Tag;
+  static_assert(std::is_same_v<Tag, Details::SpatialPredicateTag>,
+                "WideBVH only supports spatial predicates");
+
+  Kokkos::Profiling::ScopedRegion guard("ArborX::WideBVH::query::spatial");
+
+  if (empty())
+  {
+    return;
+  }
+
+  if (size() == 1)
+  {
+    auto values = _values;
+    auto indexable_getter = _indexable_getter;
+    Kokkos::parallel_for(
+        "ArborX::WideBVH::query::spatial::degenerated_one_leaf_tree",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, predicates.size()),
+        KOKKOS_LAMBDA(int i) {
+          auto const &predicate = predicates(i);
+          if (predicate(indexable_getter(values(0))))
+            callback(predicate, values(0));
+        });
+    return;
+  }
+
+  Kokkos::parallel_for(
+      "ArborX::WideBVH::query::spatial",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, predicates.size()),
+      SpatialQuery<Predicates, Callback>{*this, predicates, callback});
+}
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -20,6 +20,9 @@ namespace ArborX
 
 namespace Experimental
 {
+// Note: when the index is only needed at callback time, building the tree
+// over ImplicitIndex<Value> (see ArborX_PairValueIndex.hpp) avoids storing
+// it in every leaf altogether
 template <typename Values, typename Index>
 struct AttachIndices
 {
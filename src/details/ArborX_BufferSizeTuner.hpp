@@ -0,0 +1,100 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#ifndef ARBORX_BUFFER_SIZE_TUNER_HPP
+#define ARBORX_BUFFER_SIZE_TUNER_HPP
+
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_TraversalPolicy.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <utility>
+
+namespace ArborX::Experimental
+{
+
+// Auto-tunes the TraversalPolicy buffer size across repeated query() calls of
+// the same shape. The first call runs the usual count-then-fill two-pass
+// algorithm; subsequent calls preallocate a soft buffer derived from the
+// observed per-query result counts, which avoids the second traversal as long
+// as the counts stay within the learned bound. The buffer is kept soft so a
+// workload shift only costs an occasional second pass, never correctness.
+//
+// Typical use with an iterative solver calling the same query repeatedly:
+//
+//   Experimental::BufferSizeTuner tuner;
+//   for (int step = 0; step < n_steps; ++step)
+//     tuner.query(tree, space, predicates, values, offset);
+class BufferSizeTuner
+{
+public:
+  TraversalPolicy policy() const
+  {
+    return TraversalPolicy().setBufferSize(_buffer_size);
+  }
+
+  // Record the exact per-query result counts of a finished query
+  template <typename ExecutionSpace, typename OffsetView>
+  void update(ExecutionSpace const &space, OffsetView const &offset)
+  {
+    int const n_queries = offset.extent_int(0) - 1;
+    if (n_queries <= 0)
+      return;
+
+    int max_count;
+    Kokkos::parallel_reduce(
+        "ArborX::BufferSizeTuner::max_count",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+        KOKKOS_LAMBDA(int i, int &update) {
+          int const count = offset(i + 1) - offset(i);
+          if (count > update)
+            update = count;
+        },
+        Kokkos::Max<int>(max_count));
+
+    auto const n_results = Details::KokkosExt::lastElement(space, offset);
+    float const mean = (float)n_results / n_queries;
+
+    // Aim between the mean and the max: the max guarantees a single pass but
+    // can over-allocate wildly for skewed distributions, so cap the headroom
+    // over the mean
+    int target = max_count;
+    int const capped = (int)(2 * mean) + 8;
+    if (capped < target)
+      target = capped;
+
+    // Move slowly downward but jump immediately upward so that an
+    // underestimate does not cause second passes for several iterations
+    if (_buffer_size == 0 || target > _buffer_size)
+      _buffer_size = target;
+    else
+      _buffer_size = (3 * _buffer_size + target) / 4;
+  }
+
+  // Convenience wrapper running the query with the current buffer size and
+  // updating the estimate from its results
+  template <typename Tree, typename ExecutionSpace, typename Predicates,
+            typename Values, typename Offset>
+  void query(Tree const &tree, ExecutionSpace const &space,
+             Predicates const &predicates, Values &&values, Offset &offset)
+  {
+    tree.query(space, predicates, std::forward<Values>(values), offset,
+               policy());
+    update(space, offset);
+  }
+
+private:
+  int _buffer_size = 0;
+};
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -72,7 +72,7 @@ struct Dendrogram
 
     using ConstEdges =
         Kokkos::View<Details::UnweightedEdge const *, MemorySpace>;
-    Details::dendrogramUnionFind(exec_space, ConstEdges(unweighted_edges),
+    Details::dendrogramAlphaTree(exec_space, ConstEdges(unweighted_edges),
                                  _parents);
 
     Kokkos::Profiling::popRegion();
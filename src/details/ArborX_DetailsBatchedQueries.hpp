@@ -16,6 +16,8 @@
 #include <ArborX_DetailsAlgorithms.hpp> // returnCentroid, translateAndScale
 #include <ArborX_DetailsSortUtils.hpp>  // sortObjects
 #include <ArborX_HyperBox.hpp>
+#include <ArborX_PredicateSortingCache.hpp>
+#include <ArborX_Predicates.hpp>
 #include <ArborX_SpaceFillingCurves.hpp>
 
 #include <Kokkos_Core.hpp>
@@ -52,23 +54,134 @@ public:
   {
     auto const n_queries = predicates.size();
 
-    using Point =
-        std::decay_t<decltype(returnCentroid(getGeometry(predicates(0))))>;
+    using Geometry = std::decay_t<decltype(getGeometry(predicates(0)))>;
+    using Point = std::decay_t<decltype(returnCentroid(
+        getGeometry(predicates(0))))>;
     using LinearOrderingValueType =
         std::invoke_result_t<SpaceFillingCurve, Box, Point>;
-    Kokkos::View<LinearOrderingValueType *, DeviceType> linear_ordering_indices(
-        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
-                           "ArborX::BVH::query::linear_ordering"),
-        n_queries);
-    Kokkos::parallel_for(
-        "ArborX::BatchedQueries::project_predicates_onto_space_filling_curve",
-        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
-        KOKKOS_LAMBDA(int i) {
-          linear_ordering_indices(i) = curve(
-              scene_bounding_box, returnCentroid(getGeometry(predicates(i))));
-        });
-
-    return sortObjects(space, linear_ordering_indices);
+
+    if constexpr (GeometryTraits::is_ray_v<Geometry> &&
+                  sizeof(LinearOrderingValueType) < sizeof(unsigned long long))
+    {
+      // Incoherent rays are bucketed by the octant of their direction before
+      // being ordered by the cell of their origin on the space-filling curve.
+      // Rays in a batch then walk the tree in a similar order, which the
+      // origin alone does not provide.
+      Kokkos::View<unsigned long long *, DeviceType> keys(
+          Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                             "ArborX::BVH::query::linear_ordering"),
+          n_queries);
+      Kokkos::parallel_for(
+          "ArborX::BatchedQueries::project_rays_onto_space_filling_curve",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+          KOKKOS_LAMBDA(int i) {
+            auto const &ray = getGeometry(predicates(i));
+            auto const &dir = ray.direction();
+            unsigned long long const octant = (dir[0] < 0) +
+                                              ((dir[1] < 0) << 1) +
+                                              ((dir[2] < 0) << 2);
+            keys(i) =
+                (octant << (8 * sizeof(LinearOrderingValueType))) +
+                (unsigned long long)curve(scene_bounding_box, ray.origin());
+          });
+
+      return sortObjects(space, keys);
+    }
+    else if constexpr (sizeof(LinearOrderingValueType) <
+                       sizeof(unsigned long long))
+    {
+      // Mixed-cost batches put cheap and expensive predicates in the same
+      // warp, and the cheap ones idle until the expensive ones finish.
+      // Bucket the predicates by the exponent of their estimated traversal
+      // cost -- the geometry extent for spatial predicates, k for k-limited
+      // ones -- before ordering by the space-filling curve, so that threads
+      // scheduled together traverse similar amounts of the tree. A uniform
+      // batch falls into a single bucket and keeps its plain ordering.
+      Kokkos::View<unsigned long long *, DeviceType> keys(
+          Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                             "ArborX::BVH::query::linear_ordering"),
+          n_queries);
+      Kokkos::parallel_for(
+          "ArborX::BatchedQueries::bucket_predicates_by_cost",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+          KOKKOS_LAMBDA(int i) {
+            auto const &predicate = predicates(i);
+            auto const &geometry = getGeometry(predicate);
+
+            float cost;
+            if constexpr (Kokkos::is_detected_v<
+                              PredicateGetKArchetypeExpression,
+                              std::decay_t<decltype(predicate)>>)
+            {
+              cost = getK(predicate);
+            }
+            else
+            {
+              Box bounds{};
+              expand(bounds, geometry);
+              cost = 0;
+              for (int d = 0; d < GeometryTraits::dimension_v<Box>; ++d)
+                cost = Kokkos::max(cost, bounds.maxCorner()[d] -
+                                             bounds.minCorner()[d]);
+            }
+            // Exponent buckets: predicates within a bucket differ in cost by
+            // at most a factor of two
+            unsigned long long const bucket =
+                (cost > 0
+                     ? (unsigned long long)Kokkos::min(
+                           255,
+                           Kokkos::max(
+                               0, 128 + (int)Kokkos::floor(Kokkos::log2(cost))))
+                     : 0);
+            keys(i) = (bucket << (8 * sizeof(LinearOrderingValueType))) +
+                      (unsigned long long)curve(scene_bounding_box,
+                                                returnCentroid(geometry));
+          });
+
+      return sortObjects(space, keys);
+    }
+    else
+    {
+      Kokkos::View<LinearOrderingValueType *, DeviceType>
+          linear_ordering_indices(
+              Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                                 "ArborX::BVH::query::linear_ordering"),
+              n_queries);
+      Kokkos::parallel_for(
+          "ArborX::BatchedQueries::project_predicates_onto_space_filling_"
+          "curve",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+          KOKKOS_LAMBDA(int i) {
+            linear_ordering_indices(i) = curve(
+                scene_bounding_box, returnCentroid(getGeometry(predicates(i))));
+          });
+
+      return sortObjects(space, linear_ordering_indices);
+    }
+  }
+
+  // Consult the user-provided sorting cache (type-erased in the traversal
+  // policy) before recomputing the permutation, and fill it on a miss. A null
+  // handle degenerates to an unconditional recomputation.
+  template <typename ExecutionSpace, typename Predicates, typename Box,
+            typename SpaceFillingCurve>
+  static Kokkos::View<unsigned int *, DeviceType>
+  getOrComputePermutation(ExecutionSpace const &space,
+                          SpaceFillingCurve const &curve,
+                          Box const &scene_bounding_box,
+                          Predicates const &predicates, void *cache_handle)
+  {
+    auto *cache =
+        static_cast<Experimental::PredicateSortingCache<DeviceType> *>(
+            cache_handle);
+    if (cache != nullptr && cache->_permute.size() == predicates.size())
+      return cache->_permute;
+
+    auto permute = sortPredicatesAlongSpaceFillingCurve(
+        space, curve, scene_bounding_box, predicates);
+    if (cache != nullptr)
+      cache->_permute = permute;
+    return permute;
   }
 
   // NOTE  trailing return type seems required :(
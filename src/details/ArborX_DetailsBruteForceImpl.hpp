@@ -12,13 +12,17 @@
 #ifndef ARBORX_DETAILS_BRUTE_FORCE_IMPL_HPP
 #define ARBORX_DETAILS_BRUTE_FORCE_IMPL_HPP
 
+#include <ArborX_Callbacks.hpp>
 #include <ArborX_DetailsAlgorithms.hpp> // expand
+#include <ArborX_DetailsBatchedAlgorithms.hpp>
 #include <ArborX_DetailsKokkosExtMinMaxOperations.hpp>
 #include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
 #include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DetailsLaunchTuner.hpp>
 #include <ArborX_DetailsNearestBufferProvider.hpp>
 #include <ArborX_DetailsPriorityQueue.hpp>
 #include <ArborX_Exception.hpp>
+#include <ArborX_GeometryTraits.hpp>
 #include <ArborX_Predicates.hpp>
 
 #include <Kokkos_Core.hpp>
@@ -80,6 +84,21 @@ struct BruteForceImpl
 
     int const n_indexables = values.size();
     int const n_predicates = predicates.size();
+
+    // Honor CallbackTreeTraversalControl the same way the tree traversal
+    // does. Unlike in the tree traversal, a predicate is processed by many
+    // threads concurrently, so termination is best effort: a per-predicate
+    // flag raised on early exit makes the remaining tiles skip the predicate,
+    // but a few extra callback invocations may race with raising the flag.
+    constexpr bool can_early_exit = std::is_same_v<
+        CallbackTreeTraversalControl,
+        std::invoke_result_t<Callback const &, PredicateType const &,
+                             typename Values::value_type const &>>;
+    using MemorySpace = typename Values::memory_space;
+    Kokkos::View<bool *, MemorySpace> done(
+        Kokkos::view_alloc(space, "ArborX::BruteForce::query::spatial::done"),
+        can_early_exit ? n_predicates : 0);
+
     int max_scratch_size = TeamPolicy::scratch_size_max(0);
     // half of the scratch memory used by predicates and half for indexables
     int const predicates_per_team =
@@ -106,11 +125,7 @@ struct BruteForceImpl
     int scratch_size = ScratchPredicateType::shmem_size(predicates_per_team) +
                        ScratchIndexableType::shmem_size(indexables_per_team);
 
-    Kokkos::parallel_for(
-        "ArborX::BruteForce::query::spatial::"
-        "check_all_predicates_against_all_indexables",
-        TeamPolicy(space, n_teams, Kokkos::AUTO, 1)
-            .set_scratch_size(0, Kokkos::PerTeam(scratch_size)),
+    auto kernel =
         KOKKOS_LAMBDA(typename TeamPolicy::member_type const &teamMember) {
           // select the tiles of predicates/indexables checked by each team
           int predicate_start = predicates_per_team *
@@ -150,15 +165,181 @@ struct BruteForceImpl
                     [&](const int q) {
                       auto const &predicate = scratch_predicates(q);
                       auto const &indexable = scratch_indexables(j);
-                      if (predicate(indexable))
+                      if constexpr (can_early_exit)
+                        if (Kokkos::atomic_load(&done(predicate_start + q)))
+                          return;
+                      if (predicate(indexable) &&
+                          invoke_callback_and_check_early_exit(
+                              callback, predicate, values(indexable_start + j)))
                       {
-                        callback(predicate, values(indexable_start + j));
+                        if constexpr (can_early_exit)
+                          Kokkos::atomic_store(&done(predicate_start + q),
+                                               true);
                       }
                     });
               });
-        });
+        };
+
+    // The tile sizes are fixed by the scratch capacity, so the team size
+    // only affects occupancy and is safe to sweep
+    LaunchTuner::teamParallelFor(
+        "ArborX::BruteForce::query::spatial::"
+        "check_all_predicates_against_all_indexables",
+        space, n_teams, scratch_size, kernel);
   }
 
+  // Team-cooperative top-k engine for small batches of nearest predicates:
+  // each team owns one predicate, its threads collect private candidate
+  // lists over a strided partition of the primitive range, and k team
+  // reductions merge the lists in ascending distance order. Returns false
+  // when the candidate lists do not fit in scratch memory and the caller has
+  // to fall back to the one-thread-per-predicate kernel.
+  template <class ExecutionSpace, class Predicates, class Values,
+            class Indexables, class Callback>
+  static bool queryNearestTeamCooperative(ExecutionSpace const &space,
+                                          Predicates const &predicates,
+                                          Values const &values,
+                                          Indexables const &indexables,
+                                          Callback const &callback)
+  {
+    using TeamPolicy = Kokkos::TeamPolicy<ExecutionSpace>;
+    using PairIndexDistance = Kokkos::pair<int, float>;
+    using ScratchCandidates =
+        Kokkos::View<PairIndexDistance *,
+                     typename ExecutionSpace::scratch_memory_space,
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+
+    int const n_indexables = values.size();
+    int const n_predicates = predicates.size();
+
+    int max_k = 0;
+    Kokkos::parallel_reduce(
+        "ArborX::BruteForce::query::nearest::reduce_max_k",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_predicates),
+        KOKKOS_LAMBDA(int i, int &update) {
+          update = KokkosExt::max(update, getK(predicates(i)));
+        },
+        Kokkos::Max<int>(max_k));
+    if (max_k == 0)
+      return true;
+
+    auto kernel =
+        KOKKOS_LAMBDA(typename TeamPolicy::member_type const &teamMember)
+    {
+      int const i = teamMember.league_rank();
+      auto const &predicate = predicates(i);
+      int const k = getK(predicate);
+      if (k == 0)
+        return;
+
+      int const team_size = teamMember.team_size();
+      int const team_rank = teamMember.team_rank();
+
+      struct CompareDistance
+      {
+        KOKKOS_INLINE_FUNCTION bool
+        operator()(PairIndexDistance const &lhs,
+                   PairIndexDistance const &rhs) const
+        {
+          return lhs.second < rhs.second;
+        }
+      };
+
+      ScratchCandidates candidates(teamMember.team_scratch(0),
+                                   team_size * max_k);
+      auto *const candidates_data = &candidates(team_rank * max_k);
+
+      PriorityQueue<PairIndexDistance, CompareDistance,
+                    UnmanagedStaticVector<PairIndexDistance>>
+          heap(UnmanagedStaticVector<PairIndexDistance>(candidates_data, k));
+
+      constexpr auto inf = KokkosExt::ArithmeticTraits::infinity<float>::value;
+      auto radius = inf;
+      // Strided partition: consecutive threads touch consecutive primitives,
+      // so the loads coalesce
+      for (int j = team_rank; j < n_indexables; j += team_size)
+      {
+        auto const d = distance(getGeometry(predicate), indexables(j));
+        if ((int)heap.size() < k)
+        {
+          heap.push(Kokkos::make_pair(j, d));
+          if ((int)heap.size() == k)
+            radius = heap.top().second;
+        }
+        else if (d < radius)
+        {
+          heap.popPush(Kokkos::make_pair(j, d));
+          radius = heap.top().second;
+        }
+      }
+
+      // Ascending order, so the merge can consume each list front to back
+      sortHeap(heap.data(), heap.data() + heap.size(), heap.valueComp());
+      int const count = (int)heap.size();
+      int cursor = 0;
+
+      // k-round tournament: each round a team reduction (warp shuffles on
+      // GPU backends) picks the globally closest remaining candidate, and
+      // the thread holding it reports it before the next round starts
+      for (int round = 0; round < k; ++round)
+      {
+        Kokkos::MinLoc<float, int>::value_type head;
+        head.val = (cursor < count ? candidates_data[cursor].second : inf);
+        head.loc = team_rank;
+        teamMember.team_reduce(Kokkos::MinLoc<float, int>(head));
+        if (head.val == inf)
+          break; // fewer than k primitives in the scene
+        if (head.loc == team_rank)
+          callback(predicate, values(candidates_data[cursor++].first));
+      }
+    };
+
+    int const max_scratch_size = TeamPolicy::scratch_size_max(0);
+
+    TeamPolicy dummy_policy(space, 1, Kokkos::AUTO);
+    int team_size =
+        dummy_policy.team_size_recommended(kernel, Kokkos::ParallelForTag{});
+    if (team_size == 0)
+      team_size = 1;
+    // Shrink the team until every thread's candidate list fits in scratch
+    while (team_size > 1 &&
+           (int)ScratchCandidates::shmem_size(team_size * max_k) >
+               max_scratch_size)
+      team_size /= 2;
+    int const scratch_size =
+        (int)ScratchCandidates::shmem_size(team_size * max_k);
+    if (scratch_size > max_scratch_size)
+      return false;
+
+    Kokkos::parallel_for(
+        "ArborX::BruteForce::query::nearest::"
+        "team_cooperative_top_k",
+        TeamPolicy(space, n_predicates, team_size)
+            .set_scratch_size(0, Kokkos::PerTeam(scratch_size)),
+        kernel);
+    return true;
+  }
+
+  // Whether a batch of nearest predicates against the given primitives can
+  // be screened through the Gram identity: both sides must be points of the
+  // same dimension with single-precision coordinates
+  template <class Geometry, class Indexable, class Enable = void>
+  struct CanUseGramScreen : std::false_type
+  {};
+  template <class Geometry, class Indexable>
+  struct CanUseGramScreen<
+      Geometry, Indexable,
+      std::enable_if_t<GeometryTraits::is_point_v<Geometry> &&
+                       GeometryTraits::is_point_v<Indexable>>>
+      : std::bool_constant<
+            GeometryTraits::dimension_v<Geometry> ==
+                GeometryTraits::dimension_v<Indexable> &&
+            std::is_same_v<GeometryTraits::coordinate_type_t<Geometry>,
+                           float> &&
+            std::is_same_v<GeometryTraits::coordinate_type_t<Indexable>,
+                           float>>
+  {};
+
   template <class ExecutionSpace, class Predicates, class Values,
             class Indexables, class Callback>
   static void query(NearestPredicateTag, ExecutionSpace const &space,
@@ -168,67 +349,240 @@ struct BruteForceImpl
     Kokkos::Profiling::ScopedRegion guard("ArborX::BruteForce::query::nearest");
 
     using MemorySpace = typename Values::memory_space;
+    using TeamPolicy = Kokkos::TeamPolicy<ExecutionSpace>;
+    using IndexableType = std::decay_t<decltype(indexables(0))>;
+    using GeometryType = std::decay_t<decltype(getGeometry(
+        std::declval<typename Predicates::value_type const &>()))>;
 
     int const n_indexables = values.size();
     int const n_predicates = predicates.size();
 
+    // One thread per predicate cannot fill the device when the batch of
+    // queries is small; hand each of those predicates to a whole team that
+    // splits the primitive range between its threads and merges the
+    // per-thread candidates with team reductions
+    if (n_predicates > 0 && n_predicates < space.concurrency() / 2 &&
+        queryNearestTeamCooperative(space, predicates, values, indexables,
+                                    callback))
+      return;
+
     NearestBufferProvider<MemorySpace> buffer_provider(space, predicates);
 
-    Kokkos::parallel_for(
-        "ArborX::BruteForce::query::nearest::"
-        "check_all_predicates_against_all_indexables",
-        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_predicates),
-        KOKKOS_LAMBDA(int i) {
-          auto const &predicate = predicates(i);
-          auto const k = getK(predicate);
-          auto const buffer = buffer_provider(i);
+    // For point clouds, the staged tiles double as distance-matrix tiles:
+    // primitive squared norms are computed once up front, the per-tile
+    // arithmetic reduces to dot products through the Gram identity, and only
+    // primitives whose screened distance beats the current radius get the
+    // exactness-critical direct fp32 distance computation
+    constexpr bool use_gram_screen =
+        CanUseGramScreen<GeometryType, IndexableType>::value;
+    Kokkos::View<float *, MemorySpace> norms(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::BruteForce::query::nearest::primitive_norms"),
+        use_gram_screen ? n_indexables : 0);
+    if constexpr (use_gram_screen)
+    {
+      Kokkos::parallel_for(
+          "ArborX::BruteForce::query::nearest::compute_primitive_norms",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_indexables),
+          KOKKOS_LAMBDA(int j) {
+            auto const &primitive = indexables(j);
+            float norm2 = 0;
+            for (int d = 0; d < GeometryTraits::dimension_v<IndexableType>;
+                 ++d)
+              norm2 += primitive[d] * primitive[d];
+            norms(j) = norm2;
+          });
+    }
 
-          if (k < 1)
-            return;
+    using ScratchIndexableType =
+        Kokkos::View<IndexableType *,
+                     typename ExecutionSpace::scratch_memory_space,
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+    using ScratchNormType =
+        Kokkos::View<float *, typename ExecutionSpace::scratch_memory_space,
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+    // Each thread owns one predicate, so unlike the spatial kernel the whole
+    // scratch space is used for staging indexables (and their norms when
+    // screening)
+    int const max_scratch_size = TeamPolicy::scratch_size_max(0);
+    int const scratch_capacity =
+        max_scratch_size / ((int)sizeof(IndexableType) +
+                            (use_gram_screen ? (int)sizeof(float) : 0));
+    ARBORX_ASSERT(scratch_capacity > 0);
+    int const indexables_per_team =
+        KokkosExt::min(scratch_capacity, KokkosExt::max(n_indexables, 1));
+    int const scratch_size =
+        ScratchIndexableType::shmem_size(indexables_per_team) +
+        (use_gram_screen ? (int)ScratchNormType::shmem_size(indexables_per_team)
+                         : 0);
 
-          using PairIndexDistance =
-              typename NearestBufferProvider<MemorySpace>::PairIndexDistance;
-          struct CompareDistance
-          {
-            KOKKOS_INLINE_FUNCTION bool
-            operator()(PairIndexDistance const &lhs,
-                       PairIndexDistance const &rhs) const
-            {
-              return lhs.second < rhs.second;
-            }
-          };
+    auto kernel =
+        KOKKOS_LAMBDA(typename TeamPolicy::member_type const &teamMember)
+    {
+      ScratchIndexableType scratch_indexables(teamMember.team_scratch(0),
+                                              indexables_per_team);
+      ScratchNormType scratch_norms(
+          teamMember.team_scratch(0),
+          use_gram_screen ? indexables_per_team : 0);
 
-          PriorityQueue<PairIndexDistance, CompareDistance,
-                        UnmanagedStaticVector<PairIndexDistance>>
-              heap(UnmanagedStaticVector<PairIndexDistance>(buffer.data(),
-                                                            buffer.size()));
+      int const i =
+          teamMember.league_rank() * teamMember.team_size() +
+          teamMember.team_rank();
 
-          // Nodes with a distance that exceed that radius can safely be
-          // discarded. Initialize the radius to infinity and tighten it once k
-          // neighbors have been found.
-          auto radius = KokkosExt::ArithmeticTraits::infinity<float>::value;
+      using PairIndexDistance =
+          typename NearestBufferProvider<MemorySpace>::PairIndexDistance;
+      struct CompareDistance
+      {
+        KOKKOS_INLINE_FUNCTION bool operator()(PairIndexDistance const &lhs,
+                                               PairIndexDistance const &rhs) const
+        {
+          return lhs.second < rhs.second;
+        }
+      };
 
-          int j = 0;
-          for (; j < n_indexables && j < k; ++j)
-          {
-            auto const distance = predicate.distance(indexables(j));
-            heap.push(Kokkos::make_pair(j, distance));
-          }
-          for (; j < n_indexables; ++j)
+      // Threads past the end of the predicate range (or with nothing to
+      // collect) still participate in the staging and the barriers
+      int k = 0;
+      PairIndexDistance *buffer_data = nullptr;
+      std::size_t buffer_size = 0;
+      if (i < n_predicates)
+      {
+        k = getK(predicates(i));
+        auto const buffer = buffer_provider(i);
+        buffer_data = buffer.data();
+        buffer_size = buffer.size();
+      }
+      bool const active = (k > 0);
+
+      PriorityQueue<PairIndexDistance, CompareDistance,
+                    UnmanagedStaticVector<PairIndexDistance>>
+          heap(UnmanagedStaticVector<PairIndexDistance>(buffer_data,
+                                                        buffer_size));
+
+      // Nodes with a distance that exceed that radius can safely be
+      // discarded. Initialize the radius to infinity and tighten it once k
+      // neighbors have been found.
+      auto radius = KokkosExt::ArithmeticTraits::infinity<float>::value;
+
+      [[maybe_unused]] float query_norm2 = 0;
+      if constexpr (use_gram_screen)
+      {
+        if (active)
+        {
+          auto const &query_point = getGeometry(predicates(i));
+          for (int d = 0; d < GeometryTraits::dimension_v<GeometryType>; ++d)
+            query_norm2 += query_point[d] * query_point[d];
+        }
+      }
+
+      // GEMM-style blocking: the team stages a tile of indexables in scratch
+      // once, and every thread scans it for its own predicate
+      for (int tile_start = 0; tile_start < n_indexables;
+           tile_start += indexables_per_team)
+      {
+        int const tile_size =
+            KokkosExt::min(indexables_per_team, n_indexables - tile_start);
+
+        Kokkos::parallel_for(
+            Kokkos::TeamVectorRange(teamMember, tile_size), [&](const int j) {
+              scratch_indexables(j) = indexables(tile_start + j);
+              if constexpr (use_gram_screen)
+                scratch_norms(j) = norms(tile_start + j);
+            });
+        teamMember.team_barrier();
+
+        if (active)
+        {
+          auto const &predicate = predicates(i);
+          // Compute the distances for a whole batch before touching the
+          // heap: separated from the data-dependent heap updates, the
+          // distance arithmetic is branch-free and vectorizes on host
+          // backends
+          float distances[Batched::batch_size];
+          for (int batch_start = 0; batch_start < tile_size;
+               batch_start += Batched::batch_size)
           {
-            auto const distance = predicate.distance(indexables(j));
-            if (distance < radius)
+            int const batch_end =
+                KokkosExt::min(batch_start + Batched::batch_size, tile_size);
+            if constexpr (use_gram_screen)
+            {
+              constexpr int DIM = GeometryTraits::dimension_v<GeometryType>;
+              constexpr float eps =
+                  KokkosExt::ArithmeticTraits::epsilon<float>::value;
+              Batched::distanceSquaredGram(getGeometry(predicate), query_norm2,
+                                           scratch_indexables, scratch_norms,
+                                           batch_start, batch_end, distances);
+              for (int j = batch_start; j < batch_end; ++j)
+              {
+                // The slack absorbs the cancellation error of the Gram form,
+                // so the screen never rejects a true neighbor
+                float const slack =
+                    4 * DIM * eps * (query_norm2 + scratch_norms(j));
+                if (distances[j - batch_start] > radius * radius + slack)
+                  continue;
+                auto const distance = Details::distance(
+                    getGeometry(predicate), scratch_indexables(j));
+                if ((int)heap.size() < k)
+                {
+                  heap.push(Kokkos::make_pair(tile_start + j, distance));
+                  if ((int)heap.size() == k)
+                    radius = heap.top().second;
+                }
+                else if (distance < radius)
+                {
+                  heap.popPush(Kokkos::make_pair(tile_start + j, distance));
+                  radius = heap.top().second;
+                }
+              }
+              continue;
+            }
+            Batched::distance(getGeometry(predicate), scratch_indexables,
+                              batch_start, batch_end, distances);
+            for (int j = batch_start; j < batch_end; ++j)
             {
-              heap.popPush(Kokkos::make_pair(j, distance));
-              radius = heap.top().second;
+              auto const distance = distances[j - batch_start];
+              if ((int)heap.size() < k)
+              {
+                heap.push(Kokkos::make_pair(tile_start + j, distance));
+                if ((int)heap.size() == k)
+                  radius = heap.top().second;
+              }
+              else if (distance < radius)
+              {
+                heap.popPush(Kokkos::make_pair(tile_start + j, distance));
+                radius = heap.top().second;
+              }
             }
           }
+        }
+        teamMember.team_barrier();
+      }
+
+      if (active)
+      {
+        auto const &predicate = predicates(i);
+        // Match TreeTraversal: results are reported closest first
+        sortHeap(heap.data(), heap.data() + heap.size(), heap.valueComp());
+        for (decltype(heap.size()) q = 0; q < heap.size(); ++q)
+          callback(predicate, values((heap.data() + q)->first));
+      }
+    };
+
+    TeamPolicy dummy_policy(space, 1, Kokkos::AUTO);
+    dummy_policy.set_scratch_size(0, Kokkos::PerTeam(scratch_size));
+    int team_size =
+        dummy_policy.team_size_recommended(kernel, Kokkos::ParallelForTag{});
+    if (team_size == 0)
+      team_size = 1;
+    int const n_teams = (n_predicates + team_size - 1) / team_size;
 
-          // Match the logic in TreeTraversal and do the sorting
-          sortHeap(heap.data(), heap.data() + heap.size(), heap.valueComp());
-          for (decltype(heap.size()) i = 0; i < heap.size(); ++i)
-            callback(predicate, values((heap.data() + i)->first));
-        });
+    Kokkos::parallel_for(
+        "ArborX::BruteForce::query::nearest::"
+        "check_all_predicates_against_all_indexables",
+        TeamPolicy(space, n_teams, team_size)
+            .set_scratch_size(0, Kokkos::PerTeam(scratch_size)),
+        kernel);
   }
 };
 
@@ -12,6 +12,7 @@
 #ifndef ARBORX_DETAILS_CARTESIAN_GRID_HPP
 #define ARBORX_DETAILS_CARTESIAN_GRID_HPP
 
+#include <ArborX_DetailsKokkosExtMinMaxOperations.hpp>
 #include <ArborX_Exception.hpp>
 #include <ArborX_GeometryTraits.hpp>
 #include <ArborX_HyperBox.hpp>
@@ -67,6 +68,34 @@ public:
     return s;
   }
 
+  // Per-dimension cell coordinates of a point, clamped to the grid so that
+  // geometries outside the bounds map to the nearest boundary cell
+  template <typename Point, typename Enable = std::enable_if_t<
+                                GeometryTraits::is_point_v<Point>>>
+  KOKKOS_FUNCTION void cellCoordinates(Point const &point,
+                                       int (&coords)[DIM]) const
+  {
+    static_assert(GeometryTraits::dimension_v<Point> == DIM);
+
+    using KokkosExt::max;
+    using KokkosExt::min;
+    auto const &min_corner = _bounds.minCorner();
+    for (int d = 0; d < DIM; ++d)
+    {
+      int i = Kokkos::floor((point[d] - min_corner[d]) / _h[d]);
+      coords[d] = max(0, min(i, (int)_n[d] - 1));
+    }
+  }
+
+  KOKKOS_FUNCTION
+  size_t cellIndex(int const (&coords)[DIM]) const
+  {
+    size_t s = 0;
+    for (int d = DIM - 1; d >= 0; --d)
+      s = s * _n[d] + coords[d];
+    return s;
+  }
+
   KOKKOS_FUNCTION
   Box cellBox(size_t cell_index) const
   {
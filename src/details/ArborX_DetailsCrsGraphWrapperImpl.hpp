@@ -15,15 +15,27 @@
 #include <ArborX_Box.hpp>
 #include <ArborX_Callbacks.hpp>
 #include <ArborX_DetailsBatchedQueries.hpp>
+#include <ArborX_DetailsKokkosExtScratchArena.hpp>
 #include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
 #include <ArborX_DetailsKokkosExtViewHelpers.hpp>
 #include <ArborX_DetailsPermutedData.hpp>
 #include <ArborX_HyperBox.hpp>
+#include <ArborX_PredicateSortingAutoTuner.hpp>
 #include <ArborX_Predicates.hpp>
 #include <ArborX_TraversalPolicy.hpp>
 
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <algorithm>
+#include <vector>
+
 namespace ArborX
 {
+
+template <typename MemorySpace, typename Value, typename IndexableGetter,
+          typename BoundingVolume>
+class BoundingVolumeHierarchy;
+
 namespace Details
 {
 
@@ -50,8 +62,25 @@ struct FirstPassNoBufferOptimizationTag
 struct SecondPassTag
 {};
 
+// Whether tree.query(space, predicates, callback) may invoke the callback for
+// the same predicate from several threads concurrently. Brute force tiles
+// each predicate across a whole team, while the BVH traversals process each
+// predicate on a single thread. The conservative default covers tree types
+// this header knows nothing about.
+template <typename Tree>
+struct TraversalInvokesCallbacksConcurrently : std::true_type
+{};
+
+template <typename MemorySpace, typename Value, typename IndexableGetter,
+          typename BoundingVolume>
+struct TraversalInvokesCallbacksConcurrently<
+    BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter,
+                            BoundingVolume>> : std::false_type
+{};
+
 template <typename PassTag, typename Callback, typename OutputView,
-          typename CountView, typename PermutedOffset>
+          typename CountView, typename PermutedOffset,
+          bool ConcurrentCallbacks = true>
 struct InsertGenerator
 {
   Callback _callback;
@@ -79,7 +108,11 @@ struct InsertGenerator
       auto const buffer_size = *(&offset + 1) - offset;
 
       return _callback(raw_predicate, value, [&](ValueType const &v) {
-        int count_old = Kokkos::atomic_fetch_add(&count, 1);
+        std::decay_t<decltype(count)> count_old;
+        if constexpr (ConcurrentCallbacks)
+          count_old = Kokkos::atomic_fetch_add(&count, 1);
+        else
+          count_old = count++;
         if (count_old < buffer_size)
           _out(offset + count_old) = v;
       });
@@ -88,13 +121,17 @@ struct InsertGenerator
                                       FirstPassNoBufferOptimizationTag>)
     {
       return _callback(raw_predicate, value, [&](ValueType const &) {
-        Kokkos::atomic_increment(&count);
+        if constexpr (ConcurrentCallbacks)
+          Kokkos::atomic_increment(&count);
+        else
+          ++count;
       });
     }
     else
     {
       static_assert(std::is_same_v<PassTag, SecondPassTag>);
-      // we store offsets in counts, and offset(permute(i)) = counts(i)
+      // we store offsets in counts, which line up with the offsets element by
+      // element
       auto &offset = count;
 
       // TODO: there is a tradeoff here between skipping computation offset +
@@ -102,7 +139,10 @@ struct InsertGenerator
       // offset is problematic for OpenMP as you potentially constantly steal
       // cache lines.
       return _callback(raw_predicate, value, [&](ValueType const &v) {
-        _out(Kokkos::atomic_fetch_add(&offset, 1)) = v;
+        if constexpr (ConcurrentCallbacks)
+          _out(Kokkos::atomic_fetch_add(&offset, 1)) = v;
+        else
+          _out(offset++) = v;
       });
     }
   }
@@ -124,13 +164,23 @@ void queryImpl(ExecutionSpace const &space, Tree const &tree,
 
   static_assert(Kokkos::is_execution_space<ExecutionSpace>{});
 
+  // Single-writer traversals get plain increments on the per-query counters
+  // instead of atomic read-modify-writes
+  constexpr bool concurrent_callbacks =
+      TraversalInvokesCallbacksConcurrently<Tree>::value;
+
   auto const n_queries = predicates.size();
 
   Kokkos::Profiling::pushRegion("ArborX::CrsGraphWrapper::two_pass");
 
-  using CountView = OffsetView;
-  CountView counts(Kokkos::view_alloc(space, "ArborX::CrsGraphWrapper::counts"),
-                   n_queries);
+  // Draw the counts temporary from the per-instance scratch arena. This
+  // allocation recurs on every call, and fresh device allocations serialize
+  // multi-stream pipelines.
+  KokkosExt::ScratchArena<typename OutputView::memory_space> scratch(space);
+  auto counts =
+      scratch.allocate<typename OffsetView::non_const_value_type>(n_queries);
+  using CountView = decltype(counts);
+  Kokkos::deep_copy(space, counts, 0);
 
   using PermutedPredicates =
       PermutedData<Predicates, PermuteType, true /*AttachIndices*/>;
@@ -139,51 +189,57 @@ void queryImpl(ExecutionSpace const &space, Tree const &tree,
   using PermutedOffset = PermutedData<OffsetView, PermuteType>;
   PermutedOffset permuted_offset = {offset, permute};
 
+  // Store the counts in query order by writing them through the permutation:
+  // the offsets scan can then consume them directly instead of scattering
+  // them into the offset array in a separate kernel first
+  using PermutedCounts = PermutedData<CountView, PermuteType>;
+  PermutedCounts permuted_counts = {counts, permute};
+
   Kokkos::Profiling::pushRegion(
       "ArborX::CrsGraphWrapper::two_pass::first_pass");
+  // Track totals in the offset element type: with a 64-bit offset view the
+  // result set is allowed to exceed 2^31 entries
+  using OffsetType = typename OffsetView::non_const_value_type;
   bool underflow = false;
   bool overflow = false;
+  OffsetType total_counts = 0;
   if (buffer_status != BufferStatus::PreallocationNone)
   {
     tree.query(
         space, permuted_predicates,
-        InsertGenerator<FirstPassTag, Callback, OutputView, CountView,
-                        PermutedOffset>{callback, out, counts, permuted_offset},
+        InsertGenerator<FirstPassTag, Callback, OutputView, PermutedCounts,
+                        PermutedOffset, concurrent_callbacks>{
+            callback, out, permuted_counts, permuted_offset},
         ArborX::Experimental::TraversalPolicy().setPredicateSorting(false));
 
     // Detecting overflow is a local operation that needs to be done for every
     // index. We allow individual buffer sizes to differ, so it's not as easy
-    // as computing max counts.
-    int overflow_int;
+    // as computing max counts. The total count comes out of the same sweep,
+    // which both folds the underflow detection in and spares the device
+    // synchronization of reading the scanned offsets back later: for small
+    // predicate batches the launch and synchronization overhead of these
+    // little bookkeeping steps dominates the query call.
+    int overflow_int = 0;
     Kokkos::parallel_reduce(
-        "ArborX::CrsGraphWrapper::compute_overflow",
+        "ArborX::CrsGraphWrapper::compute_overflow_and_total",
         Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
-        KOKKOS_LAMBDA(int i, int &update) {
+        KOKKOS_LAMBDA(int i, int &overflow_update, OffsetType &count_update) {
           auto const *const offset_ptr = &permuted_offset(i);
-          if (counts(i) > *(offset_ptr + 1) - *offset_ptr)
-            update = 1;
+          if (permuted_counts(i) > *(offset_ptr + 1) - *offset_ptr)
+            overflow_update = 1;
+          count_update += permuted_counts(i);
         },
-        overflow_int);
+        Kokkos::LOr<int>(overflow_int), total_counts);
     overflow = (overflow_int > 0);
-
-    if (!overflow)
-    {
-      int n_results;
-      Kokkos::parallel_reduce(
-          "ArborX::CrsGraphWrapper::compute_underflow",
-          Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
-          KOKKOS_LAMBDA(int i, int &update) { update += counts(i); },
-          n_results);
-      underflow = (n_results < out.extent_int(0));
-    }
+    underflow = (!overflow && total_counts < (OffsetType)out.extent(0));
   }
   else
   {
     tree.query(
         space, permuted_predicates,
         InsertGenerator<FirstPassNoBufferOptimizationTag, Callback, OutputView,
-                        CountView, PermutedOffset>{callback, out, counts,
-                                                   permuted_offset},
+                        PermutedCounts, PermutedOffset, concurrent_callbacks>{
+            callback, out, permuted_counts, permuted_offset},
         ArborX::Experimental::TraversalPolicy().setPredicateSorting(false));
     // This may not be true, but it does not matter. As long as we have
     // (n_results == 0) check before second pass, this value is not used.
@@ -193,22 +249,34 @@ void queryImpl(ExecutionSpace const &space, Tree const &tree,
 
   Kokkos::Profiling::popRegion();
   Kokkos::Profiling::pushRegion(
-      "ArborX::CrsGraphWrapper::first_pass_postprocess");
+      "ArborX::CrsGraphWrapper::two_pass::first_pass_postprocess");
 
   OffsetView preallocated_offset("ArborX::CrsGraphWrapper::offset_copy", 0);
-  if (underflow)
+  if (underflow ||
+      (overflow && buffer_status != BufferStatus::PreallocationNone))
   {
-    // Store a copy of the original offset. We'll need it for compression.
+    // Store a copy of the original offset. We'll need it for compression on
+    // underflow, and for keeping the already filled results on overflow.
     preallocated_offset = KokkosExt::clone(space, offset);
   }
 
-  Kokkos::parallel_for(
-      "ArborX::CrsGraphWrapper::copy_counts_to_offsets",
-      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
-      KOKKOS_LAMBDA(int const i) { permuted_offset(i) = counts(i); });
-  KokkosExt::exclusive_scan(space, offset, offset, 0);
-
-  int const n_results = KokkosExt::lastElement(space, offset);
+  // The counts are already in query order, so the single-pass scan produces
+  // the offsets straight from them, saving the kernel that used to scatter
+  // them into the offset array and the re-read of that array by the scan
+  KokkosExt::transform_exclusive_scan(
+      space, n_queries + 1,
+      KOKKOS_LAMBDA(int i) {
+        return (i < (int)n_queries ? counts(i) : OffsetType(0));
+      },
+      offset, OffsetType(0));
+
+  // After the scan, the last offset is the sum of the counts, which the
+  // buffered first pass already reduced on the host; only the no-buffer path
+  // has to pay for reading it back from the device
+  OffsetType const n_results =
+      (buffer_status != BufferStatus::PreallocationNone
+           ? total_counts
+           : KokkosExt::lastElement(space, offset));
 
   Kokkos::Profiling::popRegion();
 
@@ -231,30 +299,108 @@ void queryImpl(ExecutionSpace const &space, Tree const &tree,
     // If it was hard preallocation, we simply throw
     ARBORX_ASSERT(buffer_status != BufferStatus::PreallocationHard);
 
-    // Otherwise, do the second pass
-    Kokkos::Profiling::pushRegion(
-        "ArborX::CrsGraphWrapper::two_pass:second_pass");
+    if (buffer_status == BufferStatus::PreallocationNone)
+    {
+      // No buffers were used, so no results exist yet; do the full second
+      // pass
+      Kokkos::Profiling::pushRegion(
+          "ArborX::CrsGraphWrapper::two_pass::second_pass");
 
-    Kokkos::parallel_for(
-        "ArborX::CrsGraphWrapper::copy_offsets_to_counts",
-        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
-        KOKKOS_LAMBDA(int const i) { counts(i) = permuted_offset(i); });
+      Kokkos::parallel_for(
+          "ArborX::CrsGraphWrapper::copy_offsets_to_counts",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+          KOKKOS_LAMBDA(int const i) { counts(i) = offset(i); });
 
-    KokkosExt::reallocWithoutInitializing(space, out, n_results);
+      KokkosExt::reallocWithoutInitializing(space, out, n_results);
 
-    tree.query(
-        space, permuted_predicates,
-        InsertGenerator<SecondPassTag, Callback, OutputView, CountView,
-                        PermutedOffset>{callback, out, counts, permuted_offset},
-        ArborX::Experimental::TraversalPolicy().setPredicateSorting(false));
+      tree.query(
+          space, permuted_predicates,
+          InsertGenerator<SecondPassTag, Callback, OutputView, PermutedCounts,
+                          PermutedOffset, concurrent_callbacks>{
+              callback, out, permuted_counts, permuted_offset},
+          ArborX::Experimental::TraversalPolicy().setPredicateSorting(false));
 
-    Kokkos::Profiling::popRegion();
+      Kokkos::Profiling::popRegion();
+    }
+    else
+    {
+      // The first pass produced complete results for every query whose
+      // buffer did not overflow. Keep those and only traverse the overflowed
+      // subset again; in typical soft-preallocation workloads that subset is
+      // a small fraction of the queries.
+      Kokkos::Profiling::pushRegion(
+          "ArborX::CrsGraphWrapper::two_pass::partial_second_pass");
+
+      using MemorySpace = typename OutputView::memory_space;
+
+      PermutedOffset permuted_old_offset = {preallocated_offset, permute};
+
+      Kokkos::View<int *, MemorySpace> overflowed_indices(
+          Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                             "ArborX::CrsGraphWrapper::overflowed_indices"),
+          n_queries);
+      Kokkos::View<int, MemorySpace> num_overflowed_view(
+          "ArborX::CrsGraphWrapper::num_overflowed");
+      Kokkos::parallel_for(
+          "ArborX::CrsGraphWrapper::compact_overflowed_queries",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+          KOKKOS_LAMBDA(int const i) {
+            auto const &old_offset = permuted_old_offset(i);
+            auto const buffer_size = *(&old_offset + 1) - old_offset;
+            if (permuted_counts(i) > buffer_size)
+              overflowed_indices(
+                  Kokkos::atomic_fetch_add(&num_overflowed_view(), 1)) = i;
+          });
+      int num_overflowed;
+      Kokkos::deep_copy(space, num_overflowed, num_overflowed_view);
+      space.fence();
+
+      OutputView tmp_out(
+          Kokkos::view_alloc(space, Kokkos::WithoutInitializing, out.label()),
+          n_results);
+      Kokkos::parallel_for(
+          "ArborX::CrsGraphWrapper::copy_filled_results",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+          KOKKOS_LAMBDA(int const i) {
+            auto const &old_offset = permuted_old_offset(i);
+            auto const buffer_size = *(&old_offset + 1) - old_offset;
+            auto const count = permuted_counts(i);
+            if (count > buffer_size)
+              return;
+            auto const new_offset = permuted_offset(i);
+            for (OffsetType j = 0; j < count; ++j)
+              tmp_out(new_offset + j) = out(old_offset + j);
+          });
+
+      // Initialize the output cursors for the re-traversed queries
+      Kokkos::parallel_for(
+          "ArborX::CrsGraphWrapper::copy_offsets_to_counts",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+          KOKKOS_LAMBDA(int const i) { counts(i) = offset(i); });
+
+      auto overflowed = Kokkos::subview(overflowed_indices,
+                                        std::make_pair(0, num_overflowed));
+      using UnpermutedPredicates =
+          PermutedData<Predicates, PermuteType, false /*AttachIndices*/>;
+      tree.query(
+          space,
+          SubsetData<UnpermutedPredicates, decltype(overflowed)>{
+              {predicates, permute}, overflowed},
+          InsertGenerator<SecondPassTag, Callback, OutputView, PermutedCounts,
+                          PermutedOffset, concurrent_callbacks>{
+              callback, tmp_out, permuted_counts, permuted_offset},
+          ArborX::Experimental::TraversalPolicy().setPredicateSorting(false));
+
+      out = tmp_out;
+
+      Kokkos::Profiling::popRegion();
+    }
   }
   else if (underflow)
   {
     // More than enough storage for results, need compression
     Kokkos::Profiling::pushRegion(
-        "ArborX::CrsGraphWrapper::two_pass:copy_values");
+        "ArborX::CrsGraphWrapper::two_pass::copy_values");
 
     OutputView tmp_out(
         Kokkos::view_alloc(space, Kokkos::WithoutInitializing, out.label()),
@@ -264,8 +410,8 @@ void queryImpl(ExecutionSpace const &space, Tree const &tree,
         "ArborX::CrsGraphWrapper::copy_valid_values",
         Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
         KOKKOS_LAMBDA(int i) {
-          int count = offset(i + 1) - offset(i);
-          for (int j = 0; j < count; ++j)
+          auto const count = offset(i + 1) - offset(i);
+          for (OffsetType j = 0; j < count; ++j)
           {
             tmp_out(offset(i) + j) = out(preallocated_offset(i) + j);
           }
@@ -288,8 +434,7 @@ struct Iota
 
 template <typename Tag, typename ExecutionSpace, typename Predicates,
           typename OffsetView, typename OutView>
-std::enable_if_t<std::is_same_v<Tag, SpatialPredicateTag> ||
-                 std::is_same_v<Tag, OrderedSpatialPredicateTag>>
+std::enable_if_t<std::is_same_v<Tag, SpatialPredicateTag>>
 allocateAndInitializeStorage(Tag, ExecutionSpace const &space,
                              Predicates const &predicates, OffsetView &offset,
                              OutView &out, int buffer_size)
@@ -299,16 +444,55 @@ allocateAndInitializeStorage(Tag, ExecutionSpace const &space,
 
   buffer_size = std::abs(buffer_size);
 
-  Kokkos::deep_copy(space, offset, buffer_size);
-
   if (buffer_size != 0)
   {
-    KokkosExt::exclusive_scan(space, offset, offset, 0);
+    // The offsets of a uniform preallocation are a closed form of the index,
+    // no need to fill the view and scan it
+    using OffsetType = typename OffsetView::non_const_value_type;
+    Kokkos::parallel_for(
+        "ArborX::CrsGraphWrapper::query::spatial::compute_uniform_offsets",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries + 1),
+        KOKKOS_LAMBDA(int i) { offset(i) = (OffsetType)i * buffer_size; });
 
     // Use calculation for the size to avoid calling lastElement(space, offset)
     // as it will launch an extra kernel to copy to host.
     KokkosExt::reallocWithoutInitializing(space, out, n_queries * buffer_size);
   }
+  else
+  {
+    Kokkos::deep_copy(space, offset, 0);
+  }
+}
+
+template <typename Tag, typename ExecutionSpace, typename Predicates,
+          typename OffsetView, typename OutView>
+std::enable_if_t<std::is_same_v<Tag, OrderedSpatialPredicateTag>>
+allocateAndInitializeStorage(Tag, ExecutionSpace const &space,
+                             Predicates const &predicates, OffsetView &offset,
+                             OutView &out, int buffer_size)
+{
+  auto const n_queries = predicates.size();
+  KokkosExt::reallocWithoutInitializing(space, offset, n_queries + 1);
+
+  buffer_size = std::abs(buffer_size);
+
+  // A k-limited predicate reports at most k results, so its storage can be
+  // preallocated exactly, guaranteeing the first pass is also the last one;
+  // unlimited predicates fall back to the buffer size heuristic. The
+  // capacities feed the single-pass scan directly instead of being
+  // materialized in the offset view first.
+  KokkosExt::transform_exclusive_scan(
+      space, n_queries + 1,
+      KOKKOS_LAMBDA(int i) {
+        if (i == (int)n_queries)
+          return 0;
+        auto const max_results = getMaxResults(predicates(i));
+        return (max_results > 0 ? max_results : buffer_size);
+      },
+      offset, 0);
+
+  KokkosExt::reallocWithoutInitializing(space, out,
+                                        KokkosExt::lastElement(space, offset));
 }
 
 template <typename Tag, typename ExecutionSpace, typename Predicates,
@@ -321,12 +505,12 @@ allocateAndInitializeStorage(Tag, ExecutionSpace const &space,
   auto const n_queries = predicates.size();
   KokkosExt::reallocWithoutInitializing(space, offset, n_queries + 1);
 
-  Kokkos::parallel_for(
-      "ArborX::CrsGraphWrapper::query::nearest::"
-      "scan_queries_for_numbers_of_nearest_neighbors",
-      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
-      KOKKOS_LAMBDA(int i) { offset(i) = getK(predicates(i)); });
-  KokkosExt::exclusive_scan(space, offset, offset, 0);
+  KokkosExt::transform_exclusive_scan(
+      space, n_queries + 1,
+      KOKKOS_LAMBDA(int i) {
+        return (i < (int)n_queries ? getK(predicates(i)) : 0);
+      },
+      offset, 0);
 
   KokkosExt::reallocWithoutInitializing(space, out,
                                         KokkosExt::lastElement(space, offset));
@@ -381,7 +565,12 @@ queryDispatch(Tag, Tree const &tree, ExecutionSpace const &space,
                             ? toBufferStatus(policy._buffer_size)
                             : BufferStatus::PreallocationSoft);
 
-  if (policy._sort_predicates)
+  auto *auto_tuner = policy._sorting_auto_tuner;
+  bool const sort_predicates =
+      (auto_tuner != nullptr ? auto_tuner->beginSample(space, predicates.size())
+                             : policy._sort_predicates);
+
+  if (sort_predicates)
   {
     Kokkos::Profiling::pushRegion(profiling_prefix + "::compute_permutation");
     using bounding_volume_type = std::decay_t<decltype(tree.bounds())>;
@@ -391,9 +580,10 @@ queryDispatch(Tag, Tree const &tree, ExecutionSpace const &space,
         scene_bounding_box{};
     using namespace Details;
     expand(scene_bounding_box, tree.bounds());
-    auto permute = Details::BatchedQueries<DeviceType>::
-        sortPredicatesAlongSpaceFillingCurve(space, Experimental::Morton32(),
-                                             scene_bounding_box, predicates);
+    auto permute =
+        Details::BatchedQueries<DeviceType>::getOrComputePermutation(
+            space, Experimental::Morton32(), scene_bounding_box, predicates,
+            policy._sorting_cache);
     Kokkos::Profiling::popRegion();
 
     queryImpl(space, tree, predicates, callback, out, offset, permute,
@@ -406,6 +596,9 @@ queryDispatch(Tag, Tree const &tree, ExecutionSpace const &space,
               buffer_status);
   }
 
+  if (auto_tuner != nullptr)
+    auto_tuner->endSample(space);
+
   Kokkos::Profiling::popRegion();
 }
 
@@ -440,6 +633,549 @@ queryDispatch(Tag, Tree const &tree, ExecutionSpace const &space,
   callback(predicates, offset, indices, out);
 }
 
+template <typename ExecutionSpace, typename Tree, typename Predicates,
+          typename Callback, typename OutputView, typename OffsetView,
+          typename CountView, typename PermuteType>
+bool queryIntoImpl(ExecutionSpace const &space, Tree const &tree,
+                   Predicates const &predicates, Callback const &callback,
+                   OutputView const &out, OffsetView const &offset,
+                   CountView const &counts, PermuteType permute)
+{
+  auto const n_queries = predicates.size();
+
+  constexpr bool concurrent_callbacks =
+      TraversalInvokesCallbacksConcurrently<Tree>::value;
+
+  using PermutedPredicates =
+      PermutedData<Predicates, PermuteType, true /*AttachIndices*/>;
+  PermutedPredicates permuted_predicates = {predicates, permute};
+
+  using PermutedOffset = PermutedData<OffsetView, PermuteType>;
+  PermutedOffset permuted_offset = {offset, permute};
+
+  // The per-query cursors live in traversal order during the traversal
+  // (matching the attached predicate indices) and are scattered back to
+  // query order afterwards
+  KokkosExt::ScratchArena<typename OutputView::memory_space> scratch(space);
+  auto cursors =
+      scratch.allocate<typename CountView::non_const_value_type>(n_queries);
+  Kokkos::deep_copy(space, cursors, 0);
+
+  tree.query(
+      space, permuted_predicates,
+      InsertGenerator<FirstPassTag, Callback, OutputView, decltype(cursors),
+                      PermutedOffset, concurrent_callbacks>{
+          callback, out, cursors, permuted_offset},
+      ArborX::Experimental::TraversalPolicy().setPredicateSorting(false));
+
+  // Scatter the cursors back to query order, folding the overflow detection
+  // and clamping into the same sweep
+  using PermutedCounts = PermutedData<CountView, PermuteType>;
+  PermutedCounts permuted_counts = {counts, permute};
+  int overflow_int = 0;
+  Kokkos::parallel_reduce(
+      "ArborX::CrsGraphWrapper::query_into::scatter_counts_and_detect_"
+      "overflow",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int i, int &update) {
+        auto const *const offset_ptr = &permuted_offset(i);
+        auto const capacity = *(offset_ptr + 1) - *offset_ptr;
+        auto count = cursors(i);
+        if (count > capacity)
+        {
+          count = capacity;
+          update = 1;
+        }
+        permuted_counts(i) = count;
+      },
+      Kokkos::LOr<int>(overflow_int));
+
+  return overflow_int > 0;
+}
+
+// Run the query into caller-preallocated storage. 'offset' must hold the CRS
+// layout of the per-query capacities (n_queries + 1 entries) and is left
+// untouched; on return the results of query i occupy
+// out(offset(i))..out(offset(i) + counts(i) - 1). Returns true if at least
+// one query produced more results than its capacity, in which case the extra
+// results of that query are dropped and counts(i) is clamped to the capacity.
+// In contrast to queryDispatch, no view is ever resized, so steady-state
+// callers whose result sizes are stable can reuse the same three views on
+// every call.
+template <typename Tree, typename ExecutionSpace, typename Predicates,
+          typename Callback, typename OutputView, typename OffsetView,
+          typename CountView>
+bool queryIntoPreallocated(Tree const &tree, ExecutionSpace const &space,
+                           Predicates const &predicates,
+                           Callback const &callback, OutputView const &out,
+                           OffsetView const &offset, CountView const &counts,
+                           Experimental::TraversalPolicy const &policy =
+                               Experimental::TraversalPolicy())
+{
+  static_assert(Kokkos::is_execution_space<ExecutionSpace>{});
+
+  using MemorySpace = typename Tree::memory_space;
+  using DeviceType = Kokkos::Device<ExecutionSpace, MemorySpace>;
+
+  check_valid_callback<typename Tree::value_type>(callback, predicates, out);
+
+  ARBORX_ASSERT(offset.size() == predicates.size() + 1);
+  ARBORX_ASSERT(counts.size() == predicates.size());
+
+  Kokkos::Profiling::ScopedRegion guard("ArborX::CrsGraphWrapper::query_into");
+
+  auto *auto_tuner = policy._sorting_auto_tuner;
+  bool const sort_predicates =
+      (auto_tuner != nullptr ? auto_tuner->beginSample(space, predicates.size())
+                             : policy._sort_predicates);
+
+  bool success;
+  if (sort_predicates)
+  {
+    using bounding_volume_type = std::decay_t<decltype(tree.bounds())>;
+    ExperimentalHyperGeometry::Box<
+        GeometryTraits::dimension_v<bounding_volume_type>,
+        typename GeometryTraits::coordinate_type_t<bounding_volume_type>>
+        scene_bounding_box{};
+    using namespace Details;
+    expand(scene_bounding_box, tree.bounds());
+    auto permute = Details::BatchedQueries<DeviceType>::getOrComputePermutation(
+        space, Experimental::Morton32(), scene_bounding_box, predicates,
+        policy._sorting_cache);
+    success = queryIntoImpl(space, tree, predicates, callback, out, offset,
+                            counts, permute);
+  }
+  else
+  {
+    success = queryIntoImpl(space, tree, predicates, callback, out, offset,
+                            counts, Iota{});
+  }
+
+  if (auto_tuner != nullptr)
+    auto_tuner->endSample(space);
+
+  return success;
+}
+
+// Insert functor that discards the value: in the count-only query only the
+// number of insertions matters, whatever their type
+struct CountingSink
+{
+  template <typename T>
+  KOKKOS_FUNCTION void operator()(T const &) const
+  {}
+};
+
+// Counterpart of InsertGenerator for the count-only query. Unlike the
+// counting branch of the first pass, it carries no output view and accepts
+// insertions of any type, so the caller does not have to commit to a result
+// type it will never materialize.
+template <typename Callback, typename PermutedCounts,
+          bool ConcurrentCallbacks = true>
+struct CountGenerator
+{
+  Callback _callback;
+  PermutedCounts _counts;
+
+  template <typename Predicate, typename Value>
+  KOKKOS_FUNCTION auto operator()(Predicate const &predicate,
+                                  Value const &value) const
+  {
+    auto &count = _counts(getData(predicate));
+    return _callback(getPredicate(predicate), value, [&](auto const &) {
+      if constexpr (ConcurrentCallbacks)
+        Kokkos::atomic_increment(&count);
+      else
+        ++count;
+    });
+  }
+};
+
+template <typename ExecutionSpace, typename Tree, typename Predicates,
+          typename Callback, typename OffsetView, typename PermuteType>
+void queryCountsImpl(ExecutionSpace const &space, Tree const &tree,
+                     Predicates const &predicates, Callback const &callback,
+                     OffsetView const &offset, PermuteType permute)
+{
+  using MemorySpace = typename Tree::memory_space;
+  using OffsetType = typename OffsetView::non_const_value_type;
+
+  auto const n_queries = predicates.size();
+
+  constexpr bool concurrent_callbacks =
+      TraversalInvokesCallbacksConcurrently<Tree>::value;
+
+  KokkosExt::ScratchArena<MemorySpace> scratch(space);
+  auto counts = scratch.allocate<OffsetType>(n_queries);
+  using CountView = decltype(counts);
+  Kokkos::deep_copy(space, counts, 0);
+
+  using PermutedPredicates =
+      PermutedData<Predicates, PermuteType, true /*AttachIndices*/>;
+  PermutedPredicates permuted_predicates = {predicates, permute};
+
+  using PermutedCounts = PermutedData<CountView, PermuteType>;
+  PermutedCounts permuted_counts = {counts, permute};
+
+  tree.query(
+      space, permuted_predicates,
+      CountGenerator<Callback, PermutedCounts, concurrent_callbacks>{
+          callback, permuted_counts},
+      ArborX::Experimental::TraversalPolicy().setPredicateSorting(false));
+
+  // The counts were written in query order through the permutation, so the
+  // scan consumes them directly
+  KokkosExt::transform_exclusive_scan(
+      space, n_queries + 1,
+      KOKKOS_LAMBDA(int i) {
+        return (i < (int)n_queries ? counts(i) : OffsetType(0));
+      },
+      offset, OffsetType(0));
+}
+
+// Count-only variant of the query: runs just the counting traversal and the
+// offsets scan, skipping the result allocation and the fill pass entirely.
+// On return 'offset' holds n_queries + 1 entries, with
+// offset(i + 1) - offset(i) the number of results query i would produce
+// (i.e., the number of insertions the callback would perform). Nothing is
+// read back to the host.
+template <typename Tree, typename ExecutionSpace, typename Predicates,
+          typename Callback, typename OffsetView>
+void queryCounts(Tree const &tree, ExecutionSpace const &space,
+                 Predicates const &predicates, Callback const &callback,
+                 OffsetView &offset,
+                 Experimental::TraversalPolicy const &policy =
+                     Experimental::TraversalPolicy())
+{
+  static_assert(Kokkos::is_execution_space<ExecutionSpace>{});
+
+  using MemorySpace = typename Tree::memory_space;
+  using DeviceType = Kokkos::Device<ExecutionSpace, MemorySpace>;
+
+  check_generic_lambda_support(callback);
+  static_assert(
+      std::is_invocable_v<
+          Callback const &,
+          typename AccessValues<Predicates, PredicatesTag>::value_type,
+          typename Tree::value_type, CountingSink>,
+      "Callback 'operator()' does not have the correct signature");
+
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::CrsGraphWrapper::query_counts");
+
+  KokkosExt::reallocWithoutInitializing(space, offset, predicates.size() + 1);
+
+  auto *auto_tuner = policy._sorting_auto_tuner;
+  bool const sort_predicates =
+      (auto_tuner != nullptr ? auto_tuner->beginSample(space, predicates.size())
+                             : policy._sort_predicates);
+
+  if (sort_predicates)
+  {
+    using bounding_volume_type = std::decay_t<decltype(tree.bounds())>;
+    ExperimentalHyperGeometry::Box<
+        GeometryTraits::dimension_v<bounding_volume_type>,
+        typename GeometryTraits::coordinate_type_t<bounding_volume_type>>
+        scene_bounding_box{};
+    using namespace Details;
+    expand(scene_bounding_box, tree.bounds());
+    auto permute = Details::BatchedQueries<DeviceType>::getOrComputePermutation(
+        space, Experimental::Morton32(), scene_bounding_box, predicates,
+        policy._sorting_cache);
+    queryCountsImpl(space, tree, predicates, callback, offset, permute);
+  }
+  else
+  {
+    queryCountsImpl(space, tree, predicates, callback, offset, Iota{});
+  }
+
+  if (auto_tuner != nullptr)
+    auto_tuner->endSample(space);
+}
+
+// Fused two-pass query over a heterogeneous predicate batch: a spatial, a
+// nearest and an ordered-spatial set run against the same tree in one
+// pipeline. Each set keeps its own traversal kernels (the predicate types
+// differ at compile time), but the fixed per-call costs are shared: the
+// permutations are computed against the scene bounding box back-to-back
+// without synchronizing, all counting traversals complete before a single
+// offsets scan over the combined counts, and one host read-back sizes one
+// result allocation for all three sets before the fill traversals. The
+// combined CRS layout segments the rows by type, in argument order: rows
+// [0, n_spatial) are the spatial queries, followed by the nearest and the
+// ordered ones.
+template <typename Tree, typename ExecutionSpace, typename SpatialPredicates,
+          typename NearestPredicates, typename OrderedPredicates,
+          typename OutputView, typename OffsetView>
+void queryMixed(Tree const &tree, ExecutionSpace const &space,
+                SpatialPredicates const &spatial_predicates,
+                NearestPredicates const &nearest_predicates,
+                OrderedPredicates const &ordered_predicates, OutputView &out,
+                OffsetView &offset,
+                Experimental::TraversalPolicy const &policy)
+{
+  using MemorySpace = typename Tree::memory_space;
+  using DeviceType = Kokkos::Device<ExecutionSpace, MemorySpace>;
+  using OffsetType = typename OffsetView::non_const_value_type;
+
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::CrsGraphWrapper::query_mixed");
+
+  constexpr bool concurrent_callbacks =
+      TraversalInvokesCallbacksConcurrently<Tree>::value;
+
+  std::size_t const n_spatial = spatial_predicates.size();
+  std::size_t const n_nearest = nearest_predicates.size();
+  std::size_t const n_ordered = ordered_predicates.size();
+  std::size_t const n_queries = n_spatial + n_nearest + n_ordered;
+
+  KokkosExt::ScratchArena<MemorySpace> scratch(space);
+  auto counts = scratch.allocate<OffsetType>(n_queries);
+  using CountView = decltype(counts);
+  Kokkos::deep_copy(space, counts, 0);
+
+  KokkosExt::reallocWithoutInitializing(space, offset, n_queries + 1);
+
+  using bounding_volume_type = std::decay_t<decltype(tree.bounds())>;
+  ExperimentalHyperGeometry::Box<
+      GeometryTraits::dimension_v<bounding_volume_type>,
+      typename GeometryTraits::coordinate_type_t<bounding_volume_type>>
+      scene_bounding_box{};
+  expand(scene_bounding_box, tree.bounds());
+
+  // The three permutations have to survive from the count pass to the fill
+  // pass, so the unsorted case materializes the identity instead of using
+  // the Iota shortcut of the homogeneous path
+  auto compute_permute = [&](auto const &predicates) {
+    if (policy._sort_predicates)
+      return BatchedQueries<DeviceType>::getOrComputePermutation(
+          space, Experimental::Morton32(), scene_bounding_box, predicates,
+          nullptr);
+    Kokkos::View<unsigned int *, DeviceType> permute(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::CrsGraphWrapper::query_mixed::permute"),
+        predicates.size());
+    KokkosExt::iota(space, permute);
+    return permute;
+  };
+  auto const spatial_permute = compute_permute(spatial_predicates);
+  auto const nearest_permute = compute_permute(nearest_predicates);
+  auto const ordered_permute = compute_permute(ordered_predicates);
+
+  auto counts_slice = [&](std::size_t begin, std::size_t n) {
+    return Kokkos::subview(counts, std::make_pair(begin, begin + n));
+  };
+  using CountsSlice = decltype(counts_slice(0, 0));
+  using Permute = std::decay_t<decltype(spatial_permute)>;
+  using PermutedCounts = PermutedData<CountsSlice, Permute>;
+
+  auto count_pass = [&](auto const &predicates, Permute const &permute,
+                        std::size_t begin) {
+    if (predicates.size() == 0)
+      return;
+    using Predicates = std::decay_t<decltype(predicates)>;
+    using PermutedPredicates =
+        PermutedData<Predicates, Permute, true /*AttachIndices*/>;
+    tree.query(space, PermutedPredicates{predicates, permute},
+               CountGenerator<DefaultCallback, PermutedCounts,
+                              concurrent_callbacks>{
+                   DefaultCallback{},
+                   PermutedCounts{counts_slice(begin, predicates.size()),
+                                  permute}},
+               Experimental::TraversalPolicy().setPredicateSorting(false));
+  };
+  count_pass(spatial_predicates, spatial_permute, 0);
+  count_pass(nearest_predicates, nearest_permute, n_spatial);
+  count_pass(ordered_predicates, ordered_permute, n_spatial + n_nearest);
+
+  KokkosExt::transform_exclusive_scan(
+      space, n_queries + 1,
+      KOKKOS_LAMBDA(int i) {
+        return (i < (int)n_queries ? counts(i) : OffsetType(0));
+      },
+      offset, OffsetType(0));
+
+  // The single synchronization point of the whole batch
+  OffsetType const n_results = KokkosExt::lastElement(space, offset);
+
+  if (n_results == 0)
+  {
+    Kokkos::resize(Kokkos::view_alloc(space, Kokkos::WithoutInitializing), out,
+                   0);
+    return;
+  }
+
+  KokkosExt::reallocWithoutInitializing(space, out, n_results);
+
+  // Seed the output cursors of all three sets in one sweep
+  Kokkos::parallel_for(
+      "ArborX::CrsGraphWrapper::query_mixed::copy_offsets_to_counts",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int const i) { counts(i) = offset(i); });
+
+  auto fill_pass = [&](auto const &predicates, Permute const &permute,
+                       std::size_t begin) {
+    if (predicates.size() == 0)
+      return;
+    using Predicates = std::decay_t<decltype(predicates)>;
+    using PermutedPredicates =
+        PermutedData<Predicates, Permute, true /*AttachIndices*/>;
+    auto offset_slice = Kokkos::subview(
+        offset, std::make_pair(begin, begin + predicates.size() + 1));
+    using PermutedOffset = PermutedData<decltype(offset_slice), Permute>;
+    tree.query(space, PermutedPredicates{predicates, permute},
+               InsertGenerator<SecondPassTag, DefaultCallback, OutputView,
+                               PermutedCounts, PermutedOffset,
+                               concurrent_callbacks>{
+                   DefaultCallback{}, out,
+                   PermutedCounts{counts_slice(begin, predicates.size()),
+                                  permute},
+                   PermutedOffset{offset_slice, permute}},
+               Experimental::TraversalPolicy().setPredicateSorting(false));
+  };
+  fill_pass(spatial_predicates, spatial_permute, 0);
+  fill_pass(nearest_predicates, nearest_permute, n_spatial);
+  fill_pass(ordered_predicates, ordered_permute, n_spatial + n_nearest);
+}
+
+// Streamed two-pass query for result sets that do not fit in device memory.
+// The count pass runs over all predicates at once (the offsets are one
+// integer per predicate, so they fit even when the results do not); the fill
+// pass then runs in predicate chunks whose results fit in 'buffer_capacity'
+// entries, draining each chunk's slice of the CRS output to the host views
+// on the execution space instance the chunk traversed on while the next
+// chunk traverses on a second instance.
+template <typename Tree, typename ExecutionSpace, typename Predicates,
+          typename Callback, typename HostValues, typename HostOffset>
+void queryToHost(Tree const &tree, ExecutionSpace const &space,
+                 Predicates const &predicates, Callback const &callback,
+                 HostValues &host_values, HostOffset &host_offset,
+                 size_t buffer_capacity,
+                 Experimental::TraversalPolicy const &policy)
+{
+  using MemorySpace = typename Tree::memory_space;
+  using OffsetType = typename HostOffset::non_const_value_type;
+  using ValueType = typename HostValues::non_const_value_type;
+  using BufferView = Kokkos::View<ValueType *, MemorySpace>;
+  using OffsetView = Kokkos::View<OffsetType *, MemorySpace>;
+
+  check_valid_callback<typename Tree::value_type>(callback, predicates,
+                                                  BufferView{});
+
+  int const n_queries = predicates.size();
+
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::CrsGraphWrapper::query_to_host");
+
+  OffsetView offset(Kokkos::view_alloc(
+                        space, Kokkos::WithoutInitializing,
+                        "ArborX::CrsGraphWrapper::query_to_host::offset"),
+                    0);
+  queryCounts(tree, space, predicates, callback, offset, policy);
+
+  Kokkos::realloc(Kokkos::view_alloc(Kokkos::WithoutInitializing), host_offset,
+                  n_queries + 1);
+  Kokkos::deep_copy(space, host_offset, offset);
+  space.fence("ArborX::CrsGraphWrapper::query_to_host (counts on host)");
+
+  OffsetType const n_results = host_offset(n_queries);
+  Kokkos::realloc(Kokkos::view_alloc(Kokkos::WithoutInitializing), host_values,
+                  n_results);
+  if (n_results == 0)
+    return;
+
+  // A chunk must hold every result of each of its predicates, so a single
+  // predicate exceeding the budget raises the buffer size to its count; that
+  // much device memory is needed to produce its results at all
+  OffsetType capacity = buffer_capacity;
+  for (int i = 0; i < n_queries; ++i)
+    capacity = Kokkos::max(capacity, host_offset(i + 1) - host_offset(i));
+
+  // Greedy chunking: a chunk closes right before the predicate whose results
+  // would push it past the capacity
+  std::vector<int> chunk_first{0};
+  for (int i = 0; i < n_queries; ++i)
+    if (host_offset(i + 1) - host_offset(chunk_first.back()) > capacity)
+      chunk_first.push_back(i);
+  chunk_first.push_back(n_queries);
+  int const num_chunks = (int)chunk_first.size() - 1;
+  int max_chunk_queries = 0;
+  for (int c = 0; c < num_chunks; ++c)
+    max_chunk_queries =
+        std::max(max_chunk_queries, chunk_first[c + 1] - chunk_first[c]);
+
+  // Double buffering: a chunk's drain to the host shares an instance with
+  // its own traversal and overlaps with the next chunk's traversal on the
+  // other one
+  auto instances = Kokkos::Experimental::partition_space(space, 1, 1);
+  int const num_buffers = std::min(num_chunks, 2);
+
+  BufferView buffers[2];
+  OffsetView chunk_offsets[2];
+  OffsetView cursors[2];
+  for (int b = 0; b < num_buffers; ++b)
+  {
+    buffers[b] = BufferView(
+        Kokkos::view_alloc(instances[b], Kokkos::WithoutInitializing,
+                           "ArborX::CrsGraphWrapper::query_to_host::buffer"),
+        capacity);
+    chunk_offsets[b] = OffsetView(
+        Kokkos::view_alloc(
+            instances[b], Kokkos::WithoutInitializing,
+            "ArborX::CrsGraphWrapper::query_to_host::chunk_offset"),
+        max_chunk_queries + 1);
+    cursors[b] = OffsetView(
+        Kokkos::view_alloc(instances[b], Kokkos::WithoutInitializing,
+                           "ArborX::CrsGraphWrapper::query_to_host::cursors"),
+        max_chunk_queries);
+  }
+
+  constexpr bool concurrent_callbacks =
+      TraversalInvokesCallbacksConcurrently<Tree>::value;
+
+  for (int c = 0; c < num_chunks; ++c)
+  {
+    auto const &instance = instances[c % num_buffers];
+    auto const &buffer = buffers[c % num_buffers];
+    auto const &chunk_offset = chunk_offsets[c % num_buffers];
+    auto const &cursor = cursors[c % num_buffers];
+
+    int const first = chunk_first[c];
+    int const chunk_queries = chunk_first[c + 1] - first;
+    OffsetType const results_begin = host_offset(first);
+    OffsetType const results_end = host_offset(first + chunk_queries);
+
+    // Rebase the chunk's slice of the offsets to the start of the buffer
+    Kokkos::parallel_for(
+        "ArborX::CrsGraphWrapper::query_to_host::rebase_chunk_offsets",
+        Kokkos::RangePolicy<ExecutionSpace>(instance, 0, chunk_queries + 1),
+        KOKKOS_LAMBDA(int j) {
+          chunk_offset(j) = offset(first + j) - offset(first);
+        });
+    Kokkos::deep_copy(instance, cursor, 0);
+
+    // The capacities are the exact counts, so this single buffered pass
+    // produces the chunk's complete results
+    tree.query(instance, RangeSubsetData<Predicates>{predicates, first,
+                                                     chunk_queries},
+               InsertGenerator<FirstPassTag, Callback, BufferView, OffsetView,
+                               OffsetView, concurrent_callbacks>{
+                   callback, buffer, cursor, chunk_offset},
+               Experimental::TraversalPolicy().setPredicateSorting(false));
+
+    Kokkos::deep_copy(
+        instance,
+        Kokkos::subview(host_values, std::make_pair(results_begin,
+                                                    results_end)),
+        Kokkos::subview(buffer,
+                        std::make_pair(OffsetType(0),
+                                       results_end - results_begin)));
+  }
+
+  for (int b = 0; b < num_buffers; ++b)
+    instances[b].fence("ArborX::CrsGraphWrapper::query_to_host (drained)");
+}
+
 template <typename Value, typename Callback, typename Predicates,
           typename OutputView>
 std::enable_if_t<!Kokkos::is_view_v<Callback> &&
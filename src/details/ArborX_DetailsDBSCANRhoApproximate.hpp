@@ -0,0 +1,204 @@
+/****************************************************************************
+ * Copyright (c) 2017-2022 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILSDBSCANRHOAPPROXIMATE_HPP
+#define ARBORX_DETAILSDBSCANRHOAPPROXIMATE_HPP
+
+#include <ArborX_DetailsCartesianGrid.hpp>
+#include <ArborX_DetailsKokkosExtMinMaxOperations.hpp>
+#include <ArborX_GeometryTraits.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX
+{
+namespace Details
+{
+
+// Locate a cell in the ascending array of nonempty cell indices, returning
+// its ordinal or -1 if the cell is empty
+template <typename UniqueCellIndices>
+KOKKOS_FUNCTION int findCellOrdinal(UniqueCellIndices const &cells,
+                                    size_t cell_index)
+{
+  int first = 0;
+  int last = cells.size();
+  while (first < last)
+  {
+    int const mid = first + (last - first) / 2;
+    if (cells(mid) < cell_index)
+      first = mid + 1;
+    else
+      last = mid;
+  }
+  if (first == (int)cells.size() || cells(first) != cell_index)
+    return -1;
+  return first;
+}
+
+// Invoke f with the ordinal and the squared minimum cell-to-cell distance of
+// every nonempty cell (including the center itself, at distance zero) within
+// `radius` cells of the given one. Stop early as soon as f returns true.
+template <int DIM, typename UniqueCellIndices, typename F>
+KOKKOS_FUNCTION void
+forEachCellWithinRadius(CartesianGrid<DIM> const &grid,
+                        UniqueCellIndices const &cells, int ordinal, float h,
+                        int radius, F const &f)
+{
+  int multi_index[DIM];
+  {
+    auto s = cells(ordinal);
+    for (int d = 0; d < DIM; ++d)
+    {
+      multi_index[d] = s % grid.extent(d);
+      s /= grid.extent(d);
+    }
+  }
+
+  int const width = 2 * radius + 1;
+  int num_stencil_cells = 1;
+  for (int d = 0; d < DIM; ++d)
+    num_stencil_cells *= width;
+
+  for (int m = 0; m < num_stencil_cells; ++m)
+  {
+    int neighbor_index[DIM];
+    bool out_of_bounds = false;
+    float min_dist_sq = 0;
+    int rem = m;
+    for (int d = 0; d < DIM; ++d)
+    {
+      int const k = rem % width - radius;
+      rem /= width;
+      neighbor_index[d] = multi_index[d] + k;
+      out_of_bounds |= (neighbor_index[d] < 0 ||
+                        neighbor_index[d] >= (int)grid.extent(d));
+
+      // Cells separated by k steps along an axis are at least (|k|-1)*h
+      // apart in that direction
+      int const gap = KokkosExt::max((k < 0 ? -k : k) - 1, 0);
+      min_dist_sq += (gap * h) * (gap * h);
+    }
+    if (out_of_bounds)
+      continue;
+
+    // Match the index linearization of CartesianGrid::cellIndex()
+    size_t neighbor_cell = 0;
+    for (int d = DIM - 1; d >= 0; --d)
+      neighbor_cell = neighbor_cell * grid.extent(d) + neighbor_index[d];
+
+    int const c = findCellOrdinal(cells, neighbor_cell);
+    if (c < 0)
+      continue;
+
+    if (f(c, min_dist_sq))
+      break;
+  }
+}
+
+// Approximate per-cell neighbor counts: the occupancy summed over every cell
+// whose minimum distance is within eps. For any point of the cell this is an
+// upper bound on its true eps-neighbor count (every true neighbor lies in
+// one of the summed cells), tight up to points in the summed cells that are
+// just beyond eps.
+template <typename ExecutionSpace, int DIM, typename UniqueCellIndices,
+          typename CellOffsets, typename MemorySpace>
+void countCellOccupancyWithinRadius(
+    ExecutionSpace const &exec_space, CartesianGrid<DIM> const &grid,
+    UniqueCellIndices const &unique_cell_indices,
+    CellOffsets const &cell_offsets, float h, float eps,
+    Kokkos::View<int *, MemorySpace> const &cell_counts)
+{
+  int const num_cells = unique_cell_indices.size();
+  int const radius = (int)Kokkos::floor(eps / h) + 1;
+  Kokkos::parallel_for(
+      "ArborX::DBSCAN::count_cell_occupancy",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_cells),
+      KOKKOS_LAMBDA(int c) {
+        int count = 0;
+        forEachCellWithinRadius(grid, unique_cell_indices, c, h, radius,
+                                [&](int cc, float min_dist_sq) {
+                                  if (min_dist_sq <= eps * eps)
+                                    count += cell_offsets(cc + 1) -
+                                             cell_offsets(cc);
+                                  return false;
+                                });
+        cell_counts(c) = count;
+      });
+}
+
+// Cell-granularity clustering: the points of a core cell (approximate count
+// at least core_min_size) all join their cell's cluster, core cells whose
+// minimum distance is within eps are merged, and the points of a non-core
+// cell attach to the first nearby core cell as border points. No
+// point-to-point distance is ever computed.
+template <typename ExecutionSpace, int DIM, typename UniqueCellIndices,
+          typename CellOffsets, typename Permutation, typename CellCounts,
+          typename UnionFind>
+void unionFindCells(ExecutionSpace const &exec_space,
+                    CartesianGrid<DIM> const &grid,
+                    UniqueCellIndices const &unique_cell_indices,
+                    CellOffsets const &cell_offsets,
+                    Permutation const &permute, float h, float eps,
+                    CellCounts const &cell_counts, int core_min_size,
+                    UnionFind union_find)
+{
+  int const num_cells = unique_cell_indices.size();
+  int const radius = (int)Kokkos::floor(eps / h) + 1;
+  Kokkos::parallel_for(
+      "ArborX::DBSCAN::union_find_cells",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_cells),
+      KOKKOS_LAMBDA(int c) {
+        int const begin = cell_offsets(c);
+        int const end = cell_offsets(c + 1);
+        int const rep = permute(begin);
+
+        if (cell_counts(c) >= core_min_size)
+        {
+          for (int jj = begin + 1; jj < end; ++jj)
+            union_find.merge(permute(jj), rep);
+
+          forEachCellWithinRadius(
+              grid, unique_cell_indices, c, h, radius,
+              [&](int cc, float min_dist_sq) {
+                // Each core-core pair is visited from both sides, only
+                // process it from the larger ordinal
+                if (cc < c && min_dist_sq <= eps * eps &&
+                    cell_counts(cc) >= core_min_size)
+                  union_find.merge(rep, permute(cell_offsets(cc)));
+                return false;
+              });
+        }
+        else
+        {
+          forEachCellWithinRadius(
+              grid, unique_cell_indices, c, h, radius,
+              [&](int cc, float min_dist_sq) {
+                if (min_dist_sq > eps * eps ||
+                    cell_counts(cc) < core_min_size)
+                  return false;
+
+                // Merge the border points in without the risk of making them
+                // representatives and forming a bridge with a different
+                // cluster (see NOTE in FDBSCANCallback)
+                int const core_rep = permute(cell_offsets(cc));
+                for (int jj = begin; jj < end; ++jj)
+                  union_find.merge_into(permute(jj), core_rep);
+                return true;
+              });
+        }
+      });
+}
+
+} // namespace Details
+} // namespace ArborX
+
+#endif
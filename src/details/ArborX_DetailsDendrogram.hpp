@@ -13,10 +13,15 @@
 #define ARBORX_DETAILS_DENDROGRAM_HPP
 
 #include <ArborX_DetailsKokkosExtStdAlgorithms.hpp> // iota
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp> // cloneWithoutInitializingNorCopying
+#include <ArborX_DetailsMinimumSpanningTree.hpp> // FOLLOW_CHAIN_VALUE, ROOT_CHAIN_VALUE
+#include <ArborX_DetailsSortUtils.hpp> // sortObjects
 #include <ArborX_DetailsUnionFind.hpp>
 
 #include <Kokkos_Core.hpp>
 
+#include <utility> // swap
+
 namespace ArborX::Details
 {
 
@@ -83,6 +88,8 @@ void dendrogramUnionFindHost(Edges sorted_edges_host, Parents &parents_host)
   Kokkos::Profiling::popRegion();
 }
 
+// Serial host implementation, kept around as a reference for
+// dendrogramAlphaTree()
 template <typename ExecutionSpace, typename MemorySpace>
 void dendrogramUnionFind(
     ExecutionSpace const &exec_space,
@@ -116,6 +123,271 @@ void dendrogramUnionFind(
   Kokkos::Profiling::popRegion();
 }
 
+// Build the dendrogram entirely on device using alpha edges.
+//
+// An edge is an alpha edge if both of its children in the dendrogram are
+// edges. Non-alpha edges within an alpha-vertex (a component connected by
+// non-alpha edges) form a single chain in the dendrogram, allowing their
+// parents to be assigned independently through a sort. Alpha edges are
+// processed recursively on the contracted graph. This is the standalone
+// counterpart of the chain machinery fused into Boruvka's algorithm (see
+// updateSidedParents() and computeParents() in
+// ArborX_DetailsMinimumSpanningTree.hpp), and uses the same sided parent
+// encoding.
+template <typename ExecutionSpace, typename MemorySpace>
+void dendrogramAlphaTree(
+    ExecutionSpace const &exec_space,
+    Kokkos::View<UnweightedEdge const *, MemorySpace> sorted_edges,
+    Kokkos::View<int *, MemorySpace> &parents)
+{
+  Kokkos::Profiling::pushRegion("ArborX::Dendrogram::dendrogram_alpha_tree");
+
+  int const num_edges = sorted_edges.size();
+  int const num_vertices = num_edges + 1;
+  int const vertices_offset = num_edges;
+
+  if (num_edges == 0)
+  {
+    Kokkos::deep_copy(exec_space, parents, -1);
+    Kokkos::Profiling::popRegion();
+    return;
+  }
+
+  Kokkos::View<int *, MemorySpace> labels(
+      Kokkos::view_alloc(
+          exec_space, Kokkos::WithoutInitializing,
+          "ArborX::Dendrogram::dendrogram_alpha_tree::labels"),
+      num_vertices);
+  KokkosExt::iota(exec_space, labels);
+  UnionFind<MemorySpace> union_find(labels);
+
+  Kokkos::View<int *, MemorySpace> sided_parents(
+      Kokkos::view_alloc(
+          exec_space, Kokkos::WithoutInitializing,
+          "ArborX::Dendrogram::dendrogram_alpha_tree::sided_parents"),
+      num_edges);
+  Kokkos::View<int *, MemorySpace> smallest_incident(
+      Kokkos::view_alloc(
+          exec_space, Kokkos::WithoutInitializing,
+          "ArborX::Dendrogram::dendrogram_alpha_tree::smallest_incident"),
+      num_vertices);
+  Kokkos::View<int *, MemorySpace> is_alpha(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::Dendrogram::dendrogram_alpha_tree::is_alpha"),
+      num_edges);
+  Kokkos::View<int *, MemorySpace> edge_indices(
+      Kokkos::view_alloc(
+          exec_space, Kokkos::WithoutInitializing,
+          "ArborX::Dendrogram::dendrogram_alpha_tree::edge_indices"),
+      num_edges);
+  KokkosExt::iota(exec_space, edge_indices);
+  auto next_edge_indices =
+      KokkosExt::cloneWithoutInitializingNorCopying(exec_space, edge_indices);
+
+  int num_active = num_edges;
+  int level = 0;
+  do
+  {
+    // Find the smallest active edge incident to every alpha-vertex. As the
+    // edges are sorted by weight, comparing indices compares weights.
+    Kokkos::deep_copy(exec_space, smallest_incident, INT_MAX);
+    Kokkos::parallel_for(
+        "ArborX::Dendrogram::alpha_tree::find_smallest_incident_edges",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_active),
+        KOKKOS_LAMBDA(int k) {
+          int const e = edge_indices(k);
+          auto const &edge = sorted_edges(e);
+          Kokkos::atomic_min(
+              &smallest_incident(union_find.representative(edge.source)), e);
+          Kokkos::atomic_min(
+              &smallest_incident(union_find.representative(edge.target)), e);
+        });
+
+    if (level == 0)
+    {
+      // The parent of a vertex is the smallest edge incident to it
+      Kokkos::parallel_for(
+          "ArborX::Dendrogram::alpha_tree::compute_vertex_parents",
+          Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_vertices),
+          KOKKOS_LAMBDA(int i) {
+            parents(vertices_offset + i) = smallest_incident(i);
+          });
+    }
+
+    // An edge is an alpha edge if each of its sides contains a smaller
+    // active edge, i.e., if it is not the smallest edge incident to either
+    // of its alpha-vertices
+    Kokkos::parallel_for(
+        "ArborX::Dendrogram::alpha_tree::determine_alpha_edges",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_active),
+        KOKKOS_LAMBDA(int k) {
+          int const e = edge_indices(k);
+          auto const &edge = sorted_edges(e);
+          is_alpha(k) =
+              (smallest_incident(union_find.representative(edge.source)) !=
+                   e &&
+               smallest_incident(union_find.representative(edge.target)) != e);
+        });
+
+    int num_alpha;
+    Kokkos::parallel_scan(
+        "ArborX::Dendrogram::alpha_tree::compact_alpha_edges",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_active),
+        KOKKOS_LAMBDA(int k, int &partial_sum, bool is_final) {
+          if (is_final && is_alpha(k))
+            next_edge_indices(partial_sum) = edge_indices(k);
+          partial_sum += is_alpha(k);
+        },
+        num_alpha);
+
+    if (num_alpha == 0)
+    {
+      // The remaining edges form a single chain ending at the root
+      Kokkos::parallel_for(
+          "ArborX::Dendrogram::alpha_tree::set_root_chain",
+          Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_active),
+          KOKKOS_LAMBDA(int k) {
+            sided_parents(edge_indices(k)) = ROOT_CHAIN_VALUE;
+          });
+      break;
+    }
+
+    // Contract the non-alpha edges to form the alpha-vertices of the next
+    // level
+    Kokkos::parallel_for(
+        "ArborX::Dendrogram::alpha_tree::contract_edges",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_active),
+        KOKKOS_LAMBDA(int k) {
+          if (!is_alpha(k))
+          {
+            auto const &edge = sorted_edges(edge_indices(k));
+            union_find.merge(edge.source, edge.target);
+          }
+        });
+
+    // Find the smallest alpha edge incident to every new alpha-vertex,
+    // reusing the smallest incident array
+    Kokkos::deep_copy(exec_space, smallest_incident, INT_MAX);
+    Kokkos::parallel_for(
+        "ArborX::Dendrogram::alpha_tree::find_smallest_incident_alpha_edges",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_active),
+        KOKKOS_LAMBDA(int k) {
+          if (is_alpha(k))
+          {
+            int const e = edge_indices(k);
+            auto const &edge = sorted_edges(e);
+            Kokkos::atomic_min(
+                &smallest_incident(union_find.representative(edge.source)), e);
+            Kokkos::atomic_min(
+                &smallest_incident(union_find.representative(edge.target)), e);
+          }
+        });
+
+    // Assign sided parents to the edges resolved at this level (same
+    // encoding as updateSidedParents() in the fused Boruvka version)
+    Kokkos::parallel_for(
+        "ArborX::Dendrogram::alpha_tree::update_sided_parents",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_active),
+        KOKKOS_LAMBDA(int k) {
+          if (is_alpha(k))
+            return;
+
+          int const e = edge_indices(k);
+          auto const &edge = sorted_edges(e);
+
+          // As the edge was contracted, representatives of its vertices are
+          // the same, so can take either
+          int const component = union_find.representative(edge.source);
+          int const alpha_edge_index = smallest_incident(component);
+
+          if (e < alpha_edge_index)
+          {
+            auto const &alpha_edge = sorted_edges(alpha_edge_index);
+            bool const is_left_side =
+                (union_find.representative(alpha_edge.source) == component);
+            sided_parents(e) =
+                2 * alpha_edge_index + static_cast<int>(is_left_side);
+          }
+          else
+          {
+            sided_parents(e) = FOLLOW_CHAIN_VALUE - alpha_edge_index;
+          }
+        });
+
+    std::swap(edge_indices, next_edge_indices);
+    num_active = num_alpha;
+    ++level;
+  } while (true);
+
+  // Resolve the chains and assign edge parents (see computeParents() in
+  // ArborX_DetailsMinimumSpanningTree.hpp). As the edges are already sorted
+  // by weight, the edge index takes the place of the weight in the key, with
+  // the added benefit that the keys are unique and ties need no fixup.
+  Kokkos::View<long long *, MemorySpace> keys(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::Dendrogram::dendrogram_alpha_tree::keys"),
+      num_edges);
+
+  constexpr int shift = sizeof(int) * CHAR_BIT;
+
+  Kokkos::parallel_for(
+      "ArborX::Dendrogram::alpha_tree::compute_sided_alpha_parents",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_edges),
+      KOKKOS_LAMBDA(int const e) {
+        long long key = sided_parents(e);
+        if (key <= FOLLOW_CHAIN_VALUE)
+        {
+          int next = FOLLOW_CHAIN_VALUE - key;
+          do
+          {
+            key = sided_parents(next);
+            if (key <= FOLLOW_CHAIN_VALUE)
+              next = FOLLOW_CHAIN_VALUE - key;
+            else if (key >= 0)
+            {
+              next = key / 2;
+              if (e < next)
+                break;
+            }
+            else if (key == ROOT_CHAIN_VALUE)
+              break;
+          } while (true);
+        }
+        if (key == ROOT_CHAIN_VALUE)
+          key = INT_MAX;
+
+        keys(e) = (key << shift) + e;
+      });
+
+  auto permute = sortObjects(exec_space, keys);
+
+  Kokkos::parallel_for(
+      "ArborX::Dendrogram::alpha_tree::compute_parents",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_edges),
+      KOKKOS_LAMBDA(int const i) {
+        int e = permute(i);
+        if (i == num_edges - 1)
+        {
+          // The parent of the root node is set to -1
+          parents(e) = -1;
+        }
+        else if ((keys(i) >> shift) == (keys(i + 1) >> shift))
+        {
+          // For the edges belonging to the same chain, assign the parent of
+          // an edge to the edge with the next larger value
+          parents(e) = permute(i + 1);
+        }
+        else
+        {
+          // For an edge which points to the root of a chain, assign edge's
+          // parent to be that root
+          parents(e) = (keys(i) >> shift) / 2;
+        }
+      });
+
+  Kokkos::Profiling::popRegion();
+}
+
 } // namespace ArborX::Details
 
 #endif
@@ -47,15 +47,67 @@ struct DistributedTreeImpl
                             Predicates const &predicates,
                             Callback const &callback);
 
-  // nearest neighbors queries
+  // streaming spatial queries: on top of assembling the regular merged
+  // output, hand every responding rank's result segment to a user callback
+  // as its messages land
+  template <typename DistributedTree, typename ExecutionSpace,
+            typename Predicates, typename Callback, typename Values,
+            typename Offset, typename SegmentCallback>
+  static std::enable_if_t<Kokkos::is_view_v<Values> &&
+                          Kokkos::is_view_v<Offset>>
+  queryDispatchStreaming(SpatialPredicateTag, DistributedTree const &tree,
+                         ExecutionSpace const &space, Predicates const &queries,
+                         Callback const &callback, Values &values,
+                         Offset &offset, SegmentCallback const &on_segment);
+
+  // ordered queries (e.g. rays reporting their first k crossings), answered
+  // in cross-rank traversal order
+  template <typename DistributedTree, typename ExecutionSpace,
+            typename Predicates, typename Values, typename Offset>
+  static std::enable_if_t<Kokkos::is_view_v<Values> &&
+                          Kokkos::is_view_v<Offset>>
+  queryDispatch(OrderedSpatialPredicateTag, DistributedTree const &tree,
+                ExecutionSpace const &space, Predicates const &queries,
+                Values &values, Offset &offset);
+
+  template <typename DistributedTree, typename ExecutionSpace,
+            typename Predicates, typename Values, typename Offset,
+            typename Callback>
+  static std::enable_if_t<Kokkos::is_view_v<Values> &&
+                          Kokkos::is_view_v<Offset>>
+  queryDispatch(OrderedSpatialPredicateTag, DistributedTree const &tree,
+                ExecutionSpace const &space, Predicates const &queries,
+                Callback const &callback, Values &values, Offset &offset);
+
+  // halo replication helper: true when every predicate fits within the
+  // halo-expanded local bounds and can be answered without communication
+  template <typename DistributedTree, typename ExecutionSpace,
+            typename Predicates>
+  static bool coveredByHalo(DistributedTree const &tree,
+                            ExecutionSpace const &space,
+                            Predicates const &predicates);
+
+  // nearest neighbors queries; the driver picks between the two-round
+  // (count-then-fill) protocol and an eager one-round protocol bounded by the
+  // replicated sample centroids, based on an estimate of the result payload
   template <typename DistributedTree, typename ExecutionSpace,
             typename Predicates, typename Callback, typename Indices,
             typename Offset>
   static void
-  queryDispatch2RoundImpl(NearestPredicateTag, DistributedTree const &tree,
-                          ExecutionSpace const &space,
-                          Predicates const &queries, Callback const &callback,
-                          Indices &indices, Offset &offset);
+  queryDispatchAdaptiveImpl(NearestPredicateTag, DistributedTree const &tree,
+                            ExecutionSpace const &space,
+                            Predicates const &queries, Callback const &callback,
+                            Indices &indices, Offset &offset);
+
+  // one-round protocol selector; on success the distance bounds computed from
+  // the replicated sample centroids are left behind for the caller to reuse
+  template <typename DistributedTree, typename ExecutionSpace,
+            typename Predicates, typename Distances>
+  static bool nearestOneRoundViable(DistributedTree const &tree,
+                                    ExecutionSpace const &space,
+                                    Predicates const &predicates,
+                                    Distances &farthest_distances,
+                                    int result_bytes);
 
   template <typename DistributedTree, typename ExecutionSpace,
             typename Predicates, typename Values, typename Offset>
@@ -11,9 +11,11 @@
 #ifndef ARBORX_DETAILS_DISTRIBUTED_TREE_NEAREST_HPP
 #define ARBORX_DETAILS_DISTRIBUTED_TREE_NEAREST_HPP
 
+#include <ArborX_DetailsAlgorithms.hpp>
 #include <ArborX_DetailsDistributedTreeImpl.hpp>
 #include <ArborX_DetailsDistributedTreeNearestHelpers.hpp>
 #include <ArborX_DetailsDistributedTreeUtils.hpp>
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
 #include <ArborX_DetailsKokkosExtKernelStdAlgorithms.hpp>
 #include <ArborX_DetailsKokkosExtMinMaxOperations.hpp>
 #include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
@@ -23,7 +25,9 @@
 #include <Kokkos_Core.hpp>
 #include <Kokkos_Profiling_ScopedRegion.hpp>
 
-// Don't really need it, but our self containment tests rely on its presence
+#include <cstdlib>
+#include <limits>
+
 #include <mpi.h>
 
 namespace ArborX::Details
@@ -36,6 +40,57 @@ struct PairValueDistance
   float distance;
 };
 
+// Result payload threshold (in bytes) under which a nearest query uses the
+// eager one-round protocol instead of the two-round one. Controlled by the
+// ARBORX_EAGER_NEAREST_MAX_BYTES environment variable; set to 0 to always use
+// the two-round protocol.
+inline long long eagerNearestMaxBytes()
+{
+  static long long const value = [] {
+    char const *env = std::getenv("ARBORX_EAGER_NEAREST_MAX_BYTES");
+    return (env != nullptr ? std::atoll(env) : (1ll << 20));
+  }();
+  return value;
+}
+
+// Distance from the geometry to the k-th closest of the replicated sample
+// centroids, a valid upper bound on the k-th nearest-neighbor distance: every
+// sample is the centroid of a real stored object and thus no closer to the
+// geometry than the object itself. Returns infinity when fewer than k samples
+// are available.
+template <int sample_size, typename Geometry, typename Centroids,
+          typename Sizes>
+KOKKOS_FUNCTION float sampleDistanceBound(Geometry const &geometry, int k,
+                                          Centroids const &sample_centroids,
+                                          Sizes const &bottom_tree_sizes)
+{
+  int const num_ranks = sample_centroids.extent(0) / sample_size;
+
+  // k smallest sample distances seen so far, sorted ascending
+  float nearest[sample_size];
+  int filled = 0;
+  for (int r = 0; r < num_ranks; ++r)
+  {
+    int const count =
+        KokkosExt::min((int)bottom_tree_sizes(r), sample_size);
+    for (int s = 0; s < count; ++s)
+    {
+      float const d = distance(geometry, sample_centroids(r * sample_size + s));
+      if (filled == k && d >= nearest[k - 1])
+        continue;
+      int pos = (filled < k ? filled++ : k - 1);
+      while (pos > 0 && nearest[pos - 1] > d)
+      {
+        nearest[pos] = nearest[pos - 1];
+        --pos;
+      }
+      nearest[pos] = d;
+    }
+  }
+  return filled == k ? nearest[k - 1]
+                     : KokkosExt::ArithmeticTraits::infinity<float>::value;
+}
+
 template <typename ExecutionSpace, typename Tree, typename Predicates,
           typename Distances>
 void DistributedTreeImpl::phaseI(ExecutionSpace const &space, Tree const &tree,
@@ -54,6 +109,8 @@ void DistributedTreeImpl::phaseI(ExecutionSpace const &space, Tree const &tree,
   Kokkos::View<int *, MemorySpace> offset(prefix + "::offset", 0);
   Kokkos::View<int *, MemorySpace> nearest_ranks(prefix + "::nearest_ranks", 0);
   tree._top_tree.query(space, predicates, nearest_ranks, offset);
+  // Keeping the first occurrence preserves the ordering by distance
+  deduplicateRanks(space, nearest_ranks, offset);
 
   // Accumulate total leave count in the local trees until it reaches k which
   // is the number of neighbors queried for.  Stop if local trees get
@@ -107,21 +164,41 @@ void DistributedTreeImpl::phaseI(ExecutionSpace const &space, Tree const &tree,
       comm, space, bottom_tree, predicates,
       CallbackWithDistance<BottomTree, DefaultCallback, float, false>(
           space, bottom_tree, DefaultCallback{}),
-      nearest_ranks, offset, distances);
-
-  // Postprocess distances to find the k-th farthest
+      nearest_ranks, offset, distances, tree.getPlanCache());
+
+  // Postprocess distances to find the k-th farthest. The estimate is then
+  // tightened with the replicated sample centroids: every sample is the
+  // centroid of a real stored object and thus no closer to the query than
+  // the object itself, so the k-th closest sample is a valid upper bound on
+  // the k-th nearest-neighbor distance. Scanning every rank's samples
+  // catches near ranks that the bounding-volume-guided forwarding above may
+  // have passed over, which is exactly where the box-based estimate gets
+  // loose on irregular domains.
+  constexpr int sample_size = Tree::sample_centroids_per_rank;
+  auto const &sample_centroids = tree._sample_centroids;
   Kokkos::parallel_for(
       prefix + "::compute_farthest_distances",
       Kokkos::RangePolicy<ExecutionSpace>(space, 0, predicates.size()),
       KOKKOS_LAMBDA(int i) {
+        int const k = getK(predicates(i));
         auto const num_distances = offset(i + 1) - offset(i);
-        if (num_distances == 0)
-          return;
 
-        auto const k = KokkosExt::min(getK(predicates(i)), num_distances) - 1;
-        auto *begin = distances.data() + offset(i);
-        KokkosExt::nth_element(begin, begin + k, begin + num_distances);
-        farthest_distances(i) = *(begin + k);
+        float bound = KokkosExt::ArithmeticTraits::infinity<float>::value;
+        if (num_distances > 0)
+        {
+          auto const j = KokkosExt::min(k, num_distances) - 1;
+          auto *begin = distances.data() + offset(i);
+          KokkosExt::nth_element(begin, begin + j, begin + num_distances);
+          bound = *(begin + j);
+        }
+
+        if (k <= sample_size)
+          bound = KokkosExt::min(
+              bound, sampleDistanceBound<sample_size>(getGeometry(predicates(i)),
+                                                      k, sample_centroids,
+                                                      bottom_tree_sizes));
+
+        farthest_distances(i) = bound;
       });
 }
 
@@ -144,6 +221,7 @@ void DistributedTreeImpl::phaseII(ExecutionSpace const &space, Tree const &tree,
                        WithinDistanceFromPredicates<Predicates, Distances>{
                            predicates, distances},
                        nearest_ranks, offset);
+  DistributedTree::deduplicateRanks(space, nearest_ranks, offset);
 
   auto const &bottom_tree = tree._bottom_tree;
   using BottomTree = std::decay_t<decltype(bottom_tree)>;
@@ -152,11 +230,15 @@ void DistributedTreeImpl::phaseII(ExecutionSpace const &space, Tree const &tree,
   // rather than nearest predicates.
   Kokkos::View<PairValueDistance<typename Values::value_type> *, MemorySpace>
       out(prefix + "::pairs_value_distance", 0);
+  // Forward the phase one bound together with each predicate: the receiving
+  // ranks start their traversals with the radius already tightened to the
+  // k-th distance, pruning most of the forwarded work up front
   DistributedTree::forwardQueriesAndCommunicateResults(
-      tree.getComm(), space, bottom_tree, predicates,
+      tree.getComm(), space, bottom_tree,
+      BoundedNearestPredicates<Predicates, Distances>{predicates, distances},
       CallbackWithDistance<BottomTree, Callback, typename Values::value_type,
                            true>(space, bottom_tree, callback),
-      nearest_ranks, offset, out);
+      nearest_ranks, offset, out, tree.getPlanCache());
 
   // Unzip
   auto n = out.extent(0);
@@ -172,9 +254,96 @@ void DistributedTreeImpl::phaseII(ExecutionSpace const &space, Tree const &tree,
   DistributedTree::filterResults(space, predicates, distances, values, offset);
 }
 
+// Decide between the eager one-round and the two-round nearest protocols.
+// The one-round protocol forwards the predicates bounded by the k-th sample
+// centroid distance right away: the bound costs no communication but is
+// looser than the phase one estimate, so more ranks are contacted and every
+// contacted rank sends back a full batch of k results. Small payloads are
+// latency-bound and win from dropping an entire network round-trip; large
+// payloads are better off paying the extra round for the tighter bound. On
+// success the computed bounds are left in `farthest_distances` for the caller
+// to reuse.
+template <typename Tree, typename ExecutionSpace, typename Predicates,
+          typename Distances>
+bool DistributedTreeImpl::nearestOneRoundViable(Tree const &tree,
+                                                ExecutionSpace const &space,
+                                                Predicates const &predicates,
+                                                Distances &farthest_distances,
+                                                int result_bytes)
+{
+  std::string prefix =
+      "ArborX::DistributedTree::query::nearest::select_protocol";
+  Kokkos::Profiling::ScopedRegion guard(prefix);
+
+  using namespace DistributedTree;
+  using MemorySpace = typename Tree::memory_space;
+
+  long long const max_bytes = eagerNearestMaxBytes();
+  if (max_bytes <= 0)
+    return false;
+
+  constexpr int sample_size = Tree::sample_centroids_per_rank;
+  auto const &sample_centroids = tree._sample_centroids;
+  auto const &bottom_tree_sizes = tree._bottom_tree_sizes;
+
+  // Upper bounds on the k-th nearest-neighbor distances from the replicated
+  // sample centroids alone
+  int num_unbounded;
+  Kokkos::parallel_reduce(
+      prefix + "::compute_sample_bounds",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, predicates.size()),
+      KOKKOS_LAMBDA(int i, int &update) {
+        constexpr float inf =
+            KokkosExt::ArithmeticTraits::infinity<float>::value;
+        int const k = getK(predicates(i));
+        float bound = inf;
+        if (k <= sample_size)
+          bound = sampleDistanceBound<sample_size>(getGeometry(predicates(i)),
+                                                   k, sample_centroids,
+                                                   bottom_tree_sizes);
+        farthest_distances(i) = bound;
+        if (bound == inf)
+          ++update;
+      },
+      num_unbounded);
+
+  long long payload = std::numeric_limits<long long>::max();
+  if (num_unbounded == 0)
+  {
+    // The top tree is replicated, so probing which ranks the bounds reach is
+    // local and cheap; the second phase repeats this query
+    Kokkos::View<int *, MemorySpace> nearest_ranks(prefix + "::nearest_ranks",
+                                                   0);
+    Kokkos::View<int *, MemorySpace> offset(prefix + "::offset", 0);
+    tree._top_tree.query(space,
+                         WithinDistanceFromPredicates<Predicates, Distances>{
+                             predicates, farthest_distances},
+                         nearest_ranks, offset);
+    deduplicateRanks(space, nearest_ranks, offset);
+
+    long long num_results;
+    Kokkos::parallel_reduce(
+        prefix + "::estimate_payload",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, predicates.size()),
+        KOKKOS_LAMBDA(int i, long long &update) {
+          update +=
+              (long long)(offset(i + 1) - offset(i)) * getK(predicates(i));
+        },
+        num_results);
+    payload = num_results * result_bytes;
+  }
+
+  // The forwarding exchanges are collective, so all ranks have to agree on
+  // the protocol; a latency-only reduction is far cheaper than the round it
+  // may save
+  MPI_Allreduce(MPI_IN_PLACE, &payload, 1, MPI_LONG_LONG, MPI_MAX,
+                tree.getComm());
+  return payload <= max_bytes;
+}
+
 template <typename Tree, typename ExecutionSpace, typename Predicates,
           typename Callback, typename Values, typename Offset>
-void DistributedTreeImpl::queryDispatch2RoundImpl(
+void DistributedTreeImpl::queryDispatchAdaptiveImpl(
     NearestPredicateTag, Tree const &tree, ExecutionSpace const &space,
     Predicates const &predicates, Callback const &callback, Values &values,
     Offset &offset)
@@ -198,6 +367,19 @@ void DistributedTreeImpl::queryDispatch2RoundImpl(
                          prefix + "::farthest_distances"),
       predicates.size());
 
+  // The sample-centroid bounds computed during protocol selection are valid
+  // upper bounds on the k-th nearest-neighbor distances, so when the payload
+  // they imply is small the second phase alone returns the exact result and
+  // the first communication round is skipped entirely.
+  if (nearestOneRoundViable(
+          tree, space, predicates, farthest_distances,
+          (int)sizeof(PairValueDistance<typename Values::value_type>)))
+  {
+    phaseII(space, tree, predicates, callback, farthest_distances, offset,
+            values);
+    return;
+  }
+
   // In the first phase, the predicates are sent to as many ranks as necessary
   // to guarantee that all k neighbors queried for are found. The farthest
   // distances are determined to reduce the communication in the second phase.
@@ -222,7 +404,7 @@ DistributedTreeImpl::queryDispatch(NearestPredicateTag tag, Tree const &tree,
                                    Predicates const &predicates, Values &values,
                                    Offset &offset)
 {
-  queryDispatch2RoundImpl(tag, tree, space, predicates, DefaultCallback{},
+  queryDispatchAdaptiveImpl(tag, tree, space, predicates, DefaultCallback{},
                           values, offset);
 }
 
@@ -237,8 +419,8 @@ DistributedTreeImpl::queryDispatch(NearestPredicateTag, Tree const &tree,
 {
   if constexpr (is_constrained_callback_v<Callback>)
   {
-    queryDispatch2RoundImpl(NearestPredicateTag{}, tree, space, predicates,
-                            callback, values, offset);
+    queryDispatchAdaptiveImpl(NearestPredicateTag{}, tree, space, predicates,
+                              callback, values, offset);
   }
   else
   {
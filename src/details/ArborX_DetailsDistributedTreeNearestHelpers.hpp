@@ -14,8 +14,10 @@
 #include <ArborX_AccessTraits.hpp>
 #include <ArborX_Box.hpp>
 #include <ArborX_DetailsHappyTreeFriends.hpp>
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
 #include <ArborX_LinearBVH.hpp>
 #include <ArborX_Point.hpp>
+#include <ArborX_Predicates.hpp>
 #include <ArborX_Ray.hpp>
 #include <ArborX_Sphere.hpp>
 
@@ -96,6 +98,33 @@ struct WithinDistanceFromPredicates
   Distances distances;
 };
 
+// Predicates annotated with the phase one farthest distances, so that the
+// ranks receiving the forwarded queries can start their traversals with a
+// tightened radius instead of rediscovering the bound from scratch
+template <class Predicates, class Distances>
+struct BoundedNearestPredicates
+{
+  Predicates _predicates;
+  Distances _distances;
+
+  using value_type =
+      PredicateWithInitialBound<typename Predicates::value_type>;
+  using memory_space = typename Predicates::memory_space;
+
+  KOKKOS_FUNCTION auto size() const { return _predicates.size(); }
+
+  KOKKOS_FUNCTION value_type operator()(int i) const
+  {
+    // The traversal discards nodes at distances greater than or equal to
+    // the current radius, so nudge the bound up to keep neighbors exactly
+    // at the k-th distance
+    return {_predicates(i),
+            Kokkos::nextafter(
+                _distances(i),
+                KokkosExt::ArithmeticTraits::infinity<float>::value)};
+  }
+};
+
 namespace Dispatch
 {
 
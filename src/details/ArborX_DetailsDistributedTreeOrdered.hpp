@@ -0,0 +1,385 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#ifndef ARBORX_DETAILS_DISTRIBUTED_TREE_ORDERED_HPP
+#define ARBORX_DETAILS_DISTRIBUTED_TREE_ORDERED_HPP
+
+#include <ArborX_Callbacks.hpp>
+#include <ArborX_DetailsDistributedTreeImpl.hpp>
+#include <ArborX_DetailsDistributedTreeUtils.hpp>
+#include <ArborX_DetailsKokkosExtMinMaxOperations.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_Predicates.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <mpi.h>
+
+namespace ArborX
+{
+
+namespace Details
+{
+// Same geometries without the match limit: the per-rank summary volumes a
+// geometry crosses do not map one-to-one to matches, so the top tree has to
+// report every candidate rank regardless of the predicate's k
+template <class Predicates>
+struct UnlimitedOrderedPredicates
+{
+  Predicates predicates;
+};
+} // namespace Details
+
+template <class Predicates>
+struct AccessTraits<Details::UnlimitedOrderedPredicates<Predicates>,
+                    PredicatesTag>
+{
+  using Self = Details::UnlimitedOrderedPredicates<Predicates>;
+
+  using memory_space = typename Predicates::memory_space;
+  using size_type = decltype(std::declval<Predicates const &>().size());
+
+  static KOKKOS_FUNCTION size_type size(Self const &x)
+  {
+    return x.predicates.size();
+  }
+  static KOKKOS_FUNCTION auto get(Self const &x, size_type i)
+  {
+    return Experimental::ordered_intersects(getGeometry(x.predicates(i)));
+  }
+};
+
+} // namespace ArborX
+
+namespace ArborX::Details
+{
+
+namespace DistributedTree
+{
+
+// Order-preserving counterpart of mergeResults(): every incoming entry
+// carries a sort key (candidate rank position in the high bits, arrival index
+// in the low bits) and each query's segment is sorted by it, so the merged
+// segments enumerate the matches in cross-rank traversal order.
+template <typename ExecutionSpace, typename QueryIdsView, typename Keys,
+          typename Values, typename OffsetView>
+void mergeResultsOrdered(ExecutionSpace const &space, int n_queries,
+                         QueryIdsView const &query_ids, Keys const &keys,
+                         Values &values, OffsetView &offset)
+{
+  std::string prefix = "ArborX::DistributedTree::query::merge_results_ordered";
+
+  Kokkos::Profiling::ScopedRegion guard(prefix);
+
+  using MemorySpace = typename Values::memory_space;
+  using Value = typename Values::value_type;
+
+  int const nnz = query_ids.extent(0);
+
+  countResults(space, n_queries, query_ids, offset);
+
+  Kokkos::View<int *, MemorySpace> cursors(
+      Kokkos::view_alloc(space, prefix + "::cursors"), n_queries);
+  Kokkos::View<Value *, MemorySpace> merged_values(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, values.label()),
+      nnz);
+  Kokkos::View<unsigned long long *, MemorySpace> merged_keys(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, prefix + "::keys"),
+      nnz);
+  Kokkos::parallel_for(
+      prefix + "::scatter_results",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, nnz), KOKKOS_LAMBDA(int i) {
+        int const q = query_ids(i);
+        int const j = offset(q) + Kokkos::atomic_fetch_add(&cursors(q), 1);
+        merged_values(j) = values(i);
+        merged_keys(j) = keys(i);
+      });
+
+  // Segments are small (the matches of a single predicate), so one thread
+  // sorting its query's segment in place is good enough -- the same trade-off
+  // deduplicateRanks() makes
+  Kokkos::parallel_for(
+      prefix + "::sort_segments",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int q) {
+        for (int i = offset(q) + 1; i < offset(q + 1); ++i)
+        {
+          auto const key = merged_keys(i);
+          auto const value = merged_values(i);
+          int j = i;
+          while (j > offset(q) && merged_keys(j - 1) > key)
+          {
+            merged_keys(j) = merged_keys(j - 1);
+            merged_values(j) = merged_values(j - 1);
+            --j;
+          }
+          merged_keys(j) = key;
+          merged_values(j) = value;
+        }
+      });
+  values = merged_values;
+}
+
+// One communication round of the ordered query: forward every predicate to
+// its listed candidate ranks, run the local ordered traversals there, send
+// the results back, and merge them in candidate order
+template <typename ExecutionSpace, typename BottomTree, typename Predicates,
+          typename Callback, typename RanksTo, typename OffsetTo,
+          typename Candidates, typename CandidateOffset, typename Values,
+          typename Offset>
+void forwardOrderedRound(
+    MPI_Comm comm, ExecutionSpace const &space, BottomTree const &bottom_tree,
+    Predicates const &predicates, Callback const &callback,
+    RanksTo const &ranks_to, OffsetTo const &offset_to,
+    Candidates const &candidate_ranks, CandidateOffset const &candidate_offset,
+    Values &values, Offset &offset,
+    DistributorPlanCache<typename BottomTree::memory_space> *plan_cache =
+        nullptr)
+{
+  std::string prefix =
+      "ArborX::DistributedTree::query::ordered_spatial::forward_round";
+  Kokkos::Profiling::ScopedRegion guard(prefix);
+
+  using Query = typename Predicates::value_type;
+  using MemorySpace = typename BottomTree::memory_space;
+
+  Kokkos::View<int *, MemorySpace> ids(prefix + "::query_ids", 0);
+  Kokkos::View<Query *, MemorySpace> fwd_predicates(prefix + "::fwd_predicates",
+                                                    0);
+  Kokkos::View<int *, MemorySpace> ranks(prefix + "::ranks", 0);
+  forwardQueries(comm, space, predicates, ranks_to, offset_to, fwd_predicates,
+                 ids, ranks, plan_cache);
+
+  bottom_tree.query(space, fwd_predicates, callback, values, offset);
+
+  communicateResultsBack(comm, space, values, offset, ranks, ids, plan_cache);
+
+  // The entries coming back from one rank are already in that rank's local
+  // traversal order, so the arrival index in the low bits keeps the sort
+  // below stable within a (query, rank) run
+  int const n_results = values.extent(0);
+  Kokkos::View<unsigned long long *, MemorySpace> keys(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         prefix + "::keys"),
+      n_results);
+  Kokkos::parallel_for(
+      prefix + "::compute_sort_keys",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_results),
+      KOKKOS_LAMBDA(int i) {
+        int const q = ids(i);
+        int pos = 0;
+        for (int j = candidate_offset(q); j < candidate_offset(q + 1); ++j)
+          if (candidate_ranks(j) == ranks(i))
+          {
+            pos = j - candidate_offset(q);
+            break;
+          }
+        keys(i) = ((unsigned long long)pos << 32) + i;
+      });
+
+  mergeResultsOrdered(space, (int)predicates.size(), ids, keys, values, offset);
+}
+
+} // namespace DistributedTree
+
+// Ordered queries enumerate their matches in cross-rank traversal order,
+// assuming the rank domains do not overlap along the geometry (matches from
+// overlapping ranks come out in the order the ranks are entered). Round one
+// visits only the first rank each geometry enters; predicates that reach
+// their match limit there terminate early, and only the remaining ones pay a
+// second round that visits all their other candidate ranks at once.
+template <typename Tree, typename ExecutionSpace, typename Predicates,
+          typename Values, typename Offset, typename Callback>
+std::enable_if_t<Kokkos::is_view_v<Values> && Kokkos::is_view_v<Offset>>
+DistributedTreeImpl::queryDispatch(OrderedSpatialPredicateTag, Tree const &tree,
+                                   ExecutionSpace const &space,
+                                   Predicates const &predicates,
+                                   Callback const &callback, Values &values,
+                                   Offset &offset)
+{
+  std::string prefix = "ArborX::DistributedTree::query::ordered_spatial";
+
+  Kokkos::Profiling::ScopedRegion guard(prefix);
+
+  using namespace DistributedTree;
+  using MemorySpace = typename Tree::memory_space;
+
+  auto comm = tree.getComm();
+
+  if (tree.empty())
+  {
+    KokkosExt::reallocWithoutInitializing(space, values, 0);
+    KokkosExt::reallocWithoutInitializing(space, offset, predicates.size() + 1);
+    Kokkos::deep_copy(space, offset, 0);
+    return;
+  }
+
+  int const n_queries = predicates.size();
+
+  // Candidate ranks in traversal order: the ordered top-tree traversal
+  // enumerates the per-rank summary volumes by increasing distance along the
+  // geometry, and the deduplication keeps first occurrences, preserving that
+  // order
+  Kokkos::View<int *, MemorySpace> candidate_ranks(
+      prefix + "::candidate_ranks", 0);
+  Kokkos::View<int *, MemorySpace> candidate_offset(
+      prefix + "::candidate_offset", 0);
+  tree._top_tree.query(space,
+                       UnlimitedOrderedPredicates<Predicates>{predicates},
+                       candidate_ranks, candidate_offset);
+  deduplicateRanks(space, candidate_ranks, candidate_offset);
+
+  // Round one goes only to the first rank each geometry enters; in the
+  // common case the match limit is reached there and the farther ranks never
+  // see the predicate
+  Kokkos::View<int *, MemorySpace> first_offset(
+      Kokkos::view_alloc(space, prefix + "::first_offset"), n_queries + 1);
+  Kokkos::parallel_for(
+      prefix + "::count_first_candidates",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int q) {
+        first_offset(q) = KokkosExt::min(
+            candidate_offset(q + 1) - candidate_offset(q), 1);
+      });
+  KokkosExt::exclusive_scan(space, first_offset, first_offset, 0);
+  Kokkos::View<int *, MemorySpace> first_ranks(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         prefix + "::first_ranks"),
+      KokkosExt::lastElement(space, first_offset));
+  Kokkos::parallel_for(
+      prefix + "::fill_first_candidates",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int q) {
+        if (candidate_offset(q + 1) > candidate_offset(q))
+          first_ranks(first_offset(q)) = candidate_ranks(candidate_offset(q));
+      });
+
+  forwardOrderedRound(comm, space, tree._bottom_tree, predicates, callback,
+                      first_ranks, first_offset, candidate_ranks,
+                      candidate_offset, values, offset, tree.getPlanCache());
+
+  // A predicate is resolved once its match limit is reached: matches in the
+  // remaining candidates cannot come earlier in the traversal order
+  int num_unresolved;
+  Kokkos::parallel_reduce(
+      prefix + "::count_unresolved",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int q, int &update) {
+        int const num_candidates = candidate_offset(q + 1) - candidate_offset(q);
+        int const max_results = getMaxResults(predicates(q));
+        if (num_candidates > 1 &&
+            (max_results == 0 || offset(q + 1) - offset(q) < max_results))
+          ++update;
+      },
+      num_unresolved);
+
+  // The forwarding exchanges are collective, so all ranks have to agree
+  // whether a second round happens at all; this reduction is the only traffic
+  // a fully resolved query set pays beyond round one
+  int any_unresolved = (num_unresolved > 0);
+  MPI_Allreduce(MPI_IN_PLACE, &any_unresolved, 1, MPI_INT, MPI_LOR, comm);
+  if (!any_unresolved)
+    return;
+
+  // Round two visits all the remaining candidates of the unresolved
+  // predicates at once -- two rounds total instead of one round per domain
+  // crossing
+  Kokkos::View<int *, MemorySpace> remaining_offset(
+      Kokkos::view_alloc(space, prefix + "::remaining_offset"), n_queries + 1);
+  Kokkos::parallel_for(
+      prefix + "::count_remaining_candidates",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int q) {
+        int const num_candidates = candidate_offset(q + 1) - candidate_offset(q);
+        int const max_results = getMaxResults(predicates(q));
+        bool const unresolved =
+            num_candidates > 1 &&
+            (max_results == 0 || offset(q + 1) - offset(q) < max_results);
+        remaining_offset(q) = (unresolved ? num_candidates - 1 : 0);
+      });
+  KokkosExt::exclusive_scan(space, remaining_offset, remaining_offset, 0);
+  Kokkos::View<int *, MemorySpace> remaining_ranks(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         prefix + "::remaining_ranks"),
+      KokkosExt::lastElement(space, remaining_offset));
+  Kokkos::parallel_for(
+      prefix + "::fill_remaining_candidates",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int q) {
+        int const count = remaining_offset(q + 1) - remaining_offset(q);
+        for (int j = 0; j < count; ++j)
+          remaining_ranks(remaining_offset(q) + j) =
+              candidate_ranks(candidate_offset(q) + 1 + j);
+      });
+
+  Values round2_values(prefix + "::round2_values", 0);
+  Offset round2_offset(prefix + "::round2_offset", 0);
+  forwardOrderedRound(comm, space, tree._bottom_tree, predicates, callback,
+                      remaining_ranks, remaining_offset, candidate_ranks,
+                      candidate_offset, round2_values, round2_offset,
+                      tree.getPlanCache());
+
+  // Concatenate the two rounds (round one holds the earliest candidate's
+  // matches) and enforce the match limit
+  Offset merged_offset(Kokkos::view_alloc(space, offset.label()),
+                       n_queries + 1);
+  Kokkos::parallel_for(
+      prefix + "::count_merged_results",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int q) {
+        int count = (offset(q + 1) - offset(q)) +
+                    (round2_offset(q + 1) - round2_offset(q));
+        int const max_results = getMaxResults(predicates(q));
+        if (max_results > 0)
+          count = KokkosExt::min(count, max_results);
+        merged_offset(q) = count;
+      });
+  KokkosExt::exclusive_scan(space, merged_offset, merged_offset, 0);
+
+  Values merged_values(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, values.label()),
+      KokkosExt::lastElement(space, merged_offset));
+  auto const round1_values = values;
+  auto const round1_offset = offset;
+  Kokkos::parallel_for(
+      prefix + "::concatenate_rounds",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int q) {
+        int out_pos = merged_offset(q);
+        int const out_end = merged_offset(q + 1);
+        for (int i = round1_offset(q);
+             i < round1_offset(q + 1) && out_pos < out_end; ++i)
+          merged_values(out_pos++) = round1_values(i);
+        for (int i = round2_offset(q);
+             i < round2_offset(q + 1) && out_pos < out_end; ++i)
+          merged_values(out_pos++) = round2_values(i);
+      });
+
+  values = merged_values;
+  offset = merged_offset;
+}
+
+template <typename Tree, typename ExecutionSpace, typename Predicates,
+          typename Values, typename Offset>
+std::enable_if_t<Kokkos::is_view_v<Values> && Kokkos::is_view_v<Offset>>
+DistributedTreeImpl::queryDispatch(OrderedSpatialPredicateTag, Tree const &tree,
+                                   ExecutionSpace const &space,
+                                   Predicates const &predicates, Values &values,
+                                   Offset &offset)
+{
+  queryDispatch(OrderedSpatialPredicateTag{}, tree, space, predicates,
+                DefaultCallback{}, values, offset);
+}
+
+} // namespace ArborX::Details
+
+#endif
@@ -12,8 +12,10 @@
 #define ARBORX_DETAILS_DISTRIBUTED_TREE_SPATIAL_HPP
 
 #include <ArborX_Callbacks.hpp>
+#include <ArborX_DetailsAlgorithms.hpp>
 #include <ArborX_DetailsDistributedTreeImpl.hpp>
 #include <ArborX_DetailsDistributedTreeUtils.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
 #include <ArborX_DetailsLegacy.hpp>
 #include <ArborX_Predicates.hpp>
 
@@ -25,6 +27,56 @@
 namespace ArborX::Details
 {
 
+template <typename Tree, typename ExecutionSpace, typename Predicates>
+bool DistributedTreeImpl::coveredByHalo(Tree const &tree,
+                                        ExecutionSpace const &space,
+                                        Predicates const &predicates)
+{
+  using BoundingVolume = typename Tree::bounding_volume_type;
+  constexpr int DIM = GeometryTraits::dimension_v<BoundingVolume>;
+
+  // The halo width is identical on every rank, so returning early keeps the
+  // decision consistent without communication
+  if (tree._halo_width <= 0)
+    return false;
+
+  // A predicate whose geometry fits inside the halo-expanded local bounds
+  // only reaches values that are either owned or ghosted
+  int num_outside = 0;
+  auto halo_bounds = tree._bottom_tree.bounds();
+  if (isValid(halo_bounds))
+  {
+    for (int d = 0; d < DIM; ++d)
+    {
+      halo_bounds.minCorner()[d] -= tree._halo_width;
+      halo_bounds.maxCorner()[d] += tree._halo_width;
+    }
+    Kokkos::parallel_reduce(
+        "ArborX::DistributedTree::query::spatial::check_halo_coverage",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, predicates.size()),
+        KOKKOS_LAMBDA(int i, int &update) {
+          BoundingVolume box{};
+          expand(box, getGeometry(predicates(i)));
+          auto grown = halo_bounds;
+          expand(grown, box);
+          if (!equals(grown, halo_bounds))
+            ++update;
+        },
+        num_outside);
+  }
+  else if (predicates.size() > 0)
+  {
+    // Predicates on a rank without local bounds cannot be answered locally
+    num_outside = 1;
+  }
+
+  // The forwarding path is collective, so all ranks have to agree; a
+  // latency-only reduction is still far cheaper than forwarding
+  int covered = (num_outside == 0);
+  MPI_Allreduce(MPI_IN_PLACE, &covered, 1, MPI_INT, MPI_LAND, tree.getComm());
+  return covered == 1;
+}
+
 template <typename Tree, typename ExecutionSpace, typename Predicates,
           typename Values, typename Offset, typename Callback>
 std::enable_if_t<Kokkos::is_view_v<Values> && Kokkos::is_view_v<Offset>>
@@ -47,15 +99,76 @@ DistributedTreeImpl::queryDispatch(SpatialPredicateTag, Tree const &tree,
 
   using MemorySpace = typename Tree::memory_space;
 
+  // A halo-replicated tree answers sufficiently local predicates without any
+  // communication: the ghost tree holds every remote value they can reach
+  if (coveredByHalo(tree, space, predicates))
+  {
+    tree._bottom_tree.query(space, predicates, callback, values, offset);
+
+    auto const &ghost_tree = tree._ghost_tree;
+    if (ghost_tree.empty())
+      return;
+
+    Values ghost_values(
+        "ArborX::DistributedTree::query::spatial::ghost_values", 0);
+    Offset ghost_offset("ArborX::DistributedTree::query::spatial::ghost_offset",
+                        0);
+    ghost_tree.query(space, predicates, callback, ghost_values, ghost_offset);
+
+    int const num_ghost_results = KokkosExt::lastElement(space, ghost_offset);
+    if (num_ghost_results == 0)
+      return;
+
+    int const n_queries = predicates.size();
+    int const num_local_results = KokkosExt::lastElement(space, offset);
+
+    Values merged_values(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing, values.label()),
+        num_local_results + num_ghost_results);
+    Offset merged_offset(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing, offset.label()),
+        n_queries + 1);
+
+    auto const local_values = values;
+    auto const local_offset = offset;
+    Kokkos::parallel_for(
+        "ArborX::DistributedTree::query::spatial::merge_ghost_results",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+        KOKKOS_LAMBDA(int q) {
+          // The sum of the two offset arrays is the offset array of the
+          // concatenated per-query ranges
+          int out = local_offset(q) + ghost_offset(q);
+          merged_offset(q) = out;
+          if (q == 0)
+            merged_offset(n_queries) =
+                local_offset(n_queries) + ghost_offset(n_queries);
+          for (int i = local_offset(q); i < local_offset(q + 1); ++i)
+            merged_values(out++) = local_values(i);
+          for (int i = ghost_offset(q); i < ghost_offset(q + 1); ++i)
+            merged_values(out++) = ghost_values(i);
+        });
+
+    values = merged_values;
+    offset = merged_offset;
+    return;
+  }
+
   auto const &top_tree = tree._top_tree;
 
   Kokkos::View<int *, MemorySpace> intersected_ranks(
       "ArborX::DistributedTree::query::spatial::intersected_ranks", 0);
   top_tree.query(space, predicates, intersected_ranks, offset);
+  DistributedTree::deduplicateRanks(space, intersected_ranks, offset);
 
-  DistributedTree::forwardQueriesAndCommunicateResults(
-      tree.getComm(), space, tree._bottom_tree, predicates, callback,
-      intersected_ranks, offset, values);
+  int const num_batches = DistributedTree::pipelinedQueryNumBatches();
+  if (num_batches > 1)
+    DistributedTree::forwardQueriesAndCommunicateResultsPipelined(
+        tree.getComm(), space, tree._bottom_tree, predicates, callback,
+        intersected_ranks, offset, values, num_batches, tree.getPlanCache());
+  else
+    DistributedTree::forwardQueriesAndCommunicateResults(
+        tree.getComm(), space, tree._bottom_tree, predicates, callback,
+        intersected_ranks, offset, values, tree.getPlanCache());
 }
 
 template <typename Tree, typename ExecutionSpace, typename Predicates,
@@ -79,16 +192,27 @@ void DistributedTreeImpl::queryDispatch(SpatialPredicateTag, Tree const &tree,
   auto const &bottom_tree = tree._bottom_tree;
   auto comm = tree.getComm();
 
+  // A halo-replicated tree answers sufficiently local predicates without
+  // forwarding; the ghost tree accounts for the remote values
+  if (coveredByHalo(tree, space, predicates))
+  {
+    bottom_tree.query(space, predicates, callback);
+    if (!tree._ghost_tree.empty())
+      tree._ghost_tree.query(space, predicates, callback);
+    return;
+  }
+
   Kokkos::View<int *, MemorySpace> intersected_ranks(
       prefix + "::intersected_ranks", 0);
   Kokkos::View<int *, MemorySpace> offset(prefix + "::offset", 0);
   top_tree.query(space, predicates, intersected_ranks, offset);
+  deduplicateRanks(space, intersected_ranks, offset);
 
   using Query = typename Predicates::value_type;
   Kokkos::View<Query *, MemorySpace> fwd_predicates(prefix + "::fwd_predicates",
                                                     0);
   forwardQueries(comm, space, predicates, intersected_ranks, offset,
-                 fwd_predicates);
+                 fwd_predicates, tree.getPlanCache());
 
   bottom_tree.query(space, fwd_predicates, callback);
 }
@@ -105,6 +229,53 @@ DistributedTreeImpl::queryDispatch(SpatialPredicateTag, Tree const &tree,
                 DefaultCallback{}, values, offset);
 }
 
+template <typename Tree, typename ExecutionSpace, typename Predicates,
+          typename Callback, typename Values, typename Offset,
+          typename SegmentCallback>
+std::enable_if_t<Kokkos::is_view_v<Values> && Kokkos::is_view_v<Offset>>
+DistributedTreeImpl::queryDispatchStreaming(SpatialPredicateTag,
+                                            Tree const &tree,
+                                            ExecutionSpace const &space,
+                                            Predicates const &predicates,
+                                            Callback const &callback,
+                                            Values &values, Offset &offset,
+                                            SegmentCallback const &on_segment)
+{
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::DistributedTree::query::spatial(streaming)");
+
+  if (tree.empty())
+  {
+    KokkosExt::reallocWithoutInitializing(space, values, 0);
+    KokkosExt::reallocWithoutInitializing(space, offset, predicates.size() + 1);
+    Kokkos::deep_copy(space, offset, 0);
+    return;
+  }
+
+  // Sufficiently local predicates produce no result messages to stream, so a
+  // halo-covered query falls back to the regular path and never invokes the
+  // segment callback
+  if (coveredByHalo(tree, space, predicates))
+  {
+    queryDispatch(SpatialPredicateTag{}, tree, space, predicates, callback,
+                  values, offset);
+    return;
+  }
+
+  using MemorySpace = typename Tree::memory_space;
+
+  auto const &top_tree = tree._top_tree;
+
+  Kokkos::View<int *, MemorySpace> intersected_ranks(
+      "ArborX::DistributedTree::query::spatial::intersected_ranks", 0);
+  top_tree.query(space, predicates, intersected_ranks, offset);
+  DistributedTree::deduplicateRanks(space, intersected_ranks, offset);
+
+  DistributedTree::forwardQueriesAndCommunicateResultsStreaming(
+      tree.getComm(), space, tree._bottom_tree, predicates, callback,
+      intersected_ranks, offset, values, on_segment, tree.getPlanCache());
+}
+
 } // namespace ArborX::Details
 
 #endif
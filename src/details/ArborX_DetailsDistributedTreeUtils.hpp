@@ -16,19 +16,40 @@
 #include <ArborX_DetailsContainers.hpp>
 #include <ArborX_DetailsDistributor.hpp>
 #include <ArborX_DetailsKokkosExtMinMaxOperations.hpp>
-#include <ArborX_DetailsKokkosExtSort.hpp>
 #include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
 #include <ArborX_DetailsKokkosExtViewHelpers.hpp>
 #include <ArborX_DetailsPriorityQueue.hpp>
+#include <ArborX_QueryLoadTelemetry.hpp>
 
 #include <Kokkos_Core.hpp>
 #include <Kokkos_Profiling_ScopedRegion.hpp>
 
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
 #include <mpi.h>
 
 namespace ArborX::Details::DistributedTree
 {
 
+// Take the plan from the cache when the caller provided one, otherwise build
+// a throwaway distributor owned by the caller through `owned`
+template <typename MemorySpace, typename ExecutionSpace, typename... Views>
+Distributor<MemorySpace> &
+getOrCreateDistributor(std::unique_ptr<Distributor<MemorySpace>> &owned,
+                       DistributorPlanCache<MemorySpace> *plan_cache,
+                       MPI_Comm comm, ExecutionSpace const &space,
+                       Views const &...views)
+{
+  if (plan_cache != nullptr)
+    return plan_cache->getOrCreate(comm, space, views...);
+
+  owned = std::make_unique<Distributor<MemorySpace>>(comm);
+  owned->createFromSends(space, views...);
+  return *owned;
+}
+
 template <typename ExecutionSpace, typename QueryIdsView, typename OffsetView>
 void countResults(ExecutionSpace const &space, int n_queries,
                   QueryIdsView const &query_ids, OffsetView &offset)
@@ -46,12 +67,163 @@ void countResults(ExecutionSpace const &space, int n_queries,
   KokkosExt::exclusive_scan(space, offset, offset, 0);
 }
 
+// Remove repeated ranks within every predicate's segment, preserving the
+// order of first occurrence. The top tree stores several summary volumes per
+// rank, so a predicate may intersect the same rank more than once, and
+// forwarding it to that rank more than once would duplicate results.
+template <typename ExecutionSpace, typename Ranks, typename Offset>
+void deduplicateRanks(ExecutionSpace const &space, Ranks &ranks, Offset &offset)
+{
+  std::string prefix = "ArborX::DistributedTree::query::deduplicate_ranks";
+
+  Kokkos::Profiling::ScopedRegion guard(prefix);
+
+  using MemorySpace = typename Ranks::memory_space;
+
+  int const n_queries = offset.extent(0) - 1;
+
+  Kokkos::View<int *, MemorySpace> new_offset(
+      Kokkos::view_alloc(space, prefix + "::new_offset"), n_queries + 1);
+  Kokkos::parallel_for(
+      prefix + "::count_unique_ranks",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int q) {
+        for (int i = offset(q); i < offset(q + 1); ++i)
+        {
+          bool duplicate = false;
+          for (int j = offset(q); j < i; ++j)
+            if (ranks(j) == ranks(i))
+            {
+              duplicate = true;
+              break;
+            }
+          if (!duplicate)
+            ++new_offset(q);
+        }
+      });
+
+  KokkosExt::exclusive_scan(space, new_offset, new_offset, 0);
+
+  Kokkos::View<int *, MemorySpace> new_ranks(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         prefix + "::new_ranks"),
+      KokkosExt::lastElement(space, new_offset));
+  Kokkos::parallel_for(
+      prefix + "::copy_unique_ranks",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int q) {
+        int k = new_offset(q);
+        for (int i = offset(q); i < offset(q + 1); ++i)
+        {
+          bool duplicate = false;
+          for (int j = offset(q); j < i; ++j)
+            if (ranks(j) == ranks(i))
+            {
+              duplicate = true;
+              break;
+            }
+          if (!duplicate)
+            new_ranks(k++) = ranks(i);
+        }
+      });
+
+  ranks = new_ranks;
+  Kokkos::deep_copy(space, offset, new_offset);
+}
+
+// Assemble the results communicated back from the remote ranks into the CRS
+// format expected by the caller. The incoming entries are grouped by source
+// rank, not by query, so they are binned by query id with a
+// count-scan-scatter sweep; sorting the whole result array by query id, which
+// this replaces, paid a comparison sort for what two linear passes
+// accomplish. With Deduplicate set, results that several ranks reported for
+// the same query (e.g. when the primitives are ghosted) are removed during
+// the merge, keeping the first occurrence of every value within a query's
+// segment; this requires the value type to be equality-comparable.
+template <bool Deduplicate = false, typename ExecutionSpace,
+          typename QueryIdsView, typename Values, typename OffsetView>
+void mergeResults(ExecutionSpace const &space, int n_queries,
+                  QueryIdsView const &query_ids, Values &values,
+                  OffsetView &offset)
+{
+  std::string prefix = "ArborX::DistributedTree::query::merge_results";
+
+  Kokkos::Profiling::ScopedRegion guard(prefix);
+
+  using MemorySpace = typename Values::memory_space;
+  using Value = typename Values::value_type;
+
+  int const nnz = query_ids.extent(0);
+
+  countResults(space, n_queries, query_ids, offset);
+
+  Kokkos::View<int *, MemorySpace> cursors(
+      Kokkos::view_alloc(space, prefix + "::cursors"), n_queries);
+  Kokkos::View<Value *, MemorySpace> merged_values(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, values.label()),
+      nnz);
+  Kokkos::parallel_for(
+      prefix + "::scatter_results",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, nnz), KOKKOS_LAMBDA(int i) {
+        int const q = query_ids(i);
+        merged_values(offset(q) + Kokkos::atomic_fetch_add(&cursors(q), 1)) =
+            values(i);
+      });
+  values = merged_values;
+
+  if constexpr (Deduplicate)
+  {
+    // Compact every query's segment in place (one thread owns the whole
+    // segment, same as in deduplicateRanks()), then squeeze out the holes
+    // between the segments
+    Kokkos::View<int *, MemorySpace> new_offset(
+        Kokkos::view_alloc(space, offset.label()), n_queries + 1);
+    Kokkos::parallel_for(
+        prefix + "::compact_unique_results",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+        KOKKOS_LAMBDA(int q) {
+          int k = offset(q);
+          for (int i = offset(q); i < offset(q + 1); ++i)
+          {
+            bool duplicate = false;
+            for (int j = offset(q); j < k; ++j)
+              if (merged_values(j) == merged_values(i))
+              {
+                duplicate = true;
+                break;
+              }
+            if (!duplicate)
+              merged_values(k++) = merged_values(i);
+          }
+          new_offset(q) = k - offset(q);
+        });
+
+    KokkosExt::exclusive_scan(space, new_offset, new_offset, 0);
+
+    Kokkos::View<Value *, MemorySpace> unique_values(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing, values.label()),
+        KokkosExt::lastElement(space, new_offset));
+    Kokkos::parallel_for(
+        prefix + "::copy_unique_results",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+        KOKKOS_LAMBDA(int q) {
+          int const count = new_offset(q + 1) - new_offset(q);
+          for (int i = 0; i < count; ++i)
+            unique_values(new_offset(q) + i) = merged_values(offset(q) + i);
+        });
+    values = unique_values;
+    Kokkos::deep_copy(space, offset, new_offset);
+  }
+}
+
 template <typename ExecutionSpace, typename Predicates, typename Indices,
           typename Offset, typename FwdQueries, typename FwdIds, typename Ranks>
 void forwardQueries(MPI_Comm comm, ExecutionSpace const &space,
                     Predicates const &queries, Indices const &indices,
                     Offset const &offset, FwdQueries &fwd_queries,
-                    FwdIds &fwd_ids, Ranks &fwd_ranks)
+                    FwdIds &fwd_ids, Ranks &fwd_ranks,
+                    DistributorPlanCache<typename Predicates::memory_space>
+                        *plan_cache = nullptr)
 {
   std::string prefix = "ArborX::DistributedTree::query::forwardQueries";
 
@@ -60,15 +232,25 @@ void forwardQueries(MPI_Comm comm, ExecutionSpace const &space,
   using MemorySpace = typename Predicates::memory_space;
   using Query = typename Predicates::value_type;
 
-  int comm_rank;
-  MPI_Comm_rank(comm, &comm_rank);
-
-  Distributor<MemorySpace> distributor(comm);
+  std::unique_ptr<Distributor<MemorySpace>> owned_distributor;
 
   int const n_queries = queries.size();
   int const n_exports = KokkosExt::lastElement(space, offset);
-  int const n_imports = distributor.createFromSends(space, indices);
+  auto &distributor =
+      getOrCreateDistributor(owned_distributor, plan_cache, comm, space,
+                             indices);
+
+  // Every forwarded predicate is a tree the destination rank walks on this
+  // rank's behalf; attribute it when the query load is being accumulated
+  if (auto *load = currentQueryLoadTelemetry())
+  {
+    auto const &destinations = distributor.getDestinationRanks();
+    auto const &offsets = distributor.getDestinationOffsets();
+    for (int i = 0; i < (int)destinations.size(); ++i)
+      load->recordPredicatesSent(destinations[i], offsets[i + 1] - offsets[i]);
+  }
 
+  int n_imports;
   {
     Kokkos::View<Query *, MemorySpace> export_queries(
         Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
@@ -82,20 +264,18 @@ void forwardQueries(MPI_Comm comm, ExecutionSpace const &space,
             export_queries(i) = queries(q);
         });
 
+    // The fill kernel above overlaps the count exchange posted by
+    // createFromSends()
+    n_imports = distributor.getTotalReceiveLength();
+
     KokkosExt::reallocWithoutInitializing(space, fwd_queries, n_imports);
     distributor.doPostsAndWaits(space, export_queries, fwd_queries);
   }
 
-  {
-    Kokkos::View<int *, MemorySpace> export_ranks(
-        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
-                           prefix + "::export_ranks"),
-        n_exports);
-    Kokkos::deep_copy(space, export_ranks, comm_rank);
-
-    KokkosExt::reallocWithoutInitializing(space, fwd_ranks, n_imports);
-    distributor.doPostsAndWaits(space, export_ranks, fwd_ranks);
-  }
+  // The origin rank of every forwarded predicate is implied by the
+  // communication plan, so it is reconstructed locally rather than sent over
+  // the network alongside the predicate
+  distributor.getImportSourceRanks(space, fwd_ranks);
 
   {
     Kokkos::View<int *, MemorySpace> export_ids(
@@ -119,7 +299,9 @@ template <typename ExecutionSpace, typename Predicates, typename Indices,
           typename Offset, typename FwdQueries>
 void forwardQueries(MPI_Comm comm, ExecutionSpace const &space,
                     Predicates const &queries, Indices const &indices,
-                    Offset const &offset, FwdQueries &fwd_queries)
+                    Offset const &offset, FwdQueries &fwd_queries,
+                    DistributorPlanCache<typename Predicates::memory_space>
+                        *plan_cache = nullptr)
 {
   std::string prefix =
       "ArborX::DistributedTree::query::forwardQueries(partial)";
@@ -129,10 +311,19 @@ void forwardQueries(MPI_Comm comm, ExecutionSpace const &space,
   using MemorySpace = typename Predicates::memory_space;
   using Query = typename Predicates::value_type;
 
-  Distributor<MemorySpace> distributor(comm);
+  std::unique_ptr<Distributor<MemorySpace>> owned_distributor;
 
   int const n_exports = KokkosExt::lastElement(space, offset);
-  int const n_imports = distributor.createFromSends(space, indices);
+  auto &distributor = getOrCreateDistributor(owned_distributor, plan_cache,
+                                             comm, space, indices);
+
+  if (auto *load = currentQueryLoadTelemetry())
+  {
+    auto const &destinations = distributor.getDestinationRanks();
+    auto const &offsets = distributor.getDestinationOffsets();
+    for (int i = 0; i < (int)destinations.size(); ++i)
+      load->recordPredicatesSent(destinations[i], offsets[i + 1] - offsets[i]);
+  }
 
   Kokkos::View<Query *, MemorySpace> export_queries(
       Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
@@ -146,49 +337,61 @@ void forwardQueries(MPI_Comm comm, ExecutionSpace const &space,
           export_queries(i) = queries(q);
       });
 
+  // The fill kernel above overlaps the count exchange posted by
+  // createFromSends()
+  int const n_imports = distributor.getTotalReceiveLength();
+
   KokkosExt::reallocWithoutInitializing(space, fwd_queries, n_imports);
   distributor.doPostsAndWaits(space, export_queries, fwd_queries);
 }
 
 template <typename ExecutionSpace, typename OutputView, typename Offset,
           typename Ranks, typename Ids>
-void communicateResultsBack(MPI_Comm comm, ExecutionSpace const &space,
-                            OutputView &out, Offset const &offset, Ranks &ranks,
-                            Ids &ids)
+void communicateResultsBack(
+    MPI_Comm comm, ExecutionSpace const &space, OutputView &out,
+    Offset const &offset, Ranks &ranks, Ids &ids,
+    DistributorPlanCache<typename OutputView::memory_space> *plan_cache =
+        nullptr)
 {
   Kokkos::Profiling::ScopedRegion guard(
       "ArborX::DistributedTree::communicateResultsBack");
 
   using MemorySpace = typename OutputView::memory_space;
 
-  int comm_rank;
-  MPI_Comm_rank(comm, &comm_rank);
-
   int const n_fwd_queries = offset.extent_int(0) - 1;
   int const n_exports = KokkosExt::lastElement(space, offset);
 
   // We are assuming here that if the same rank is related to multiple batches
   // these batches appear consecutively. Hence, no reordering is necessary.
-  Distributor<MemorySpace> distributor(comm);
+  std::unique_ptr<Distributor<MemorySpace>> owned_distributor;
   // FIXME Distributor::createFromSends takes two views of the same type by
   // a const reference.  There were two easy ways out, either take the views by
   // value or cast at the call site.  I went with the latter.  Proper fix
   // involves more code cleanup in ArborX_DetailsDistributor.hpp than I am
   // willing to do just now.
-  int const n_imports =
-      distributor.createFromSends(space, ranks, static_cast<Ranks>(offset));
+  auto &distributor =
+      getOrCreateDistributor(owned_distributor, plan_cache, comm, space, ranks,
+                             static_cast<Ranks>(offset));
 
-  {
-    Kokkos::View<int *, MemorySpace> export_ranks(
-        Kokkos::view_alloc(space, Kokkos::WithoutInitializing, ranks.label()),
-        n_exports);
-    Kokkos::deep_copy(space, export_ranks, comm_rank);
+  int const n_imports = distributor.getTotalReceiveLength();
 
-    Kokkos::View<int *, MemorySpace> import_ranks(
-        Kokkos::view_alloc(space, Kokkos::WithoutInitializing, ranks.label()),
-        n_imports);
+  // Every incoming result is a leaf hit the source rank computed for this
+  // rank; attribute it when the query load is being accumulated
+  if (auto *load = currentQueryLoadTelemetry())
+  {
+    auto const &sources = distributor.getSourceRanks();
+    auto const &src_offsets = distributor.getSourceOffsets();
+    for (int i = 0; i < (int)sources.size(); ++i)
+      load->recordResultsReceived(sources[i],
+                                  src_offsets[i + 1] - src_offsets[i]);
+  }
 
-    distributor.doPostsAndWaits(space, export_ranks, import_ranks);
+  {
+    // The origin rank of every incoming batch of results is implied by the
+    // communication plan, so it is reconstructed locally rather than sent
+    // over the network alongside the results
+    Kokkos::View<int *, MemorySpace> import_ranks(ranks.label(), 0);
+    distributor.getImportSourceRanks(space, import_ranks);
     ranks = import_ranks;
   }
 
@@ -226,12 +429,121 @@ void communicateResultsBack(MPI_Comm comm, ExecutionSpace const &space,
   }
 }
 
+template <typename Packed, typename Ids, typename Values>
+struct UnpackResultSegment
+{
+  Packed _packed;
+  Ids _ids;
+  Values _values;
+
+  KOKKOS_FUNCTION void operator()(int i) const
+  {
+    _ids(i) = _packed(i).first;
+    _values(i) = _packed(i).second;
+  }
+};
+
+// Variant of communicateResultsBack() that invokes
+// on_segment(source_rank, segment_ids, segment_values) for every rank's batch
+// of results as soon as its messages land (subviews of the import buffers,
+// populated on `space`). The query ids travel packed together with the values
+// in a single exchange: exchanged separately as in communicateResultsBack(),
+// the slowest rank's ids would gate the delivery of every rank's values. On
+// return, out/ranks/ids hold the complete results exactly as after
+// communicateResultsBack().
+template <typename ExecutionSpace, typename OutputView, typename Offset,
+          typename Ranks, typename Ids, typename SegmentCallback>
+void communicateResultsBackStreaming(
+    MPI_Comm comm, ExecutionSpace const &space, OutputView &out,
+    Offset const &offset, Ranks &ranks, Ids &ids,
+    SegmentCallback const &on_segment,
+    DistributorPlanCache<typename OutputView::memory_space> *plan_cache =
+        nullptr)
+{
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::DistributedTree::communicateResultsBackStreaming");
+
+  using MemorySpace = typename OutputView::memory_space;
+  using Value = typename OutputView::value_type;
+  using Packed = Kokkos::pair<int, Value>;
+
+  int const n_fwd_queries = offset.extent_int(0) - 1;
+  int const n_exports = KokkosExt::lastElement(space, offset);
+
+  std::unique_ptr<Distributor<MemorySpace>> owned_distributor;
+  auto &distributor =
+      getOrCreateDistributor(owned_distributor, plan_cache, comm, space, ranks,
+                             static_cast<Ranks>(offset));
+
+  int const n_imports = distributor.getTotalReceiveLength();
+
+  if (auto *load = currentQueryLoadTelemetry())
+  {
+    auto const &sources = distributor.getSourceRanks();
+    auto const &src_offsets = distributor.getSourceOffsets();
+    for (int i = 0; i < (int)sources.size(); ++i)
+      load->recordResultsReceived(sources[i],
+                                  src_offsets[i + 1] - src_offsets[i]);
+  }
+
+  {
+    Kokkos::View<int *, MemorySpace> import_ranks(ranks.label(), 0);
+    distributor.getImportSourceRanks(space, import_ranks);
+    ranks = import_ranks;
+  }
+
+  Kokkos::View<Packed *, MemorySpace> export_packed(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedTree::query::export_packed"),
+      n_exports);
+  {
+    auto const export_out = out;
+    Kokkos::parallel_for(
+        "ArborX::DistributedTree::query::fill_packed_buffer",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_fwd_queries),
+        KOKKOS_LAMBDA(int q) {
+          for (int i = offset(q); i < offset(q + 1); ++i)
+            export_packed(i) = {ids(q), export_out(i)};
+        });
+  }
+
+  Kokkos::View<int *, MemorySpace> import_ids(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, ids.label()),
+      n_imports);
+  OutputView import_out(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, out.label()),
+      n_imports);
+  Kokkos::View<Packed *, MemorySpace> import_packed(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedTree::query::import_packed"),
+      n_imports);
+
+  distributor.doPostsAndWaitsome(
+      space, export_packed, import_packed,
+      [&](int source_rank, int first, int last) {
+        Kokkos::parallel_for(
+            "ArborX::DistributedTree::query::unpack_result_segment",
+            Kokkos::RangePolicy<ExecutionSpace>(space, first, last),
+            UnpackResultSegment<decltype(import_packed), decltype(import_ids),
+                                decltype(import_out)>{import_packed, import_ids,
+                                                      import_out});
+        on_segment(source_rank,
+                   Kokkos::subview(import_ids, std::pair(first, last)),
+                   Kokkos::subview(import_out, std::pair(first, last)));
+      });
+
+  ids = import_ids;
+  out = import_out;
+}
+
 template <typename ExecutionSpace, typename BottomTree, typename Predicates,
           typename Callback, typename RanksTo, typename Offset, typename Values>
 void forwardQueriesAndCommunicateResults(
     MPI_Comm comm, ExecutionSpace const &space, BottomTree const &bottom_tree,
     Predicates const &predicates, Callback const &callback,
-    RanksTo const &ranks_to, Offset &offset, Values &values)
+    RanksTo const &ranks_to, Offset &offset, Values &values,
+    DistributorPlanCache<typename BottomTree::memory_space> *plan_cache =
+        nullptr)
 {
   std::string prefix =
       "ArborX::DistributedTree::query::forwardQueriesAndCommunicateResults";
@@ -246,20 +558,191 @@ void forwardQueriesAndCommunicateResults(
                                                     0);
   Kokkos::View<int *, MemorySpace> ranks(prefix + "::ranks", 0);
   forwardQueries(comm, space, predicates, ranks_to, offset, fwd_predicates, ids,
-                 ranks);
+                 ranks, plan_cache);
 
   // Perform predicates that have been received
   bottom_tree.query(space, fwd_predicates, callback, values, offset);
 
   // Communicate results back
-  communicateResultsBack(comm, space, values, offset, ranks, ids);
+  communicateResultsBack(comm, space, values, offset, ranks, ids, plan_cache);
+
+  Kokkos::Profiling::pushRegion(prefix + "::postprocess_results");
+
+  // Merge results
+  mergeResults(space, (int)predicates.size(), ids, values, offset);
+
+  Kokkos::Profiling::popRegion();
+}
+
+// Variant of forwardQueriesAndCommunicateResults() that streams the results
+// back through communicateResultsBackStreaming(): on_segment fires for each
+// responding rank as its messages land, before the merged output is
+// assembled, so the slowest rank no longer gates all post-processing
+template <typename ExecutionSpace, typename BottomTree, typename Predicates,
+          typename Callback, typename RanksTo, typename Offset, typename Values,
+          typename SegmentCallback>
+void forwardQueriesAndCommunicateResultsStreaming(
+    MPI_Comm comm, ExecutionSpace const &space, BottomTree const &bottom_tree,
+    Predicates const &predicates, Callback const &callback,
+    RanksTo const &ranks_to, Offset &offset, Values &values,
+    SegmentCallback const &on_segment,
+    DistributorPlanCache<typename BottomTree::memory_space> *plan_cache =
+        nullptr)
+{
+  std::string prefix = "ArborX::DistributedTree::query::"
+                       "forwardQueriesAndCommunicateResultsStreaming";
+  Kokkos::Profiling::ScopedRegion guard(prefix);
+
+  using Query = typename Predicates::value_type;
+  using MemorySpace = typename BottomTree::memory_space;
+
+  // Forward predicates
+  Kokkos::View<int *, MemorySpace> ids(prefix + "::query_ids", 0);
+  Kokkos::View<Query *, MemorySpace> fwd_predicates(prefix + "::fwd_predicates",
+                                                    0);
+  Kokkos::View<int *, MemorySpace> ranks(prefix + "::ranks", 0);
+  forwardQueries(comm, space, predicates, ranks_to, offset, fwd_predicates, ids,
+                 ranks, plan_cache);
+
+  // Perform predicates that have been received
+  bottom_tree.query(space, fwd_predicates, callback, values, offset);
+
+  // Communicate results back, handing each segment over as it arrives
+  communicateResultsBackStreaming(comm, space, values, offset, ranks, ids,
+                                  on_segment, plan_cache);
+
+  Kokkos::Profiling::pushRegion(prefix + "::postprocess_results");
+
+  // Merge results
+  mergeResults(space, (int)predicates.size(), ids, values, offset);
+
+  Kokkos::Profiling::popRegion();
+}
+
+// Number of batches to use in the pipelined spatial query, controlled by the
+// ARBORX_PIPELINED_QUERY_BATCHES environment variable. Values below 2 keep
+// the default sequential phases.
+inline int pipelinedQueryNumBatches()
+{
+  static int const value = [] {
+    char const *env = std::getenv("ARBORX_PIPELINED_QUERY_BATCHES");
+    return (env != nullptr ? std::atoi(env) : 0);
+  }();
+  return value;
+}
+
+// Variant of forwardQueriesAndCommunicateResults() that splits the received
+// predicates into batches and overlaps communicating the results of batch N
+// back to their origin with the local traversal of batch N+1, run on a
+// separate execution space instance. This hides a large part of the
+// communication time behind local work when both phases are substantial.
+template <typename ExecutionSpace, typename BottomTree, typename Predicates,
+          typename Callback, typename RanksTo, typename Offset, typename Values>
+void forwardQueriesAndCommunicateResultsPipelined(
+    MPI_Comm comm, ExecutionSpace const &space, BottomTree const &bottom_tree,
+    Predicates const &predicates, Callback const &callback,
+    RanksTo const &ranks_to, Offset &offset, Values &values, int num_batches,
+    DistributorPlanCache<typename BottomTree::memory_space> *plan_cache =
+        nullptr)
+{
+  std::string prefix = "ArborX::DistributedTree::query::"
+                       "forwardQueriesAndCommunicateResultsPipelined";
+  Kokkos::Profiling::ScopedRegion guard(prefix);
+
+  using Query = typename Predicates::value_type;
+  using MemorySpace = typename BottomTree::memory_space;
+  using Value = typename Values::value_type;
+
+  // Forward predicates
+  Kokkos::View<int *, MemorySpace> ids(prefix + "::query_ids", 0);
+  Kokkos::View<Query *, MemorySpace> fwd_predicates(prefix + "::fwd_predicates",
+                                                    0);
+  Kokkos::View<int *, MemorySpace> ranks(prefix + "::ranks", 0);
+  forwardQueries(comm, space, predicates, ranks_to, offset, fwd_predicates, ids,
+                 ranks, plan_cache);
+
+  int const n_imports = fwd_predicates.extent_int(0);
+  num_batches = KokkosExt::min(num_batches, KokkosExt::max(n_imports, 1));
+
+  auto instances = Kokkos::Experimental::partition_space(space, 1, 1);
+
+  std::vector<Kokkos::View<Value *, MemorySpace>> batch_values(num_batches);
+  std::vector<Kokkos::View<int *, MemorySpace>> batch_offset(num_batches);
+  std::vector<Kokkos::View<int *, MemorySpace>> batch_ranks(num_batches);
+  std::vector<Kokkos::View<int *, MemorySpace>> batch_ids(num_batches);
+
+  auto batch_range = [n_imports, num_batches](int b) {
+    return Kokkos::make_pair((long)b * n_imports / num_batches,
+                             (long)(b + 1) * n_imports / num_batches);
+  };
+
+  for (int b = 0; b < num_batches; ++b)
+  {
+    auto const &instance = instances[b % 2];
+    auto const range = batch_range(b);
+    int const batch_size = range.second - range.first;
+
+    batch_ranks[b] = Kokkos::View<int *, MemorySpace>(
+        Kokkos::view_alloc(instance, Kokkos::WithoutInitializing,
+                           prefix + "::batch_ranks"),
+        batch_size);
+    Kokkos::deep_copy(instance, batch_ranks[b],
+                      Kokkos::subview(ranks, range));
+    batch_ids[b] = Kokkos::View<int *, MemorySpace>(
+        Kokkos::view_alloc(instance, Kokkos::WithoutInitializing,
+                           prefix + "::batch_ids"),
+        batch_size);
+    Kokkos::deep_copy(instance, batch_ids[b], Kokkos::subview(ids, range));
+
+    batch_values[b] =
+        Kokkos::View<Value *, MemorySpace>(prefix + "::batch_values", 0);
+    batch_offset[b] =
+        Kokkos::View<int *, MemorySpace>(prefix + "::batch_offset", 0);
+
+    // Launch the local traversal of this batch asynchronously, then drain
+    // the communication of the previous batch while it is running
+    bottom_tree.query(instance, Kokkos::subview(fwd_predicates, range),
+                      callback, batch_values[b], batch_offset[b]);
+
+    if (b > 0)
+      communicateResultsBack(comm, instances[(b - 1) % 2], batch_values[b - 1],
+                             batch_offset[b - 1], batch_ranks[b - 1],
+                             batch_ids[b - 1], plan_cache);
+  }
+  communicateResultsBack(comm, instances[(num_batches - 1) % 2],
+                         batch_values[num_batches - 1],
+                         batch_offset[num_batches - 1],
+                         batch_ranks[num_batches - 1],
+                         batch_ids[num_batches - 1], plan_cache);
 
   Kokkos::Profiling::pushRegion(prefix + "::postprocess_results");
 
+  // Concatenate the per-batch results
+  int n_results = 0;
+  for (int b = 0; b < num_batches; ++b)
+    n_results += batch_values[b].extent_int(0);
+
+  Kokkos::View<Value *, MemorySpace> all_values(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         prefix + "::values"),
+      n_results);
+  Kokkos::View<int *, MemorySpace> all_ids(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, prefix + "::ids"),
+      n_results);
+  int pos = 0;
+  for (int b = 0; b < num_batches; ++b)
+  {
+    int const batch_size = batch_values[b].extent_int(0);
+    auto const range = Kokkos::make_pair(pos, pos + batch_size);
+    Kokkos::deep_copy(space, Kokkos::subview(all_values, range),
+                      batch_values[b]);
+    Kokkos::deep_copy(space, Kokkos::subview(all_ids, range), batch_ids[b]);
+    pos += batch_size;
+  }
+
   // Merge results
-  int const n_predicates = predicates.size();
-  countResults(space, n_predicates, ids, offset);
-  KokkosExt::sortByKey(space, ids, values);
+  mergeResults(space, (int)predicates.size(), all_ids, all_values, offset);
+  values = all_values;
 
   Kokkos::Profiling::popRegion();
 }
@@ -14,23 +14,165 @@
 #include <ArborX_Config.hpp>
 
 #include <ArborX_DetailsKokkosExtMinMaxReduce.hpp>
+#include <ArborX_DetailsKokkosExtScratchArena.hpp>
 #include <ArborX_DetailsKokkosExtViewHelpers.hpp>
 #include <ArborX_DetailsSortUtils.hpp>
+#include <ArborX_DistributorTelemetry.hpp>
 #include <ArborX_Exception.hpp>
 
 #include <Kokkos_Core.hpp>
 #include <Kokkos_Profiling_ScopedRegion.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
 #include <sstream>
 #include <vector>
 
 #include <mpi.h>
+#if defined(OPEN_MPI)
+#include <mpi-ext.h>
+#endif
 
 namespace ArborX
 {
 namespace Details
 {
 
+// Determine once at runtime whether device buffers may be passed directly to
+// MPI calls. The ARBORX_GPU_AWARE_MPI environment variable (0 or 1) takes
+// precedence, followed by the ARBORX_ENABLE_GPU_AWARE_MPI configure option,
+// followed by querying the MPI implementation when it exposes that
+// information.
+inline bool mpiSupportsDeviceBuffers()
+{
+  static bool const value = [] {
+    char const *env = std::getenv("ARBORX_GPU_AWARE_MPI");
+    if (env != nullptr)
+      return std::strcmp(env, "0") != 0;
+#if defined(ARBORX_ENABLE_GPU_AWARE_MPI)
+    return true;
+#elif defined(MPIX_CUDA_AWARE_SUPPORT)
+    return MPIX_Query_cuda_support() == 1;
+#elif defined(MPIX_ROCM_AWARE_SUPPORT)
+    return MPIX_Query_rocm_support() == 1;
+#else
+    return false;
+#endif
+  }();
+  return value;
+}
+
+template <typename MemorySpace>
+bool canPassBuffersDirectlyToMPI()
+{
+  // Host-accessible buffers can always be handed to MPI; device buffers
+  // require a GPU-aware implementation.
+  if constexpr (Kokkos::SpaceAccessibility<Kokkos::HostSpace,
+                                           MemorySpace>::accessible)
+    return true;
+  else
+    return mpiSupportsDeviceBuffers();
+}
+
+// Determine once at runtime whether the exchanges should go through MPI
+// neighborhood collectives over a distributed graph communicator matching the
+// plan's sparse connectivity instead of hand-rolled point-to-point messages.
+// On sparse communication graphs (each rank talking to a few neighbors out of
+// many) this hands the message schedule to the MPI implementation, which can
+// exploit the topology, and removes the per-exchange request bookkeeping.
+// Controlled by the ARBORX_NEIGHBOR_COLLECTIVES environment variable (0 or 1,
+// off by default).
+inline bool neighborCollectivesEnabled()
+{
+  static bool const value = [] {
+    char const *env = std::getenv("ARBORX_NEIGHBOR_COLLECTIVES");
+    return env != nullptr && std::strcmp(env, "0") != 0;
+  }();
+  return value;
+}
+
+// Determine once at runtime whether the exchanges should be node-aware,
+// grouping the ranks that share a node and scheduling their messages
+// separately from the inter-node ones. Controlled by the
+// ARBORX_HIERARCHICAL_EXCHANGE environment variable (0 or 1, off by default).
+inline bool hierarchicalExchangeEnabled()
+{
+  static bool const value = [] {
+    char const *env = std::getenv("ARBORX_HIERARCHICAL_EXCHANGE");
+    return env != nullptr && std::strcmp(env, "0") != 0;
+  }();
+  return value;
+}
+
+// Determine once at runtime whether small inter-group messages should be
+// aggregated through intermediate ranks instead of being sent directly. At
+// large scale the ranks near domain corners exchange many tiny messages and
+// the per-message overhead swamps the payload; routing them through two
+// levels of intermediaries trades extra bytes on the wire for an
+// inter-group message count per rank proportional to the number of groups
+// (~sqrt of the communicator size) instead of to the communicator size.
+// Controlled by the ARBORX_MULTI_HOP_EXCHANGE environment variable (0 or 1,
+// off by default).
+inline bool multiHopRoutingEnabled()
+{
+  static bool const value = [] {
+    char const *env = std::getenv("ARBORX_MULTI_HOP_EXCHANGE");
+    return env != nullptr && std::strcmp(env, "0") != 0;
+  }();
+  return value;
+}
+
+// Byte threshold under which an inter-group message is routed through
+// intermediate ranks when the multi-hop mode is enabled; larger messages
+// are bandwidth-bound and keep the direct path. Controlled by the
+// ARBORX_MULTI_HOP_THRESHOLD environment variable (in bytes, 4096 by
+// default).
+inline std::size_t multiHopMessageThreshold()
+{
+  static std::size_t const value = [] {
+    char const *env = std::getenv("ARBORX_MULTI_HOP_THRESHOLD");
+    return (env != nullptr ? (std::size_t)std::atoll(env)
+                           : (std::size_t)4096);
+  }();
+  return value;
+}
+
+// Determine once at runtime whether large messages should be compressed
+// before hitting the wire. Exchanged query results are typically structs
+// whose bytes are dominated by padding, unset fields and small-magnitude
+// integers, so a large fraction of them is zero; eliding the zero bytes
+// behind a presence bitmap shrinks such messages substantially on
+// bandwidth-constrained interconnects at the price of a compression kernel
+// per exchange and a message-size handshake. Controlled by the
+// ARBORX_COMPRESSED_EXCHANGE environment variable (0 or 1, off by default).
+inline bool compressedExchangeEnabled()
+{
+  static bool const value = [] {
+    char const *env = std::getenv("ARBORX_COMPRESSED_EXCHANGE");
+    return env != nullptr && std::strcmp(env, "0") != 0;
+  }();
+  return value;
+}
+
+// Byte threshold below which a message keeps the raw representation when the
+// compressed mode is enabled; small messages are latency-bound and the
+// compression kernels cost more than the bytes they would save. Controlled
+// by the ARBORX_COMPRESSED_EXCHANGE_THRESHOLD environment variable (in
+// bytes, 4096 by default).
+inline std::size_t compressedMessageThreshold()
+{
+  static std::size_t const value = [] {
+    char const *env = std::getenv("ARBORX_COMPRESSED_EXCHANGE_THRESHOLD");
+    return (env != nullptr ? (std::size_t)std::atoll(env)
+                           : (std::size_t)4096);
+  }();
+  return value;
+}
+
 // Assuming that batched_ranks might contain elements multiply, but duplicates
 // are not separated by other elements, return the unique elements in that array
 // with the corresponding element counts and displacement (offsets).
@@ -197,6 +339,137 @@ static void sortAndDetermineBufferLayout(ExecutionSpace const &space,
   ARBORX_ASSERT(offsets.back() == static_cast<int>(ranks.size()));
 }
 
+// Zero-elision codec used by the compressed exchange mode. The compressed
+// image of a message is a bitmap with one bit per payload byte (set when the
+// byte is nonzero) followed by the nonzero bytes in order. A message whose
+// image would not be smaller travels raw; the receiver tells the two
+// representations apart by comparing the wire size against the payload size
+// it knows from the communication plan. Both directions run one team per
+// message, with the byte positions inside a message recovered by a team-level
+// scan.
+
+// Count the nonzero bytes of each message of `bytes` (cut at `offsets`, in
+// bytes), which sizes its compressed image.
+template <typename ExecutionSpace, typename Bytes, typename Offsets,
+          typename Counts>
+void countNonzeroBytesPerMessage(ExecutionSpace const &space,
+                                 Bytes const &bytes, Offsets const &offsets,
+                                 Counts const &counts)
+{
+  using TeamPolicy = Kokkos::TeamPolicy<ExecutionSpace>;
+  int const num_messages = counts.extent(0);
+  Kokkos::parallel_for(
+      "ArborX::Distributor::count_nonzero_bytes",
+      TeamPolicy(space, num_messages, Kokkos::AUTO),
+      KOKKOS_LAMBDA(typename TeamPolicy::member_type const &team) {
+        int const i = team.league_rank();
+        int const begin = offsets(i);
+        int const length = offsets(i + 1) - begin;
+        int count;
+        Kokkos::parallel_reduce(
+            Kokkos::TeamThreadRange(team, length),
+            [&](int j, int &update) { update += (bytes(begin + j) != 0); },
+            count);
+        Kokkos::single(Kokkos::PerTeam(team), [&] { counts(i) = count; });
+      });
+}
+
+// Pack each message of `bytes` into its slot of `packed`. A packed slot the
+// size of the message receives a raw copy, an empty slot is skipped (the
+// same-rank message never leaves the device), anything else receives the
+// bitmap-plus-nonzero-bytes image.
+template <typename ExecutionSpace, typename Bytes, typename Offsets,
+          typename Packed>
+void compressMessages(ExecutionSpace const &space, Bytes const &bytes,
+                      Offsets const &offsets, Offsets const &packed_offsets,
+                      Packed const &packed)
+{
+  using TeamPolicy = Kokkos::TeamPolicy<ExecutionSpace>;
+  int const num_messages = offsets.extent(0) - 1;
+  Kokkos::parallel_for(
+      "ArborX::Distributor::compress_messages",
+      TeamPolicy(space, num_messages, Kokkos::AUTO),
+      KOKKOS_LAMBDA(typename TeamPolicy::member_type const &team) {
+        int const i = team.league_rank();
+        int const begin = offsets(i);
+        int const length = offsets(i + 1) - begin;
+        int const packed_begin = packed_offsets(i);
+        int const packed_length = packed_offsets(i + 1) - packed_begin;
+        if (packed_length == 0)
+          return;
+        if (packed_length == length)
+        {
+          Kokkos::parallel_for(Kokkos::TeamThreadRange(team, length),
+                               [&](int j) {
+                                 packed(packed_begin + j) = bytes(begin + j);
+                               });
+          return;
+        }
+        int const bitmap_length = (length + 7) / 8;
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange(team, bitmap_length), [&](int b) {
+              unsigned char mask = 0;
+              for (int k = 0; k < 8 && 8 * b + k < length; ++k)
+                if (bytes(begin + 8 * b + k) != 0)
+                  mask |= 1 << k;
+              packed(packed_begin + b) = (char)mask;
+            });
+        Kokkos::parallel_scan(
+            Kokkos::TeamThreadRange(team, length),
+            [&](int j, int &update, bool is_final) {
+              bool const nonzero = (bytes(begin + j) != 0);
+              if (is_final && nonzero)
+                packed(packed_begin + bitmap_length + update) =
+                    bytes(begin + j);
+              update += nonzero;
+            });
+      });
+}
+
+// Inverse of compressMessages() writing straight into the unpack
+// destination, so decompression needs no intermediate buffer.
+template <typename ExecutionSpace, typename Packed, typename Offsets,
+          typename Bytes>
+void decompressMessages(ExecutionSpace const &space, Packed const &packed,
+                        Offsets const &packed_offsets, Offsets const &offsets,
+                        Bytes const &bytes)
+{
+  using TeamPolicy = Kokkos::TeamPolicy<ExecutionSpace>;
+  int const num_messages = offsets.extent(0) - 1;
+  Kokkos::parallel_for(
+      "ArborX::Distributor::decompress_messages",
+      TeamPolicy(space, num_messages, Kokkos::AUTO),
+      KOKKOS_LAMBDA(typename TeamPolicy::member_type const &team) {
+        int const i = team.league_rank();
+        int const begin = offsets(i);
+        int const length = offsets(i + 1) - begin;
+        int const packed_begin = packed_offsets(i);
+        int const packed_length = packed_offsets(i + 1) - packed_begin;
+        if (packed_length == 0)
+          return;
+        if (packed_length == length)
+        {
+          Kokkos::parallel_for(Kokkos::TeamThreadRange(team, length),
+                               [&](int j) {
+                                 bytes(begin + j) = packed(packed_begin + j);
+                               });
+          return;
+        }
+        int const bitmap_length = (length + 7) / 8;
+        Kokkos::parallel_scan(
+            Kokkos::TeamThreadRange(team, length),
+            [&](int j, int &update, bool is_final) {
+              bool const nonzero =
+                  ((unsigned char)packed(packed_begin + j / 8) >> (j % 8)) & 1;
+              if (is_final)
+                bytes(begin + j) =
+                    (nonzero ? packed(packed_begin + bitmap_length + update)
+                             : 0);
+              update += nonzero;
+            });
+      });
+}
+
 template <typename DeviceType>
 class Distributor
 {
@@ -208,10 +481,28 @@ public:
                  0}
   {}
 
+  ~Distributor()
+  {
+    // Complete a count exchange that was never consumed
+    if (_counts_request != MPI_REQUEST_NULL)
+      MPI_Wait(&_counts_request, MPI_STATUS_IGNORE);
+    if (_node_comm != MPI_COMM_NULL)
+      MPI_Comm_free(&_node_comm);
+    if (_graph_comm != MPI_COMM_NULL)
+      MPI_Comm_free(&_graph_comm);
+  }
+
+  Distributor(Distributor const &) = delete;
+  Distributor &operator=(Distributor const &) = delete;
+
+  // Both overloads only post the exchange of the message counts. The number
+  // of imports becomes available through getTotalReceiveLength(), which
+  // completes the exchange; kernels launched in between overlap the
+  // collective.
   template <typename ExecutionSpace, typename View>
-  size_t createFromSends(ExecutionSpace const &space,
-                         View const &batched_destination_ranks,
-                         View const &batch_offsets)
+  void createFromSends(ExecutionSpace const &space,
+                       View const &batched_destination_ranks,
+                       View const &batch_offsets)
   {
     Kokkos::Profiling::ScopedRegion guard(
         "ArborX::Distributor::createFromSends(batched)");
@@ -227,12 +518,12 @@ public:
     determineBufferLayout(space, batched_destination_ranks, batch_offsets,
                           _permute, _destinations, _dest_offsets);
 
-    return preparePointToPointCommunication();
+    postCountExchange();
   }
 
   template <typename ExecutionSpace, typename View>
-  size_t createFromSends(ExecutionSpace const &space,
-                         View const &destination_ranks)
+  void createFromSends(ExecutionSpace const &space,
+                       View const &destination_ranks)
   {
     Kokkos::Profiling::ScopedRegion guard(
         "ArborX::Distributor::createFromSends");
@@ -248,7 +539,7 @@ public:
     sortAndDetermineBufferLayout(space, destination_ranks, _permute,
                                  _destinations, _dest_offsets);
 
-    return preparePointToPointCommunication();
+    postCountExchange();
   }
 
   template <typename ExecutionSpace, typename ExportView, typename ImportView>
@@ -258,6 +549,8 @@ public:
     Kokkos::Profiling::ScopedRegion guard(
         "ArborX::Distributor::doPostsAndWaits");
 
+    finishCountExchange();
+
     static_assert(ExportView::rank == 1 &&
                   (std::is_same_v<typename ExportView::array_layout,
                                   Kokkos::LayoutLeft> ||
@@ -297,6 +590,9 @@ public:
     auto permuted_exports = exports;
     if (permutation_necessary)
     {
+      Kokkos::Profiling::ScopedRegion guard(
+          "ArborX::Distributor::doPostsAndWaits::permute_exports");
+
       KokkosExt::reallocWithoutInitializing(space, permuted_exports_storage,
                                             exports.size());
 
@@ -307,6 +603,8 @@ public:
 
     int comm_rank;
     MPI_Comm_rank(_comm, &comm_rank);
+    int comm_size;
+    MPI_Comm_size(_comm, &comm_size);
 
     int same_rank_destination = -1;
     int same_rank_source = -1;
@@ -323,11 +621,197 @@ public:
       }
     }
 
-#ifndef ARBORX_ENABLE_GPU_AWARE_MPI
-    using MirrorSpace = typename ExportView::host_mirror_space;
+    // When a telemetry sink is installed for the current query, record the
+    // off-rank legs of this exchange; the same-rank data never touches the
+    // network
+    auto *telemetry_record =
+        recordTelemetryExchange(comm_rank, sizeof(ValueType));
 
-    auto exports_comm = Kokkos::create_mirror_view(
-        Kokkos::WithoutInitializing, MirrorSpace{}, permuted_exports);
+    // Compression changes the wire sizes, which every other mode derives
+    // from the count exchange; it therefore runs its own point-to-point
+    // schedule, size handshake included, and takes precedence when several
+    // modes are requested.
+    if (compressedExchangeEnabled())
+    {
+      exchangeCompressed(space, permuted_exports, imports,
+                         same_rank_destination, same_rank_source, comm_rank,
+                         telemetry_record);
+      return;
+    }
+
+    // The multi-hop mode repacks and forwards whole messages, which subsumes
+    // the scheduling the other modes provide; it takes precedence when
+    // several are requested. Below four ranks there is only one group and
+    // nothing to route.
+    bool const multi_hop = multiHopRoutingEnabled() && comm_size >= 4;
+
+    // With the hierarchical mode enabled, post the inter-node messages before
+    // the intra-node ones: they cross the network and take the longest, so
+    // they make progress while the node-local messages move over the much
+    // faster shared-memory or peer-to-peer transports.
+    bool const node_aware = !multi_hop && hierarchicalExchangeEnabled();
+    if (node_aware)
+      discoverNodeLocalRanks();
+    int const num_passes = (node_aware ? 2 : 1);
+    auto const pass_of = [&](int rank) {
+      return (node_aware && isNodeLocal(rank)) ? 1 : 0;
+    };
+
+    // The neighborhood collective schedules all messages in one call, which
+    // is at odds with the hierarchical two-pass ordering; the hierarchical
+    // mode takes precedence when both are requested.
+    bool const neighbor_collective =
+        !multi_hop && !node_aware && neighborCollectivesEnabled();
+
+    auto post_sends_and_receives = [&](auto const &exports_comm,
+                                       auto const &imports_comm) {
+      Kokkos::Profiling::ScopedRegion guard(
+          "ArborX::Distributor::doPostsAndWaits::exchange");
+
+      int const indegrees = _sources.size();
+      int const outdegrees = _destinations.size();
+
+      // Make sure the data is ready before sending it. Fencing before the
+      // receives are posted also guarantees that staging buffers recycled
+      // from the pinned arena are not handed to MPI while copies from an
+      // earlier exchange on this execution space instance are still in
+      // flight.
+      space.fence(
+          "ArborX::Distributor::doPostsAndWaits (data ready before sending)");
+
+      if (multi_hop)
+      {
+        Kokkos::Timer timer;
+        exchangeMultiHop(exports_comm.data(), imports_comm.data(),
+                         sizeof(ValueType), comm_rank, comm_size);
+        if (telemetry_record != nullptr)
+          telemetry_record->wait_time = timer.seconds();
+        return;
+      }
+
+      if (neighbor_collective)
+      {
+        // A single collective replaces the whole point-to-point schedule.
+        // The same-rank counts are zeroed out: that data moves through
+        // copy_same_rank_data() without ever leaving the device.
+        std::vector<int> send_counts(outdegrees);
+        std::vector<int> send_displs(outdegrees);
+        for (int i = 0; i < outdegrees; ++i)
+        {
+          send_displs[i] = _dest_offsets[i] * sizeof(ValueType);
+          send_counts[i] = (_destinations[i] == comm_rank
+                                ? 0
+                                : (_dest_offsets[i + 1] - _dest_offsets[i]) *
+                                      (int)sizeof(ValueType));
+        }
+        std::vector<int> recv_counts(indegrees);
+        std::vector<int> recv_displs(indegrees);
+        for (int i = 0; i < indegrees; ++i)
+        {
+          recv_displs[i] = _src_offsets[i] * sizeof(ValueType);
+          recv_counts[i] = (_sources[i] == comm_rank
+                                ? 0
+                                : (_src_offsets[i + 1] - _src_offsets[i]) *
+                                      (int)sizeof(ValueType));
+        }
+        Kokkos::Timer timer;
+        MPI_Neighbor_alltoallv(exports_comm.data(), send_counts.data(),
+                               send_displs.data(), MPI_BYTE,
+                               imports_comm.data(), recv_counts.data(),
+                               recv_displs.data(), MPI_BYTE, getGraphComm());
+        if (telemetry_record != nullptr)
+          telemetry_record->wait_time = timer.seconds();
+        return;
+      }
+
+      std::vector<MPI_Request> requests;
+      requests.reserve(outdegrees + indegrees);
+      for (int pass = 0; pass < num_passes; ++pass)
+        for (int i = 0; i < indegrees; ++i)
+        {
+          if (_sources[i] != comm_rank && pass_of(_sources[i]) == pass)
+          {
+            auto const receive_buffer_ptr =
+                imports_comm.data() + _src_offsets[i];
+            auto const message_size =
+                (_src_offsets[i + 1] - _src_offsets[i]) * sizeof(ValueType);
+            requests.emplace_back();
+            MPI_Irecv(receive_buffer_ptr, message_size, MPI_BYTE, _sources[i],
+                      123, _comm, &requests.back());
+          }
+        }
+
+      for (int pass = 0; pass < num_passes; ++pass)
+        for (int i = 0; i < outdegrees; ++i)
+        {
+          if (_destinations[i] != comm_rank &&
+              pass_of(_destinations[i]) == pass)
+          {
+            requests.emplace_back();
+            MPI_Isend(
+                exports_comm.data() + _dest_offsets[i],
+                (_dest_offsets[i + 1] - _dest_offsets[i]) * sizeof(ValueType),
+                MPI_BYTE, _destinations[i], 123, _comm, &requests.back());
+          }
+        }
+      if (!requests.empty())
+      {
+        Kokkos::Timer timer;
+        MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+        if (telemetry_record != nullptr)
+          telemetry_record->wait_time = timer.seconds();
+      }
+    };
+
+    auto copy_same_rank_data = [&](auto const &permuted_exports_arg) {
+      if (same_rank_destination != -1)
+      {
+        Kokkos::Profiling::ScopedRegion guard(
+            "ArborX::Distributor::doPostsAndWaits::copy_same_rank_data");
+
+        ARBORX_ASSERT((_src_offsets[same_rank_source + 1] -
+                       _src_offsets[same_rank_source]) ==
+                      (_dest_offsets[same_rank_destination + 1] -
+                       _dest_offsets[same_rank_destination]));
+        Kokkos::deep_copy(
+            space,
+            Kokkos::subview(imports,
+                            std::pair(_src_offsets[same_rank_source],
+                                      _src_offsets[same_rank_source + 1])),
+            Kokkos::subview(
+                permuted_exports_arg,
+                std::pair(_dest_offsets[same_rank_destination],
+                          _dest_offsets[same_rank_destination + 1])));
+      }
+    };
+
+    // The multi-hop repacking runs on the host, so device buffers must be
+    // staged even when MPI could consume them directly
+    bool const multi_hop_needs_staging =
+        multi_hop && !Kokkos::SpaceAccessibility<Kokkos::HostSpace,
+                                                 MemorySpace>::accessible;
+    if (canPassBuffersDirectlyToMPI<MemorySpace>() && !multi_hop_needs_staging)
+    {
+      post_sends_and_receives(permuted_exports, imports);
+      copy_same_rank_data(permuted_exports);
+      return;
+    }
+
+    // MPI cannot consume the device buffers, stage them through the host.
+    // The staging buffers are drawn from a pinned-memory arena: pinned pages
+    // keep the copies to and from the device asynchronous, so the
+    // per-interval copies overlap instead of synchronizing one by one, and
+    // the (expensive) pinned allocations are recycled across query calls.
+#ifdef KOKKOS_HAS_SHARED_HOST_PINNED_SPACE
+    using StagingSpace = Kokkos::SharedHostPinnedSpace;
+#else
+    using StagingSpace = Kokkos::HostSpace;
+#endif
+    KokkosExt::ScratchArena<StagingSpace> staging(space);
+
+    Kokkos::Profiling::pushRegion(
+        "ArborX::Distributor::doPostsAndWaits::stage_exports_on_host");
+    auto exports_comm = staging.allocate<ValueType>(permuted_exports.size());
     if (same_rank_destination != -1)
     {
       // Only copy the parts of the exports that we need to send remotely
@@ -342,49 +826,112 @@ public:
     {
       Kokkos::deep_copy(space, exports_comm, permuted_exports);
     }
-    auto imports_comm = Kokkos::create_mirror_view(Kokkos::WithoutInitializing,
-                                                   MirrorSpace{}, imports);
-#else
-    auto exports_comm = permuted_exports;
-    auto imports_comm = imports;
-#endif
+    auto imports_comm = staging.allocate<ValueType>(imports.size());
+    Kokkos::Profiling::popRegion();
 
-    int const indegrees = _sources.size();
-    int const outdegrees = _destinations.size();
-    std::vector<MPI_Request> requests;
-    requests.reserve(outdegrees + indegrees);
-    for (int i = 0; i < indegrees; ++i)
+    post_sends_and_receives(exports_comm, imports_comm);
+    copy_same_rank_data(permuted_exports);
+
+    Kokkos::Profiling::pushRegion(
+        "ArborX::Distributor::doPostsAndWaits::unstage_imports_from_host");
+    if (same_rank_destination != -1)
     {
-      if (_sources[i] != comm_rank)
-      {
-        auto const receive_buffer_ptr = imports_comm.data() + _src_offsets[i];
-        auto const message_size =
-            (_src_offsets[i + 1] - _src_offsets[i]) * sizeof(ValueType);
-        requests.emplace_back();
-        MPI_Irecv(receive_buffer_ptr, message_size, MPI_BYTE, _sources[i], 123,
-                  _comm, &requests.back());
-      }
+      for (auto interval : {std::make_pair(0, _src_offsets[same_rank_source]),
+                            std::make_pair(_src_offsets[same_rank_source + 1],
+                                           _src_offsets.back())})
+        Kokkos::deep_copy(space, Kokkos::subview(imports, interval),
+                          Kokkos::subview(imports_comm, interval));
+    }
+    else
+    {
+      Kokkos::deep_copy(space, imports, imports_comm);
     }
+    Kokkos::Profiling::popRegion();
+  }
 
-    // Make sure the data is ready before sending it
-    space.fence(
-        "ArborX::Distributor::doPostsAndWaits (data ready before sending)");
+  // Variant of doPostsAndWaits() that drives the receives with MPI_Waitsome
+  // and invokes segment_callback(source_rank, first, last) as soon as the
+  // half-open interval [first, last) of `imports` coming from source_rank has
+  // landed. The same-rank segment, if any, is delivered first. Work the
+  // callback submits on `space` is ordered after the segment data; reading a
+  // segment on the host requires fencing `space` inside the callback.
+  //
+  // The multi-hop, neighbor-collective, hierarchical and compressed modes
+  // schedule whole exchanges and only complete wholesale, so this always
+  // posts the plain point-to-point schedule regardless of the requested
+  // mode.
+  template <typename ExecutionSpace, typename ExportView, typename ImportView,
+            typename SegmentCallback>
+  void doPostsAndWaitsome(ExecutionSpace const &space,
+                          ExportView const &exports, ImportView const &imports,
+                          SegmentCallback const &segment_callback) const
+  {
+    Kokkos::Profiling::ScopedRegion guard(
+        "ArborX::Distributor::doPostsAndWaitsome");
 
-    for (int i = 0; i < outdegrees; ++i)
+    finishCountExchange();
+
+    using MemorySpace = typename ExportView::memory_space;
+    static_assert(
+        std::is_same_v<MemorySpace, typename ImportView::memory_space>);
+
+    using ValueType = typename ImportView::value_type;
+    static_assert(
+        std::is_same_v<ValueType,
+                       std::remove_cv_t<typename ExportView::value_type>>);
+
+    bool const permutation_necessary = _permute.size() != 0;
+
+    ARBORX_ASSERT(!permutation_necessary || exports.size() == _permute.size());
+    ARBORX_ASSERT(exports.size() == getTotalSendLength());
+    ARBORX_ASSERT(imports.size() == getTotalReceiveLength());
+
+    using ExportViewWithoutMemoryTraits =
+        Kokkos::View<typename ExportView::data_type,
+                     typename ExportView::array_layout,
+                     typename ExportView::device_type>;
+    ExportViewWithoutMemoryTraits permuted_exports_storage(
+        "ArborX::Distributor::doPostsAndWaitsome::permuted_exports", 0);
+
+    auto permuted_exports = exports;
+    if (permutation_necessary)
     {
-      if (_destinations[i] != comm_rank)
+      KokkosExt::reallocWithoutInitializing(space, permuted_exports_storage,
+                                            exports.size());
+      permuted_exports = permuted_exports_storage;
+      ArborX::Details::applyInversePermutation(space, _permute, exports,
+                                               permuted_exports);
+    }
+
+    int comm_rank;
+    MPI_Comm_rank(_comm, &comm_rank);
+
+    int same_rank_destination = -1;
+    int same_rank_source = -1;
+    {
+      auto it =
+          std::find(_destinations.begin(), _destinations.end(), comm_rank);
+      if (it != _destinations.end())
       {
-        requests.emplace_back();
-        MPI_Isend(exports_comm.data() + _dest_offsets[i],
-                  (_dest_offsets[i + 1] - _dest_offsets[i]) * sizeof(ValueType),
-                  MPI_BYTE, _destinations[i], 123, _comm, &requests.back());
+        same_rank_destination = it - _destinations.begin();
+
+        it = std::find(_sources.begin(), _sources.end(), comm_rank);
+        ARBORX_ASSERT(it != _sources.end());
+        same_rank_source = it - _sources.begin();
       }
     }
-    if (!requests.empty())
-      MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
 
-    if (same_rank_destination != -1)
-    {
+    auto *telemetry_record =
+        recordTelemetryExchange(comm_rank, sizeof(ValueType));
+
+    int const indegrees = _sources.size();
+    int const outdegrees = _destinations.size();
+
+    // The same-rank segment does not wait on any message, so it is moved
+    // (device-to-device) and handed to the callback before anything else
+    auto deliver_same_rank = [&](auto const &exports_device) {
+      if (same_rank_source == -1)
+        return;
       ARBORX_ASSERT((_src_offsets[same_rank_source + 1] -
                      _src_offsets[same_rank_source]) ==
                     (_dest_offsets[same_rank_destination + 1] -
@@ -394,65 +941,830 @@ public:
           Kokkos::subview(imports,
                           std::pair(_src_offsets[same_rank_source],
                                     _src_offsets[same_rank_source + 1])),
-          Kokkos::subview(permuted_exports,
+          Kokkos::subview(exports_device,
                           std::pair(_dest_offsets[same_rank_destination],
                                     _dest_offsets[same_rank_destination + 1])));
+      segment_callback(comm_rank, _src_offsets[same_rank_source],
+                       _src_offsets[same_rank_source + 1]);
+    };
+
+    // Posts the schedule, then loops MPI_Waitsome over the receives and calls
+    // deliver(i) for every source index i whose message has arrived
+    auto post_sends_and_stream_receives = [&](auto const &exports_comm,
+                                              auto const &imports_comm,
+                                              auto const &deliver) {
+      Kokkos::Profiling::ScopedRegion guard(
+          "ArborX::Distributor::doPostsAndWaitsome::exchange");
+
+      // Make sure the data is ready before sending it (see doPostsAndWaits()
+      // for why this also protects recycled staging buffers)
+      space.fence("ArborX::Distributor::doPostsAndWaitsome"
+                  " (data ready before sending)");
+
+      std::vector<MPI_Request> receive_requests;
+      std::vector<int> receive_sources;
+      receive_requests.reserve(indegrees);
+      receive_sources.reserve(indegrees);
+      for (int i = 0; i < indegrees; ++i)
+      {
+        if (_sources[i] == comm_rank)
+          continue;
+        receive_requests.emplace_back();
+        receive_sources.push_back(i);
+        MPI_Irecv(imports_comm.data() + _src_offsets[i],
+                  (_src_offsets[i + 1] - _src_offsets[i]) * sizeof(ValueType),
+                  MPI_BYTE, _sources[i], 123, _comm, &receive_requests.back());
+      }
+
+      std::vector<MPI_Request> send_requests;
+      send_requests.reserve(outdegrees);
+      for (int i = 0; i < outdegrees; ++i)
+      {
+        if (_destinations[i] == comm_rank)
+          continue;
+        send_requests.emplace_back();
+        MPI_Isend(
+            exports_comm.data() + _dest_offsets[i],
+            (_dest_offsets[i + 1] - _dest_offsets[i]) * sizeof(ValueType),
+            MPI_BYTE, _destinations[i], 123, _comm, &send_requests.back());
+      }
+
+      Kokkos::Timer timer;
+      int outstanding = (int)receive_requests.size();
+      std::vector<int> completed(receive_requests.size());
+      while (outstanding > 0)
+      {
+        int count;
+        MPI_Waitsome(receive_requests.size(), receive_requests.data(), &count,
+                     completed.data(), MPI_STATUSES_IGNORE);
+        for (int c = 0; c < count; ++c)
+          deliver(receive_sources[completed[c]]);
+        outstanding -= count;
+      }
+      if (!send_requests.empty())
+        MPI_Waitall(send_requests.size(), send_requests.data(),
+                    MPI_STATUSES_IGNORE);
+      if (telemetry_record != nullptr)
+        telemetry_record->wait_time = timer.seconds();
+    };
+
+    if (canPassBuffersDirectlyToMPI<MemorySpace>())
+    {
+      deliver_same_rank(permuted_exports);
+      post_sends_and_stream_receives(permuted_exports, imports, [&](int i) {
+        segment_callback(_sources[i], _src_offsets[i], _src_offsets[i + 1]);
+      });
+      return;
     }
 
-#ifndef ARBORX_ENABLE_GPU_AWARE_MPI
+    // MPI cannot consume the device buffers; stage them through the pinned
+    // arena like doPostsAndWaits(), except that every received interval is
+    // copied back to the device as soon as it arrives so that the callback
+    // never waits on an unrelated message
+#ifdef KOKKOS_HAS_SHARED_HOST_PINNED_SPACE
+    using StagingSpace = Kokkos::SharedHostPinnedSpace;
+#else
+    using StagingSpace = Kokkos::HostSpace;
+#endif
+    KokkosExt::ScratchArena<StagingSpace> staging(space);
+
+    auto exports_comm = staging.allocate<ValueType>(permuted_exports.size());
     if (same_rank_destination != -1)
     {
-      for (auto interval : {std::make_pair(0, _src_offsets[same_rank_source]),
-                            std::make_pair(_src_offsets[same_rank_source + 1],
-                                           _src_offsets.back())})
-        Kokkos::deep_copy(space, Kokkos::subview(imports, interval),
-                          Kokkos::subview(imports_comm, interval));
+      for (auto interval :
+           {std::make_pair(0, _dest_offsets[same_rank_destination]),
+            std::make_pair(_dest_offsets[same_rank_destination + 1],
+                           _dest_offsets.back())})
+        Kokkos::deep_copy(space, Kokkos::subview(exports_comm, interval),
+                          Kokkos::subview(permuted_exports, interval));
     }
     else
     {
-      Kokkos::deep_copy(space, imports, imports_comm);
+      Kokkos::deep_copy(space, exports_comm, permuted_exports);
     }
-#endif
+    auto imports_comm = staging.allocate<ValueType>(imports.size());
+
+    deliver_same_rank(permuted_exports);
+    post_sends_and_stream_receives(exports_comm, imports_comm, [&](int i) {
+      auto const interval = std::pair(_src_offsets[i], _src_offsets[i + 1]);
+      Kokkos::deep_copy(space, Kokkos::subview(imports, interval),
+                        Kokkos::subview(imports_comm, interval));
+      segment_callback(_sources[i], _src_offsets[i], _src_offsets[i + 1]);
+    });
+  }
+
+  // Host-side layout of the current plan, for consumers attributing the
+  // exchanged data to ranks (e.g. the query-load telemetry). Segment i of the
+  // exports, [getDestinationOffsets()[i], getDestinationOffsets()[i+1]), goes
+  // to getDestinationRanks()[i]; likewise for the imports and the sources.
+  std::vector<int> const &getDestinationRanks() const { return _destinations; }
+  std::vector<int> const &getDestinationOffsets() const
+  {
+    return _dest_offsets;
+  }
+  std::vector<int> const &getSourceRanks() const
+  {
+    finishCountExchange();
+    return _sources;
+  }
+  std::vector<int> const &getSourceOffsets() const
+  {
+    finishCountExchange();
+    return _src_offsets;
+  }
+
+  size_t getTotalReceiveLength() const
+  {
+    finishCountExchange();
+    return _src_offsets.back();
   }
-  size_t getTotalReceiveLength() const { return _src_offsets.back(); }
   size_t getTotalSendLength() const { return _dest_offsets.back(); }
 
+  // Fill in the source rank of every import slot. The provenance of an
+  // import is fully determined by the communication plan -- slot i in
+  // [_src_offsets[j], _src_offsets[j + 1]) was received from _sources[j] --
+  // so the ranks are reconstructed locally instead of being echoed over the
+  // network alongside every forwarded object.
+  template <typename ExecutionSpace, typename View>
+  void getImportSourceRanks(ExecutionSpace const &space, View &ranks) const
+  {
+    static_assert(View::rank == 1);
+    static_assert(std::is_same_v<typename View::non_const_value_type, int>);
+
+    finishCountExchange();
+
+    KokkosExt::reallocWithoutInitializing(space, ranks, _src_offsets.back());
+    auto ranks_host =
+        Kokkos::create_mirror_view(Kokkos::WithoutInitializing, ranks);
+    int const indegrees = _sources.size();
+    for (int j = 0; j < indegrees; ++j)
+      for (int i = _src_offsets[j]; i < _src_offsets[j + 1]; ++i)
+        ranks_host(i) = _sources[j];
+    Kokkos::deep_copy(space, ranks, ranks_host);
+    space.fence("ArborX::Distributor::getImportSourceRanks"
+                " (copy before host buffer goes out of scope)");
+  }
+
 private:
-  size_t preparePointToPointCommunication()
+  // Append a record for the off-rank legs of the upcoming exchange to the
+  // installed telemetry sink, if any. Returns nullptr when telemetry is off.
+  Experimental::DistributorTelemetry::Exchange *
+  recordTelemetryExchange(int comm_rank, std::size_t value_size) const
+  {
+    auto *telemetry = currentDistributorTelemetry();
+    if (telemetry == nullptr)
+      return nullptr;
+    auto &record = telemetry->exchanges.emplace_back();
+    int const outdegrees = _destinations.size();
+    for (int i = 0; i < outdegrees; ++i)
+      if (_destinations[i] != comm_rank)
+      {
+        record.destinations.push_back(_destinations[i]);
+        record.bytes_sent.push_back(
+            (long long)(_dest_offsets[i + 1] - _dest_offsets[i]) *
+            (long long)value_size);
+      }
+    int const indegrees = _sources.size();
+    for (int i = 0; i < indegrees; ++i)
+      if (_sources[i] != comm_rank)
+      {
+        record.sources.push_back(_sources[i]);
+        record.bytes_received.push_back(
+            (long long)(_src_offsets[i + 1] - _src_offsets[i]) *
+            (long long)value_size);
+      }
+    return &record;
+  }
+
+  // Post the nonblocking exchange of the message counts and return
+  // immediately. The matching wait happens in finishCountExchange().
+  void postCountExchange()
   {
     Kokkos::Profiling::ScopedRegion guard(
-        "ArborX::Distributor::preparePointToPointCommunication");
+        "ArborX::Distributor::postCountExchange");
 
     int comm_size;
     MPI_Comm_size(_comm, &comm_size);
 
-    std::vector<int> src_counts_dense(comm_size);
+    // A new plan invalidates the cached graph communicator
+    if (_graph_comm != MPI_COMM_NULL)
+      MPI_Comm_free(&_graph_comm);
+
+    _src_counts_dense.assign(comm_size, 0);
     int const dest_size = _destinations.size();
     for (int i = 0; i < dest_size; ++i)
     {
-      src_counts_dense[_destinations[i]] =
+      _src_counts_dense[_destinations[i]] =
           _dest_offsets[i + 1] - _dest_offsets[i];
     }
-    MPI_Alltoall(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, src_counts_dense.data(), 1,
+    MPI_Ialltoall(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, _src_counts_dense.data(),
+                  1, MPI_INT, _comm, &_counts_request);
+  }
+
+  // Group the ranks sharing a node with this one. The split is collective
+  // over the whole communicator, so it is only performed on the first
+  // exchange and cached; plans living in a DistributorPlanCache amortize it
+  // across queries.
+  void discoverNodeLocalRanks() const
+  {
+    if (_node_comm != MPI_COMM_NULL)
+      return;
+
+    Kokkos::Profiling::ScopedRegion guard(
+        "ArborX::Distributor::discoverNodeLocalRanks");
+
+    MPI_Comm_split_type(_comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL,
+                        &_node_comm);
+
+    int node_size;
+    MPI_Comm_size(_node_comm, &node_size);
+    _node_local_ranks.resize(node_size);
+
+    int comm_rank;
+    MPI_Comm_rank(_comm, &comm_rank);
+    MPI_Allgather(&comm_rank, 1, MPI_INT, _node_local_ranks.data(), 1, MPI_INT,
+                  _node_comm);
+    std::sort(_node_local_ranks.begin(), _node_local_ranks.end());
+  }
+
+  // Build, on first use, the distributed graph communicator matching this
+  // plan's sparse connectivity. The creation is collective over the whole
+  // communicator and is cached with the plan, so plans living in a
+  // DistributorPlanCache amortize it across queries.
+  MPI_Comm getGraphComm() const
+  {
+    if (_graph_comm == MPI_COMM_NULL)
+    {
+      Kokkos::Profiling::ScopedRegion guard(
+          "ArborX::Distributor::createGraphComm");
+
+      MPI_Dist_graph_create_adjacent(
+          _comm, _sources.size(), _sources.data(), MPI_UNWEIGHTED,
+          _destinations.size(), _destinations.data(), MPI_UNWEIGHTED,
+          MPI_INFO_NULL, /*reorder*/ 0, &_graph_comm);
+    }
+    return _graph_comm;
+  }
+
+  bool isNodeLocal(int rank) const
+  {
+    return std::binary_search(_node_local_ranks.begin(),
+                              _node_local_ranks.end(), rank);
+  }
+
+  // Exchange one variable-size byte packet per peer: the counts go through a
+  // dense integer all-to-all (the same price postCountExchange() already
+  // pays), the payloads through point-to-point messages. A packet addressed
+  // to this rank moves straight to the returned inboxes.
+  std::map<int, std::vector<char>>
+  exchangePackets(std::map<int, std::vector<char>> outboxes, int tag) const
+  {
+    int comm_rank;
+    MPI_Comm_rank(_comm, &comm_rank);
+    int comm_size;
+    MPI_Comm_size(_comm, &comm_size);
+
+    std::vector<int> send_counts(comm_size, 0);
+    for (auto const &[rank, packet] : outboxes)
+      send_counts[rank] = (int)packet.size();
+    std::vector<int> recv_counts(comm_size);
+    MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1,
                  MPI_INT, _comm);
 
+    std::map<int, std::vector<char>> inboxes;
+    std::vector<MPI_Request> requests;
+    for (int r = 0; r < comm_size; ++r)
+      if (recv_counts[r] > 0 && r != comm_rank)
+      {
+        auto &packet = inboxes[r];
+        packet.resize(recv_counts[r]);
+        requests.emplace_back();
+        MPI_Irecv(packet.data(), packet.size(), MPI_BYTE, r, tag, _comm,
+                  &requests.back());
+      }
+    for (auto &[rank, packet] : outboxes)
+    {
+      if (packet.empty())
+        continue;
+      if (rank == comm_rank)
+      {
+        inboxes[comm_rank] = std::move(packet);
+        continue;
+      }
+      requests.emplace_back();
+      MPI_Isend(packet.data(), packet.size(), MPI_BYTE, rank, tag, _comm,
+                &requests.back());
+    }
+    if (!requests.empty())
+      MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+    return inboxes;
+  }
+
+  // Exchange with per-message zero-elision compression. Each message above
+  // the size threshold whose compressed image is smaller than the raw bytes
+  // is packed on the device before the sends and unpacked into its import
+  // slots on arrival; everything else travels raw. The wire sizes are only
+  // known after compression, so unlike the other exchange paths the receives
+  // cannot be sized from the count exchange alone: a one-integer handshake
+  // per peer precedes the payload exchange, overlapped with the packing
+  // kernel.
+  template <typename ExecutionSpace, typename ExportView, typename ImportView>
+  void exchangeCompressed(
+      ExecutionSpace const &space, ExportView const &permuted_exports,
+      ImportView const &imports, int same_rank_destination,
+      int same_rank_source, int comm_rank,
+      Experimental::DistributorTelemetry::Exchange *telemetry_record) const
+  {
+    Kokkos::Profiling::ScopedRegion guard(
+        "ArborX::Distributor::exchangeCompressed");
+
+    using ValueType = typename ImportView::value_type;
+    using MemorySpace = typename ImportView::memory_space;
+    int const value_size = sizeof(ValueType);
+
+    int const outdegrees = _destinations.size();
+    int const indegrees = _sources.size();
+
+    Kokkos::View<char const *, MemorySpace,
+                 Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+        export_bytes(reinterpret_cast<char const *>(permuted_exports.data()),
+                     permuted_exports.size() * value_size);
+    Kokkos::View<char *, MemorySpace, Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+        import_bytes(reinterpret_cast<char *>(imports.data()),
+                     imports.size() * value_size);
+
+    auto to_device_offsets = [&space](std::string const &label,
+                                      std::vector<int> const &host_offsets) {
+      Kokkos::View<int *, MemorySpace> device_offsets(
+          Kokkos::view_alloc(space, Kokkos::WithoutInitializing, label),
+          host_offsets.size());
+      Kokkos::deep_copy(space, device_offsets,
+                        Kokkos::View<int const *, Kokkos::HostSpace,
+                                     Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
+                            host_offsets.data(), host_offsets.size()));
+      return device_offsets;
+    };
+
+    std::vector<int> export_byte_offsets(outdegrees + 1);
+    for (int i = 0; i <= outdegrees; ++i)
+      export_byte_offsets[i] = _dest_offsets[i] * value_size;
+    auto export_offsets = to_device_offsets(
+        "ArborX::Distributor::exchangeCompressed::export_offsets",
+        export_byte_offsets);
+
+    // Size the compressed images
+    Kokkos::View<int *, MemorySpace> nonzero_counts(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::Distributor::exchangeCompressed::nonzero_counts"),
+        outdegrees);
+    countNonzeroBytesPerMessage(space, export_bytes, export_offsets,
+                                nonzero_counts);
+    auto nonzero_counts_host = Kokkos::create_mirror_view(nonzero_counts);
+    Kokkos::deep_copy(space, nonzero_counts_host, nonzero_counts);
+    space.fence(
+        "ArborX::Distributor::exchangeCompressed (nonzero counts on host)");
+
+    auto const threshold = compressedMessageThreshold();
+    std::vector<int> send_sizes(outdegrees);
+    std::vector<int> send_offsets(outdegrees + 1);
+    send_offsets[0] = 0;
+    for (int i = 0; i < outdegrees; ++i)
+    {
+      int const length = export_byte_offsets[i + 1] - export_byte_offsets[i];
+      int const compressed = (length + 7) / 8 + nonzero_counts_host(i);
+      send_sizes[i] =
+          (_destinations[i] == comm_rank
+               ? 0
+               : ((std::size_t)length > threshold && compressed < length
+                      ? compressed
+                      : length));
+      send_offsets[i + 1] = send_offsets[i] + send_sizes[i];
+    }
+
+    // Pack asynchronously; the size handshake below overlaps with the kernel
+    Kokkos::View<char *, MemorySpace> packed_exports(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::Distributor::exchangeCompressed::packed_exports"),
+        send_offsets.back());
+    auto packed_export_offsets = to_device_offsets(
+        "ArborX::Distributor::exchangeCompressed::packed_export_offsets",
+        send_offsets);
+    compressMessages(space, export_bytes, export_offsets,
+                     packed_export_offsets, packed_exports);
+
+    std::vector<int> recv_sizes(indegrees, 0);
+    {
+      std::vector<MPI_Request> requests;
+      requests.reserve(outdegrees + indegrees);
+      for (int i = 0; i < indegrees; ++i)
+        if (_sources[i] != comm_rank)
+        {
+          requests.emplace_back();
+          MPI_Irecv(&recv_sizes[i], 1, MPI_INT, _sources[i], 127, _comm,
+                    &requests.back());
+        }
+      for (int i = 0; i < outdegrees; ++i)
+        if (_destinations[i] != comm_rank)
+        {
+          requests.emplace_back();
+          MPI_Isend(&send_sizes[i], 1, MPI_INT, _destinations[i], 127, _comm,
+                    &requests.back());
+        }
+      if (!requests.empty())
+        MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+    }
+    std::vector<int> recv_offsets(indegrees + 1);
+    recv_offsets[0] = 0;
+    for (int i = 0; i < indegrees; ++i)
+      recv_offsets[i + 1] = recv_offsets[i] + recv_sizes[i];
+
+    // Telemetry reports what actually crosses the wire
+    if (telemetry_record != nullptr)
+    {
+      telemetry_record->bytes_sent.clear();
+      for (int i = 0; i < outdegrees; ++i)
+        if (_destinations[i] != comm_rank)
+          telemetry_record->bytes_sent.push_back(send_sizes[i]);
+      telemetry_record->bytes_received.clear();
+      for (int i = 0; i < indegrees; ++i)
+        if (_sources[i] != comm_rank)
+          telemetry_record->bytes_received.push_back(recv_sizes[i]);
+    }
+
+    Kokkos::View<char *, MemorySpace> packed_imports(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::Distributor::exchangeCompressed::packed_imports"),
+        recv_offsets.back());
+
+    auto post_sends_and_receives = [&](auto const &exports_comm,
+                                       auto const &imports_comm) {
+      // Make sure the packed data is ready before sending it
+      space.fence(
+          "ArborX::Distributor::exchangeCompressed (data ready before "
+          "sending)");
+
+      std::vector<MPI_Request> requests;
+      requests.reserve(outdegrees + indegrees);
+      for (int i = 0; i < indegrees; ++i)
+        if (_sources[i] != comm_rank)
+        {
+          requests.emplace_back();
+          MPI_Irecv(imports_comm.data() + recv_offsets[i], recv_sizes[i],
+                    MPI_BYTE, _sources[i], 128, _comm, &requests.back());
+        }
+      for (int i = 0; i < outdegrees; ++i)
+        if (_destinations[i] != comm_rank)
+        {
+          requests.emplace_back();
+          MPI_Isend(exports_comm.data() + send_offsets[i], send_sizes[i],
+                    MPI_BYTE, _destinations[i], 128, _comm, &requests.back());
+        }
+      if (!requests.empty())
+      {
+        Kokkos::Timer timer;
+        MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+        if (telemetry_record != nullptr)
+          telemetry_record->wait_time = timer.seconds();
+      }
+    };
+
+    auto copy_same_rank_data = [&] {
+      if (same_rank_destination != -1)
+      {
+        ARBORX_ASSERT((_src_offsets[same_rank_source + 1] -
+                       _src_offsets[same_rank_source]) ==
+                      (_dest_offsets[same_rank_destination + 1] -
+                       _dest_offsets[same_rank_destination]));
+        Kokkos::deep_copy(
+            space,
+            Kokkos::subview(imports,
+                            std::pair(_src_offsets[same_rank_source],
+                                      _src_offsets[same_rank_source + 1])),
+            Kokkos::subview(
+                permuted_exports,
+                std::pair(_dest_offsets[same_rank_destination],
+                          _dest_offsets[same_rank_destination + 1])));
+      }
+    };
+
+#ifdef KOKKOS_HAS_SHARED_HOST_PINNED_SPACE
+    using StagingSpace = Kokkos::SharedHostPinnedSpace;
+#else
+    using StagingSpace = Kokkos::HostSpace;
+#endif
+    KokkosExt::ScratchArena<StagingSpace> staging(space);
+    if (canPassBuffersDirectlyToMPI<MemorySpace>())
+    {
+      post_sends_and_receives(packed_exports, packed_imports);
+      copy_same_rank_data();
+    }
+    else
+    {
+      auto exports_comm = staging.allocate<char>(packed_exports.size());
+      Kokkos::deep_copy(space, exports_comm, packed_exports);
+      auto imports_comm = staging.allocate<char>(packed_imports.size());
+      post_sends_and_receives(exports_comm, imports_comm);
+      copy_same_rank_data();
+      Kokkos::deep_copy(space, packed_imports, imports_comm);
+    }
+
+    // Unpack, decompressing straight into the import slots
+    std::vector<int> import_byte_offsets(indegrees + 1);
+    for (int i = 0; i <= indegrees; ++i)
+      import_byte_offsets[i] = _src_offsets[i] * value_size;
+    auto import_offsets = to_device_offsets(
+        "ArborX::Distributor::exchangeCompressed::import_offsets",
+        import_byte_offsets);
+    auto packed_import_offsets = to_device_offsets(
+        "ArborX::Distributor::exchangeCompressed::packed_import_offsets",
+        recv_offsets);
+    decompressMessages(space, packed_imports, packed_import_offsets,
+                       import_offsets, import_bytes);
+  }
+
+  // Multi-hop exchange over host-accessible buffers. The ranks are cut into
+  // ~sqrt(comm_size) contiguous groups standing in for the groups of the
+  // network topology (which MPI does not expose portably). Messages that are
+  // large or group-local keep the direct path; a small inter-group message
+  // makes three hops, each of which aggregates everything sharing the next
+  // leg into one packet:
+  //   1. to the member of this group responsible for the destination group,
+  //   2. across to the destination group's member responsible for this group,
+  //   3. to its final destination within that group.
+  // Each record travels with its original source and final destination, and
+  // the source determines the import slot on delivery, so the hops need no
+  // coordination beyond their packet count exchanges. The routing decision
+  // depends only on the plan and the message size, so the receivers post the
+  // matching direct receives without being told.
+  void exchangeMultiHop(void const *exports_data, void *imports_data,
+                        std::size_t value_size, int comm_rank,
+                        int comm_size) const
+  {
+    auto const *exports_bytes = static_cast<char const *>(exports_data);
+    auto *imports_bytes = static_cast<char *>(imports_data);
+
+    int const group_size = (int)std::ceil(std::sqrt((double)comm_size));
+    auto group_of = [=](int rank) { return rank / group_size; };
+    auto group_begin = [=](int group) { return group * group_size; };
+    auto group_count = [=](int group) {
+      return std::min(group_size, comm_size - group * group_size);
+    };
+
+    auto const threshold = multiHopMessageThreshold();
+    auto routed = [&](int peer, std::size_t num_bytes) {
+      return num_bytes > 0 && num_bytes <= threshold &&
+             group_of(peer) != group_of(comm_rank);
+    };
+
+    int const indegrees = _sources.size();
+    int const outdegrees = _destinations.size();
+
+    // Direct legs first, so they progress while the hops run
+    std::vector<MPI_Request> requests;
+    for (int i = 0; i < indegrees; ++i)
+    {
+      std::size_t const num_bytes =
+          (_src_offsets[i + 1] - _src_offsets[i]) * value_size;
+      if (_sources[i] != comm_rank && !routed(_sources[i], num_bytes))
+      {
+        requests.emplace_back();
+        MPI_Irecv(imports_bytes + _src_offsets[i] * value_size, num_bytes,
+                  MPI_BYTE, _sources[i], 123, _comm, &requests.back());
+      }
+    }
+    for (int i = 0; i < outdegrees; ++i)
+    {
+      std::size_t const num_bytes =
+          (_dest_offsets[i + 1] - _dest_offsets[i]) * value_size;
+      if (_destinations[i] != comm_rank &&
+          !routed(_destinations[i], num_bytes))
+      {
+        requests.emplace_back();
+        MPI_Isend(exports_bytes + _dest_offsets[i] * value_size, num_bytes,
+                  MPI_BYTE, _destinations[i], 123, _comm, &requests.back());
+      }
+    }
+
+    struct RecordHeader
+    {
+      int source;
+      int destination;
+      int num_bytes;
+    };
+    auto append_record = [](std::vector<char> &packet,
+                            RecordHeader const &header, char const *payload) {
+      auto const old_size = packet.size();
+      packet.resize(old_size + sizeof(RecordHeader) + header.num_bytes);
+      std::memcpy(packet.data() + old_size, &header, sizeof(RecordHeader));
+      std::memcpy(packet.data() + old_size + sizeof(RecordHeader), payload,
+                  header.num_bytes);
+    };
+    auto forward_records = [&](std::map<int, std::vector<char>> const &inboxes,
+                               auto const &next_hop_rank) {
+      std::map<int, std::vector<char>> outboxes;
+      for (auto const &[peer, packet] : inboxes)
+        for (std::size_t pos = 0; pos < packet.size();)
+        {
+          RecordHeader header;
+          std::memcpy(&header, packet.data() + pos, sizeof(RecordHeader));
+          auto const record_size = sizeof(RecordHeader) + header.num_bytes;
+          auto &outbox = outboxes[next_hop_rank(header)];
+          outbox.insert(outbox.end(), packet.begin() + pos,
+                        packet.begin() + pos + record_size);
+          pos += record_size;
+        }
+      return outboxes;
+    };
+
+    // Hop 1: hand each routed message to the aggregator of its destination
+    // group within this rank's group
+    std::map<int, std::vector<char>> outboxes;
+    for (int i = 0; i < outdegrees; ++i)
+    {
+      int const destination = _destinations[i];
+      std::size_t const num_bytes =
+          (_dest_offsets[i + 1] - _dest_offsets[i]) * value_size;
+      if (destination == comm_rank || !routed(destination, num_bytes))
+        continue;
+      int const aggregator =
+          group_begin(group_of(comm_rank)) +
+          group_of(destination) % group_count(group_of(comm_rank));
+      append_record(outboxes[aggregator],
+                    {comm_rank, destination, (int)num_bytes},
+                    exports_bytes + _dest_offsets[i] * value_size);
+    }
+    auto inboxes = exchangePackets(std::move(outboxes), 124);
+
+    // Hop 2: ship each destination group's aggregate across to the member of
+    // that group responsible for deliveries from this group
+    inboxes = exchangePackets(
+        forward_records(inboxes,
+                        [&](RecordHeader const &header) {
+                          int const group = group_of(header.destination);
+                          return group_begin(group) +
+                                 group_of(comm_rank) % group_count(group);
+                        }),
+        125);
+
+    // Hop 3: fan the aggregates out to their final destinations within this
+    // group
+    inboxes = exchangePackets(
+        forward_records(inboxes, [](RecordHeader const &header) {
+          return header.destination;
+        }),
+        126);
+
+    // Every source sends this rank at most one message, so its import slot
+    // interval is determined by the plan
+    std::map<int, std::size_t> import_offsets;
+    for (int i = 0; i < indegrees; ++i)
+      import_offsets[_sources[i]] = _src_offsets[i] * value_size;
+    for (auto const &[peer, packet] : inboxes)
+      for (std::size_t pos = 0; pos < packet.size();)
+      {
+        RecordHeader header;
+        std::memcpy(&header, packet.data() + pos, sizeof(RecordHeader));
+        ARBORX_ASSERT(header.destination == comm_rank);
+        auto const it = import_offsets.find(header.source);
+        ARBORX_ASSERT(it != import_offsets.end());
+        std::memcpy(imports_bytes + it->second,
+                    packet.data() + pos + sizeof(RecordHeader),
+                    header.num_bytes);
+        pos += sizeof(RecordHeader) + header.num_bytes;
+      }
+
+    if (!requests.empty())
+      MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+  }
+
+  void finishCountExchange() const
+  {
+    if (_counts_request == MPI_REQUEST_NULL)
+      return;
+
+    Kokkos::Profiling::ScopedRegion guard(
+        "ArborX::Distributor::finishCountExchange");
+
+    Kokkos::Timer timer;
+    MPI_Wait(&_counts_request, MPI_STATUS_IGNORE);
+    if (auto *telemetry = currentDistributorTelemetry())
+      telemetry->count_wait_time += timer.seconds();
+
+    int const comm_size = _src_counts_dense.size();
     _src_offsets.push_back(0);
     for (int i = 0; i < comm_size; ++i)
-      if (src_counts_dense[i] > 0)
+      if (_src_counts_dense[i] > 0)
       {
         _sources.push_back(i);
-        _src_offsets.push_back(_src_offsets.back() + src_counts_dense[i]);
+        _src_offsets.push_back(_src_offsets.back() + _src_counts_dense[i]);
       }
-
-    return _src_offsets.back();
   }
 
   MPI_Comm _comm;
   Kokkos::View<int *, DeviceType> _permute;
   std::vector<int> _dest_offsets;
-  std::vector<int> _src_offsets;
-  std::vector<int> _sources;
   std::vector<int> _destinations;
+  // Receive-side layout is computed lazily when the posted count exchange
+  // completes, hence the mutable members
+  mutable MPI_Request _counts_request = MPI_REQUEST_NULL;
+  mutable std::vector<int> _src_counts_dense;
+  mutable std::vector<int> _src_offsets;
+  mutable std::vector<int> _sources;
+  // Node-local rank grouping is discovered lazily on the first exchange when
+  // the hierarchical mode is enabled
+  mutable MPI_Comm _node_comm = MPI_COMM_NULL;
+  mutable std::vector<int> _node_local_ranks;
+  // Distributed graph communicator matching the plan, created lazily when
+  // the neighborhood-collective mode is enabled
+  mutable MPI_Comm _graph_comm = MPI_COMM_NULL;
+};
+
+// Order-sensitive fingerprint of the send pattern a communication plan was
+// created from, allowing a cached plan to be revalidated with a single
+// reduction instead of recomputing the buffer layout
+template <typename ExecutionSpace, typename View>
+unsigned long long sendPatternSignature(ExecutionSpace const &space,
+                                        View const &view)
+{
+  static_assert(std::is_same_v<typename View::non_const_value_type, int>);
+
+  unsigned long long signature;
+  Kokkos::parallel_reduce(
+      "ArborX::Distributor::send_pattern_signature",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, view.size()),
+      KOKKOS_LAMBDA(int i, unsigned long long &update) {
+        // Mixing the index into the hash keeps the commutative reduction
+        // sensitive to the order of the destinations
+        auto h = (unsigned long long)view(i) +
+                 0x9E3779B97F4A7C15ull * (unsigned long long)(i + 1);
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        update += h;
+      },
+      signature);
+  return signature + view.size();
+}
+
+template <typename ExecutionSpace, typename View, typename... Views>
+unsigned long long sendPatternSignature(ExecutionSpace const &space,
+                                        View const &view,
+                                        Views const &...views)
+{
+  return 3 * sendPatternSignature(space, view) +
+         sendPatternSignature(space, views...);
+}
+
+// Opt-in cache of communication plans for query patterns that repeat across
+// queries (e.g. a halo exchange performed every timestep). The cache is
+// sequence-based: every query resets the cursor and the distributor creation
+// sites consume one slot each in a deterministic order, so identical
+// consecutive queries hit their previous plans without any call-site keys.
+// Revalidation compares hashes of the send pattern; a false positive would
+// require a 64-bit hash collision between two patterns of the same
+// application.
+template <typename MemorySpace>
+class DistributorPlanCache
+{
+public:
+  // Start a new pass over the cached plans; called at the beginning of every
+  // query
+  void reset() { _cursor = 0; }
+
+  template <typename ExecutionSpace, typename... Views>
+  Distributor<MemorySpace> &getOrCreate(MPI_Comm comm,
+                                        ExecutionSpace const &space,
+                                        Views const &...views)
+  {
+    Kokkos::Profiling::ScopedRegion guard(
+        "ArborX::DistributorPlanCache::getOrCreate");
+
+    if (_cursor == (int)_entries.size())
+      _entries.emplace_back();
+    auto &entry = _entries[_cursor++];
+
+    auto const signature = sendPatternSignature(space, views...);
+    if (entry.plan && entry.signature == signature)
+      return *entry.plan;
+
+    entry.plan = std::make_unique<Distributor<MemorySpace>>(comm);
+    entry.signature = signature;
+    entry.plan->createFromSends(space, views...);
+    return *entry.plan;
+  }
+
+private:
+  struct Entry
+  {
+    std::unique_ptr<Distributor<MemorySpace>> plan;
+    unsigned long long signature = 0;
+  };
+
+  std::vector<Entry> _entries;
+  int _cursor = 0;
 };
 
 } // namespace Details
@@ -0,0 +1,189 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILS_DUAL_TREE_TRAVERSAL_HPP
+#define ARBORX_DETAILS_DUAL_TREE_TRAVERSAL_HPP
+
+#include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_DetailsHappyTreeFriends.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <utility>
+
+namespace ArborX::Details
+{
+
+// Bounding volume of any node, leaf or internal. Leaves store indexables
+// rather than volumes, so theirs is built on the fly.
+template <class BVH>
+KOKKOS_INLINE_FUNCTION auto nodeBoundingVolume(BVH const &bvh, int node)
+{
+  using BoundingVolume = typename BVH::bounding_volume_type;
+  if (!HappyTreeFriends::isLeaf(bvh, node))
+    return HappyTreeFriends::getInternalBoundingVolume(bvh, node);
+  BoundingVolume volume{};
+  expand(volume, HappyTreeFriends::getIndexable(bvh, node));
+  return volume;
+}
+
+// Simultaneous descent over two bounding volume hierarchies, invoking the
+// callback with every pair of values (one from each tree) whose indexables
+// intersect. Compared to turning one tree's primitives into predicates
+// against the other tree, the pruning works on pairs of subtrees: two
+// bodies that barely touch discard almost all of both hierarchies within a
+// few levels instead of paying one root-to-leaf descent per primitive.
+//
+// The candidate pair frontier is expanded breadth first, one device pass
+// per level. This exposes every surviving pair of a level to the parallel
+// loop, instead of serializing a depth-first pair stack in each thread.
+template <class BVH1, class BVH2, class Callback>
+struct DualTreeTraversal
+{
+  using MemorySpace = typename BVH1::memory_space;
+
+  BVH1 _bvh1;
+  BVH2 _bvh2;
+  Callback _callback;
+
+  template <class ExecutionSpace>
+  DualTreeTraversal(ExecutionSpace const &space, BVH1 const &bvh1,
+                    BVH2 const &bvh2, Callback const &callback)
+      : _bvh1{bvh1}
+      , _bvh2{bvh2}
+      , _callback{callback}
+  {
+    if (_bvh1.empty() || _bvh2.empty() ||
+        !intersects(_bvh1.bounds(), _bvh2.bounds()))
+      return;
+
+    if (_bvh1.size() == 1 || _bvh2.size() == 1)
+    {
+      // A single-leaf tree offers no subtree pairs to prune; test its only
+      // primitive against every primitive of the other tree
+      auto const local_bvh1 = _bvh1;
+      auto const local_bvh2 = _bvh2;
+      auto const local_callback = _callback;
+      int const n2 = _bvh2.size();
+      Kokkos::parallel_for(
+          "ArborX::DualTreeTraversal::degenerate",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0,
+                                              (int)_bvh1.size() * n2),
+          KOKKOS_LAMBDA(int k) {
+            int const i = k / n2;
+            int const j = k % n2;
+            if (HappyTreeFriends::isLive(local_bvh1, i) &&
+                HappyTreeFriends::isLive(local_bvh2, j) &&
+                intersects(HappyTreeFriends::getIndexable(local_bvh1, i),
+                           HappyTreeFriends::getIndexable(local_bvh2, j)))
+              local_callback(HappyTreeFriends::getValue(local_bvh1, i),
+                             HappyTreeFriends::getValue(local_bvh2, j));
+          });
+      return;
+    }
+
+    auto const local_bvh1 = _bvh1;
+    auto const local_bvh2 = _bvh2;
+    auto const local_callback = _callback;
+
+    using PairOfNodes = Kokkos::pair<int, int>;
+    Kokkos::View<PairOfNodes *, MemorySpace> current(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::DualTreeTraversal::current_pairs"),
+        1);
+    Kokkos::View<PairOfNodes *, MemorySpace> next(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::DualTreeTraversal::next_pairs"),
+        4);
+    Kokkos::View<int, MemorySpace> count("ArborX::DualTreeTraversal::count");
+
+    Kokkos::parallel_for(
+        "ArborX::DualTreeTraversal::seed",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, 1), KOKKOS_LAMBDA(int) {
+          current(0) = {HappyTreeFriends::getRoot(local_bvh1),
+                        HappyTreeFriends::getRoot(local_bvh2)};
+        });
+
+    int num_pairs = 1;
+    while (num_pairs > 0)
+    {
+      // Every surviving pair produces at most four children, so a single
+      // atomic append into a pre-sized buffer cannot overflow
+      if ((int)next.extent(0) < 4 * num_pairs)
+        KokkosExt::reallocWithoutInitializing(space, next, 4 * num_pairs);
+      Kokkos::deep_copy(space, count, 0);
+
+      auto const local_current = current;
+      auto const local_next = next;
+      Kokkos::parallel_for(
+          "ArborX::DualTreeTraversal::expand_pairs",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_pairs),
+          KOKKOS_LAMBDA(int p) {
+            auto const pair = local_current(p);
+            int const a = pair.first;
+            int const b = pair.second;
+            bool const leaf_a = HappyTreeFriends::isLeaf(local_bvh1, a);
+            bool const leaf_b = HappyTreeFriends::isLeaf(local_bvh2, b);
+
+            if (leaf_a && leaf_b)
+            {
+              // Values removed by remove_if() keep their leaf slots; skip
+              // them here like the single-tree traversals do
+              if (HappyTreeFriends::isLive(local_bvh1, a) &&
+                  HappyTreeFriends::isLive(local_bvh2, b) &&
+                  intersects(HappyTreeFriends::getIndexable(local_bvh1, a),
+                             HappyTreeFriends::getIndexable(local_bvh2, b)))
+                local_callback(HappyTreeFriends::getValue(local_bvh1, a),
+                               HappyTreeFriends::getValue(local_bvh2, b));
+              return;
+            }
+
+            // Descend every non-leaf side one level and keep the child
+            // pairs whose volumes overlap
+            int children_a[2] = {a, a};
+            int children_b[2] = {b, b};
+            int num_a = 1;
+            int num_b = 1;
+            if (!leaf_a)
+            {
+              children_a[0] = HappyTreeFriends::getLeftChild(local_bvh1, a);
+              children_a[1] = HappyTreeFriends::getRightChild(local_bvh1, a);
+              num_a = 2;
+            }
+            if (!leaf_b)
+            {
+              children_b[0] = HappyTreeFriends::getLeftChild(local_bvh2, b);
+              children_b[1] = HappyTreeFriends::getRightChild(local_bvh2, b);
+              num_b = 2;
+            }
+            for (int u = 0; u < num_a; ++u)
+              for (int v = 0; v < num_b; ++v)
+                if (intersects(
+                        nodeBoundingVolume(local_bvh1, children_a[u]),
+                        nodeBoundingVolume(local_bvh2, children_b[v])))
+                {
+                  int const slot = Kokkos::atomic_fetch_add(&count(), 1);
+                  local_next(slot) = {children_a[u], children_b[v]};
+                }
+          });
+
+      auto count_host =
+          Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, count);
+      num_pairs = count_host();
+      std::swap(current, next);
+    }
+  }
+};
+
+} // namespace ArborX::Details
+
+#endif
@@ -14,6 +14,7 @@
 
 #include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
 #include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DetailsSortUtils.hpp>
 
 #include <Kokkos_Core.hpp>
 
@@ -28,41 +29,53 @@ void expandHalfToFull(ExecutionSpace const &space, Offsets &offsets,
   typename Offsets::const_type const offsets_orig = offsets;
   typename Indices::const_type const indices_orig = indices;
 
-  auto const n = offsets.extent(0) - 1;
-  offsets = KokkosExt::cloneWithoutInitializingNorCopying(space, offsets_orig);
-  Kokkos::deep_copy(space, offsets, 0);
+  using MemorySpace = typename Indices::memory_space;
+
+  int const n = offsets.extent(0) - 1;
+  auto const m = 2 * indices_orig.extent(0);
+
+  // Write both orientations of every half pair into an arena in a single
+  // pass. Each pair owns two fixed slots determined by its position in the
+  // half graph, so unlike counting degrees first there is no atomic
+  // contention on high-degree rows and no second traversal of the half
+  // graph.
+  Kokkos::View<int *, MemorySpace> rows(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::Experimental::HalfToFull::rows"),
+      m);
+  KokkosExt::reallocWithoutInitializing(space, indices, m);
   Kokkos::parallel_for(
-      "ArborX::Experimental::HalfToFull::count",
+      "ArborX::Experimental::HalfToFull::fill_pairs",
       Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
         for (int j = offsets_orig(i); j < offsets_orig(i + 1); ++j)
         {
           int const k = indices_orig(j);
-          Kokkos::atomic_increment(&offsets(i));
-          Kokkos::atomic_increment(&offsets(k));
+          rows(2 * j) = i;
+          indices(2 * j) = k;
+          rows(2 * j + 1) = k;
+          indices(2 * j + 1) = i;
         }
       });
-  KokkosExt::exclusive_scan(space, offsets, offsets, 0);
 
-  auto const m = KokkosExt::lastElement(space, offsets);
-  KokkosExt::reallocWithoutInitializing(space, indices, m);
+  // Group the arena by row and recover the offsets from the sorted rows
+  sortObjects(space, rows, indices);
 
-  auto counts = KokkosExt::clone(space, offsets,
-                                 "ArborX::Experimental::HalfToFull::counts");
   Kokkos::parallel_for(
-      "ArborX::Experimental::HalfToFull::rewrite",
-      Kokkos::TeamPolicy<ExecutionSpace>(space, n, Kokkos::AUTO, 1),
-      KOKKOS_LAMBDA(
-          typename Kokkos::TeamPolicy<ExecutionSpace>::member_type const
-              &member) {
-        auto const i = member.league_rank();
-        auto const first = offsets_orig(i);
-        auto const last = offsets_orig(i + 1);
-        Kokkos::parallel_for(
-            Kokkos::TeamVectorRange(member, last - first), [&](int j) {
-              int const k = indices_orig(first + j);
-              indices(Kokkos::atomic_fetch_inc(&counts(i))) = k;
-              indices(Kokkos::atomic_fetch_inc(&counts(k))) = i;
-            });
+      "ArborX::Experimental::HalfToFull::compute_offsets",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n + 1),
+      KOKKOS_LAMBDA(int i) {
+        // Lower bound of row i in the sorted rows
+        int first = 0;
+        int last = (int)m;
+        while (first < last)
+        {
+          int const middle = first + (last - first) / 2;
+          if (rows(middle) < i)
+            first = middle + 1;
+          else
+            last = middle;
+        }
+        offsets(i) = first;
       });
   Kokkos::Profiling::popRegion();
 }
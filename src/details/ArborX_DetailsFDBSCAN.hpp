@@ -34,9 +34,12 @@ struct CountUpToN
   KOKKOS_FUNCTION auto operator()(Query const &query, Value const &) const
   {
     auto i = getData(query);
-    Kokkos::atomic_increment(&_counts(i));
+    // The counter is only ever touched by the thread traversing query i, so
+    // the value returned by the atomic is the up-to-date count; testing it
+    // avoids re-loading the counter from memory for every visited neighbor
+    int const count = Kokkos::atomic_fetch_add(&_counts(i), 1) + 1;
 
-    if (_counts(i) < _n)
+    if (count < _n)
       return ArborX::CallbackTreeTraversalControl::normal_continuation;
 
     // Once count reaches threshold, terminate the traversal.
@@ -62,7 +62,9 @@ struct CountUpToN_DenseBox
 
     bool const is_dense_cell = (k < _num_dense_cells);
 
-    int &count = _counts(i);
+    // The counter is only ever touched by the thread traversing query i, so
+    // the value returned by the atomic is the up-to-date count; testing it
+    // avoids re-loading the counter from memory for every visited neighbor
     if (is_dense_cell)
     {
       auto const &query_point = _primitives(i);
@@ -74,7 +76,7 @@ struct CountUpToN_DenseBox
         int j = _permute(jj);
         if (distance(query_point, _primitives(j)) <= eps)
         {
-          Kokkos::atomic_increment(&count);
+          int const count = Kokkos::atomic_fetch_add(&_counts(i), 1) + 1;
           if (count >= _n)
             return ArborX::CallbackTreeTraversalControl::early_exit;
         }
@@ -82,7 +84,7 @@ struct CountUpToN_DenseBox
     }
     else
     {
-      Kokkos::atomic_increment(&count);
+      int const count = Kokkos::atomic_fetch_add(&_counts(i), 1) + 1;
       if (count >= _n)
         return ArborX::CallbackTreeTraversalControl::early_exit;
     }
@@ -208,6 +210,52 @@ computeCellIndices(ExecutionSpace const &exec_space,
   return cell_indices;
 }
 
+template <typename ExecutionSpace, typename CellOffsets>
+int countPointsInDenseCells(ExecutionSpace const &exec_space,
+                            CellOffsets cell_offsets, int cutoff)
+{
+  auto const num_nonempty_cells = cell_offsets.size() - 1;
+
+  int num_points_in_dense_cells;
+  Kokkos::parallel_reduce(
+      "ArborX::DBSCAN::count_points_in_dense_cells",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_nonempty_cells),
+      KOKKOS_LAMBDA(int i, int &update) {
+        int num_points_in_cell = cell_offsets(i + 1) - cell_offsets(i);
+        if (num_points_in_cell >= cutoff)
+          update += num_points_in_cell;
+      },
+      num_points_in_dense_cells);
+  return num_points_in_dense_cells;
+}
+
+// Select the dense-cell occupancy cutoff from the distribution of cell
+// occupancies. core_min_size is the floor: a cell with that many points
+// guarantees that all of its points are core points and may be merged
+// directly, so the cutoff may only be raised, never lowered. On data with
+// strong density variance the distribution has a long tail of cells sitting
+// right at the floor; each of them becomes a box primitive with an unprunable
+// scan while contributing almost nothing to the pairwise work the dense path
+// saves, which grows quadratically with occupancy. Double the cutoff as long
+// as the shed cells hold under 5% of the points the floor would capture. On
+// data with a narrow occupancy distribution the first candidate already
+// exceeds the budget and the floor is kept, preserving the usual behavior.
+template <typename ExecutionSpace, typename CellOffsets>
+int tuneDenseCellCutoff(ExecutionSpace const &exec_space,
+                        CellOffsets cell_offsets, int core_min_size)
+{
+  int const num_floor_points =
+      countPointsInDenseCells(exec_space, cell_offsets, core_min_size);
+  if (num_floor_points == 0)
+    return core_min_size;
+
+  int cutoff = core_min_size;
+  while (countPointsInDenseCells(exec_space, cell_offsets, 2 * cutoff) >=
+         0.95f * num_floor_points)
+    cutoff *= 2;
+  return cutoff;
+}
+
 template <typename ExecutionSpace, typename CellIndices, typename CellOffsets,
           typename Permutation>
 int reorderDenseAndSparseCells(ExecutionSpace const &exec_space,
@@ -223,16 +271,8 @@ int reorderDenseAndSparseCells(ExecutionSpace const &exec_space,
   auto const num_nonempty_cells = cell_offsets.size() - 1;
 
   // Count the number of points in the dense cells
-  int num_points_in_dense_cells;
-  Kokkos::parallel_reduce(
-      "ArborX::DBSCAN::count_points_in_dense_cells",
-      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_nonempty_cells),
-      KOKKOS_LAMBDA(int i, int &update) {
-        int num_points_in_cell = cell_offsets(i + 1) - cell_offsets(i);
-        if (num_points_in_cell >= core_min_size)
-          update += num_points_in_cell;
-      },
-      num_points_in_dense_cells);
+  int num_points_in_dense_cells =
+      countPointsInDenseCells(exec_space, cell_offsets, core_min_size);
 
   // Create new arrays of cells indices and permute, so that the points in the
   // dense cells go first, and the points in non-dense (sparse) cells go after
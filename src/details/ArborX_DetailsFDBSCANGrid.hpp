@@ -0,0 +1,198 @@
+/****************************************************************************
+ * Copyright (c) 2017-2022 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILSFDBSCANGRID_HPP
+#define ARBORX_DETAILSFDBSCANGRID_HPP
+
+#include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_DetailsCartesianGrid.hpp>
+#include <ArborX_GeometryTraits.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX
+{
+namespace Details
+{
+
+// Invoke f with the range of positions [begin, end) in the sorted cell
+// indices array for every nonempty cell in the 3^DIM stencil centered at the
+// given cell. Stop early as soon as f returns true.
+//
+// The grid cell length is assumed to be at least eps, so that the stencil is
+// guaranteed to contain the full eps-neighborhood of every point in the
+// center cell.
+template <int DIM, typename CellIndices, typename F>
+KOKKOS_FUNCTION void
+forEachNeighboringCell(CartesianGrid<DIM> const &grid,
+                       CellIndices const &sorted_cell_indices, size_t cell,
+                       F const &f)
+{
+  int multi_index[DIM];
+  {
+    auto s = cell;
+    for (int d = 0; d < DIM; ++d)
+    {
+      multi_index[d] = s % grid.extent(d);
+      s /= grid.extent(d);
+    }
+  }
+
+  int num_stencil_cells = 1;
+  for (int d = 0; d < DIM; ++d)
+    num_stencil_cells *= 3;
+
+  int const n = sorted_cell_indices.size();
+  for (int m = 0; m < num_stencil_cells; ++m)
+  {
+    int neighbor_index[DIM];
+    bool out_of_bounds = false;
+    int rem = m;
+    for (int d = 0; d < DIM; ++d)
+    {
+      neighbor_index[d] = multi_index[d] + (rem % 3 - 1);
+      rem /= 3;
+      out_of_bounds |= (neighbor_index[d] < 0 ||
+                        neighbor_index[d] >= (int)grid.extent(d));
+    }
+    if (out_of_bounds)
+      continue;
+
+    // Match the index linearization of CartesianGrid::cellIndex()
+    size_t neighbor_cell = 0;
+    for (int d = DIM - 1; d >= 0; --d)
+      neighbor_cell = neighbor_cell * grid.extent(d) + neighbor_index[d];
+
+    // Locate the points of the neighbor cell through binary search in the
+    // sorted cell indices
+    int first = 0;
+    int last = n;
+    while (first < last)
+    {
+      int const mid = first + (last - first) / 2;
+      if (sorted_cell_indices(mid) < neighbor_cell)
+        first = mid + 1;
+      else
+        last = mid;
+    }
+    if (first == n || sorted_cell_indices(first) != neighbor_cell)
+      continue;
+
+    int lo = first;
+    int hi = n;
+    while (lo < hi)
+    {
+      int const mid = lo + (hi - lo) / 2;
+      if (sorted_cell_indices(mid) == neighbor_cell)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+
+    if (f(first, lo))
+      break;
+  }
+}
+
+template <typename ExecutionSpace, typename Points, typename CellIndices,
+          typename Permutation, typename MemorySpace>
+void countNeighborsWithinGridStencil(
+    ExecutionSpace const &exec_space, Points const &points,
+    CartesianGrid<GeometryTraits::dimension_v<
+        typename Points::value_type>> const &grid,
+    CellIndices const &sorted_cell_indices, Permutation const &permute,
+    float eps, int core_min_size,
+    Kokkos::View<int *, MemorySpace> const &num_neigh)
+{
+  auto const n = points.size();
+  Kokkos::parallel_for(
+      "ArborX::DBSCAN::count_neighbors_within_grid_stencil",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int ii) {
+        int const i = permute(ii);
+        auto const &query_point = points(i);
+
+        // The count includes the point itself, matching the counts produced
+        // by the eps-neighborhood queries of the other implementations
+        int count = 0;
+        forEachNeighboringCell(
+            grid, sorted_cell_indices, sorted_cell_indices(ii),
+            [&](int begin, int end) {
+              for (int jj = begin; jj < end; ++jj)
+              {
+                if (distance(query_point, points(permute(jj))) <= eps)
+                {
+                  ++count;
+                  if (count >= core_min_size)
+                    return true;
+                }
+              }
+              return false;
+            });
+        num_neigh(i) = count;
+      });
+}
+
+template <typename ExecutionSpace, typename Points, typename CellIndices,
+          typename Permutation, typename CorePointsType, typename UnionFind>
+void unionFindWithinGridStencil(
+    ExecutionSpace const &exec_space, Points const &points,
+    CartesianGrid<GeometryTraits::dimension_v<
+        typename Points::value_type>> const &grid,
+    CellIndices const &sorted_cell_indices, Permutation const &permute,
+    float eps, CorePointsType is_core_point, UnionFind union_find)
+{
+  auto const n = points.size();
+  Kokkos::parallel_for(
+      "ArborX::DBSCAN::union_find_within_grid_stencil",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int ii) {
+        int const i = permute(ii);
+
+        // Border points are merged in from the side of their core neighbors
+        if (!is_core_point(i))
+          return;
+
+        auto const &query_point = points(i);
+
+        forEachNeighboringCell(
+            grid, sorted_cell_indices, sorted_cell_indices(ii),
+            [&](int begin, int end) {
+              for (int jj = begin; jj < end; ++jj)
+              {
+                int const j = permute(jj);
+                if (distance(query_point, points(j)) > eps)
+                  continue;
+
+                bool const is_neighbor_core_point = is_core_point(j);
+                if (is_neighbor_core_point && i > j)
+                {
+                  // Each core-core pair is visited from both sides, only
+                  // process it from the larger index
+                  union_find.merge(i, j);
+                }
+                else if (!is_neighbor_core_point)
+                {
+                  // Merge the border point in without the risk of making it a
+                  // representative and forming a bridge with a different
+                  // cluster (see NOTE in FDBSCANCallback)
+                  union_find.merge_into(j, i);
+                }
+              }
+              return false;
+            });
+      });
+}
+
+} // namespace Details
+} // namespace ArborX
+
+#endif
@@ -0,0 +1,271 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILS_FLAT_CLUSTERING_HPP
+#define ARBORX_DETAILS_FLAT_CLUSTERING_HPP
+
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_Exception.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Details
+{
+
+// Density level corresponding to a merge height (lambda = 1/distance);
+// zero-height merges happen at effectively infinite density
+KOKKOS_INLINE_FUNCTION float eomLambda(float height)
+{
+  return (height > 0 ? 1 / height
+                     : KokkosExt::ArithmeticTraits::finite_max<float>::value);
+}
+
+// Extract flat clusters from a dendrogram through excess-of-mass (EOM)
+// stability selection, entirely on device.
+//
+// The dendrogram is given by the parents array (parents of the num_edges
+// edges first, followed by the parents of the num_vertices vertices, with -1
+// marking the root edge) and the edge heights, as produced by
+// Experimental::Dendrogram. Conceptually, every edge corresponds to the
+// component formed below it, which is born when the distance threshold drops
+// below the height of its parent and splits when it drops below its own
+// height (in lambda = 1/distance terms, exists for lambda in [lambda_birth,
+// lambda_split]).
+//
+// A split is real only if both sides have at least min_cluster_size points;
+// otherwise the smaller side "falls out" and the component keeps its
+// identity. Edges between two real splits therefore condense into a single
+// cluster, whose stability is the sum over its fallouts and final split of
+// (number of points leaving) * (lambda at which they leave - lambda_birth).
+// A cluster is selected if its stability is at least the sum of the best
+// selections in its subtrees; the root cluster is never selected, so data
+// with no real split yields only noise.
+//
+// The computation maps onto the parent/height arrays with four patterns:
+// a bottom-up counting pass where the second thread entering a node
+// proceeds and the first one dies (same idea as the hierarchy refit in
+// ArborX_DetailsTreeConstruction.hpp), pointer jumping to condense edges to
+// their cluster roots, flat transforms with atomic accumulation for the
+// stabilities, and a bottom-up pass over the (binary) cluster tree for the
+// selection.
+//
+// Returns per-vertex labels holding the root edge index of the selected
+// cluster a vertex belongs to, or -1 for noise.
+template <typename ExecutionSpace, typename Parents, typename Heights>
+Kokkos::View<int *, typename Parents::memory_space>
+extractEOMClusters(ExecutionSpace const &exec_space, Parents const &parents,
+                   Heights const &heights, int min_cluster_size)
+{
+  using MemorySpace = typename Parents::memory_space;
+
+  ARBORX_ASSERT(min_cluster_size >= 2);
+
+  int const num_edges = heights.size();
+  int const num_vertices = num_edges + 1;
+  int const vertices_offset = num_edges;
+  ARBORX_ASSERT((int)parents.size() == num_edges + num_vertices);
+
+  Kokkos::View<int *, MemorySpace> labels(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::HDBSCAN::labels"),
+      num_vertices);
+  if (num_edges == 0)
+  {
+    Kokkos::deep_copy(exec_space, labels, -1);
+    return labels;
+  }
+
+  constexpr int UNTOUCHED = -1;
+
+  // Compute the number of points below every edge. Every vertex climbs
+  // towards the root; the first thread entering an edge deposits its count
+  // and dies, the second one adds both counts up and proceeds.
+  Kokkos::View<int *, MemorySpace> counts(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::HDBSCAN::counts"),
+      num_edges);
+  Kokkos::deep_copy(exec_space, counts, UNTOUCHED);
+  Kokkos::parallel_for(
+      "ArborX::HDBSCAN::flat_clusters::compute_counts",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_vertices),
+      KOKKOS_LAMBDA(int i) {
+        int count = 1;
+        int e = parents(vertices_offset + i);
+        do
+        {
+          int other =
+              Kokkos::atomic_compare_exchange(&counts(e), UNTOUCHED, count);
+          if (other == UNTOUCHED)
+            break;
+          count += other;
+          counts(e) = count;
+          e = parents(e);
+        } while (e != -1);
+      });
+
+  // Condense every edge to its cluster root: the closest ancestor-or-self
+  // edge that is either the root or a real-split child. Pointer jumping
+  // halves the remaining chain lengths in every iteration; stale reads only
+  // cost an extra iteration.
+  Kokkos::View<int *, MemorySpace> cluster_ids(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::HDBSCAN::cluster_ids"),
+      num_edges);
+  Kokkos::parallel_for(
+      "ArborX::HDBSCAN::flat_clusters::init_cluster_ids",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_edges),
+      KOKKOS_LAMBDA(int e) {
+        int const p = parents(e);
+        bool const is_cluster_root =
+            (p == -1) || (counts(e) >= min_cluster_size &&
+                          counts(p) - counts(e) >= min_cluster_size);
+        cluster_ids(e) = (is_cluster_root ? e : p);
+      });
+  int num_changes;
+  do
+  {
+    Kokkos::parallel_reduce(
+        "ArborX::HDBSCAN::flat_clusters::condense_cluster_ids",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_edges),
+        KOKKOS_LAMBDA(int e, int &update) {
+          int const c = cluster_ids(e);
+          int const cc = cluster_ids(c);
+          if (cc != c)
+          {
+            cluster_ids(e) = cc;
+            ++update;
+          }
+        },
+        num_changes);
+  } while (num_changes > 0);
+
+  // Accumulate the cluster stabilities. Every edge and every vertex knows
+  // the node at which it merges, and whether it leaves the cluster there:
+  // the smaller side of a lopsided split falls out, and both sides of a
+  // real split leave (the cluster dies there). Splits inside a component
+  // that already fell out of its cluster do not contribute; an edge still
+  // carries its cluster iff it holds at least min_cluster_size points.
+  Kokkos::View<float *, MemorySpace> stabilities(
+      Kokkos::view_alloc(exec_space, "ArborX::HDBSCAN::stabilities"),
+      num_edges);
+  Kokkos::parallel_for(
+      "ArborX::HDBSCAN::flat_clusters::compute_stabilities",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0,
+                                          num_edges + num_vertices),
+      KOKKOS_LAMBDA(int i) {
+        int const p = parents(i);
+        if (p == -1 || counts(p) < min_cluster_size)
+          return;
+        int const count = (i < num_edges ? counts(i) : 1);
+        int const sibling_count = counts(p) - count;
+        bool const leaves =
+            (count < min_cluster_size || sibling_count >= min_cluster_size);
+        if (!leaves)
+          return;
+        int const cluster = cluster_ids(p);
+        int const above = parents(cluster);
+        float const lambda_birth =
+            (above == -1 ? 0.f : eomLambda(heights(above)));
+        Kokkos::atomic_add(&stabilities(cluster),
+                           count * (eomLambda(heights(p)) - lambda_birth));
+      });
+
+  // Select clusters bottom-up over the cluster tree, which is binary: a
+  // cluster has either two children (through its real split) or none. A
+  // cluster is tentatively selected if its own stability reaches the sum of
+  // the best selections below it; the final selection keeps the tentatively
+  // selected clusters without a tentatively selected ancestor.
+  Kokkos::View<int *, MemorySpace> num_children(
+      Kokkos::view_alloc(exec_space, "ArborX::HDBSCAN::num_children"),
+      num_edges);
+  Kokkos::View<int *, MemorySpace> selected(
+      Kokkos::view_alloc(exec_space, "ArborX::HDBSCAN::selected"), num_edges);
+  Kokkos::View<float *, MemorySpace> accumulated(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::HDBSCAN::accumulated"),
+      num_edges);
+  Kokkos::deep_copy(exec_space, accumulated, -1.f);
+  Kokkos::parallel_for(
+      "ArborX::HDBSCAN::flat_clusters::count_cluster_children",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_edges),
+      KOKKOS_LAMBDA(int e) {
+        if (cluster_ids(e) == e && parents(e) != -1)
+          Kokkos::atomic_inc(&num_children(cluster_ids(parents(e))));
+      });
+  Kokkos::parallel_for(
+      "ArborX::HDBSCAN::flat_clusters::select_clusters",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_edges),
+      KOKKOS_LAMBDA(int e) {
+        if (cluster_ids(e) != e || num_children(e) > 0)
+          return;
+
+        // Start from a leaf cluster and climb. The accumulated stability
+        // doubles as the arrival flag: the first child deposits its value,
+        // the second one completes the sum and proceeds.
+        int cluster = e;
+        selected(cluster) = (parents(cluster) != -1);
+        float best = Kokkos::max(stabilities(cluster), 0.f);
+        while (parents(cluster) != -1)
+        {
+          int const parent_cluster = cluster_ids(parents(cluster));
+          float other = Kokkos::atomic_compare_exchange(
+              &accumulated(parent_cluster), -1.f, best);
+          if (other == -1.f)
+            break;
+          float const children_sum = other + best;
+          float const stability = stabilities(parent_cluster);
+          selected(parent_cluster) = (parents(parent_cluster) != -1 &&
+                                      stability >= children_sum);
+          best = Kokkos::max(stability, children_sum);
+          cluster = parent_cluster;
+        }
+      });
+
+  // Resolve every cluster to the highest tentatively selected cluster on
+  // its ancestor-or-self chain, which is exactly the final EOM selection.
+  // The walk is linear in the cluster tree depth, which is negligible next
+  // to the number of edges.
+  Kokkos::View<int *, MemorySpace> flat(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::HDBSCAN::flat"),
+      num_edges);
+  Kokkos::parallel_for(
+      "ArborX::HDBSCAN::flat_clusters::resolve_flat_labels",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_edges),
+      KOKKOS_LAMBDA(int e) {
+        if (cluster_ids(e) != e)
+          return;
+        int best = -1;
+        int cluster = e;
+        while (true)
+        {
+          if (selected(cluster))
+            best = cluster;
+          if (parents(cluster) == -1)
+            break;
+          cluster = cluster_ids(parents(cluster));
+        }
+        flat(e) = best;
+      });
+
+  Kokkos::parallel_for(
+      "ArborX::HDBSCAN::flat_clusters::assign_labels",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_vertices),
+      KOKKOS_LAMBDA(int i) {
+        labels(i) = flat(cluster_ids(parents(vertices_offset + i)));
+      });
+
+  return labels;
+}
+
+} // namespace ArborX::Details
+
+#endif
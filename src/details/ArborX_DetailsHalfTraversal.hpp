@@ -52,6 +52,12 @@ struct HalfTraversal
 
   KOKKOS_FUNCTION void operator()(int i) const
   {
+    // Values removed by remove_if() keep their leaf slots; they must not
+    // show up in any pair, neither as the owner of the predicate nor as the
+    // visited side
+    if (!HappyTreeFriends::isLive(_bvh, i))
+      return;
+
     auto const leaf_value = HappyTreeFriends::getValue(_bvh, i);
     auto const predicate = _get_predicate(leaf_value);
 
@@ -60,7 +66,8 @@ struct HalfTraversal
     {
       if (HappyTreeFriends::isLeaf(_bvh, node))
       {
-        if (predicate(HappyTreeFriends::getIndexable(_bvh, node)))
+        if (HappyTreeFriends::isLive(_bvh, node) &&
+            predicate(HappyTreeFriends::getIndexable(_bvh, node)))
           _callback(leaf_value, HappyTreeFriends::getValue(_bvh, node));
         node = HappyTreeFriends::getRope(_bvh, node);
       }
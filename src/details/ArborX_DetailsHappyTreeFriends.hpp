@@ -12,6 +12,8 @@
 #ifndef ARBORX_DETAILS_HAPPY_TREE_FRIENDS_HPP
 #define ARBORX_DETAILS_HAPPY_TREE_FRIENDS_HPP
 
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+
 #include <Kokkos_Assert.hpp> // KOKKOS_ASSERT
 #include <Kokkos_Macros.hpp>
 
@@ -22,6 +24,16 @@ namespace ArborX::Details
 
 struct HappyTreeFriends
 {
+  // Detect trees whose leaves store the value without its index
+  // (Experimental::ImplicitIndex); other tree types do not declare the flag
+  template <class BVH, class = void>
+  struct HasImplicitIndex : std::false_type
+  {};
+  template <class BVH>
+  struct HasImplicitIndex<BVH, std::enable_if_t<BVH::has_implicit_index>>
+      : std::true_type
+  {};
+
   template <class BVH>
   static KOKKOS_FUNCTION int getRoot(BVH const &bvh)
   {
@@ -51,16 +63,38 @@ struct HappyTreeFriends
   }
 
   template <class BVH>
-  static KOKKOS_FUNCTION auto const &getIndexable(BVH const &bvh, int i)
+  static KOKKOS_FUNCTION decltype(auto) getIndexable(BVH const &bvh, int i)
+  {
+    if constexpr (HasImplicitIndex<BVH>::value)
+    {
+      // Apply the getter to the stored value directly: getValue() returns a
+      // reconstructed pair by value, whose indexable would dangle
+      KOKKOS_ASSERT(i >= 0 && i < (int)bvh.size());
+      return bvh._indexable_getter(bvh._leaf_nodes(i).value);
+    }
+    else
+    {
+      return bvh._indexable_getter(getValue(bvh, i));
+    }
+  }
+
+  template <class BVH>
+  static KOKKOS_FUNCTION decltype(auto) getValue(BVH const &bvh, int i)
   {
-    return bvh._indexable_getter(getValue(bvh, i));
+    KOKKOS_ASSERT(i >= 0 && i < (int)bvh.size());
+    if constexpr (HasImplicitIndex<BVH>::value)
+      return typename BVH::value_type{
+          bvh._leaf_nodes(i).value,
+          typename BVH::value_type::index_type(bvh._leaf_permutation(i))};
+    else
+      return (bvh._leaf_nodes(i).value);
   }
 
   template <class BVH>
-  static KOKKOS_FUNCTION auto const &getValue(BVH const &bvh, int i)
+  static KOKKOS_FUNCTION bool isLive(BVH const &bvh, int i)
   {
     KOKKOS_ASSERT(i >= 0 && i < (int)bvh.size());
-    return bvh._leaf_nodes(i).value;
+    return bvh._tombstones.extent(0) == 0 || bvh._tombstones(i) == 0;
   }
 
   template <class BVH>
@@ -77,6 +111,33 @@ struct HappyTreeFriends
     return getRope(bvh, getLeftChild(bvh, i));
   }
 
+  template <class BVH>
+  static auto const &getLeafNodes(BVH const &bvh)
+  {
+    return bvh._leaf_nodes;
+  }
+
+  template <class BVH>
+  static auto const &getInternalNodes(BVH const &bvh)
+  {
+    return bvh._internal_nodes;
+  }
+
+  // Replace a tree's node storage (and the lazily allocated per-leaf arrays)
+  // with a private deep copy. Backdoor for wrappers that mutate a standby
+  // copy of a tree while queries keep reading the original (see
+  // Experimental::VersionedBVH).
+  template <class ExecutionSpace, class BVH>
+  static void detachNodeStorage(ExecutionSpace const &space, BVH &bvh)
+  {
+    bvh._leaf_nodes = KokkosExt::clone(space, bvh._leaf_nodes);
+    bvh._internal_nodes = KokkosExt::clone(space, bvh._internal_nodes);
+    if (bvh._tombstones.extent(0) > 0)
+      bvh._tombstones = KokkosExt::clone(space, bvh._tombstones);
+    if (bvh._leaf_permutation.extent(0) > 0)
+      bvh._leaf_permutation = KokkosExt::clone(space, bvh._leaf_permutation);
+  }
+
   template <class BVH>
   static KOKKOS_FUNCTION auto getRope(BVH const &bvh, int i)
   {
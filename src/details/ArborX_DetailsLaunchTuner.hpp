@@ -0,0 +1,180 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#ifndef ARBORX_DETAILS_LAUNCH_TUNER_HPP
+#define ARBORX_DETAILS_LAUNCH_TUNER_HPP
+
+#include <Kokkos_Core.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace ArborX::Details
+{
+
+// Sweeps launch parameters of the traversal kernels at runtime. The defaults
+// Kokkos picks for the thread-block size (the chunk size of a RangePolicy)
+// and the team size of a TeamPolicy are not optimal for every device and
+// kernel shape, and hard-coding per-architecture values does not survive a
+// heterogeneous fleet. When enabled through the ARBORX_TUNE_KERNEL_LAUNCH
+// environment variable, the first invocations of each (kernel, backend,
+// problem-size bucket) combination cycle through a fixed set of candidate
+// launch parameters, each timed between fences on the execution space the
+// query was issued on, and the fastest candidate is locked in for the rest
+// of the run. Decided launches add a mutex-protected map lookup and nothing
+// else; when the variable is not set, the launches go straight through.
+//
+// Problem sizes are bucketed by their power of two, so a simulation whose
+// batch size drifts slightly between steps still hits a single cached
+// decision, while genuinely different shapes are tuned separately.
+struct LaunchTuner
+{
+  // Candidate launch parameters. Slot 0 keeps the Kokkos default; for a
+  // RangePolicy the remaining slots are chunk sizes (the thread-block size
+  // on GPU backends, the per-thread work quantum on host backends), for a
+  // TeamPolicy they are team sizes.
+  static constexpr int candidates[] = {0, 64, 128, 256, 512, 1024};
+  static constexpr int num_candidates = sizeof(candidates) / sizeof(int);
+
+  // Timed samples per candidate before the decision is locked in
+  static constexpr int sample_rounds = 2;
+
+  struct Entry
+  {
+    int num_samples = 0;
+    double time[num_candidates] = {};
+    // -1 while sampling, afterwards the index of the winning candidate
+    int decision = -1;
+  };
+
+  static bool enabled()
+  {
+    static bool const value = [] {
+      char const *env = std::getenv("ARBORX_TUNE_KERNEL_LAUNCH");
+      return env != nullptr && std::strcmp(env, "0") != 0;
+    }();
+    return value;
+  }
+
+  static std::string makeKey(char const *label, char const *backend,
+                             long long n)
+  {
+    int bucket = 0;
+    while (n >>= 1)
+      ++bucket;
+    return std::string(label) + '/' + backend + "/2^" + std::to_string(bucket);
+  }
+
+  // Runs launch(candidate_index) once, timing it while the entry is still
+  // sampling. Candidates at or past num_usable are excluded, which lets the
+  // caller clamp the sweep to what the kernel can actually launch with.
+  // While an entry is sampling, concurrent host threads serialize on the
+  // cache mutex so that their kernels do not overlap and pollute the
+  // timings; decided entries release the mutex before launching.
+  template <typename ExecutionSpace, typename Launch>
+  static void run(ExecutionSpace const &space, std::string const &key,
+                  int num_usable, Launch const &launch)
+  {
+    static std::unordered_map<std::string, Entry> cache;
+    static std::mutex mutex;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    auto &entry = cache[key];
+
+    if (entry.decision >= 0)
+    {
+      int const decision = entry.decision;
+      lock.unlock();
+      launch(decision);
+      return;
+    }
+
+    int const candidate = entry.num_samples % num_usable;
+    space.fence("ArborX::LaunchTuner::begin_sample");
+    Kokkos::Timer timer;
+    launch(candidate);
+    space.fence("ArborX::LaunchTuner::end_sample");
+    entry.time[candidate] += timer.seconds();
+
+    if (++entry.num_samples == num_usable * sample_rounds)
+    {
+      // Ties go to the Kokkos default
+      entry.decision = 0;
+      for (int c = 1; c < num_usable; ++c)
+        if (entry.time[c] < entry.time[entry.decision])
+          entry.decision = c;
+    }
+  }
+
+  // Drop-in replacement for Kokkos::parallel_for over a RangePolicy that
+  // sweeps the chunk size
+  template <typename Policy, typename Functor>
+  static void parallelFor(char const *label, Policy policy,
+                          Functor const &functor)
+  {
+    if (!enabled())
+    {
+      Kokkos::parallel_for(label, policy, functor);
+      return;
+    }
+
+    using ExecutionSpace = typename Policy::execution_space;
+    run(policy.space(),
+        makeKey(label, ExecutionSpace::name(), policy.end() - policy.begin()),
+        num_candidates, [&](int candidate) {
+          if (candidates[candidate] > 0)
+            policy.set_chunk_size(candidates[candidate]);
+          Kokkos::parallel_for(label, policy, functor);
+        });
+  }
+
+  // Counterpart for team launches whose correctness does not depend on the
+  // team size; sweeps the team size with the given per-team scratch
+  template <typename ExecutionSpace, typename Functor>
+  static void teamParallelFor(char const *label, ExecutionSpace const &space,
+                              int league_size, int scratch_size,
+                              Functor const &functor)
+  {
+    using TeamPolicy = Kokkos::TeamPolicy<ExecutionSpace>;
+    auto make_policy = [&space, league_size, scratch_size](int team_size) {
+      auto policy = (team_size > 0 ? TeamPolicy(space, league_size, team_size,
+                                                1)
+                                   : TeamPolicy(space, league_size,
+                                                Kokkos::AUTO, 1));
+      return policy.set_scratch_size(0, Kokkos::PerTeam(scratch_size));
+    };
+
+    if (!enabled())
+    {
+      Kokkos::parallel_for(label, make_policy(0), functor);
+      return;
+    }
+
+    int const max_team_size =
+        make_policy(0).team_size_max(functor, Kokkos::ParallelForTag{});
+    int num_usable = 1;
+    while (num_usable < num_candidates &&
+           candidates[num_usable] <= max_team_size)
+      ++num_usable;
+
+    run(space, makeKey(label, ExecutionSpace::name(), league_size), num_usable,
+        [&](int candidate) {
+          Kokkos::parallel_for(label, make_policy(candidates[candidate]),
+                               functor);
+        });
+  }
+};
+
+} // namespace ArborX::Details
+
+#endif
@@ -108,7 +108,8 @@ public:
 };
 
 template <class BVH, class Labels, class Weights, class Edges, class Metric,
-          class Radii, class LowerBounds, bool UseSharedRadii>
+          class Radii, class LowerBounds, class ActivePoints,
+          bool UseSharedRadii>
 struct FindComponentNearestNeighbors
 {
   BVH _bvh;
@@ -118,9 +119,13 @@ struct FindComponentNearestNeighbors
   Metric _metric;
   Radii _radii;
   LowerBounds _lower_bounds;
+  ActivePoints _active_points;
+  float _radius_scale;
 
   struct WithLowerBounds
   {};
+  struct WithActivePoints
+  {};
 
   template <class ExecutionSpace>
   FindComponentNearestNeighbors(ExecutionSpace const &space, BVH const &bvh,
@@ -128,6 +133,8 @@ struct FindComponentNearestNeighbors
                                 Edges const &edges, Metric const &metric,
                                 Radii const &radii,
                                 LowerBounds const &lower_bounds,
+                                ActivePoints const &active_points,
+                                int num_active, float epsilon,
                                 std::bool_constant<UseSharedRadii>)
       : _bvh(bvh)
       , _labels(labels)
@@ -136,14 +143,28 @@ struct FindComponentNearestNeighbors
       , _metric{metric}
       , _radii(radii)
       , _lower_bounds(lower_bounds)
+      , _active_points(active_points)
+      , _radius_scale(1 / (1 + epsilon))
   {
+    ARBORX_ASSERT(epsilon >= 0);
     int const n = bvh.size();
     ARBORX_ASSERT(labels.extent_int(0) == 2 * n - 1);
     ARBORX_ASSERT(edges.extent_int(0) == n);
     ARBORX_ASSERT(radii.extent_int(0) == n);
 
+    if (num_active < n)
+    {
+      // Only traverse from the points that may still improve their
+      // component's shortest outgoing edge
+      Kokkos::parallel_for(
+          "ArborX::MST::find_component_nearest_neighbors_active",
+          Kokkos::RangePolicy<ExecutionSpace, WithActivePoints>(space, 0,
+                                                                num_active),
+          *this);
+    }
+    else
 #ifdef KOKKOS_ENABLE_SERIAL
-    if (std::is_same<ExecutionSpace, Kokkos::Serial>{})
+        if (std::is_same<ExecutionSpace, Kokkos::Serial>{})
     {
       Kokkos::parallel_for(
           "ArborX::MST::find_component_nearest_neighbors_with_lower_bounds",
@@ -168,6 +189,11 @@ struct FindComponentNearestNeighbors
     }
   }
 
+  KOKKOS_FUNCTION void operator()(WithActivePoints, int k) const
+  {
+    this->operator()(_active_points(k));
+  }
+
   KOKKOS_FUNCTION void operator()(int i) const
   {
     constexpr auto inf = KokkosExt::ArithmeticTraits::infinity<float>::value;
@@ -229,7 +255,13 @@ struct FindComponentNearestNeighbors
       // points we take so that they don't create a cycle among component
       // connectivity. This requires us to uniquely resolve equidistant
       // neighbors, so we cannot skip any of them.
-      if (distance_node <= radius)
+      //
+      // The radius scale implements the well-separation pruning of the
+      // approximate mode: a subtree whose bounding volume is farther than
+      // radius / (1 + epsilon) cannot improve the current candidate by more
+      // than the accepted quality factor and is not descended into. In exact
+      // mode the scale is one and the comparisons are unchanged.
+      if (distance_node <= radius * _radius_scale)
       {
         // Insert children into the stack and make sure that the closest one
         // ends on top.
@@ -238,7 +270,7 @@ struct FindComponentNearestNeighbors
         distance_left = distance(left_child);
         distance_right = distance(right_child);
 
-        if (predicate(left_child) && distance_left <= radius)
+        if (predicate(left_child) && distance_left <= radius * _radius_scale)
         {
           if (HappyTreeFriends::isLeaf(_bvh, left_child))
           {
@@ -263,7 +295,7 @@ struct FindComponentNearestNeighbors
         }
 
         // Note: radius may have been already updated here from the left child
-        if (predicate(right_child) && distance_right <= radius)
+        if (predicate(right_child) && distance_right <= radius * _radius_scale)
         {
           if (HappyTreeFriends::isLeaf(_bvh, right_child))
           {
@@ -340,12 +372,12 @@ struct FindComponentNearestNeighbors
 // and w is not in C. The found edge is stored in component_out_edges(C).
 template <class ExecutionSpace, class BVH, class Labels, class Weights,
           class Edges, class Metric, class Radii, class LowerBounds,
-          bool UseSharedRadii>
+          class ActivePoints, bool UseSharedRadii>
 FindComponentNearestNeighbors(ExecutionSpace, BVH, Labels, Weights, Edges,
-                              Metric, Radii, LowerBounds,
-                              std::bool_constant<UseSharedRadii>)
+                              Metric, Radii, LowerBounds, ActivePoints, int,
+                              float, std::bool_constant<UseSharedRadii>)
     -> FindComponentNearestNeighbors<BVH, Labels, Weights, Edges, Metric, Radii,
-                                     LowerBounds, UseSharedRadii>;
+                                     LowerBounds, ActivePoints, UseSharedRadii>;
 
 template <class ExecutionSpace, class Labels, class ComponentOutEdges,
           class LowerBounds>
@@ -364,6 +396,38 @@ void updateLowerBounds(ExecutionSpace const &space, Labels const &labels,
       });
 }
 
+// Gather the points whose lower bound does not exceed the upper bound on
+// their component's shortest outgoing edge. The other points cannot provide
+// the shortest outgoing edge of their component this round, so traversals
+// starting from them may be skipped. The relative (Morton) order of the
+// surviving points is preserved.
+template <class ExecutionSpace, class Labels, class Radii, class LowerBounds,
+          class ActivePoints>
+int compactActivePoints(ExecutionSpace const &space, Labels const &labels,
+                        Radii const &radii, LowerBounds const &lower_bounds,
+                        ActivePoints const &active_points)
+{
+  Kokkos::Profiling::ScopedRegion guard("ArborX::MST::compact_active_points");
+
+  int const n = lower_bounds.extent(0);
+  int num_active;
+  Kokkos::parallel_scan(
+      "ArborX::MST::compact_active_points",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i, int &update, bool final_pass) {
+        // Note it is <= instead of < for the same equidistant neighbors
+        // resolution reason as in the traversal
+        if (lower_bounds(i) <= radii(labels(i)))
+        {
+          if (final_pass)
+            active_points(update) = i;
+          ++update;
+        }
+      },
+      num_active);
+  return num_active;
+}
+
 // workaround slow atomic min operations on edge type
 template <class ExecutionSpace, class Labels, class Weights, class Edges>
 void retrieveEdges(ExecutionSpace const &space, Labels const &labels,
@@ -416,6 +480,7 @@ struct UpdateComponentsAndEdges
   Edges _edges;
   EdgesMapping _edge_mapping;
   EdgesCount _num_edges;
+  bool _approximate = false;
 
   KOKKOS_FUNCTION auto computeNextComponent(int component) const
   {
@@ -432,8 +497,35 @@ struct UpdateComponentsAndEdges
     return KokkosExt::min(component, next_component);
   }
 
+  // When the shortest edges are found approximately, the out-edge graph may
+  // contain cycles longer than two: a component may skip its true shortest
+  // edge and point at a third component instead of reciprocating. Locate the
+  // unique cycle reachable from the component and return its minimum label,
+  // generalizing the resolution of a bidirectional edge.
+  KOKKOS_FUNCTION int computeCycleRepresentative(int component) const
+  {
+    auto const next = [this](int c) { return _labels(_out_edges(c).target()); };
+
+    // Floyd's cycle detection
+    int slow = component;
+    int fast = component;
+    do
+    {
+      slow = next(slow);
+      fast = next(next(fast));
+    } while (slow != fast);
+
+    int representative = slow;
+    for (int c = next(slow); c != slow; c = next(c))
+      representative = KokkosExt::min(representative, c);
+    return representative;
+  }
+
   KOKKOS_FUNCTION auto computeFinalComponent(int component) const
   {
+    if (_approximate)
+      return computeCycleRepresentative(component);
+
     int prev_component = component;
     int next_component;
     while ((next_component = computeNextComponent(prev_component)) !=
@@ -453,7 +545,14 @@ struct UpdateComponentsAndEdges
   KOKKOS_FUNCTION void operator()(UnidirectionalEdgesTag, int i) const
   {
     auto const component = _labels(i);
-    if (i != component || computeNextComponent(component) == component)
+    if (i != component)
+      return;
+    // The merged component's representative is the only member that does not
+    // contribute its outgoing edge
+    bool const is_representative =
+        _approximate ? computeCycleRepresentative(component) == component
+                     : computeNextComponent(component) == component;
+    if (is_representative)
       return;
 
     // append new edge at the "end" of the array (akin to
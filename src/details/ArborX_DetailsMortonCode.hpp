@@ -13,10 +13,13 @@
 #define ARBORX_DETAILS_MORTON_CODE_UTILS_HPP
 
 #include <ArborX_DetailsKokkosExtMinMaxOperations.hpp> // min. max
+#include <ArborX_DetailsKokkosExtRadixSort.hpp> // is_radix_sortable
 #include <ArborX_GeometryTraits.hpp>
 
 #include <Kokkos_Core.hpp> // abort
 
+#include <type_traits>
+
 namespace ArborX
 {
 
@@ -282,24 +285,61 @@ KOKKOS_INLINE_FUNCTION unsigned long long expandBitsBy<9>(unsigned long long x)
   return x;
 }
 
+// Interleave the low bits[d] bits of x[d], one level at a time starting from
+// the most significant, with dimension 0 contributing the highest bit of each
+// level. The bit counts may differ by one, allowing the leading dimensions to
+// absorb the bits a uniform stride would leave unused when the code width is
+// not a multiple of the dimension. With uniform counts this reproduces the
+// expandBitsBy-based interleaving, only slower, which is why it is reserved
+// for the higher dimensions; it only runs at tree construction time.
+template <int DIM, typename Integer>
+KOKKOS_INLINE_FUNCTION Integer interleaveBits(Integer const (&x)[DIM],
+                                              int const (&bits)[DIM])
+{
+  Integer r = 0;
+  for (int l = bits[0] - 1; l >= 0; --l)
+    for (int d = 0; d < DIM; ++d)
+      if (l < bits[d])
+        r = (r << 1) | ((x[d] >> l) & (Integer)1);
+  return r;
+}
+
 template <typename Point,
           typename Enable = std::enable_if_t<GeometryTraits::is_point_v<Point>>>
 KOKKOS_INLINE_FUNCTION unsigned int morton32(Point const &p)
 {
   constexpr int DIM = GeometryTraits::dimension_v<Point>;
-  constexpr unsigned N = 1u << (DIM == 1 ? 31 : 32 / DIM);
 
   using KokkosExt::max;
   using KokkosExt::min;
 
-  unsigned int r = 0;
-  for (int d = 0; d < DIM; ++d)
+  if constexpr (DIM >= 4)
   {
-    auto x = min(max((float)p[d] * N, 0.f), (float)N - 1);
-    r += (expandBitsBy<DIM - 1>((unsigned int)x) << (DIM - d - 1));
+    // Balanced interleaving using the full code width; the low dimensions
+    // keep the magic-number fast path below
+    unsigned int scaled[DIM];
+    int bits[DIM];
+    for (int d = 0; d < DIM; ++d)
+    {
+      bits[d] = 32 / DIM + (d < 32 % DIM);
+      auto const n = 1u << bits[d];
+      scaled[d] = (unsigned int)min(max((float)p[d] * n, 0.f), (float)n - 1);
+    }
+    return interleaveBits(scaled, bits);
   }
+  else
+  {
+    constexpr unsigned N = 1u << (DIM == 1 ? 31 : 32 / DIM);
 
-  return r;
+    unsigned int r = 0;
+    for (int d = 0; d < DIM; ++d)
+    {
+      auto x = min(max((float)p[d] * N, 0.f), (float)N - 1);
+      r += (expandBitsBy<DIM - 1>((unsigned int)x) << (DIM - d - 1));
+    }
+
+    return r;
+  }
 }
 
 template <typename Point,
@@ -308,21 +348,216 @@ template <typename Point,
 KOKKOS_INLINE_FUNCTION unsigned long long morton64(Point const &p)
 {
   constexpr int DIM = GeometryTraits::dimension_v<Point>;
-  constexpr unsigned long long N = (1llu << (63 / DIM));
 
   using KokkosExt::max;
   using KokkosExt::min;
 
-  unsigned long long r = 0;
-  for (int d = 0; d < DIM; ++d)
+  if constexpr (DIM >= 4)
   {
-    auto x = min(max((float)p[d] * N, 0.f), (float)N - 1);
-    r += (expandBitsBy<DIM - 1>((unsigned long long)x) << (DIM - d - 1));
+    // Balanced interleaving using the full 63-bit code width; the low
+    // dimensions keep the magic-number fast path below
+    unsigned long long scaled[DIM];
+    int bits[DIM];
+    for (int d = 0; d < DIM; ++d)
+    {
+      bits[d] = 63 / DIM + (d < 63 % DIM);
+      auto const n = 1llu << bits[d];
+      scaled[d] =
+          (unsigned long long)min(max((float)p[d] * n, 0.f), (float)n - 1);
+    }
+    return interleaveBits(scaled, bits);
   }
+  else
+  {
+    constexpr unsigned long long N = (1llu << (63 / DIM));
 
-  return r;
+    unsigned long long r = 0;
+    for (int d = 0; d < DIM; ++d)
+    {
+      auto x = min(max((float)p[d] * N, 0.f), (float)N - 1);
+      r += (expandBitsBy<DIM - 1>((unsigned long long)x) << (DIM - d - 1));
+    }
+
+    return r;
+  }
 }
 
+// 128-bit code word for the extended-precision Morton order computed by
+// morton128() below. Only the low 126 bits carry the code, mirroring the
+// 63-bit convention of morton64(): with the top bits clear, the XOR-based
+// distance metric in tree construction (see GenerateHierarchy::delta())
+// stays positive under a signed reading of the high word, and the type can
+// serve as its own signed counterpart there. Comparisons therefore order
+// the high word as signed, which coincides with the unsigned order for any
+// valid code. The operator set is what the consumers need: byte extraction
+// for the radix sort, comparisons for the vendor sort paths, and the
+// arithmetic of the delta metric.
+struct MortonCode128
+{
+  unsigned long long hi = 0;
+  unsigned long long lo = 0;
+
+  MortonCode128() = default;
+  KOKKOS_FUNCTION constexpr MortonCode128(unsigned long long value)
+      : hi(0)
+      , lo(value)
+  {}
+  KOKKOS_FUNCTION constexpr MortonCode128(unsigned long long hi_,
+                                          unsigned long long lo_)
+      : hi(hi_)
+      , lo(lo_)
+  {}
+
+  KOKKOS_FUNCTION explicit constexpr operator unsigned long long() const
+  {
+    return lo;
+  }
+  // The radix sort casts extracted digits straight to int
+  KOKKOS_FUNCTION explicit constexpr operator int() const { return (int)lo; }
+  KOKKOS_FUNCTION explicit constexpr operator bool() const
+  {
+    return hi != 0 || lo != 0;
+  }
+
+  KOKKOS_FUNCTION constexpr MortonCode128 &
+  operator&=(MortonCode128 const &other)
+  {
+    hi &= other.hi;
+    lo &= other.lo;
+    return *this;
+  }
+  KOKKOS_FUNCTION constexpr MortonCode128 &
+  operator|=(MortonCode128 const &other)
+  {
+    hi |= other.hi;
+    lo |= other.lo;
+    return *this;
+  }
+
+  friend KOKKOS_FUNCTION constexpr bool operator==(MortonCode128 const &a,
+                                                   MortonCode128 const &b)
+  {
+    return a.hi == b.hi && a.lo == b.lo;
+  }
+  friend KOKKOS_FUNCTION constexpr bool operator!=(MortonCode128 const &a,
+                                                   MortonCode128 const &b)
+  {
+    return !(a == b);
+  }
+  friend KOKKOS_FUNCTION constexpr bool operator<(MortonCode128 const &a,
+                                                  MortonCode128 const &b)
+  {
+    return a.hi != b.hi ? (long long)a.hi < (long long)b.hi : a.lo < b.lo;
+  }
+  friend KOKKOS_FUNCTION constexpr bool operator>(MortonCode128 const &a,
+                                                  MortonCode128 const &b)
+  {
+    return b < a;
+  }
+  friend KOKKOS_FUNCTION constexpr bool operator<=(MortonCode128 const &a,
+                                                   MortonCode128 const &b)
+  {
+    return !(b < a);
+  }
+  friend KOKKOS_FUNCTION constexpr bool operator>=(MortonCode128 const &a,
+                                                   MortonCode128 const &b)
+  {
+    return !(a < b);
+  }
+
+  friend KOKKOS_FUNCTION constexpr MortonCode128
+  operator^(MortonCode128 const &a, MortonCode128 const &b)
+  {
+    return {a.hi ^ b.hi, a.lo ^ b.lo};
+  }
+  friend KOKKOS_FUNCTION constexpr MortonCode128
+  operator&(MortonCode128 const &a, MortonCode128 const &b)
+  {
+    return {a.hi & b.hi, a.lo & b.lo};
+  }
+  friend KOKKOS_FUNCTION constexpr MortonCode128
+  operator|(MortonCode128 const &a, MortonCode128 const &b)
+  {
+    return {a.hi | b.hi, a.lo | b.lo};
+  }
+
+  friend KOKKOS_FUNCTION constexpr MortonCode128
+  operator<<(MortonCode128 const &a, int s)
+  {
+    if (s == 0)
+      return a;
+    if (s >= 64)
+      return {a.lo << (s - 64), 0};
+    return {(a.hi << s) | (a.lo >> (64 - s)), a.lo << s};
+  }
+  friend KOKKOS_FUNCTION constexpr MortonCode128
+  operator>>(MortonCode128 const &a, int s)
+  {
+    if (s == 0)
+      return a;
+    if (s >= 64)
+      return {0, a.hi >> (s - 64)};
+    return {a.hi >> s, (a.lo >> s) | (a.hi << (64 - s))};
+  }
+
+  friend KOKKOS_FUNCTION constexpr MortonCode128
+  operator+(MortonCode128 const &a, MortonCode128 const &b)
+  {
+    unsigned long long const lo = a.lo + b.lo;
+    return {a.hi + b.hi + (lo < a.lo), lo};
+  }
+  friend KOKKOS_FUNCTION constexpr MortonCode128
+  operator-(MortonCode128 const &a, MortonCode128 const &b)
+  {
+    return {a.hi - b.hi - (a.lo < b.lo), a.lo - b.lo};
+  }
+  // Product truncated to 128 bits; the 64x64 low-word product is assembled
+  // from 32-bit halves to stay portable
+  friend KOKKOS_FUNCTION constexpr MortonCode128
+  operator*(MortonCode128 const &a, MortonCode128 const &b)
+  {
+    unsigned long long const a0 = a.lo & 0xffffffffllu;
+    unsigned long long const a1 = a.lo >> 32;
+    unsigned long long const b0 = b.lo & 0xffffffffllu;
+    unsigned long long const b1 = b.lo >> 32;
+
+    unsigned long long const ll = a0 * b0;
+    unsigned long long const lh = a0 * b1;
+    unsigned long long const hl = a1 * b0;
+
+    unsigned long long const mid =
+        (ll >> 32) + (lh & 0xffffffffllu) + (hl & 0xffffffffllu);
+    unsigned long long const carry = (mid >> 32) + (lh >> 32) + (hl >> 32);
+    return {a.hi * b.lo + a.lo * b.hi + a1 * b1 + carry,
+            (ll & 0xffffffffllu) | (mid << 32)};
+  }
+};
+
+// Signed counterpart of a linear ordering value type for the distance metric
+// in tree construction (see GenerateHierarchy::delta()). The built-in code
+// types map to the standard signed integer of the same width; MortonCode128
+// compares through its signed high word and is its own counterpart.
+template <typename Code>
+struct SignedCodeType
+{
+  using type = std::make_signed_t<Code>;
+};
+
+template <>
+struct SignedCodeType<MortonCode128>
+{
+  using type = MortonCode128;
+};
+
+namespace KokkosExt
+{
+// MortonCode128 provides the shift, mask, and conversion operators the byte
+// extraction of the radix passes uses
+template <>
+struct is_radix_sortable<MortonCode128> : std::true_type
+{};
+} // namespace KokkosExt
+
 // Calculate a 62-bit Morton code for a 2D point located within [0, 1]^2.
 // Special case because it needs double.
 template <typename Point,
@@ -346,8 +581,75 @@ KOKKOS_INLINE_FUNCTION unsigned long long morton64(Point const &p)
          expandBitsBy<1>((unsigned long long)yd);
 }
 
+// Calculate a 126-bit Morton code for a point located within [0, 1]^d.
+// Coordinates are scaled in double precision: for data spanning many orders
+// of magnitude, the 21 bits per dimension of the 3D morton64() collapse
+// large numbers of distinct points onto identical codes, and construction
+// degenerates to the duplicate-key handling in GenerateHierarchy::delta().
+// The 42 bits per dimension available here push that collapse out by another
+// factor of two million per dimension. There are no magic constants for
+// expanding bits across two words, so the code always goes through the
+// slower generic interleaving (see interleaveBits()); it only runs at tree
+// construction time.
+template <typename Point,
+          typename Enable = std::enable_if_t<GeometryTraits::is_point_v<Point>>>
+KOKKOS_INLINE_FUNCTION MortonCode128 morton128(Point const &p)
+{
+  constexpr int DIM = GeometryTraits::dimension_v<Point>;
+
+  using KokkosExt::max;
+  using KokkosExt::min;
+
+  // A double carries 53 significant bits, so a single dimension cannot
+  // discriminate more than that; cap the per-dimension width accordingly
+  // instead of widening the stride
+  unsigned long long scaled[DIM];
+  int bits[DIM];
+  for (int d = 0; d < DIM; ++d)
+  {
+    bits[d] = min(126 / DIM + (d < 126 % DIM), 53);
+    auto const n = 1llu << bits[d];
+    scaled[d] =
+        (unsigned long long)min(max((double)p[d] * n, 0.), (double)n - 1);
+  }
+
+  MortonCode128 r;
+  for (int l = bits[0] - 1; l >= 0; --l)
+    for (int d = 0; d < DIM; ++d)
+      if (l < bits[d])
+        r = (r << 1) | MortonCode128((scaled[d] >> l) & 1llu);
+  return r;
+}
+
 } // namespace Details
 
 } // namespace ArborX
 
+// The duplicate-key handling in tree construction anchors the delta metric at
+// the most negative value; the radix sort folds its key-bit reductions with
+// the bitwise identities
+template <>
+struct Kokkos::Experimental::finite_max<ArborX::Details::MortonCode128>
+{
+  static constexpr ArborX::Details::MortonCode128 value{0x7fffffffffffffffllu,
+                                                        0xffffffffffffffffllu};
+};
+
+template <>
+struct Kokkos::Experimental::finite_min<ArborX::Details::MortonCode128>
+{
+  static constexpr ArborX::Details::MortonCode128 value{0x8000000000000000llu,
+                                                        0};
+};
+
+template <>
+struct Kokkos::reduction_identity<ArborX::Details::MortonCode128>
+{
+  KOKKOS_FUNCTION static ArborX::Details::MortonCode128 band()
+  {
+    return {0xffffffffffffffffllu, 0xffffffffffffffffllu};
+  }
+  KOKKOS_FUNCTION static ArborX::Details::MortonCode128 bor() { return {}; }
+};
+
 #endif
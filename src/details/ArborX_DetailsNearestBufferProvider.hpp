@@ -16,9 +16,72 @@
 
 #include <Kokkos_Core.hpp>
 
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 namespace ArborX::Details
 {
 
+namespace Impl
+{
+
+template <typename MemorySpace>
+struct NearestBufferPoolState
+{
+  using PairIndexDistance = Kokkos::pair<int, float>;
+
+  // One cached allocation per power-of-two size class. Rounding the
+  // requested size up to a class lets batches of slightly varying shape
+  // share an allocation instead of reallocating every call.
+  std::unordered_map<unsigned long long,
+                     Kokkos::View<PairIndexDistance *, MemorySpace>>
+      _buffers;
+  std::unordered_map<unsigned long long, Kokkos::View<int *, MemorySpace>>
+      _offsets;
+};
+
+// One pool per execution space instance: a pooled allocation is only reused
+// by later kernels submitted to the same instance, making the recycling
+// stream-ordered and thus safe without extra fences.
+template <typename MemorySpace>
+std::shared_ptr<NearestBufferPoolState<MemorySpace>>
+nearestBufferPoolState(uint64_t instance_id)
+{
+  static std::mutex mutex;
+  static std::unordered_map<
+      uint64_t, std::shared_ptr<NearestBufferPoolState<MemorySpace>>>
+      pools;
+
+  std::lock_guard<std::mutex> guard(mutex);
+  if (pools.empty())
+    Kokkos::push_finalize_hook([]() {
+      std::lock_guard<std::mutex> guard(mutex);
+      pools.clear();
+    });
+  auto &state = pools[instance_id];
+  if (!state)
+    state = std::make_shared<NearestBufferPoolState<MemorySpace>>();
+  return state;
+}
+
+template <typename View>
+View acquirePooledView(std::unordered_map<unsigned long long, View> &pool,
+                       std::size_t n, char const *label)
+{
+  unsigned long long size_class = 1;
+  while (size_class < n)
+    size_class *= 2;
+  auto &cached = pool[size_class];
+  if (cached.size() < size_class)
+    cached = View(Kokkos::view_alloc(Kokkos::WithoutInitializing, label),
+                  size_class);
+  return cached;
+}
+
+} // namespace Impl
+
 template <typename MemorySpace>
 struct NearestBufferProvider
 {
@@ -28,6 +91,9 @@ struct NearestBufferProvider
 
   Kokkos::View<PairIndexDistance *, MemorySpace> _buffer;
   Kokkos::View<int *, MemorySpace> _offset;
+  // Heap size shared by all predicates, or 0 when the sizes differ and the
+  // offsets are explicit
+  int _stride = 0;
 
   NearestBufferProvider() = default;
 
@@ -42,6 +108,9 @@ struct NearestBufferProvider
 
   KOKKOS_FUNCTION auto operator()(int i) const
   {
+    if (_stride > 0)
+      return Kokkos::subview(_buffer,
+                             Kokkos::make_pair(i * _stride, (i + 1) * _stride));
     return Kokkos::subview(_buffer,
                            Kokkos::make_pair(_offset(i), _offset(i + 1)));
   }
@@ -55,21 +124,59 @@ private:
   void allocateBuffer(ExecutionSpace const &space, Predicates const &predicates)
   {
     auto const n_queries = predicates.size();
+    if (n_queries == 0)
+      return;
 
-    KokkosExt::reallocWithoutInitializing(space, _offset, n_queries + 1);
+    // It is not possible to anticipate how much memory to allocate since the
+    // number of nearest neighbors k is only known at runtime. Draw the
+    // buffer from a pool surviving across queries so that batches of
+    // constant shape do not pay for a device allocation on every call.
+    auto pool =
+        Impl::nearestBufferPoolState<MemorySpace>(space.impl_instance_id());
+
+    Kokkos::MinMaxScalar<int> k_range;
+    Kokkos::parallel_reduce(
+        "ArborX::NearestBufferProvider::scan_queries_for_numbers_of_neighbors",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+        KOKKOS_LAMBDA(int i, Kokkos::MinMaxScalar<int> &update) {
+          int const k = getK(predicates(i));
+          if (k < update.min_val)
+            update.min_val = k;
+          if (k > update.max_val)
+            update.max_val = k;
+        },
+        Kokkos::MinMax<int>(k_range));
+
+    if (k_range.min_val == k_range.max_val)
+    {
+      // Uniform k: the offsets are implicit, skip the prefix sum and the
+      // offset storage altogether
+      _stride = k_range.max_val;
+      auto const buffer_size = n_queries * static_cast<std::size_t>(_stride);
+      _buffer = Kokkos::subview(
+          Impl::acquirePooledView(pool->_buffers, buffer_size,
+                                  "ArborX::NearestBufferProvider::buffer"),
+          Kokkos::make_pair(std::size_t(0), buffer_size));
+      return;
+    }
+
+    _offset = Kokkos::subview(
+        Impl::acquirePooledView(pool->_offsets, n_queries + 1,
+                                "ArborX::NearestBufferProvider::offset"),
+        Kokkos::make_pair(std::size_t(0),
+                          static_cast<std::size_t>(n_queries) + 1));
 
     Kokkos::parallel_for(
         "ArborX::NearestBufferProvider::scan_queries_for_numbers_of_neighbors",
         Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
         KOKKOS_CLASS_LAMBDA(int i) { _offset(i) = getK(predicates(i)); });
     KokkosExt::exclusive_scan(space, _offset, _offset, 0);
-    int const buffer_size = KokkosExt::lastElement(space, _offset);
-    // Allocate buffer over which to perform heap operations in the nearest
-    // query to store nearest nodes found so far.
-    // It is not possible to anticipate how much memory to allocate since the
-    // number of nearest neighbors k is only known at runtime.
+    std::size_t const buffer_size = KokkosExt::lastElement(space, _offset);
 
-    KokkosExt::reallocWithoutInitializing(space, _buffer, buffer_size);
+    _buffer = Kokkos::subview(
+        Impl::acquirePooledView(pool->_buffers, buffer_size,
+                                "ArborX::NearestBufferProvider::buffer"),
+        Kokkos::make_pair(std::size_t(0), buffer_size));
   }
 };
 
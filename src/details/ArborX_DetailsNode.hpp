@@ -13,6 +13,7 @@
 #define ARBORX_NODE_HPP
 
 #include <ArborX_Box.hpp>
+#include <ArborX_HyperBox.hpp>
 
 #include <Kokkos_Macros.hpp>
 
@@ -23,26 +24,50 @@ namespace ArborX::Details
 
 constexpr int ROPE_SENTINEL = -1;
 
-template <class Value>
+// Leaf and internal nodes live in two separate dense arrays. Keeping the
+// user value out of InternalNode is what makes the internal array hot-loop
+// friendly: its stride is bounds + connectivity only and does not grow with
+// sizeof(Value), so large payloads never dilute the cache lines the
+// traversal spends most of its time in. The leaf rope is deliberately kept
+// next to the payload: a visited leaf always reads both, so splitting them
+// into two arrays would trade one access for two.
+//
+// The index type parametrizes the node and rope indices. The default caps a
+// tree at 2^31-1 values; a 64-bit type lifts the cap at the cost of wider
+// nodes.
+template <class Value, class Index = int>
 struct LeafNode
 {
   using value_type = Value;
+  using index_type = Index;
 
-  int rope = ROPE_SENTINEL;
+  Index rope = ROPE_SENTINEL;
   Value value;
 };
 
-template <class BoundingVolume>
+template <class BoundingVolume, class Index = int>
 struct InternalNode
 {
   using bounding_volume_type = BoundingVolume;
+  using index_type = Index;
 
   // Right child is the rope of the left child
-  int left_child = -1;
-  int rope = ROPE_SENTINEL;
+  Index left_child = -1;
+  Index rope = ROPE_SENTINEL;
   BoundingVolume bounding_volume;
 };
 
+// The bounding volume template parameter specializes the node storage per
+// dimension at compile time, so lower-dimensional trees fetch fewer bytes per
+// traversal step: a single-precision 2D internal node is 24 bytes against 32
+// for its 3D counterpart, and a pair of 2D nodes shares one 64-byte cache
+// line with room to spare. Pin the packed layouts so that padding does not
+// creep back in.
+static_assert(sizeof(InternalNode<ExperimentalHyperGeometry::Box<2>>) ==
+              2 * sizeof(int) + 4 * sizeof(float));
+static_assert(sizeof(InternalNode<ExperimentalHyperGeometry::Box<3>>) ==
+              2 * sizeof(int) + 6 * sizeof(float));
+
 template <class Value>
 KOKKOS_INLINE_FUNCTION constexpr LeafNode<Value>
 makeLeafNode(Value value) noexcept
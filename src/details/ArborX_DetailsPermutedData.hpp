@@ -61,6 +61,64 @@ public:
   using self_type = PermutedData<Data, Permute, AttachIndices>;
 };
 
+// Restriction of the data to a subset of its indices. In contrast to
+// PermutedData with attached indices, the attached index is the position in
+// the full data, not in the subset, so that data indexed by the original
+// positions (counts, offsets) keeps lining up.
+template <typename Data, typename Indices>
+struct SubsetData
+{
+  using memory_space = typename Data::memory_space;
+  using value_type =
+      std::decay_t<decltype(attach(std::declval<Data const &>()(0), 0))>;
+
+  Data _data;
+  Indices _indices;
+
+  KOKKOS_FUNCTION decltype(auto) operator()(int i) const
+  {
+    auto const j = _indices(i);
+    return attach(_data(j), (int)j);
+  }
+  KOKKOS_FUNCTION auto size() const { return _indices.size(); }
+};
+
+template <typename Data, typename Indices, typename Tag>
+class AccessValuesI<SubsetData<Data, Indices>, Tag>
+    : public SubsetData<Data, Indices>
+{
+public:
+  using self_type = SubsetData<Data, Indices>;
+};
+
+// Contiguous slice [first, first + size) of the data. Unlike SubsetData, the
+// attached index is the position within the slice, so that per-slice counts
+// and offsets can start at zero.
+template <typename Data>
+struct RangeSubsetData
+{
+  using memory_space = typename Data::memory_space;
+  using value_type =
+      std::decay_t<decltype(attach(std::declval<Data const &>()(0), 0))>;
+
+  Data _data;
+  int _first;
+  int _size;
+
+  KOKKOS_FUNCTION decltype(auto) operator()(int i) const
+  {
+    return attach(_data(_first + i), i);
+  }
+  KOKKOS_FUNCTION auto size() const { return _size; }
+};
+
+template <typename Data, typename Tag>
+class AccessValuesI<RangeSubsetData<Data>, Tag> : public RangeSubsetData<Data>
+{
+public:
+  using self_type = RangeSubsetData<Data>;
+};
+
 } // namespace Details
 
 template <typename Predicates, typename Permute, bool AttachIndices>
@@ -85,6 +143,46 @@ struct AccessTraits<Details::PermutedData<Predicates, Permute, AttachIndices>,
   }
 };
 
+template <typename Predicates>
+struct AccessTraits<Details::RangeSubsetData<Predicates>, PredicatesTag>
+{
+  using RangePredicates = Details::RangeSubsetData<Predicates>;
+
+  using memory_space = typename Predicates::memory_space;
+
+  KOKKOS_FUNCTION static std::size_t
+  size(RangePredicates const &range_predicates)
+  {
+    return range_predicates.size();
+  }
+
+  KOKKOS_FUNCTION static decltype(auto)
+  get(RangePredicates const &range_predicates, std::size_t index)
+  {
+    return range_predicates(index);
+  }
+};
+
+template <typename Predicates, typename Indices>
+struct AccessTraits<Details::SubsetData<Predicates, Indices>, PredicatesTag>
+{
+  using SubsetPredicates = Details::SubsetData<Predicates, Indices>;
+
+  using memory_space = typename Predicates::memory_space;
+
+  KOKKOS_FUNCTION static std::size_t
+  size(SubsetPredicates const &subset_predicates)
+  {
+    return subset_predicates.size();
+  }
+
+  KOKKOS_FUNCTION static decltype(auto)
+  get(SubsetPredicates const &subset_predicates, std::size_t index)
+  {
+    return subset_predicates(index);
+  }
+};
+
 } // namespace ArborX
 
 #endif
@@ -14,7 +14,8 @@
 
 #include <ArborX_DetailsKokkosExtSort.hpp>
 #include <ArborX_DetailsKokkosExtStdAlgorithms.hpp> // iota
-#include <ArborX_DetailsKokkosExtViewHelpers.hpp>   // clone
+#include <ArborX_DetailsKokkosExtSwap.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp> // clone
 #include <ArborX_Exception.hpp>
 
 #include <Kokkos_Core.hpp>
@@ -42,6 +43,131 @@ auto sortObjects(ExecutionSpace const &space, ViewType &view)
   return permute;
 }
 
+// Variant of sortObjects() that carries a values view along with the keys
+// instead of returning the permutation. The values move during the sort's
+// own scatter phases, which replaces the sort-then-gather idiom
+//   auto permute = sortObjects(space, keys);
+//   applyPermutation(space, permute, values);
+// whose gather is a full extra random-access pass over the values. Only
+// callers that do not need the permutation afterwards qualify.
+template <typename ExecutionSpace, typename KeysType, typename ValuesType>
+void sortObjects(ExecutionSpace const &space, KeysType &keys,
+                 ValuesType &values)
+{
+  Kokkos::Profiling::pushRegion("ArborX::Sorting(fused)");
+
+  ARBORX_ASSERT(values.extent(0) == keys.extent(0));
+
+  KokkosExt::sortByKey(space, keys, values);
+
+  Kokkos::Profiling::popRegion();
+}
+
+template <typename ExecutionSpace, typename ViewType>
+int countSortingDescents(ExecutionSpace const &space, ViewType const &view)
+{
+  int const n = view.extent(0);
+  int num_descents;
+  Kokkos::parallel_reduce(
+      "ArborX::Sorting::count_descents",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n > 0 ? n - 1 : 0),
+      KOKKOS_LAMBDA(int i, int &update) {
+        if (view(i + 1) < view(i))
+          ++update;
+      },
+      num_descents);
+  return num_descents;
+}
+
+// Variant of sortObjects() for input that is expected to already be sorted or
+// close to it, e.g., space-filling curve codes recomputed on data that was
+// ordered by a previous build. A single reduction counts the adjacent
+// inversions: sorted input skips the sort altogether, input with few
+// inversions is repaired in place with odd-even transposition passes that
+// only pay for the actual displacement, and anything else falls through to
+// the full sort.
+template <typename ExecutionSpace, typename ViewType,
+          class SizeType = unsigned int>
+auto sortObjectsAdaptive(ExecutionSpace const &space, ViewType &view)
+{
+  Kokkos::Profiling::pushRegion("ArborX::Sorting(adaptive)");
+
+  int const n = view.extent(0);
+
+  Kokkos::View<SizeType *, typename ViewType::device_type> permute(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::Sorting::permute"),
+      n);
+  KokkosExt::iota(space, permute);
+
+  int const num_descents = countSortingDescents(space, view);
+  if (num_descents == 0)
+  {
+    Kokkos::Profiling::popRegion();
+    return permute;
+  }
+
+  // Each repair pass is two sweeps over the data, so only a handful of them
+  // beat the full sort. Many descents mean the order is not nearly-sorted
+  // and the repair would not converge in time. Note that sortByKey() does
+  // not require the permutation to be the identity, so the swaps already
+  // performed by an unsuccessful repair are folded in for free.
+  if (num_descents <= n / 64)
+  {
+    // All passes are enqueued up front and run without host round trips:
+    // each pass pair counts its swaps on the device, and a swap-free pair
+    // (which for odd-even transposition means the data is sorted) raises a
+    // completion flag that short-circuits the remaining passes. Only the
+    // final repaired-or-not decision reads back to the host.
+    Kokkos::View<int, typename ViewType::device_type> done(
+        Kokkos::view_alloc(space, "ArborX::Sorting::repair_done"));
+    Kokkos::View<int, typename ViewType::device_type> num_swaps(
+        Kokkos::view_alloc(space, "ArborX::Sorting::repair_num_swaps"));
+    constexpr int max_pass_pairs = 16;
+    for (int pass_pair = 0; pass_pair < max_pass_pairs; ++pass_pair)
+    {
+      for (int parity : {0, 1})
+        Kokkos::parallel_for(
+            "ArborX::Sorting::transposition_pass",
+            Kokkos::RangePolicy<ExecutionSpace>(space, 0, n / 2),
+            KOKKOS_LAMBDA(int k) {
+              if (done())
+                return;
+              int const i = 2 * k + parity;
+              if (i + 1 < n && view(i + 1) < view(i))
+              {
+                KokkosExt::swap(view(i), view(i + 1));
+                KokkosExt::swap(permute(i), permute(i + 1));
+                Kokkos::atomic_inc(&num_swaps());
+              }
+            });
+
+      Kokkos::parallel_for(
+          "ArborX::Sorting::check_repair_converged",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, 1),
+          KOKKOS_LAMBDA(int) {
+            if (num_swaps() == 0)
+              done() = 1;
+            num_swaps() = 0;
+          });
+    }
+
+    auto done_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, done);
+    if (done_host() != 0)
+    {
+      Kokkos::Profiling::popRegion();
+      return permute;
+    }
+  }
+
+  KokkosExt::sortByKey(space, view, permute);
+
+  Kokkos::Profiling::popRegion();
+
+  return permute;
+}
+
 // Helper functions and structs for applyPermutations
 namespace PermuteHelper
 {
@@ -0,0 +1,518 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILS_SUBTREE_REBUILD_HPP
+#define ARBORX_DETAILS_SUBTREE_REBUILD_HPP
+
+#include <ArborX_DetailsAlgorithms.hpp> // expand, intersects
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_DetailsNode.hpp> // makeLeafNode
+#include <ArborX_DetailsSortUtils.hpp>
+#include <ArborX_DetailsTreeConstruction.hpp>
+#include <ArborX_GeometryTraits.hpp>
+#include <ArborX_HyperBox.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Details::TreeConstruction
+{
+
+// Indexables accessor over a gathered set of leaf slots of an existing tree,
+// presenting it to the scene bounds and space-filling curve kernels as if it
+// were the input range of a fresh build
+template <typename LeafNodes, typename LeafSlots, typename IndexableGetter>
+struct SubtreeLeafIndexables
+{
+  LeafNodes _leaf_nodes;
+  LeafSlots _leaf_slots;
+  IndexableGetter _indexable_getter;
+
+  using memory_space = typename LeafNodes::memory_space;
+
+  KOKKOS_FUNCTION decltype(auto) operator()(int i) const
+  {
+    return _indexable_getter(_leaf_nodes(_leaf_slots(i)).value);
+  }
+
+  KOKKOS_FUNCTION int size() const { return _leaf_slots.extent_int(0); }
+};
+
+// Variant of GenerateHierarchy that regenerates the hierarchy of a single
+// subtree of an existing tree in place, leaving every node outside the
+// subtree untouched. The construction runs over local leaf positions
+// [0, m): the delta() walls at the local bounds confine it to the subtree
+// and terminate the bottom-up walk at the subtree root instead of the tree
+// root. The local Karras indices only serve as logical node names: every
+// leaf and internal node access goes through the slot arrays holding the
+// slots the old subtree occupied (graft() and the treelet restructuring do
+// not keep subtrees in the slot layout the original build produces, so the
+// slots cannot be computed, only gathered), with the old subtree root's
+// slot in position zero so that the parent and the external ropes pointing
+// at the subtree stay valid. Ropes walking off the last local leaf take
+// the preserved rope of the old subtree root: every node on the rightmost
+// path of the subtree escapes it to the same place the subtree root does.
+template <typename ScratchLeafNodes, typename IndexableGetter,
+          typename PermutationIndices, typename LinearOrdering,
+          typename LeafNodes, typename InternalNodes, typename Slots>
+class GenerateSubtreeHierarchy
+{
+  static constexpr int UNTOUCHED_NODE = -1;
+
+  using MemorySpace = typename LeafNodes::memory_space;
+  using LinearOrderingValueType = typename LinearOrdering::non_const_value_type;
+  using BoundingVolume =
+      typename InternalNodes::value_type::bounding_volume_type;
+
+public:
+  template <typename ExecutionSpace>
+  GenerateSubtreeHierarchy(ExecutionSpace const &space,
+                           ScratchLeafNodes const &scratch_leaf_nodes,
+                           IndexableGetter const &indexable_getter,
+                           PermutationIndices const &permutation_indices,
+                           LinearOrdering const &sorted_morton_codes,
+                           LeafNodes leaf_nodes, InternalNodes internal_nodes,
+                           Slots const &leaf_slots,
+                           Slots const &internal_slots, int external_rope)
+      : _scratch_leaf_nodes(scratch_leaf_nodes)
+      , _indexable_getter(indexable_getter)
+      , _permutation_indices(permutation_indices)
+      , _sorted_morton_codes(sorted_morton_codes)
+      , _leaf_nodes(leaf_nodes)
+      , _internal_nodes(internal_nodes)
+      , _leaf_slots(leaf_slots)
+      , _internal_slots(internal_slots)
+      , _ranges(Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                                   "ArborX::BVH::partial_rebuild::ranges"),
+                internal_slots.extent(0))
+      , _num_subtree_internal_nodes(internal_slots.extent_int(0))
+      , _num_internal_nodes(internal_nodes.extent_int(0))
+      , _external_rope(external_rope)
+  {
+    Kokkos::deep_copy(space, _ranges, UNTOUCHED_NODE);
+
+    Kokkos::parallel_for(
+        "ArborX::TreeConstruction::generate_subtree_hierarchy",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, leaf_slots.extent(0)),
+        *this);
+  }
+
+  using DeltaValueType = typename SignedCodeType<LinearOrderingValueType>::type;
+
+  // Combined index of the internal node with the local Karras index i
+  KOKKOS_FUNCTION
+  auto internalIndex(int const i) const
+  {
+    return _internal_slots(i) + _num_internal_nodes + 1;
+  }
+
+  KOKKOS_FUNCTION
+  DeltaValueType delta(int const i) const
+  {
+    constexpr auto max_value =
+        KokkosExt::ArithmeticTraits::finite_max<DeltaValueType>::value;
+    constexpr auto min_value =
+        KokkosExt::ArithmeticTraits::finite_min<DeltaValueType>::value;
+
+    // The walls here confine the construction to the subtree; everything
+    // below proceeds as in the full build (see GenerateHierarchy::delta()
+    // for the tie break)
+    if (i < 0 || i >= _num_subtree_internal_nodes)
+      return max_value;
+
+    auto const x = _sorted_morton_codes(i) ^ _sorted_morton_codes(i + 1);
+
+    return x + (!x) * (min_value + (i ^ (i + 1))) - 1;
+  }
+
+  template <typename Node>
+  KOKKOS_FUNCTION void setRope(Node &node, int range_right,
+                               DeltaValueType delta_right) const
+  {
+    int rope;
+    if (range_right != _num_subtree_internal_nodes)
+    {
+      rope = (delta_right < delta(range_right + 1)
+                  ? _leaf_slots(range_right + 1)
+                  : internalIndex(range_right + 1));
+    }
+    else
+    {
+      // The node is on the rightmost path of the subtree and escapes it to
+      // wherever the old subtree root did
+      rope = _external_rope;
+    }
+    node.rope = rope;
+  }
+
+  KOKKOS_FUNCTION void operator()(int i) const
+  {
+    auto &leaf_node = _leaf_nodes(_leaf_slots(i));
+    leaf_node = makeLeafNode(_scratch_leaf_nodes(_permutation_indices(i)).value);
+
+    BoundingVolume bounding_volume{};
+    expand(bounding_volume, _indexable_getter(leaf_node.value));
+
+    int range_left = i;
+    int range_right = i;
+
+    auto delta_left = delta(range_left - 1);
+    auto delta_right = delta(range_right);
+
+    setRope(leaf_node, range_right, delta_right);
+
+    // Combined index of the node the thread is currently at
+    int combined = _leaf_slots(i);
+
+    // The subtree root's Karras index degenerates to zero (both walls
+    // return the same delta), which is precisely where the gathering placed
+    // the old subtree root's slot
+    auto const root = internalIndex(0);
+    do
+    {
+      // The comments of the GenerateHierarchy operator apply verbatim and
+      // are not repeated; the only difference is the slot indirection on
+      // every node access
+      bool const is_left_child = (delta_right < delta_left);
+
+      int left_child;
+      if (is_left_child)
+      {
+        int const apetrei_parent = range_right;
+
+        range_right = Kokkos::atomic_compare_exchange(
+            &_ranges(apetrei_parent), UNTOUCHED_NODE, range_left);
+        if (range_right == UNTOUCHED_NODE)
+          break;
+
+        left_child = combined;
+        int right_child = apetrei_parent + 1;
+        bool const right_child_is_leaf = (right_child == range_right);
+
+        delta_right = delta(range_right);
+
+        Kokkos::load_fence();
+        if (right_child_is_leaf)
+          expand(bounding_volume,
+                 _indexable_getter(_leaf_nodes(_leaf_slots(right_child)).value));
+        else
+          expand(bounding_volume,
+                 _internal_nodes(_internal_slots(right_child)).bounding_volume);
+      }
+      else
+      {
+        int const apetrei_parent = range_left - 1;
+
+        range_left = Kokkos::atomic_compare_exchange(
+            &_ranges(apetrei_parent), UNTOUCHED_NODE, range_right);
+        if (range_left == UNTOUCHED_NODE)
+          break;
+
+        bool const left_child_is_leaf = (apetrei_parent == range_left);
+
+        delta_left = delta(range_left - 1);
+
+        Kokkos::load_fence();
+        if (left_child_is_leaf)
+        {
+          left_child = _leaf_slots(apetrei_parent);
+          expand(bounding_volume,
+                 _indexable_getter(_leaf_nodes(left_child).value));
+        }
+        else
+        {
+          expand(bounding_volume,
+                 _internal_nodes(_internal_slots(apetrei_parent))
+                     .bounding_volume);
+          left_child = internalIndex(apetrei_parent);
+        }
+      }
+
+      int const karras_parent =
+          delta_right < delta_left ? range_right : range_left;
+
+      auto &parent_node = _internal_nodes(_internal_slots(karras_parent));
+      parent_node.left_child = left_child;
+      setRope(parent_node, range_right, delta_right);
+      parent_node.bounding_volume = bounding_volume;
+
+      combined = internalIndex(karras_parent);
+    } while (combined != root);
+  }
+
+private:
+  ScratchLeafNodes _scratch_leaf_nodes;
+  IndexableGetter _indexable_getter;
+  PermutationIndices _permutation_indices;
+  LinearOrdering _sorted_morton_codes;
+  LeafNodes _leaf_nodes;
+  InternalNodes _internal_nodes;
+  Slots _leaf_slots;
+  Slots _internal_slots;
+  Kokkos::View<int *, MemorySpace> _ranges;
+  int _num_subtree_internal_nodes;
+  int _num_internal_nodes;
+  int _external_rope;
+};
+
+// Rebuild in place the smallest subtree covering every leaf whose indexable
+// intersects the region: the subtree's leaves are re-sorted along the
+// space-filling curve and its hierarchy regenerated over the slots it
+// already occupies, while every node outside the subtree keeps its slot,
+// children, ropes, and volumes. The caller is responsible for refitting
+// afterwards: the regenerated subtree has fresh volumes, but the volumes on
+// the path from the subtree root up are stale.
+template <typename ExecutionSpace, typename IndexableGetter,
+          typename SpaceFillingCurve, typename Region, typename LeafNodes,
+          typename InternalNodes, typename Tombstones>
+void rebuildSubtree(ExecutionSpace const &space,
+                    IndexableGetter const &indexable_getter,
+                    SpaceFillingCurve const &curve, Region const &region,
+                    LeafNodes leaf_nodes, InternalNodes internal_nodes,
+                    Tombstones const &tombstones)
+{
+  using MemorySpace = typename InternalNodes::memory_space;
+  using LeafNode = typename LeafNodes::value_type;
+  using BoundingVolume =
+      typename InternalNodes::value_type::bounding_volume_type;
+
+  int const n = leaf_nodes.extent_int(0);
+  int const num_internal_nodes = internal_nodes.extent_int(0);
+
+  // The nodes do not store parent links or leaf ranges, and after graft()
+  // or the treelet restructuring the slot layout carries no range
+  // information either. Recover the parents from the connectivity (as the
+  // refit does) and count the dirty leaves below every internal node
+  // bottom-up; the smallest subtree covering all of them is then found by
+  // descending while one child holds the full count.
+  Kokkos::View<int *, MemorySpace> parents(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::BVH::partial_rebuild::parents"),
+      2 * n - 1);
+  Kokkos::parallel_for(
+      "ArborX::BVH::partial_rebuild::compute_parents",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_internal_nodes),
+      KOKKOS_LAMBDA(int k) {
+        int const left_child = internal_nodes(k).left_child;
+        int const right_child =
+            (left_child < n ? leaf_nodes(left_child).rope
+                            : internal_nodes(left_child - n).rope);
+        parents(left_child) = k;
+        parents(right_child) = k;
+      });
+
+  Kokkos::View<int *, MemorySpace> flags(
+      Kokkos::view_alloc(space, "ArborX::BVH::partial_rebuild::flags"),
+      num_internal_nodes);
+  Kokkos::View<int *, MemorySpace> dirty_counts(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::BVH::partial_rebuild::dirty_counts"),
+      num_internal_nodes);
+  Kokkos::View<int *, MemorySpace> leaf_counts(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::BVH::partial_rebuild::leaf_counts"),
+      num_internal_nodes);
+
+  Kokkos::parallel_for(
+      "ArborX::BVH::partial_rebuild::count_dirty_leaves",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        int node = parents(i);
+        do
+        {
+          if (Kokkos::atomic_fetch_add(&flags(node), 1) == 0)
+            break;
+
+          Kokkos::load_fence();
+
+          int const left_child = internal_nodes(node).left_child;
+          int const right_child =
+              (left_child < n ? leaf_nodes(left_child).rope
+                              : internal_nodes(left_child - n).rope);
+
+          int num_dirty = 0;
+          int num_leaves = 0;
+          for (int child : {left_child, right_child})
+          {
+            if (child < n)
+            {
+              num_dirty += (int)intersects(
+                  indexable_getter(leaf_nodes(child).value), region);
+              ++num_leaves;
+            }
+            else
+            {
+              num_dirty += dirty_counts(child - n);
+              num_leaves += leaf_counts(child - n);
+            }
+          }
+          dirty_counts(node) = num_dirty;
+          leaf_counts(node) = num_leaves;
+
+          if (node == 0) // root
+            break;
+          node = parents(n + node);
+        } while (true);
+      });
+
+  Kokkos::View<int[4], MemorySpace> subtree(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::BVH::partial_rebuild::subtree"));
+  Kokkos::parallel_for(
+      "ArborX::BVH::partial_rebuild::locate_subtree",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, 1), KOKKOS_LAMBDA(int) {
+        int const num_dirty = dirty_counts(0);
+        int node = 0; // internal index, starting at the root
+        if (num_dirty > 1)
+        {
+          // A child holding every dirty leaf spans at least two of them and
+          // thus is internal
+          while (true)
+          {
+            int const left_child = internal_nodes(node).left_child;
+            int const right_child =
+                (left_child < n ? leaf_nodes(left_child).rope
+                                : internal_nodes(left_child - n).rope);
+            if (left_child >= n &&
+                dirty_counts(left_child - n) == num_dirty)
+              node = left_child - n;
+            else if (right_child >= n &&
+                     dirty_counts(right_child - n) == num_dirty)
+              node = right_child - n;
+            else
+              break;
+          }
+        }
+        subtree(0) = num_dirty;
+        subtree(1) = node;
+        subtree(2) = internal_nodes(node).rope;
+        subtree(3) = leaf_counts(node);
+      });
+
+  int subtree_host[4];
+  Kokkos::deep_copy(
+      space,
+      Kokkos::View<int[4], Kokkos::HostSpace, Kokkos::MemoryUnmanaged>(
+          subtree_host),
+      subtree);
+  space.fence("ArborX::BVH::partial_rebuild"
+              " (subtree extent copied to host before allocating scratch)");
+
+  // No dirty leaf, or a single one: there is no topology to rebuild
+  if (subtree_host[0] <= 1)
+    return;
+
+  int const root_slot = subtree_host[1];
+  int const external_rope = subtree_host[2];
+  int const num_leaves = subtree_host[3];
+
+  // Gather the slots the subtree occupies with a stackless rope traversal.
+  // The root comes out first, which is where the restricted generation
+  // expects it.
+  Kokkos::View<int *, MemorySpace> leaf_slots(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::BVH::partial_rebuild::leaf_slots"),
+      num_leaves);
+  Kokkos::View<int *, MemorySpace> internal_slots(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::BVH::partial_rebuild::internal_slots"),
+      num_leaves - 1);
+  Kokkos::parallel_for(
+      "ArborX::BVH::partial_rebuild::gather_slots",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, 1), KOKKOS_LAMBDA(int) {
+        int node = n + root_slot;
+        int num_gathered_leaves = 0;
+        int num_gathered_internals = 0;
+        while (node != external_rope)
+        {
+          if (node < n)
+          {
+            leaf_slots(num_gathered_leaves++) = node;
+            node = leaf_nodes(node).rope;
+          }
+          else
+          {
+            internal_slots(num_gathered_internals++) = node - n;
+            node = internal_nodes(node - n).left_child;
+          }
+        }
+      });
+
+  // Re-sort the subtree's leaves along the space-filling curve over their
+  // own bounding box. The codes are not comparable to the ones of the
+  // original build (different box), but the construction only ever compares
+  // them to each other.
+  SubtreeLeafIndexables<LeafNodes, decltype(leaf_slots), IndexableGetter>
+      indexables{leaf_nodes, leaf_slots, indexable_getter};
+
+  constexpr int DIM = GeometryTraits::dimension_v<BoundingVolume>;
+  using SceneBox = ExperimentalHyperGeometry::Box<
+      DIM, typename GeometryTraits::coordinate_type_t<BoundingVolume>>;
+  SceneBox subtree_box{};
+  calculateBoundingBoxOfTheScene(space, indexables, subtree_box);
+
+  using LinearOrderingValueType =
+      std::invoke_result_t<SpaceFillingCurve, SceneBox,
+                           std::decay_t<decltype(indexables(0))>>;
+  Kokkos::View<LinearOrderingValueType *, MemorySpace> linear_ordering_indices(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::BVH::partial_rebuild::linear_ordering"),
+      num_leaves);
+  projectOntoSpaceFillingCurve(space, indexables, curve, subtree_box,
+                               linear_ordering_indices);
+
+  // The slots were gathered in traversal order, so the codes are sorted up
+  // to the modifications and the adaptive sort gets to repair instead of
+  // sorting from scratch
+  auto permutation_indices =
+      Details::sortObjectsAdaptive(space, linear_ordering_indices);
+
+  // The generation reads the old leaves through the permutation while
+  // overwriting their slots, so it works from a copy
+  Kokkos::View<LeafNode *, MemorySpace> scratch_leaf_nodes(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::BVH::partial_rebuild::scratch_leaf_nodes"),
+      num_leaves);
+  Kokkos::parallel_for(
+      "ArborX::BVH::partial_rebuild::gather_leaves",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_leaves),
+      KOKKOS_LAMBDA(int i) {
+        scratch_leaf_nodes(i) = leaf_nodes(leaf_slots(i));
+      });
+
+  if (tombstones.extent(0) != 0)
+  {
+    // Tombstones follow their leaves into the new order
+    Kokkos::View<char *, MemorySpace> scratch_tombstones(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::BVH::partial_rebuild::scratch_tombstones"),
+        num_leaves);
+    Kokkos::parallel_for(
+        "ArborX::BVH::partial_rebuild::permute_tombstones",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_leaves),
+        KOKKOS_LAMBDA(int i) {
+          scratch_tombstones(i) = tombstones(leaf_slots(i));
+        });
+    Kokkos::parallel_for(
+        "ArborX::BVH::partial_rebuild::scatter_tombstones",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_leaves),
+        KOKKOS_LAMBDA(int i) {
+          tombstones(leaf_slots(i)) = scratch_tombstones(permutation_indices(i));
+        });
+  }
+
+  GenerateSubtreeHierarchy(space, scratch_leaf_nodes, indexable_getter,
+                           permutation_indices, linear_ordering_indices,
+                           leaf_nodes, internal_nodes, leaf_slots,
+                           internal_slots, external_rope);
+}
+
+} // namespace ArborX::Details::TreeConstruction
+
+#endif
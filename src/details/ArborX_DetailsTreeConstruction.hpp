@@ -13,7 +13,10 @@
 #define ARBORX_DETAILS_TREE_CONSTRUCTION_HPP
 
 #include <ArborX_DetailsAlgorithms.hpp> // expand
+#include <ArborX_DetailsBatchedAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtAccessibilityTraits.hpp>
 #include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_DetailsKokkosExtMinMaxOperations.hpp>
 #include <ArborX_DetailsNode.hpp> // makeLeafNode
 #include <ArborX_SpaceFillingCurves.hpp>
 
@@ -39,15 +42,84 @@ struct SceneReductionFunctor
   }
 };
 
+template <typename Indexables, typename BoundingVolume>
+struct BatchedSceneReductionFunctor
+{
+  Indexables _indexables;
+  int _n;
+
+  KOKKOS_FUNCTION void operator()(int b, BoundingVolume &update) const
+  {
+    using KokkosExt::min;
+    Batched::expand(update, _indexables, b * Batched::batch_size,
+                    min(_n, (b + 1) * Batched::batch_size));
+  }
+  KOKKOS_FUNCTION void join(BoundingVolume &result,
+                            BoundingVolume const &update) const
+  {
+    expand(result, update);
+  }
+};
+
 template <typename ExecutionSpace, typename Indexables, typename Box>
 inline void calculateBoundingBoxOfTheScene(ExecutionSpace const &space,
                                            Indexables const &indexables,
                                            Box &scene_bounding_box)
 {
-  Kokkos::parallel_reduce(
-      "ArborX::TreeConstruction::calculate_bounding_box_of_the_scene",
-      Kokkos::RangePolicy<ExecutionSpace>(space, 0, indexables.size()),
-      SceneReductionFunctor<Indexables, Box>{indexables}, scene_bounding_box);
+  if constexpr (KokkosExt::is_accessible_from<Kokkos::HostSpace,
+                                              ExecutionSpace>::value)
+  {
+    // On host backends, reduce over batches of primitives so that the
+    // accumulator stays in registers across each batch and the inner
+    // min/max sweep vectorizes
+    int const n = indexables.size();
+    int const n_batches =
+        (n + Batched::batch_size - 1) / Batched::batch_size;
+    Kokkos::parallel_reduce(
+        "ArborX::TreeConstruction::calculate_bounding_box_of_the_scene",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_batches),
+        BatchedSceneReductionFunctor<Indexables, Box>{indexables, n},
+        scene_bounding_box);
+  }
+  else
+  {
+    Kokkos::parallel_reduce(
+        "ArborX::TreeConstruction::calculate_bounding_box_of_the_scene",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, indexables.size()),
+        SceneReductionFunctor<Indexables, Box>{indexables},
+        scene_bounding_box);
+  }
+}
+
+// Variant that leaves the result in device memory. Reducing into a host
+// scalar blocks the calling thread until the kernel completes, so this is
+// the one to use when construction must only enqueue work on the instance.
+template <typename ExecutionSpace, typename Indexables, typename Box,
+          typename... Properties>
+inline void calculateBoundingBoxOfTheScene(
+    ExecutionSpace const &space, Indexables const &indexables,
+    Kokkos::View<Box, Properties...> const &scene_bounding_box)
+{
+  if constexpr (KokkosExt::is_accessible_from<Kokkos::HostSpace,
+                                              ExecutionSpace>::value)
+  {
+    int const n = indexables.size();
+    int const n_batches =
+        (n + Batched::batch_size - 1) / Batched::batch_size;
+    Kokkos::parallel_reduce(
+        "ArborX::TreeConstruction::calculate_bounding_box_of_the_scene",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_batches),
+        BatchedSceneReductionFunctor<Indexables, Box>{indexables, n},
+        scene_bounding_box);
+  }
+  else
+  {
+    Kokkos::parallel_reduce(
+        "ArborX::TreeConstruction::calculate_bounding_box_of_the_scene",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, indexables.size()),
+        SceneReductionFunctor<Indexables, Box>{indexables},
+        scene_bounding_box);
+  }
 }
 
 template <typename ExecutionSpace, typename Indexables,
@@ -71,6 +143,30 @@ inline void projectOntoSpaceFillingCurve(ExecutionSpace const &space,
       });
 }
 
+// Variant reading the scene bounding box from device memory, matching the
+// asynchronous scene bounds reduction above
+template <typename ExecutionSpace, typename Indexables,
+          typename SpaceFillingCurve, typename Box, typename... Properties,
+          typename LinearOrdering>
+inline void projectOntoSpaceFillingCurve(
+    ExecutionSpace const &space, Indexables const &indexables,
+    SpaceFillingCurve const &curve,
+    Kokkos::View<Box, Properties...> const &scene_bounding_box,
+    LinearOrdering linear_ordering_indices)
+{
+  size_t const n = indexables.size();
+  ARBORX_ASSERT(linear_ordering_indices.extent(0) == n);
+  static_assert(
+      std::is_same_v<typename LinearOrdering::value_type,
+                     decltype(curve(scene_bounding_box(), indexables(0)))>);
+
+  Kokkos::parallel_for(
+      "ArborX::TreeConstruction::project_primitives_onto_space_filling_curve",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        linear_ordering_indices(i) = curve(scene_bounding_box(), indexables(i));
+      });
+}
+
 template <typename ExecutionSpace, typename Values, typename IndexableGetter,
           typename Nodes, typename BoundingVolume>
 inline void
@@ -147,6 +243,31 @@ public:
                      Kokkos::MemoryUnmanaged>(getRootBoundingVolumePtr()));
   }
 
+  // Constructor for the fused small-tree builder, which runs operator()
+  // from inside its own kernel. Nothing is launched here: the caller owns
+  // the ranges scratch, resets it through resetRange() before the emission
+  // phase, and copies the root bounding volume out itself.
+  GenerateHierarchy(Values const &values,
+                    IndexableGetter const &indexable_getter,
+                    PermutationIndices const &permutation_indices,
+                    LinearOrdering const &sorted_morton_codes,
+                    LeafNodes leaf_nodes, InternalNodes internal_nodes,
+                    Kokkos::View<int *, MemorySpace> const &ranges)
+      : _values(values)
+      , _indexable_getter(indexable_getter)
+      , _permutation_indices(permutation_indices)
+      , _sorted_morton_codes(sorted_morton_codes)
+      , _leaf_nodes(leaf_nodes)
+      , _internal_nodes(internal_nodes)
+      , _ranges(ranges)
+      , _num_internal_nodes(_internal_nodes.extent_int(0))
+  {}
+
+  KOKKOS_FUNCTION void resetRange(int i) const
+  {
+    _ranges(i) = UNTOUCHED_NODE;
+  }
+
   KOKKOS_FUNCTION
   BoundingVolume const *getRootBoundingVolumePtr() const
   {
@@ -156,7 +277,10 @@ public:
     return &_internal_nodes.data()->bounding_volume;
   }
 
-  using DeltaValueType = std::make_signed_t<LinearOrderingValueType>;
+  // For the built-in code types this is the standard signed integer of the
+  // same width; the 128-bit codes keep their top bits clear and compare
+  // through their signed high word, serving as their own signed counterpart
+  using DeltaValueType = typename SignedCodeType<LinearOrderingValueType>::type;
 
   KOKKOS_FUNCTION
   auto internalIndex(int const i) const { return i + _num_internal_nodes + 1; }
@@ -355,6 +479,122 @@ private:
   int _num_internal_nodes;
 };
 
+// Recompute the bounding volumes of the internal nodes bottom-up, reusing the
+// hierarchy produced by generateHierarchy(). This is much cheaper than a full
+// rebuild and is appropriate when the indexables moved only slightly (the tree
+// topology, and thus its quality, is unchanged). Tombstoned leaves (an empty
+// view disables the feature) contribute nothing to their ancestors, so fully
+// emptied subtrees end up with default volumes that no predicate can
+// intersect and traversals prune them.
+template <typename ExecutionSpace, typename IndexableGetter, typename LeafNodes,
+          typename InternalNodes, typename BoundingVolume, typename Tombstones>
+inline void refitHierarchy(ExecutionSpace const &space,
+                           IndexableGetter const &indexable_getter,
+                           LeafNodes leaf_nodes, InternalNodes internal_nodes,
+                           BoundingVolume &bounds,
+                           Tombstones const &tombstones)
+{
+  using MemorySpace = typename InternalNodes::memory_space;
+
+  int const n = leaf_nodes.extent_int(0);
+  int const num_internal_nodes = internal_nodes.extent_int(0);
+  ARBORX_ASSERT(num_internal_nodes == n - 1);
+
+  // The nodes do not store parent links. Recover them from the connectivity:
+  // the left child is stored explicitly, and the right child is the rope of
+  // the left child. Leaf nodes use indices [0, n), internal nodes [n, 2n-1).
+  Kokkos::View<int *, MemorySpace> parents(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::BVH::refit::parents"),
+      2 * n - 1);
+  Kokkos::parallel_for(
+      "ArborX::TreeConstruction::compute_parents",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_internal_nodes),
+      KOKKOS_LAMBDA(int k) {
+        int const left_child = internal_nodes(k).left_child;
+        int const right_child =
+            (left_child < n ? leaf_nodes(left_child).rope
+                            : internal_nodes(left_child - n).rope);
+        parents(left_child) = k;
+        parents(right_child) = k;
+      });
+
+  Kokkos::View<int *, MemorySpace> flags(
+      Kokkos::view_alloc(space, "ArborX::BVH::refit::flags"),
+      num_internal_nodes);
+
+  Kokkos::parallel_for(
+      "ArborX::TreeConstruction::refit_hierarchy",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        int node = parents(i);
+        do
+        {
+          // Use an atomic flag per internal node to terminate the first
+          // thread that enters it, while letting the second one through.
+          // This ensures that no node is processed before both of its
+          // children are.
+          if (Kokkos::atomic_fetch_add(&flags(node), 1) == 0)
+            break;
+
+          // Memory synchronization below ensures writes from other threads
+          // to the child bounding volume memory locations are visible from
+          // the current thread.
+          // NOTE we need acquire semantics at the device scope
+          Kokkos::load_fence();
+
+          int const left_child = internal_nodes(node).left_child;
+          int const right_child =
+              (left_child < n ? leaf_nodes(left_child).rope
+                              : internal_nodes(left_child - n).rope);
+
+          BoundingVolume bounding_volume{};
+          if (left_child < n)
+          {
+            if (tombstones.extent(0) == 0 || tombstones(left_child) == 0)
+              expand(bounding_volume,
+                     indexable_getter(leaf_nodes(left_child).value));
+          }
+          else
+            expand(bounding_volume,
+                   internal_nodes(left_child - n).bounding_volume);
+          if (right_child < n)
+          {
+            if (tombstones.extent(0) == 0 || tombstones(right_child) == 0)
+              expand(bounding_volume,
+                     indexable_getter(leaf_nodes(right_child).value));
+          }
+          else
+            expand(bounding_volume,
+                   internal_nodes(right_child - n).bounding_volume);
+
+          internal_nodes(node).bounding_volume = bounding_volume;
+
+          if (node == 0) // root
+            break;
+          node = parents(n + node);
+        } while (true);
+      });
+
+  Kokkos::deep_copy(
+      space,
+      Kokkos::View<BoundingVolume, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>(
+          &bounds),
+      Kokkos::View<BoundingVolume const, MemorySpace, Kokkos::MemoryUnmanaged>(
+          &internal_nodes.data()->bounding_volume));
+}
+
+template <typename ExecutionSpace, typename IndexableGetter, typename LeafNodes,
+          typename InternalNodes, typename BoundingVolume>
+inline void refitHierarchy(ExecutionSpace const &space,
+                           IndexableGetter const &indexable_getter,
+                           LeafNodes leaf_nodes, InternalNodes internal_nodes,
+                           BoundingVolume &bounds)
+{
+  using MemorySpace = typename InternalNodes::memory_space;
+  refitHierarchy(space, indexable_getter, leaf_nodes, internal_nodes, bounds,
+                 Kokkos::View<char *, MemorySpace>());
+}
+
 template <typename ExecutionSpace, typename Values, typename IndexableGetter,
           typename... PermutationIndicesViewProperties,
           typename LinearOrderingValueType,
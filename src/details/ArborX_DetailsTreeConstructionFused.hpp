@@ -0,0 +1,216 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILS_TREE_CONSTRUCTION_FUSED_HPP
+#define ARBORX_DETAILS_TREE_CONSTRUCTION_FUSED_HPP
+
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_DetailsKokkosExtScratchArena.hpp>
+#include <ArborX_DetailsTreeConstruction.hpp>
+#include <ArborX_Exception.hpp>
+#include <ArborX_GeometryTraits.hpp>
+#include <ArborX_HyperBox.hpp>
+
+#include <Kokkos_BitManipulation.hpp>
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Details::TreeConstruction
+{
+
+// Upper bound on the tree size eligible for the fused single-launch builder.
+// Below it, a build costs more in kernel launches and inter-kernel memory
+// round-trips than in compute, and the single launch removes that overhead;
+// above it, the sort dominates and the multi-kernel path with its tuned
+// global sort wins.
+inline constexpr int max_fused_construction_size = 16384;
+
+// Builds the complete tree in one kernel launch: a single team reduces the
+// scene bounding box, projects the indexables onto the space-filling curve,
+// sorts the codes with a bitonic network, and emits the hierarchy, with team
+// barriers separating the phases. All scratch lives in global memory, so the
+// fusion win is the removed launches and synchronizations, not data reuse.
+template <typename Values, typename IndexableGetter, typename SpaceFillingCurve,
+          typename SceneBox, typename Codes, typename Permutation,
+          typename PermutationOut, typename ScenePartials, typename Hierarchy>
+struct FusedSmallTreeBuilder
+{
+  Values _values;
+  IndexableGetter _indexable_getter;
+  SpaceFillingCurve _curve;
+  Codes _codes;               // padded to _padded_size
+  Permutation _permutation;   // padded to _padded_size
+  PermutationOut _permutation_out;
+  ScenePartials _scene_partials;
+  Hierarchy _hierarchy;
+  int _size;
+  int _padded_size;
+
+  template <typename TeamMember>
+  KOKKOS_FUNCTION void operator()(TeamMember const &member) const
+  {
+    using Code = typename Codes::non_const_value_type;
+    using Details::expand;
+
+    int const n = _size;
+    int const rank = member.team_rank();
+    int const team_size = member.team_size();
+
+    // Scene bounds: each thread accumulates a partial box over a strided
+    // range, and a single thread combines the partials, which is cheap at
+    // these sizes
+    SceneBox partial{};
+    for (int i = rank; i < n; i += team_size)
+      expand(partial, _indexable_getter(_values(i)));
+    _scene_partials(rank) = partial;
+    member.team_barrier();
+    if (rank == 0)
+    {
+      SceneBox scene{};
+      for (int r = 0; r < team_size; ++r)
+        expand(scene, _scene_partials(r));
+      _scene_partials(0) = scene;
+    }
+    member.team_barrier();
+    SceneBox const scene_bounding_box = _scene_partials(0);
+
+    // Projection. The tail up to the power-of-two padded size is filled with
+    // sentinel keys: the sort below breaks code ties by the index, and the
+    // tail indices exceed every real one, so the tail keys sort strictly
+    // last and the network stays oblivious to the actual size. The range
+    // flags of the emission phase are reset on the way.
+    constexpr auto sentinel =
+        KokkosExt::ArithmeticTraits::finite_max<Code>::value;
+    for (int i = rank; i < _padded_size; i += team_size)
+    {
+      _codes(i) = (i < n) ? _curve(scene_bounding_box,
+                                   _indexable_getter(_values(i)))
+                          : sentinel;
+      _permutation(i) = i;
+    }
+    for (int i = rank; i < n - 1; i += team_size)
+      _hierarchy.resetRange(i);
+    member.team_barrier();
+
+    // Bitonic sort of the (code, index) pairs. The pairs are pairwise
+    // distinct, so a strict comparison determines every exchange.
+    for (int k = 2; k <= _padded_size; k <<= 1)
+      for (int j = k >> 1; j > 0; j >>= 1)
+      {
+        for (int i = rank; i < _padded_size; i += team_size)
+        {
+          int const l = i ^ j;
+          if (l <= i)
+            continue;
+          auto const code_i = _codes(i);
+          auto const code_l = _codes(l);
+          auto const index_i = _permutation(i);
+          auto const index_l = _permutation(l);
+          bool const descending = ((i & k) != 0);
+          bool const greater =
+              code_i > code_l || (code_i == code_l && index_i > index_l);
+          if (greater != descending)
+          {
+            _codes(i) = code_l;
+            _codes(l) = code_i;
+            _permutation(i) = index_l;
+            _permutation(l) = index_i;
+          }
+        }
+        member.team_barrier();
+      }
+
+    // Hierarchy emission: the same per-leaf bottom-up walk as the
+    // multi-kernel path, running over the team's threads
+    bool const keep_permutation = (_permutation_out.extent(0) != 0);
+    for (int i = rank; i < n; i += team_size)
+    {
+      if (keep_permutation)
+        _permutation_out(i) = _permutation(i);
+      _hierarchy(i);
+    }
+  }
+};
+
+// Single-launch construction for trees of at most
+// max_fused_construction_size leaves. The temporaries come from the scratch
+// arena, so repeated small builds on one execution space instance allocate
+// nothing. The permutation view may be empty when the caller does not keep
+// the leaf permutation; otherwise it must have one entry per leaf.
+template <typename ExecutionSpace, typename Values, typename IndexableGetter,
+          typename SpaceFillingCurve, typename... PermutationViewProperties,
+          typename LeafNodes, typename InternalNodes>
+void buildSmallTreeFused(
+    ExecutionSpace const &space, Values const &values,
+    IndexableGetter const &indexable_getter, SpaceFillingCurve const &curve,
+    Kokkos::View<unsigned int *, PermutationViewProperties...> const
+        &leaf_permutation,
+    LeafNodes leaf_nodes, InternalNodes internal_nodes,
+    typename InternalNodes::value_type::bounding_volume_type &bounds)
+{
+  using MemorySpace = typename LeafNodes::memory_space;
+  using BoundingVolume =
+      typename InternalNodes::value_type::bounding_volume_type;
+
+  constexpr int DIM = GeometryTraits::dimension_v<BoundingVolume>;
+  using SceneBox = ExperimentalHyperGeometry::Box<
+      DIM, typename GeometryTraits::coordinate_type_t<BoundingVolume>>;
+  using Indexable = std::decay_t<
+      std::invoke_result_t<IndexableGetter, typename Values::value_type>>;
+  using Code = std::invoke_result_t<SpaceFillingCurve, SceneBox, Indexable>;
+  static_assert(std::is_unsigned_v<Code>,
+                "the bitonic phase relies on an integral sentinel code");
+
+  int const n = leaf_nodes.extent_int(0);
+  ARBORX_ASSERT(n >= 2 && n <= max_fused_construction_size);
+  ARBORX_ASSERT(leaf_permutation.extent(0) == 0 ||
+                leaf_permutation.extent_int(0) == n);
+  int const padded_size = (int)Kokkos::bit_ceil((unsigned)n);
+
+  KokkosExt::ScratchArena<MemorySpace> arena(space);
+  auto codes = arena.template allocate<Code>(padded_size);
+  auto permutation = arena.template allocate<unsigned int>(padded_size);
+  auto ranges = arena.template allocate<int>(n - 1);
+
+  using Hierarchy = GenerateHierarchy<Values, IndexableGetter,
+                                      decltype(permutation), decltype(codes),
+                                      LeafNodes, InternalNodes>;
+  Hierarchy hierarchy(values, indexable_getter, permutation, codes, leaf_nodes,
+                      internal_nodes, Kokkos::View<int *, MemorySpace>(ranges));
+
+  FusedSmallTreeBuilder<
+      Values, IndexableGetter, SpaceFillingCurve, SceneBox, decltype(codes),
+      decltype(permutation),
+      Kokkos::View<unsigned int *, PermutationViewProperties...>,
+      decltype(arena.template allocate<SceneBox>(0)), Hierarchy>
+      builder{values,      indexable_getter, curve,    codes,
+              permutation, leaf_permutation, {},       hierarchy,
+              n,           padded_size};
+
+  Kokkos::TeamPolicy<ExecutionSpace> policy(space, 1, Kokkos::AUTO);
+  int const team_size =
+      policy.team_size_recommended(builder, Kokkos::ParallelForTag{});
+  builder._scene_partials = arena.template allocate<SceneBox>(team_size);
+
+  Kokkos::parallel_for(
+      "ArborX::TreeConstruction::build_small_tree_fused",
+      Kokkos::TeamPolicy<ExecutionSpace>(space, 1, team_size), builder);
+
+  Kokkos::deep_copy(
+      space,
+      Kokkos::View<BoundingVolume, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>(
+          &bounds),
+      Kokkos::View<BoundingVolume const, MemorySpace, Kokkos::MemoryUnmanaged>(
+          hierarchy.getRootBoundingVolumePtr()));
+}
+
+} // namespace ArborX::Details::TreeConstruction
+
+#endif
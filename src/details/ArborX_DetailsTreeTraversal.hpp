@@ -14,8 +14,10 @@
 #include <ArborX_DetailsAlgorithms.hpp>
 #include <ArborX_DetailsHappyTreeFriends.hpp>
 #include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_DetailsKokkosExtMinMaxOperations.hpp>
 #include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
 #include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DetailsLaunchTuner.hpp>
 #include <ArborX_DetailsNearestBufferProvider.hpp>
 #include <ArborX_DetailsNode.hpp> // ROPE_SENTINEL
 #include <ArborX_DetailsPriorityQueue.hpp>
@@ -23,6 +25,8 @@
 #include <ArborX_Exception.hpp>
 #include <ArborX_Predicates.hpp>
 
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
 namespace ArborX
 {
 namespace Details
@@ -46,6 +50,8 @@ struct TreeTraversal<BVH, Predicates, Callback, SpatialPredicateTag>
       , _predicates{predicates}
       , _callback{callback}
   {
+    Kokkos::Profiling::ScopedRegion guard("ArborX::TreeTraversal::spatial");
+
     if (_bvh.empty())
     {
       // do nothing
@@ -58,12 +64,30 @@ struct TreeTraversal<BVH, Predicates, Callback, SpatialPredicateTag>
                                                            predicates.size()),
           *this);
     }
+    else if constexpr (std::is_same_v<typename ExecutionSpace::memory_space,
+                                      Kokkos::HostSpace>)
+    {
+      // On host backends, each rope hop of the one-predicate-per-thread loop
+      // is a dependent cache miss once the tree exceeds the cache. Processing
+      // several predicates per thread concurrently overlaps those misses:
+      // every predicate's next node is prefetched while the others compute.
+      int const n_blocks =
+          (predicates.size() + interleave_width - 1) / interleave_width;
+      // Static scheduling keeps each SFC-sorted predicate block on the thread
+      // whose first touch committed the node pages of the matching subtree
+      // range, so multi-socket hosts mostly read from their own NUMA domain
+      LaunchTuner::parallelFor(
+          "ArborX::TreeTraversal::spatial",
+          Kokkos::RangePolicy<ExecutionSpace, Kokkos::Schedule<Kokkos::Static>,
+                              Interleaved>(space, 0, n_blocks),
+          *this);
+    }
     else
     {
-      Kokkos::parallel_for("ArborX::TreeTraversal::spatial",
-                           Kokkos::RangePolicy<ExecutionSpace, FullTree>(
-                               space, 0, predicates.size()),
-                           *this);
+      LaunchTuner::parallelFor("ArborX::TreeTraversal::spatial",
+                               Kokkos::RangePolicy<ExecutionSpace, FullTree>(
+                                   space, 0, predicates.size()),
+                               *this);
     }
   }
 
@@ -78,13 +102,21 @@ struct TreeTraversal<BVH, Predicates, Callback, SpatialPredicateTag>
   struct FullTree
   {};
 
+  struct Interleaved
+  {};
+
+  // Number of predicates a host thread advances in lockstep. Large enough to
+  // cover the latency of a node fetch with the intersection tests of the
+  // other lanes, small enough for the lane state to stay in registers.
+  static constexpr int interleave_width = 8;
+
   KOKKOS_FUNCTION void operator()(OneLeafTree, int queryIndex) const
   {
     auto const &predicate = _predicates(queryIndex);
     auto const root = 0;
     auto const &root_bounding_volume =
         HappyTreeFriends::getIndexable(_bvh, root);
-    if (predicate(root_bounding_volume))
+    if (HappyTreeFriends::isLive(_bvh, root) && predicate(root_bounding_volume))
     {
       _callback(predicate, HappyTreeFriends::getValue(_bvh, 0));
     }
@@ -95,6 +127,79 @@ struct TreeTraversal<BVH, Predicates, Callback, SpatialPredicateTag>
     operator()(_predicates(queryIndex));
   }
 
+  KOKKOS_FUNCTION void operator()(Interleaved, int blockIndex) const
+  {
+    int const n_queries = _predicates.size();
+    int const block_begin = blockIndex * interleave_width;
+
+    int query_index[interleave_width];
+    int node[interleave_width];
+    int n_active = KokkosExt::min(interleave_width, n_queries - block_begin);
+    for (int lane = 0; lane < n_active; ++lane)
+    {
+      query_index[lane] = block_begin + lane;
+      node[lane] = HappyTreeFriends::getRoot(_bvh);
+    }
+
+    while (n_active > 0)
+    {
+      for (int lane = 0; lane < n_active; ++lane)
+        prefetchNode(node[lane]);
+
+      for (int lane = 0; lane < n_active;)
+      {
+        int const current = node[lane];
+        auto const &predicate = _predicates(query_index[lane]);
+
+        int next;
+        if (HappyTreeFriends::isLeaf(_bvh, current))
+        {
+          next = (HappyTreeFriends::isLive(_bvh, current) &&
+                  predicate(HappyTreeFriends::getIndexable(_bvh, current)) &&
+                  invoke_callback_and_check_early_exit(
+                      _callback, predicate,
+                      HappyTreeFriends::getValue(_bvh, current)))
+                     ? ROPE_SENTINEL
+                     : HappyTreeFriends::getRope(_bvh, current);
+        }
+        else
+        {
+          next = (predicate(
+                      HappyTreeFriends::getInternalBoundingVolume(_bvh, current))
+                      ? HappyTreeFriends::getLeftChild(_bvh, current)
+                      : HappyTreeFriends::getRope(_bvh, current));
+        }
+
+        if (next == ROPE_SENTINEL)
+        {
+          // Retire the lane by swapping in the last active one
+          --n_active;
+          query_index[lane] = query_index[n_active];
+          node[lane] = node[n_active];
+        }
+        else
+        {
+          node[lane] = next;
+          ++lane;
+        }
+      }
+    }
+  }
+
+  // Issue a non-binding prefetch of the node a lane visits next, so that its
+  // cache miss overlaps with the intersection tests of the other lanes
+  KOKKOS_FORCEINLINE_FUNCTION void prefetchNode([[maybe_unused]] int node) const
+  {
+#if defined(__GNUC__) && !defined(__CUDA_ARCH__) &&                            \
+    !defined(__HIP_DEVICE_COMPILE__)
+    if (HappyTreeFriends::isLeaf(_bvh, node))
+      __builtin_prefetch(&HappyTreeFriends::getLeafNodes(_bvh)(node));
+    else
+      __builtin_prefetch(&HappyTreeFriends::getInternalBoundingVolume(
+          _bvh, node));
+#endif
+  }
+
   template <typename Predicate>
   KOKKOS_FUNCTION void operator()(Predicate const &predicate) const
   {
@@ -103,7 +208,8 @@ struct TreeTraversal<BVH, Predicates, Callback, SpatialPredicateTag>
     {
       if (HappyTreeFriends::isLeaf(_bvh, node))
       {
-        if (predicate(HappyTreeFriends::getIndexable(_bvh, node)) &&
+        if (HappyTreeFriends::isLive(_bvh, node) &&
+            predicate(HappyTreeFriends::getIndexable(_bvh, node)) &&
             invoke_callback_and_check_early_exit(
                 _callback, predicate, HappyTreeFriends::getValue(_bvh, node)))
           return;
@@ -138,6 +244,8 @@ struct TreeTraversal<BVH, Predicates, Callback, NearestPredicateTag>
       , _predicates{predicates}
       , _callback{callback}
   {
+    Kokkos::Profiling::ScopedRegion guard("ArborX::TreeTraversal::nearest");
+
     if (_bvh.empty())
     {
       // do nothing
@@ -152,9 +260,46 @@ struct TreeTraversal<BVH, Predicates, Callback, NearestPredicateTag>
     }
     else
     {
+      // Find out whether the heap machinery is needed at all. For k=1 the
+      // best candidate fits in registers, which skips the buffer allocation
+      // and the per-query heap maintenance entirely.
+      int max_k = 0;
+      auto const &predicates = _predicates;
+      Kokkos::parallel_reduce(
+          "ArborX::TreeTraversal::nearest::max_k",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, predicates.size()),
+          KOKKOS_LAMBDA(int i, int &update) {
+            int const k = getK(predicates(i));
+            if (k > update)
+              update = k;
+          },
+          Kokkos::Max<int>(max_k));
+
+      if (max_k == 1)
+      {
+        LaunchTuner::parallelFor(
+            "ArborX::TreeTraversal::nearest::k_of_1",
+            Kokkos::RangePolicy<ExecutionSpace, SingleNearest>(
+                space, 0, predicates.size()),
+            *this);
+        return;
+      }
+
+      if (max_k <= small_k_capacity)
+      {
+        // The candidate heaps fit in registers (or thread-local memory),
+        // which also skips the global buffer allocation
+        LaunchTuner::parallelFor(
+            "ArborX::TreeTraversal::nearest::small_k",
+            Kokkos::RangePolicy<ExecutionSpace, SmallNearest>(
+                space, 0, predicates.size()),
+            *this);
+        return;
+      }
+
       _buffer = NearestBufferProvider<MemorySpace>(space, predicates);
 
-      Kokkos::parallel_for(
+      LaunchTuner::parallelFor(
           "ArborX::TreeTraversal::nearest",
           Kokkos::RangePolicy<ExecutionSpace>(space, 0, predicates.size()),
           *this);
@@ -164,6 +309,139 @@ struct TreeTraversal<BVH, Predicates, Callback, NearestPredicateTag>
   struct OneLeafTree
   {};
 
+  struct SingleNearest
+  {};
+
+  struct SmallNearest
+  {};
+
+  // Largest k for which the candidate heap is kept in registers (or
+  // thread-local memory) instead of the global-memory buffer
+  static constexpr int small_k_capacity = 8;
+
+  using PairIndexDistance =
+      typename NearestBufferProvider<MemorySpace>::PairIndexDistance;
+
+  // Specialized traversal for k=1 that tracks the best candidate in
+  // registers instead of maintaining a heap in a scratch buffer
+  KOKKOS_FUNCTION void operator()(SingleNearest, int queryIndex) const
+  {
+    auto const &predicate = _predicates(queryIndex);
+
+    if (getK(predicate) < 1)
+      return;
+
+    auto &bvh = _bvh;
+    auto const distance = [&predicate, &bvh](int j) {
+      using DistanceType = decltype(predicate.distance(
+          HappyTreeFriends::getInternalBoundingVolume(bvh, j)));
+      if (HappyTreeFriends::isLeaf(bvh, j))
+      {
+        // An infinite distance keeps tombstoned leaves from ever becoming
+        // candidates
+        return HappyTreeFriends::isLive(bvh, j)
+                   ? predicate.distance(HappyTreeFriends::getIndexable(bvh, j))
+                   : KokkosExt::ArithmeticTraits::infinity<DistanceType>::value;
+      }
+      return predicate.distance(
+          HappyTreeFriends::getInternalBoundingVolume(bvh, j));
+    };
+
+    int best_leaf = -1;
+    auto radius = getInitialBound(predicate);
+
+    // In the (1+eps)-approximate mode, only candidates that would improve on
+    // the current best by more than the slack factor are considered
+    auto const slack = getDistanceSlack(predicate);
+
+    constexpr int SENTINEL = -1;
+    int stack[64];
+    auto *stack_ptr = stack;
+    *stack_ptr++ = SENTINEL;
+
+    int node = HappyTreeFriends::getRoot(_bvh);
+    float distance_node = 0.f;
+
+    do
+    {
+      bool traverse_left = false;
+      bool traverse_right = false;
+
+      int left_child;
+      int right_child;
+      float distance_left = 0.f;
+      float distance_right = 0.f;
+
+      if (distance_node * slack < radius)
+      {
+        left_child = HappyTreeFriends::getLeftChild(_bvh, node);
+        right_child = HappyTreeFriends::getRightChild(_bvh, node);
+
+        distance_left = distance(left_child);
+        distance_right = distance(right_child);
+
+        if (distance_left * slack < radius)
+        {
+          if (HappyTreeFriends::isLeaf(_bvh, left_child))
+          {
+            best_leaf = left_child;
+            radius = distance_left;
+          }
+          else
+          {
+            traverse_left = true;
+          }
+        }
+
+        // Note: radius may have been already updated here from the left child
+        if (distance_right * slack < radius)
+        {
+          if (HappyTreeFriends::isLeaf(_bvh, right_child))
+          {
+            best_leaf = right_child;
+            radius = distance_right;
+          }
+          else
+          {
+            traverse_right = true;
+          }
+        }
+      }
+
+      if (!traverse_left && !traverse_right)
+      {
+        node = *--stack_ptr;
+        if (node != SENTINEL)
+        {
+          // This is a theoretically unnecessary duplication of distance
+          // calculation for stack nodes. However, it is better than putting
+          // the distances in the stack.
+          distance_node = distance(node);
+        }
+      }
+      else
+      {
+        node = (traverse_left &&
+                (distance_left <= distance_right || !traverse_right))
+                   ? left_child
+                   : right_child;
+        distance_node = (node == left_child ? distance_left : distance_right);
+        if (traverse_left && traverse_right)
+          *stack_ptr++ = (node == left_child ? right_child : left_child);
+      }
+    } while (node != SENTINEL);
+
+    if (best_leaf != -1)
+      _callback(predicate, HappyTreeFriends::getValue(_bvh, best_leaf));
+    else if constexpr (has_initial_candidate_v<
+                           std::decay_t<decltype(predicate)>>)
+    {
+      // The seeded bound admits only strictly closer values, so finding
+      // nothing means the seed itself is the nearest neighbor
+      _callback(predicate, getInitialCandidate(predicate));
+    }
+  }
+
   KOKKOS_FUNCTION void operator()(OneLeafTree, int queryIndex) const
   {
     auto const &predicate = _predicates(queryIndex);
@@ -173,6 +451,9 @@ struct TreeTraversal<BVH, Predicates, Callback, NearestPredicateTag>
     if (k < 1)
       return;
 
+    if (!HappyTreeFriends::isLive(_bvh, 0))
+      return;
+
     _callback(predicate, HappyTreeFriends::getValue(_bvh, 0));
   }
 
@@ -186,8 +467,29 @@ struct TreeTraversal<BVH, Predicates, Callback, NearestPredicateTag>
     if (k < 1)
       return;
 
-    using PairIndexDistance =
-        typename NearestBufferProvider<MemorySpace>::PairIndexDistance;
+    KOKKOS_ASSERT(k == (int)buffer.size());
+    searchNearest(predicate, k, buffer.data());
+  }
+
+  // Specialized traversal for small k that stores the candidate heap in
+  // registers (or thread-local memory) instead of the buffer provider's
+  // global-memory allocation
+  KOKKOS_FUNCTION void operator()(SmallNearest, int queryIndex) const
+  {
+    auto const &predicate = _predicates(queryIndex);
+    auto const k = getK(predicate);
+
+    if (k < 1)
+      return;
+
+    PairIndexDistance buffer[small_k_capacity];
+    searchNearest(predicate, k, buffer);
+  }
+
+  template <typename Predicate>
+  KOKKOS_FUNCTION void searchNearest(Predicate const &predicate, int k,
+                                     PairIndexDistance *buffer) const
+  {
     struct CompareDistance
     {
       KOKKOS_INLINE_FUNCTION bool operator()(PairIndexDistance const &lhs,
@@ -200,18 +502,24 @@ struct TreeTraversal<BVH, Predicates, Callback, NearestPredicateTag>
     // preserve the heap structure internally at all time.  There is no
     // memory allocation, elements are stored in the buffer passed as an
     // argument. The farthest leaf node is on top.
-    KOKKOS_ASSERT(k == (int)buffer.size());
     PriorityQueue<PairIndexDistance, CompareDistance,
                   UnmanagedStaticVector<PairIndexDistance>>
-        heap(UnmanagedStaticVector<PairIndexDistance>(buffer.data(),
-                                                      buffer.size()));
+        heap(UnmanagedStaticVector<PairIndexDistance>(buffer, k));
 
     auto &bvh = _bvh;
     auto const distance = [&predicate, &bvh](int j) {
-      return HappyTreeFriends::isLeaf(bvh, j)
-                 ? predicate.distance(HappyTreeFriends::getIndexable(bvh, j))
-                 : predicate.distance(
-                       HappyTreeFriends::getInternalBoundingVolume(bvh, j));
+      using DistanceType = decltype(predicate.distance(
+          HappyTreeFriends::getInternalBoundingVolume(bvh, j)));
+      if (HappyTreeFriends::isLeaf(bvh, j))
+      {
+        // An infinite distance keeps tombstoned leaves from ever becoming
+        // candidates
+        return HappyTreeFriends::isLive(bvh, j)
+                   ? predicate.distance(HappyTreeFriends::getIndexable(bvh, j))
+                   : KokkosExt::ArithmeticTraits::infinity<DistanceType>::value;
+      }
+      return predicate.distance(
+          HappyTreeFriends::getInternalBoundingVolume(bvh, j));
     };
 
     constexpr int SENTINEL = -1;
@@ -233,16 +541,21 @@ struct TreeTraversal<BVH, Predicates, Callback, NearestPredicateTag>
     float distance_node = 0.f;
 
     // Nodes with a distance that exceed that radius can safely be
-    // discarded. Initialize the radius to infinity and tighten it once k
-    // neighbors have been found.
-    auto radius = KokkosExt::ArithmeticTraits::infinity<float>::value;
+    // discarded. The radius starts at the bound carried by the predicate
+    // (infinity unless one is known) and is tightened once k neighbors have
+    // been found.
+    auto radius = getInitialBound(predicate);
+
+    // In the (1+eps)-approximate mode, only candidates that would improve on
+    // the current k-th best by more than the slack factor are considered
+    auto const slack = getDistanceSlack(predicate);
 
     do
     {
       bool traverse_left = false;
       bool traverse_right = false;
 
-      if (distance_node < radius)
+      if (distance_node * slack < radius)
       {
         // Insert children into the stack and make sure that the
         // closest one ends on top.
@@ -252,7 +565,7 @@ struct TreeTraversal<BVH, Predicates, Callback, NearestPredicateTag>
         distance_left = distance(left_child);
         distance_right = distance(right_child);
 
-        if (distance_left < radius)
+        if (distance_left * slack < radius)
         {
           if (HappyTreeFriends::isLeaf(_bvh, left_child))
           {
@@ -271,7 +584,7 @@ struct TreeTraversal<BVH, Predicates, Callback, NearestPredicateTag>
         }
 
         // Note: radius may have been already updated here from the left child
-        if (distance_right < radius)
+        if (distance_right * slack < radius)
         {
           if (HappyTreeFriends::isLeaf(_bvh, right_child))
           {
@@ -323,7 +636,9 @@ struct TreeTraversal<BVH, Predicates, Callback, NearestPredicateTag>
       }
     } while (node != SENTINEL);
 
-    // Sort the leaf nodes and output the results.
+    // Sort the leaf nodes and output the results. Emitting each query's
+    // results in ascending distance is part of the nearest output contract
+    // that downstream consumers may rely on.
     // NOTE: Do not try this at home.  Messing with the underlying container
     // invalidates the state of the PriorityQueue.
     sortHeap(heap.data(), heap.data() + heap.size(), heap.valueComp());
@@ -332,6 +647,14 @@ struct TreeTraversal<BVH, Predicates, Callback, NearestPredicateTag>
       _callback(predicate,
                 HappyTreeFriends::getValue(_bvh, (heap.data() + i)->first));
     }
+
+    if constexpr (has_initial_candidate_v<std::decay_t<Predicate>>)
+    {
+      // A single-nearest query bounded by its seed only collects strictly
+      // closer values, so an empty heap means the seed is still the answer
+      if (k == 1 && heap.size() == 0)
+        _callback(predicate, getInitialCandidate(predicate));
+    }
   }
 };
 
@@ -349,6 +672,9 @@ struct TreeTraversal<BVH, Predicates, Callback, OrderedSpatialPredicateTag>
       , _predicates{predicates}
       , _callback{callback}
   {
+    Kokkos::Profiling::ScopedRegion guard(
+        "ArborX::TreeTraversal::ordered_spatial");
+
     if (_bvh.empty())
     {
       // do nothing
@@ -364,7 +690,7 @@ struct TreeTraversal<BVH, Predicates, Callback, OrderedSpatialPredicateTag>
     }
     else
     {
-      Kokkos::parallel_for(
+      LaunchTuner::parallelFor(
           "ArborX::Experimental::TreeTraversal::OrderedSpatialPredicate",
           Kokkos::RangePolicy<ExecutionSpace, FullTree>(space, 0,
                                                         predicates.size()),
@@ -393,7 +719,8 @@ struct TreeTraversal<BVH, Predicates, Callback, OrderedSpatialPredicateTag>
         decltype(distance(getGeometry(predicate), root_bounding_volume));
     constexpr auto inf =
         KokkosExt::ArithmeticTraits::infinity<distance_type>::value;
-    if (distance(getGeometry(predicate), root_bounding_volume) != inf)
+    if (HappyTreeFriends::isLive(_bvh, root) &&
+        distance(getGeometry(predicate), root_bounding_volume) != inf)
     {
       _callback(predicate, HappyTreeFriends::getValue(_bvh, 0));
     }
@@ -430,12 +757,25 @@ struct TreeTraversal<BVH, Predicates, Callback, OrderedSpatialPredicateTag>
     constexpr auto inf =
         KokkosExt::ArithmeticTraits::infinity<distance_type>::value;
 
+    // A k-limited predicate stops the traversal after its first k matches;
+    // the callback may still terminate it earlier
+    auto const max_results = getMaxResults(predicate);
+    int num_results = 0;
+
     auto &bvh = _bvh;
     auto const distance = [&predicate, &bvh](int j) {
-      return HappyTreeFriends::isLeaf(bvh, j)
-                 ? predicate.distance(HappyTreeFriends::getIndexable(bvh, j))
-                 : predicate.distance(
-                       HappyTreeFriends::getInternalBoundingVolume(bvh, j));
+      using DistanceType = decltype(predicate.distance(
+          HappyTreeFriends::getInternalBoundingVolume(bvh, j)));
+      if (HappyTreeFriends::isLeaf(bvh, j))
+      {
+        // An infinite distance keeps tombstoned leaves from ever becoming
+        // candidates
+        return HappyTreeFriends::isLive(bvh, j)
+                   ? predicate.distance(HappyTreeFriends::getIndexable(bvh, j))
+                   : KokkosExt::ArithmeticTraits::infinity<DistanceType>::value;
+      }
+      return predicate.distance(
+          HappyTreeFriends::getInternalBoundingVolume(bvh, j));
     };
 
     int node = HappyTreeFriends::getRoot(_bvh);
@@ -446,9 +786,15 @@ struct TreeTraversal<BVH, Predicates, Callback, OrderedSpatialPredicateTag>
     {
       if (HappyTreeFriends::isLeaf(_bvh, node))
       {
-        if (invoke_callback_and_check_early_exit(
-                _callback, predicate, HappyTreeFriends::getValue(_bvh, node)))
-          return;
+        if (HappyTreeFriends::isLive(_bvh, node))
+        {
+          if (invoke_callback_and_check_early_exit(
+                  _callback, predicate, HappyTreeFriends::getValue(_bvh, node)))
+            return;
+
+          if (max_results > 0 && ++num_results >= max_results)
+            return;
+        }
 
         if (heap.empty())
           return;
@@ -0,0 +1,143 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#ifndef ARBORX_DETAILS_TREE_TRAVERSAL_PACKET_HPP
+#define ARBORX_DETAILS_TREE_TRAVERSAL_PACKET_HPP
+
+#include <ArborX_DetailsHappyTreeFriends.hpp>
+#include <ArborX_DetailsNode.hpp> // ROPE_SENTINEL
+#include <ArborX_DetailsTreeTraversal.hpp>
+#include <ArborX_Predicates.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Details
+{
+
+// Packet traversal for spatially coherent queries. A team shares a single
+// rope-based traversal path: an internal node is descended into if any live
+// predicate of the packet intersects it, and leaves are tested by every lane
+// individually. When the predicates are sorted along a space-filling curve
+// (the default TraversalPolicy behavior), neighboring predicates follow
+// nearly identical paths, so sharing the path trades a few extra leaf tests
+// for a several-fold reduction in node fetches.
+template <typename ExecutionSpace, typename BVH, typename Predicates,
+          typename Callback>
+struct TreeTraversalPacket
+{
+  using TeamPolicy = Kokkos::TeamPolicy<ExecutionSpace>;
+  using MemberType = typename TeamPolicy::member_type;
+
+  BVH _bvh;
+  Predicates _predicates;
+  Callback _callback;
+
+  TreeTraversalPacket(ExecutionSpace const &space, BVH const &bvh,
+                      Predicates const &predicates, Callback const &callback)
+      : _bvh{bvh}
+      , _predicates{predicates}
+      , _callback{callback}
+  {
+    // Packets pay off only when there are internal nodes to share; delegate
+    // the degenerate trees to the regular traversal
+    if (_bvh.size() <= 1 || _predicates.size() == 0)
+    {
+      traverse(space, bvh, predicates, callback);
+      return;
+    }
+
+    int const n_queries = _predicates.size();
+
+    TeamPolicy probe(space, 1, Kokkos::AUTO);
+    int const team_size =
+        probe.team_size_recommended(*this, Kokkos::ParallelForTag{});
+    int const n_packets = (n_queries + team_size - 1) / team_size;
+    TeamPolicy policy(space, n_packets, team_size);
+    policy.set_scratch_size(
+        0, Kokkos::PerTeam(team_size * (int)sizeof(int)));
+    Kokkos::parallel_for("ArborX::TreeTraversal::spatial_packet", policy,
+                         *this);
+  }
+
+  KOKKOS_FUNCTION void operator()(MemberType const &member) const
+  {
+    int const team_size = member.team_size();
+    int const packet_begin = member.league_rank() * team_size;
+    int const n_queries = _predicates.size();
+
+    // Per-lane flags marking predicates that exited early as well as the
+    // unused lanes of the last packet. The ranges below span exactly
+    // team_size work items, so every lane only ever reads its own flag.
+    int *done =
+        (int *)member.team_scratch(0).get_shmem(team_size * sizeof(int));
+    Kokkos::parallel_for(
+        Kokkos::TeamThreadRange(member, team_size),
+        [&](int t) { done[t] = (packet_begin + t >= n_queries); });
+
+    int node = HappyTreeFriends::getRoot(_bvh);
+    do
+    {
+      if (HappyTreeFriends::isLeaf(_bvh, node))
+      {
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange(member, team_size), [&](int t) {
+              if (done[t])
+                return;
+              auto const &predicate = _predicates(packet_begin + t);
+              if (HappyTreeFriends::isLive(_bvh, node) &&
+                  predicate(HappyTreeFriends::getIndexable(_bvh, node)) &&
+                  invoke_callback_and_check_early_exit(
+                      _callback, predicate,
+                      HappyTreeFriends::getValue(_bvh, node)))
+                done[t] = 1;
+            });
+        int alive;
+        Kokkos::parallel_reduce(
+            Kokkos::TeamThreadRange(member, team_size),
+            [&](int t, int &update) { update += !done[t]; }, alive);
+        if (alive == 0)
+          break;
+        node = HappyTreeFriends::getRope(_bvh, node);
+      }
+      else
+      {
+        auto const &bounding_volume =
+            HappyTreeFriends::getInternalBoundingVolume(_bvh, node);
+        int hit;
+        Kokkos::parallel_reduce(
+            Kokkos::TeamThreadRange(member, team_size),
+            [&](int t, int &update) {
+              if (!done[t] && _predicates(packet_begin + t)(bounding_volume))
+                update = 1;
+            },
+            hit);
+        node = (hit ? HappyTreeFriends::getLeftChild(_bvh, node)
+                    : HappyTreeFriends::getRope(_bvh, node));
+      }
+    } while (node != ROPE_SENTINEL);
+  }
+};
+
+template <typename ExecutionSpace, typename BVH, typename Predicates,
+          typename Callback>
+void traverseWithPackets(ExecutionSpace const &space, BVH const &bvh,
+                         Predicates const &predicates,
+                         Callback const &callback)
+{
+  using Tag = typename Predicates::value_type::Tag;
+  static_assert(std::is_same_v<Tag, SpatialPredicateTag>,
+                "packet traversal only supports spatial predicates");
+  TreeTraversalPacket<ExecutionSpace, BVH, Predicates, Callback>(
+      space, bvh, predicates, callback);
+}
+
+} // namespace ArborX::Details
+
+#endif
@@ -0,0 +1,224 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#ifndef ARBORX_DETAILS_TREE_TRAVERSAL_WORK_QUEUE_HPP
+#define ARBORX_DETAILS_TREE_TRAVERSAL_WORK_QUEUE_HPP
+
+#include <ArborX_Callbacks.hpp>
+#include <ArborX_DetailsHappyTreeFriends.hpp>
+#include <ArborX_DetailsTreeTraversal.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Details
+{
+
+// Alternative spatial traversal engine for irregular workloads. Instead of
+// assigning one thread per predicate for its entire traversal, work is
+// expressed as (predicate, subtree) items in a global queue. A fixed number
+// of persistent threads repeatedly pop items and traverse the subtree with a
+// bounded local stack; when the local stack fills up, the excess subtrees are
+// pushed back to the global queue where idle threads pick them up. This keeps
+// the device busy when a few expensive predicates dominate, at the cost of
+// extra queue traffic for regular workloads.
+template <typename BVH, typename Predicates, typename Callback>
+struct TreeTraversalWorkQueue
+{
+  using MemorySpace = typename BVH::memory_space;
+  using WorkItem = Kokkos::pair<int, int>; // (predicate index, node)
+
+  BVH _bvh;
+  Predicates _predicates;
+  Callback _callback;
+
+  Kokkos::View<WorkItem *, MemorySpace> _queue;
+  Kokkos::View<int *, MemorySpace> _ready;
+  // 0: pop position, 1: push position, 2: number of unfinished items
+  Kokkos::View<int[3], MemorySpace> _counters;
+  // Set when a callback requested early exit so that queued items of the
+  // same predicate terminate without traversing their subtree.
+  Kokkos::View<bool *, MemorySpace> _done;
+
+  static constexpr int LOCAL_STACK_SIZE = 16;
+
+  template <typename ExecutionSpace>
+  TreeTraversalWorkQueue(ExecutionSpace const &space, BVH const &bvh,
+                         Predicates const &predicates,
+                         Callback const &callback)
+      : _bvh{bvh}
+      , _predicates{predicates}
+      , _callback{callback}
+  {
+    int const n_predicates = predicates.size();
+
+    if (_bvh.empty() || n_predicates == 0)
+    {
+      // do nothing
+      return;
+    }
+
+    if (_bvh.size() == 1)
+    {
+      // Work queue brings nothing here, use the regular engine
+      traverse(space, _bvh, _predicates, _callback);
+      return;
+    }
+
+    // Items that do not fit within the queue capacity are traversed inline,
+    // so running out of capacity costs performance, not correctness.
+    int const capacity = Kokkos::max(4 * n_predicates, 1024);
+    _queue = Kokkos::View<WorkItem *, MemorySpace>(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::TreeTraversal::work_queue::queue"),
+        capacity);
+    _ready = Kokkos::View<int *, MemorySpace>(
+        Kokkos::view_alloc(space,
+                           "ArborX::TreeTraversal::work_queue::ready"),
+        capacity);
+    _counters = Kokkos::View<int[3], MemorySpace>(
+        Kokkos::view_alloc(space,
+                           "ArborX::TreeTraversal::work_queue::counters"));
+    _done = Kokkos::View<bool *, MemorySpace>(
+        Kokkos::view_alloc(space, "ArborX::TreeTraversal::work_queue::done"),
+        n_predicates);
+
+    auto queue = _queue;
+    auto ready = _ready;
+    auto counters = _counters;
+    int const root = HappyTreeFriends::getRoot(_bvh);
+    Kokkos::parallel_for(
+        "ArborX::TreeTraversal::work_queue::seed",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_predicates),
+        KOKKOS_LAMBDA(int i) {
+          queue(i) = {i, root};
+          ready(i) = 1;
+          if (i == 0)
+          {
+            counters(1) = n_predicates;
+            counters(2) = n_predicates;
+          }
+        });
+
+    int const num_threads =
+        Kokkos::min<int>(space.concurrency(), n_predicates);
+    Kokkos::parallel_for(
+        "ArborX::TreeTraversal::work_queue::spatial",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_threads), *this);
+  }
+
+  KOKKOS_FUNCTION void push(WorkItem const &item) const
+  {
+    Kokkos::atomic_inc(&_counters(2));
+    int const pos = Kokkos::atomic_fetch_add(&_counters(1), 1);
+    if (pos < _queue.extent_int(0))
+    {
+      _queue(pos) = item;
+      // Release the item only after it is fully written
+      Kokkos::store_fence();
+      Kokkos::atomic_store(&_ready(pos), 1);
+    }
+    else
+    {
+      // Queue is full, traverse inline
+      processItem(item);
+      Kokkos::atomic_dec(&_counters(2));
+    }
+  }
+
+  KOKKOS_FUNCTION void processItem(WorkItem const &item) const
+  {
+    auto const &predicate = _predicates(item.first);
+
+    if (Kokkos::atomic_load(&_done(item.first)))
+      return;
+
+    int stack[LOCAL_STACK_SIZE];
+    int stack_size = 0;
+    stack[stack_size++] = item.second;
+
+    while (stack_size > 0)
+    {
+      int const node = stack[--stack_size];
+      if (HappyTreeFriends::isLeaf(_bvh, node))
+      {
+        if (HappyTreeFriends::isLive(_bvh, node) &&
+            predicate(HappyTreeFriends::getIndexable(_bvh, node)) &&
+            invoke_callback_and_check_early_exit(
+                _callback, predicate, HappyTreeFriends::getValue(_bvh, node)))
+        {
+          Kokkos::atomic_store(&_done(item.first), true);
+          return;
+        }
+      }
+      else if (predicate(
+                   HappyTreeFriends::getInternalBoundingVolume(_bvh, node)))
+      {
+        int const left_child = HappyTreeFriends::getLeftChild(_bvh, node);
+        int const right_child = HappyTreeFriends::getRightChild(_bvh, node);
+        if (stack_size < LOCAL_STACK_SIZE - 1)
+        {
+          stack[stack_size++] = left_child;
+          stack[stack_size++] = right_child;
+        }
+        else
+        {
+          // Local stack is full, donate one subtree to idle threads
+          stack[stack_size++] = left_child;
+          push({item.first, right_child});
+        }
+      }
+    }
+  }
+
+  KOKKOS_FUNCTION void operator()(int) const
+  {
+    while (true)
+    {
+      int const pop_pos = Kokkos::atomic_load(&_counters(0));
+      int const push_pos =
+          Kokkos::min(Kokkos::atomic_load(&_counters(1)), _queue.extent_int(0));
+      if (pop_pos < push_pos)
+      {
+        if (Kokkos::atomic_compare_exchange(&_counters(0), pop_pos,
+                                            pop_pos + 1) != pop_pos)
+          continue; // another thread got the item
+
+        // Wait for the producer to finish writing the item
+        while (Kokkos::atomic_load(&_ready(pop_pos)) == 0)
+          ;
+        Kokkos::load_fence();
+
+        processItem(_queue(pop_pos));
+        Kokkos::atomic_dec(&_counters(2));
+      }
+      else if (Kokkos::atomic_load(&_counters(2)) == 0)
+      {
+        break; // all items processed, no producers left
+      }
+    }
+  }
+};
+
+template <typename ExecutionSpace, typename BVH, typename Predicates,
+          typename Callback>
+void traverseWithWorkQueue(ExecutionSpace const &space, BVH const &bvh,
+                           Predicates const &predicates,
+                           Callback const &callback)
+{
+  using Tag = typename Predicates::value_type::Tag;
+  static_assert(std::is_same_v<Tag, SpatialPredicateTag>,
+                "work queue traversal only supports spatial predicates");
+  TreeTraversalWorkQueue<BVH, Predicates, Callback>(space, bvh, predicates,
+                                                    callback);
+}
+
+} // namespace ArborX::Details
+
+#endif
@@ -0,0 +1,296 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILS_TREELET_RESTRUCTURING_HPP
+#define ARBORX_DETAILS_TREELET_RESTRUCTURING_HPP
+
+#include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_DetailsNode.hpp>
+#include <ArborX_DetailsTreeConstructionPLOC.hpp> // boundaryMeasure
+#include <ArborX_Exception.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Details::TreeConstruction
+{
+
+// In-place treelet restructuring post-pass (TRBVH-style). Walking bottom-up
+// with the same two-arrivals scheduling as the refit pass, every internal
+// node greedily gathers a treelet of up to seven subtree roots below it and
+// replaces the treelet's topology with the optimal one, found by dynamic
+// programming over the leaf subsets. The pass only rewires child pointers
+// and bounding volumes within each treelet; the ropes are recomputed in one
+// sweep at the end, so the node layout consumed by TreeTraversal is
+// preserved and the query path is untouched.
+//
+// When a non-empty `frequencies` view of per-node visit counts (one counter
+// per node, leaves first, sized 2n - 1) is passed, the optimizer minimizes
+// the visit-weighted boundary measure instead of plain SAH, trading tree
+// quality in regions the recorded queries never reached for tighter
+// topology where they concentrated. The view is updated in place with the
+// estimated frequencies of the rewritten internal nodes, so callers should
+// pass a scratch copy.
+template <typename ExecutionSpace, typename IndexableGetter,
+          typename LeafNodes, typename InternalNodes, typename BoundingVolume,
+          typename Frequencies =
+              Kokkos::View<int *, typename InternalNodes::memory_space>>
+void restructureTreelets(ExecutionSpace const &space,
+                         IndexableGetter const &indexable_getter,
+                         LeafNodes leaf_nodes, InternalNodes internal_nodes,
+                         BoundingVolume &bounds,
+                         Frequencies const &frequencies = Frequencies())
+{
+  using MemorySpace = typename InternalNodes::memory_space;
+
+  constexpr int treelet_size = 7;
+
+  int const n = leaf_nodes.extent_int(0);
+  int const num_internal_nodes = internal_nodes.extent_int(0);
+  ARBORX_ASSERT(num_internal_nodes == n - 1);
+
+  bool const use_frequencies = frequencies.extent(0) > 0;
+  if (use_frequencies)
+    ARBORX_ASSERT(frequencies.extent_int(0) == 2 * n - 1);
+
+  // Parent of every node and explicit right child of every internal node.
+  // The right children are normally implied by the ropes, but the ropes go
+  // stale as soon as a subtree moves, so the topology is kept explicit for
+  // the duration of the pass.
+  Kokkos::View<int *, MemorySpace> parents(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::BVH::restructure::parents"),
+      2 * n - 1);
+  Kokkos::View<int *, MemorySpace> right_children(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::BVH::restructure::right_children"),
+      num_internal_nodes);
+  Kokkos::parallel_for(
+      "ArborX::TreeConstruction::restructure::compute_parents",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_internal_nodes),
+      KOKKOS_LAMBDA(int k) {
+        int const left_child = internal_nodes(k).left_child;
+        int const right_child =
+            (left_child < n ? leaf_nodes(left_child).rope
+                            : internal_nodes(left_child - n).rope);
+        parents(left_child) = n + k;
+        parents(right_child) = n + k;
+        right_children(k) = right_child;
+        if (k == 0)
+          parents(n) = -1;
+      });
+
+  Kokkos::View<int *, MemorySpace> flags(
+      Kokkos::view_alloc(space, "ArborX::BVH::restructure::flags"),
+      num_internal_nodes);
+
+  Kokkos::parallel_for(
+      "ArborX::TreeConstruction::restructure::restructure_treelets",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        auto const leaf_box = [&](int node) {
+          BoundingVolume box{};
+          if (node < n)
+            expand(box, indexable_getter(leaf_nodes(node).value));
+          else
+            box = internal_nodes(node - n).bounding_volume;
+          return box;
+        };
+
+        int node = parents(i) - n;
+        do
+        {
+          // Two-arrivals scheduling: the first thread entering an internal
+          // node terminates, the second one proceeds, so no node is
+          // restructured before both of its subtrees are final
+          if (Kokkos::atomic_fetch_add(&flags(node), 1) == 0)
+            break;
+          Kokkos::load_fence();
+
+          // Greedily grow the treelet below the node, always opening the
+          // subtree root with the largest bounding volume (weighted by the
+          // recorded visit frequency when given one, so the treelet digs
+          // into the hot subtrees where reshaping matters most)
+          int leaves[treelet_size];
+          int internals[treelet_size - 1];
+          int num_leaves = 2;
+          int num_internals = 1;
+          internals[0] = node;
+          leaves[0] = internal_nodes(node).left_child;
+          leaves[1] = right_children(node);
+          while (num_leaves < treelet_size)
+          {
+            int argmax = -1;
+            decltype(boundaryMeasure(BoundingVolume{})) max_measure = 0;
+            for (int l = 0; l < num_leaves; ++l)
+            {
+              if (leaves[l] < n)
+                continue;
+              auto measure = boundaryMeasure(
+                  internal_nodes(leaves[l] - n).bounding_volume);
+              if (use_frequencies)
+                measure *= (decltype(measure))(frequencies(leaves[l]) + 1);
+              if (argmax == -1 || measure > max_measure)
+              {
+                argmax = l;
+                max_measure = measure;
+              }
+            }
+            if (argmax == -1) // all treelet leaves are actual leaves
+              break;
+            int const opened = leaves[argmax] - n;
+            internals[num_internals++] = opened;
+            leaves[argmax] = internal_nodes(opened).left_child;
+            leaves[num_leaves++] = right_children(opened);
+          }
+
+          // Optimal topology over the treelet leaves by dynamic programming
+          // over the leaf subsets, minimizing the total boundary measure of
+          // the internal nodes (surface area heuristic with equal costs).
+          // With frequencies, a subset's measure is weighted by the summed
+          // visit counts of its constituents, approximating the expected
+          // per-query traversal cost under the recorded distribution; the
+          // one extra visit per constituent keeps never-visited subtrees
+          // falling back to the geometric objective.
+          using CostType = decltype(boundaryMeasure(BoundingVolume{}));
+          constexpr int num_subsets = 1 << treelet_size;
+          BoundingVolume subset_box[num_subsets];
+          CostType cost[num_subsets];
+          CostType weight[num_subsets];
+          unsigned char split[num_subsets];
+          int const full = (1 << num_leaves) - 1;
+          for (int s = 1; s <= full; ++s)
+          {
+            int b = 0;
+            while (!((s >> b) & 1))
+              ++b;
+            int const rest = s & (s - 1);
+            subset_box[s] = leaf_box(leaves[b]);
+            if (rest != 0)
+              expand(subset_box[s], subset_box[rest]);
+            if (use_frequencies)
+              weight[s] = (rest == 0
+                               ? (CostType)frequencies(leaves[b]) + 1
+                               : weight[s ^ rest] + weight[rest]);
+
+            if (rest == 0) // singleton
+            {
+              cost[s] = 0;
+              continue;
+            }
+            CostType best = KokkosExt::ArithmeticTraits::infinity<
+                CostType>::value;
+            int best_split = 0;
+            for (int p = (s - 1) & s; p > 0; p = (p - 1) & s)
+            {
+              auto const candidate = cost[p] + cost[s ^ p];
+              if (candidate < best)
+              {
+                best = candidate;
+                best_split = p;
+              }
+            }
+            cost[s] = (use_frequencies ? weight[s] : CostType(1)) *
+                          boundaryMeasure(subset_box[s]) +
+                      best;
+            split[s] = (unsigned char)best_split;
+          }
+
+          // Rewrite the treelet in place, reusing its internal node slots;
+          // the treelet root keeps the node itself, so the linkage above is
+          // untouched
+          int stack_subset[treelet_size + 1];
+          int stack_slot[treelet_size + 1];
+          int stack_size = 0;
+          int next_internal = 1;
+          stack_subset[stack_size] = full;
+          stack_slot[stack_size++] = node;
+          while (stack_size > 0)
+          {
+            --stack_size;
+            int const s = stack_subset[stack_size];
+            int const k = stack_slot[stack_size];
+            int const p = split[s];
+            int const q = s ^ p;
+
+            int children[2];
+            int const sides[2] = {p, q};
+            for (int c = 0; c < 2; ++c)
+            {
+              if ((sides[c] & (sides[c] - 1)) == 0) // singleton
+              {
+                int b = 0;
+                while (!((sides[c] >> b) & 1))
+                  ++b;
+                children[c] = leaves[b];
+              }
+              else
+              {
+                int const slot = internals[next_internal++];
+                children[c] = n + slot;
+                stack_subset[stack_size] = sides[c];
+                stack_slot[stack_size++] = slot;
+              }
+            }
+
+            internal_nodes(k).left_child = children[0];
+            right_children(k) = children[1];
+            internal_nodes(k).bounding_volume = subset_box[s];
+            parents(children[0]) = n + k;
+            parents(children[1]) = n + k;
+            // The slot now roots a different subset, so propagate its
+            // estimated frequency for the treelets above to read
+            if (use_frequencies)
+              frequencies(n + k) =
+                  (typename Frequencies::value_type)weight[s];
+          }
+
+          // Make the writes visible to the thread that will proceed through
+          // the parent
+          Kokkos::store_fence();
+
+          if (node == 0) // root
+            break;
+          node = parents(n + node) - n;
+        } while (true);
+      });
+
+  // The restructured subtrees moved, so reassign every rope from the
+  // explicit topology: a node's rope is the right sibling of its lowest
+  // ancestor (including itself) that is a left child
+  Kokkos::parallel_for(
+      "ArborX::TreeConstruction::restructure::assign_ropes",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, 2 * n - 1),
+      KOKKOS_LAMBDA(int node) {
+        int x = node;
+        int p = parents(x);
+        while (p != -1 && right_children(p - n) == x)
+        {
+          x = p;
+          p = parents(x);
+        }
+        int const rope = (p == -1 ? ROPE_SENTINEL : right_children(p - n));
+        if (node < n)
+          leaf_nodes(node).rope = rope;
+        else
+          internal_nodes(node - n).rope = rope;
+      });
+
+  Kokkos::deep_copy(
+      space,
+      Kokkos::View<BoundingVolume, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>(
+          &bounds),
+      Kokkos::View<BoundingVolume const, MemorySpace, Kokkos::MemoryUnmanaged>(
+          &internal_nodes.data()->bounding_volume));
+}
+
+} // namespace ArborX::Details::TreeConstruction
+
+#endif
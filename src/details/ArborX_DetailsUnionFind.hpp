@@ -64,6 +64,18 @@
 // ```
 //
 // This is encoded in `representative()` function.
+//
+// On host executions, where a handful of hardware threads hammering the same
+// component roots makes the CAS loop over the representatives scale poorly,
+// the merge instead uses the lock-free variant of Rem's algorithm with
+// splicing studied in:
+//
+//   [2] Patwary, Md. Mostofa Ali, Jean Blair, and Fredrik Manne.
+//   "Experiments on union-find algorithms for the disjoint-set data
+//   structure." In International Symposium on Experimental Algorithms,
+//   pp. 411-423. 2010.
+
+#include <ArborX_DetailsKokkosExtSwap.hpp>
 
 #include <Kokkos_Core.hpp>
 
@@ -151,11 +163,11 @@ struct UnionFind
     // until there is no data race on the parent.
     // ```
 
-    int vstat = representative(i);
-    int ostat = representative(j);
-
     if constexpr (DoSerial)
     {
+      int vstat = representative(i);
+      int ostat = representative(j);
+
       if (vstat < ostat)
         _labels(ostat) = vstat;
       else
@@ -163,17 +175,69 @@ struct UnionFind
     }
     else
     {
-      // Note: the code does one extra iteration even when the labels array was
-      // updated. However, it does not show up in any of the performance
-      // studies, and the code is cleaner and more compact.
-      while (vstat != ostat)
+      KOKKOS_IF_ON_DEVICE((mergeEclCas(i, j);))
+      KOKKOS_IF_ON_HOST((mergeRemSplice(i, j);))
+    }
+  }
+
+private:
+  KOKKOS_FUNCTION
+  void mergeEclCas(int i, int j) const
+  {
+    int vstat = representative(i);
+    int ostat = representative(j);
+
+    // Note: the code does one extra iteration even when the labels array was
+    // updated. However, it does not show up in any of the performance
+    // studies, and the code is cleaner and more compact.
+    while (vstat != ostat)
+    {
+      if (vstat < ostat)
+        ostat = Kokkos::atomic_compare_exchange(&_labels(ostat), ostat, vstat);
+      else
+        vstat = Kokkos::atomic_compare_exchange(&_labels(vstat), vstat, ostat);
+    }
+  }
+
+  // Lock-free Rem's algorithm with splicing [2]. Instead of fully resolving
+  // both representatives before linking, walk the two paths in lock step,
+  // always advancing on the side with the larger parent, and splice the
+  // visited elements over to the other side's parent along the way. Threads
+  // merging within an already connected component part ways as soon as their
+  // paths meet at a common parent, so the contended CAS retries on the
+  // component roots that plague the ECL loop on many-core hosts are largely
+  // avoided. As every write replaces a parent with a smaller one, concurrent
+  // updates stay benign for the same reasons as in representative().
+  KOKKOS_FUNCTION
+  void mergeRemSplice(int u, int v) const
+  {
+    while (true)
+    {
+      int u_parent = _labels(u);
+      int v_parent = _labels(v);
+      if (u_parent == v_parent)
+        return;
+
+      // Keep u the side with the larger parent
+      if (u_parent < v_parent)
+      {
+        KokkosExt::swap(u, v);
+        KokkosExt::swap(u_parent, v_parent);
+      }
+
+      if (u_parent == u)
+      {
+        // u is a root: try to hook it under the other side's parent. A lost
+        // race means another thread changed the root, so reload and repeat.
+        if (Kokkos::atomic_compare_exchange(&_labels(u), u, v_parent) == u)
+          return;
+      }
+      else
       {
-        if (vstat < ostat)
-          ostat =
-              Kokkos::atomic_compare_exchange(&_labels(ostat), ostat, vstat);
-        else
-          vstat =
-              Kokkos::atomic_compare_exchange(&_labels(vstat), vstat, ostat);
+        // Splice u over to the smaller parent and continue from its old
+        // parent. A lost race only skips one compression step.
+        Kokkos::atomic_compare_exchange(&_labels(u), u_parent, v_parent);
+        u = u_parent;
       }
     }
   }
@@ -0,0 +1,489 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DISTRIBUTED_MINIMUM_SPANNING_TREE_HPP
+#define ARBORX_DISTRIBUTED_MINIMUM_SPANNING_TREE_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_DetailsDistributor.hpp>
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DistributedTree.hpp>
+#include <ArborX_MinimumSpanningTree.hpp>
+#include <ArborX_PredicateHelpers.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <mpi.h>
+
+namespace ArborX::Details
+{
+
+// Edge of the distributed spanning tree. Endpoints are global point ids
+// (dense numbering by rank, matching the distributed DBSCAN labels).
+struct GlobalWeightedEdge
+{
+  long long source;
+  long long target;
+  float weight;
+};
+
+// Minimum outgoing edge of a rank component, gathered on all ranks during
+// the merge rounds
+struct ComponentProposal
+{
+  long long source;
+  long long target;
+  float weight;
+  int target_rank;
+};
+
+// Distributed Boruvka over points partitioned across ranks. Each rank
+// computes the MST of its local points with the single-memory-space Boruvka,
+// collects candidate inter-partition edges by querying the nearest neighbors
+// of its points through a DistributedTree and keeping the remote ones, and
+// the per-rank trees are then merged by repeatedly selecting each
+// component's cheapest candidate edge and combining components through a
+// union-find replicated on every rank.
+//
+// The result is the exact minimum spanning tree of the subgraph formed by
+// the union of the per-rank trees and the exchanged candidate edges. It
+// coincides with the MST of the full graph whenever every inter-partition
+// MST edge appears among the candidates, which the candidate budget
+// controls. For k > 1 the candidate weights use mutual reachability
+// distances with core distances computed through the distributed tree, and
+// are thus exact; the weights of the local tree edges use locally computed
+// core distances, which may overestimate the global ones for points near a
+// partition boundary.
+//
+// Must be constructed as collective over all processes in the communicator.
+template <class MemorySpace>
+struct DistributedMinimumSpanningTree
+{
+  using memory_space = MemorySpace;
+  static_assert(Kokkos::is_memory_space<MemorySpace>::value);
+
+  // Local slice of the global spanning tree: the edges of the local MST
+  // followed by the inter-partition edges this rank proposed during the
+  // merge. The global tree is the disjoint union of the slices.
+  Kokkos::View<GlobalWeightedEdge *, MemorySpace> edges;
+
+  template <class ExecutionSpace, class Primitives>
+  DistributedMinimumSpanningTree(MPI_Comm comm, ExecutionSpace const &space,
+                                 Primitives const &primitives, int k = 1,
+                                 int num_candidates_per_point = 3)
+      : edges("ArborX::DistributedMST::edges", 0)
+  {
+    std::string prefix = "ArborX::DistributedMST";
+    Kokkos::Profiling::ScopedRegion guard(prefix);
+
+    namespace KokkosExt = ArborX::Details::KokkosExt;
+
+    using Points = Details::AccessValues<Primitives, PrimitivesTag>;
+    using Point = typename Points::value_type;
+    static_assert(GeometryTraits::is_point_v<Point>);
+    static_assert(
+        KokkosExt::is_accessible_from<typename Points::memory_space,
+                                      ExecutionSpace>::value,
+        "Primitives must be accessible from the execution space");
+
+    Points points{primitives}; // NOLINT
+    int const n = points.size();
+
+    ARBORX_ASSERT(k >= 1);
+    ARBORX_ASSERT(num_candidates_per_point >= 1);
+    ARBORX_ASSERT(n >= 2);
+
+    int comm_rank;
+    MPI_Comm_rank(comm, &comm_rank);
+    int comm_size;
+    MPI_Comm_size(comm, &comm_size);
+
+    // Assign global ids to the points using dense numbering by rank
+    Kokkos::View<long long *, MemorySpace> rank_offsets(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                           prefix + "::rank_offsets"),
+        comm_size);
+    auto rank_offsets_host = Kokkos::create_mirror_view(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing), rank_offsets);
+    {
+      long long num_local = n;
+      std::vector<long long> rank_sizes(comm_size);
+      MPI_Allgather(&num_local, sizeof(long long), MPI_BYTE, rank_sizes.data(),
+                    sizeof(long long), MPI_BYTE, comm);
+      long long offset = 0;
+      for (int r = 0; r < comm_size; ++r)
+      {
+        rank_offsets_host(r) = offset;
+        offset += rank_sizes[r];
+      }
+      Kokkos::deep_copy(space, rank_offsets, rank_offsets_host);
+    }
+    long long const gid_begin = rank_offsets_host(comm_rank);
+    long long const gid_end = gid_begin + n;
+
+    // MST of the local points. For a non-empty rank it connects all local
+    // points into a single component, so the components entering the merge
+    // are exactly the ranks.
+    Kokkos::Profiling::pushRegion(prefix + "::local_mst");
+    MinimumSpanningTree<MemorySpace> local_mst(space, primitives, k);
+    Kokkos::Profiling::popRegion();
+
+    // Distributed tree over all points, carrying their global ids
+    Kokkos::Profiling::pushRegion(prefix + "::construction");
+    Kokkos::View<PairValueIndex<Point, long long> *, MemorySpace> tree_values(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           prefix + "::tree_values"),
+        n);
+    Kokkos::parallel_for(
+        prefix + "::fill_tree_values",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int i) { tree_values(i) = {points(i), gid_begin + i}; });
+    DistributedTree<MemorySpace, PairValueIndex<Point, long long>> tree(
+        comm, space, tree_values);
+    Kokkos::Profiling::popRegion();
+
+    // Globally exact core distances for the candidate weights: the k-th
+    // nearest neighbor may live on another rank
+    Kokkos::View<float *, MemorySpace> core_distances(
+        prefix + "::core_distances", 0);
+    if (k > 1)
+    {
+      Kokkos::Profiling::pushRegion(prefix + "::compute_core_distances");
+      Kokkos::resize(Kokkos::view_alloc(space), core_distances, n);
+
+      Kokkos::View<PairValueIndex<Point, long long> *, MemorySpace> neighbors(
+          prefix + "::knn_values", 0);
+      Kokkos::View<int *, MemorySpace> offsets(prefix + "::knn_offsets", 0);
+      tree.query(space, Experimental::make_nearest(points, k), neighbors,
+                 offsets);
+
+      Kokkos::parallel_for(
+          prefix + "::max_knn_distance",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+          KOKKOS_LAMBDA(int i) {
+            using KokkosExt::max;
+            float d = 0.f;
+            for (int j = offsets(i); j < offsets(i + 1); ++j)
+              d = max(d, distance(points(i), neighbors(j).value));
+            core_distances(i) = d;
+          });
+      Kokkos::Profiling::popRegion();
+    }
+
+    // Candidate inter-partition edges: the nearest neighbors of each local
+    // point that are owned by another rank. Interior points find only local
+    // neighbors and contribute no candidates; points near a partition
+    // boundary contribute their cheapest connections to the adjacent ranks.
+    Kokkos::Profiling::pushRegion(prefix + "::candidate_edges");
+
+    Kokkos::View<long long *, MemorySpace> cand_targets(prefix + "::cand_targets",
+                                                        0);
+    Kokkos::View<int *, MemorySpace> cand_target_ranks(
+        prefix + "::cand_target_ranks", 0);
+    Kokkos::View<GlobalWeightedEdge *, MemorySpace> candidates(
+        prefix + "::candidates", 0);
+    {
+      Kokkos::View<PairValueIndex<Point, long long> *, MemorySpace> neighbors(
+          prefix + "::cand_values", 0);
+      Kokkos::View<int *, MemorySpace> offsets(prefix + "::cand_offsets", 0);
+      int const num_neighbors = std::max(k, num_candidates_per_point);
+      tree.query(space, Experimental::make_nearest(points, num_neighbors),
+                 neighbors, offsets);
+
+      // Two passes over the results: count the remote neighbors, then fill
+      // the compacted candidate list
+      int const num_results = neighbors.size();
+      Kokkos::View<int *, MemorySpace> flags(
+          Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                             prefix + "::cand_flags"),
+          num_results + 1);
+      Kokkos::parallel_for(
+          prefix + "::flag_remote_neighbors",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_results + 1),
+          KOKKOS_LAMBDA(int j) {
+            flags(j) =
+                (j < num_results && (neighbors(j).index < gid_begin ||
+                                     neighbors(j).index >= gid_end));
+          });
+      KokkosExt::exclusive_scan(space, flags, flags, 0);
+      int const num_candidates = KokkosExt::lastElement(space, flags);
+
+      KokkosExt::reallocWithoutInitializing(space, cand_targets,
+                                            num_candidates);
+      KokkosExt::reallocWithoutInitializing(space, cand_target_ranks,
+                                            num_candidates);
+      KokkosExt::reallocWithoutInitializing(space, candidates, num_candidates);
+      Kokkos::parallel_for(
+          prefix + "::fill_candidates",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+          KOKKOS_LAMBDA(int i) {
+            using KokkosExt::max;
+            for (int j = offsets(i); j < offsets(i + 1); ++j)
+            {
+              auto const gid = neighbors(j).index;
+              if (gid >= gid_begin && gid < gid_end)
+                continue;
+
+              float weight = distance(points(i), neighbors(j).value);
+              if (core_distances.size() != 0)
+                weight = max(weight, core_distances(i));
+
+              // Owning rank of the target through its global id
+              int lo = 0;
+              int hi = comm_size - 1;
+              while (lo < hi)
+              {
+                int mid = (lo + hi + 1) / 2;
+                if (rank_offsets(mid) <= gid)
+                  lo = mid;
+                else
+                  hi = mid - 1;
+              }
+
+              auto const slot = flags(j);
+              cand_targets(slot) = gid;
+              cand_target_ranks(slot) = lo;
+              candidates(slot) = {gid_begin + i, gid, weight};
+            }
+          });
+    }
+    int const num_candidates = candidates.size();
+
+    // For mutual reachability the candidate weights also need the core
+    // distances of the remote endpoints, fetched from their owners
+    if (k > 1)
+    {
+      Distributor<MemorySpace> to_owners(comm);
+      to_owners.createFromSends(space, cand_target_ranks);
+      int const num_requests = to_owners.getTotalReceiveLength();
+
+      Kokkos::View<long long *, MemorySpace> request_gids(
+          Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                             prefix + "::request_gids"),
+          num_requests);
+      to_owners.doPostsAndWaits(space, cand_targets, request_gids);
+
+      Kokkos::View<float *, MemorySpace> replies(
+          Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                             prefix + "::core_distance_replies"),
+          num_requests);
+      Kokkos::parallel_for(
+          prefix + "::fill_core_distance_replies",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_requests),
+          KOKKOS_LAMBDA(int r) {
+            replies(r) = core_distances(request_gids(r) - gid_begin);
+          });
+
+      // The Distributor sends and receives in the same rank order, so
+      // reversing the plan routes each reply back to the requesting slot
+      Kokkos::View<int *, MemorySpace> request_ranks(
+          Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                             prefix + "::request_ranks"),
+          num_requests);
+      {
+        Kokkos::View<int *, MemorySpace> export_ranks(
+            Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                               prefix + "::export_ranks"),
+            num_candidates);
+        Kokkos::deep_copy(space, export_ranks, comm_rank);
+        to_owners.doPostsAndWaits(space, export_ranks, request_ranks);
+      }
+      Kokkos::View<int *, MemorySpace> request_slots(
+          Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                             prefix + "::request_slots"),
+          num_requests);
+      {
+        Kokkos::View<int *, MemorySpace> export_slots(
+            Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                               prefix + "::export_slots"),
+            num_candidates);
+        KokkosExt::iota(space, export_slots);
+        to_owners.doPostsAndWaits(space, export_slots, request_slots);
+      }
+
+      Distributor<MemorySpace> to_requesters(comm);
+      to_requesters.createFromSends(space, request_ranks);
+      Kokkos::View<float *, MemorySpace> imports(
+          Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                             prefix + "::core_distance_imports"),
+          num_candidates);
+      to_requesters.doPostsAndWaits(space, replies, imports);
+      Kokkos::View<int *, MemorySpace> slot_imports(
+          Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                             prefix + "::slot_imports"),
+          num_candidates);
+      to_requesters.doPostsAndWaits(space, request_slots, slot_imports);
+
+      Kokkos::parallel_for(
+          prefix + "::apply_remote_core_distances",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_candidates),
+          KOKKOS_LAMBDA(int c) {
+            using KokkosExt::max;
+            auto &candidate = candidates(slot_imports(c));
+            candidate.weight = max(candidate.weight, imports(c));
+          });
+    }
+
+    Kokkos::Profiling::popRegion();
+
+    // Merge the per-rank trees. Every round each rank proposes the cheapest
+    // candidate edge leaving its component; the proposals are gathered on
+    // all ranks and applied in the deterministic (weight, endpoints) order
+    // through a replicated union-find over the ranks, so all ranks agree on
+    // the merges without further communication.
+    Kokkos::Profiling::pushRegion(prefix + "::merge");
+
+    std::vector<int> parent(comm_size);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto uf_find = [&parent](int x) {
+      while (parent[x] != x)
+        x = parent[x] = parent[parent[x]];
+      return x;
+    };
+
+    Kokkos::View<int *, MemorySpace> components(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           prefix + "::components"),
+        comm_size);
+    auto components_host = Kokkos::create_mirror_view(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing), components);
+
+    std::vector<GlobalWeightedEdge> accepted;
+    std::vector<ComponentProposal> proposals(comm_size);
+    Kokkos::View<ComponentProposal, MemorySpace> proposal(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           prefix + "::proposal"));
+    auto proposal_host = Kokkos::create_mirror_view(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing), proposal);
+
+    constexpr float inf = KokkosExt::ArithmeticTraits::infinity<float>::value;
+    while (true)
+    {
+      for (int r = 0; r < comm_size; ++r)
+        components_host(r) = uf_find(r);
+      Kokkos::deep_copy(space, components, components_host);
+      int const my_component = components_host(comm_rank);
+
+      // Cheapest candidate edge leaving this rank's component
+      using MinLoc = Kokkos::MinLoc<float, int>;
+      MinLoc::value_type cheapest;
+      Kokkos::parallel_reduce(
+          prefix + "::select_cheapest_candidate",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_candidates),
+          KOKKOS_LAMBDA(int c, MinLoc::value_type &update) {
+            if (components(cand_target_ranks(c)) == my_component)
+              return;
+            if (candidates(c).weight < update.val)
+            {
+              update.val = candidates(c).weight;
+              update.loc = c;
+            }
+          },
+          MinLoc(cheapest));
+
+      if (cheapest.loc >= 0)
+      {
+        int const loc = cheapest.loc;
+        Kokkos::parallel_for(
+            prefix + "::fetch_proposal",
+            Kokkos::RangePolicy<ExecutionSpace>(space, 0, 1),
+            KOKKOS_LAMBDA(int) {
+              proposal() = {candidates(loc).source, candidates(loc).target,
+                            candidates(loc).weight, cand_target_ranks(loc)};
+            });
+        Kokkos::deep_copy(space, proposal_host, proposal);
+        space.fence(prefix + "::fetch_proposal (copy to host)");
+      }
+      else
+      {
+        proposal_host() = {-1, -1, inf, -1};
+      }
+
+      MPI_Allgather(proposal_host.data(), sizeof(ComponentProposal), MPI_BYTE,
+                    proposals.data(), sizeof(ComponentProposal), MPI_BYTE,
+                    comm);
+
+      std::vector<int> order(comm_size);
+      std::iota(order.begin(), order.end(), 0);
+      std::sort(order.begin(), order.end(), [&proposals](int a, int b) {
+        auto const &lhs = proposals[a];
+        auto const &rhs = proposals[b];
+        if (lhs.weight != rhs.weight)
+          return lhs.weight < rhs.weight;
+        return std::minmax(lhs.source, lhs.target) <
+               std::minmax(rhs.source, rhs.target);
+      });
+
+      bool merged = false;
+      for (auto r : order)
+      {
+        auto const &p = proposals[r];
+        if (p.target_rank < 0)
+          continue;
+        int const a = uf_find(r);
+        int const b = uf_find(p.target_rank);
+        if (a == b)
+          continue;
+        parent[a] = b;
+        merged = true;
+        // The proposing rank owns the accepted edge, so the global tree is
+        // the disjoint union of the local slices
+        if (r == comm_rank)
+          accepted.push_back({p.source, p.target, p.weight});
+      }
+      if (!merged)
+        break;
+    }
+
+    Kokkos::Profiling::popRegion();
+
+    // Assemble the local slice: the local MST edges converted to global
+    // ids, followed by the accepted inter-partition edges
+    int const num_local_edges = local_mst.edges.size();
+    int const num_accepted = accepted.size();
+    KokkosExt::reallocWithoutInitializing(space, edges,
+                                          num_local_edges + num_accepted);
+    auto local_edges = local_mst.edges;
+    auto self = edges;
+    Kokkos::parallel_for(
+        prefix + "::globalize_local_edges",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_local_edges),
+        KOKKOS_LAMBDA(int e) {
+          auto const &edge = local_edges(e);
+          self(e) = {gid_begin + edge.source, gid_begin + edge.target,
+                     edge.weight};
+        });
+    if (num_accepted > 0)
+    {
+      auto accepted_device = Kokkos::create_mirror_view_and_copy(
+          MemorySpace{},
+          Kokkos::View<GlobalWeightedEdge *, Kokkos::HostSpace,
+                       Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
+              accepted.data(), num_accepted));
+      Kokkos::deep_copy(
+          space,
+          Kokkos::subview(edges,
+                          std::make_pair(num_local_edges,
+                                         num_local_edges + num_accepted)),
+          accepted_device);
+    }
+  }
+};
+
+} // namespace ArborX::Details
+
+#endif
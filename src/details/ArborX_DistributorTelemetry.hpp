@@ -0,0 +1,193 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#ifndef ARBORX_DISTRIBUTOR_TELEMETRY_HPP
+#define ARBORX_DISTRIBUTOR_TELEMETRY_HPP
+
+#include <ostream>
+#include <vector>
+
+namespace ArborX::Experimental
+{
+
+// Per-query record of the MPI exchanges performed by the distributors of a
+// distributed tree. Attaching an instance to a tree (see
+// DistributedTreeBase::attachDistributorTelemetry()) makes every query
+// overwrite it with one entry per exchange, listing the off-rank
+// destinations and sources with the respective message sizes and the time
+// spent waiting on the messages. This attributes a slow query to message
+// count, message volume, or imbalance across neighbors without rerunning
+// under an external tracer. Same-rank transfers never touch the network and
+// are not recorded. Recording fills a few host vectors per exchange; the
+// exchanges themselves are not synchronized any differently, so the timings
+// are the ones production runs see.
+struct DistributorTelemetry
+{
+  // One doPostsAndWaits() call; a query typically performs several (e.g.
+  // forwarding the predicates and communicating the results back)
+  struct Exchange
+  {
+    std::vector<int> destinations;
+    std::vector<long long> bytes_sent; // per destination
+    std::vector<int> sources;
+    std::vector<long long> bytes_received; // per source
+    // Time in seconds spent waiting for the messages to complete
+    double wait_time = 0.;
+  };
+
+  std::vector<Exchange> exchanges;
+  // Accumulated time in seconds spent waiting on the message-count
+  // exchanges that establish the receive-side layout of a new plan; zero
+  // when cached plans are reused
+  double count_wait_time = 0.;
+
+  // Discard the records of the previous query; called at the beginning of
+  // every query of the tree the telemetry is attached to
+  void beginQuery()
+  {
+    exchanges.clear();
+    count_wait_time = 0.;
+  }
+
+  int numMessagesSent() const
+  {
+    int n = 0;
+    for (auto const &exchange : exchanges)
+      n += exchange.destinations.size();
+    return n;
+  }
+
+  int numMessagesReceived() const
+  {
+    int n = 0;
+    for (auto const &exchange : exchanges)
+      n += exchange.sources.size();
+    return n;
+  }
+
+  long long totalBytesSent() const
+  {
+    long long total = 0;
+    for (auto const &exchange : exchanges)
+      for (auto bytes : exchange.bytes_sent)
+        total += bytes;
+    return total;
+  }
+
+  long long totalBytesReceived() const
+  {
+    long long total = 0;
+    for (auto const &exchange : exchanges)
+      for (auto bytes : exchange.bytes_received)
+        total += bytes;
+    return total;
+  }
+
+  double totalWaitTime() const
+  {
+    double total = count_wait_time;
+    for (auto const &exchange : exchanges)
+      total += exchange.wait_time;
+    return total;
+  }
+
+  // Print a host-side summary of the recorded exchanges
+  void report(std::ostream &os) const
+  {
+    long long max_sent = 0;
+    int max_sent_rank = -1;
+    long long max_received = 0;
+    int max_received_rank = -1;
+    double max_wait = 0.;
+    int max_wait_exchange = -1;
+    for (int e = 0; e < (int)exchanges.size(); ++e)
+    {
+      auto const &exchange = exchanges[e];
+      for (int i = 0; i < (int)exchange.destinations.size(); ++i)
+        if (exchange.bytes_sent[i] > max_sent)
+        {
+          max_sent = exchange.bytes_sent[i];
+          max_sent_rank = exchange.destinations[i];
+        }
+      for (int i = 0; i < (int)exchange.sources.size(); ++i)
+        if (exchange.bytes_received[i] > max_received)
+        {
+          max_received = exchange.bytes_received[i];
+          max_received_rank = exchange.sources[i];
+        }
+      if (exchange.wait_time > max_wait)
+      {
+        max_wait = exchange.wait_time;
+        max_wait_exchange = e;
+      }
+    }
+
+    os << "ArborX distributor telemetry over " << exchanges.size()
+       << " exchanges\n";
+    os << "  messages: sent " << numMessagesSent() << ", received "
+       << numMessagesReceived() << '\n';
+    os << "  bytes sent: total " << totalBytesSent() << ", max " << max_sent;
+    if (max_sent_rank >= 0)
+      os << " (to rank " << max_sent_rank << ")";
+    os << '\n';
+    os << "  bytes received: total " << totalBytesReceived() << ", max "
+       << max_received;
+    if (max_received_rank >= 0)
+      os << " (from rank " << max_received_rank << ")";
+    os << '\n';
+    os << "  wait time: total " << totalWaitTime() << " s, max " << max_wait
+       << " s";
+    if (max_wait_exchange >= 0)
+      os << " (exchange " << max_wait_exchange << ")";
+    os << '\n';
+    os << "  count-exchange wait time: " << count_wait_time << " s\n";
+  }
+};
+
+} // namespace ArborX::Experimental
+
+namespace ArborX::Details
+{
+
+// The distributors recording into the telemetry live deep inside the query
+// implementation and, with plan caching enabled, across queries, so the sink
+// is installed for the duration of a query instead of being threaded through
+// every exchange call site. Queries are collective and never nested, and
+// queryAsync() runs the whole query on its helper thread, so a thread-local
+// slot is safe.
+inline Experimental::DistributorTelemetry *&currentDistributorTelemetry()
+{
+  thread_local Experimental::DistributorTelemetry *telemetry = nullptr;
+  return telemetry;
+}
+
+class ScopedDistributorTelemetry
+{
+public:
+  explicit ScopedDistributorTelemetry(
+      Experimental::DistributorTelemetry *telemetry)
+      : _previous(currentDistributorTelemetry())
+  {
+    currentDistributorTelemetry() = telemetry;
+  }
+
+  ~ScopedDistributorTelemetry() { currentDistributorTelemetry() = _previous; }
+
+  ScopedDistributorTelemetry(ScopedDistributorTelemetry const &) = delete;
+  ScopedDistributorTelemetry &
+  operator=(ScopedDistributorTelemetry const &) = delete;
+
+private:
+  Experimental::DistributorTelemetry *_previous;
+};
+
+} // namespace ArborX::Details
+
+#endif
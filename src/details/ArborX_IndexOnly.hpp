@@ -0,0 +1,80 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#ifndef ARBORX_DETAILS_INDEX_ONLY_HPP
+#define ARBORX_DETAILS_INDEX_ONLY_HPP
+
+#include <ArborX_AccessTraits.hpp>
+
+namespace ArborX
+{
+
+namespace Experimental
+{
+
+// Compact value mode. With attach_indices() the leaves store a full copy of
+// the user's value next to the index; for memory-constrained trees over
+// large primitive sets the copy is pure overhead. index_only() makes the
+// tree values bare 32-bit indices into the user's original view, and
+// IndexedIndexableGetter fetches the indexable through that view whenever
+// the construction or the traversal needs the geometry. Callbacks then
+// receive the index as the value. The user's view must stay alive and
+// unmodified for the lifetime of the tree (a refit after modifying it is
+// the same contract as any indexable getter referencing user storage).
+template <typename Values, typename Index>
+struct IndexOnly
+{
+  Values _values;
+};
+
+template <typename Index = unsigned, typename Values = void>
+auto index_only(Values const &values)
+{
+  static_assert(sizeof(Index) <= sizeof(unsigned),
+                "index_only is meant for compact 32-bit indices");
+  return IndexOnly<Values, Index>{values};
+}
+
+template <typename Values>
+struct IndexedIndexableGetter
+{
+  Values _values;
+
+  template <typename Index, typename Enable = std::enable_if_t<
+                                std::is_integral_v<Index>>>
+  KOKKOS_FUNCTION decltype(auto) operator()(Index i) const
+  {
+    return _values(i);
+  }
+};
+
+} // namespace Experimental
+
+} // namespace ArborX
+
+template <typename Values, typename Index>
+struct ArborX::AccessTraits<ArborX::Experimental::IndexOnly<Values, Index>,
+                            ArborX::PrimitivesTag>
+{
+private:
+  using Self = ArborX::Experimental::IndexOnly<Values, Index>;
+  using Access = AccessTraits<Values, ArborX::PrimitivesTag>;
+
+public:
+  using memory_space = typename Access::memory_space;
+
+  KOKKOS_FUNCTION static auto size(Self const &self)
+  {
+    return Access::size(self._values);
+  }
+  KOKKOS_FUNCTION static auto get(Self const &, int i) { return Index(i); }
+};
+
+#endif
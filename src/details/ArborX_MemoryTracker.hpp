@@ -0,0 +1,220 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_MEMORY_TRACKER_HPP
+#define ARBORX_MEMORY_TRACKER_HPP
+
+#include <Kokkos_Core.hpp>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ArborX
+{
+
+namespace Experimental
+{
+
+// Memory usage of a single phase: the bytes allocated in the phase that are
+// still live, the maximum that value ever reached, and the number of
+// allocations charged to the phase
+struct MemoryUsage
+{
+  std::uint64_t current_bytes = 0;
+  std::uint64_t peak_bytes = 0;
+  std::uint64_t num_allocations = 0;
+};
+
+// Opt-in allocation tracker reporting per-phase peak memory. Between start()
+// and stop() every Kokkos::View allocation is charged to the innermost
+// profiling region active at the time (the internal kernels already delimit
+// their phases with "ArborX::..." regions, so construction, the batched
+// query steps, the CRS graph assembly, and the Boruvka rounds show up
+// without instrumenting the individual allocation sites), or to the
+// allocation label when no region is active. Deallocations are credited to
+// the phase that allocated the data, so a phase's peak reflects the memory
+// it holds across later phases as well.
+//
+// The tracker installs the Kokkos profiling callbacks and therefore cannot
+// be combined with an externally loaded profiling tool. Tracking is
+// process-wide and guarded by a mutex; the overhead is per allocation, not
+// per kernel, so production runs can afford it.
+class MemoryTracker
+{
+  struct State
+  {
+    std::mutex mutex;
+    bool active = false;
+    std::vector<std::string> region_stack;
+    // Live allocations with their size and the phase they were charged to
+    std::unordered_map<void const *, std::pair<std::uint64_t, std::string>>
+        live;
+    std::map<std::string, MemoryUsage> phases;
+    std::uint64_t current_total_bytes = 0;
+    std::uint64_t peak_total_bytes = 0;
+    std::string peak_phase;
+  };
+
+  static State &state()
+  {
+    static State s;
+    return s;
+  }
+
+  static void allocateCallback(Kokkos::Tools::SpaceHandle /*handle*/,
+                               char const *label, void const *ptr,
+                               std::uint64_t size)
+  {
+    auto &s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    std::string phase =
+        (!s.region_stack.empty() ? s.region_stack.back() : std::string(label));
+    auto &usage = s.phases[phase];
+    usage.current_bytes += size;
+    usage.peak_bytes = std::max(usage.peak_bytes, usage.current_bytes);
+    ++usage.num_allocations;
+    s.live[ptr] = {size, std::move(phase)};
+
+    s.current_total_bytes += size;
+    if (s.current_total_bytes > s.peak_total_bytes)
+    {
+      s.peak_total_bytes = s.current_total_bytes;
+      s.peak_phase =
+          (!s.region_stack.empty() ? s.region_stack.back() : std::string(label));
+    }
+  }
+
+  static void deallocateCallback(Kokkos::Tools::SpaceHandle /*handle*/,
+                                 char const * /*label*/, void const *ptr,
+                                 std::uint64_t /*size*/)
+  {
+    auto &s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    auto it = s.live.find(ptr);
+    if (it == s.live.end())
+      return; // allocated before start()
+    auto const size = it->second.first;
+    s.phases[it->second.second].current_bytes -= size;
+    s.current_total_bytes -= size;
+    s.live.erase(it);
+  }
+
+  static void pushRegionCallback(char const *name)
+  {
+    auto &s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.region_stack.emplace_back(name);
+  }
+
+  static void popRegionCallback()
+  {
+    auto &s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (!s.region_stack.empty())
+      s.region_stack.pop_back();
+  }
+
+public:
+  // Install the profiling callbacks and start charging allocations
+  static void start()
+  {
+    auto &s = state();
+    {
+      std::lock_guard<std::mutex> lock(s.mutex);
+      if (s.active)
+        return;
+      s.active = true;
+    }
+    namespace KTE = Kokkos::Tools::Experimental;
+    KTE::set_allocate_data_callback(allocateCallback);
+    KTE::set_deallocate_data_callback(deallocateCallback);
+    KTE::set_push_region_callback(pushRegionCallback);
+    KTE::set_pop_region_callback(popRegionCallback);
+  }
+
+  // Uninstall the callbacks. The accumulated usage remains available until
+  // reset().
+  static void stop()
+  {
+    auto &s = state();
+    {
+      std::lock_guard<std::mutex> lock(s.mutex);
+      if (!s.active)
+        return;
+      s.active = false;
+    }
+    namespace KTE = Kokkos::Tools::Experimental;
+    KTE::set_allocate_data_callback(nullptr);
+    KTE::set_deallocate_data_callback(nullptr);
+    KTE::set_push_region_callback(nullptr);
+    KTE::set_pop_region_callback(nullptr);
+  }
+
+  static void reset()
+  {
+    auto &s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.live.clear();
+    s.phases.clear();
+    s.region_stack.clear();
+    s.current_total_bytes = 0;
+    s.peak_total_bytes = 0;
+    s.peak_phase.clear();
+  }
+
+  // Peak of the total live bytes over the tracked interval
+  static std::uint64_t peakTotalBytes()
+  {
+    auto &s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.peak_total_bytes;
+  }
+
+  static std::map<std::string, MemoryUsage> phases()
+  {
+    auto &s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.phases;
+  }
+
+  // Print a host-side summary of the per-phase peaks
+  static void report(std::ostream &os)
+  {
+    auto &s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    auto to_mib = [](std::uint64_t bytes) {
+      return (double)bytes / (1024. * 1024.);
+    };
+
+    os << "memory high-water mark: " << to_mib(s.peak_total_bytes) << " MiB";
+    if (!s.peak_phase.empty())
+      os << " (reached in \"" << s.peak_phase << "\")";
+    os << '\n';
+    for (auto const &[phase, usage] : s.phases)
+      os << "  " << phase << ": peak " << to_mib(usage.peak_bytes)
+         << " MiB in " << usage.num_allocations << " allocations, "
+         << to_mib(usage.current_bytes) << " MiB still live\n";
+  }
+};
+
+} // namespace Experimental
+
+} // namespace ArborX
+
+#endif
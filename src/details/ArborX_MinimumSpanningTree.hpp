@@ -13,12 +13,14 @@
 #define ARBORX_MINIMUM_SPANNING_TREE_HPP
 
 #include <ArborX_AccessTraits.hpp>
+#include <ArborX_DetailsHappyTreeFriends.hpp>
 #include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
 #include <ArborX_DetailsKokkosExtViewHelpers.hpp>
 #include <ArborX_DetailsMinimumSpanningTree.hpp>
 #include <ArborX_DetailsMutualReachabilityDistance.hpp>
 #include <ArborX_DetailsTreeNodeLabeling.hpp>
 #include <ArborX_DetailsWeightedEdge.hpp>
+#include <ArborX_Exception.hpp>
 #include <ArborX_LinearBVH.hpp>
 #include <ArborX_PredicateHelpers.hpp>
 
@@ -38,9 +40,14 @@ struct MinimumSpanningTree
   Kokkos::View<int *, MemorySpace> dendrogram_parents;
   Kokkos::View<float *, MemorySpace> dendrogram_parent_heights;
 
+  // epsilon is the quality knob of the approximate mode: traversals accept
+  // the current candidate edge once no other candidate could be shorter by
+  // more than a factor of 1 + epsilon, so every produced edge is within that
+  // factor of the exact Boruvka choice of its round. Zero (the default)
+  // computes the exact minimum spanning tree.
   template <class ExecutionSpace, class Primitives>
   MinimumSpanningTree(ExecutionSpace const &space, Primitives const &primitives,
-                      int k = 1)
+                      int k = 1, float epsilon = 0.f)
       : edges(Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
                                  "ArborX::MST::edges"),
               AccessTraits<Primitives, PrimitivesTag>::size(primitives) - 1)
@@ -49,6 +56,12 @@ struct MinimumSpanningTree
   {
     Kokkos::Profiling::pushRegion("ArborX::MST::MST");
 
+    ARBORX_ASSERT(epsilon >= 0);
+    // The hybrid Boruvka+dendrogram relies on every merge being realized by a
+    // reciprocated shortest edge when mapping edges onto dendrogram chains,
+    // which approximate edge choices do not guarantee
+    ARBORX_ASSERT(Mode == BoruvkaMode::MST || epsilon == 0);
+
     using Points = Details::AccessValues<Primitives, PrimitivesTag>;
     using Point = typename Points::value_type;
     static_assert(GeometryTraits::is_point_v<Point>);
@@ -77,13 +90,13 @@ struct MinimumSpanningTree
       MutualReachability<decltype(core_distances)> mutual_reachability{
           core_distances};
       Kokkos::Profiling::pushRegion("ArborX::MST::boruvka");
-      doBoruvka(space, bvh, mutual_reachability);
+      doBoruvka(space, bvh, mutual_reachability, epsilon, core_distances);
       Kokkos::Profiling::popRegion();
     }
     else
     {
       Kokkos::Profiling::pushRegion("ArborX::MST::boruvka");
-      doBoruvka(space, bvh, Euclidean{});
+      doBoruvka(space, bvh, Euclidean{}, epsilon);
       Kokkos::Profiling::popRegion();
     }
 
@@ -99,7 +112,8 @@ private:
 #endif
   template <class ExecutionSpace, class BVH, class Metric>
   void doBoruvka(ExecutionSpace const &space, BVH const &bvh,
-                 Metric const &metric)
+                 Metric const &metric, float epsilon,
+                 Kokkos::View<float *, MemorySpace> const &core_distances = {})
   {
     namespace KokkosExt = ArborX::Details::KokkosExt;
 
@@ -134,15 +148,32 @@ private:
                            "ArborX::MST::radii"),
         n);
 
-    Kokkos::View<float *, MemorySpace> lower_bounds("ArborX::MST::lower_bounds",
-                                                    0);
+    // Lower bounds are maintained on all backends: in addition to pruning
+    // individual traversals in Serial, they drive the compaction of the
+    // points processed in later rounds.
+    Kokkos::View<float *, MemorySpace> lower_bounds(
+        Kokkos::view_alloc(space, "ArborX::MST::lower_bounds"), n);
+
+    // Every mutual reachability edge through a point weighs at least the
+    // point's core distance, regardless of the round. Seeding the lower
+    // bounds with the core distances recycles the result of the k-NN phase
+    // to prune traversals starting from the very first sweep.
+    bool const bounds_seeded = (core_distances.size() != 0);
+    if (bounds_seeded)
+    {
+      Kokkos::parallel_for(
+          "ArborX::MST::initialize_lower_bounds",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+          KOKKOS_LAMBDA(int i) {
+            lower_bounds(i) =
+                core_distances(HappyTreeFriends::getValue(bvh, i).index);
+          });
+    }
 
-    constexpr bool use_lower_bounds =
-#ifdef KOKKOS_ENABLE_SERIAL
-        std::is_same<ExecutionSpace, Kokkos::Serial>::value;
-#else
-        false;
-#endif
+    Kokkos::View<int *, MemorySpace> active_points(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::MST::active_points"),
+        n);
 
     // Shared radii may or may not be faster for CUDA depending on the problem.
     // In the ICPP'51 paper experiments, we ended up using it only in Serial.
@@ -155,12 +186,6 @@ private:
         false;
 #endif
 
-    if constexpr (use_lower_bounds)
-    {
-      KokkosExt::reallocWithoutInitializing(space, lower_bounds, n);
-      Kokkos::deep_copy(space, lower_bounds, 0);
-    }
-
     Kokkos::Profiling::pushRegion("ArborX::MST::Boruvka_loop");
     Kokkos::View<int, MemorySpace> num_edges(
         Kokkos::view_alloc(space, "ArborX::MST::num_edges")); // initialize to 0
@@ -185,7 +210,7 @@ private:
     [[maybe_unused]] int edges_end = 0;
     do
     {
-      Kokkos::Profiling::pushRegion("ArborX::Boruvka_" +
+      Kokkos::Profiling::pushRegion("ArborX::MST::Boruvka_" +
                                     std::to_string(++iterations) + "_" +
                                     std::to_string(num_components));
 
@@ -199,19 +224,27 @@ private:
       Kokkos::deep_copy(space, radii, inf);
       resetSharedRadii(space, bvh, labels, metric, radii);
 
+      // Compact the points that may still improve their component's shortest
+      // outgoing edge so that late rounds do not pay full-n traversal time.
+      // In the first round this only excludes anything when the lower bounds
+      // were seeded with the core distances.
+      int num_active = static_cast<int>(n);
+      if (iterations > 1 || bounds_seeded)
+        num_active = compactActivePoints(space, labels, radii, lower_bounds,
+                                         active_points);
+
       FindComponentNearestNeighbors(
           space, bvh, labels, weights, component_out_edges, metric, radii,
-          lower_bounds, std::bool_constant<use_shared_radii>());
+          lower_bounds, active_points, num_active, epsilon,
+          std::bool_constant<use_shared_radii>());
       retrieveEdges(space, labels, weights, component_out_edges);
-      if constexpr (use_lower_bounds)
-      {
-        updateLowerBounds(space, labels, component_out_edges, lower_bounds);
-      }
+      updateLowerBounds(space, labels, component_out_edges, lower_bounds);
 
       UpdateComponentsAndEdges<decltype(labels), decltype(component_out_edges),
                                decltype(edges), decltype(edges_mapping),
                                decltype(num_edges), Mode>
-          f{labels, component_out_edges, edges, edges_mapping, num_edges};
+          f{labels,        component_out_edges, edges,
+            edges_mapping, num_edges,           epsilon > 0};
 
       // For every component C and a found shortest edge `(u, w)`, add the
       // edge to the list of MST edges.
@@ -261,6 +294,7 @@ private:
 
     // Deallocate some memory to reduce high water mark
     Kokkos::resize(edges_mapping, 0);
+    Kokkos::resize(active_points, 0);
     Kokkos::resize(lower_bounds, 0);
     Kokkos::resize(radii, 0);
     Kokkos::resize(labels, 0);
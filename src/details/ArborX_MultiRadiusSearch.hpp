@@ -0,0 +1,181 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_MULTI_RADIUS_SEARCH_HPP
+#define ARBORX_MULTI_RADIUS_SEARCH_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtAccessibilityTraits.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_Exception.hpp>
+#include <ArborX_GeometryTraits.hpp>
+#include <ArborX_HyperSphere.hpp>
+#include <ArborX_Predicates.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <vector>
+
+namespace ArborX::Experimental
+{
+
+// Bin a match by the finest radius enclosing it. The radii are sorted in
+// increasing order and the traversal is pruned at the largest one, so the
+// linear scan over the few radii is negligible next to the distance
+// computation.
+template <class Points, class MemorySpace>
+struct MultiRadiusCountCallback
+{
+  Kokkos::View<float *, MemorySpace> _radii;
+  Kokkos::View<int *, MemorySpace> _counts;
+  Points _points;
+
+  template <typename Predicate, typename Value>
+  KOKKOS_FUNCTION int findBin(Predicate const &predicate,
+                              Value const &value) const
+  {
+    using Details::distance;
+    auto const d = distance(_points(getData(predicate)), value.value);
+    int const num_radii = _radii.extent(0);
+    int bin = 0;
+    while (bin + 1 < num_radii && _radii(bin) < d)
+      ++bin;
+    return bin;
+  }
+
+  template <typename Predicate, typename Value>
+  KOKKOS_FUNCTION void operator()(Predicate const &predicate,
+                                  Value const &value) const
+  {
+    int const num_radii = _radii.extent(0);
+    Kokkos::atomic_increment(&_counts(
+        getData(predicate) * (size_t)num_radii + findBin(predicate, value)));
+  }
+};
+
+template <class Points, class MemorySpace>
+struct MultiRadiusFillCallback : MultiRadiusCountCallback<Points, MemorySpace>
+{
+  Kokkos::View<int *, MemorySpace> _indices;
+
+  template <typename Predicate, typename Value>
+  KOKKOS_FUNCTION void operator()(Predicate const &predicate,
+                                  Value const &value) const
+  {
+    int const num_radii = this->_radii.extent(0);
+    _indices(Kokkos::atomic_fetch_inc(
+        &this->_counts(getData(predicate) * (size_t)num_radii +
+                       this->findBin(predicate, value)))) = value.index;
+  }
+};
+
+// Multi-scale radius search: query every point at several nested radii with a
+// single traversal pruned at the largest one. Each match is binned by the
+// finest radius enclosing it, so the neighbors of query i whose distance
+// falls within (radii[l-1], radii[l]] are
+//   indices(offsets(i * num_radii + l), offsets(i * num_radii + l + 1))
+// and the full result at radius l is the union of a query's segments
+// 0 through l. Compared to one query() call per radius, which re-traverses
+// the upper tree every time, the shared traversal costs little more than the
+// largest single radius.
+//
+// The tree values must be index-carrying (e.g. built from
+// Experimental::attach_indices); the stored indices are what the output
+// refers to.
+template <class ExecutionSpace, class Tree, class Queries, class Offsets,
+          class Indices>
+void multiRadiusQuery(ExecutionSpace const &space, Tree const &tree,
+                      Queries const &queries, std::vector<float> const &radii,
+                      Offsets &offsets, Indices &indices)
+{
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::Experimental::MultiRadiusQuery");
+
+  namespace KokkosExt = ArborX::Details::KokkosExt;
+
+  using Points = Details::AccessValues<Queries, PrimitivesTag>;
+  using MemorySpace = typename Tree::memory_space;
+  static_assert(
+      KokkosExt::is_accessible_from<MemorySpace, ExecutionSpace>::value);
+  static_assert(
+      KokkosExt::is_accessible_from<typename Points::memory_space,
+                                    ExecutionSpace>::value,
+      "Queries must be accessible from the execution space");
+
+  using Point = std::decay_t<typename Points::value_type>;
+  static_assert(GeometryTraits::is_point_v<Point>);
+  constexpr int dim = GeometryTraits::dimension_v<Point>;
+  using Coordinate = typename GeometryTraits::coordinate_type_t<Point>;
+
+  int const num_radii = radii.size();
+  ARBORX_ASSERT(num_radii >= 1);
+  for (int l = 0; l < num_radii; ++l)
+    ARBORX_ASSERT(radii[l] > 0 && (l == 0 || radii[l] > radii[l - 1]));
+
+  Points points{queries}; // NOLINT
+  int const n = points.size();
+
+  Kokkos::View<float *, MemorySpace> device_radii(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::Experimental::MultiRadiusQuery::radii"),
+      num_radii);
+  Kokkos::deep_copy(space, device_radii,
+                    Kokkos::View<float const *, Kokkos::HostSpace,
+                                 Kokkos::MemoryTraits<Kokkos::Unmanaged>>{
+                        radii.data(), radii.size()});
+
+  using Predicate = decltype(attach(
+      intersects(ExperimentalHyperGeometry::Sphere<dim, Coordinate>{}), int{}));
+  Kokkos::View<Predicate *, MemorySpace> predicates(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::Experimental::MultiRadiusQuery::predicates"),
+      n);
+  float const r_max = radii.back();
+  Kokkos::parallel_for(
+      "ArborX::Experimental::MultiRadiusQuery::setup_predicates",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        auto const &hyper_point = reinterpret_cast<
+            ExperimentalHyperGeometry::Point<dim, Coordinate> const &>(
+            points(i));
+        predicates(i) = attach(
+            intersects(ExperimentalHyperGeometry::Sphere<dim, Coordinate>{
+                hyper_point, r_max}),
+            i);
+      });
+
+  KokkosExt::reallocWithoutInitializing(space, offsets,
+                                        (size_t)n * num_radii + 1);
+  Kokkos::deep_copy(space, offsets, 0);
+  tree.query(space, predicates,
+             MultiRadiusCountCallback<decltype(points), MemorySpace>{
+                 device_radii,
+                 Kokkos::subview(offsets,
+                                 std::make_pair((size_t)0, (size_t)n * num_radii)),
+                 points});
+  KokkosExt::exclusive_scan(space, offsets, offsets, 0);
+  KokkosExt::reallocWithoutInitializing(space, indices,
+                                        KokkosExt::lastElement(space, offsets));
+
+  auto counts = KokkosExt::clone(
+      space,
+      Kokkos::subview(offsets, std::make_pair((size_t)0, (size_t)n * num_radii)),
+      "ArborX::Experimental::MultiRadiusQuery::counts");
+  tree.query(space, predicates,
+             MultiRadiusFillCallback<decltype(points), MemorySpace>{
+                 {device_radii, counts, points}, indices});
+}
+
+} // namespace ArborX::Experimental
+
+#endif
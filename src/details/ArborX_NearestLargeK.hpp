@@ -0,0 +1,307 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_NEAREST_LARGE_K_HPP
+#define ARBORX_NEAREST_LARGE_K_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_CrsGraphWrapper.hpp> // query_counts
+#include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_DetailsHeap.hpp>
+#include <ArborX_DetailsKokkosExtAccessibilityTraits.hpp>
+#include <ArborX_DetailsKokkosExtKernelStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DetailsOperatorFunctionObjects.hpp>
+#include <ArborX_DetailsPermutedData.hpp> // SubsetData
+#include <ArborX_GeometryTraits.hpp>
+#include <ArborX_HyperSphere.hpp>
+#include <ArborX_Predicates.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+namespace ArborX::Experimental
+{
+
+template <class Value>
+struct LargeKNearestPair
+{
+  Value value;
+  float distance;
+
+  friend KOKKOS_FUNCTION bool operator<(LargeKNearestPair const &lhs,
+                                        LargeKNearestPair const &rhs)
+  {
+    return lhs.distance < rhs.distance;
+  }
+};
+
+// Emit every candidate together with its distance to the query it came from,
+// so that the selection pass never has to recompute geometry
+template <class Tree, class Predicates>
+struct LargeKNearestGatherCallback
+{
+  Tree _tree;
+  Predicates _predicates;
+
+  template <typename Predicate, typename Value, typename Output>
+  KOKKOS_FUNCTION void operator()(Predicate const &predicate,
+                                  Value const &value, Output const &out) const
+  {
+    auto const q = getData(predicate);
+    out(LargeKNearestPair<Value>{
+        value, _predicates(q).distance(_tree.indexable_get()(value))});
+  }
+};
+
+// Two-phase nearest search for large k (hundreds and up), where the
+// heap-based traversal spends most of its time on the O(log k) heap update
+// every candidate pays. Phase one estimates a per-query radius expected to
+// hold the k nearest values: a geometric seed assuming an even spread over
+// the scene is verified with count-only queries and doubled until at least
+// k candidates fall inside. Phase two gathers the candidates of every query
+// with one spatial traversal and selects its k closest with a heap-free
+// partial selection (quickselect plus a heapsort of just the k survivors).
+// The counts are box-conservative, so a query can still come up short of k
+// true neighbors inside its radius; only those few fall back to the regular
+// heap traversal. The output matches tree.query() with the same predicates:
+// per query, the k nearest values sorted by increasing distance.
+//
+// Only nearest predicates over point geometries are supported.
+template <class ExecutionSpace, class Tree, class UserPredicates, class Values,
+          class Offsets>
+void largeKNearestQuery(ExecutionSpace const &space, Tree const &tree,
+                        UserPredicates const &user_predicates, Values &values,
+                        Offsets &offsets)
+{
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::Experimental::LargeKNearestQuery");
+
+  namespace KokkosExt = ArborX::Details::KokkosExt;
+
+  using MemorySpace = typename Tree::memory_space;
+  using Value = typename Tree::value_type;
+  static_assert(
+      KokkosExt::is_accessible_from<MemorySpace, ExecutionSpace>::value);
+  static_assert(Kokkos::is_view_v<Values> && Kokkos::is_view_v<Offsets>);
+  static_assert(std::is_same_v<typename Values::value_type, Value>,
+                "Output values must hold the tree value type");
+
+  Details::check_valid_access_traits(PredicatesTag{}, user_predicates);
+  using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+  static_assert(
+      KokkosExt::is_accessible_from<typename Predicates::memory_space,
+                                    ExecutionSpace>::value,
+      "Predicates must be accessible from the execution space");
+  static_assert(std::is_same_v<typename Predicates::value_type::Tag,
+                               NearestPredicateTag>,
+                "largeKNearestQuery requires nearest predicates");
+
+  using Geometry = std::decay_t<decltype(getGeometry(
+      std::declval<typename Predicates::value_type const &>()))>;
+  static_assert(GeometryTraits::is_point_v<Geometry>,
+                "largeKNearestQuery requires point geometries");
+  constexpr int dim = GeometryTraits::dimension_v<Geometry>;
+  using Coordinate = GeometryTraits::coordinate_type_t<Geometry>;
+  using Sphere = ExperimentalHyperGeometry::Sphere<dim, Coordinate>;
+
+  Predicates predicates{user_predicates}; // NOLINT
+  int const n_queries = predicates.size();
+
+  KokkosExt::reallocWithoutInitializing(space, offsets, n_queries + 1);
+  if (tree.empty() || n_queries == 0)
+  {
+    Kokkos::deep_copy(space, offsets, 0);
+    KokkosExt::reallocWithoutInitializing(space, values, 0);
+    return;
+  }
+
+  auto const scene_bounds = tree.bounds();
+  float const scene_size =
+      Details::distance(scene_bounds.minCorner(), scene_bounds.maxCorner());
+  int const n_values = tree.size();
+
+  // Seed every radius with the ball expected to hold k values if they were
+  // spread evenly over the scene
+  Kokkos::View<float *, MemorySpace> radii(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::Experimental::LargeKNearestQuery::radii"),
+      n_queries);
+  Kokkos::parallel_for(
+      "ArborX::Experimental::LargeKNearestQuery::seed_radii",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int i) {
+        float const fraction = Kokkos::min(
+            Kokkos::max((float)getK(predicates(i)), 0.f) / n_values, 1.f);
+        radii(i) = scene_size * Kokkos::pow(fraction, 1.f / dim);
+      });
+
+  using SpherePredicate = decltype(attach(intersects(Sphere{}), int{}));
+  Kokkos::View<SpherePredicate *, MemorySpace> sphere_predicates(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::Experimental::LargeKNearestQuery::predicates"),
+      n_queries);
+  // Grow the radii of the queries whose count came up short until every
+  // query holds at least k candidates or covers the whole scene. The counts
+  // only re-traverse the tree, never touch result storage, and the doubling
+  // ends after a handful of rounds.
+  Kokkos::View<int *, MemorySpace> counts(
+      "ArborX::Experimental::LargeKNearestQuery::counts", 0);
+  while (true)
+  {
+    Kokkos::parallel_for(
+        "ArborX::Experimental::LargeKNearestQuery::setup_predicates",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+        KOKKOS_LAMBDA(int i) {
+          auto const &geometry = getGeometry(predicates(i));
+          auto const &hyper_point = reinterpret_cast<
+              ExperimentalHyperGeometry::Point<dim, Coordinate> const &>(
+              geometry);
+          sphere_predicates(i) =
+              attach(intersects(Sphere{hyper_point, radii(i)}), i);
+        });
+    query_counts(tree, space, sphere_predicates, counts);
+
+    int num_grown;
+    Kokkos::parallel_reduce(
+        "ArborX::Experimental::LargeKNearestQuery::grow_radii",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+        KOKKOS_LAMBDA(int i, int &update) {
+          if (counts(i + 1) - counts(i) >= getK(predicates(i)))
+            return;
+          // Growing past the radius covering the whole scene from this
+          // query cannot add candidates
+          float const cover =
+              predicates(i).distance(scene_bounds) + scene_size;
+          if (radii(i) >= cover)
+            return;
+          radii(i) = (radii(i) > 0 ? Kokkos::min(2 * radii(i), cover) : cover);
+          ++update;
+        },
+        num_grown);
+    if (num_grown == 0)
+      break;
+  }
+
+  // Gather the candidates with their distances in one spatial traversal; the
+  // sphere predicates still match the final radii when the loop exits
+  Kokkos::View<LargeKNearestPair<Value> *, MemorySpace> candidates(
+      "ArborX::Experimental::LargeKNearestQuery::candidates", 0);
+  Kokkos::View<int *, MemorySpace> candidate_offsets(
+      "ArborX::Experimental::LargeKNearestQuery::candidate_offsets", 0);
+  tree.query(space, sphere_predicates,
+             LargeKNearestGatherCallback<Tree, Predicates>{tree, predicates},
+             candidates, candidate_offsets);
+
+  // A query is filled when at least k candidates lie within its verified
+  // radius; the candidate set then provably contains its k nearest values.
+  // The spatial traversal tests conservative boxes, so a count that reached
+  // k does not guarantee the true distances did; the shortfalls go through
+  // the regular heap traversal below.
+  Kokkos::View<int *, MemorySpace> fallback_scan(
+      "ArborX::Experimental::LargeKNearestQuery::fallback_scan",
+      n_queries + 1);
+  Kokkos::parallel_for(
+      "ArborX::Experimental::LargeKNearestQuery::classify",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int q) {
+        int const k = getK(predicates(q));
+        if (k <= 0)
+        {
+          offsets(q) = 0;
+          return;
+        }
+        int within = 0;
+        for (int j = candidate_offsets(q); j < candidate_offsets(q + 1); ++j)
+          within += (candidates(j).distance <= radii(q));
+        bool const filled = (within >= k);
+        offsets(q) = (filled ? k : 0);
+        if (!filled)
+          fallback_scan(q) = 1;
+      });
+  KokkosExt::exclusive_scan(space, fallback_scan, fallback_scan, 0);
+  int const n_fallback = KokkosExt::lastElement(space, fallback_scan);
+
+  Kokkos::View<int *, MemorySpace> fallback_indices(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::Experimental::LargeKNearestQuery::fallback_indices"),
+      n_fallback);
+  Kokkos::View<Value *, MemorySpace> fallback_values(
+      "ArborX::Experimental::LargeKNearestQuery::fallback_values", 0);
+  Kokkos::View<int *, MemorySpace> fallback_offsets(
+      "ArborX::Experimental::LargeKNearestQuery::fallback_offsets", 0);
+  if (n_fallback > 0)
+  {
+    Kokkos::parallel_for(
+        "ArborX::Experimental::LargeKNearestQuery::gather_fallback",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+        KOKKOS_LAMBDA(int q) {
+          if (fallback_scan(q + 1) != fallback_scan(q))
+            fallback_indices(fallback_scan(q)) = q;
+        });
+    tree.query(
+        space,
+        Details::SubsetData<Predicates, decltype(fallback_indices)>{
+            predicates, fallback_indices},
+        fallback_values, fallback_offsets);
+    Kokkos::parallel_for(
+        "ArborX::Experimental::LargeKNearestQuery::fallback_counts",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_fallback),
+        KOKKOS_LAMBDA(int j) {
+          offsets(fallback_indices(j)) =
+              fallback_offsets(j + 1) - fallback_offsets(j);
+        });
+  }
+
+  KokkosExt::exclusive_scan(space, offsets, offsets, 0);
+  KokkosExt::reallocWithoutInitializing(space, values,
+                                        KokkosExt::lastElement(space, offsets));
+
+  // Heap-free selection: quickselect the k closest candidates of each filled
+  // query, then heapsort just those k to match the distance-sorted output of
+  // the regular nearest traversal
+  Kokkos::parallel_for(
+      "ArborX::Experimental::LargeKNearestQuery::select",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int q) {
+        int const k = offsets(q + 1) - offsets(q);
+        if (k == 0 || fallback_scan(q + 1) != fallback_scan(q))
+          return;
+        auto *first = candidates.data() + candidate_offsets(q);
+        auto *last = candidates.data() + candidate_offsets(q + 1);
+        KokkosExt::nth_element(first, first + k - 1, last);
+        Details::Less<LargeKNearestPair<Value>> comp;
+        Details::makeHeap(first, first + k, comp);
+        Details::sortHeap(first, first + k, comp);
+        for (int j = 0; j < k; ++j)
+          values(offsets(q) + j) = first[j].value;
+      });
+
+  if (n_fallback > 0)
+  {
+    Kokkos::parallel_for(
+        "ArborX::Experimental::LargeKNearestQuery::scatter_fallback",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_fallback),
+        KOKKOS_LAMBDA(int j) {
+          int const q = fallback_indices(j);
+          int const count = fallback_offsets(j + 1) - fallback_offsets(j);
+          for (int i = 0; i < count; ++i)
+            values(offsets(q) + i) = fallback_values(fallback_offsets(j) + i);
+        });
+  }
+}
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -13,13 +13,17 @@
 #define ARBORX_NEIGHBOR_LIST_HPP
 
 #include <ArborX_DetailsHalfTraversal.hpp>
+#include <ArborX_DetailsHappyTreeFriends.hpp>
+#include <ArborX_DetailsKokkosExtMinMaxOperations.hpp>
 #include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtSwap.hpp>
 #include <ArborX_DetailsKokkosExtViewHelpers.hpp> // reallocWithoutInitializing
 #include <ArborX_GeometryTraits.hpp>
 #include <ArborX_HyperSphere.hpp>
 #include <ArborX_LinearBVH.hpp>
 
 #include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
 
 namespace ArborX::Experimental
 {
@@ -151,6 +155,9 @@ void findFullNeighborList(ExecutionSpace const &space,
   Kokkos::Profiling::popRegion();
   Kokkos::Profiling::pushRegion("ArborX::Experimental::FullNeighborList::Fill");
 
+  // Each half-traversal match emits both directions directly; mirroring the
+  // half list in a separate pass would re-read the whole index array and
+  // scatter with the same atomics anyway
   auto counts =
       KokkosExt::clone(space, Kokkos::subview(offsets, std::make_pair(0, n)),
                        "ArborX::Experimental::FullNeighborList::counts");
@@ -158,27 +165,380 @@ void findFullNeighborList(ExecutionSpace const &space,
       space, bvh,
       KOKKOS_LAMBDA(Value const &value1, Value const &value2) {
         indices(Kokkos::atomic_fetch_inc(&counts(value2.index))) = value1.index;
+        indices(Kokkos::atomic_fetch_inc(&counts(value1.index))) = value2.index;
       },
       NeighborListPredicateGetter{radius});
 
   Kokkos::Profiling::popRegion();
-  Kokkos::Profiling::pushRegion("ArborX::Experimental::FullNeighborList::Copy");
+  Kokkos::Profiling::popRegion();
+}
+
+// Persistent state of the Verlet (skin) neighbor list mode: the snapshot of
+// the points the cached list was built against, and the cached CRS list
+// built at radius + skin.
+template <class MemorySpace, class Point>
+struct VerletListCache
+{
+  static_assert(GeometryTraits::is_point_v<Point>);
+
+  Kokkos::View<Point *, MemorySpace> _reference_points{
+      "ArborX::Experimental::VerletListCache::reference_points", 0};
+  Kokkos::View<int *, MemorySpace> _offsets{
+      "ArborX::Experimental::VerletListCache::offsets", 0};
+  Kokkos::View<int *, MemorySpace> _indices{
+      "ArborX::Experimental::VerletListCache::indices", 0};
+};
+
+template <class ExecutionSpace, class Points, class MemorySpace, class Point>
+bool verletListNeedsRebuild(ExecutionSpace const &space, Points const &points,
+                            VerletListCache<MemorySpace, Point> const &cache,
+                            float skin)
+{
+  int const n = points.size();
+  if ((int)cache._reference_points.size() != n)
+    return true;
+
+  // A pair of points can enter each other's radius sphere undetected only if
+  // together they bridge the skin, so half of it per point is the safe drift
+  auto const reference_points = cache._reference_points;
+  float const threshold = skin / 2;
+  int moved = 0;
+  Kokkos::parallel_reduce(
+      "ArborX::Experimental::VerletList::check_displacements",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i, int &update) {
+        using Details::distance;
+        if (distance(points(i), reference_points(i)) > threshold)
+          update = 1;
+      },
+      Kokkos::LOr<int>(moved));
+  return moved != 0;
+}
+
+// Verlet (skin) mode: the list is built at radius + skin and cached together
+// with a snapshot of the points; as long as no point drifts farther than
+// skin / 2 from its snapshot, the cached list remains a superset of the
+// radius list and is returned without any traversal. As usual for Verlet
+// lists in molecular dynamics, consumers are expected to filter the pairs by
+// their current distance.
+template <class ExecutionSpace, class Primitives, class Offsets, class Indices,
+          class MemorySpace, class Point>
+void findHalfNeighborList(ExecutionSpace const &space,
+                          Primitives const &primitives, float radius,
+                          float skin, Offsets &offsets, Indices &indices,
+                          VerletListCache<MemorySpace, Point> &cache)
+{
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::Experimental::HalfNeighborList::Verlet");
+
+  namespace KokkosExt = ArborX::Details::KokkosExt;
+
+  using Points = Details::AccessValues<Primitives, PrimitivesTag>;
+  static_assert(
+      std::is_same_v<std::decay_t<typename Points::value_type>, Point>);
+
+  ARBORX_ASSERT(skin > 0);
+
+  Points points{primitives}; // NOLINT
+  int const n = points.size();
+
+  if (verletListNeedsRebuild(space, points, cache, skin))
+  {
+    findHalfNeighborList(space, primitives, radius + skin, cache._offsets,
+                         cache._indices);
+
+    KokkosExt::reallocWithoutInitializing(space, cache._reference_points, n);
+    auto reference_points = cache._reference_points;
+    Kokkos::parallel_for(
+        "ArborX::Experimental::HalfNeighborList::snapshot_reference_points",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int i) { reference_points(i) = points(i); });
+  }
+
+  offsets = cache._offsets;
+  indices = cache._indices;
+}
+
+// Verlet (skin) mode of the full neighbor list, see above
+template <class ExecutionSpace, class Primitives, class Offsets, class Indices,
+          class MemorySpace, class Point>
+void findFullNeighborList(ExecutionSpace const &space,
+                          Primitives const &primitives, float radius,
+                          float skin, Offsets &offsets, Indices &indices,
+                          VerletListCache<MemorySpace, Point> &cache)
+{
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::Experimental::FullNeighborList::Verlet");
+
+  namespace KokkosExt = ArborX::Details::KokkosExt;
+
+  using Points = Details::AccessValues<Primitives, PrimitivesTag>;
+  static_assert(
+      std::is_same_v<std::decay_t<typename Points::value_type>, Point>);
+
+  ARBORX_ASSERT(skin > 0);
+
+  Points points{primitives}; // NOLINT
+  int const n = points.size();
+
+  if (verletListNeedsRebuild(space, points, cache, skin))
+  {
+    findFullNeighborList(space, primitives, radius + skin, cache._offsets,
+                         cache._indices);
+
+    KokkosExt::reallocWithoutInitializing(space, cache._reference_points, n);
+    auto reference_points = cache._reference_points;
+    Kokkos::parallel_for(
+        "ArborX::Experimental::FullNeighborList::snapshot_reference_points",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int i) { reference_points(i) = points(i); });
+  }
+
+  offsets = cache._offsets;
+  indices = cache._indices;
+}
+
+// Callback of the all-kNN pass: maintain a bounded max-heap of the k closest
+// values seen by this query. The traversal processes each predicate on a
+// single thread, so the heaps need no atomics.
+template <class Points, class MemorySpace>
+struct KNearestNeighborListCallback
+{
+  Kokkos::View<int *, MemorySpace> _indices;
+  Kokkos::View<float *, MemorySpace> _distances;
+  Kokkos::View<int *, MemorySpace> _counts;
+  Points _points;
+  int _k;
+
+  template <typename Predicate, typename Value>
+  KOKKOS_FUNCTION void operator()(Predicate const &predicate,
+                                  Value const &value) const
+  {
+    int const i = getData(predicate);
+    if ((int)value.index == i)
+      return;
+
+    using Details::distance;
+    using Details::KokkosExt::swap;
+
+    auto const d = distance(_points(i), value.value);
+    float *dist = &_distances(i * (size_t)_k);
+    int *index = &_indices(i * (size_t)_k);
+
+    auto sift_down = [&](int c, int m) {
+      while (true)
+      {
+        int child = 2 * c + 1;
+        if (child >= m)
+          break;
+        if (child + 1 < m && dist[child + 1] > dist[child])
+          ++child;
+        if (dist[c] >= dist[child])
+          break;
+        swap(dist[c], dist[child]);
+        swap(index[c], index[child]);
+        c = child;
+      }
+    };
+
+    auto &count = _counts(i);
+    if (count < _k)
+    {
+      int c = count++;
+      dist[c] = d;
+      index[c] = value.index;
+      while (c > 0)
+      {
+        int const parent = (c - 1) / 2;
+        if (dist[parent] >= dist[c])
+          break;
+        swap(dist[c], dist[parent]);
+        swap(index[c], index[parent]);
+        c = parent;
+      }
+    }
+    else if (d < dist[0])
+    {
+      dist[0] = d;
+      index[0] = value.index;
+      sift_down(0, _k);
+    }
+  }
+};
+
+// All-k-nearest-neighbors list: every point of the primitives finds its k
+// nearest other points, the self-query pattern of k-NN graph construction.
+// Instead of running the generic nearest traversal with its priority queue,
+// each query is seeded with an upper bound on its k-th neighbor distance
+// computed from the k leaves adjacent to it in Morton order -- for the
+// near-uniform point sets of manifold learning pipelines those are almost
+// the true neighbors -- and then runs as a plain bounded-sphere spatial
+// traversal feeding a per-query max-heap. The neighbor indices of point i
+// are indices(offsets(i), offsets(i+1)), sorted by increasing distance.
+template <class ExecutionSpace, class Primitives, class Offsets,
+          class Indices>
+void findKNearestNeighborList(ExecutionSpace const &space,
+                              Primitives const &primitives, int k,
+                              Offsets &offsets, Indices &indices)
+{
+  Kokkos::Profiling::pushRegion("ArborX::Experimental::KNearestNeighborList");
+
+  namespace KokkosExt = ArborX::Details::KokkosExt;
+
+  using Points = Details::AccessValues<Primitives, PrimitivesTag>;
+
+  using MemorySpace = typename Points::memory_space;
+  static_assert(
+      KokkosExt::is_accessible_from<MemorySpace, ExecutionSpace>::value,
+      "Primitives must be accessible from the execution space");
+
+  using Point = typename Points::value_type;
+  static_assert(GeometryTraits::is_point_v<Point>);
+  constexpr int dim = GeometryTraits::dimension_v<Point>;
+  using Coordinate = typename GeometryTraits::coordinate_type_t<Point>;
+
+  ARBORX_ASSERT(k >= 1);
+
+  Points points{primitives}; // NOLINT
+  int const n = points.size();
+  int const k_eff = KokkosExt::min(k, n - 1);
+
+  KokkosExt::reallocWithoutInitializing(space, offsets, n + 1);
+  if (n == 0 || k_eff <= 0)
+  {
+    Kokkos::deep_copy(space, offsets, 0);
+    KokkosExt::reallocWithoutInitializing(space, indices, 0);
+    Kokkos::Profiling::popRegion();
+    return;
+  }
+
+  using Value = PairValueIndex<Point>;
+
+  BoundingVolumeHierarchy<MemorySpace, Value> bvh(
+      space, Experimental::attach_indices(points));
+
+  Kokkos::Profiling::pushRegion(
+      "ArborX::Experimental::KNearestNeighborList::Seed");
+
+  // The leaves are stored in Morton order, so the leaves around the one
+  // holding a point are its natural first neighbor candidates. The largest
+  // distance among k_eff of them bounds the true k_eff-th neighbor distance
+  // from above and prunes the traversal from the start.
+  Kokkos::View<int *, MemorySpace> leaf_of(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::Experimental::KNearestNeighborList::leaf_of"),
+      n);
+  Kokkos::parallel_for(
+      "ArborX::Experimental::KNearestNeighborList::map_leaves",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int p) {
+        leaf_of(Details::HappyTreeFriends::getValue(bvh, p).index) = p;
+      });
+
+  using Predicate = decltype(attach(
+      intersects(ExperimentalHyperGeometry::Sphere<dim, Coordinate>{}), int{}));
+  Kokkos::View<Predicate *, MemorySpace> predicates(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::Experimental::KNearestNeighborList::predicates"),
+      n);
+  Kokkos::parallel_for(
+      "ArborX::Experimental::KNearestNeighborList::seed_bounds",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        using Details::distance;
+        using KokkosExt::max;
+
+        int const p = leaf_of(i);
+        Coordinate radius = 0;
+        int got = 0;
+        for (int o = 1; got < k_eff; ++o)
+        {
+          if (p - o < 0 && p + o >= n)
+            break;
+          if (p - o >= 0)
+          {
+            radius = max(
+                radius,
+                distance(points(i), Details::HappyTreeFriends::getValue(
+                                        bvh, p - o)
+                                        .value));
+            ++got;
+          }
+          if (got < k_eff && p + o < n)
+          {
+            radius = max(
+                radius,
+                distance(points(i), Details::HappyTreeFriends::getValue(
+                                        bvh, p + o)
+                                        .value));
+            ++got;
+          }
+        }
+
+        auto const &hyper_point = reinterpret_cast<
+            ExperimentalHyperGeometry::Point<dim, Coordinate> const &>(
+            points(i));
+        predicates(i) = attach(
+            intersects(ExperimentalHyperGeometry::Sphere<dim, Coordinate>{
+                hyper_point, radius}),
+            i);
+      });
+
+  Kokkos::Profiling::popRegion();
+  Kokkos::Profiling::pushRegion(
+      "ArborX::Experimental::KNearestNeighborList::Traversal");
+
+  KokkosExt::reallocWithoutInitializing(space, indices, (size_t)n * k_eff);
+  Kokkos::View<float *, MemorySpace> distances(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::Experimental::KNearestNeighborList::distances"),
+      (size_t)n * k_eff);
+  Kokkos::View<int *, MemorySpace> counts(
+      "ArborX::Experimental::KNearestNeighborList::counts", n);
+
+  bvh.query(space, predicates,
+            KNearestNeighborListCallback<decltype(points), MemorySpace>{
+                indices, distances, counts, points, k_eff});
+
+  Kokkos::Profiling::popRegion();
+  Kokkos::Profiling::pushRegion(
+      "ArborX::Experimental::KNearestNeighborList::Sort");
 
-  auto counts_copy = KokkosExt::clone(space, counts, counts.label() + "_copy");
+  // Heap-sort each query's heap in place to produce the neighbors by
+  // increasing distance. The seed radius was the distance to an actual
+  // candidate, so every heap is full.
   Kokkos::parallel_for(
-      "ArborX::Experimental::FullNeighborList::Copy",
-      Kokkos::TeamPolicy<ExecutionSpace>(space, n, Kokkos::AUTO, 1),
-      KOKKOS_LAMBDA(
-          typename Kokkos::TeamPolicy<ExecutionSpace>::member_type const
-              &member) {
-        auto const i = member.league_rank();
-        auto const first = offsets(i);
-        auto const last = counts_copy(i);
-        Kokkos::parallel_for(
-            Kokkos::TeamVectorRange(member, last - first), [&](int j) {
-              int const k = indices(first + j);
-              indices(Kokkos::atomic_fetch_inc(&counts(k))) = i;
-            });
+      "ArborX::Experimental::KNearestNeighborList::sort_neighbors",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        using Details::KokkosExt::swap;
+
+        KOKKOS_ASSERT(counts(i) == k_eff);
+        float *dist = &distances(i * (size_t)k_eff);
+        int *index = &indices(i * (size_t)k_eff);
+        for (int m = k_eff; m > 1;)
+        {
+          --m;
+          swap(dist[0], dist[m]);
+          swap(index[0], index[m]);
+          int c = 0;
+          while (true)
+          {
+            int child = 2 * c + 1;
+            if (child >= m)
+              break;
+            if (child + 1 < m && dist[child + 1] > dist[child])
+              ++child;
+            if (dist[c] >= dist[child])
+              break;
+            swap(dist[c], dist[child]);
+            swap(index[c], index[child]);
+            c = child;
+          }
+        }
+
+        offsets(i) = i * k_eff;
+        if (i == 0)
+          offsets(n) = n * k_eff;
       });
 
   Kokkos::Profiling::popRegion();
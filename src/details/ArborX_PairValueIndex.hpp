@@ -31,6 +31,31 @@ struct PairValueIndex
   Index index;
 };
 
+namespace Experimental
+{
+
+// Marker value type for BoundingVolumeHierarchy. The tree is built over the
+// plain values and behaves as if it stored PairValueIndex<Value, Index>, but
+// the leaves store only the value itself: the index is reconstructed at
+// callback time from the leaf's position in the tree ordering and the
+// permutation retained from construction. This shaves the index (and any
+// padding it drags in) off every leaf, which traversals stream, at the cost
+// of one permutation array that is only touched on hits.
+//
+// A custom IndexableGetter is applied to the stored value, not to the
+// reconstructed pair. Operations that reorder the leaves after construction
+// (partialRebuild, graft, compact) are not available in this mode.
+template <typename Value, typename Index = unsigned>
+struct ImplicitIndex
+{
+  static_assert(std::is_integral_v<Index>);
+
+  using value_type = Value;
+  using index_type = Index;
+};
+
+} // namespace Experimental
+
 namespace Details
 {
 template <typename T>
@@ -44,6 +69,50 @@ struct is_pair_value_index<PairValueIndex<Value, Index>> : public std::true_type
 template <typename T>
 inline constexpr bool is_pair_value_index_v = is_pair_value_index<T>::value;
 
+template <typename T>
+struct is_implicit_index : public std::false_type
+{};
+
+template <typename Value, typename Index>
+struct is_implicit_index<Experimental::ImplicitIndex<Value, Index>>
+    : public std::true_type
+{};
+
+template <typename T>
+inline constexpr bool is_implicit_index_v = is_implicit_index<T>::value;
+
+// Type stored in the leaves for a given tree value template argument
+template <typename T>
+struct implicit_index_storage
+{
+  using type = T;
+};
+
+template <typename Value, typename Index>
+struct implicit_index_storage<Experimental::ImplicitIndex<Value, Index>>
+{
+  using type = Value;
+};
+
+template <typename T>
+using implicit_index_storage_t = typename implicit_index_storage<T>::type;
+
+// Type produced by queries for a given tree value template argument
+template <typename T>
+struct implicit_index_value
+{
+  using type = T;
+};
+
+template <typename Value, typename Index>
+struct implicit_index_value<Experimental::ImplicitIndex<Value, Index>>
+{
+  using type = PairValueIndex<Value, Index>;
+};
+
+template <typename T>
+using implicit_index_value_t = typename implicit_index_value<T>::type;
+
 } // namespace Details
 
 } // namespace ArborX
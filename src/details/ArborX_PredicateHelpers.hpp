@@ -87,6 +87,37 @@ auto make_nearest(Primitives const &primitives, int k)
   return PrimitivesNearestK<Primitives>{primitives, k};
 }
 
+// Generator-style predicate source: the predicate for index i is computed on
+// the fly by the user functor instead of being read from a materialized
+// view. The space-filling curve sorting permutes indices rather than
+// predicates, so a query with generated predicates never allocates an O(n)
+// predicate array.
+template <typename MemorySpace, typename Generator>
+class PredicateGenerator
+{
+  static_assert(Kokkos::is_memory_space<MemorySpace>::value);
+
+public:
+  using memory_space = MemorySpace;
+
+  Generator _generator;
+  int _n;
+};
+
+// The memory space argument states where the data captured by the generator
+// is accessible from, the same role AccessTraits::memory_space plays for
+// view-based predicates
+template <typename MemorySpace, typename Generator>
+auto make_predicates(MemorySpace const &, Generator const &generator, int n)
+{
+  using Predicate = std::decay_t<decltype(generator(0))>;
+  using Tag =
+      Kokkos::detected_t<Details::PredicateTagArchetypeAlias, Predicate>;
+  static_assert(Details::is_valid_predicate_tag<Tag>::value,
+                "generator must return a valid predicate");
+  return PredicateGenerator<MemorySpace, Generator>{generator, n};
+}
+
 } // namespace Experimental
 
 template <class Primitives>
@@ -160,6 +191,24 @@ public:
   }
 };
 
+template <class MemorySpace, class Generator>
+struct AccessTraits<Experimental::PredicateGenerator<MemorySpace, Generator>,
+                    PredicatesTag>
+{
+private:
+  using Self = Experimental::PredicateGenerator<MemorySpace, Generator>;
+
+public:
+  using memory_space = MemorySpace;
+  using size_type = typename memory_space::size_type;
+
+  static KOKKOS_FUNCTION size_type size(Self const &x) { return x._n; }
+  static KOKKOS_FUNCTION decltype(auto) get(Self const &x, size_type i)
+  {
+    return x._generator(i);
+  }
+};
+
 } // namespace ArborX
 
 #endif
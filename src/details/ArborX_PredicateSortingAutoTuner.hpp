@@ -0,0 +1,101 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#ifndef ARBORX_PREDICATE_SORTING_AUTO_TUNER_HPP
+#define ARBORX_PREDICATE_SORTING_AUTO_TUNER_HPP
+
+#include <Kokkos_Core.hpp>
+
+#include <cstddef>
+
+namespace ArborX::Experimental
+{
+
+// Decides at runtime whether sorting the predicates along the space-filling
+// curve pays off. Whether it does depends on the batch size, the coherence
+// of the predicates, and the backend, which makes a static choice through
+// TraversalPolicy::setPredicateSorting() brittle. The tuner times the first
+// few invocations of a repeated query shape, alternating between the two
+// configurations, and locks in the faster one for all subsequent calls. A
+// change in the number of predicates restarts the sampling.
+//
+// While sampling, every timed invocation is bracketed by fences on the
+// execution space passed to query(), so the first 2 * sample_rounds calls
+// pay a synchronization penalty; decided calls add no overhead. The timings
+// include the cost of computing the permutation, so attaching a
+// PredicateSortingCache to the same policy shifts the decision in favor of
+// sorting, as it should.
+//
+// Typical use:
+//
+//   Experimental::PredicateSortingAutoTuner tuner;
+//   auto policy = Experimental::TraversalPolicy().setPredicateSorting(tuner);
+//   for (int step = 0; step < n_steps; ++step)
+//     tree.query(space, predicates, callback, policy);
+struct PredicateSortingAutoTuner
+{
+  // Timed invocations per configuration before locking in
+  static constexpr int sample_rounds = 3;
+
+  int _num_samples = 0;
+  // Accumulated query time per configuration: [0] unsorted, [1] sorted
+  double _time[2] = {0., 0.};
+  // -1 while sampling, afterwards the index of the winning configuration
+  int _decision = -1;
+  // Initialized invalid so that the first invocation starts the sampling
+  std::size_t _num_predicates = std::size_t(-1);
+  int _current = 1;
+  Kokkos::Timer _timer;
+
+  bool decided() const { return _decision >= 0; }
+
+  template <class ExecutionSpace>
+  bool beginSample(ExecutionSpace const &space, std::size_t n_predicates)
+  {
+    if (n_predicates != _num_predicates)
+    {
+      // A different batch shape restarts the sampling
+      _num_samples = 0;
+      _time[0] = _time[1] = 0.;
+      _decision = -1;
+      _num_predicates = n_predicates;
+    }
+
+    if (decided())
+      return _decision == 1;
+
+    // Alternate starting with the sorted configuration (the library default)
+    // so that neither is systematically favored by warm-up effects
+    _current = (_num_samples % 2 == 0);
+    space.fence("ArborX::PredicateSortingAutoTuner::begin_sample");
+    _timer.reset();
+    return _current == 1;
+  }
+
+  template <class ExecutionSpace>
+  void endSample(ExecutionSpace const &space)
+  {
+    if (decided())
+      return;
+
+    space.fence("ArborX::PredicateSortingAutoTuner::end_sample");
+    _time[_current] += _timer.seconds();
+
+    if (++_num_samples == 2 * sample_rounds)
+    {
+      // Ties go to sorting, the library default
+      _decision = (_time[1] <= _time[0]);
+    }
+  }
+};
+
+} // namespace ArborX::Experimental
+
+#endif
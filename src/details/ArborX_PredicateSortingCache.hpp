@@ -0,0 +1,50 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#ifndef ARBORX_PREDICATE_SORTING_CACHE_HPP
+#define ARBORX_PREDICATE_SORTING_CACHE_HPP
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Experimental
+{
+
+// Retains the space-filling-curve permutation of the predicates across
+// query() calls. Sorting the predicates is pure repeated work when the same
+// predicate set is issued over and over (e.g., every iteration of a solver),
+// so the first call stores the computed permutation here and later calls
+// reuse it.
+//
+// The cache holder asserts that the predicates have not changed since the
+// permutation was stored; reusing a stale permutation does not affect
+// correctness of the results, only the traversal coherence the sorting is
+// meant to provide. A change in the number of predicates invalidates the
+// cache automatically; any other change requires calling clear().
+//
+// The device type must match the one of the tree the policy is passed to.
+//
+// Typical use:
+//
+//   Experimental::PredicateSortingCache<DeviceType> cache;
+//   auto policy = Experimental::TraversalPolicy().setSortingCache(cache);
+//   for (int step = 0; step < n_steps; ++step)
+//     tree.query(space, predicates, callback, policy);
+template <typename DeviceType>
+struct PredicateSortingCache
+{
+  Kokkos::View<unsigned int *, DeviceType> _permute{
+      "ArborX::PredicateSortingCache::permute", 0};
+
+  void clear() { Kokkos::resize(_permute, 0); }
+};
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -13,6 +13,8 @@
 
 #include <ArborX_DetailsAlgorithms.hpp>
 
+#include <Kokkos_DetectionIdiom.hpp>
+
 namespace ArborX
 {
 namespace Details
@@ -92,8 +94,9 @@ struct OrderedSpatial
   OrderedSpatial() = default;
 
   KOKKOS_FUNCTION
-  OrderedSpatial(Geometry const &geometry)
+  OrderedSpatial(Geometry const &geometry, int k = 0)
       : _geometry(geometry)
+      , _k(k)
   {}
 
   template <class OtherGeometry>
@@ -104,6 +107,8 @@ struct OrderedSpatial
   }
 
   Geometry _geometry;
+  // Maximum number of matches to report, with 0 meaning all of them
+  int _k = 0;
 };
 } // namespace Experimental
 
@@ -128,14 +133,43 @@ KOKKOS_INLINE_FUNCTION int getK(Nearest<Geometry> const &pred)
 
 namespace Experimental
 {
+// With k > 0, only the k matches closest to the geometry along the traversal
+// order are reported ("first k surface crossings of a ray"); the default
+// reports all of them
 template <typename Geometry>
 KOKKOS_INLINE_FUNCTION OrderedSpatial<Geometry>
-ordered_intersects(Geometry const &geometry)
+ordered_intersects(Geometry const &geometry, int k = 0)
 {
-  return OrderedSpatial<Geometry>(geometry);
+  return OrderedSpatial<Geometry>(geometry, k);
 }
 } // namespace Experimental
 
+template <typename Geometry>
+KOKKOS_INLINE_FUNCTION int
+getK(Experimental::OrderedSpatial<Geometry> const &pred)
+{
+  return pred._k;
+}
+
+namespace Details
+{
+template <typename Predicate>
+using PredicateGetKArchetypeExpression =
+    decltype(getK(std::declval<Predicate const &>()));
+
+// Upper bound on the number of matches the predicate may report, with 0
+// meaning no limit. Predicate types that do not carry a k are unlimited.
+template <typename Predicate>
+KOKKOS_INLINE_FUNCTION int getMaxResults(Predicate const &predicate)
+{
+  if constexpr (Kokkos::is_detected_v<PredicateGetKArchetypeExpression,
+                                      Predicate>)
+    return getK(predicate);
+  else
+    return 0;
+}
+} // namespace Details
+
 template <typename Geometry>
 KOKKOS_INLINE_FUNCTION Geometry const &
 getGeometry(Nearest<Geometry> const &pred)
@@ -194,6 +228,149 @@ KOKKOS_INLINE_FUNCTION constexpr auto attach(Predicate &&pred, Data &&data)
       std::forward<Predicate>(pred), std::forward<Data>(data)};
 }
 
+// Nearest predicate annotated with a known upper bound on the distance to
+// its k-th nearest neighbor, allowing the traversal to prune nodes beyond
+// the bound before the heap has filled. Used by the distributed nearest
+// implementation to propagate the phase one bound to forwarded queries.
+template <typename Predicate>
+struct PredicateWithInitialBound : Predicate
+{
+  static_assert(std::is_same_v<typename Predicate::Tag,
+                               Details::NearestPredicateTag>);
+
+  KOKKOS_DEFAULTED_FUNCTION PredicateWithInitialBound() = default;
+  KOKKOS_INLINE_FUNCTION PredicateWithInitialBound(Predicate const &pred,
+                                                   float bound)
+      : Predicate{pred}
+      , _bound{bound}
+  {}
+  float _bound =
+      Details::KokkosExt::ArithmeticTraits::infinity<float>::value;
+};
+
+template <typename Predicate>
+KOKKOS_INLINE_FUNCTION float getInitialBound(Predicate const &)
+{
+  return Details::KokkosExt::ArithmeticTraits::infinity<float>::value;
+}
+
+template <typename Predicate>
+KOKKOS_INLINE_FUNCTION float
+getInitialBound(PredicateWithInitialBound<Predicate> const &pred)
+{
+  return pred._bound;
+}
+
+// Nearest predicate with a relative distance slack: the traversal only
+// descends into subtrees whose distance lower bound is within a (1+eps)
+// factor of the current best, pruning the expensive tail of the traversal in
+// exchange for neighbors that may be up to (1+eps) farther than the true
+// ones.
+template <typename Predicate>
+struct PredicateWithDistanceSlack : Predicate
+{
+  static_assert(std::is_same_v<typename Predicate::Tag,
+                               Details::NearestPredicateTag>);
+
+  KOKKOS_DEFAULTED_FUNCTION PredicateWithDistanceSlack() = default;
+  KOKKOS_INLINE_FUNCTION PredicateWithDistanceSlack(Predicate const &pred,
+                                                    float eps)
+      : Predicate{pred}
+      , _slack{1 + eps}
+  {}
+  float _slack = 1.f;
+};
+
+template <typename Predicate>
+KOKKOS_INLINE_FUNCTION float getDistanceSlack(Predicate const &)
+{
+  return 1.f;
+}
+
+template <typename Predicate>
+KOKKOS_INLINE_FUNCTION float
+getDistanceSlack(PredicateWithDistanceSlack<Predicate> const &pred)
+{
+  return pred._slack;
+}
+
+// (1+eps)-approximate k-nearest neighbors
+template <typename Geometry>
+KOKKOS_INLINE_FUNCTION PredicateWithDistanceSlack<Nearest<Geometry>>
+nearest(Geometry const &geometry, int k, float eps)
+{
+  return {Nearest<Geometry>(geometry, k), eps};
+}
+
+// Nearest predicate seeded with an initial candidate, typically the answer
+// to the same query from the previous time step. The candidate's distance
+// bounds the traversal before any node is visited, so a candidate that is
+// still (close to) the nearest neighbor collapses the traversal to the few
+// nodes that could beat it. The candidate must be a value stored in the tree
+// together with its exact distance to the query geometry; it is reported
+// itself when no strictly closer value exists. Only k == 1 queries exploit
+// the seed, larger k traverse as if unseeded.
+template <typename Predicate, typename Value>
+struct PredicateWithInitialCandidate : Predicate
+{
+  static_assert(std::is_same_v<typename Predicate::Tag,
+                               Details::NearestPredicateTag>);
+
+  KOKKOS_DEFAULTED_FUNCTION PredicateWithInitialCandidate() = default;
+  KOKKOS_INLINE_FUNCTION PredicateWithInitialCandidate(Predicate const &pred,
+                                                       Value const &candidate,
+                                                       float distance)
+      : Predicate{pred}
+      , _candidate{candidate}
+      , _candidate_distance{distance}
+  {}
+  Value _candidate;
+  float _candidate_distance =
+      Details::KokkosExt::ArithmeticTraits::infinity<float>::value;
+};
+
+template <typename Predicate, typename Value>
+KOKKOS_INLINE_FUNCTION Value const &
+getInitialCandidate(PredicateWithInitialCandidate<Predicate, Value> const &pred)
+{
+  return pred._candidate;
+}
+
+template <typename Predicate, typename Value>
+KOKKOS_INLINE_FUNCTION float
+getInitialBound(PredicateWithInitialCandidate<Predicate, Value> const &pred)
+{
+  // The seed only bounds single-nearest queries: for larger k the k-th
+  // neighbor may well be farther than the candidate
+  return getK(pred) == 1
+             ? pred._candidate_distance
+             : Details::KokkosExt::ArithmeticTraits::infinity<float>::value;
+}
+
+namespace Details
+{
+template <typename Predicate>
+using PredicateGetInitialCandidateArchetypeExpression =
+    decltype(getInitialCandidate(std::declval<Predicate const &>()));
+
+template <typename Predicate>
+inline constexpr bool has_initial_candidate_v =
+    Kokkos::is_detected_v<PredicateGetInitialCandidateArchetypeExpression,
+                          Predicate>;
+} // namespace Details
+
+namespace Experimental
+{
+// Warm-started single nearest neighbor
+template <typename Geometry, typename Value>
+KOKKOS_INLINE_FUNCTION PredicateWithInitialCandidate<Nearest<Geometry>, Value>
+seeded_nearest(Geometry const &geometry, Value const &candidate,
+               float distance)
+{
+  return {Nearest<Geometry>(geometry, 1), candidate, distance};
+}
+} // namespace Experimental
+
 } // namespace ArborX
 
 #endif
@@ -0,0 +1,159 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#ifndef ARBORX_QUERY_AGGREGATOR_HPP
+#define ARBORX_QUERY_AGGREGATOR_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_CrsGraphWrapper.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_Exception.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+
+namespace ArborX::Experimental
+{
+
+// Collects the predicates of several small logical query() calls and runs
+// them as one fused CRS query. Each call pays the full query pipeline
+// (multiple kernel launches plus, without a buffer size, a second traversal
+// pass), so when independent modules issue many calls of a few hundred
+// predicates each, the launch overhead dominates and the small batches
+// underutilize the device. Fusing the calls pays the pipeline once and
+// hands the traversal a batch large enough to fill it. The fused results
+// are demultiplexed per call through the CRS offsets of the slots the call
+// occupies.
+//
+// Typical use, once per step:
+//
+//   Experimental::QueryAggregator<MemorySpace, Predicate, int> aggregator;
+//   auto t1 = aggregator.submit(space, predicates_of_module_1);
+//   auto t2 = aggregator.submit(space, predicates_of_module_2);
+//   aggregator.flush(space, tree);
+//   aggregator.get(space, t1, values_1, offset_1);
+//   aggregator.get(space, t2, values_2, offset_2);
+//   aggregator.reset();
+//
+// The allocations survive reset(), so steady-state rounds with stable batch
+// sizes do not allocate for the predicates.
+template <typename MemorySpace, typename Predicate, typename Value>
+class QueryAggregator
+{
+public:
+  // Slots a submitted call occupies in the fused predicate batch
+  struct Ticket
+  {
+    int first;
+    int size;
+  };
+
+  template <typename ExecutionSpace, typename UserPredicates>
+  Ticket submit(ExecutionSpace const &space,
+                UserPredicates const &user_predicates)
+  {
+    ARBORX_ASSERT(!_flushed);
+
+    Details::check_valid_access_traits(PredicatesTag{}, user_predicates);
+    using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+    static_assert(std::is_same_v<typename Predicates::value_type, Predicate>,
+                  "All aggregated calls must use the same predicate type");
+
+    Predicates predicates{user_predicates}; // NOLINT
+
+    int const n = predicates.size();
+    if (_size + n > (int)_predicates.size())
+      Kokkos::resize(Kokkos::view_alloc(space, Kokkos::WithoutInitializing),
+                     _predicates,
+                     std::max(_size + n, 2 * (int)_predicates.size()));
+
+    auto storage = _predicates;
+    int const first = _size;
+    Kokkos::parallel_for(
+        "ArborX::QueryAggregator::copy_predicates",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int i) { storage(first + i) = predicates(i); });
+
+    _size += n;
+    return {first, n};
+  }
+
+  // Run all the submitted predicates through one regular CRS query; trailing
+  // arguments (e.g. a TraversalPolicy) are forwarded to it
+  template <typename ExecutionSpace, typename Tree, typename... Args>
+  void flush(ExecutionSpace const &space, Tree const &tree, Args &&...args)
+  {
+    ARBORX_ASSERT(!_flushed);
+
+    ArborX::query(tree, space,
+                  Kokkos::subview(_predicates, std::make_pair(0, _size)),
+                  _values, _offset, std::forward<Args>(args)...);
+    _flushed = true;
+  }
+
+  // Copy a submitted call's slice of the fused results into its own CRS
+  // views, rebasing the offsets to start at zero
+  template <typename ExecutionSpace, typename Values, typename Offset>
+  void get(ExecutionSpace const &space, Ticket ticket, Values &values,
+           Offset &offset) const
+  {
+    namespace KokkosExt = Details::KokkosExt;
+
+    ARBORX_ASSERT(_flushed);
+    ARBORX_ASSERT(ticket.first >= 0 && ticket.first + ticket.size <= _size);
+
+    int values_begin;
+    int values_end;
+    Kokkos::deep_copy(space, values_begin,
+                      Kokkos::subview(_offset, ticket.first));
+    Kokkos::deep_copy(space, values_end,
+                      Kokkos::subview(_offset, ticket.first + ticket.size));
+    space.fence("ArborX::QueryAggregator::get"
+                " (offsets copied to host before slicing the results)");
+
+    KokkosExt::reallocWithoutInitializing(space, offset, ticket.size + 1);
+    auto out_offset = offset;
+    auto const fused_offset = Kokkos::subview(
+        _offset, std::make_pair(ticket.first, ticket.first + ticket.size + 1));
+    Kokkos::parallel_for(
+        "ArborX::QueryAggregator::rebase_offsets",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, ticket.size + 1),
+        KOKKOS_LAMBDA(int i) { out_offset(i) = fused_offset(i) - values_begin; });
+
+    KokkosExt::reallocWithoutInitializing(space, values,
+                                          values_end - values_begin);
+    Kokkos::deep_copy(
+        space, values,
+        Kokkos::subview(_values, std::make_pair(values_begin, values_end)));
+  }
+
+  // Discard the submissions and results, keeping the allocations for the
+  // next round of calls
+  void reset()
+  {
+    _size = 0;
+    _flushed = false;
+  }
+
+private:
+  Kokkos::View<Predicate *, MemorySpace> _predicates{
+      "ArborX::QueryAggregator::predicates", 0};
+  Kokkos::View<Value *, MemorySpace> _values{"ArborX::QueryAggregator::values",
+                                             0};
+  Kokkos::View<int *, MemorySpace> _offset{"ArborX::QueryAggregator::offset",
+                                           0};
+  int _size = 0;
+  bool _flushed = false;
+};
+
+} // namespace ArborX::Experimental
+
+#endif
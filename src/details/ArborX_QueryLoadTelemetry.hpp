@@ -0,0 +1,138 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#ifndef ARBORX_QUERY_LOAD_TELEMETRY_HPP
+#define ARBORX_QUERY_LOAD_TELEMETRY_HPP
+
+#include <ostream>
+#include <vector>
+
+namespace ArborX::Experimental
+{
+
+// Accumulates, across queries of the distributed tree it is attached to (see
+// DistributedTreeBase::attachLoadTelemetry()), how much query work this rank
+// asked every rank to serve: the number of predicates it forwarded to each
+// rank and the number of results each rank produced for it. Both are cheap
+// proxies for the traversal work the serving rank ran on this rank's behalf
+// -- every forwarded predicate walks the serving tree once and every result
+// is a leaf hit -- and are read off the communication plans without
+// instrumenting the traversal kernels. Unlike the distributor telemetry, the
+// records accumulate until reset(), so the load of a whole simulation phase
+// can feed a repartitioning decision; combine the per-rank views with
+// DistributedTreeBase::repartitioningHints().
+struct QueryLoadTelemetry
+{
+  // Indexed by rank; grown on first contact with a rank
+  std::vector<long long> predicates_sent;
+  std::vector<long long> results_received;
+
+  void recordPredicatesSent(int rank, long long n)
+  {
+    if ((int)predicates_sent.size() <= rank)
+      predicates_sent.resize(rank + 1, 0);
+    predicates_sent[rank] += n;
+  }
+
+  void recordResultsReceived(int rank, long long n)
+  {
+    if ((int)results_received.size() <= rank)
+      results_received.resize(rank + 1, 0);
+    results_received[rank] += n;
+  }
+
+  void reset()
+  {
+    predicates_sent.clear();
+    results_received.clear();
+  }
+};
+
+// Partition-quality metrics computed collectively from the query load all
+// ranks accumulated, plus per-rank weights a load balancer can consume; the
+// result of DistributedTreeBase::repartitioningHints()
+struct RepartitioningHints
+{
+  // Per rank: total cost served on behalf of all ranks (forwarded predicates
+  // plus produced results)
+  std::vector<long long> served_cost;
+  // Per rank: number of values its bottom tree currently stores
+  std::vector<long long> primitive_counts;
+  // Per rank: served cost per stored value, normalized to a mean of one.
+  // Feeding weights[r] to a weighted partitioner as the weight of every
+  // primitive currently on rank r equalizes the expected served cost instead
+  // of the primitive counts.
+  std::vector<double> weights;
+  // Largest served cost over the mean; 1 is perfect balance
+  double imbalance = 1.;
+
+  // Print a host-side summary of the metrics
+  void report(std::ostream &os) const
+  {
+    int const comm_size = served_cost.size();
+    long long total = 0;
+    long long max_cost = 0;
+    int max_rank = -1;
+    for (int r = 0; r < comm_size; ++r)
+    {
+      total += served_cost[r];
+      if (served_cost[r] > max_cost)
+      {
+        max_cost = served_cost[r];
+        max_rank = r;
+      }
+    }
+    os << "ArborX repartitioning hints over " << comm_size << " ranks\n";
+    os << "  served cost: total " << total << ", max " << max_cost;
+    if (max_rank >= 0)
+      os << " (rank " << max_rank << ")";
+    os << '\n';
+    os << "  imbalance: " << imbalance << '\n';
+  }
+};
+
+} // namespace ArborX::Experimental
+
+namespace ArborX::Details
+{
+
+// Installed for the duration of a query through a scoped thread-local slot,
+// for the same reasons the distributor telemetry sink is (see
+// ArborX_DistributorTelemetry.hpp): the recording happens deep inside the
+// communication helpers, queries are collective and never nested, and
+// queryAsync() runs entirely on its helper thread.
+inline Experimental::QueryLoadTelemetry *&currentQueryLoadTelemetry()
+{
+  thread_local Experimental::QueryLoadTelemetry *telemetry = nullptr;
+  return telemetry;
+}
+
+class ScopedQueryLoadTelemetry
+{
+public:
+  explicit ScopedQueryLoadTelemetry(Experimental::QueryLoadTelemetry *telemetry)
+      : _previous(currentQueryLoadTelemetry())
+  {
+    currentQueryLoadTelemetry() = telemetry;
+  }
+
+  ~ScopedQueryLoadTelemetry() { currentQueryLoadTelemetry() = _previous; }
+
+  ScopedQueryLoadTelemetry(ScopedQueryLoadTelemetry const &) = delete;
+  ScopedQueryLoadTelemetry &
+  operator=(ScopedQueryLoadTelemetry const &) = delete;
+
+private:
+  Experimental::QueryLoadTelemetry *_previous;
+};
+
+} // namespace ArborX::Details
+
+#endif
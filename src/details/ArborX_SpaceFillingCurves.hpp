@@ -13,6 +13,7 @@
 #define ARBORX_SPACE_FILLING_CURVES_HPP
 
 #include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_DetailsHilbertCode.hpp>
 #include <ArborX_DetailsMortonCode.hpp>
 #include <ArborX_HyperBox.hpp>
 #include <ArborX_HyperPoint.hpp>
@@ -73,6 +74,84 @@ struct Morton64
   }
 };
 
+// Extended-precision variant for scenes whose coordinate dynamic range
+// exceeds what the default curves can resolve (deep zooms, data spanning
+// many orders of magnitude): there, morton64() maps large numbers of
+// distinct points onto identical codes and tree construction degenerates to
+// its duplicate-key handling. The 128-bit codes scale the coordinates in
+// double precision, so the extra bits only carry information when the
+// geometries use double-precision coordinates. They bypass the vendor radix
+// paths of sortByKey() in favor of its comparison- and byte-wise ones;
+// prefer the default curves whenever 21 bits per dimension suffice.
+struct Morton128
+{
+  template <typename Box, typename Point,
+            std::enable_if_t<GeometryTraits::is_box_v<Box> &&
+                             GeometryTraits::is_point_v<Point>> * = nullptr>
+  KOKKOS_FUNCTION auto operator()(Box const &scene_bounding_box, Point p) const
+  {
+    Details::translateAndScale(p, p, scene_bounding_box);
+    return Details::morton128(p);
+  }
+  template <typename Box, class Geometry,
+            std::enable_if_t<GeometryTraits::is_box_v<Box> &&
+                             !GeometryTraits::is_point_v<Geometry>> * = nullptr>
+  KOKKOS_FUNCTION auto operator()(Box const &scene_bounding_box,
+                                  Geometry const &geometry) const
+  {
+    using Details::returnCentroid;
+    auto p = returnCentroid(geometry);
+    Details::translateAndScale(p, p, scene_bounding_box);
+    return Details::morton128(p);
+  }
+};
+
+struct Hilbert32
+{
+  template <typename Box, typename Point,
+            std::enable_if_t<GeometryTraits::is_box_v<Box> &&
+                             GeometryTraits::is_point_v<Point>> * = nullptr>
+  KOKKOS_FUNCTION auto operator()(Box const &scene_bounding_box, Point p) const
+  {
+    Details::translateAndScale(p, p, scene_bounding_box);
+    return Details::hilbert32(p);
+  }
+  template <typename Box, typename Geometry,
+            std::enable_if_t<GeometryTraits::is_box_v<Box> &&
+                             !GeometryTraits::is_point_v<Geometry>> * = nullptr>
+  KOKKOS_FUNCTION auto operator()(Box const &scene_bounding_box,
+                                  Geometry const &geometry) const
+  {
+    using Details::returnCentroid;
+    auto p = returnCentroid(geometry);
+    Details::translateAndScale(p, p, scene_bounding_box);
+    return Details::hilbert32(p);
+  }
+};
+
+struct Hilbert64
+{
+  template <typename Box, typename Point,
+            std::enable_if_t<GeometryTraits::is_box_v<Box> &&
+                             GeometryTraits::is_point_v<Point>> * = nullptr>
+  KOKKOS_FUNCTION auto operator()(Box const &scene_bounding_box, Point p) const
+  {
+    Details::translateAndScale(p, p, scene_bounding_box);
+    return Details::hilbert64(p);
+  }
+  template <typename Box, class Geometry,
+            std::enable_if_t<GeometryTraits::is_box_v<Box> &&
+                             !GeometryTraits::is_point_v<Geometry>> * = nullptr>
+  KOKKOS_FUNCTION auto operator()(Box const &scene_bounding_box,
+                                  Geometry const &geometry) const
+  {
+    using Details::returnCentroid;
+    auto p = returnCentroid(geometry);
+    Details::translateAndScale(p, p, scene_bounding_box);
+    return Details::hilbert64(p);
+  }
+};
+
 } // namespace Experimental
 
 namespace Details
@@ -90,7 +169,8 @@ void check_valid_space_filling_curve(SpaceFillingCurve const &)
   using OrderValueType =
       std::invoke_result_t<SpaceFillingCurve const &, Box, Point>;
   static_assert(std::is_same_v<OrderValueType, unsigned int> ||
-                std::is_same_v<OrderValueType, unsigned long long>);
+                std::is_same_v<OrderValueType, unsigned long long> ||
+                std::is_same_v<OrderValueType, MortonCode128>);
   static_assert(std::is_same_v<
                 OrderValueType,
                 std::invoke_result_t<SpaceFillingCurve const &, Box, Box>>);
@@ -16,6 +16,12 @@ namespace ArborX
 {
 namespace Experimental
 {
+
+template <typename DeviceType>
+struct PredicateSortingCache;
+
+struct PredicateSortingAutoTuner;
+
 struct TraversalPolicy
 {
   // Buffer size lets a user provide an upper bound for the number of results
@@ -33,6 +39,34 @@ struct TraversalPolicy
   // Sort predicates allows disabling predicate sorting.
   bool _sort_predicates = true;
 
+  // Use the persistent-threads work-queue traversal engine for spatial
+  // queries. Threads pick (predicate, subtree) work items off a shared queue
+  // and donate subtrees back to it, which mitigates the load imbalance of the
+  // one-thread-per-predicate scheme when a few predicates are much more
+  // expensive than the rest. Ignored for non-spatial predicates.
+  bool _persistent_work_queue = false;
+
+  // Use packet traversal for spatial queries: a team of threads shares a
+  // single traversal path and cooperatively tests children, which reduces
+  // node-fetch bandwidth when the predicates are spatially coherent (e.g.,
+  // sorted along a space-filling curve). Ignored for non-spatial predicates.
+  bool _packet_traversal = false;
+
+  // Optional handle to a user-owned PredicateSortingCache retaining the
+  // space-filling-curve permutation across query calls (see the cache header
+  // for the usage contract). Only consulted when predicate sorting is
+  // enabled. The handle is type-erased so that the policy stays independent
+  // of the device type; the query implementation casts it back knowing the
+  // device type of the tree.
+  void *_sorting_cache = nullptr;
+
+  // Optional handle to a user-owned PredicateSortingAutoTuner that samples
+  // both sorting configurations over the first invocations of a repeated
+  // query shape and locks in the faster one (see the tuner header for the
+  // usage contract). When set, it overrides the static _sort_predicates
+  // choice.
+  PredicateSortingAutoTuner *_sorting_auto_tuner = nullptr;
+
   TraversalPolicy &setBufferSize(int buffer_size)
   {
     _buffer_size = buffer_size;
@@ -44,6 +78,31 @@ struct TraversalPolicy
     _sort_predicates = sort_predicates;
     return *this;
   }
+
+  TraversalPolicy &setPredicateSorting(PredicateSortingAutoTuner &tuner)
+  {
+    _sorting_auto_tuner = &tuner;
+    return *this;
+  }
+
+  TraversalPolicy &setPersistentWorkQueue(bool persistent_work_queue)
+  {
+    _persistent_work_queue = persistent_work_queue;
+    return *this;
+  }
+
+  TraversalPolicy &setPacketTraversal(bool packet_traversal)
+  {
+    _packet_traversal = packet_traversal;
+    return *this;
+  }
+
+  template <typename DeviceType>
+  TraversalPolicy &setSortingCache(PredicateSortingCache<DeviceType> &cache)
+  {
+    _sorting_cache = &cache;
+    return *this;
+  }
 };
 
 } // namespace Experimental
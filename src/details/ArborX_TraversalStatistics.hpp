@@ -0,0 +1,650 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_TRAVERSAL_STATISTICS_HPP
+#define ARBORX_TRAVERSAL_STATISTICS_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_Callbacks.hpp>
+#include <ArborX_DetailsHappyTreeFriends.hpp>
+#include <ArborX_DetailsHeap.hpp>
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DetailsNearestBufferProvider.hpp>
+#include <ArborX_DetailsNode.hpp> // ROPE_SENTINEL
+#include <ArborX_DetailsPriorityQueue.hpp>
+#include <ArborX_DetailsTreeTraversal.hpp>
+#include <ArborX_Predicates.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <ostream>
+
+namespace ArborX
+{
+
+namespace Experimental
+{
+
+// Per-query counters accumulated by queryWithStatistics(). The counters are
+// indexed by the position of the predicate in the view passed to the query
+// (no predicate sorting is performed on the instrumented path), which makes
+// it possible to correlate slow query batches with tree quality and with the
+// spatial distribution of the predicates.
+template <class MemorySpace>
+struct TraversalStatistics
+{
+  Kokkos::View<int *, MemorySpace> internal_nodes_visited;
+  Kokkos::View<int *, MemorySpace> leaf_tests;
+  Kokkos::View<int *, MemorySpace> heap_pushes;
+
+  TraversalStatistics()
+      : internal_nodes_visited(
+            "ArborX::TraversalStatistics::internal_nodes_visited", 0)
+      , leaf_tests("ArborX::TraversalStatistics::leaf_tests", 0)
+      , heap_pushes("ArborX::TraversalStatistics::heap_pushes", 0)
+  {}
+
+  template <class ExecutionSpace>
+  void reset(ExecutionSpace const &space, int n_queries)
+  {
+    namespace KokkosExt = Details::KokkosExt;
+    KokkosExt::reallocWithoutInitializing(space, internal_nodes_visited,
+                                          n_queries);
+    KokkosExt::reallocWithoutInitializing(space, leaf_tests, n_queries);
+    KokkosExt::reallocWithoutInitializing(space, heap_pushes, n_queries);
+    Kokkos::deep_copy(space, internal_nodes_visited, 0);
+    Kokkos::deep_copy(space, leaf_tests, 0);
+    Kokkos::deep_copy(space, heap_pushes, 0);
+  }
+
+  // Print a host-side summary of the accumulated counters
+  void report(std::ostream &os) const
+  {
+    auto print = [&os](char const *label, auto const &device_counters) {
+      auto counters = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{},
+                                                          device_counters);
+      int const n = counters.extent(0);
+      long long total = 0;
+      int max = 0;
+      int argmax = -1;
+      for (int i = 0; i < n; ++i)
+      {
+        total += counters(i);
+        if (counters(i) > max)
+        {
+          max = counters(i);
+          argmax = i;
+        }
+      }
+      os << "  " << label << ": total " << total << ", mean "
+         << (n > 0 ? (double)total / n : 0.) << ", max " << max;
+      if (argmax >= 0)
+        os << " (query " << argmax << ")";
+      os << '\n';
+    };
+
+    os << "ArborX traversal statistics over "
+       << internal_nodes_visited.extent(0) << " queries\n";
+    print("internal nodes visited", internal_nodes_visited);
+    print("leaf tests", leaf_tests);
+    print("heap pushes", heap_pushes);
+  }
+};
+
+} // namespace Experimental
+
+namespace Details
+{
+
+template <typename BVH, typename Predicates, typename Callback,
+          typename Statistics>
+struct SpatialTraversalWithStatistics
+{
+  BVH _bvh;
+  Predicates _predicates;
+  Callback _callback;
+  Statistics _stats;
+
+  template <typename ExecutionSpace>
+  SpatialTraversalWithStatistics(ExecutionSpace const &space, BVH const &bvh,
+                                 Predicates const &predicates,
+                                 Callback const &callback,
+                                 Statistics const &stats)
+      : _bvh{bvh}
+      , _predicates{predicates}
+      , _callback{callback}
+      , _stats{stats}
+  {
+    Kokkos::parallel_for("ArborX::TreeTraversal::spatial_with_statistics",
+                         Kokkos::RangePolicy<ExecutionSpace>(
+                             space, 0, predicates.size()),
+                         *this);
+  }
+
+  KOKKOS_FUNCTION void operator()(int queryIndex) const
+  {
+    auto const &predicate = _predicates(queryIndex);
+
+    int internal_count = 0;
+    int leaf_count = 0;
+
+    int node = HappyTreeFriends::getRoot(_bvh);
+    do
+    {
+      if (HappyTreeFriends::isLeaf(_bvh, node))
+      {
+        ++leaf_count;
+        if (predicate(HappyTreeFriends::getIndexable(_bvh, node)) &&
+            invoke_callback_and_check_early_exit(
+                _callback, predicate, HappyTreeFriends::getValue(_bvh, node)))
+          break;
+        node = HappyTreeFriends::getRope(_bvh, node);
+      }
+      else
+      {
+        ++internal_count;
+        node =
+            (predicate(HappyTreeFriends::getInternalBoundingVolume(_bvh, node))
+                 ? HappyTreeFriends::getLeftChild(_bvh, node)
+                 : HappyTreeFriends::getRope(_bvh, node));
+      }
+    } while (node != ROPE_SENTINEL);
+
+    _stats.internal_nodes_visited(queryIndex) = internal_count;
+    _stats.leaf_tests(queryIndex) = leaf_count;
+  }
+};
+
+template <typename BVH, typename Predicates, typename Callback,
+          typename Statistics>
+struct NearestTraversalWithStatistics
+{
+  using MemorySpace = typename BVH::memory_space;
+
+  BVH _bvh;
+  Predicates _predicates;
+  Callback _callback;
+  Statistics _stats;
+
+  NearestBufferProvider<MemorySpace> _buffer;
+
+  template <typename ExecutionSpace>
+  NearestTraversalWithStatistics(ExecutionSpace const &space, BVH const &bvh,
+                                 Predicates const &predicates,
+                                 Callback const &callback,
+                                 Statistics const &stats)
+      : _bvh{bvh}
+      , _predicates{predicates}
+      , _callback{callback}
+      , _stats{stats}
+      , _buffer(space, predicates)
+  {
+    Kokkos::parallel_for("ArborX::TreeTraversal::nearest_with_statistics",
+                         Kokkos::RangePolicy<ExecutionSpace>(
+                             space, 0, predicates.size()),
+                         *this);
+  }
+
+  KOKKOS_FUNCTION void operator()(int queryIndex) const
+  {
+    auto const &predicate = _predicates(queryIndex);
+    auto const k = getK(predicate);
+    auto const buffer = _buffer(queryIndex);
+
+    if (k < 1)
+      return;
+
+    int internal_count = 0;
+    int leaf_count = 0;
+    int push_count = 0;
+
+    using PairIndexDistance =
+        typename NearestBufferProvider<MemorySpace>::PairIndexDistance;
+    struct CompareDistance
+    {
+      KOKKOS_INLINE_FUNCTION bool operator()(PairIndexDistance const &lhs,
+                                             PairIndexDistance const &rhs) const
+      {
+        return lhs.second < rhs.second;
+      }
+    };
+    PriorityQueue<PairIndexDistance, CompareDistance,
+                  UnmanagedStaticVector<PairIndexDistance>>
+        heap(UnmanagedStaticVector<PairIndexDistance>(buffer.data(),
+                                                      buffer.size()));
+
+    auto &bvh = _bvh;
+    auto const distance = [&predicate, &bvh](int j) {
+      return HappyTreeFriends::isLeaf(bvh, j)
+                 ? predicate.distance(HappyTreeFriends::getIndexable(bvh, j))
+                 : predicate.distance(
+                       HappyTreeFriends::getInternalBoundingVolume(bvh, j));
+    };
+
+    constexpr int SENTINEL = -1;
+    int stack[64];
+    auto *stack_ptr = stack;
+    *stack_ptr++ = SENTINEL;
+
+    int node = HappyTreeFriends::getRoot(_bvh);
+    int left_child;
+    int right_child;
+
+    float distance_left = 0.f;
+    float distance_right = 0.f;
+    float distance_node = 0.f;
+
+    auto radius = KokkosExt::ArithmeticTraits::infinity<float>::value;
+
+    auto const push_leaf = [&](int leaf, float leaf_distance) {
+      ++push_count;
+      auto leaf_pair = Kokkos::make_pair(leaf, leaf_distance);
+      if ((int)heap.size() < k)
+        heap.push(leaf_pair);
+      else
+        heap.popPush(leaf_pair);
+      if ((int)heap.size() == k)
+        radius = heap.top().second;
+    };
+
+    do
+    {
+      bool traverse_left = false;
+      bool traverse_right = false;
+
+      if (distance_node < radius)
+      {
+        ++internal_count;
+        left_child = HappyTreeFriends::getLeftChild(_bvh, node);
+        right_child = HappyTreeFriends::getRightChild(_bvh, node);
+
+        distance_left = distance(left_child);
+        distance_right = distance(right_child);
+
+        if (HappyTreeFriends::isLeaf(_bvh, left_child))
+          ++leaf_count;
+        if (HappyTreeFriends::isLeaf(_bvh, right_child))
+          ++leaf_count;
+
+        if (distance_left < radius)
+        {
+          if (HappyTreeFriends::isLeaf(_bvh, left_child))
+            push_leaf(left_child, distance_left);
+          else
+            traverse_left = true;
+        }
+
+        // Note: radius may have been already updated here from the left child
+        if (distance_right < radius)
+        {
+          if (HappyTreeFriends::isLeaf(_bvh, right_child))
+            push_leaf(right_child, distance_right);
+          else
+            traverse_right = true;
+        }
+      }
+
+      if (!traverse_left && !traverse_right)
+      {
+        node = *--stack_ptr;
+        if (node != SENTINEL)
+          distance_node = distance(node);
+      }
+      else
+      {
+        node = (traverse_left &&
+                (distance_left <= distance_right || !traverse_right))
+                   ? left_child
+                   : right_child;
+        distance_node = (node == left_child ? distance_left : distance_right);
+        if (traverse_left && traverse_right)
+          *stack_ptr++ = (node == left_child ? right_child : left_child);
+      }
+    } while (node != SENTINEL);
+
+    sortHeap(heap.data(), heap.data() + heap.size(), heap.valueComp());
+    for (decltype(heap.size()) i = 0; i < heap.size(); ++i)
+    {
+      _callback(predicate,
+                HappyTreeFriends::getValue(_bvh, (heap.data() + i)->first));
+    }
+
+    _stats.internal_nodes_visited(queryIndex) = internal_count;
+    _stats.leaf_tests(queryIndex) = leaf_count;
+    _stats.heap_pushes(queryIndex) = push_count;
+  }
+};
+
+template <typename ExecutionSpace, typename BVH, typename Predicates,
+          typename Callback, typename Statistics>
+SpatialTraversalWithStatistics(ExecutionSpace, BVH, Predicates, Callback,
+                               Statistics)
+    -> SpatialTraversalWithStatistics<BVH, Predicates, Callback, Statistics>;
+
+template <typename ExecutionSpace, typename BVH, typename Predicates,
+          typename Callback, typename Statistics>
+NearestTraversalWithStatistics(ExecutionSpace, BVH, Predicates, Callback,
+                               Statistics)
+    -> NearestTraversalWithStatistics<BVH, Predicates, Callback, Statistics>;
+
+// Per-node counterpart of the per-query statistics: every node touched by a
+// traversal bumps its own counter instead of the query's. The recorders
+// deliver no results (the traversal shape only depends on the predicates),
+// they only accumulate, so several batches can share one counter view.
+template <typename BVH, typename Predicates, typename Visits>
+struct SpatialNodeVisitRecorder
+{
+  BVH _bvh;
+  Predicates _predicates;
+  Visits _visits;
+
+  template <typename ExecutionSpace>
+  SpatialNodeVisitRecorder(ExecutionSpace const &space, BVH const &bvh,
+                           Predicates const &predicates, Visits const &visits)
+      : _bvh{bvh}
+      , _predicates{predicates}
+      , _visits{visits}
+  {
+    Kokkos::parallel_for("ArborX::TreeTraversal::spatial_record_node_visits",
+                         Kokkos::RangePolicy<ExecutionSpace>(
+                             space, 0, predicates.size()),
+                         *this);
+  }
+
+  KOKKOS_FUNCTION void operator()(int queryIndex) const
+  {
+    auto const &predicate = _predicates(queryIndex);
+
+    int node = HappyTreeFriends::getRoot(_bvh);
+    do
+    {
+      Kokkos::atomic_increment(&_visits(node));
+      if (HappyTreeFriends::isLeaf(_bvh, node))
+      {
+        node = HappyTreeFriends::getRope(_bvh, node);
+      }
+      else
+      {
+        node =
+            (predicate(HappyTreeFriends::getInternalBoundingVolume(_bvh, node))
+                 ? HappyTreeFriends::getLeftChild(_bvh, node)
+                 : HappyTreeFriends::getRope(_bvh, node));
+      }
+    } while (node != ROPE_SENTINEL);
+  }
+};
+
+template <typename BVH, typename Predicates, typename Visits>
+struct NearestNodeVisitRecorder
+{
+  using MemorySpace = typename BVH::memory_space;
+
+  BVH _bvh;
+  Predicates _predicates;
+  Visits _visits;
+
+  NearestBufferProvider<MemorySpace> _buffer;
+
+  template <typename ExecutionSpace>
+  NearestNodeVisitRecorder(ExecutionSpace const &space, BVH const &bvh,
+                           Predicates const &predicates, Visits const &visits)
+      : _bvh{bvh}
+      , _predicates{predicates}
+      , _visits{visits}
+      , _buffer(space, predicates)
+  {
+    Kokkos::parallel_for("ArborX::TreeTraversal::nearest_record_node_visits",
+                         Kokkos::RangePolicy<ExecutionSpace>(
+                             space, 0, predicates.size()),
+                         *this);
+  }
+
+  KOKKOS_FUNCTION void operator()(int queryIndex) const
+  {
+    auto const &predicate = _predicates(queryIndex);
+    auto const k = getK(predicate);
+    auto const buffer = _buffer(queryIndex);
+
+    if (k < 1)
+      return;
+
+    using PairIndexDistance =
+        typename NearestBufferProvider<MemorySpace>::PairIndexDistance;
+    struct CompareDistance
+    {
+      KOKKOS_INLINE_FUNCTION bool operator()(PairIndexDistance const &lhs,
+                                             PairIndexDistance const &rhs) const
+      {
+        return lhs.second < rhs.second;
+      }
+    };
+    PriorityQueue<PairIndexDistance, CompareDistance,
+                  UnmanagedStaticVector<PairIndexDistance>>
+        heap(UnmanagedStaticVector<PairIndexDistance>(buffer.data(),
+                                                      buffer.size()));
+
+    auto &bvh = _bvh;
+    auto const distance = [&predicate, &bvh](int j) {
+      return HappyTreeFriends::isLeaf(bvh, j)
+                 ? predicate.distance(HappyTreeFriends::getIndexable(bvh, j))
+                 : predicate.distance(
+                       HappyTreeFriends::getInternalBoundingVolume(bvh, j));
+    };
+
+    constexpr int SENTINEL = -1;
+    int stack[64];
+    auto *stack_ptr = stack;
+    *stack_ptr++ = SENTINEL;
+
+    int node = HappyTreeFriends::getRoot(_bvh);
+    int left_child;
+    int right_child;
+
+    float distance_left = 0.f;
+    float distance_right = 0.f;
+    float distance_node = 0.f;
+
+    auto radius = KokkosExt::ArithmeticTraits::infinity<float>::value;
+
+    auto const push_leaf = [&](int leaf, float leaf_distance) {
+      auto leaf_pair = Kokkos::make_pair(leaf, leaf_distance);
+      if ((int)heap.size() < k)
+        heap.push(leaf_pair);
+      else
+        heap.popPush(leaf_pair);
+      if ((int)heap.size() == k)
+        radius = heap.top().second;
+    };
+
+    do
+    {
+      bool traverse_left = false;
+      bool traverse_right = false;
+
+      if (distance_node < radius)
+      {
+        Kokkos::atomic_increment(&_visits(node));
+        left_child = HappyTreeFriends::getLeftChild(_bvh, node);
+        right_child = HappyTreeFriends::getRightChild(_bvh, node);
+
+        distance_left = distance(left_child);
+        distance_right = distance(right_child);
+
+        if (HappyTreeFriends::isLeaf(_bvh, left_child))
+          Kokkos::atomic_increment(&_visits(left_child));
+        if (HappyTreeFriends::isLeaf(_bvh, right_child))
+          Kokkos::atomic_increment(&_visits(right_child));
+
+        if (distance_left < radius)
+        {
+          if (HappyTreeFriends::isLeaf(_bvh, left_child))
+            push_leaf(left_child, distance_left);
+          else
+            traverse_left = true;
+        }
+
+        // Note: radius may have been already updated here from the left child
+        if (distance_right < radius)
+        {
+          if (HappyTreeFriends::isLeaf(_bvh, right_child))
+            push_leaf(right_child, distance_right);
+          else
+            traverse_right = true;
+        }
+      }
+
+      if (!traverse_left && !traverse_right)
+      {
+        node = *--stack_ptr;
+        if (node != SENTINEL)
+          distance_node = distance(node);
+      }
+      else
+      {
+        node = (traverse_left &&
+                (distance_left <= distance_right || !traverse_right))
+                   ? left_child
+                   : right_child;
+        distance_node = (node == left_child ? distance_left : distance_right);
+        if (traverse_left && traverse_right)
+          *stack_ptr++ = (node == left_child ? right_child : left_child);
+      }
+    } while (node != SENTINEL);
+  }
+};
+
+template <typename ExecutionSpace, typename BVH, typename Predicates,
+          typename Visits>
+SpatialNodeVisitRecorder(ExecutionSpace, BVH, Predicates, Visits)
+    -> SpatialNodeVisitRecorder<BVH, Predicates, Visits>;
+
+template <typename ExecutionSpace, typename BVH, typename Predicates,
+          typename Visits>
+NearestNodeVisitRecorder(ExecutionSpace, BVH, Predicates, Visits)
+    -> NearestNodeVisitRecorder<BVH, Predicates, Visits>;
+
+template <typename ExecutionSpace, typename BVH, typename Predicates,
+          typename Visits>
+void recordNodeVisitsDispatch(ExecutionSpace const &space, BVH const &bvh,
+                              Predicates const &predicates,
+                              Visits const &visits)
+{
+  using Tag = typename Predicates::value_type::Tag;
+
+  if constexpr (std::is_same_v<Tag, SpatialPredicateTag>)
+    SpatialNodeVisitRecorder(space, bvh, predicates, visits);
+  else
+  {
+    static_assert(std::is_same_v<Tag, NearestPredicateTag>,
+                  "Node visit recording is only implemented for spatial and "
+                  "nearest predicates");
+    NearestNodeVisitRecorder(space, bvh, predicates, visits);
+  }
+}
+
+template <typename ExecutionSpace, typename BVH, typename Predicates,
+          typename Callback, typename Statistics>
+void traverseWithStatistics(ExecutionSpace const &space, BVH const &bvh,
+                            Predicates const &predicates,
+                            Callback const &callback, Statistics const &stats)
+{
+  using Tag = typename Predicates::value_type::Tag;
+
+  if (bvh.size() <= 1)
+  {
+    // Degenerate trees perform no real traversal; the counters stay zero
+    traverse(space, bvh, predicates, callback);
+    return;
+  }
+
+  if constexpr (std::is_same_v<Tag, SpatialPredicateTag>)
+    SpatialTraversalWithStatistics(space, bvh, predicates, callback, stats);
+  else
+  {
+    static_assert(std::is_same_v<Tag, NearestPredicateTag>,
+                  "Traversal statistics are only implemented for spatial and "
+                  "nearest predicates");
+    NearestTraversalWithStatistics(space, bvh, predicates, callback, stats);
+  }
+}
+
+} // namespace Details
+
+namespace Experimental
+{
+
+// Same as tree.query() with a callback, except that per-query traversal
+// counters are accumulated into `stats`. The instrumented kernels are
+// separate from the regular ones, so the standard query path pays nothing.
+// Predicates are not sorted, keeping the counters in the callers' order.
+template <typename Tree, typename ExecutionSpace, typename UserPredicates,
+          typename Callback>
+void queryWithStatistics(Tree const &tree, ExecutionSpace const &space,
+                         UserPredicates const &user_predicates,
+                         Callback const &callback,
+                         TraversalStatistics<typename Tree::memory_space> &stats)
+{
+  using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+  static_assert(Details::KokkosExt::is_accessible_from<
+                    typename Predicates::memory_space, ExecutionSpace>::value,
+                "Predicates must be accessible from the execution space");
+
+  Predicates predicates{user_predicates}; // NOLINT
+
+  stats.reset(space, predicates.size());
+  Details::traverseWithStatistics(space, tree, predicates, callback, stats);
+}
+
+// Accumulate how many times each tree node is visited over a query batch.
+// The counters are indexed like the nodes: entries [0, size()) count the
+// leaf tests of the corresponding leaves, entries [size(), 2 * size() - 1)
+// the visits of the internal nodes, with the root at entry size(). The view
+// is resized and zeroed when its extent does not match the tree and
+// accumulated into otherwise, so consecutive batches over the same tree form
+// one recording epoch. The traversal delivers no results; its shape only
+// depends on the predicates. Feed the recorded counts to
+// optimize(space, visits) to restructure the tree for the recorded query
+// distribution.
+template <typename Tree, typename ExecutionSpace, typename UserPredicates,
+          typename Visits>
+void recordNodeVisits(Tree const &tree, ExecutionSpace const &space,
+                      UserPredicates const &user_predicates, Visits &visits)
+{
+  static_assert(Kokkos::is_view_v<Visits>);
+
+  using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+  static_assert(Details::KokkosExt::is_accessible_from<
+                    typename Predicates::memory_space, ExecutionSpace>::value,
+                "Predicates must be accessible from the execution space");
+
+  Predicates predicates{user_predicates}; // NOLINT
+
+  int const n = tree.size();
+  int const num_nodes = (n > 0 ? 2 * n - 1 : 0);
+  if (visits.extent_int(0) != num_nodes)
+  {
+    Details::KokkosExt::reallocWithoutInitializing(space, visits, num_nodes);
+    Kokkos::deep_copy(space, visits, 0);
+  }
+
+  // Degenerate trees have no hierarchy to traverse
+  if (n <= 1)
+    return;
+
+  Details::recordNodeVisitsDispatch(space, tree, predicates, visits);
+}
+
+} // namespace Experimental
+
+} // namespace ArborX
+
+#endif
@@ -0,0 +1,226 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_TREE_QUALITY_HPP
+#define ARBORX_TREE_QUALITY_HPP
+
+#include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_DetailsHappyTreeFriends.hpp>
+#include <ArborX_DetailsTreeConstructionPLOC.hpp> // boundaryMeasure
+#include <ArborX_GeometryTraits.hpp>
+
+#include <ArborX_DetailsKokkosExtMinMaxOperations.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <algorithm>
+#include <ostream>
+#include <vector>
+
+namespace ArborX
+{
+
+namespace Details
+{
+
+// Boundary measure of the intersection of two boxes, zero when they do not
+// overlap
+template <typename Box>
+KOKKOS_FUNCTION auto overlapMeasure(Box const &a, Box const &b)
+{
+  constexpr int DIM = GeometryTraits::dimension_v<Box>;
+  Box common;
+  for (int d = 0; d < DIM; ++d)
+  {
+    auto const lo = KokkosExt::max(a.minCorner()[d], b.minCorner()[d]);
+    auto const hi = KokkosExt::min(a.maxCorner()[d], b.maxCorner()[d]);
+    if (lo > hi)
+      return decltype(TreeConstruction::boundaryMeasure(common)){0};
+    common.minCorner()[d] = lo;
+    common.maxCorner()[d] = hi;
+  }
+  return TreeConstruction::boundaryMeasure(common);
+}
+
+// Bounding box of any node of the tree, in the combined node indexing
+template <typename Tree>
+KOKKOS_FUNCTION auto treeNodeBox(Tree const &tree, int i)
+{
+  using BoundingVolume = typename Tree::bounding_volume_type;
+  if (HappyTreeFriends::isLeaf(tree, i))
+  {
+    BoundingVolume box{};
+    expand(box, HappyTreeFriends::getIndexable(tree, i));
+    return box;
+  }
+  return BoundingVolume(HappyTreeFriends::getInternalBoundingVolume(tree, i));
+}
+
+} // namespace Details
+
+namespace Experimental
+{
+
+// Host-side tree-quality summary computed by computeTreeQuality(). Cheap
+// enough to collect in production; paired with the traversal counters in
+// TraversalStatistics it separates "the tree is bad" from "the queries are
+// bad" when triaging a slow query batch.
+struct TreeQualityMetrics
+{
+  // Surface area heuristic cost with unit intersection costs: the sum of
+  // the boundary measures of all nodes divided by the root's. Lower is
+  // better; the LBVH builder typically lands 20-40% above what a
+  // high-quality builder reaches on the same input.
+  double sah_cost = 0;
+  // Sibling overlap of an internal node: the boundary measure of the
+  // intersection of its children relative to the node's own. High overlap
+  // forces traversals to descend into both children.
+  double mean_sibling_overlap = 0;
+  double max_sibling_overlap = 0;
+  int max_leaf_depth = 0;
+  // depth_histogram[d] is the number of leaves at depth d (the root's
+  // children are at depth 1)
+  std::vector<long long> depth_histogram;
+
+  void report(std::ostream &os) const
+  {
+    os << "ArborX tree quality\n";
+    os << "  SAH cost: " << sah_cost << '\n';
+    os << "  sibling overlap: mean " << mean_sibling_overlap << ", max "
+       << max_sibling_overlap << '\n';
+    os << "  leaf depth: max " << max_leaf_depth << ", histogram:\n";
+    for (int d = 0; d < (int)depth_histogram.size(); ++d)
+      if (depth_histogram[d] > 0)
+        os << "    depth " << d << ": " << depth_histogram[d] << '\n';
+  }
+};
+
+// Walk a built tree and summarize its quality. The tree's bounding volume
+// must be a box. Runs a handful of sweeps over the nodes, so the cost is
+// comparable to a refit and independent of any query workload.
+template <typename ExecutionSpace, typename Tree>
+TreeQualityMetrics computeTreeQuality(ExecutionSpace const &space,
+                                      Tree const &tree)
+{
+  using Details::HappyTreeFriends;
+  using MemorySpace = typename Tree::memory_space;
+
+  Kokkos::Profiling::ScopedRegion guard("ArborX::computeTreeQuality");
+
+  TreeQualityMetrics metrics;
+
+  int const n = tree.size();
+  if (n <= 1)
+  {
+    metrics.sah_cost = (n == 1 ? 1. : 0.);
+    metrics.depth_histogram.assign(1, n);
+    return metrics;
+  }
+
+  using Details::TreeConstruction::boundaryMeasure;
+
+  double sum_internal_measure = 0;
+  double sum_overlap = 0;
+  double max_overlap = 0;
+  Kokkos::parallel_reduce(
+      "ArborX::TreeQuality::internal_nodes",
+      Kokkos::RangePolicy<ExecutionSpace>(space, n, 2 * n - 1),
+      KOKKOS_LAMBDA(int i, double &measure_update, double &overlap_update,
+                    double &max_overlap_update) {
+        auto const &box = HappyTreeFriends::getInternalBoundingVolume(tree, i);
+        auto const measure = boundaryMeasure(box);
+        measure_update += measure;
+
+        auto const overlap = Details::overlapMeasure(
+            Details::treeNodeBox(tree, HappyTreeFriends::getLeftChild(tree, i)),
+            Details::treeNodeBox(tree,
+                                 HappyTreeFriends::getRightChild(tree, i)));
+        double const relative_overlap =
+            (measure > 0 ? overlap / measure : 0.);
+        overlap_update += relative_overlap;
+        if (relative_overlap > max_overlap_update)
+          max_overlap_update = relative_overlap;
+      },
+      sum_internal_measure, sum_overlap, Kokkos::Max<double>(max_overlap));
+
+  double sum_leaf_measure = 0;
+  Kokkos::parallel_reduce(
+      "ArborX::TreeQuality::leaves",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i, double &update) {
+        update += boundaryMeasure(Details::treeNodeBox(tree, i));
+      },
+      sum_leaf_measure);
+
+  double const root_measure = boundaryMeasure(tree.bounds());
+  metrics.sah_cost =
+      (root_measure > 0
+           ? (sum_internal_measure + sum_leaf_measure) / root_measure
+           : 0.);
+  metrics.mean_sibling_overlap = sum_overlap / (n - 1);
+  metrics.max_sibling_overlap = max_overlap;
+
+  // Leaf depths: recover the parents from the connectivity and climb. The
+  // climbs are O(depth) each, which is the same order as a traversal.
+  Kokkos::View<int *, MemorySpace> parents(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::TreeQuality::parents"),
+      2 * n - 1);
+  Kokkos::parallel_for(
+      "ArborX::TreeQuality::compute_parents",
+      Kokkos::RangePolicy<ExecutionSpace>(space, n, 2 * n - 1),
+      KOKKOS_LAMBDA(int i) {
+        parents(HappyTreeFriends::getLeftChild(tree, i)) = i;
+        parents(HappyTreeFriends::getRightChild(tree, i)) = i;
+        if (i == HappyTreeFriends::getRoot(tree))
+          parents(i) = -1;
+      });
+
+  constexpr int max_bins = 128; // deeper leaves land in the last bin
+  Kokkos::View<long long *, MemorySpace> histogram(
+      Kokkos::view_alloc(space, "ArborX::TreeQuality::histogram"), max_bins);
+  int max_depth = 0;
+  Kokkos::parallel_reduce(
+      "ArborX::TreeQuality::leaf_depths",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i, int &update) {
+        int depth = 0;
+        int node = i;
+        while (parents(node) != -1)
+        {
+          node = parents(node);
+          ++depth;
+        }
+        Kokkos::atomic_increment(
+            &histogram(depth < max_bins ? depth : max_bins - 1));
+        if (depth > update)
+          update = depth;
+      },
+      Kokkos::Max<int>(max_depth));
+  metrics.max_leaf_depth = max_depth;
+
+  auto histogram_host =
+      Kokkos::create_mirror_view(Kokkos::HostSpace{}, histogram);
+  Kokkos::deep_copy(space, histogram_host, histogram);
+  space.fence("ArborX::computeTreeQuality (copy histogram to host)");
+  int const num_bins = std::min(max_depth + 1, max_bins);
+  metrics.depth_histogram.assign(histogram_host.data(),
+                                 histogram_host.data() + num_bins);
+
+  return metrics;
+}
+
+} // namespace Experimental
+
+} // namespace ArborX
+
+#endif
@@ -0,0 +1,79 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#ifndef ARBORX_BOUNDING_SPHERE_HPP
+#define ARBORX_BOUNDING_SPHERE_HPP
+
+#include <ArborX_GeometryTraits.hpp>
+#include <ArborX_HyperPoint.hpp>
+
+#include <Kokkos_Macros.hpp>
+
+namespace ArborX::Experimental
+{
+
+// Sphere meant to serve as the internal bounding volume of a hierarchy.
+// Testing a point against a sphere is one difference and one dot product,
+// where the box test clamps per axis, so for nearest-dominated workloads the
+// shorter test per visited node can outweigh the looser fit. Unlike
+// ArborX::Sphere, whose default state is a legitimate zero-radius sphere at
+// the origin, a default-constructed BoundingSphere is empty (negative
+// radius): it intersects nothing and expanding it adopts the other geometry,
+// which is what the construction and refit kernels expect of a
+// value-initialized volume.
+template <int DIM, class Coordinate = float>
+struct BoundingSphere
+{
+  KOKKOS_DEFAULTED_FUNCTION
+  BoundingSphere() = default;
+
+  KOKKOS_FUNCTION
+  constexpr BoundingSphere(
+      ExperimentalHyperGeometry::Point<DIM, Coordinate> const &centroid,
+      Coordinate radius)
+      : _centroid(centroid)
+      , _radius(radius)
+  {}
+
+  KOKKOS_FUNCTION
+  constexpr auto &centroid() { return _centroid; }
+
+  KOKKOS_FUNCTION
+  constexpr auto const &centroid() const { return _centroid; }
+
+  KOKKOS_FUNCTION
+  constexpr auto radius() const { return _radius; }
+
+  ExperimentalHyperGeometry::Point<DIM, Coordinate> _centroid = {};
+  Coordinate _radius = -1;
+};
+
+} // namespace ArborX::Experimental
+
+template <int DIM, class Coordinate>
+struct ArborX::GeometryTraits::dimension<
+    ArborX::Experimental::BoundingSphere<DIM, Coordinate>>
+{
+  static constexpr int value = DIM;
+};
+template <int DIM, class Coordinate>
+struct ArborX::GeometryTraits::tag<
+    ArborX::Experimental::BoundingSphere<DIM, Coordinate>>
+{
+  using type = SphereTag;
+};
+template <int DIM, class Coordinate>
+struct ArborX::GeometryTraits::coordinate_type<
+    ArborX::Experimental::BoundingSphere<DIM, Coordinate>>
+{
+  using type = Coordinate;
+};
+
+#endif
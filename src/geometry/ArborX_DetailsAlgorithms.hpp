@@ -30,6 +30,8 @@ namespace Dispatch
 {
 using GeometryTraits::BoxTag;
 using GeometryTraits::KDOPTag;
+using GeometryTraits::MaskedTag;
+using GeometryTraits::OBBTag;
 using GeometryTraits::PointTag;
 using GeometryTraits::RayTag;
 using GeometryTraits::SphereTag;
@@ -219,17 +221,23 @@ struct distance<PointTag, BoxTag, Point, Box>
   KOKKOS_FUNCTION static auto apply(Point const &point, Box const &box)
   {
     constexpr int DIM = GeometryTraits::dimension_v<Point>;
-    Point projected_point;
+
+    using KokkosExt::max;
+    using KokkosExt::min;
+
+    // Clamping with min/max instead of comparing keeps the fully unrolled
+    // loop free of branches, which matters for the higher dimensions where
+    // this dominates the nearest traversal
+    using Coordinate = decltype(point[0] - box.minCorner()[0]);
+    Coordinate distance_squared = 0;
     for (int d = 0; d < DIM; ++d)
     {
-      if (point[d] < box.minCorner()[d])
-        projected_point[d] = box.minCorner()[d];
-      else if (point[d] > box.maxCorner()[d])
-        projected_point[d] = box.maxCorner()[d];
-      else
-        projected_point[d] = point[d];
+      Coordinate const x = point[d];
+      auto tmp = x - min(max(x, (Coordinate)box.minCorner()[d]),
+                         (Coordinate)box.maxCorner()[d]);
+      distance_squared += tmp * tmp;
     }
-    return Details::distance(point, projected_point);
+    return Kokkos::sqrt(distance_squared);
   }
 };
 
@@ -263,8 +271,12 @@ struct distance<PointTag, TriangleTag, Point, Triangle>
       r[d] = u * a[d] + v * b[d] + w * c[d];
     return r;
   }
+  // The edge vectors ab and ac may be precomputed once per triangle (see
+  // PrecomputedTriangle) instead of being derived from the vertices here
+  template <typename Vector>
   KOKKOS_FUNCTION static auto closest_point(Point const &p, Point const &a,
-                                            Point const &b, Point const &c)
+                                            Point const &b, Point const &c,
+                                            Vector const &ab, Vector const &ac)
   {
     /* Zones
            \ 2/
@@ -278,8 +290,6 @@ struct distance<PointTag, TriangleTag, Point, Triangle>
         |        |
     */
 
-    auto const ab = b - a;
-    auto const ac = c - a;
     auto const ap = p - a;
 
     auto const d1 = ab.dot(ap);
@@ -333,7 +343,7 @@ struct distance<PointTag, TriangleTag, Point, Triangle>
     auto const &b = triangle.b;
     auto const &c = triangle.c;
 
-    return Details::distance(p, closest_point(p, a, b, c));
+    return Details::distance(p, closest_point(p, a, b, c, b - a, c - a));
   }
 };
 
@@ -442,6 +452,100 @@ struct expand<BoxTag, SphereTag, Box, Sphere>
   }
 };
 
+// expand a sphere to include a point
+template <typename Sphere, typename Point>
+struct expand<SphereTag, PointTag, Sphere, Point>
+{
+  KOKKOS_FUNCTION static void apply(Sphere &sphere, Point const &point)
+  {
+    using Coordinate = typename GeometryTraits::coordinate_type_t<Sphere>;
+    constexpr int DIM = GeometryTraits::dimension_v<Sphere>;
+
+    auto center = sphere.centroid();
+    if (sphere.radius() < 0)
+    {
+      // An empty sphere adopts the point
+      for (int d = 0; d < DIM; ++d)
+        center[d] = point[d];
+      sphere = {center, 0};
+      return;
+    }
+    Coordinate const dist = Details::distance(point, center);
+    if (dist <= sphere.radius())
+      return;
+    // Grow by the minimal amount: the far pole stays put and the near side
+    // moves out to touch the point
+    Coordinate const radius = (dist + sphere.radius()) / 2;
+    Coordinate const alpha = (radius - sphere.radius()) / dist;
+    for (int d = 0; d < DIM; ++d)
+      center[d] += alpha * (point[d] - center[d]);
+    sphere = {center, radius};
+  }
+};
+
+// expand a sphere to include a sphere
+template <typename Sphere, typename OtherSphere>
+struct expand<SphereTag, SphereTag, Sphere, OtherSphere>
+{
+  KOKKOS_FUNCTION static void apply(Sphere &sphere, OtherSphere const &other)
+  {
+    using Coordinate = typename GeometryTraits::coordinate_type_t<Sphere>;
+    constexpr int DIM = GeometryTraits::dimension_v<Sphere>;
+
+    if (other.radius() < 0)
+      return;
+
+    auto center = sphere.centroid();
+    auto const adopt_other = [&]() {
+      for (int d = 0; d < DIM; ++d)
+        center[d] = other.centroid()[d];
+      sphere = {center, (Coordinate)other.radius()};
+    };
+    if (sphere.radius() < 0)
+    {
+      adopt_other();
+      return;
+    }
+    Coordinate const dist = Details::distance(other.centroid(), center);
+    if (dist + other.radius() <= sphere.radius())
+      return;
+    if (dist + sphere.radius() <= other.radius())
+    {
+      adopt_other();
+      return;
+    }
+    Coordinate const radius = (dist + sphere.radius() + other.radius()) / 2;
+    Coordinate const alpha = (radius - sphere.radius()) / dist;
+    for (int d = 0; d < DIM; ++d)
+      center[d] += alpha * (other.centroid()[d] - center[d]);
+    sphere = {center, radius};
+  }
+};
+
+// expand a sphere to include a box
+template <typename Sphere, typename Box>
+struct expand<SphereTag, BoxTag, Sphere, Box>
+{
+  KOKKOS_FUNCTION static void apply(Sphere &sphere, Box const &box)
+  {
+    using Coordinate = typename GeometryTraits::coordinate_type_t<Sphere>;
+    constexpr int DIM = GeometryTraits::dimension_v<Sphere>;
+
+    // The tightest sphere around the box is centered at its centroid with
+    // the half-diagonal as radius
+    auto center = sphere.centroid();
+    Coordinate radius_squared = 0;
+    for (int d = 0; d < DIM; ++d)
+    {
+      center[d] = (box.minCorner()[d] + box.maxCorner()[d]) / 2;
+      Coordinate const half = (box.maxCorner()[d] - box.minCorner()[d]) / 2;
+      radius_squared += half * half;
+    }
+    Details::expand(sphere,
+                    Sphere{center, (Coordinate)Kokkos::sqrt(radius_squared)});
+  }
+};
+
 // expand a box to include a triangle
 template <typename Box, typename Triangle>
 struct expand<BoxTag, TriangleTag, Box, Triangle>
@@ -517,6 +621,29 @@ struct intersects<PointTag, SphereTag, Point, Sphere>
   }
 };
 
+// check if two spheres intersect
+template <typename Sphere1, typename Sphere2>
+struct intersects<SphereTag, SphereTag, Sphere1, Sphere2>
+{
+  KOKKOS_FUNCTION static constexpr bool apply(Sphere1 const &sphere,
+                                              Sphere2 const &other)
+  {
+    return Details::distance(sphere.centroid(), other.centroid()) <=
+           sphere.radius() + other.radius();
+  }
+};
+
+// check if an axis-aligned bounding box intersects with a sphere
+template <typename Box, typename Sphere>
+struct intersects<BoxTag, SphereTag, Box, Sphere>
+{
+  KOKKOS_FUNCTION static constexpr bool apply(Box const &box,
+                                              Sphere const &sphere)
+  {
+    return Details::intersects(sphere, box);
+  }
+};
+
 template <typename Point, typename Triangle>
 struct intersects<PointTag, TriangleTag, Point, Triangle>
 {
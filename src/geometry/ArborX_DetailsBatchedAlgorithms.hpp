@@ -0,0 +1,91 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#ifndef ARBORX_DETAILS_BATCHED_ALGORITHMS_HPP
+#define ARBORX_DETAILS_BATCHED_ALGORITHMS_HPP
+
+#include <ArborX_DetailsAlgorithms.hpp>
+
+#include <Kokkos_Macros.hpp>
+
+// Batch variants of the core geometry kernels. The scalar kernels reduce to
+// branch-free arithmetic once inlined; what keeps host compilers from
+// vectorizing the hot loops is the data-dependent control flow interleaved by
+// the callers (heap updates, callbacks, reduction joins). These helpers pull
+// a straight run of geometry arithmetic out of such loops so that it
+// auto-vectorizes, and leave the control flow to a separate pass over the
+// results.
+namespace ArborX::Details::Batched
+{
+
+// Number of primitives processed per batch. Callers size their local result
+// arrays with it; it is intentionally small enough to stay in registers.
+inline constexpr int batch_size = 16;
+
+// Expand a bounding volume to include the primitives in [begin, end)
+template <typename BoundingVolume, typename Primitives>
+KOKKOS_FUNCTION void expand(BoundingVolume &bounding_volume,
+                            Primitives const &primitives, int begin, int end)
+{
+  for (int i = begin; i < end; ++i)
+    Details::expand(bounding_volume, primitives(i));
+}
+
+// Distances from a geometry to the primitives in [begin, end), written to
+// out[0], ..., out[end - begin - 1]
+template <typename Geometry, typename Primitives, typename Coordinate>
+KOKKOS_FUNCTION void distance(Geometry const &geometry,
+                              Primitives const &primitives, int begin, int end,
+                              Coordinate *out)
+{
+  for (int i = begin; i < end; ++i)
+    out[i - begin] = Details::distance(geometry, primitives(i));
+}
+
+// Squared distances from a point to the point primitives in [begin, end)
+// through the Gram identity |q - p|^2 = |q|^2 - 2 q.p + |p|^2, with the
+// squared norms supplied by the caller. The loop body is a pure dot product,
+// the same tile shape dense linear algebra kernels use, so it maps onto
+// vector units (and fused multiply-add pipelines) better than the
+// subtract-square form. The identity cancels catastrophically in floating
+// point when |q - p| is small relative to the norms, so the results are a
+// screen, not a substitute for the exact distance.
+template <typename Point, typename Primitives, typename Norms,
+          typename Coordinate>
+KOKKOS_FUNCTION void
+distanceSquaredGram(Point const &point, Coordinate point_norm2,
+                    Primitives const &primitives, Norms const &norms2,
+                    int begin, int end, Coordinate *out)
+{
+  constexpr int DIM = GeometryTraits::dimension_v<Point>;
+  for (int i = begin; i < end; ++i)
+  {
+    auto const &primitive = primitives(i);
+    Coordinate dot = 0;
+    for (int d = 0; d < DIM; ++d)
+      dot += point[d] * primitive[d];
+    out[i - begin] = point_norm2 - 2 * dot + norms2(i);
+  }
+}
+
+// Intersection tests of a geometry against the primitives in [begin, end),
+// written to out[0], ..., out[end - begin - 1]
+template <typename Geometry, typename Primitives>
+KOKKOS_FUNCTION void intersects(Geometry const &geometry,
+                                Primitives const &primitives, int begin,
+                                int end, bool *out)
+{
+  for (int i = begin; i < end; ++i)
+    out[i - begin] = Details::intersects(geometry, primitives(i));
+}
+
+} // namespace ArborX::Details::Batched
+
+#endif
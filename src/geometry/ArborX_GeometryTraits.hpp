@@ -61,16 +61,21 @@ DEFINE_GEOMETRY(box, BoxTag);
 DEFINE_GEOMETRY(sphere, SphereTag);
 DEFINE_GEOMETRY(triangle, TriangleTag);
 DEFINE_GEOMETRY(kdop, KDOPTag);
+DEFINE_GEOMETRY(obb, OBBTag);
+DEFINE_GEOMETRY(masked, MaskedTag);
 DEFINE_GEOMETRY(tetrahedron, TetrahedronTag);
 DEFINE_GEOMETRY(ray, RayTag);
+DEFINE_GEOMETRY(periodic_sphere, PeriodicSphereTag);
 #undef DEFINE_GEOMETRY
 
 template <typename Geometry>
 inline constexpr bool
     is_valid_geometry = (is_point_v<Geometry> || is_box_v<Geometry> ||
                          is_sphere_v<Geometry> || is_kdop_v<Geometry> ||
+                         is_obb_v<Geometry> || is_masked_v<Geometry> ||
                          is_triangle_v<Geometry> ||
-                         is_tetrahedron_v<Geometry> || is_ray_v<Geometry>);
+                         is_tetrahedron_v<Geometry> || is_ray_v<Geometry> ||
+                         is_periodic_sphere_v<Geometry>);
 
 template <typename Geometry>
 using DimensionNotSpecializedArchetypeAlias =
@@ -112,7 +117,7 @@ void check_valid_geometry_traits(Geometry const &)
                 "GeometryTraits::tag<Geometry> must define 'type' member type");
   static_assert(is_valid_geometry<Geometry>,
                 "GeometryTraits::tag<Geometry>::type must be PointTag, BoxTag, "
-                "SphereTag, TriangleTag, KDOPTag, or RayTag");
+                "SphereTag, TriangleTag, KDOPTag, OBBTag, or RayTag");
 
   static_assert(!std::is_same_v<coordinate_type_t<Geometry>, not_specialized>,
                 "GeometryTraits::coordinate_type<Geometry> must define 'type' "
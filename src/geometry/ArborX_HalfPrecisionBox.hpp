@@ -0,0 +1,198 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_HALF_PRECISION_BOX_HPP
+#define ARBORX_HALF_PRECISION_BOX_HPP
+
+#include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_GeometryTraits.hpp>
+#include <ArborX_HyperBox.hpp>
+#include <ArborX_HyperPoint.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <cstdint>
+
+namespace ArborX::Experimental
+{
+
+/**
+ * Axis-aligned bounding box storing its corners in half precision, with the
+ * minimum corner rounded down and the maximum corner rounded up so that the
+ * stored box always contains the full-precision one. Intended as the
+ * bounding volume template parameter of a BoundingVolumeHierarchy: internal
+ * nodes then occupy half the bandwidth of full-precision ones, at the price
+ * of slightly looser boxes (more false positives, never false negatives).
+ * The corner accessors widen to the full-precision coordinate type, so all
+ * generic geometric algorithms read the box as usual.
+ */
+template <int DIM, class Coordinate = float>
+struct HalfPrecisionBox
+{
+  using storage_type = Kokkos::Experimental::half_t;
+
+  KOKKOS_FUNCTION
+  HalfPrecisionBox()
+  {
+    constexpr auto infinity =
+        Details::KokkosExt::ArithmeticTraits::infinity<Coordinate>::value;
+    for (int d = 0; d < DIM; ++d)
+    {
+      _min[d] = storage_type(infinity);
+      _max[d] = storage_type(-infinity);
+    }
+  }
+
+  KOKKOS_FUNCTION
+  explicit HalfPrecisionBox(
+      ExperimentalHyperGeometry::Box<DIM, Coordinate> const &box)
+  {
+    for (int d = 0; d < DIM; ++d)
+    {
+      _min[d] = roundDown(box.minCorner()[d]);
+      _max[d] = roundUp(box.maxCorner()[d]);
+    }
+  }
+
+  KOKKOS_FUNCTION
+  auto minCorner() const
+  {
+    ExperimentalHyperGeometry::Point<DIM, Coordinate> p;
+    for (int d = 0; d < DIM; ++d)
+      p[d] = (Coordinate)_min[d];
+    return p;
+  }
+
+  KOKKOS_FUNCTION
+  auto maxCorner() const
+  {
+    ExperimentalHyperGeometry::Point<DIM, Coordinate> p;
+    for (int d = 0; d < DIM; ++d)
+      p[d] = (Coordinate)_max[d];
+    return p;
+  }
+
+  // Largest half-precision value not exceeding x
+  static KOKKOS_FUNCTION storage_type roundDown(Coordinate x)
+  {
+    storage_type h(x);
+    // Backends without native half support fall back to single precision, in
+    // which case the conversion is exact
+    if constexpr (sizeof(storage_type) == sizeof(std::uint16_t))
+    {
+      if ((Coordinate)h > x)
+      {
+        auto bits = Kokkos::bit_cast<std::uint16_t>(h);
+        if (bits == 0x0000 || bits == 0x8000) // +/-0
+          bits = 0x8001;                      // smallest negative subnormal
+        else if (bits & 0x8000)
+          ++bits; // negative: increase the magnitude
+        else
+          --bits; // positive: decrease the magnitude
+        h = Kokkos::bit_cast<storage_type>(bits);
+      }
+    }
+    return h;
+  }
+
+  // Smallest half-precision value not less than x
+  static KOKKOS_FUNCTION storage_type roundUp(Coordinate x)
+  {
+    storage_type h(x);
+    if constexpr (sizeof(storage_type) == sizeof(std::uint16_t))
+    {
+      if ((Coordinate)h < x)
+      {
+        auto bits = Kokkos::bit_cast<std::uint16_t>(h);
+        if (bits == 0x0000 || bits == 0x8000) // +/-0
+          bits = 0x0001;                      // smallest positive subnormal
+        else if (bits & 0x8000)
+          --bits; // negative: decrease the magnitude
+        else
+          ++bits; // positive: increase the magnitude
+        h = Kokkos::bit_cast<storage_type>(bits);
+      }
+    }
+    return h;
+  }
+
+  storage_type _min[DIM];
+  storage_type _max[DIM];
+};
+
+} // namespace ArborX::Experimental
+
+template <int DIM, class Coordinate>
+struct ArborX::GeometryTraits::dimension<
+    ArborX::Experimental::HalfPrecisionBox<DIM, Coordinate>>
+{
+  static constexpr int value = DIM;
+};
+template <int DIM, class Coordinate>
+struct ArborX::GeometryTraits::tag<
+    ArborX::Experimental::HalfPrecisionBox<DIM, Coordinate>>
+{
+  using type = BoxTag;
+};
+template <int DIM, class Coordinate>
+struct ArborX::GeometryTraits::coordinate_type<
+    ArborX::Experimental::HalfPrecisionBox<DIM, Coordinate>>
+{
+  using type = Coordinate;
+};
+
+namespace ArborX::Details::Dispatch
+{
+
+// Expanding a half-precision box goes through full precision and converts
+// back with conservative outward rounding. The read-only algorithms
+// (intersects, distance, centroid) need no overloads as the widening corner
+// accessors make the generic implementations work as-is.
+template <int DIM, class Coordinate, typename Geometry>
+struct ExpandHalfPrecisionBox
+{
+  KOKKOS_FUNCTION static void
+  apply(Experimental::HalfPrecisionBox<DIM, Coordinate> &box,
+        Geometry const &geometry)
+  {
+    ExperimentalHyperGeometry::Box<DIM, Coordinate> widened{box.minCorner(),
+                                                            box.maxCorner()};
+    Details::expand(widened, geometry);
+    box = Experimental::HalfPrecisionBox<DIM, Coordinate>(widened);
+  }
+};
+
+template <int DIM, class Coordinate, typename Point>
+struct expand<BoxTag, PointTag, Experimental::HalfPrecisionBox<DIM, Coordinate>,
+              Point> : ExpandHalfPrecisionBox<DIM, Coordinate, Point>
+{};
+
+template <int DIM, class Coordinate, typename Box>
+struct expand<BoxTag, BoxTag, Experimental::HalfPrecisionBox<DIM, Coordinate>,
+              Box> : ExpandHalfPrecisionBox<DIM, Coordinate, Box>
+{};
+
+template <int DIM, class Coordinate, typename Sphere>
+struct expand<BoxTag, SphereTag,
+              Experimental::HalfPrecisionBox<DIM, Coordinate>, Sphere>
+    : ExpandHalfPrecisionBox<DIM, Coordinate, Sphere>
+{};
+
+template <int DIM, class Coordinate, typename Triangle>
+struct expand<BoxTag, TriangleTag,
+              Experimental::HalfPrecisionBox<DIM, Coordinate>, Triangle>
+    : ExpandHalfPrecisionBox<DIM, Coordinate, Triangle>
+{};
+
+} // namespace ArborX::Details::Dispatch
+
+#endif
@@ -11,6 +11,8 @@
 #ifndef ARBORX_TRIANGLE_HPP
 #define ARBORX_TRIANGLE_HPP
 
+#include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_DetailsVector.hpp>
 #include <ArborX_HyperPoint.hpp>
 
 namespace ArborX::ExperimentalHyperGeometry
@@ -31,6 +33,30 @@ Triangle(ExperimentalHyperGeometry::Point<DIM, Coordinate>,
          ExperimentalHyperGeometry::Point<DIM, Coordinate>)
     -> Triangle<DIM, Coordinate>;
 
+// Triangle that additionally carries quantities derived from its vertices.
+// Building it once, typically in the AccessTraits used for tree construction,
+// avoids recomputing the edge vectors and the barycentric transform in every
+// traversal-side test. It behaves as a regular triangle everywhere else.
+template <int DIM, class Coordinate = float>
+struct PrecomputedTriangle : Triangle<DIM, Coordinate>
+{
+  Details::Vector<DIM, Coordinate> ab; // b - a
+  Details::Vector<DIM, Coordinate> ac; // c - a
+  Coordinate inv_det;                  // inverse determinant of (ab ac), 2D
+};
+
+template <int DIM, class Coordinate>
+KOKKOS_FUNCTION auto makePrecomputed(Triangle<DIM, Coordinate> const &triangle)
+{
+  auto const ab = triangle.b - triangle.a;
+  auto const ac = triangle.c - triangle.a;
+  Coordinate inv_det = 0;
+  if constexpr (DIM == 2)
+    inv_det = 1 / (ac[1] * ab[0] - ac[0] * ab[1]);
+  return PrecomputedTriangle<DIM, Coordinate>{
+      {triangle.a, triangle.b, triangle.c}, ab, ac, inv_det};
+}
+
 } // namespace ArborX::ExperimentalHyperGeometry
 
 template <int DIM, class Coordinate>
@@ -52,4 +78,76 @@ struct ArborX::GeometryTraits::coordinate_type<
   using type = Coordinate;
 };
 
+template <int DIM, class Coordinate>
+struct ArborX::GeometryTraits::dimension<
+    ArborX::ExperimentalHyperGeometry::PrecomputedTriangle<DIM, Coordinate>>
+{
+  static constexpr int value = DIM;
+};
+template <int DIM, class Coordinate>
+struct ArborX::GeometryTraits::tag<
+    ArborX::ExperimentalHyperGeometry::PrecomputedTriangle<DIM, Coordinate>>
+{
+  using type = TriangleTag;
+};
+template <int DIM, class Coordinate>
+struct ArborX::GeometryTraits::coordinate_type<
+    ArborX::ExperimentalHyperGeometry::PrecomputedTriangle<DIM, Coordinate>>
+{
+  using type = Coordinate;
+};
+
+namespace ArborX::Details::Dispatch
+{
+using GeometryTraits::PointTag;
+using GeometryTraits::TriangleTag;
+
+// 2D point-in-triangle test reusing the stored barycentric transform
+template <typename Point, int DIM, class Coordinate>
+struct intersects<
+    PointTag, TriangleTag, Point,
+    ExperimentalHyperGeometry::PrecomputedTriangle<DIM, Coordinate>>
+{
+  KOKKOS_FUNCTION static constexpr bool
+  apply(Point const &point,
+        ExperimentalHyperGeometry::PrecomputedTriangle<DIM, Coordinate> const
+            &triangle)
+  {
+    static_assert(DIM == 2);
+
+    // Same linear system as for the plain triangle (see
+    // ArborX_DetailsAlgorithms.hpp), with the inverse applied from the stored
+    // edge vectors and determinant
+    auto const &u = triangle.ab;
+    auto const &v = triangle.ac;
+    Coordinate const dx = point[0] - triangle.a[0];
+    Coordinate const dy = point[1] - triangle.a[1];
+
+    Coordinate const alpha = (v[1] * dx - v[0] * dy) * triangle.inv_det;
+    Coordinate const beta = (-u[1] * dx + u[0] * dy) * triangle.inv_det;
+
+    return (1 - alpha - beta >= 0 && alpha >= 0 && beta >= 0);
+  }
+};
+
+template <typename Point, int DIM, class Coordinate>
+struct distance<PointTag, TriangleTag, Point,
+                ExperimentalHyperGeometry::PrecomputedTriangle<DIM, Coordinate>>
+{
+  KOKKOS_FUNCTION static auto
+  apply(Point const &point,
+        ExperimentalHyperGeometry::PrecomputedTriangle<DIM, Coordinate> const
+            &triangle)
+  {
+    using Base =
+        distance<PointTag, TriangleTag, Point,
+                 ExperimentalHyperGeometry::Triangle<DIM, Coordinate>>;
+    return Details::distance(
+        point, Base::closest_point(point, triangle.a, triangle.b, triangle.c,
+                                   triangle.ab, triangle.ac));
+  }
+};
+
+} // namespace ArborX::Details::Dispatch
+
 #endif
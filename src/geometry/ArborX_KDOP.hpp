@@ -350,6 +350,10 @@ struct intersects<PointTag, KDOPTag, Point, KDOP>
   {
     constexpr int DIM = GeometryTraits::dimension_v<Point>;
     constexpr int n_directions = KDOP::n_directions;
+    // Accumulate over all slabs instead of exiting early: the trip count is
+    // a compile-time constant, so the loop fully unrolls into straight-line
+    // code with no per-direction branches
+    bool inside = true;
     for (int i = 0; i < n_directions; ++i)
     {
       auto const &dir = kdop.directions()[i];
@@ -357,10 +361,10 @@ struct intersects<PointTag, KDOPTag, Point, KDOP>
       for (int d = 1; d < DIM; ++d)
         proj_i += point[d] * dir[d];
 
-      if (proj_i < kdop._min_values[i] || proj_i > kdop._max_values[i])
-        return false;
+      inside &=
+          (proj_i >= kdop._min_values[i] && proj_i <= kdop._max_values[i]);
     }
-    return true;
+    return inside;
   }
 };
 
@@ -372,15 +376,15 @@ struct intersects<KDOPTag, KDOPTag, KDOP1, KDOP2>
   {
     constexpr int n_directions = KDOP1::n_directions;
     static_assert(KDOP2::n_directions == n_directions);
-    for (int i = 0; i < kdop.n_directions; ++i)
+    // See the comment in the point-KDOP overlap test for why there is no
+    // early exit
+    bool overlap = true;
+    for (int i = 0; i < n_directions; ++i)
     {
-      if (other._max_values[i] < kdop._min_values[i] ||
-          other._min_values[i] > kdop._max_values[i])
-      {
-        return false;
-      }
+      overlap &= (other._max_values[i] >= kdop._min_values[i] &&
+                  other._min_values[i] <= kdop._max_values[i]);
     }
-    return true;
+    return overlap;
   }
 };
 
@@ -0,0 +1,170 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_MASKED_GEOMETRY_HPP
+#define ARBORX_MASKED_GEOMETRY_HPP
+
+#include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_GeometryTraits.hpp>
+
+#include <Kokkos_Macros.hpp>
+
+#include <type_traits>
+
+namespace ArborX::Experimental
+{
+
+/**
+ * Geometry adapter pairing a geometry with a category bit mask. Expanding one
+ * masked geometry with another ORs the masks, so when the adapter is used as
+ * the bounding volume of a tree (with an indexable getter returning the
+ * values' masked geometries) every internal node records the union of the
+ * categories below it. A masked query geometry then prunes entire subtrees
+ * that contain no matching category, instead of visiting them and filtering
+ * in the callback. Overlap against a plain (unmasked) geometry ignores the
+ * mask and degenerates to the geometric test, so unmasked queries see all
+ * categories.
+ */
+template <typename Geometry, typename Mask = unsigned int>
+struct Masked
+{
+  static_assert(std::is_unsigned_v<Mask>);
+
+  Geometry _geometry;
+  Mask _mask = 0;
+};
+
+template <typename Geometry, typename Mask>
+Masked(Geometry, Mask) -> Masked<Geometry, Mask>;
+
+} // namespace ArborX::Experimental
+
+template <typename Geometry, typename Mask>
+struct ArborX::GeometryTraits::dimension<
+    ArborX::Experimental::Masked<Geometry, Mask>>
+{
+  static constexpr int value = dimension_v<Geometry>;
+};
+template <typename Geometry, typename Mask>
+struct ArborX::GeometryTraits::tag<
+    ArborX::Experimental::Masked<Geometry, Mask>>
+{
+  using type = MaskedTag;
+};
+template <typename Geometry, typename Mask>
+struct ArborX::GeometryTraits::coordinate_type<
+    ArborX::Experimental::Masked<Geometry, Mask>>
+{
+  using type = coordinate_type_t<Geometry>;
+};
+
+namespace ArborX::Details::Dispatch
+{
+
+template <typename Masked1, typename Masked2>
+struct expand<MaskedTag, MaskedTag, Masked1, Masked2>
+{
+  KOKKOS_FUNCTION static void apply(Masked1 &that, Masked2 const &other)
+  {
+    Details::expand(that._geometry, other._geometry);
+    that._mask |= other._mask;
+  }
+};
+
+template <typename Box, typename Masked>
+struct expand<BoxTag, MaskedTag, Box, Masked>
+{
+  KOKKOS_FUNCTION static void apply(Box &box, Masked const &masked)
+  {
+    Details::expand(box, masked._geometry);
+  }
+};
+
+template <typename Masked1, typename Masked2>
+struct intersects<MaskedTag, MaskedTag, Masked1, Masked2>
+{
+  KOKKOS_FUNCTION static constexpr bool apply(Masked1 const &that,
+                                              Masked2 const &other)
+  {
+    // Testing the mask first is the whole point: a subtree with no matching
+    // category is rejected on a single AND without touching the geometry
+    return (that._mask & other._mask) != 0 &&
+           Details::intersects(that._geometry, other._geometry);
+  }
+};
+
+template <typename Tag, typename Geometry, typename Masked>
+struct intersects<Tag, MaskedTag, Geometry, Masked>
+{
+  KOKKOS_FUNCTION static constexpr bool apply(Geometry const &geometry,
+                                              Masked const &masked)
+  {
+    return Details::intersects(geometry, masked._geometry);
+  }
+};
+
+template <typename Tag, typename Masked, typename Geometry>
+struct intersects<MaskedTag, Tag, Masked, Geometry>
+{
+  KOKKOS_FUNCTION static constexpr bool apply(Masked const &masked,
+                                              Geometry const &geometry)
+  {
+    return Details::intersects(masked._geometry, geometry);
+  }
+};
+
+template <typename Masked1, typename Masked2>
+struct distance<MaskedTag, MaskedTag, Masked1, Masked2>
+{
+  KOKKOS_FUNCTION static auto apply(Masked1 const &that, Masked2 const &other)
+  {
+    using T = decltype(Details::distance(that._geometry, other._geometry));
+    // An infinite distance makes the nearest traversal prune subtrees with
+    // no matching category the same way the overlap test does
+    return (that._mask & other._mask) != 0
+               ? Details::distance(that._geometry, other._geometry)
+               : KokkosExt::ArithmeticTraits::infinity<T>::value;
+  }
+};
+
+template <typename Tag, typename Geometry, typename Masked>
+struct distance<Tag, MaskedTag, Geometry, Masked>
+{
+  KOKKOS_FUNCTION static auto apply(Geometry const &geometry,
+                                    Masked const &masked)
+  {
+    return Details::distance(geometry, masked._geometry);
+  }
+};
+
+template <typename Tag, typename Masked, typename Geometry>
+struct distance<MaskedTag, Tag, Masked, Geometry>
+{
+  KOKKOS_FUNCTION static auto apply(Masked const &masked,
+                                    Geometry const &geometry)
+  {
+    return Details::distance(masked._geometry, geometry);
+  }
+};
+
+template <typename Masked>
+struct centroid<MaskedTag, Masked>
+{
+  KOKKOS_FUNCTION static decltype(auto) apply(Masked const &masked)
+  {
+    return Details::returnCentroid(masked._geometry);
+  }
+};
+
+} // namespace ArborX::Details::Dispatch
+
+#endif
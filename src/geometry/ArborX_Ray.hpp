@@ -436,6 +436,120 @@ float distance(Ray const &ray, Box const &box)
              : Details::KokkosExt::ArithmeticTraits::infinity<float>::value;
 }
 
+// Query-side ray representation with the reciprocal direction precomputed
+// once at construction, so that the slab test against every node visited
+// during traversal multiplies where the plain Ray divides. Rays and
+// precomputed rays are interchangeable when building predicates; the
+// precomputed form pays off when a ray is tested against many boxes, the
+// tree traversal being the prime example. Intersection tests with
+// geometries other than boxes go through the implicit conversion to Ray.
+struct PrecomputedRay
+{
+  using Point = Ray::Point;
+  using Vector = Ray::Vector;
+
+  Ray _ray;
+  Vector _inv_direction = {};
+
+  KOKKOS_DEFAULTED_FUNCTION
+  constexpr PrecomputedRay() = default;
+
+  KOKKOS_FUNCTION
+  PrecomputedRay(Ray const &ray)
+      : _ray(ray)
+  {
+    for (int d = 0; d < 3; ++d)
+      _inv_direction[d] = 1.f / _ray.direction()[d];
+  }
+
+  KOKKOS_FUNCTION
+  PrecomputedRay(Point const &origin, Vector const &direction)
+      : PrecomputedRay(Ray{origin, direction})
+  {}
+
+  KOKKOS_FUNCTION
+  constexpr Point const &origin() const { return _ray.origin(); }
+
+  KOKKOS_FUNCTION
+  constexpr Vector const &direction() const { return _ray.direction(); }
+
+  KOKKOS_FUNCTION
+  constexpr Vector const &invDirection() const { return _inv_direction; }
+
+  KOKKOS_FUNCTION
+  constexpr operator Ray const &() const { return _ray; }
+};
+
+KOKKOS_INLINE_FUNCTION
+constexpr bool equals(PrecomputedRay const &l, PrecomputedRay const &r)
+{
+  return equals(static_cast<Ray const &>(l), static_cast<Ray const &>(r));
+}
+
+KOKKOS_INLINE_FUNCTION
+auto returnCentroid(PrecomputedRay const &ray) { return ray.origin(); }
+
+// Same algorithm and special-value behavior as the Ray overload above: the
+// sign of a reciprocal component matches the sign of the direction
+// component, a zero direction component still produces infinities, and the
+// 0 * inf = NaN case corresponds exactly to the 0 / 0 case discussed there.
+KOKKOS_INLINE_FUNCTION
+bool intersection(PrecomputedRay const &ray, Box const &box, float &tmin,
+                  float &tmax)
+{
+  auto const &min = box.minCorner();
+  auto const &max = box.maxCorner();
+  auto const &orig = ray.origin();
+  auto const &inv_dir = ray.invDirection();
+
+  constexpr auto inf =
+      Details::KokkosExt::ArithmeticTraits::infinity<float>::value;
+  tmin = -inf;
+  tmax = inf;
+
+  for (int d = 0; d < 3; ++d)
+  {
+    float tdmin;
+    float tdmax;
+    if (inv_dir[d] >= 0)
+    {
+      tdmin = (min[d] - orig[d]) * inv_dir[d];
+      tdmax = (max[d] - orig[d]) * inv_dir[d];
+    }
+    else
+    {
+      tdmin = (max[d] - orig[d]) * inv_dir[d];
+      tdmax = (min[d] - orig[d]) * inv_dir[d];
+    }
+    if (tmin < tdmin)
+      tmin = tdmin;
+    if (tmax > tdmax)
+      tmax = tdmax;
+  }
+  return (tmin <= tmax);
+}
+
+KOKKOS_INLINE_FUNCTION
+bool intersects(PrecomputedRay const &ray, Box const &box)
+{
+  float tmin;
+  float tmax;
+  // intersects only if box is in front of the ray
+  return intersection(ray, box, tmin, tmax) && (tmax >= 0.f);
+}
+
+// See the Ray overload for the definition
+KOKKOS_INLINE_FUNCTION
+float distance(PrecomputedRay const &ray, Box const &box)
+{
+  float tmin;
+  float tmax;
+  bool intersects = intersection(ray, box, tmin, tmax) && (tmax >= 0.f);
+  return intersects
+             ? (tmin > 0.f ? tmin : 0.f)
+             : Details::KokkosExt::ArithmeticTraits::infinity<float>::value;
+}
+
 // Solves a*x^2 + b*x + c = 0.
 // If a solution exists, return true and stores roots at x1, x2.
 // If a solution does not exist, returns false.
@@ -511,6 +625,82 @@ KOKKOS_INLINE_FUNCTION bool intersection(Ray const &ray, Sphere const &sphere,
   return false;
 }
 
+// Ray restricted to the parametric interval [0, tmax], i.e. a segment of
+// known length starting at the origin. Intended for occlusion (any-hit)
+// queries: an intersects() predicate built from a BoundedRay matches any
+// primitive hit within the interval and none beyond it, so combined with a
+// callback returning early_exit it answers "is this segment blocked" with a
+// single unordered traversal, without the priority queue bookkeeping of
+// ordered_intersects.
+struct BoundedRay
+{
+  using Point = Ray::Point;
+  using Vector = Ray::Vector;
+
+  Ray _ray;
+  float _tmax = 0.f;
+
+  KOKKOS_DEFAULTED_FUNCTION
+  constexpr BoundedRay() = default;
+
+  KOKKOS_FUNCTION
+  BoundedRay(Point const &origin, Vector const &direction, float tmax)
+      : _ray(origin, direction)
+      , _tmax(tmax)
+  {}
+
+  // Segment between two points, the common shadow ray case
+  KOKKOS_FUNCTION
+  BoundedRay(Point const &start, Point const &end)
+      : _ray(start, end - start)
+  {
+    auto const v = end - start;
+    _tmax = std::sqrt(v.dot(v));
+  }
+
+  KOKKOS_FUNCTION
+  constexpr Point const &origin() const { return _ray.origin(); }
+
+  KOKKOS_FUNCTION
+  constexpr Vector const &direction() const { return _ray.direction(); }
+
+  KOKKOS_FUNCTION
+  constexpr float tmax() const { return _tmax; }
+
+  KOKKOS_FUNCTION
+  constexpr operator Ray const &() const { return _ray; }
+};
+
+KOKKOS_INLINE_FUNCTION
+constexpr bool equals(BoundedRay const &l, BoundedRay const &r)
+{
+  return equals(static_cast<Ray const &>(l), static_cast<Ray const &>(r)) &&
+         l.tmax() == r.tmax();
+}
+
+KOKKOS_INLINE_FUNCTION
+auto returnCentroid(BoundedRay const &ray) { return ray.origin(); }
+
+KOKKOS_INLINE_FUNCTION
+bool intersects(BoundedRay const &ray, Box const &box)
+{
+  float tmin;
+  float tmax;
+  // intersects only if the box overlaps the [0, tmax] interval
+  return intersection(static_cast<Ray const &>(ray), box, tmin, tmax) &&
+         (tmax >= 0.f) && (tmin <= ray.tmax());
+}
+
+KOKKOS_INLINE_FUNCTION
+bool intersects(BoundedRay const &ray,
+                ExperimentalHyperGeometry::Triangle<3> const &triangle)
+{
+  float tmin;
+  float tmax;
+  return intersection(static_cast<Ray const &>(ray), triangle, tmin, tmax) &&
+         (tmax >= 0.f) && (tmin <= ray.tmax());
+}
+
 template <typename Geometry>
 KOKKOS_INLINE_FUNCTION void
 overlapDistance(Ray const &ray, Geometry const &geometry, float &length,
@@ -563,4 +753,37 @@ struct ArborX::GeometryTraits::coordinate_type<ArborX::Experimental::Ray>
   using type = float;
 };
 
+template <>
+struct ArborX::GeometryTraits::dimension<ArborX::Experimental::PrecomputedRay>
+{
+  static constexpr int value = 3;
+};
+template <>
+struct ArborX::GeometryTraits::tag<ArborX::Experimental::PrecomputedRay>
+{
+  using type = RayTag;
+};
+template <>
+struct ArborX::GeometryTraits::coordinate_type<
+    ArborX::Experimental::PrecomputedRay>
+{
+  using type = float;
+};
+
+template <>
+struct ArborX::GeometryTraits::dimension<ArborX::Experimental::BoundedRay>
+{
+  static constexpr int value = 3;
+};
+template <>
+struct ArborX::GeometryTraits::tag<ArborX::Experimental::BoundedRay>
+{
+  using type = RayTag;
+};
+template <>
+struct ArborX::GeometryTraits::coordinate_type<ArborX::Experimental::BoundedRay>
+{
+  using type = float;
+};
+
 #endif
@@ -0,0 +1,194 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_SINGLE_PRECISION_BOX_HPP
+#define ARBORX_SINGLE_PRECISION_BOX_HPP
+
+#include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_GeometryTraits.hpp>
+#include <ArborX_HyperBox.hpp>
+#include <ArborX_HyperPoint.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <cstdint>
+
+namespace ArborX::Experimental
+{
+
+/**
+ * Axis-aligned bounding box over double-precision primitives that stores its
+ * corners in single precision, rounded outward so that the stored box always
+ * contains the exact one. Using it as the bounding volume template parameter
+ * of a BoundingVolumeHierarchy halves the internal node bytes of an
+ * otherwise double-precision tree; the leaves keep the original
+ * double-precision values, so the predicate test against a leaf remains
+ * exact and the looser internal boxes can only cost extra node visits,
+ * never results.
+ */
+template <int DIM, class Coordinate = double>
+struct SinglePrecisionBox
+{
+  using storage_type = float;
+
+  KOKKOS_FUNCTION
+  SinglePrecisionBox()
+  {
+    constexpr auto infinity =
+        Details::KokkosExt::ArithmeticTraits::infinity<storage_type>::value;
+    for (int d = 0; d < DIM; ++d)
+    {
+      _min[d] = infinity;
+      _max[d] = -infinity;
+    }
+  }
+
+  KOKKOS_FUNCTION
+  explicit SinglePrecisionBox(
+      ExperimentalHyperGeometry::Box<DIM, Coordinate> const &box)
+  {
+    for (int d = 0; d < DIM; ++d)
+    {
+      _min[d] = roundDown(box.minCorner()[d]);
+      _max[d] = roundUp(box.maxCorner()[d]);
+    }
+  }
+
+  KOKKOS_FUNCTION
+  auto minCorner() const
+  {
+    ExperimentalHyperGeometry::Point<DIM, Coordinate> p;
+    for (int d = 0; d < DIM; ++d)
+      p[d] = (Coordinate)_min[d];
+    return p;
+  }
+
+  KOKKOS_FUNCTION
+  auto maxCorner() const
+  {
+    ExperimentalHyperGeometry::Point<DIM, Coordinate> p;
+    for (int d = 0; d < DIM; ++d)
+      p[d] = (Coordinate)_max[d];
+    return p;
+  }
+
+  // Largest single-precision value not exceeding x. Nudging the float by one
+  // ulp through its bit pattern also does the right thing when x falls
+  // outside the single-precision range: decrementing infinity yields the
+  // largest finite float.
+  static KOKKOS_FUNCTION storage_type roundDown(Coordinate x)
+  {
+    storage_type f(x);
+    if ((Coordinate)f > x)
+    {
+      auto bits = Kokkos::bit_cast<std::uint32_t>(f);
+      if (bits == 0x00000000 || bits == 0x80000000) // +/-0
+        bits = 0x80000001; // smallest negative subnormal
+      else if (bits & 0x80000000)
+        ++bits; // negative: increase the magnitude
+      else
+        --bits; // positive: decrease the magnitude
+      f = Kokkos::bit_cast<storage_type>(bits);
+    }
+    return f;
+  }
+
+  // Smallest single-precision value not less than x
+  static KOKKOS_FUNCTION storage_type roundUp(Coordinate x)
+  {
+    storage_type f(x);
+    if ((Coordinate)f < x)
+    {
+      auto bits = Kokkos::bit_cast<std::uint32_t>(f);
+      if (bits == 0x00000000 || bits == 0x80000000) // +/-0
+        bits = 0x00000001; // smallest positive subnormal
+      else if (bits & 0x80000000)
+        --bits; // negative: decrease the magnitude
+      else
+        ++bits; // positive: increase the magnitude
+      f = Kokkos::bit_cast<storage_type>(bits);
+    }
+    return f;
+  }
+
+  storage_type _min[DIM];
+  storage_type _max[DIM];
+};
+
+} // namespace ArborX::Experimental
+
+template <int DIM, class Coordinate>
+struct ArborX::GeometryTraits::dimension<
+    ArborX::Experimental::SinglePrecisionBox<DIM, Coordinate>>
+{
+  static constexpr int value = DIM;
+};
+template <int DIM, class Coordinate>
+struct ArborX::GeometryTraits::tag<
+    ArborX::Experimental::SinglePrecisionBox<DIM, Coordinate>>
+{
+  using type = BoxTag;
+};
+template <int DIM, class Coordinate>
+struct ArborX::GeometryTraits::coordinate_type<
+    ArborX::Experimental::SinglePrecisionBox<DIM, Coordinate>>
+{
+  using type = Coordinate;
+};
+
+namespace ArborX::Details::Dispatch
+{
+
+// Only expand needs overloads: it writes the corners back and must round
+// outward again. Reading algorithms go through the corner accessors, which
+// widen to the full-precision coordinate type, so the generic
+// implementations apply unchanged.
+template <int DIM, class Coordinate, typename Geometry>
+struct ExpandSinglePrecisionBox
+{
+  KOKKOS_FUNCTION static void
+  apply(Experimental::SinglePrecisionBox<DIM, Coordinate> &box,
+        Geometry const &geometry)
+  {
+    ExperimentalHyperGeometry::Box<DIM, Coordinate> widened{box.minCorner(),
+                                                            box.maxCorner()};
+    Details::expand(widened, geometry);
+    box = Experimental::SinglePrecisionBox<DIM, Coordinate>(widened);
+  }
+};
+
+template <int DIM, class Coordinate, typename Point>
+struct expand<BoxTag, PointTag,
+              Experimental::SinglePrecisionBox<DIM, Coordinate>, Point>
+    : ExpandSinglePrecisionBox<DIM, Coordinate, Point>
+{};
+
+template <int DIM, class Coordinate, typename Box>
+struct expand<BoxTag, BoxTag, Experimental::SinglePrecisionBox<DIM, Coordinate>,
+              Box> : ExpandSinglePrecisionBox<DIM, Coordinate, Box>
+{};
+
+template <int DIM, class Coordinate, typename Sphere>
+struct expand<BoxTag, SphereTag,
+              Experimental::SinglePrecisionBox<DIM, Coordinate>, Sphere>
+    : ExpandSinglePrecisionBox<DIM, Coordinate, Sphere>
+{};
+
+template <int DIM, class Coordinate, typename Triangle>
+struct expand<BoxTag, TriangleTag,
+              Experimental::SinglePrecisionBox<DIM, Coordinate>, Triangle>
+    : ExpandSinglePrecisionBox<DIM, Coordinate, Triangle>
+{};
+
+} // namespace ArborX::Details::Dispatch
+
+#endif
@@ -37,6 +37,43 @@ Tetrahedron(ExperimentalHyperGeometry::Point<3, Coordinate>,
             ExperimentalHyperGeometry::Point<3, Coordinate>)
     -> Tetrahedron<Coordinate>;
 
+// Tetrahedron that additionally stores its four face planes, oriented towards
+// the inside. Building it once, typically in the AccessTraits used for tree
+// construction, turns every traversal-side point inclusion test into four
+// plane evaluations instead of four cross products. It behaves as a regular
+// tetrahedron everywhere else.
+template <class Coordinate = float>
+struct PrecomputedTetrahedron : Tetrahedron<Coordinate>
+{
+  Details::Vector<3, Coordinate> normals[4];
+  Coordinate offsets[4];
+};
+
+template <class Coordinate>
+KOKKOS_FUNCTION auto makePrecomputed(Tetrahedron<Coordinate> const &tet)
+{
+  PrecomputedTetrahedron<Coordinate> result{{tet.a, tet.b, tet.c, tet.d}};
+
+  constexpr int N = 4;
+  Kokkos::Array<decltype(tet.a), N> v = {tet.a, tet.b, tet.c, tet.d};
+  for (int j = 0; j < N; ++j)
+  {
+    auto normal = (v[(j + 1) % N] - v[j]).cross(v[(j + 2) % N] - v[j]);
+
+    // Scaling by the (signed) projection of the remaining vertex orients the
+    // plane towards the inside; a degenerate face yields a zero normal whose
+    // test always passes, matching the plain tetrahedron
+    auto const orientation = normal.dot(v[(j + 3) % N] - v[j]);
+    for (int d = 0; d < 3; ++d)
+      normal[d] *= orientation;
+
+    result.normals[j] = normal;
+    result.offsets[j] = -(normal[0] * v[j][0] + normal[1] * v[j][1] +
+                          normal[2] * v[j][2]);
+  }
+  return result;
+}
+
 } // namespace ArborX::ExperimentalHyperGeometry
 
 template <class Coordinate>
@@ -58,6 +95,25 @@ struct ArborX::GeometryTraits::coordinate_type<
   using type = Coordinate;
 };
 
+template <class Coordinate>
+struct ArborX::GeometryTraits::dimension<
+    ArborX::ExperimentalHyperGeometry::PrecomputedTetrahedron<Coordinate>>
+{
+  static constexpr int value = 3;
+};
+template <class Coordinate>
+struct ArborX::GeometryTraits::tag<
+    ArborX::ExperimentalHyperGeometry::PrecomputedTetrahedron<Coordinate>>
+{
+  using type = TetrahedronTag;
+};
+template <class Coordinate>
+struct ArborX::GeometryTraits::coordinate_type<
+    ArborX::ExperimentalHyperGeometry::PrecomputedTetrahedron<Coordinate>>
+{
+  using type = Coordinate;
+};
+
 namespace ArborX::Details::Dispatch
 {
 using GeometryTraits::BoxTag;
@@ -104,6 +160,30 @@ struct intersects<PointTag, TetrahedronTag, Point, Tetrahedron>
   }
 };
 
+// Point inclusion test reusing the stored oriented face planes
+template <typename Point, class Coordinate>
+struct intersects<PointTag, TetrahedronTag, Point,
+                  ExperimentalHyperGeometry::PrecomputedTetrahedron<Coordinate>>
+{
+  KOKKOS_FUNCTION static constexpr bool
+  apply(Point const &point,
+        ExperimentalHyperGeometry::PrecomputedTetrahedron<Coordinate> const
+            &tet)
+  {
+    static_assert(GeometryTraits::dimension_v<Point> == 3);
+
+    for (int j = 0; j < 4; ++j)
+    {
+      auto const &normal = tet.normals[j];
+      if (normal[0] * point[0] + normal[1] * point[1] + normal[2] * point[2] +
+              tet.offsets[j] <
+          0)
+        return false;
+    }
+    return true;
+  }
+};
+
 } // namespace ArborX::Details::Dispatch
 
 #endif
@@ -0,0 +1,409 @@
+/****************************************************************************
+ * Copyright (c) 2023 by the ArborX authors                                 *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_INTERP_DISTRIBUTED_MOVING_LEAST_SQUARES_HPP
+#define ARBORX_INTERP_DISTRIBUTED_MOVING_LEAST_SQUARES_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_DetailsDistributor.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DistributedTree.hpp>
+#include <ArborX_Exception.hpp>
+#include <ArborX_GeometryTraits.hpp>
+#include <ArborX_InterpDetailsCompactRadialBasisFunction.hpp>
+#include <ArborX_InterpDetailsMovingLeastSquaresCoefficients.hpp>
+#include <ArborX_InterpDetailsPolynomialBasis.hpp>
+#include <ArborX_PredicateHelpers.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <memory>
+#include <optional>
+
+#include <mpi.h>
+
+namespace ArborX::Interpolation::Details
+{
+
+// Source point annotated with its owning rank and owner-local index, so that
+// a nearest neighbor found through the distributed tree directly identifies
+// the value to fetch during the apply phase
+template <typename Point>
+struct DistributedSourcePoint
+{
+  Point point;
+  int rank;
+  int index;
+};
+
+struct DistributedSourcePointIndexableGetter
+{
+  template <typename Point>
+  KOKKOS_FUNCTION auto const &
+  operator()(DistributedSourcePoint<Point> const &source) const
+  {
+    return source.point;
+  }
+};
+
+// Request for one remote source value, shipped to the owning rank while
+// setting up the communication plan
+struct MLSValueRequest
+{
+  int index;       // owner-local index of the requested source value
+  int origin_rank; // rank the value must be sent back to
+  int id;          // flat (target, neighbor) slot on the origin rank
+};
+
+} // namespace ArborX::Interpolation::Details
+
+namespace ArborX::Interpolation
+{
+
+// Distributed variant of MovingLeastSquares for source points spread across
+// the ranks of a communicator. Neighbors are found through a distributed
+// tree, only the neighbor coordinates are shipped during setup, and the
+// communication plan (who owns which needed source value) plus the local
+// coefficients are cached so that repeated applies only exchange the values
+// themselves.
+//
+// Both the constructor and interpolate() must be called as collectives over
+// all processes in the communicator.
+// As with MovingLeastSquares, AccumulationType widens the per-target setup
+// arithmetic independently of the coefficients storage type.
+template <typename MemorySpace, typename FloatingCalculationType = double,
+          typename AccumulationType = FloatingCalculationType>
+class DistributedMovingLeastSquares
+{
+public:
+  template <typename ExecutionSpace, typename SourcePoints,
+            typename TargetPoints, typename CRBFunc = CRBF::Wendland<0>,
+            typename PolynomialDegree = PolynomialDegree<2>>
+  DistributedMovingLeastSquares(MPI_Comm comm, ExecutionSpace const &space,
+                                SourcePoints const &source_points,
+                                TargetPoints const &target_points, CRBFunc = {},
+                                PolynomialDegree = {},
+                                std::optional<int> num_neighbors = std::nullopt)
+  {
+    namespace KokkosExt = ArborX::Details::KokkosExt;
+
+    auto guard = Kokkos::Profiling::ScopedRegion(
+        "ArborX::DistributedMovingLeastSquares");
+
+    static_assert(
+        KokkosExt::is_accessible_from<MemorySpace, ExecutionSpace>::value,
+        "Memory space must be accessible from the execution space");
+
+    // SourcePoints is an access trait of points
+    ArborX::Details::check_valid_access_traits(PrimitivesTag{}, source_points);
+    using SourceAccess =
+        ArborX::Details::AccessValues<SourcePoints, PrimitivesTag>;
+    static_assert(
+        KokkosExt::is_accessible_from<typename SourceAccess::memory_space,
+                                      ExecutionSpace>::value,
+        "Source points must be accessible from the execution space");
+    using SourcePoint = typename SourceAccess::value_type;
+    GeometryTraits::check_valid_geometry_traits(SourcePoint{});
+    static_assert(GeometryTraits::is_point_v<SourcePoint>,
+                  "Source points elements must be points");
+    static constexpr int dimension = GeometryTraits::dimension_v<SourcePoint>;
+
+    // TargetPoints is an access trait of points
+    ArborX::Details::check_valid_access_traits(PrimitivesTag{}, target_points);
+    using TargetAccess =
+        ArborX::Details::AccessValues<TargetPoints, PrimitivesTag>;
+    static_assert(
+        KokkosExt::is_accessible_from<typename TargetAccess::memory_space,
+                                      ExecutionSpace>::value,
+        "Target points must be accessible from the execution space");
+    using TargetPoint = typename TargetAccess::value_type;
+    GeometryTraits::check_valid_geometry_traits(TargetPoint{});
+    static_assert(GeometryTraits::is_point_v<TargetPoint>,
+                  "Target points elements must be points");
+    static_assert(dimension == GeometryTraits::dimension_v<TargetPoint>,
+                  "Target and source points must have the same dimension");
+
+    _num_neighbors =
+        num_neighbors ? *num_neighbors
+                      : Details::polynomialBasisSize<dimension,
+                                                     PolynomialDegree::value>();
+
+    TargetAccess target_access{target_points}; // NOLINT
+    SourceAccess source_access{source_points}; // NOLINT
+
+    _num_targets = target_access.size();
+    _source_size = source_access.size();
+
+    int comm_rank;
+    MPI_Comm_rank(comm, &comm_rank);
+
+    // Annotate the local source points with their owner
+    using SourceEntry = Details::DistributedSourcePoint<SourcePoint>;
+    Kokkos::View<SourceEntry *, MemorySpace> entries(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::DistributedMovingLeastSquares::entries"),
+        _source_size);
+    Kokkos::parallel_for(
+        "ArborX::DistributedMovingLeastSquares::annotate_source_points",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, _source_size),
+        KOKKOS_LAMBDA(int const i) {
+          entries(i) = {source_access(i), comm_rank, i};
+        });
+
+    DistributedTree<MemorySpace, SourceEntry,
+                    Details::DistributedSourcePointIndexableGetter>
+        source_tree(comm, space, entries,
+                    Details::DistributedSourcePointIndexableGetter{});
+
+    // There must be enough source points globally
+    ARBORX_ASSERT(0 < _num_neighbors &&
+                  (typename decltype(source_tree)::size_type)_num_neighbors <=
+                      source_tree.size());
+
+    // Find the neighbors of each local target among all source points
+    Kokkos::View<SourceEntry *, MemorySpace> neighbors(
+        "ArborX::DistributedMovingLeastSquares::neighbors", 0);
+    Kokkos::View<int *, MemorySpace> offset(
+        "ArborX::DistributedMovingLeastSquares::offset", 0);
+    source_tree.query(
+        space, Experimental::make_nearest(target_access, _num_neighbors),
+        neighbors, offset);
+
+    int const num_requests = _num_targets * _num_neighbors;
+    ARBORX_ASSERT(KokkosExt::lastElement(space, offset) == num_requests);
+
+    int const num_neighbors = _num_neighbors;
+
+    // Neighbor coordinates were shipped with the query results, so the
+    // coefficients are computed without further communication
+    Kokkos::View<SourcePoint **, MemorySpace> source_view(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::DistributedMovingLeastSquares::source_view"),
+        _num_targets, _num_neighbors);
+    Kokkos::parallel_for(
+        "ArborX::DistributedMovingLeastSquares::fill_source_view",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_requests),
+        KOKKOS_LAMBDA(int const j) {
+          source_view(j / num_neighbors, j % num_neighbors) =
+              neighbors(j).point;
+        });
+
+    _coeffs = Details::movingLeastSquaresCoefficients<
+        CRBFunc, PolynomialDegree, FloatingCalculationType, AccumulationType>(
+        space, source_view, target_access);
+
+    // Set up the communication plan for the apply phase: ship each value
+    // request to the owning rank, and record on the owner which local values
+    // to send where. The flat request id travels there and back once so that
+    // every rank learns which import slot answers which (target, neighbor)
+    // pair; the slot assignment is stable across applies.
+    Kokkos::View<int *, MemorySpace> destinations(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::DistributedMovingLeastSquares::destinations"),
+        num_requests);
+    Kokkos::View<Details::MLSValueRequest *, MemorySpace> requests(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::DistributedMovingLeastSquares::requests"),
+        num_requests);
+    Kokkos::parallel_for(
+        "ArborX::DistributedMovingLeastSquares::fill_requests",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_requests),
+        KOKKOS_LAMBDA(int const j) {
+          destinations(j) = neighbors(j).rank;
+          requests(j) = {neighbors(j).index, comm_rank, j};
+        });
+
+    ArborX::Details::Distributor<MemorySpace> forward(comm);
+    forward.createFromSends(space, destinations);
+    int const num_exports = forward.getTotalReceiveLength();
+    Kokkos::View<Details::MLSValueRequest *, MemorySpace> received(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::DistributedMovingLeastSquares::received"),
+        num_exports);
+    forward.doPostsAndWaits(space, requests, received);
+
+    _send_indices = Kokkos::View<int *, MemorySpace>(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::DistributedMovingLeastSquares::send_indices"),
+        num_exports);
+    Kokkos::View<int *, MemorySpace> origins(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::DistributedMovingLeastSquares::origins"),
+        num_exports);
+    Kokkos::View<int *, MemorySpace> ids(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::DistributedMovingLeastSquares::ids"),
+        num_exports);
+    auto send_indices = _send_indices;
+    Kokkos::parallel_for(
+        "ArborX::DistributedMovingLeastSquares::unpack_requests",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_exports),
+        KOKKOS_LAMBDA(int const l) {
+          send_indices(l) = received(l).index;
+          origins(l) = received(l).origin_rank;
+          ids(l) = received(l).id;
+        });
+
+    _backward =
+        std::make_shared<ArborX::Details::Distributor<MemorySpace>>(comm);
+    _backward->createFromSends(space, origins);
+    ARBORX_ASSERT((int)_backward->getTotalReceiveLength() == num_requests);
+
+    Kokkos::View<int *, MemorySpace> returned_ids(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::DistributedMovingLeastSquares::returned_ids"),
+        num_requests);
+    _backward->doPostsAndWaits(space, ids, returned_ids);
+
+    _slots = Kokkos::View<int *, MemorySpace>(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::DistributedMovingLeastSquares::slots"),
+        num_requests);
+    auto slots = _slots;
+    Kokkos::parallel_for(
+        "ArborX::DistributedMovingLeastSquares::invert_slots",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_requests),
+        KOKKOS_LAMBDA(int const l) { slots(returned_ids(l)) = l; });
+  }
+
+  template <typename ExecutionSpace, typename SourceValues,
+            typename ApproxValues>
+  void interpolate(ExecutionSpace const &space,
+                   SourceValues const &source_values,
+                   ApproxValues &approx_values) const
+  {
+    auto guard = Kokkos::Profiling::ScopedRegion(
+        "ArborX::DistributedMovingLeastSquares::interpolate");
+
+    namespace KokkosExt = ArborX::Details::KokkosExt;
+
+    static_assert(
+        KokkosExt::is_accessible_from<MemorySpace, ExecutionSpace>::value,
+        "Memory space must be accessible from the execution space");
+
+    // SourceValues is a 1D view of all local source values, or a 2D view
+    // with one field per column
+    static_assert(Kokkos::is_view_v<SourceValues> &&
+                      (SourceValues::rank == 1 || SourceValues::rank == 2),
+                  "Source values must be a 1D or 2D view of values");
+    static_assert(
+        KokkosExt::is_accessible_from<typename SourceValues::memory_space,
+                                      ExecutionSpace>::value,
+        "Source values must be accessible from the execution space");
+
+    // ApproxValues is a view for approximated values of the same rank
+    static_assert(Kokkos::is_view_v<ApproxValues> &&
+                      ApproxValues::rank == SourceValues::rank,
+                  "Approx values must be a view of the same rank as the source "
+                  "values");
+    static_assert(
+        KokkosExt::is_accessible_from<typename ApproxValues::memory_space,
+                                      ExecutionSpace>::value,
+        "Approx values must be accessible from the execution space");
+    static_assert(!std::is_const_v<typename ApproxValues::value_type>,
+                  "Approx values must be writable");
+
+    // Source values must be a valuation on the local source points
+    KOKKOS_ASSERT(_source_size == source_values.extent_int(0));
+
+    // Approx values must have the correct size
+    KOKKOS_ASSERT(approx_values.extent_int(0) == _num_targets);
+
+    using Value = typename ApproxValues::non_const_value_type;
+
+    int const num_exports = _send_indices.extent(0);
+    int const num_imports = _slots.extent(0);
+
+    Kokkos::View<Value *, MemorySpace> exports(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::DistributedMovingLeastSquares::exports"),
+        num_exports);
+    Kokkos::View<Value *, MemorySpace> imports(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::DistributedMovingLeastSquares::imports"),
+        num_imports);
+
+    auto send_indices = _send_indices;
+    auto slots = _slots;
+    auto coeffs = _coeffs;
+    int const num_targets = _num_targets;
+    int const num_neighbors = _num_neighbors;
+
+    if constexpr (SourceValues::rank == 1)
+    {
+      Kokkos::parallel_for(
+          "ArborX::DistributedMovingLeastSquares::gather_values",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_exports),
+          KOKKOS_LAMBDA(int const l) {
+            exports(l) = source_values(send_indices(l));
+          });
+      _backward->doPostsAndWaits(space, exports, imports);
+
+      Kokkos::parallel_for(
+          "ArborX::DistributedMovingLeastSquares::target_interpolation",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_targets),
+          KOKKOS_LAMBDA(int const i) {
+            Value tmp = 0;
+            for (int j = 0; j < num_neighbors; j++)
+              tmp += coeffs(i, j) * imports(slots(i * num_neighbors + j));
+            approx_values(i) = tmp;
+          });
+    }
+    else
+    {
+      // The distributor exchanges 1D buffers, so the fields are shipped one
+      // at a time, reusing the buffers
+      KOKKOS_ASSERT(approx_values.extent(1) == source_values.extent(1));
+      int const num_fields = source_values.extent_int(1);
+
+      for (int f = 0; f < num_fields; f++)
+      {
+        Kokkos::parallel_for(
+            "ArborX::DistributedMovingLeastSquares::gather_values",
+            Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_exports),
+            KOKKOS_LAMBDA(int const l) {
+              exports(l) = source_values(send_indices(l), f);
+            });
+        _backward->doPostsAndWaits(space, exports, imports);
+
+        Kokkos::parallel_for(
+            "ArborX::DistributedMovingLeastSquares::target_interpolation",
+            Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_targets),
+            KOKKOS_LAMBDA(int const i) {
+              Value tmp = 0;
+              for (int j = 0; j < num_neighbors; j++)
+                tmp += coeffs(i, j) * imports(slots(i * num_neighbors + j));
+              approx_values(i, f) = tmp;
+            });
+      }
+    }
+  }
+
+private:
+  Kokkos::View<FloatingCalculationType **, MemorySpace> _coeffs;
+  Kokkos::View<int *, MemorySpace> _send_indices;
+  Kokkos::View<int *, MemorySpace> _slots;
+  // The distributor is not copyable; sharing it keeps the interpolation
+  // object cheap to copy like the rest of the library
+  std::shared_ptr<ArborX::Details::Distributor<MemorySpace>> _backward;
+  int _num_targets;
+  int _num_neighbors;
+  int _source_size;
+};
+
+} // namespace ArborX::Interpolation
+
+#endif
@@ -13,9 +13,13 @@
 #define ARBORX_INTERP_MOVING_LEAST_SQUARES_HPP
 
 #include <ArborX_AccessTraits.hpp>
+#include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
 #include <ArborX_DetailsLegacy.hpp>
 #include <ArborX_GeometryTraits.hpp>
 #include <ArborX_HyperBox.hpp>
+#include <ArborX_HyperSphere.hpp>
 #include <ArborX_IndexableGetter.hpp>
 #include <ArborX_InterpDetailsCompactRadialBasisFunction.hpp>
 #include <ArborX_InterpDetailsMovingLeastSquaresCoefficients.hpp>
@@ -54,12 +58,34 @@ struct MLSSearchNeighborsCallback
   }
 };
 
+// Functor used in the sweep-box query to flag targets whose stencil region
+// was crossed by a source point that moved beyond the tolerance
+template <typename StaleView>
+struct MLSMarkStaleTargetsCallback
+{
+  StaleView stale;
+
+  template <typename Predicate, typename Primitive>
+  KOKKOS_FUNCTION void operator()(Predicate const &predicate,
+                                  Primitive const &) const
+  {
+    stale(getData(predicate)) = 1;
+  }
+};
+
 } // namespace ArborX::Interpolation::Details
 
 namespace ArborX::Interpolation
 {
 
-template <typename MemorySpace, typename FloatingCalculationType = double>
+// FloatingCalculationType is the storage type of the interpolation
+// coefficients; AccumulationType is the type the per-target setup (weighted
+// Vandermonde products and SVD) is evaluated in. The default runs everything
+// in one type; passing <float, double> selects a mixed-precision setup that
+// stores inputs and coefficients in single precision but keeps the
+// conditioning-sensitive arithmetic in double.
+template <typename MemorySpace, typename FloatingCalculationType = double,
+          typename AccumulationType = FloatingCalculationType>
 class MovingLeastSquares
 {
 public:
@@ -126,8 +152,8 @@ public:
     auto source_view = searchNeighbors(space, source_access, target_access);
 
     // Compute the moving least squares coefficients
-    _coeffs = Details::movingLeastSquaresCoefficients<CRBFunc, PolynomialDegree,
-                                                      FloatingCalculationType>(
+    _coeffs = Details::movingLeastSquaresCoefficients<
+        CRBFunc, PolynomialDegree, FloatingCalculationType, AccumulationType>(
         space, source_view, target_access);
   }
 
@@ -146,17 +172,21 @@ public:
         KokkosExt::is_accessible_from<MemorySpace, ExecutionSpace>::value,
         "Memory space must be accessible from the execution space");
 
-    // SourceValues is a 1D view of all source values
-    static_assert(Kokkos::is_view_v<SourceValues> && SourceValues::rank == 1,
-                  "Source values must be a 1D view of values");
+    // SourceValues is a 1D view of all source values, or a 2D view with one
+    // field per column
+    static_assert(Kokkos::is_view_v<SourceValues> &&
+                      (SourceValues::rank == 1 || SourceValues::rank == 2),
+                  "Source values must be a 1D or 2D view of values");
     static_assert(
         KokkosExt::is_accessible_from<typename SourceValues::memory_space,
                                       ExecutionSpace>::value,
         "Source values must be accessible from the execution space");
 
-    // ApproxValues is a 1D view for approximated values
-    static_assert(Kokkos::is_view_v<ApproxValues> && ApproxValues::rank == 1,
-                  "Approx values must be a 1D view");
+    // ApproxValues is a view for approximated values of the same rank
+    static_assert(Kokkos::is_view_v<ApproxValues> &&
+                      ApproxValues::rank == SourceValues::rank,
+                  "Approx values must be a view of the same rank as the source "
+                  "values");
     static_assert(
         KokkosExt::is_accessible_from<typename ApproxValues::memory_space,
                                       ExecutionSpace>::value,
@@ -173,14 +203,273 @@ public:
 
     using Value = typename ApproxValues::non_const_value_type;
 
+    if constexpr (SourceValues::rank == 1)
+    {
+      Kokkos::parallel_for(
+          "ArborX::MovingLeastSquares::target_interpolation",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, _num_targets),
+          KOKKOS_CLASS_LAMBDA(int const i) {
+            Value tmp = 0;
+            for (int j = 0; j < _num_neighbors; j++)
+              tmp += _coeffs(i, j) * source_values(_indices(i, j));
+            approx_values(i) = tmp;
+          });
+    }
+    else
+    {
+      // Multiple fields between the same point sets are interpolated in a
+      // single fused pass: the coefficients and the indices are read once per
+      // target and applied to every column
+      KOKKOS_ASSERT(approx_values.extent(1) == source_values.extent(1));
+      int const num_fields = source_values.extent_int(1);
+
+      Kokkos::parallel_for(
+          "ArborX::MovingLeastSquares::target_interpolation_multi",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, _num_targets),
+          KOKKOS_CLASS_LAMBDA(int const i) {
+            for (int f = 0; f < num_fields; f++)
+              approx_values(i, f) = 0;
+            for (int j = 0; j < _num_neighbors; j++)
+            {
+              auto const coeff = _coeffs(i, j);
+              int const source = _indices(i, j);
+              for (int f = 0; f < num_fields; f++)
+                approx_values(i, f) += coeff * source_values(source, f);
+            }
+          });
+    }
+  }
+
+  // Refreshes the operator after the point clouds moved, recomputing only the
+  // targets whose stencil may have changed. A point whose displacement since
+  // the previous set is within `tolerance` keeps its role: a target is redone
+  // when it moved beyond the tolerance or when a source that did crossed its
+  // stencil region; every other row of coefficients and indices is reused as
+  // is. CRBFunc and PolynomialDegree must match the ones the operator was
+  // built with. The tolerance is a per-call threshold, so the error of reused
+  // rows can grow with repeated updates; steadily drifting clouds should be
+  // rebuilt from scratch periodically.
+  template <typename ExecutionSpace, typename PreviousSourcePoints,
+            typename SourcePoints, typename PreviousTargetPoints,
+            typename TargetPoints, typename CRBFunc = CRBF::Wendland<0>,
+            typename PolynomialDegree = PolynomialDegree<2>>
+  void update(ExecutionSpace const &space,
+              PreviousSourcePoints const &previous_source_points,
+              SourcePoints const &source_points,
+              PreviousTargetPoints const &previous_target_points,
+              TargetPoints const &target_points,
+              FloatingCalculationType tolerance, CRBFunc = {},
+              PolynomialDegree = {})
+  {
+    namespace KokkosExt = ArborX::Details::KokkosExt;
+
+    auto guard =
+        Kokkos::Profiling::ScopedRegion("ArborX::MovingLeastSquares::update");
+
+    static_assert(
+        KokkosExt::is_accessible_from<MemorySpace, ExecutionSpace>::value,
+        "Memory space must be accessible from the execution space");
+
+    ArborX::Details::check_valid_access_traits(PrimitivesTag{},
+                                               previous_source_points);
+    ArborX::Details::check_valid_access_traits(PrimitivesTag{}, source_points);
+    ArborX::Details::check_valid_access_traits(PrimitivesTag{},
+                                               previous_target_points);
+    ArborX::Details::check_valid_access_traits(PrimitivesTag{}, target_points);
+    using PrevSourceAccess =
+        ArborX::Details::AccessValues<PreviousSourcePoints, PrimitivesTag>;
+    using SourceAccess =
+        ArborX::Details::AccessValues<SourcePoints, PrimitivesTag>;
+    using PrevTargetAccess =
+        ArborX::Details::AccessValues<PreviousTargetPoints, PrimitivesTag>;
+    using TargetAccess =
+        ArborX::Details::AccessValues<TargetPoints, PrimitivesTag>;
+    using SourcePoint = typename SourceAccess::value_type;
+    using TargetPoint = typename TargetAccess::value_type;
+    static_assert(GeometryTraits::is_point_v<SourcePoint> &&
+                      GeometryTraits::is_point_v<TargetPoint>,
+                  "Source and target points elements must be points");
+    static_assert(
+        std::is_same_v<typename PrevSourceAccess::value_type, SourcePoint> &&
+            std::is_same_v<typename PrevTargetAccess::value_type, TargetPoint>,
+        "Previous and current point sets must hold the same point type");
+    static constexpr int dimension = GeometryTraits::dimension_v<SourcePoint>;
+    static_assert(dimension == GeometryTraits::dimension_v<TargetPoint>,
+                  "Target and source points must have the same dimension");
+    using Coordinate = GeometryTraits::coordinate_type_t<TargetPoint>;
+
+    PrevSourceAccess prev_source_access{previous_source_points}; // NOLINT
+    SourceAccess source_access{source_points};                   // NOLINT
+    PrevTargetAccess prev_target_access{previous_target_points}; // NOLINT
+    TargetAccess target_access{target_points};                   // NOLINT
+
+    // The clouds may move but not change size or correspondence
+    KOKKOS_ASSERT(prev_source_access.size() == source_access.size() &&
+                  source_access.size() == std::size_t(_source_size));
+    KOKKOS_ASSERT(prev_target_access.size() == target_access.size() &&
+                  target_access.size() == std::size_t(_num_targets));
+
+    // Flag and compact the sources that moved beyond the tolerance
+    Kokkos::View<int *, MemorySpace> moved_offsets(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::MovingLeastSquares::update::moved_offsets"),
+        _source_size + 1);
+    Kokkos::parallel_for(
+        "ArborX::MovingLeastSquares::update::flag_moved_sources",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, _source_size + 1),
+        KOKKOS_LAMBDA(int const i) {
+          moved_offsets(i) =
+              (i + 1 < moved_offsets.extent_int(0) &&
+               ArborX::Details::distance(prev_source_access(i),
+                                         source_access(i)) > tolerance);
+        });
+    KokkosExt::exclusive_scan(space, moved_offsets, moved_offsets, 0);
+    int const num_moved = KokkosExt::lastElement(space, moved_offsets);
+
+    // A target is stale as soon as it moved itself ...
+    Kokkos::View<int *, MemorySpace> stale(
+        "ArborX::MovingLeastSquares::update::stale_flags", _num_targets);
+    Kokkos::parallel_for(
+        "ArborX::MovingLeastSquares::update::flag_moved_targets",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, _num_targets),
+        KOKKOS_LAMBDA(int const i) {
+          stale(i) = (ArborX::Details::distance(prev_target_access(i),
+                                                target_access(i)) > tolerance);
+        });
+
+    // ... or as soon as a moving source swept through its stencil region
+    if (num_moved > 0)
+    {
+      using Box = ExperimentalHyperGeometry::Box<dimension, Coordinate>;
+      Kokkos::View<Box *, MemorySpace> sweep_boxes(
+          Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                             "ArborX::MovingLeastSquares::update::sweep_boxes"),
+          num_moved);
+      Kokkos::parallel_for(
+          "ArborX::MovingLeastSquares::update::fill_sweep_boxes",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, _source_size),
+          KOKKOS_LAMBDA(int const i) {
+            if (moved_offsets(i + 1) > moved_offsets(i))
+            {
+              Box box{};
+              ArborX::Details::expand(box, prev_source_access(i));
+              ArborX::Details::expand(box, source_access(i));
+              sweep_boxes(moved_offsets(i)) = box;
+            }
+          });
+      BoundingVolumeHierarchy<MemorySpace, ArborX::PairValueIndex<Box>>
+          sweep_tree(space, ArborX::Experimental::attach_indices(sweep_boxes));
+
+      // The stencil ball is measured on the previous configuration; the
+      // 2 * tolerance slack absorbs the sub-tolerance drift of both the
+      // target and its retained sources
+      using Sphere = ExperimentalHyperGeometry::Sphere<dimension, Coordinate>;
+      using Predicate = decltype(attach(intersects(Sphere{}), int{}));
+      Kokkos::View<Predicate *, MemorySpace> stencil_balls(
+          Kokkos::view_alloc(
+              space, Kokkos::WithoutInitializing,
+              "ArborX::MovingLeastSquares::update::stencil_balls"),
+          _num_targets);
+      auto const indices = _indices;
+      int const num_neighbors = _num_neighbors;
+      Kokkos::parallel_for(
+          "ArborX::MovingLeastSquares::update::fill_stencil_balls",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, _num_targets),
+          KOKKOS_LAMBDA(int const i) {
+            auto const target_point = prev_target_access(i);
+            auto const &center = reinterpret_cast<
+                ExperimentalHyperGeometry::Point<dimension, Coordinate> const &>(
+                target_point);
+            Coordinate radius = 0;
+            for (int j = 0; j < num_neighbors; j++)
+              radius = Kokkos::max(
+                  radius, ArborX::Details::distance(
+                              target_point, prev_source_access(indices(i, j))));
+            stencil_balls(i) = attach(
+                intersects(Sphere{center, radius + 2 * Coordinate(tolerance)}),
+                i);
+          });
+
+      sweep_tree.query(
+          space, stencil_balls,
+          Details::MLSMarkStaleTargetsCallback<decltype(stale)>{stale});
+    }
+
+    // Compact the stale targets
+    Kokkos::View<int *, MemorySpace> stale_offsets(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::MovingLeastSquares::update::stale_offsets"),
+        _num_targets + 1);
+    Kokkos::parallel_for(
+        "ArborX::MovingLeastSquares::update::copy_stale_flags",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, _num_targets + 1),
+        KOKKOS_LAMBDA(int const i) {
+          stale_offsets(i) = (i < stale.extent_int(0) ? stale(i) : 0);
+        });
+    KokkosExt::exclusive_scan(space, stale_offsets, stale_offsets, 0);
+    int const num_stale = KokkosExt::lastElement(space, stale_offsets);
+    if (num_stale == 0)
+      return;
+
+    Kokkos::View<TargetPoint *, MemorySpace> stale_points(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::MovingLeastSquares::update::stale_points"),
+        num_stale);
+    Kokkos::View<int *, MemorySpace> stale_ids(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::MovingLeastSquares::update::stale_ids"),
+        num_stale);
     Kokkos::parallel_for(
-        "ArborX::MovingLeastSquares::target_interpolation",
+        "ArborX::MovingLeastSquares::update::compact_stale_targets",
         Kokkos::RangePolicy<ExecutionSpace>(space, 0, _num_targets),
+        KOKKOS_LAMBDA(int const i) {
+          if (stale_offsets(i + 1) > stale_offsets(i))
+          {
+            stale_points(stale_offsets(i)) = target_access(i);
+            stale_ids(stale_offsets(i)) = i;
+          }
+        });
+
+    // Redo the search and the coefficients for the stale targets only, over
+    // the current source cloud
+    BoundingVolumeHierarchy<MemorySpace, ArborX::PairValueIndex<SourcePoint>>
+        source_tree(space, ArborX::Experimental::attach_indices(source_access));
+    auto predicates = Experimental::attach_indices(
+        Experimental::make_nearest(stale_points, _num_neighbors));
+
+    Kokkos::View<SourcePoint **, MemorySpace> source_view(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::MovingLeastSquares::update::source_view"),
+        num_stale, _num_neighbors);
+    Kokkos::View<int **, MemorySpace> stale_indices(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::MovingLeastSquares::update::stale_indices"),
+        num_stale, _num_neighbors);
+    Kokkos::View<int *, MemorySpace> counter(
+        "ArborX::MovingLeastSquares::update::counter", num_stale);
+    Details::MLSSearchNeighborsCallback<decltype(source_view),
+                                        decltype(stale_indices),
+                                        decltype(counter)>
+        callback{source_view, stale_indices, counter};
+    source_tree.query(space, predicates, callback);
+
+    ArborX::Details::AccessValues<decltype(stale_points), PrimitivesTag>
+        stale_access{stale_points}; // NOLINT
+    auto stale_coeffs = Details::movingLeastSquaresCoefficients<
+        CRBFunc, PolynomialDegree, FloatingCalculationType, AccumulationType>(
+        space, source_view, stale_access);
+
+    // Scatter the recomputed rows back; the others keep their old stencil
+    Kokkos::parallel_for(
+        "ArborX::MovingLeastSquares::update::scatter_stale_rows",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_stale),
         KOKKOS_CLASS_LAMBDA(int const i) {
-          Value tmp = 0;
+          int const row = stale_ids(i);
           for (int j = 0; j < _num_neighbors; j++)
-            tmp += _coeffs(i, j) * source_values(_indices(i, j));
-          approx_values(i) = tmp;
+          {
+            _coeffs(row, j) = stale_coeffs(i, j);
+            _indices(row, j) = stale_indices(i, j);
+          }
         });
   }
 
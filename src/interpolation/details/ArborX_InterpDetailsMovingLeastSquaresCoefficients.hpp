@@ -26,9 +26,16 @@
 namespace ArborX::Interpolation::Details
 {
 
+// AccumulatorType is the type in which the per-target linear algebra (weight
+// and Vandermonde products, moment matrix, SVD rotations) is carried out. It
+// defaults to the coefficients type, but can be set to a wider type for a
+// mixed-precision setup where the inputs and the final coefficients stay in
+// single precision (global memory traffic) while the conditioning-sensitive
+// arithmetic runs in double (registers and scratch only).
 template <typename SourcePoints, typename TargetAccess, typename Coefficients,
           typename ExecutionSpace, typename CRBFunc = CRBF::Wendland<0>,
-          typename PolynomialDegree = PolynomialDegree<2>>
+          typename PolynomialDegree = PolynomialDegree<2>,
+          typename AccumulatorType = typename Coefficients::non_const_value_type>
 class MovingLeastSquaresCoefficientsKernel
 {
 private:
@@ -48,11 +55,11 @@ private:
       Kokkos::View<T, ScratchMemorySpace, Kokkos::MemoryUnmanaged>;
 
   using LocalSourcePoints = Kokkos::Subview<SourcePoints, int, Kokkos::ALL_t>;
-  using LocalPhi = ScratchView<CoefficientsType *>;
-  using LocalVandermonde = ScratchView<CoefficientsType *[poly_size]>;
-  using LocalMoment = ScratchView<CoefficientsType[poly_size][poly_size]>;
-  using LocalSVDDiag = ScratchView<CoefficientsType[poly_size]>;
-  using LocalSVDUnit = ScratchView<CoefficientsType[poly_size][poly_size]>;
+  using LocalPhi = ScratchView<AccumulatorType *>;
+  using LocalVandermonde = ScratchView<AccumulatorType *[poly_size]>;
+  using LocalMoment = ScratchView<AccumulatorType[poly_size][poly_size]>;
+  using LocalSVDDiag = ScratchView<AccumulatorType[poly_size]>;
+  using LocalSVDUnit = ScratchView<AccumulatorType[poly_size][poly_size]>;
   using LocalCoefficients = Kokkos::Subview<Coefficients, int, Kokkos::ALL_t>;
 
 public:
@@ -159,19 +166,24 @@ private:
   KOKKOS_FUNCTION void phiComputation(LocalSourcePoints const &source_points,
                                       LocalPhi &phi) const
   {
-    CoefficientsType radius = Kokkos::Experimental::epsilon_v<CoefficientsType>;
+    AccumulatorType radius = Kokkos::Experimental::epsilon_v<AccumulatorType>;
     for (int neighbor = 0; neighbor < _num_neighbors; neighbor++)
     {
-      CoefficientsType const norm =
+      AccumulatorType const norm =
           ArborX::Details::distance(source_points(neighbor), SourcePoint{});
+      phi(neighbor) = norm;
       radius = Kokkos::max(radius, norm);
     }
 
     // The one at the limit would be 0 due to how CRBFs work
-    radius *= CoefficientsType(1.1);
+    radius *= AccumulatorType(1.1);
 
+    // The norms were stashed in phi by the radius sweep, so the CRBF
+    // evaluation neither recomputes the distances nor divides per neighbor
+    AccumulatorType const radius_reciprocal = AccumulatorType(1) / radius;
     for (int neighbor = 0; neighbor < _num_neighbors; neighbor++)
-      phi(neighbor) = CRBF::evaluate<CRBFunc>(source_points(neighbor), radius);
+      phi(neighbor) = CRBFunc::template evaluate<dimension>(
+          phi(neighbor) * radius_reciprocal);
   }
 
   // Computes the vandermonde matrix
@@ -181,7 +193,12 @@ private:
   {
     for (int neighbor = 0; neighbor < _num_neighbors; neighbor++)
     {
-      auto basis = evaluatePolynomialBasis<degree>(source_points(neighbor));
+      // Widen the recentered point before forming the monomials so that the
+      // basis products are evaluated in the accumulator type
+      ExperimentalHyperGeometry::Point<dimension, AccumulatorType> point;
+      for (int k = 0; k < dimension; k++)
+        point[k] = source_points(neighbor)[k];
+      auto basis = evaluatePolynomialBasis<degree>(point);
       for (int k = 0; k < poly_size; k++)
         vandermonde(neighbor, k) = basis[k];
     }
@@ -193,13 +210,23 @@ private:
                                          LocalMoment &moment) const
   {
     for (int i = 0; i < poly_size; i++)
-      for (int j = 0; j < poly_size; j++)
-      {
+      for (int j = i; j < poly_size; j++)
         moment(i, j) = 0;
-        for (int neighbor = 0; neighbor < _num_neighbors; neighbor++)
-          moment(i, j) += vandermonde(neighbor, i) * vandermonde(neighbor, j) *
-                          phi(neighbor);
+
+    // Accumulating neighbor by neighbor applies the weight to each basis
+    // value once instead of once per matrix entry, and only the upper
+    // triangle is built since the moment matrix is symmetric by construction
+    for (int neighbor = 0; neighbor < _num_neighbors; neighbor++)
+      for (int i = 0; i < poly_size; i++)
+      {
+        auto const weighted = vandermonde(neighbor, i) * phi(neighbor);
+        for (int j = i; j < poly_size; j++)
+          moment(i, j) += weighted * vandermonde(neighbor, j);
       }
+
+    for (int i = 1; i < poly_size; i++)
+      for (int j = 0; j < i; j++)
+        moment(i, j) = moment(j, i);
   }
 
   // Computes the coefficients
@@ -209,10 +236,11 @@ private:
   {
     for (int neighbor = 0; neighbor < _num_neighbors; neighbor++)
     {
-      coefficients(neighbor) = 0;
+      AccumulatorType tmp = 0;
       for (int i = 0; i < poly_size; i++)
-        coefficients(neighbor) +=
-            moment(0, i) * vandermonde(neighbor, i) * phi(neighbor);
+        tmp += moment(0, i) * vandermonde(neighbor, i);
+      // The only narrowing back to the coefficients type happens here
+      coefficients(neighbor) = CoefficientsType(tmp * phi(neighbor));
     }
   }
 
@@ -224,8 +252,8 @@ private:
 };
 
 template <typename CRBFunc, typename PolynomialDegree,
-          typename CoefficientsType, typename ExecutionSpace,
-          typename SourcePoints, typename TargetAccess>
+          typename CoefficientsType, typename AccumulatorType = CoefficientsType,
+          typename ExecutionSpace, typename SourcePoints, typename TargetAccess>
 auto movingLeastSquaresCoefficients(ExecutionSpace const &space,
                                     SourcePoints const &source_points,
                                     TargetAccess const &target_access)
@@ -278,7 +306,8 @@ auto movingLeastSquaresCoefficients(ExecutionSpace const &space,
 
   MovingLeastSquaresCoefficientsKernel<SourcePoints, TargetAccess,
                                        decltype(coefficients), ExecutionSpace,
-                                       CRBFunc, PolynomialDegree>
+                                       CRBFunc, PolynomialDegree,
+                                       AccumulatorType>
       kernel(space, target_access, source_points, coefficients);
 
   Kokkos::parallel_for("ArborX::MovingLeastSquaresCoefficients::kernel",
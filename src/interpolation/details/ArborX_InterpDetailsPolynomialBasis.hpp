@@ -17,6 +17,7 @@
 #include <Kokkos_Core.hpp>
 
 #include <type_traits>
+#include <utility>
 
 namespace ArborX::Interpolation
 {
@@ -100,6 +101,58 @@ KOKKOS_FUNCTION constexpr std::size_t polynomialBasisSize()
   return result;
 }
 
+// Every non-constant basis term is the product of an earlier term and a
+// single coordinate. This flattens the slice recursion into one (source
+// term, coordinate) pair per term, computed at compile time, so that the
+// evaluation can be expanded into straight-line code.
+template <std::size_t DIM, std::size_t Degree>
+KOKKOS_FUNCTION constexpr auto polynomialBasisTermRecurrence()
+{
+  struct
+  {
+    std::size_t prev[polynomialBasisSize<DIM, Degree>()]{};
+    std::size_t dim[polynomialBasisSize<DIM, Degree>()]{};
+  } result;
+
+  auto slice_lengths = polynomialBasisSliceLengths<DIM, Degree>();
+
+  std::size_t prev_col = 0;
+  std::size_t curr_col = 1;
+
+  for (std::size_t deg = 0; deg < Degree; deg++)
+  {
+    std::size_t loc_offset = curr_col;
+    for (std::size_t dim = 0; dim < DIM; dim++)
+    {
+      for (std::size_t i = 0; i < slice_lengths.arr[deg][dim]; i++)
+      {
+        result.prev[loc_offset + i] = prev_col + i;
+        result.dim[loc_offset + i] = dim;
+      }
+
+      loc_offset += slice_lengths.arr[deg][dim];
+    }
+
+    prev_col = curr_col;
+    curr_col = loc_offset;
+  }
+
+  return result;
+}
+
+// Expanding over a compile-time term list turns the evaluation into a fixed
+// sequence of multiplies with constant indices. Terms only refer to earlier
+// terms, and the comma fold evaluates left to right.
+template <std::size_t Degree, typename Array, typename Point,
+          std::size_t... Is>
+KOKKOS_FUNCTION void evaluatePolynomialBasisTerms(Array &arr, Point const &p,
+                                                  std::index_sequence<Is...>)
+{
+  static constexpr std::size_t DIM = GeometryTraits::dimension_v<Point>;
+  static constexpr auto term = polynomialBasisTermRecurrence<DIM, Degree>();
+  ((arr[Is + 1] = arr[term.prev[Is + 1]] * p[term.dim[Is + 1]]), ...);
+}
+
 // This creates the list by building each slices in-place
 template <std::size_t Degree, typename Point>
 KOKKOS_FUNCTION auto evaluatePolynomialBasis(Point const &p)
@@ -109,34 +162,13 @@ KOKKOS_FUNCTION auto evaluatePolynomialBasis(Point const &p)
   using Value = typename GeometryTraits::coordinate_type_t<Point>;
   static_assert(DIM > 0, "Polynomial basis with no dimension is invalid");
 
-  Kokkos::Array<Value, polynomialBasisSize<DIM, Degree>()> arr{};
+  static constexpr std::size_t size = polynomialBasisSize<DIM, Degree>();
+  Kokkos::Array<Value, size> arr{};
   arr[0] = Value(1);
 
   if constexpr (Degree > 0)
-  {
-    // Cannot use structured binding with constexpr
-    static constexpr auto slice_lengths =
-        polynomialBasisSliceLengths<DIM, Degree>();
-
-    std::size_t prev_col = 0;
-    std::size_t curr_col = 1;
-
-    for (std::size_t deg = 0; deg < Degree; deg++)
-    {
-      std::size_t loc_offset = curr_col;
-      for (std::size_t dim = 0; dim < DIM; dim++)
-      {
-        // copy the previous column and multply by p[dim]
-        for (std::size_t i = 0; i < slice_lengths.arr[deg][dim]; i++)
-          arr[loc_offset + i] = arr[prev_col + i] * p[dim];
-
-        loc_offset += slice_lengths.arr[deg][dim];
-      }
-
-      prev_col = curr_col;
-      curr_col = loc_offset;
-    }
-  }
+    evaluatePolynomialBasisTerms<Degree>(arr, p,
+                                         std::make_index_sequence<size - 1>{});
 
   return arr;
 }
@@ -226,6 +226,178 @@ KOKKOS_FUNCTION void symmetricPseudoInverseSVDKernel(Matrix &mat, Diag &diag,
     }
 }
 
+// Team-cooperative variant of the kernel above. The members of a team work on
+// a single matrix together: the pivot search is a team reduction over the
+// upper triangle and the rotations are applied row-parallel. The rotation
+// sequence itself is identical to the per-thread kernel, so both produce the
+// same result.
+template <typename TeamMember, typename Matrix, typename Diag, typename Unit>
+KOKKOS_FUNCTION void
+symmetricPseudoInverseSVDTeamKernel(TeamMember const &member, Matrix &mat,
+                                    Diag &diag, Unit &unit)
+{
+  ensureIsSquareSymmetricMatrix(mat);
+  static_assert(!std::is_const_v<typename Matrix::value_type>,
+                "mat must be writable");
+
+  static_assert(Kokkos::is_view_v<Diag>, "diag must be a view");
+  static_assert(Diag::rank == 1, "diag must be 1D");
+  static_assert(!std::is_const_v<typename Diag::value_type>,
+                "diag must be writable");
+
+  ensureIsSquareMatrix(unit);
+  static_assert(!std::is_const_v<typename Unit::value_type>,
+                "unit must be writable");
+  static_assert(
+      std::is_same_v<typename Matrix::value_type, typename Diag::value_type> &&
+          std::is_same_v<typename Diag::value_type, typename Unit::value_type>,
+      "All input matrices must have the same value type");
+  KOKKOS_ASSERT(mat.extent(0) == diag.extent(0) &&
+                diag.extent(0) == unit.extent(0));
+  using Value = typename Matrix::non_const_value_type;
+  int const size = mat.extent(0);
+
+  // We first initialize 'unit' as the identity matrix
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(member, size * size),
+                       [&](int k) {
+                         int const i = k / size;
+                         int const j = k % size;
+                         unit(i, j) = Value(i == j);
+                       });
+  member.team_barrier();
+
+  static constexpr Value epsilon = Kokkos::Experimental::epsilon_v<float>;
+  while (true)
+  {
+    // Team-wide argmax over the upper triangle; the result is broadcast to
+    // every member, so all of them agree on the pivot
+    using MaxLocReducer = Kokkos::MaxLoc<Value, int>;
+    typename MaxLocReducer::value_type pivot;
+    Kokkos::parallel_reduce(
+        Kokkos::TeamThreadRange(member, size * size),
+        [&](int k, typename MaxLocReducer::value_type &update) {
+          int const i = k / size;
+          int const j = k % size;
+          if (i < j)
+          {
+            Value const val = Kokkos::abs(mat(i, j));
+            if (update.val < val)
+            {
+              update.val = val;
+              update.loc = k;
+            }
+          }
+        },
+        MaxLocReducer(pivot));
+    if (pivot.val <= epsilon)
+      break;
+
+    // We have a guarantee that p < q
+    int const p = pivot.loc / size;
+    int const q = pivot.loc % size;
+
+    auto const a = mat(p, p);
+    auto const b = mat(p, q);
+    auto const c = mat(q, q);
+
+    // Every member redundantly computes the rotation that diagonalizes the
+    // 2x2 submatrix (see the per-thread kernel for the derivation)
+    Value cos_theta;
+    Value sin_theta;
+    Value x;
+    Value y;
+    if (a == c)
+    {
+      cos_theta = Kokkos::sqrt(Value(2)) / 2;
+      sin_theta = cos_theta;
+      x = a + b;
+      y = a - b;
+    }
+    else
+    {
+      auto const u = (2 * b) / (a - c);
+      auto const v = 1 / Kokkos::sqrt(u * u + 1);
+      cos_theta = Kokkos::sqrt((1 + v) / 2);
+      sin_theta = Kokkos::copysign(Kokkos::sqrt((1 - v) / 2), u);
+      x = (a + c + (a - c) / v) / 2;
+      y = a + c - x;
+    }
+
+    // R'(theta)^T . mat . R'(theta), row-parallel: rows (or columns) i
+    // different from p and q are mutually independent, and the three entries
+    // at the crossings are set separately
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(member, size), [&](int i) {
+      if (i == p || i == q)
+        return;
+      if (i < p)
+      {
+        auto const es_ip = mat(i, p);
+        auto const es_iq = mat(i, q);
+        mat(i, p) = cos_theta * es_ip + sin_theta * es_iq;
+        mat(i, q) = -sin_theta * es_ip + cos_theta * es_iq;
+      }
+      else if (i < q)
+      {
+        auto const es_pi = mat(p, i);
+        auto const es_iq = mat(i, q);
+        mat(p, i) = cos_theta * es_pi + sin_theta * es_iq;
+        mat(i, q) = -sin_theta * es_pi + cos_theta * es_iq;
+      }
+      else
+      {
+        auto const es_pi = mat(p, i);
+        auto const es_qi = mat(q, i);
+        mat(p, i) = cos_theta * es_pi + sin_theta * es_qi;
+        mat(q, i) = -sin_theta * es_pi + cos_theta * es_qi;
+      }
+    });
+    Kokkos::single(Kokkos::PerTeam(member), [&]() {
+      mat(p, p) = x;
+      mat(p, q) = 0;
+      mat(q, q) = y;
+    });
+
+    // unit . R'(theta)
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(member, size), [&](int i) {
+      auto const u_ip = unit(i, p);
+      auto const u_iq = unit(i, q);
+      unit(i, p) = cos_theta * u_ip + sin_theta * u_iq;
+      unit(i, q) = -sin_theta * u_ip + cos_theta * u_iq;
+    });
+    member.team_barrier();
+  }
+
+  // We compute the max to get a range of the invertible eigenvalues
+  Value max_eigen;
+  Kokkos::parallel_reduce(
+      Kokkos::TeamThreadRange(member, size),
+      [&](int i, Value &update) {
+        diag(i) = mat(i, i);
+        update = Kokkos::max(Kokkos::abs(mat(i, i)), update);
+      },
+      Kokkos::Max<Value>(max_eigen));
+  max_eigen = Kokkos::max(max_eigen, epsilon);
+  auto const threshold = max_eigen * epsilon;
+  member.team_barrier();
+
+  // We invert the diagonal of 'mat', except if "0" is found
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(member, size), [&](int i) {
+    diag(i) = (Kokkos::abs(diag(i)) < threshold) ? 0 : 1 / diag(i);
+  });
+  member.team_barrier();
+
+  // Then we fill out 'mat' as the pseudo inverse
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(member, size * size),
+                       [&](int k) {
+                         int const i = k / size;
+                         int const j = k % size;
+                         Value value = 0;
+                         for (int l = 0; l < size; l++)
+                           value += diag(l) * unit(i, l) * unit(j, l);
+                         mat(i, j) = value;
+                       });
+}
+
 template <typename ExecutionSpace, typename InOutMatrices>
 void symmetricPseudoInverseSVD(ExecutionSpace const &space,
                                InOutMatrices &matrices)
@@ -247,25 +419,52 @@ void symmetricPseudoInverseSVD(ExecutionSpace const &space,
   KOKKOS_ASSERT(matrices.extent(1) == matrices.extent(2)); // Must be square
 
   using Value = typename InOutMatrices::non_const_value_type;
-  using MemorySpace = typename InOutMatrices::memory_space;
 
-  Kokkos::View<Value **, MemorySpace> diags(
-      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
-                         "ArborX::SymmetricPseudoInverseSVD::diags"),
-      matrices.extent(0), matrices.extent(1));
-  Kokkos::View<Value ***, MemorySpace> units(
-      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
-                         "ArborX::SymmetricPseudoInverseSVD::units"),
-      matrices.extent(0), matrices.extent(1), matrices.extent(2));
+  int const num_matrices = matrices.extent(0);
+  int const size = matrices.extent(1);
+  if (num_matrices == 0 || size == 0)
+    return;
+
+  // One team per matrix; the matrix and the two work arrays of the SVD are
+  // staged in team scratch so that the Jacobi sweeps never touch global memory
+  using TeamPolicy = Kokkos::TeamPolicy<ExecutionSpace>;
+  using ScratchMemorySpace = typename ExecutionSpace::scratch_memory_space;
+  using ScratchMatrix =
+      Kokkos::View<Value **, ScratchMemorySpace, Kokkos::MemoryUnmanaged>;
+  using ScratchDiag =
+      Kokkos::View<Value *, ScratchMemorySpace, Kokkos::MemoryUnmanaged>;
+
+  std::size_t const shmem_size =
+      2 * ScratchMatrix::shmem_size(size, size) + ScratchDiag::shmem_size(size);
+  // Large matrices (the size grows quickly with the polynomial degree) do not
+  // fit in the on-chip scratch and fall back to the global memory backed level
+  int const level =
+      (shmem_size <= (std::size_t)TeamPolicy::scratch_size_max(0)) ? 0 : 1;
+
+  TeamPolicy policy(space, num_matrices, Kokkos::AUTO);
+  policy.set_scratch_size(level, Kokkos::PerTeam(shmem_size));
 
   Kokkos::parallel_for(
-      "ArborX::SymmetricPseudoInverseSVD::computations",
-      Kokkos::RangePolicy<ExecutionSpace>(space, 0, matrices.extent(0)),
-      KOKKOS_LAMBDA(int const i) {
-        auto mat = Kokkos::subview(matrices, i, Kokkos::ALL, Kokkos::ALL);
-        auto diag = Kokkos::subview(diags, i, Kokkos::ALL);
-        auto unit = Kokkos::subview(units, i, Kokkos::ALL, Kokkos::ALL);
-        symmetricPseudoInverseSVDKernel(mat, diag, unit);
+      "ArborX::SymmetricPseudoInverseSVD::computations", policy,
+      KOKKOS_LAMBDA(typename TeamPolicy::member_type const &member) {
+        int const i = member.league_rank();
+        ScratchMatrix mat(member.team_scratch(level), size, size);
+        ScratchDiag diag(member.team_scratch(level), size);
+        ScratchMatrix unit(member.team_scratch(level), size, size);
+
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange(member, size * size), [&](int k) {
+              mat(k / size, k % size) = matrices(i, k / size, k % size);
+            });
+        member.team_barrier();
+
+        symmetricPseudoInverseSVDTeamKernel(member, mat, diag, unit);
+        member.team_barrier();
+
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange(member, size * size), [&](int k) {
+              matrices(i, k / size, k % size) = mat(k / size, k % size);
+            });
       });
 }
 
@@ -0,0 +1,173 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILS_KOKKOS_EXT_RADIX_SORT_HPP
+#define ARBORX_DETAILS_KOKKOS_EXT_RADIX_SORT_HPP
+
+#include <ArborX_DetailsKokkosExtAccessibilityTraits.hpp>
+#include <ArborX_DetailsKokkosExtMinMaxOperations.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp> // exclusive_scan
+#include <ArborX_Exception.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <type_traits>
+
+namespace ArborX::Details::KokkosExt
+{
+
+// Keys qualify for the radix sort below if they expose the operations its
+// byte extraction uses (shift by a bit count, mask, conversion to int) and
+// the bitwise and/or reductions. Unsigned integers qualify out of the box;
+// wider code types opt in by specializing this trait.
+template <typename T>
+struct is_radix_sortable
+    : std::bool_constant<std::is_integral_v<T> && std::is_unsigned_v<T>>
+{};
+
+// Stable LSD radix sort for unsigned integer keys (Morton codes and similar)
+// carrying the values along. Keys are processed eight bits at a time; each
+// pass splits the data into chunks, counts the digits per chunk, computes
+// global stable offsets with a single exclusive scan over the digit-major
+// count matrix, and scatters. Bytes on which all keys agree are detected
+// upfront with a bitwise and/or reduction and skipped, so nearly-uniform key
+// distributions (e.g., Morton codes of a localized cloud) only pay for the
+// passes that discriminate.
+template <typename ExecutionSpace, typename Keys, typename Values>
+void radixSortByKey(ExecutionSpace const &space, Keys &keys, Values &values)
+{
+  Kokkos::Profiling::ScopedRegion guard("ArborX::KokkosExt::radixSortByKey");
+
+  static_assert(Kokkos::is_view<Keys>::value);
+  static_assert(Kokkos::is_view<Values>::value);
+  static_assert(Keys::rank == 1);
+  static_assert(Values::rank == 1);
+  static_assert(is_accessible_from<typename Keys::memory_space,
+                                   ExecutionSpace>::value);
+  static_assert(is_accessible_from<typename Values::memory_space,
+                                   ExecutionSpace>::value);
+
+  using KeyType = typename Keys::non_const_value_type;
+  using ValueType = typename Values::non_const_value_type;
+  static_assert(is_radix_sortable<KeyType>::value,
+                "radix sort requires unsigned integer or radix-sortable keys");
+
+  using MemorySpace = typename Keys::memory_space;
+
+  int const n = keys.size();
+  ARBORX_ASSERT(values.extent_int(0) == n);
+
+  if (n <= 1)
+    return;
+
+  // Find the bytes on which the keys actually differ
+  KeyType keys_and, keys_or;
+  Kokkos::parallel_reduce(
+      "ArborX::RadixSort::reduce_key_bits",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i, KeyType &update_and, KeyType &update_or) {
+        auto const key = keys(i);
+        update_and &= key;
+        update_or |= key;
+      },
+      Kokkos::BAnd<KeyType>(keys_and), Kokkos::BOr<KeyType>(keys_or));
+  KeyType const differing_bits = keys_and ^ keys_or;
+  if (differing_bits == 0)
+    return;
+
+  // One chunk per thread keeps the counting and the scatter free of atomics
+  // while providing enough independent work on every backend
+  int const concurrency = space.concurrency();
+  int const chunk_size = max(1024, n / (8 * concurrency) + 1);
+  int const num_chunks = (n + chunk_size - 1) / chunk_size;
+
+  constexpr int num_digits = 256;
+
+  Kokkos::View<unsigned int *, MemorySpace> counts(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::RadixSort::counts"),
+      num_digits * num_chunks);
+
+  Kokkos::View<KeyType *, MemorySpace> scratch_keys(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::RadixSort::scratch_keys"),
+      n);
+  Kokkos::View<ValueType *, MemorySpace> scratch_values(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::RadixSort::scratch_values"),
+      n);
+
+  bool forward = true;
+  for (int byte = 0; byte < (int)sizeof(KeyType); ++byte)
+  {
+    int const shift = 8 * byte;
+    if (((differing_bits >> shift) & (KeyType)0xff) == 0)
+      continue;
+
+    Kokkos::deep_copy(space, counts, 0);
+
+    Kokkos::parallel_for(
+        "ArborX::RadixSort::count_digits",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_chunks),
+        KOKKOS_LAMBDA(int chunk) {
+          int const begin = chunk * chunk_size;
+          int const end = min(begin + chunk_size, n);
+          for (int i = begin; i < end; ++i)
+          {
+            auto const key = forward ? keys(i) : scratch_keys(i);
+            int const digit = (int)((key >> shift) & (KeyType)0xff);
+            ++counts(digit * num_chunks + chunk);
+          }
+        });
+
+    // The digit-major layout of the counts turns the scan result into
+    // stable global scatter offsets
+    exclusive_scan(space, counts, counts, 0);
+
+    Kokkos::parallel_for(
+        "ArborX::RadixSort::scatter",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_chunks),
+        KOKKOS_LAMBDA(int chunk) {
+          int const begin = chunk * chunk_size;
+          int const end = min(begin + chunk_size, n);
+          for (int i = begin; i < end; ++i)
+          {
+            auto const key = forward ? keys(i) : scratch_keys(i);
+            int const digit = (int)((key >> shift) & (KeyType)0xff);
+            auto const j = counts(digit * num_chunks + chunk)++;
+            if (forward)
+            {
+              scratch_keys(j) = key;
+              scratch_values(j) = values(i);
+            }
+            else
+            {
+              keys(j) = key;
+              values(j) = scratch_values(i);
+            }
+          }
+        });
+
+    forward = !forward;
+  }
+
+  if (!forward)
+  {
+    // An odd number of passes left the result in the scratch buffers
+    Kokkos::deep_copy(space, keys, scratch_keys);
+    Kokkos::deep_copy(space, values, scratch_values);
+  }
+}
+
+} // namespace ArborX::Details::KokkosExt
+
+#endif
@@ -0,0 +1,156 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#ifndef ARBORX_DETAILS_KOKKOS_EXT_SCRATCH_ARENA_HPP
+#define ARBORX_DETAILS_KOKKOS_EXT_SCRATCH_ARENA_HPP
+
+#include <Kokkos_Core.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ArborX::Details::KokkosExt
+{
+
+namespace Impl
+{
+
+template <typename MemorySpace>
+struct ScratchArenaState
+{
+  Kokkos::View<char *, MemorySpace> _storage{
+      "ArborX::ScratchArena::storage", 0};
+  // Chunks allocated when the main storage overflowed. They are kept alive
+  // until the outermost frame is destroyed, at which point the main storage
+  // is grown to the high-water mark so that subsequent frames are served from
+  // a single allocation.
+  std::vector<Kokkos::View<char *, MemorySpace>> _overflow;
+  std::size_t _offset = 0;
+  std::size_t _overflow_bytes = 0;
+  std::size_t _high_water = 0;
+};
+
+// One arena per execution space instance: temporaries drawn from an arena are
+// only reused by later kernels submitted to the same instance, making the
+// recycling stream-ordered and thus safe without extra fences.
+template <typename MemorySpace>
+std::shared_ptr<ScratchArenaState<MemorySpace>>
+scratchArenaState(uint64_t instance_id)
+{
+  static std::mutex mutex;
+  static std::unordered_map<uint64_t,
+                            std::shared_ptr<ScratchArenaState<MemorySpace>>>
+      arenas;
+
+  std::lock_guard<std::mutex> guard(mutex);
+  if (arenas.empty())
+    Kokkos::push_finalize_hook([]() {
+      std::lock_guard<std::mutex> guard(mutex);
+      arenas.clear();
+    });
+  auto &state = arenas[instance_id];
+  if (!state)
+    state = std::make_shared<ScratchArenaState<MemorySpace>>();
+  return state;
+}
+
+} // namespace Impl
+
+// Bump allocator for the short-lived Kokkos::View temporaries allocated
+// inside query() phases. Device allocations (cudaMalloc and friends)
+// synchronize the whole device and serialize multi-stream pipelines; the
+// arena pays that cost once and recycles the memory across calls.
+//
+// Usage follows stack discipline: constructing a ScratchArena opens a frame,
+// views obtained from allocate() are valid for the lifetime of that frame,
+// and the destructor rewinds the arena to where the frame started. Frames may
+// nest. The returned views are unmanaged, so the caller must not resize or
+// reallocate them.
+template <typename MemorySpace>
+class ScratchArena
+{
+  static_assert(Kokkos::is_memory_space_v<MemorySpace>);
+
+  // Generous alignment so that any value type, including SIMD-friendly ones,
+  // can be served from an arbitrary frame position
+  static constexpr std::size_t alignment = 128;
+
+  std::shared_ptr<Impl::ScratchArenaState<MemorySpace>> _state;
+  std::size_t _frame_offset;
+
+public:
+  using memory_space = MemorySpace;
+
+  template <typename ExecutionSpace,
+            typename = std::enable_if_t<
+                Kokkos::is_execution_space_v<ExecutionSpace>>>
+  explicit ScratchArena(ExecutionSpace const &space)
+      : _state(Impl::scratchArenaState<MemorySpace>(space.impl_instance_id()))
+      , _frame_offset(_state->_offset)
+  {}
+
+  ScratchArena(ScratchArena const &) = delete;
+  ScratchArena &operator=(ScratchArena const &) = delete;
+
+  ~ScratchArena()
+  {
+    auto &state = *_state;
+    state._offset = _frame_offset;
+    if (_frame_offset == 0 && !state._overflow.empty())
+    {
+      // Outermost frame closed after an overflow: consolidate into a single
+      // chunk sized to the high-water mark
+      state._overflow.clear();
+      state._overflow_bytes = 0;
+      state._storage = Kokkos::View<char *, MemorySpace>(
+          Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                             "ArborX::ScratchArena::storage"),
+          state._high_water);
+    }
+  }
+
+  template <typename T>
+  Kokkos::View<T *, MemorySpace, Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+  allocate(std::size_t n) const
+  {
+    auto &state = *_state;
+
+    std::size_t const bytes = n * sizeof(T);
+    std::size_t const start =
+        (state._offset + alignment - 1) & ~(alignment - 1);
+    if (start + bytes <= state._storage.size())
+    {
+      state._offset = start + bytes;
+      state._high_water =
+          Kokkos::max(state._high_water, state._offset + state._overflow_bytes);
+      return {reinterpret_cast<T *>(state._storage.data() + start), n};
+    }
+
+    // Does not fit: serve from a dedicated chunk that survives until the
+    // outermost frame is destroyed
+    std::size_t const chunk_bytes =
+        (bytes + alignment - 1) & ~(alignment - 1);
+    state._overflow.emplace_back(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                           "ArborX::ScratchArena::overflow"),
+        chunk_bytes);
+    state._overflow_bytes += chunk_bytes;
+    state._high_water =
+        Kokkos::max(state._high_water, state._offset + state._overflow_bytes);
+    return {reinterpret_cast<T *>(state._overflow.back().data()), n};
+  }
+};
+
+} // namespace ArborX::Details::KokkosExt
+
+#endif
@@ -0,0 +1,127 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILS_KOKKOS_EXT_SEGMENTED_SORT_HPP
+#define ARBORX_DETAILS_KOKKOS_EXT_SEGMENTED_SORT_HPP
+
+#include <ArborX_DetailsKokkosExtAccessibilityTraits.hpp>
+#include <ArborX_Exception.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_NestedSort.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+namespace ArborX::Details::KokkosExt
+{
+
+// Sort the keys (dragging the values along) within every segment
+// [offsets(i), offsets(i + 1)), leaving the segments themselves in place.
+// Short segments are handled one per thread with a serial insertion sort;
+// the remaining ones get a team each, with the team size picked by the
+// backend, running the nested team sort. Compared to a flat sort of the
+// whole array with synthesized segment keys this skips the key widening
+// pass, and the short segments -- the common case for per-query results --
+// never leave the lowest level of the memory hierarchy.
+template <typename ExecutionSpace, typename Offsets, typename Keys,
+          typename Values>
+void segmentedSortByKey(ExecutionSpace const &space, Offsets const &offsets,
+                        Keys &keys, Values &values)
+{
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::KokkosExt::segmentedSortByKey");
+
+  static_assert(Kokkos::is_view<Offsets>::value);
+  static_assert(Kokkos::is_view<Keys>::value);
+  static_assert(Kokkos::is_view<Values>::value);
+  static_assert(Offsets::rank == 1);
+  static_assert(Keys::rank == 1);
+  static_assert(Values::rank == 1);
+  static_assert(is_accessible_from<typename Offsets::memory_space,
+                                   ExecutionSpace>::value);
+  static_assert(
+      is_accessible_from<typename Keys::memory_space, ExecutionSpace>::value);
+  static_assert(
+      is_accessible_from<typename Values::memory_space, ExecutionSpace>::value);
+
+  ARBORX_ASSERT(offsets.size() > 0);
+  ARBORX_ASSERT(keys.size() == values.size());
+
+  int const n_segments = offsets.size() - 1;
+  if (n_segments == 0 || keys.size() == 0)
+    return;
+
+  using MemorySpace = typename Keys::memory_space;
+
+  // One thread per segment beats a team until the serial insertion sort
+  // stops fitting the lowest level of the memory hierarchy
+  constexpr int short_segment_max = 32;
+
+  Kokkos::View<int *, MemorySpace> long_segments(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::KokkosExt::segmentedSortByKey::long_segments"),
+      n_segments);
+  int num_long_segments;
+  Kokkos::parallel_scan(
+      "ArborX::KokkosExt::segmentedSortByKey::find_long_segments",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_segments),
+      KOKKOS_LAMBDA(int i, int &partial, bool final_pass) {
+        if (offsets(i + 1) - offsets(i) > short_segment_max)
+        {
+          if (final_pass)
+            long_segments(partial) = i;
+          ++partial;
+        }
+      },
+      num_long_segments);
+
+  Kokkos::parallel_for(
+      "ArborX::KokkosExt::segmentedSortByKey::sort_short_segments",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_segments),
+      KOKKOS_LAMBDA(int i) {
+        int const begin = offsets(i);
+        int const end = offsets(i + 1);
+        if (end - begin > short_segment_max)
+          return;
+        for (int j = begin + 1; j < end; ++j)
+        {
+          auto key = keys(j);
+          auto value = values(j);
+          int k = j - 1;
+          for (; k >= begin && key < keys(k); --k)
+          {
+            keys(k + 1) = keys(k);
+            values(k + 1) = values(k);
+          }
+          keys(k + 1) = key;
+          values(k + 1) = value;
+        }
+      });
+
+  if (num_long_segments > 0)
+  {
+    using TeamPolicy = Kokkos::TeamPolicy<ExecutionSpace>;
+    Kokkos::parallel_for(
+        "ArborX::KokkosExt::segmentedSortByKey::sort_long_segments",
+        TeamPolicy(space, num_long_segments, Kokkos::AUTO),
+        KOKKOS_LAMBDA(typename TeamPolicy::member_type const &team) {
+          int const i = long_segments(team.league_rank());
+          auto const range = Kokkos::make_pair(offsets(i), offsets(i + 1));
+          Kokkos::Experimental::sort_by_key_team(
+              team, Kokkos::subview(keys, range),
+              Kokkos::subview(values, range));
+        });
+  }
+}
+
+} // namespace ArborX::Details::KokkosExt
+
+#endif
@@ -15,6 +15,7 @@
 #include <ArborX_Config.hpp> // ARBORX_ENABLE_ROCTHRUST
 
 #include <ArborX_DetailsKokkosExtMinMaxReduce.hpp>
+#include <ArborX_DetailsKokkosExtRadixSort.hpp>
 
 #include <Kokkos_Profiling_ScopedRegion.hpp>
 #include <Kokkos_Sort.hpp>
@@ -95,18 +96,30 @@ void sortByKey(ExecutionSpace const &space, Keys &keys, Values &values)
   if (n == 0)
     return;
 
-  auto [min_val, max_val] = minmax_reduce(space, keys);
-  if (min_val == max_val)
+  // Radix-sortable keys (notably the Morton codes in tree construction,
+  // including the 128-bit extended-precision codes) go through the dedicated
+  // radix sort, which beats the generic bin sort on backends without a
+  // vendor path
+  if constexpr (is_radix_sortable<typename Keys::non_const_value_type>::value)
+  {
+    radixSortByKey(space, keys, values);
     return;
-
-  using SizeType = unsigned int;
-  using CompType = Kokkos::BinOp1D<Keys>;
-
-  Kokkos::BinSort<Keys, CompType, typename Keys::device_type, SizeType>
-      bin_sort(space, keys, CompType(n / 2, min_val, max_val), true);
-  bin_sort.create_permute_vector(space);
-  bin_sort.sort(space, keys);
-  bin_sort.sort(space, values);
+  }
+  else
+  {
+    auto [min_val, max_val] = minmax_reduce(space, keys);
+    if (min_val == max_val)
+      return;
+
+    using SizeType = unsigned int;
+    using CompType = Kokkos::BinOp1D<Keys>;
+
+    Kokkos::BinSort<Keys, CompType, typename Keys::device_type, SizeType>
+        bin_sort(space, keys, CompType(n / 2, min_val, max_val), true);
+    bin_sort.create_permute_vector(space);
+    bin_sort.sort(space, keys);
+    bin_sort.sort(space, values);
+  }
 }
 
 #if defined(KOKKOS_ENABLE_CUDA) ||                                             \
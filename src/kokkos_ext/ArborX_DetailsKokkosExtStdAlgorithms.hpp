@@ -57,6 +57,44 @@ void exclusive_scan(ExecutionSpace const &space, SrcView const &src,
       });
 }
 
+// Counterpart of exclusive_scan() whose source elements are produced by a
+// callable instead of read from a view: dst(i) = init + transform(0) + ... +
+// transform(i - 1). Kokkos lowers parallel_scan to a single-pass
+// (decoupled-lookback) scan on GPU backends, so fusing the element
+// production into the scan spares materializing the source array in one
+// kernel only to re-read it in the next.
+template <typename ExecutionSpace, typename Transform, typename DstView,
+          typename InitValueType>
+void transform_exclusive_scan(ExecutionSpace const &space, std::size_t n,
+                              Transform const &transform, DstView const &dst,
+                              InitValueType init)
+{
+  static_assert(Kokkos::is_execution_space<ExecutionSpace>::value);
+  static_assert(Kokkos::is_view<DstView>::value);
+  static_assert(
+      is_accessible_from<typename DstView::memory_space, ExecutionSpace>::value,
+      "Destination view must be accessible from the execution space");
+  static_assert(
+      std::is_same_v<typename DstView::value_type,
+                     typename DstView::non_const_value_type>,
+      "transform_exclusive_scan requires non-const destination type");
+  static_assert(unsigned(DstView::rank) == unsigned(1),
+                "transform_exclusive_scan requires Views of rank 1");
+
+  using ValueType = typename DstView::value_type;
+
+  ARBORX_ASSERT(n == dst.extent(0));
+  Kokkos::parallel_scan(
+      "ArborX::Algorithms::transform_exclusive_scan",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i, ValueType &update, bool final_pass) {
+        ValueType const tmp = transform(i);
+        if (final_pass)
+          dst(i) = update + init;
+        update += tmp;
+      });
+}
+
 template <typename ExecutionSpace, typename ViewType>
 typename ViewType::non_const_value_type
 reduce(ExecutionSpace const &space, ViewType const &v,
@@ -190,6 +190,25 @@ auto makeNearestQueries(
   return queries;
 }
 
+template <typename DeviceType>
+auto makeApproxNearestQueries(
+    std::vector<std::tuple<ArborX::Point, int, float>> const &points)
+{
+  // NOTE: each entry stores the query point, the number k of neighbors to
+  // query for, and the relative distance slack eps
+  int const n = points.size();
+  Kokkos::View<
+      ArborX::PredicateWithDistanceSlack<ArborX::Nearest<ArborX::Point>> *,
+      DeviceType>
+      queries("Testing::approx_nearest_queries", n);
+  auto queries_host = Kokkos::create_mirror_view(queries);
+  for (int i = 0; i < n; ++i)
+    queries_host(i) = ArborX::nearest(
+        std::get<0>(points[i]), std::get<1>(points[i]), std::get<2>(points[i]));
+  Kokkos::deep_copy(queries, queries_host);
+  return queries;
+}
+
 template <typename DeviceType>
 auto makeBoxNearestQueries(
     std::vector<std::tuple<ArborX::Point, ArborX::Point, int>> const &boxes)
@@ -0,0 +1,131 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborXTest_StdVectorToKokkosView.hpp"
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_BVHForest.hpp>
+#include <ArborX_PairValueIndex.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(BVHForest)
+
+namespace
+{
+// Nine points on a line split into three trees of three values each
+template <typename ExecutionSpace>
+auto makeLineForest(ExecutionSpace const &exec_space)
+{
+  using MemorySpace = typename ExecutionSpace::memory_space;
+  using Value = ArborX::PairValueIndex<ArborX::Point>;
+
+  int const n = 9;
+  std::vector<Value> values;
+  values.reserve(n);
+  for (int i = 0; i < n; ++i)
+    values.push_back({{(float)i, 0.f, 0.f}, (unsigned)i});
+
+  auto values_view =
+      ArborXTest::toView<ExecutionSpace>(values, "Test::forest_values");
+  auto offsets = ArborXTest::toView<ExecutionSpace>(
+      std::vector<int>{0, 3, 6, 9}, "Test::forest_offsets");
+
+  return ArborX::Experimental::BVHForest<MemorySpace, Value>(
+      exec_space, values_view, offsets);
+}
+
+template <typename IndicesHost, typename OffsetsHost>
+std::vector<int> sortedSegment(IndicesHost const &indices,
+                               OffsetsHost const &offsets, int i)
+{
+  std::vector<int> result(indices.data() + offsets(i),
+                          indices.data() + offsets(i + 1));
+  std::sort(result.begin(), result.end());
+  return result;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(forest_query_all_trees_spatial, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace exec_space;
+
+  auto const forest = makeLineForest(exec_space);
+  BOOST_TEST(forest.size() == 9);
+  BOOST_TEST(forest.numTrees() == 3);
+
+  // The second query straddles a tree boundary, so its matches can only
+  // come from a merged forest-wide search
+  auto queries = ArborXTest::toView<ExecutionSpace>(
+      std::vector<decltype(ArborX::intersects(ArborX::Sphere{}))>{
+          ArborX::intersects(ArborX::Sphere{{4.f, 0.f, 0.f}, 1.5f}),
+          ArborX::intersects(ArborX::Sphere{{2.5f, 0.f, 0.f}, 1.f}),
+      },
+      "Test::queries");
+
+  Kokkos::View<int *, MemorySpace> indices("Test::indices", 0);
+  Kokkos::View<int *, MemorySpace> offsets("Test::offsets", 0);
+  forest.query(exec_space, queries, indices, offsets);
+
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  auto offsets_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets);
+  BOOST_TEST(offsets_host.size() == 3);
+  BOOST_TEST(sortedSegment(indices_host, offsets_host, 0) ==
+             (std::vector<int>{3, 4, 5}));
+  BOOST_TEST(sortedSegment(indices_host, offsets_host, 1) ==
+             (std::vector<int>{2, 3}));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(forest_query_all_trees_nearest, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace exec_space;
+
+  auto const forest = makeLineForest(exec_space);
+
+  // The neighbors of the second query live in two different trees
+  auto queries = ArborXTest::toView<ExecutionSpace>(
+      std::vector<ArborX::Nearest<ArborX::Point>>{
+          ArborX::nearest(ArborX::Point{4.2f, 0.f, 0.f}, 3),
+          ArborX::nearest(ArborX::Point{6.9f, 0.f, 0.f}, 2),
+      },
+      "Test::queries");
+
+  Kokkos::View<int *, MemorySpace> indices("Test::indices", 0);
+  Kokkos::View<int *, MemorySpace> offsets("Test::offsets", 0);
+  forest.query(exec_space, queries, indices, offsets);
+
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  auto offsets_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets);
+  BOOST_TEST(offsets_host.size() == 3);
+  BOOST_TEST(offsets_host(1) == 3);
+  BOOST_TEST(offsets_host(2) == 5);
+  // Results come out in ascending distance order
+  BOOST_TEST(indices_host(0) == 4);
+  BOOST_TEST(indices_host(1) == 5);
+  BOOST_TEST(indices_host(2) == 3);
+  BOOST_TEST(indices_host(3) == 7);
+  BOOST_TEST(indices_host(4) == 6);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,126 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_AttachIndices.hpp>
+#include <ArborX_BoundingSphere.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_PredicateHelpers.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BoundingSphere)
+
+BOOST_AUTO_TEST_CASE(bounding_sphere_expansion)
+{
+  using ArborX::Details::distance;
+  using ArborX::Details::expand;
+  using ArborX::Details::intersects;
+  using ArborX::Experimental::BoundingSphere;
+  using Box = ArborX::ExperimentalHyperGeometry::Box<3, float>;
+  using Point = ArborX::ExperimentalHyperGeometry::Point<3, float>;
+
+  // A default-constructed sphere is empty and adopts the first geometry
+  BoundingSphere<3> sphere;
+  BOOST_TEST(sphere.radius() < 0);
+  BOOST_TEST(!intersects(Point{0, 0, 0}, sphere));
+
+  expand(sphere, Point{1, 0, 0});
+  BOOST_TEST(sphere.radius() == 0.f);
+  BOOST_TEST(intersects(Point{1, 0, 0}, sphere));
+  BOOST_TEST(!intersects(Point{0, 0, 0}, sphere));
+
+  // Growing with a point keeps the far pole in place
+  expand(sphere, Point{3, 0, 0});
+  BOOST_TEST(sphere.centroid()[0] == 2.f);
+  BOOST_TEST(sphere.radius() == 1.f);
+
+  // The union with another sphere covers both
+  expand(sphere, BoundingSphere<3>{{2, 4, 0}, 1});
+  float const eps = 1e-5f;
+  BOOST_TEST(distance(Point{1, 0, 0}, sphere) <= eps);
+  BOOST_TEST(distance(Point{3, 0, 0}, sphere) <= eps);
+  BOOST_TEST(distance(Point{2, 5, 0}, sphere) <= eps);
+
+  // A sphere contained in the current one changes nothing
+  auto const before = sphere;
+  expand(sphere, BoundingSphere<3>{sphere.centroid(), sphere.radius() / 2});
+  BOOST_TEST(sphere.radius() == before.radius());
+
+  // Expanding an empty sphere with a box covers the box corners
+  BoundingSphere<3> box_sphere;
+  expand(box_sphere, Box{{0, 0, 0}, {2, 2, 2}});
+  BOOST_TEST(distance(Point{0, 0, 0}, box_sphere) <= eps);
+  BOOST_TEST(distance(Point{2, 2, 2}, box_sphere) <= eps);
+
+  BOOST_TEST(intersects(sphere, box_sphere));
+  BOOST_TEST(
+      !intersects(BoundingSphere<3>{{10, 0, 0}, 1}, box_sphere));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(bounding_sphere_bvh, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  ExecutionSpace space;
+
+  int const n = 100;
+  Kokkos::View<ArborX::Point *, MemorySpace> points(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Testing::points"),
+      n);
+  Kokkos::parallel_for(
+      "Testing::fill_points", Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        points(i) = {(float)(i % 10), (float)(i / 10), 0};
+      });
+
+  ArborX::BoundingVolumeHierarchy<
+      MemorySpace, ArborX::PairValueIndex<ArborX::Point>,
+      ArborX::Details::DefaultIndexableGetter,
+      ArborX::Experimental::BoundingSphere<3>>
+      bvh(space, ArborX::Experimental::attach_indices(points));
+  BOOST_TEST(bvh.size() == n);
+
+  // Each nearest query returns exactly its own point
+  Kokkos::View<int *, MemorySpace> nearest_errors("Testing::nearest_errors", 1);
+  bvh.query(
+      space,
+      ArborX::Experimental::attach_indices(
+          ArborX::Experimental::make_nearest(points, 1)),
+      KOKKOS_LAMBDA(auto const &predicate, auto const &value) {
+        if ((int)value.index != ArborX::getData(predicate))
+          Kokkos::atomic_increment(&nearest_errors(0));
+      });
+  auto nearest_errors_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, nearest_errors);
+  BOOST_TEST(nearest_errors_host(0) == 0);
+
+  // Same for small spatial queries, despite the looser sphere bounds
+  Kokkos::View<int *, MemorySpace> counts("Testing::counts", n);
+  bvh.query(
+      space,
+      ArborX::Experimental::attach_indices(
+          ArborX::Experimental::make_intersects(points, 0.1)),
+      KOKKOS_LAMBDA(auto const &predicate, auto const &) {
+        Kokkos::atomic_increment(&counts(ArborX::getData(predicate)));
+      });
+  int errors;
+  Kokkos::parallel_reduce(
+      "Testing::check_counts", Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i, int &update) { update += (counts(i) != 1); },
+      errors);
+  BOOST_TEST(errors == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,109 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborXTest_Cloud.hpp"
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_CellList.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_PredicateHelpers.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace Test
+{
+
+// Sorted per-query result sets of a fixed-radius query, for comparing the
+// cell list against the BVH
+template <class Index, class ExecutionSpace, class Points>
+auto queryIndices(ExecutionSpace const &exec_space, Index const &index,
+                  Points const &points, float radius)
+{
+  using MemorySpace = typename Index::memory_space;
+  Kokkos::View<int *, MemorySpace> offsets("Test::offsets", 0);
+  Kokkos::View<typename Index::value_type *, MemorySpace> values(
+      "Test::values", 0);
+  index.query(exec_space,
+              ArborX::Experimental::make_intersects(points, radius), values,
+              offsets);
+
+  auto offsets_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets);
+  auto values_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, values);
+
+  std::vector<int> offsets_v(offsets_host.data(),
+                             offsets_host.data() + offsets_host.size());
+  std::vector<int> indices_v(values_host.size());
+  for (unsigned i = 0; i < values_host.size(); ++i)
+    indices_v[i] = values_host(i).index;
+  for (unsigned i = 0; i + 1 < offsets_v.size(); ++i)
+    std::sort(indices_v.begin() + offsets_v[i],
+              indices_v.begin() + offsets_v[i + 1]);
+  return std::make_pair(offsets_v, indices_v);
+}
+
+} // namespace Test
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(cell_list_vs_bvh, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace exec_space;
+
+  auto points = ArborXTest::make_random_cloud<ArborX::Point>(exec_space, 500);
+  float const radius = 0.1f;
+
+  using Value = ArborX::PairValueIndex<ArborX::Point>;
+
+  ArborX::Experimental::CellList<MemorySpace, Value> cell_list(
+      exec_space, ArborX::Experimental::attach_indices(points), radius);
+  BOOST_TEST(cell_list.size() == points.size());
+
+  ArborX::BoundingVolumeHierarchy<MemorySpace, Value> bvh(
+      exec_space, ArborX::Experimental::attach_indices(points));
+
+  auto [cell_offsets, cell_indices] =
+      Test::queryIndices(exec_space, cell_list, points, radius);
+  auto [bvh_offsets, bvh_indices] =
+      Test::queryIndices(exec_space, bvh, points, radius);
+
+  BOOST_TEST(cell_offsets == bvh_offsets, boost::test_tools::per_element());
+  BOOST_TEST(cell_indices == bvh_indices, boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(cell_list_empty, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace exec_space;
+
+  Kokkos::View<ArborX::Point *, MemorySpace> no_points("Test::no_points", 0);
+
+  ArborX::Experimental::CellList<MemorySpace, ArborX::Point> cell_list(
+      exec_space, no_points, 1.f);
+  BOOST_TEST(cell_list.empty());
+
+  Kokkos::View<int *, MemorySpace> offsets("Test::offsets", 0);
+  Kokkos::View<ArborX::Point *, MemorySpace> values("Test::values", 0);
+  Kokkos::View<decltype(ArborX::intersects(ArborX::Sphere{})) *, MemorySpace>
+      predicates("Test::predicates", 1);
+  cell_list.query(exec_space, predicates, values, offsets);
+
+  auto offsets_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets);
+  BOOST_TEST(offsets_host(1) == 0);
+  BOOST_TEST(values.size() == 0u);
+}
@@ -0,0 +1,116 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#include "ArborXTest_StdVectorToKokkosView.hpp"
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_ClusterPostprocessing.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+using ArborXTest::toView;
+
+namespace
+{
+template <typename View>
+auto toStdVector(View const &view)
+{
+  auto view_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, view);
+  return std::vector<typename View::value_type>(
+      view_host.data(), view_host.data() + view_host.size());
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(ClusterPostprocessing)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(relabel_clusters, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  ExecutionSpace space;
+
+  // Two clusters with representatives 2 and 6, one noise point
+  auto labels = toView<DeviceType, int>({2, 2, 2, 6, -1, 6, 6, 2});
+
+  Kokkos::View<int *, MemorySpace> sizes("Test::sizes", 0);
+  auto num_clusters =
+      ArborX::Experimental::relabelClusters(space, labels, sizes);
+  BOOST_TEST(num_clusters == 2);
+  BOOST_TEST(toStdVector(labels) == (std::vector<int>{0, 0, 0, 1, -1, 1, 1, 0}),
+             boost::test_tools::per_element());
+  BOOST_TEST(toStdVector(sizes) == (std::vector<int>{4, 3}),
+             boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(relabel_clusters_min_size, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  ExecutionSpace space;
+
+  auto labels = toView<DeviceType, int>({2, 2, 2, 6, -1, 6, 6, 2});
+
+  // The size-3 cluster is demoted to noise
+  Kokkos::View<int *, MemorySpace> sizes("Test::sizes", 0);
+  auto num_clusters =
+      ArborX::Experimental::relabelClusters(space, labels, sizes,
+                                            /*cluster_min_size*/ 4);
+  BOOST_TEST(num_clusters == 1);
+  BOOST_TEST(toStdVector(labels) ==
+                 (std::vector<int>{0, 0, 0, -1, -1, -1, -1, 0}),
+             boost::test_tools::per_element());
+  BOOST_TEST(toStdVector(sizes) == (std::vector<int>{4}),
+             boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(relabel_clusters_centroids, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  using ArborX::Point;
+
+  ExecutionSpace space;
+
+  auto labels = toView<DeviceType, int>({2, 2, 2, 6, -1, 6, 6, 2});
+  auto points = toView<DeviceType, Point>({{0, 0, 0},
+                                           {1, 0, 0},
+                                           {2, 0, 0},
+                                           {3, 0, 0},
+                                           {4, 0, 0},
+                                           {5, 0, 0},
+                                           {6, 0, 0},
+                                           {7, 0, 0}});
+
+  Kokkos::View<int *, MemorySpace> sizes("Test::sizes", 0);
+  Kokkos::View<Point *, MemorySpace> centroids("Test::centroids", 0);
+  auto num_clusters = ArborX::Experimental::relabelClusters(
+      space, labels, points, sizes, centroids);
+  BOOST_TEST(num_clusters == 2);
+  BOOST_TEST(toStdVector(sizes) == (std::vector<int>{4, 3}),
+             boost::test_tools::per_element());
+
+  auto centroids_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, centroids);
+  // cluster 0 holds points 0, 1, 2, 7; cluster 1 holds points 3, 5, 6
+  BOOST_TEST(centroids_host(0)[0] == 2.5f, boost::test_tools::tolerance(1e-5f));
+  BOOST_TEST(centroids_host(1)[0] == 14.f / 3,
+             boost::test_tools::tolerance(1e-5f));
+  BOOST_TEST(centroids_host(0)[1] == 0.f);
+  BOOST_TEST(centroids_host(1)[2] == 0.f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
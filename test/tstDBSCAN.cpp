@@ -45,7 +45,7 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(dbscan_verifier, DeviceType, ARBORX_DEVICE_TYPES)
 {
   using ExecutionSpace = typename DeviceType::execution_space;
   using ArborX::Point;
-  using ArborX::Details::verifyDBSCAN;
+  using ArborX::Experimental::verifyDBSCAN;
 
   ExecutionSpace space;
 
@@ -156,12 +156,13 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(dbscan, DeviceType, ARBORX_DEVICE_TYPES)
   using ExecutionSpace = typename DeviceType::execution_space;
   using ArborX::dbscan;
   using ArborX::Point;
-  using ArborX::Details::verifyDBSCAN;
+  using ArborX::Experimental::verifyDBSCAN;
 
   ExecutionSpace space;
 
   for (auto impl : {ArborX::DBSCAN::Implementation::FDBSCAN,
-                    ArborX::DBSCAN::Implementation::FDBSCAN_DenseBox})
+                    ArborX::DBSCAN::Implementation::FDBSCAN_DenseBox,
+                    ArborX::DBSCAN::Implementation::FDBSCAN_Grid})
   {
     ArborX::DBSCAN::Parameters params;
     params.setImplementation(impl);
@@ -260,4 +261,43 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(dbscan, DeviceType, ARBORX_DEVICE_TYPES)
   }
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(dbscan_rho_approximate, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using ArborX::dbscan;
+  using ArborX::Point;
+
+  ExecutionSpace space;
+
+  ArborX::DBSCAN::Parameters params;
+  params.setImplementation(ArborX::DBSCAN::Implementation::RhoApproximate);
+
+  // The approximation may merge points up to a small multiple of eps apart,
+  // so the labels are only pinned down when the clusters are packed well
+  // within eps and separated well beyond it
+  float const eps = 1.f;
+  auto points = toView<DeviceType, Point>({
+      {{0.0f, 0, 0}}, {{0.1f, 0, 0}}, {{0.2f, 0, 0}}, // cluster
+      {{10.0f, 0, 0}}, {{10.1f, 0, 0}}, {{10.2f, 0, 0}}, // another cluster
+      {{20.0f, 0, 0}} // noise
+  });
+
+  for (int core_min_size : {2, 3})
+  {
+    auto labels = dbscan(space, points, eps, core_min_size, params);
+    auto labels_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, labels);
+
+    BOOST_TEST(labels_host(0) >= 0);
+    BOOST_TEST(labels_host(1) == labels_host(0));
+    BOOST_TEST(labels_host(2) == labels_host(0));
+    BOOST_TEST(labels_host(3) >= 0);
+    BOOST_TEST(labels_host(4) == labels_host(3));
+    BOOST_TEST(labels_host(5) == labels_host(3));
+    BOOST_TEST(labels_host(0) != labels_host(3));
+    BOOST_TEST(labels_host(6) == -1);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,65 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#include "ArborXTest_StdVectorToKokkosView.hpp"
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_DBSCANContext.hpp>
+#include <ArborX_DBSCANVerification.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+using ArborXTest::toView;
+
+BOOST_AUTO_TEST_SUITE(DBSCANContext)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(dbscan_context, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  using ArborX::Point;
+  using ArborX::Experimental::verifyDBSCAN;
+
+  ExecutionSpace space;
+
+  // Same point set as the bridging check in the DBSCAN verifier test
+  std::vector<Point> all_points{{-1, 0.5, 0}, {-1, -0.5, 0}, {-1, 0, 0},
+                                {0, 0, 0},    {1, 0, 0},     {1, 0.5, 0},
+                                {1, -0.5, 0}};
+  auto all_points_view = toView<DeviceType, Point>(all_points);
+  auto fewer_points_view = toView<DeviceType, Point>(std::vector<Point>(
+      all_points.begin(), all_points.begin() + 4));
+
+  float const eps = 1.f;
+
+  for (int core_min_size : {2, 4})
+  {
+    ArborX::Experimental::DBSCANContext<MemorySpace, Point> context(
+        eps, core_min_size);
+
+    // First frame allocates the workspace
+    BOOST_TEST(verifyDBSCAN(space, all_points_view, eps, core_min_size,
+                            context.cluster(space, all_points_view)));
+
+    // A same-size frame runs entirely out of the retained workspace
+    BOOST_TEST(verifyDBSCAN(space, all_points_view, eps, core_min_size,
+                            context.cluster(space, all_points_view)));
+
+    // Shrinking and growing frames stay correct
+    BOOST_TEST(verifyDBSCAN(space, fewer_points_view, eps, core_min_size,
+                            context.cluster(space, fewer_points_view)));
+    BOOST_TEST(verifyDBSCAN(space, all_points_view, eps, core_min_size,
+                            context.cluster(space, all_points_view)));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,50 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#include "ArborXTest_StdVectorToKokkosView.hpp"
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_DBSCANSweep.hpp>
+#include <ArborX_DBSCANVerification.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+using ArborXTest::toView;
+
+BOOST_AUTO_TEST_SUITE(DBSCANSweep)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(dbscan_sweep, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  using ArborX::Point;
+  using ArborX::Experimental::verifyDBSCAN;
+
+  ExecutionSpace space;
+
+  auto points = toView<DeviceType, Point>({{-1, 0.5, 0},
+                                           {-1, -0.5, 0},
+                                           {-1, 0, 0},
+                                           {0, 0, 0},
+                                           {1, 0, 0},
+                                           {1, 0.5, 0},
+                                           {1, -0.5, 0}});
+
+  float const eps = 1.f;
+
+  // One graph construction serves every core_min_size value of the sweep
+  ArborX::Experimental::DBSCANSweep<MemorySpace> sweep(space, points, eps);
+  BOOST_TEST(sweep.size() == 7);
+  for (int core_min_size : {2, 3, 4, 5, 8})
+    BOOST_TEST(verifyDBSCAN(space, points, eps, core_min_size,
+                            sweep.labels(space, core_min_size)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -15,6 +15,7 @@
 #include "ArborX_EnableViewComparison.hpp"
 #include <ArborX_Dendrogram.hpp>
 #include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_HDBSCAN.hpp>
 #include <ArborX_DetailsSortUtils.hpp>
 #include <ArborX_DetailsWeightedEdge.hpp>
 #include <ArborX_MinimumSpanningTree.hpp>
@@ -48,6 +49,22 @@ auto buildDendrogram(ExecutionSpace const &exec_space,
   return std::make_pair(parents_host, parent_heights_host);
 }
 
+template <class ExecutionSpace>
+auto extractFlatClusters(ExecutionSpace const &exec_space,
+                         std::vector<WeightedEdge> const &edges_host,
+                         int min_cluster_size)
+{
+  using ArborXTest::toView;
+  auto edges = toView<ExecutionSpace>(edges_host, "Test::edges");
+
+  using MemorySpace = typename ExecutionSpace::memory_space;
+  ArborX::Experimental::Dendrogram<MemorySpace> dendrogram{exec_space, edges};
+
+  auto labels = ArborX::Experimental::extractFlatClusters(
+      exec_space, dendrogram, min_cluster_size);
+  return Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, labels);
+}
+
 } // namespace
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(dendrogram_union_find, DeviceType,
@@ -104,6 +121,61 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(dendrogram_union_find, DeviceType,
   }
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(dendrogram_flat_clusters, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using ArborX::Details::WeightedEdge;
+
+  ExecutionSpace space;
+
+  // Labels hold the index of the root edge of the selected cluster (in the
+  // sorted edge order), which is deterministic as long as the weights are
+  // unique.
+
+  {
+    // A single merge is the root split, which is never selected, so both
+    // points come out as noise
+    auto labels = extractFlatClusters(
+        space, std::vector<WeightedEdge>{{0, 1, 2.f}}, 2);
+    BOOST_TEST(labels == (std::vector<int>{-1, -1}), tt::per_element());
+  }
+
+  {
+    // Two tight triplets connected by a long bridge. The bridge split is the
+    // only real split, and produces the two triplet clusters (root edges 2
+    // and 3 in sorted order).
+    std::vector<WeightedEdge> edges{
+        {0, 1, 1.f}, {1, 2, 1.2f}, {3, 4, 1.1f}, {4, 5, 1.3f}, {2, 3, 10.f}};
+    auto labels = extractFlatClusters(space, edges, 3);
+    BOOST_TEST(labels == (std::vector<int>{2, 2, 2, 3, 3, 3}),
+               tt::per_element());
+
+    // With min_cluster_size = 2 the pairs {0,1} and {3,4} condense into the
+    // triplet clusters instead of splitting them, so the selection does not
+    // change
+    labels = extractFlatClusters(space, edges, 2);
+    BOOST_TEST(labels == (std::vector<int>{2, 2, 2, 3, 3, 3}),
+               tt::per_element());
+  }
+
+  {
+    // Same two triplets with a far away straggler. Splitting off a single
+    // point is not a real split, so the straggler is noise and the triplet
+    // clusters are unaffected.
+    auto labels = extractFlatClusters(space,
+                                      std::vector<WeightedEdge>{{0, 1, 1.f},
+                                                                {1, 2, 1.2f},
+                                                                {3, 4, 1.1f},
+                                                                {4, 5, 1.3f},
+                                                                {2, 3, 10.f},
+                                                                {5, 6, 20.f}},
+                                      3);
+    BOOST_TEST(labels == (std::vector<int>{2, 2, 2, 3, 3, 3, -1}),
+               tt::per_element());
+  }
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(dendrogram_boruvka, DeviceType,
                               ARBORX_DEVICE_TYPES)
 {
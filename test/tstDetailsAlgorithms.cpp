@@ -130,6 +130,15 @@ BOOST_AUTO_TEST_CASE(distance_point_triangle)
   BOOST_TEST(distance(Point3{-1, 0, 1}, triangle3_2) == 1);
   BOOST_TEST(distance(Point3{0, -1, -1}, triangle3_2) == std::sqrt(2.f));
   BOOST_TEST(distance(Point3{1, -1, -1}, triangle3_2) == std::sqrt(3.f));
+
+  // precomputed triangle matches the plain one
+  auto const precomputed3 =
+      ArborX::ExperimentalHyperGeometry::makePrecomputed(triangle3);
+  BOOST_TEST(distance(Point3{2, 0, 0}, precomputed3) == 1);
+  BOOST_TEST(distance(Point3{0, 0, 1}, precomputed3) == 1);
+  BOOST_TEST(distance(Point3{0.25f, 0.25f, 2.f}, precomputed3) == 2);
+  BOOST_TEST(distance(Point3{-1, 0, 1}, precomputed3) == std::sqrt(2.f));
+  BOOST_TEST(distance(Point3{2, -1, -1}, precomputed3) == std::sqrt(3.f));
 }
 
 BOOST_AUTO_TEST_CASE(distance_box_box)
@@ -258,6 +267,15 @@ BOOST_AUTO_TEST_CASE(intersects)
   BOOST_TEST(!intersects(Point2{{1.1, 0}}, triangle));
   BOOST_TEST(!intersects(Point2{{-0.1, 0}}, triangle));
 
+  // precomputed triangle matches the plain one
+  auto const precomputed_triangle =
+      ArborX::ExperimentalHyperGeometry::makePrecomputed(triangle);
+  BOOST_TEST(intersects(Point2{{0, 0}}, precomputed_triangle));
+  BOOST_TEST(intersects(Point2{{0.5, 1}}, precomputed_triangle));
+  BOOST_TEST(intersects(Point2{{0.25, 0.5}}, precomputed_triangle));
+  BOOST_TEST(!intersects(Point2{{1, 1}}, precomputed_triangle));
+  BOOST_TEST(!intersects(Point2{{-0.1, 0}}, precomputed_triangle));
+
   // triangle box
   constexpr ArborX::ExperimentalHyperGeometry::Triangle<3> triangle3{
       {{1, 0, 0}}, {{0, 1, 0}}, {{0, 0, 1}}};
@@ -291,6 +309,15 @@ BOOST_AUTO_TEST_CASE(intersects)
   BOOST_TEST(!intersects(Point{0, 0, 1.1}, tet));
   BOOST_TEST(!intersects(Point{0.5, 0.5, 0.5}, tet));
   BOOST_TEST(!intersects(Point{-0.5, 0.5, 0.5}, tet));
+
+  // precomputed tetrahedron matches the plain one
+  auto const precomputed_tet =
+      ArborX::ExperimentalHyperGeometry::makePrecomputed(tet);
+  BOOST_TEST(intersects(Point{0, 0, 0}, precomputed_tet));
+  BOOST_TEST(intersects(Point{0, 0, 1}, precomputed_tet));
+  BOOST_TEST(intersects(Point{0.2, 0.2, 0.1}, precomputed_tet));
+  BOOST_TEST(!intersects(Point{-0.1, 0, 0}, precomputed_tet));
+  BOOST_TEST(!intersects(Point{0.5, 0.5, 0.5}, precomputed_tet));
 }
 
 BOOST_AUTO_TEST_CASE(equals)
@@ -9,16 +9,26 @@
  * SPDX-License-Identifier: BSD-3-Clause                                    *
  ****************************************************************************/
 
+#include "ArborXTest_StdVectorToKokkosView.hpp"
 #include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
 #include "ArborX_EnableViewComparison.hpp"
+#include <ArborX_AttachIndices.hpp>
+#include <ArborX_CrsGraphWrapper.hpp>
 #include <ArborX_DetailsCrsGraphWrapperImpl.hpp>
 #include <ArborX_DetailsKokkosExtStdAlgorithms.hpp> // exclusive_scan
 #include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_PairValueIndex.hpp>
+#include <ArborX_PredicateHelpers.hpp>
 #include <ArborX_Predicates.hpp>
+#include <ArborX_QueryAggregator.hpp>
 #include <ArborX_TraversalPolicy.hpp>
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <vector>
+
 #define BOOST_TEST_MODULE DetailsCrsGraphWrapperImpl
 
 namespace tt = boost::test_tools;
@@ -97,3 +107,381 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(query_impl, DeviceType, ARBORX_DEVICE_TYPES)
   BOOST_TEST(offset_host == offset_ref, tt::per_element());
   BOOST_TEST(indices_host == indices_ref, tt::per_element());
 }
+
+struct ExtractIndex
+{
+  template <typename Predicate, typename Value, typename Insert>
+  KOKKOS_FUNCTION void operator()(Predicate const &, Value const &value,
+                                  Insert const &insert) const
+  {
+    insert((int)value.index);
+  }
+};
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(query_into_preallocated, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  namespace KokkosExt = ArborX::Details::KokkosExt;
+
+  ExecutionSpace space;
+
+  int const n = 10;
+  std::vector<ArborX::Point> points_host;
+  for (int i = 0; i < n; ++i)
+    points_host.push_back({(float)i, 0.f, 0.f});
+  auto points = ArborXTest::toView<DeviceType>(points_host, "Testing::points");
+
+  ArborX::BVH<MemorySpace> bvh(space, points);
+
+  // A ball of radius 1.5 around point i finds i-1, i, i+1 (when present)
+  auto predicates = ArborX::Experimental::make_intersects(points, 1.5f);
+
+  int const capacity = 4;
+  Kokkos::View<int *, DeviceType> offset("Testing::offset", n + 1);
+  Kokkos::deep_copy(offset, capacity);
+  KokkosExt::exclusive_scan(space, offset, offset, 0);
+  Kokkos::View<int *, DeviceType> values(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "Testing::values"),
+      n * capacity);
+  Kokkos::View<int *, DeviceType> counts("Testing::counts", n);
+
+  bool const overflow = ArborX::Experimental::query_into(
+      bvh, space, predicates, ExtractIndex{}, values, offset, counts);
+  BOOST_TEST(!overflow);
+
+  auto counts_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, counts);
+  auto values_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, values);
+  for (int i = 0; i < n; ++i)
+  {
+    std::vector<int> expected;
+    for (int j = std::max(i - 1, 0); j <= std::min(i + 1, n - 1); ++j)
+      expected.push_back(j);
+    BOOST_TEST(counts_host(i) == (int)expected.size());
+    // Within a query's slice the order of the results is unspecified
+    std::vector<int> found(&values_host(i * capacity),
+                           &values_host(i * capacity) + counts_host(i));
+    std::sort(found.begin(), found.end());
+    BOOST_TEST(found == expected, tt::per_element());
+  }
+
+  // Reusing the same storage with smaller capacities truncates the results
+  // and reports the overflow
+  Kokkos::deep_copy(offset, 1);
+  KokkosExt::exclusive_scan(space, offset, offset, 0);
+  BOOST_TEST(ArborX::Experimental::query_into(
+      bvh, space, predicates, ExtractIndex{}, values, offset, counts));
+
+  Kokkos::deep_copy(counts_host, counts);
+  Kokkos::deep_copy(values_host, values);
+  for (int i = 0; i < n; ++i)
+  {
+    BOOST_TEST(counts_host(i) == 1);
+    auto const v = values_host(i);
+    BOOST_TEST((v >= i - 1 && v <= i + 1));
+  }
+}
+
+struct KeepEven
+{
+  template <typename Predicate, typename Value, typename Insert>
+  KOKKOS_FUNCTION void operator()(Predicate const &, Value const &value,
+                                  Insert const &insert) const
+  {
+    if (value.index % 2 == 0)
+      insert((int)value.index);
+  }
+};
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(query_counts, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  ExecutionSpace space;
+
+  int const n = 10;
+  std::vector<ArborX::Point> points_host;
+  for (int i = 0; i < n; ++i)
+    points_host.push_back({(float)i, 0.f, 0.f});
+  auto points = ArborXTest::toView<DeviceType>(points_host, "Testing::points");
+
+  ArborX::BVH<MemorySpace> bvh(space, points);
+
+  // A ball of radius 1.5 around point i finds i-1, i, i+1 (when present)
+  auto predicates = ArborX::Experimental::make_intersects(points, 1.5f);
+
+  // The count-only offsets must match those of the full query
+  Kokkos::View<int *, DeviceType> values("Testing::values", 0);
+  Kokkos::View<int *, DeviceType> offset_ref("Testing::offset_ref", 0);
+  bvh.query(space, predicates, values, offset_ref);
+
+  Kokkos::View<int *, DeviceType> offset("Testing::offset", 0);
+  ArborX::Experimental::query_counts(bvh, space, predicates, offset);
+
+  auto offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+  auto offset_ref_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset_ref);
+  BOOST_TEST(offset_host == offset_ref_host, tt::per_element());
+
+  // A filtering callback counts only what it would have inserted
+  ArborX::Experimental::query_counts(bvh, space, predicates, KeepEven{},
+                                     offset);
+  Kokkos::deep_copy(offset_host, offset);
+  for (int i = 0; i < n; ++i)
+  {
+    int expected = 0;
+    for (int j = std::max(i - 1, 0); j <= std::min(i + 1, n - 1); ++j)
+      expected += (j % 2 == 0);
+    BOOST_TEST(offset_host(i + 1) - offset_host(i) == expected);
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(query_to_host, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  ExecutionSpace space;
+
+  int const n = 100;
+  std::vector<ArborX::Point> points_host;
+  for (int i = 0; i < n; ++i)
+    points_host.push_back({(float)i, 0.f, 0.f});
+  auto points = ArborXTest::toView<DeviceType>(points_host, "Testing::points");
+
+  ArborX::BVH<MemorySpace> bvh(space, points);
+
+  // A ball of radius 1.5 around point i finds i-1, i, i+1 (when present)
+  auto predicates = ArborX::Experimental::make_intersects(points, 1.5f);
+
+  Kokkos::View<int *, DeviceType> values_ref("Testing::values_ref", 0);
+  Kokkos::View<int *, DeviceType> offset_ref("Testing::offset_ref", 0);
+  bvh.query(space, predicates, values_ref, offset_ref);
+  auto values_ref_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, values_ref);
+  auto offset_ref_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset_ref);
+
+  Kokkos::View<int *, Kokkos::HostSpace> values("Testing::values", 0);
+  Kokkos::View<int *, Kokkos::HostSpace> offset("Testing::offset", 0);
+
+  // Budgets forcing many chunks, one forcing a single chunk, and one smaller
+  // than the largest single-predicate count (which must raise the buffer)
+  for (size_t buffer_capacity : {7ul, 10000ul, 1ul})
+  {
+    ArborX::Experimental::query_to_host(bvh, space, predicates, values, offset,
+                                        buffer_capacity);
+
+    BOOST_TEST(offset == offset_ref_host, tt::per_element());
+    // Within a query's slice the order of the results is unspecified
+    for (int i = 0; i < n; ++i)
+    {
+      std::vector<int> found(&values(offset(i)), &values(0) + offset(i + 1));
+      std::sort(found.begin(), found.end());
+      std::vector<int> expected(&values_ref_host(offset_ref_host(i)),
+                                &values_ref_host(0) + offset_ref_host(i + 1));
+      BOOST_TEST(found == expected, tt::per_element());
+    }
+  }
+
+  // A filtering callback streams only what it inserts
+  ArborX::Experimental::query_to_host(bvh, space, predicates, KeepEven{},
+                                      values, offset, 16);
+  for (int i = 0; i < n; ++i)
+  {
+    std::vector<int> found(&values(offset(i)), &values(0) + offset(i + 1));
+    std::sort(found.begin(), found.end());
+    std::vector<int> expected;
+    for (int j = std::max(i - 1, 0); j <= std::min(i + 1, n - 1); ++j)
+      if (j % 2 == 0)
+        expected.push_back(j);
+    BOOST_TEST(found == expected, tt::per_element());
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(query_aggregator, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  ExecutionSpace space;
+
+  int const n = 10;
+  std::vector<ArborX::Point> points_host;
+  for (int i = 0; i < n; ++i)
+    points_host.push_back({(float)i, 0.f, 0.f});
+  auto points = ArborXTest::toView<DeviceType>(points_host, "Testing::points");
+
+  ArborX::BVH<MemorySpace> bvh(space, points);
+
+  // Two logical callers with small batches: balls of radius 1.5 around
+  // points [0, 4) and [5, 8), each finding i-1, i, i+1 (when present)
+  using Predicate = decltype(ArborX::intersects(ArborX::Sphere{}));
+  Kokkos::View<Predicate *, DeviceType> all_predicates(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "Testing::predicates"),
+      n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        all_predicates(i) = ArborX::intersects(ArborX::Sphere{points(i), 1.5f});
+      });
+  auto predicates_1 = Kokkos::subview(all_predicates, std::make_pair(0, 4));
+  auto predicates_2 = Kokkos::subview(all_predicates, std::make_pair(5, 8));
+
+  auto query_separately = [&](auto const &predicates) {
+    Kokkos::View<int *, DeviceType> values("Testing::values_ref", 0);
+    Kokkos::View<int *, DeviceType> offset("Testing::offset_ref", 0);
+    bvh.query(space, predicates, values, offset);
+    return std::make_pair(values, offset);
+  };
+  auto [values_ref_1, offset_ref_1] = query_separately(predicates_1);
+  auto [values_ref_2, offset_ref_2] = query_separately(predicates_2);
+
+  ArborX::Experimental::QueryAggregator<MemorySpace, Predicate, int> aggregator;
+
+  auto compare_to_reference = [](auto const &values, auto const &offset,
+                                 auto const &values_ref,
+                                 auto const &offset_ref) {
+    auto offset_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+    auto offset_ref_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset_ref);
+    BOOST_TEST(offset_host == offset_ref_host, tt::per_element());
+
+    auto values_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, values);
+    auto values_ref_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, values_ref);
+    BOOST_TEST(values_host.size() == values_ref_host.size());
+    // Within a query's slice the order of the results is unspecified
+    int const n_queries = offset_host.size() - 1;
+    for (int i = 0; i < n_queries; ++i)
+    {
+      std::vector<int> found(&values_host(offset_host(i)),
+                             &values_host(0) + offset_host(i + 1));
+      std::sort(found.begin(), found.end());
+      std::vector<int> expected(&values_ref_host(offset_ref_host(i)),
+                                &values_ref_host(0) + offset_ref_host(i + 1));
+      std::sort(expected.begin(), expected.end());
+      BOOST_TEST(found == expected, tt::per_element());
+    }
+  };
+
+  // The fused query must produce the same per-caller results as the
+  // separate calls
+  auto ticket_1 = aggregator.submit(space, predicates_1);
+  auto ticket_2 = aggregator.submit(space, predicates_2);
+  BOOST_TEST(ticket_1.first == 0);
+  BOOST_TEST(ticket_1.size == 4);
+  BOOST_TEST(ticket_2.first == 4);
+  BOOST_TEST(ticket_2.size == 3);
+
+  aggregator.flush(space, bvh);
+
+  Kokkos::View<int *, DeviceType> values("Testing::values", 0);
+  Kokkos::View<int *, DeviceType> offset("Testing::offset", 0);
+  aggregator.get(space, ticket_1, values, offset);
+  compare_to_reference(values, offset, values_ref_1, offset_ref_1);
+  aggregator.get(space, ticket_2, values, offset);
+  compare_to_reference(values, offset, values_ref_2, offset_ref_2);
+
+  // reset() starts a new round reusing the allocations
+  aggregator.reset();
+  auto ticket_3 = aggregator.submit(space, predicates_2);
+  BOOST_TEST(ticket_3.first == 0);
+  aggregator.flush(space, bvh,
+                   ArborX::Experimental::TraversalPolicy().setPredicateSorting(
+                       false));
+  aggregator.get(space, ticket_3, values, offset);
+  compare_to_reference(values, offset, values_ref_2, offset_ref_2);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(query_mixed, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  ExecutionSpace space;
+
+  int const n = 10;
+  std::vector<ArborX::Point> points_host;
+  for (int i = 0; i < n; ++i)
+    points_host.push_back({(float)i, 0.f, 0.f});
+  auto points = ArborXTest::toView<DeviceType>(points_host, "Testing::points");
+
+  using Value = ArborX::PairValueIndex<ArborX::Point>;
+  ArborX::BoundingVolumeHierarchy<MemorySpace, Value> bvh(
+      space, ArborX::Experimental::attach_indices(points));
+
+  // A ball of radius 1.5 around point i finds i-1, i, i+1 (when present)
+  auto spatial = ArborX::Experimental::make_intersects(points, 1.5f);
+  auto nearest = ArborX::Experimental::make_nearest(points, 1);
+  using OrderedPredicate =
+      decltype(ArborX::Experimental::ordered_intersects(ArborX::Sphere{}));
+  Kokkos::View<OrderedPredicate *, DeviceType> ordered(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "Testing::ordered"), n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        ordered(i) = ArborX::Experimental::ordered_intersects(
+            ArborX::Sphere{points(i), 1.5f});
+      });
+
+  Kokkos::View<Value *, DeviceType> values("Testing::values", 0);
+  Kokkos::View<int *, DeviceType> offset("Testing::offset", 0);
+  ArborX::Experimental::query_mixed(bvh, space, spatial, nearest, ordered,
+                                    values, offset);
+
+  auto offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+  auto values_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, values);
+  BOOST_TEST(offset_host.size() == (std::size_t)3 * n + 1);
+
+  auto expected_neighbors = [&](int i) {
+    std::vector<int> expected;
+    for (int j = std::max(i - 1, 0); j <= std::min(i + 1, n - 1); ++j)
+      expected.push_back(j);
+    return expected;
+  };
+  auto row_indices = [&](int row) {
+    std::vector<int> found;
+    for (int jj = offset_host(row); jj < offset_host(row + 1); ++jj)
+      found.push_back((int)values_host(jj).index);
+    return found;
+  };
+
+  // Spatial segment: within a row the order of the results is unspecified
+  for (int i = 0; i < n; ++i)
+  {
+    auto found = row_indices(i);
+    std::sort(found.begin(), found.end());
+    BOOST_TEST(found == expected_neighbors(i), tt::per_element());
+  }
+  // Nearest segment: the single closest point is the query point itself
+  for (int i = 0; i < n; ++i)
+  {
+    auto const found = row_indices(n + i);
+    BOOST_TEST(found.size() == 1u);
+    BOOST_TEST(found[0] == i);
+  }
+  // Ordered segment: the closest result comes first
+  for (int i = 0; i < n; ++i)
+  {
+    auto found = row_indices(2 * n + i);
+    BOOST_TEST(found.front() == i);
+    std::sort(found.begin(), found.end());
+    BOOST_TEST(found == expected_neighbors(i), tt::per_element());
+  }
+
+  // An empty set only shrinks the combined layout
+  Kokkos::View<OrderedPredicate *, DeviceType> no_ordered("Testing::no_ordered",
+                                                          0);
+  ArborX::Experimental::query_mixed(bvh, space, spatial, nearest, no_ordered,
+                                    values, offset);
+  BOOST_TEST(offset.size() == (std::size_t)2 * n + 1);
+}
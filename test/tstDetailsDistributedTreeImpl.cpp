@@ -16,6 +16,9 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <vector>
+
 #define BOOST_TEST_MODULE DetailsDistributedTree
 
 namespace tt = boost::test_tools;
@@ -48,6 +51,63 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(count_results, DeviceType, ARBORX_DEVICE_TYPES)
   BOOST_TEST(offset_host == offset_ref, tt::per_element());
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(merge_results, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+
+  // Results as they arrive from the remote ranks: grouped by source rank, one
+  // rank reported results for queries {0, 2, 2} and another for {1, 2, 2},
+  // with value 20 reported by both ranks for query 2
+  std::vector<int> ids_ref = {0, 2, 2, 1, 2, 2};
+  std::vector<int> values_ref = {10, 20, 21, 30, 22, 20};
+  int const m = 3;
+  int const nnz = 6;
+
+  auto run = [&](auto deduplicate) {
+    Kokkos::View<int *, DeviceType> ids("Testing::query_ids", nnz);
+    Kokkos::View<int *, DeviceType> values("Testing::values", nnz);
+    auto ids_host = Kokkos::create_mirror_view(ids);
+    auto values_host = Kokkos::create_mirror_view(values);
+    for (int i = 0; i < nnz; ++i)
+    {
+      ids_host(i) = ids_ref[i];
+      values_host(i) = values_ref[i];
+    }
+    Kokkos::deep_copy(ids, ids_host);
+    Kokkos::deep_copy(values, values_host);
+
+    Kokkos::View<int *, DeviceType> offset("Testing::offset", 0);
+    ArborX::Details::DistributedTree::mergeResults<decltype(
+        deduplicate)::value>(ExecutionSpace{}, m, ids, values, offset);
+
+    auto offset_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+    auto merged_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, values);
+    std::vector<std::vector<int>> result(m);
+    for (int q = 0; q < m; ++q)
+    {
+      for (int i = offset_host(q); i < offset_host(q + 1); ++i)
+        result[q].push_back(merged_host(i));
+      // within a query's segment the order is unspecified
+      std::sort(result[q].begin(), result[q].end());
+    }
+    return result;
+  };
+
+  auto merged = run(std::false_type{});
+  BOOST_TEST(merged[0] == (std::vector<int>{10}), tt::per_element());
+  BOOST_TEST(merged[1] == (std::vector<int>{30}), tt::per_element());
+  BOOST_TEST(merged[2] == (std::vector<int>{20, 20, 21, 22}),
+             tt::per_element());
+
+  auto deduplicated = run(std::true_type{});
+  BOOST_TEST(deduplicated[0] == (std::vector<int>{10}), tt::per_element());
+  BOOST_TEST(deduplicated[1] == (std::vector<int>{30}), tt::per_element());
+  BOOST_TEST(deduplicated[2] == (std::vector<int>{20, 21, 22}),
+             tt::per_element());
+}
+
 void checkBufferLayout(std::vector<int> const &ranks,
                        std::vector<int> const &permute_ref,
                        std::vector<int> const &unique_ref,
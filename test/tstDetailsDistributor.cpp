@@ -81,3 +81,30 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(do_posts_and_waits, DeviceType,
   Helper<DeviceType>::checkDoPostsAndWaits(comm, ranks, exports_unmanaged,
                                            imports_ref);
 }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(get_import_source_ranks, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  int comm_size;
+  MPI_Comm_size(comm, &comm_size);
+
+  // Every rank sends one packet to every rank, so the imports are laid out
+  // ordered by source rank
+  Kokkos::View<int *, DeviceType> ranks("Testing::ranks", comm_size);
+  ArborX::Details::KokkosExt::iota(ExecutionSpace{}, ranks, 0);
+
+  ArborX::Details::Distributor<DeviceType> distributor(comm);
+  distributor.createFromSends(ExecutionSpace{}, ranks);
+
+  Kokkos::View<int *, DeviceType> import_ranks("Testing::import_ranks", 0);
+  distributor.getImportSourceRanks(ExecutionSpace{}, import_ranks);
+
+  auto import_ranks_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, import_ranks);
+  BOOST_TEST(import_ranks_host.extent_int(0) == comm_size);
+  for (int i = 0; i < comm_size; ++i)
+    BOOST_TEST(import_ranks_host(i) == i);
+}
@@ -0,0 +1,152 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborXTest_StdVectorToKokkosView.hpp"
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include "ArborX_EnableViewComparison.hpp"
+#include <ArborX_DetailsDualTreeTraversal.hpp>
+#include <ArborX_LinearBVH.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+namespace tt = boost::test_tools;
+
+namespace Test
+{
+std::vector<ArborX::Box> make_boxes(int n, float offset)
+{
+  // Boxes along the x-axis that overlap their immediate neighbors from the
+  // other body when the offset difference is smaller than the half-width sum
+  std::vector<ArborX::Box> boxes;
+  boxes.reserve(n);
+  for (int i = 0; i < n; ++i)
+    boxes.push_back({{i + offset - 0.6f, 0.f, 0.f}, {i + offset + 0.6f, 1.f, 1.f}});
+  return boxes;
+}
+} // namespace Test
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(dual_tree_traversal, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using MemorySpace = typename DeviceType::memory_space;
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace space;
+
+  int const n1 = 17;
+  int const n2 = 23;
+  auto boxes1_v = Test::make_boxes(n1, 0.f);
+  auto boxes2_v = Test::make_boxes(n2, 0.25f);
+  auto boxes1 = ArborXTest::toView<DeviceType>(boxes1_v, "Test::boxes1");
+  auto boxes2 = ArborXTest::toView<DeviceType>(boxes2_v, "Test::boxes2");
+
+  ArborX::BVH<MemorySpace> bvh1(space, boxes1);
+  ArborX::BVH<MemorySpace> bvh2(space, boxes2);
+
+  Kokkos::View<int *, MemorySpace> count("Test::count", n1 * n2);
+
+  using Value = ArborX::PairValueIndex<ArborX::Box>;
+  ArborX::Details::DualTreeTraversal(
+      space, bvh1, bvh2,
+      KOKKOS_LAMBDA(Value const &value1, Value const &value2) {
+        Kokkos::atomic_inc(&count(value1.index * n2 + value2.index));
+      });
+
+  std::vector<int> count_ref(n1 * n2);
+  for (int i = 0; i < n1; ++i)
+    for (int j = 0; j < n2; ++j)
+      count_ref[i * n2 + j] =
+          ArborX::Details::intersects(boxes1_v[i], boxes2_v[j]) ? 1 : 0;
+
+  auto count_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, count);
+  BOOST_TEST(count_host == count_ref, tt::per_element());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(dual_tree_traversal_degenerate, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using MemorySpace = typename DeviceType::memory_space;
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace space;
+
+  auto boxes1_v = Test::make_boxes(1, 0.f);
+  auto boxes2_v = Test::make_boxes(5, 0.25f);
+  auto boxes1 = ArborXTest::toView<DeviceType>(boxes1_v, "Test::boxes1");
+  auto boxes2 = ArborXTest::toView<DeviceType>(boxes2_v, "Test::boxes2");
+
+  ArborX::BVH<MemorySpace> bvh1(space, boxes1);
+  ArborX::BVH<MemorySpace> bvh2(space, boxes2);
+
+  Kokkos::View<int *, MemorySpace> count("Test::count", 5);
+
+  using Value = ArborX::PairValueIndex<ArborX::Box>;
+  ArborX::Details::DualTreeTraversal(
+      space, bvh1, bvh2,
+      KOKKOS_LAMBDA(Value const &, Value const &value2) {
+        Kokkos::atomic_inc(&count(value2.index));
+      });
+
+  // The single box of the first body only reaches the first box of the
+  // second one
+  auto count_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, count);
+  BOOST_TEST(count_host == (std::vector<int>{1, 0, 0, 0, 0}),
+             tt::per_element());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(dual_tree_traversal_tombstones, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using MemorySpace = typename DeviceType::memory_space;
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace space;
+
+  int const n1 = 17;
+  int const n2 = 23;
+  auto boxes1_v = Test::make_boxes(n1, 0.f);
+  auto boxes2_v = Test::make_boxes(n2, 0.25f);
+  auto boxes1 = ArborXTest::toView<DeviceType>(boxes1_v, "Test::boxes1");
+  auto boxes2 = ArborXTest::toView<DeviceType>(boxes2_v, "Test::boxes2");
+
+  ArborX::BVH<MemorySpace> bvh1(space, boxes1);
+  ArborX::BVH<MemorySpace> bvh2(space, boxes2);
+
+  using Value = ArborX::PairValueIndex<ArborX::Box>;
+  bvh1.remove_if(
+      space, KOKKOS_LAMBDA(Value const &value) { return value.index % 2 == 0; });
+  bvh2.remove_if(
+      space,
+      KOKKOS_LAMBDA(Value const &value) { return (int)value.index >= n2 / 2; });
+
+  Kokkos::View<int *, MemorySpace> count("Test::count", n1 * n2);
+  ArborX::Details::DualTreeTraversal(
+      space, bvh1, bvh2,
+      KOKKOS_LAMBDA(Value const &value1, Value const &value2) {
+        Kokkos::atomic_inc(&count(value1.index * n2 + value2.index));
+      });
+
+  // Pairs with a removed value on either side must not be reported
+  std::vector<int> count_ref(n1 * n2);
+  for (int i = 0; i < n1; ++i)
+    for (int j = 0; j < n2; ++j)
+      count_ref[i * n2 + j] =
+          (i % 2 != 0 && j < n2 / 2 &&
+           ArborX::Details::intersects(boxes1_v[i], boxes2_v[j]))
+              ? 1
+              : 0;
+
+  auto count_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, count);
+  BOOST_TEST(count_host == count_ref, tt::per_element());
+}
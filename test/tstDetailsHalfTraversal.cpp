@@ -12,8 +12,11 @@
 #include "ArborXTest_StdVectorToKokkosView.hpp"
 #include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
 #include "ArborX_EnableViewComparison.hpp"
+#include <ArborX_AttachIndices.hpp>
 #include <ArborX_DetailsHalfTraversal.hpp>
+#include <ArborX_HalfTraversal.hpp>
 #include <ArborX_LinearBVH.hpp>
+#include <ArborX_Sphere.hpp>
 
 #include "BoostTest_CUDA_clang_workarounds.hpp"
 #include <boost/test/unit_test.hpp>
@@ -55,6 +58,17 @@ struct PredicateGetter
     return {};
   }
 };
+
+struct RadiusPredicateGetter
+{
+  float _radius;
+
+  template <class Value>
+  KOKKOS_FUNCTION auto operator()(Value const &value) const
+  {
+    return ArborX::intersects(ArborX::Sphere{value.value, _radius});
+  }
+};
 } // namespace Test
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(half_traversal, DeviceType, ARBORX_DEVICE_TYPES)
@@ -102,3 +116,77 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(half_traversal, DeviceType, ARBORX_DEVICE_TYPES)
                               Kokkos::HostSpace{}, count),
              boost::test_tools::per_element());
 }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(half_traversal_pairwise, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using MemorySpace = typename DeviceType::memory_space;
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace exec_space;
+
+  int const n = 32;
+  auto points = Test::make_points(exec_space, n);
+
+  using Value = ArborX::PairValueIndex<ArborX::Point>;
+  ArborX::BoundingVolumeHierarchy<MemorySpace, Value> bvh(
+      exec_space, ArborX::Experimental::attach_indices(points));
+
+  // The points sit on the diagonal with spacing sqrt(3), so with radius 2
+  // every point interacts with its immediate neighbors only
+  Kokkos::View<int *, MemorySpace> num_neighbors("Test::num_neighbors", n);
+  ArborX::Experimental::halfTraversal(
+      exec_space, bvh, Test::RadiusPredicateGetter{2.f},
+      KOKKOS_LAMBDA(Value const &value1, Value const &value2) {
+        Kokkos::atomic_increment(&num_neighbors(value1.index));
+        Kokkos::atomic_increment(&num_neighbors(value2.index));
+      });
+
+  std::vector<int> num_neighbors_ref(n, 2);
+  num_neighbors_ref.front() = 1;
+  num_neighbors_ref.back() = 1;
+
+  BOOST_TEST(num_neighbors_ref == Kokkos::create_mirror_view_and_copy(
+                                      Kokkos::HostSpace{}, num_neighbors),
+             boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(half_traversal_tombstones, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using MemorySpace = typename DeviceType::memory_space;
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace exec_space;
+
+  int const n = 32;
+  auto points = Test::make_points(exec_space, n);
+
+  using Value = ArborX::PairValueIndex<ArborX::Point>;
+  ArborX::BoundingVolumeHierarchy<MemorySpace, Value> bvh(
+      exec_space, ArborX::Experimental::attach_indices(points));
+
+  // Removing a point in the middle of the diagonal must take it out of
+  // every pair, on both sides of the traversal
+  int const removed = n / 2;
+  bvh.remove_if(
+      exec_space,
+      KOKKOS_LAMBDA(Value const &value) { return (int)value.index == removed; });
+
+  Kokkos::View<int *, MemorySpace> num_neighbors("Test::num_neighbors", n);
+  ArborX::Experimental::halfTraversal(
+      exec_space, bvh, Test::RadiusPredicateGetter{2.f},
+      KOKKOS_LAMBDA(Value const &value1, Value const &value2) {
+        Kokkos::atomic_increment(&num_neighbors(value1.index));
+        Kokkos::atomic_increment(&num_neighbors(value2.index));
+      });
+
+  std::vector<int> num_neighbors_ref(n, 2);
+  num_neighbors_ref.front() = 1;
+  num_neighbors_ref.back() = 1;
+  num_neighbors_ref[removed] = 0;
+  --num_neighbors_ref[removed - 1];
+  --num_neighbors_ref[removed + 1];
+
+  BOOST_TEST(num_neighbors_ref == Kokkos::create_mirror_view_and_copy(
+                                      Kokkos::HostSpace{}, num_neighbors),
+             boost::test_tools::per_element());
+}
@@ -0,0 +1,58 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <ArborX_DetailsHilbertCode.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace ArborX::Details;
+
+#include <ArborX_HyperPoint.hpp>
+
+BOOST_AUTO_TEST_SUITE(HilbertCodes)
+
+BOOST_AUTO_TEST_CASE(hilbert_codes)
+{
+  using ArborX::ExperimentalHyperGeometry::Point;
+
+  BOOST_TEST(hilbert32(Point{0.f, 0.f}) == 0x0u);
+  BOOST_TEST(hilbert32(Point{0.25f, 0.25f}) == 0x20000000u);
+  BOOST_TEST(hilbert32(Point{0.25f, 0.75f}) == 0x60000000u);
+  BOOST_TEST(hilbert32(Point{0.75f, 0.75f}) == 0xa0000000u);
+  BOOST_TEST(hilbert32(Point{0.75f, 0.25f}) == 0xcaaaaaaau);
+
+  BOOST_TEST(hilbert64(Point{0.f, 0.f}) == 0x0llu);
+  BOOST_TEST(hilbert64(Point{0.25f, 0.25f}) == 0x800000000000000llu);
+  BOOST_TEST(hilbert64(Point{0.25f, 0.75f}) == 0x1800000000000000llu);
+  BOOST_TEST(hilbert64(Point{0.75f, 0.75f}) == 0x2800000000000000llu);
+  BOOST_TEST(hilbert64(Point{0.75f, 0.25f}) == 0x32aaaaaaaaaaaaaallu);
+
+  BOOST_TEST(hilbert32(Point{0.f, 0.f, 0.f}) == 0x0u);
+  BOOST_TEST(hilbert32(Point{0.9f, 0.9f, 0.9f}) == 0x2da05a05u);
+  BOOST_TEST(hilbert32(Point{0.1f, 0.9f, 0.1f}) == 0x1da05a05u);
+
+  BOOST_TEST(hilbert64(Point{0.9f, 0.9f, 0.9f}) == 0x5b40b40b40b40b40llu);
+  BOOST_TEST(hilbert64(Point{0.1f, 0.9f, 0.1f}) == 0x3b40b40b40b40b40llu);
+}
+
+BOOST_AUTO_TEST_CASE(hilbert_quadrant_contiguity)
+{
+  using ArborX::ExperimentalHyperGeometry::Point;
+
+  // Each quadrant of the unit square occupies a contiguous quarter of the key
+  // space, visited in the U-shape order of the first-order curve
+  BOOST_TEST(hilbert32(Point{0.25f, 0.25f}) >> 30 == 0u);
+  BOOST_TEST(hilbert32(Point{0.25f, 0.75f}) >> 30 == 1u);
+  BOOST_TEST(hilbert32(Point{0.75f, 0.75f}) >> 30 == 2u);
+  BOOST_TEST(hilbert32(Point{0.75f, 0.25f}) >> 30 == 3u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,75 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_DetailsKokkosExtScratchArena.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#define BOOST_TEST_MODULE KokkosExtScratchArena
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(scratch_arena, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  using ArborX::Details::KokkosExt::iota;
+  using ArborX::Details::KokkosExt::lastElement;
+  using ArborX::Details::KokkosExt::ScratchArena;
+
+  ExecutionSpace space;
+
+  // Warm the arena up so that later frames are served from consolidated
+  // storage with predictable placement
+  {
+    ScratchArena<MemorySpace> scratch(space);
+    (void)scratch.allocate<char>(4096);
+  }
+
+  char *frame_data;
+  {
+    ScratchArena<MemorySpace> scratch(space);
+    auto v = scratch.allocate<int>(10);
+    BOOST_TEST(v.size() == 10);
+    frame_data = reinterpret_cast<char *>(v.data());
+
+    // Views from the same frame do not alias
+    auto w = scratch.allocate<float>(100);
+    BOOST_TEST((void *)w.data() != (void *)v.data());
+
+    // The views are usable in kernels
+    iota(space, v);
+    BOOST_TEST(lastElement(space, v) == 9);
+
+    // Nested frames rewind independently
+    char *nested_data;
+    {
+      ScratchArena<MemorySpace> nested(space);
+      nested_data = reinterpret_cast<char *>(nested.allocate<int>(5).data());
+    }
+    {
+      ScratchArena<MemorySpace> nested(space);
+      BOOST_TEST(reinterpret_cast<char *>(nested.allocate<int>(5).data()) ==
+                 nested_data);
+    }
+    BOOST_TEST(lastElement(space, v) == 9);
+  }
+
+  // A later frame reuses the memory of the previous one
+  {
+    ScratchArena<MemorySpace> scratch(space);
+    BOOST_TEST(reinterpret_cast<char *>(scratch.allocate<int>(10).data()) ==
+               frame_data);
+  }
+}
@@ -0,0 +1,81 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborXTest_StdVectorToKokkosView.hpp"
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_DetailsKokkosExtSegmentedSort.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <set>
+#include <vector>
+
+#define BOOST_TEST_MODULE KokkosExtSegmentedSort
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(segmented_sort_by_key, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using ArborX::Details::KokkosExt::segmentedSortByKey;
+  using ArborXTest::toView;
+
+  ExecutionSpace space;
+
+  // Segment lengths straddle the internal short/long threshold, including
+  // empty and single-element segments
+  std::vector<int> offsets_v = {0, 0, 1, 4, 20, 100, 233};
+  int const n = offsets_v.back();
+
+  std::vector<float> keys_v(n);
+  std::vector<int> values_v(n);
+  for (int i = 0; i < n; ++i)
+  {
+    // Deterministic scrambled keys with duplicates
+    keys_v[i] = (i * 73) % 41;
+    values_v[i] = i;
+  }
+
+  auto offsets = toView<ExecutionSpace>(offsets_v, "Test::offsets");
+  auto keys = toView<ExecutionSpace>(keys_v, "Test::keys");
+  auto values = toView<ExecutionSpace>(values_v, "Test::values");
+
+  segmentedSortByKey(space, offsets, keys, values);
+
+  auto keys_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, keys);
+  auto values_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, values);
+
+  int const n_segments = offsets_v.size() - 1;
+  for (int s = 0; s < n_segments; ++s)
+  {
+    std::set<int> seen;
+    for (int j = offsets_v[s]; j < offsets_v[s + 1]; ++j)
+    {
+      // Keys are sorted within the segment
+      if (j > offsets_v[s])
+        BOOST_TEST(keys_host(j - 1) <= keys_host(j));
+      // Values moved along with their keys
+      BOOST_TEST(keys_host(j) == keys_v[values_host(j)]);
+      seen.insert(values_host(j));
+    }
+    // The segment is a permutation of its original entries
+    BOOST_TEST((int)seen.size() == offsets_v[s + 1] - offsets_v[s]);
+    if (!seen.empty())
+    {
+      BOOST_TEST(*seen.begin() >= offsets_v[s]);
+      BOOST_TEST(*seen.rbegin() < offsets_v[s + 1]);
+    }
+  }
+}
@@ -112,6 +112,39 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(exclusive_scan, DeviceType, ARBORX_DEVICE_TYPES)
   BOOST_TEST(w_host == w_ref, tt::per_element());
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(transform_exclusive_scan, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  namespace KokkosExt = ArborX::Details::KokkosExt;
+  using ExecutionSpace = typename DeviceType::execution_space;
+
+  ExecutionSpace space{};
+
+  int const n = 10;
+  Kokkos::View<int *, DeviceType> y("y", n);
+  KokkosExt::transform_exclusive_scan(
+      space, n, KOKKOS_LAMBDA(int i) { return (i < n - 1 ? 1 : 0); }, y, 0);
+  std::vector<int> y_ref(n);
+  std::iota(y_ref.begin(), y_ref.end(), 0);
+  auto y_host = Kokkos::create_mirror_view(y);
+  Kokkos::deep_copy(y_host, y);
+  BOOST_TEST(y_host == y_ref, tt::per_element());
+
+  // with init value
+  Kokkos::View<double[3], DeviceType> v("v");
+  KokkosExt::transform_exclusive_scan(
+      space, 3, KOKKOS_LAMBDA(int i) { return (i < 2 ? 1. : 0.); }, v, 5.);
+  std::vector<double> v_ref = {5., 6., 7.};
+  auto v_host = Kokkos::create_mirror_view(v);
+  Kokkos::deep_copy(v_host, v);
+  BOOST_TEST(v_host == v_ref, tt::per_element());
+
+  Kokkos::View<int *, DeviceType> z("z", n + 1);
+  BOOST_CHECK_THROW(KokkosExt::transform_exclusive_scan(
+                        space, n, KOKKOS_LAMBDA(int) { return 1; }, z, 0),
+                    ArborX::SearchException);
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(reduce, DeviceType, ARBORX_DEVICE_TYPES)
 {
   using ExecutionSpace = typename DeviceType::execution_space;
@@ -39,3 +39,25 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(last_element, DeviceType, ARBORX_DEVICE_TYPES)
   Kokkos::deep_copy(u, 3.14);
   BOOST_TEST(lastElement(execution_space, u) == 3.14);
 }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(first_touch, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ArborX::Details::KokkosExt::firstTouch;
+  using ArborX::Details::KokkosExt::lastElement;
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace execution_space;
+
+  // The placement effect is not observable here; check that the sweep covers
+  // allocations of any size, including a trailing partial page, without
+  // touching out of bounds, and that later writes are preserved
+  for (int n : {0, 1, 1000, 100000})
+  {
+    Kokkos::View<int *, DeviceType> v(
+        Kokkos::view_alloc(execution_space, Kokkos::WithoutInitializing, "v"),
+        n);
+    firstTouch(execution_space, v);
+    Kokkos::deep_copy(execution_space, v, 255);
+    if (n > 0)
+      BOOST_TEST(lastElement(execution_space, v) == 255);
+  }
+}
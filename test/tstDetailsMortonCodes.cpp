@@ -79,6 +79,52 @@ BOOST_AUTO_TEST_CASE(morton_codes)
   BOOST_TEST(morton64(Point{1.f, 1.f, 1.f}) == 0x7fffffffffffffffllu);
   BOOST_TEST(morton64(Point{0.f, 0.f, 1.f}) == 0x1249249249249249llu);
   BOOST_TEST(morton64(Point{1.f, 1.f, 0.f}) == 0x6db6db6db6db6db6llu);
+
+  // Higher dimensions use the balanced interleaving, which fills the whole
+  // code width (a uniform 32 / 6 stride would leave two bits unused)
+  BOOST_TEST(morton32(Point{0.f, 0.f, 0.f, 0.f, 0.f, 0.f}) == 0x0u);
+  BOOST_TEST(morton32(Point{1.f, 1.f, 1.f, 1.f, 1.f, 1.f}) == 0xffffffffu);
+  BOOST_TEST(morton32(Point{1.f, 0.f, 0.f, 0.f, 0.f, 0.f}) == 0xa0820820u);
+  BOOST_TEST(morton32(Point{0.f, 0.f, 0.f, 0.f, 0.f, 1.f}) == 0x1041041u);
+
+  BOOST_TEST(morton64(Point{0.f, 0.f, 0.f, 0.f, 0.f, 0.f}) == 0x0llu);
+  BOOST_TEST(morton64(Point{1.f, 1.f, 1.f, 1.f, 1.f, 1.f}) ==
+             0x7fffffffffffffffllu);
+}
+
+BOOST_AUTO_TEST_CASE(morton_codes_128)
+{
+  using ArborX::ExperimentalHyperGeometry::Point;
+
+  // A single dimension is capped at the 53 significant bits of a double
+  BOOST_TEST((morton128(Point{0.}) == MortonCode128{0, 0x0llu}));
+  BOOST_TEST((morton128(Point{0.5}) == MortonCode128{0, 0x10000000000000llu}));
+  BOOST_TEST((morton128(Point{1.}) == MortonCode128{0, 0x1fffffffffffffllu}));
+
+  BOOST_TEST((morton128(Point{0., 0.}) == MortonCode128{0, 0}));
+  BOOST_TEST((morton128(Point{1., 1.}) ==
+              MortonCode128{0x3ffffffffffllu, 0xffffffffffffffffllu}));
+  BOOST_TEST((morton128(Point{0., 1.}) ==
+              MortonCode128{0x15555555555llu, 0x5555555555555555llu}));
+  BOOST_TEST((morton128(Point{1., 0.}) ==
+              MortonCode128{0x2aaaaaaaaaallu, 0xaaaaaaaaaaaaaaaallu}));
+
+  // 42 bits per dimension fill the full 126-bit width in 3D
+  BOOST_TEST((morton128(Point{0., 0., 0.}) == MortonCode128{0, 0}));
+  BOOST_TEST((morton128(Point{1., 1., 1.}) ==
+              MortonCode128{0x3fffffffffffffffllu, 0xffffffffffffffffllu}));
+  BOOST_TEST((morton128(Point{0., 0., 1.}) ==
+              MortonCode128{0x924924924924924llu, 0x9249249249249249llu}));
+  BOOST_TEST((morton128(Point{1., 1., 0.}) ==
+              MortonCode128{0x36db6db6db6db6dbllu, 0x6db6db6db6db6db6llu}));
+
+  // Points that collapse onto a single 21-bit-per-dimension cell keep
+  // distinct, correctly ordered codes
+  double const x = 0.5;
+  double const y = 0.5 + 1e-9;
+  BOOST_TEST(morton64(Point{x, x, x}) == morton64(Point{y, y, y}));
+  BOOST_TEST((morton128(Point{x, x, x}) != morton128(Point{y, y, y})));
+  BOOST_TEST((morton128(Point{x, x, x}) < morton128(Point{y, y, y})));
 }
 
 BOOST_AUTO_TEST_SUITE_END()
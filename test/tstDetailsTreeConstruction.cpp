@@ -17,10 +17,18 @@
 #include <ArborX_DetailsNode.hpp>       // ROPE SENTINEL
 #include <ArborX_DetailsSortUtils.hpp>  // sortObjects
 #include <ArborX_DetailsTreeConstruction.hpp>
+#include <ArborX_DetailsTreeConstructionFused.hpp>
+#include <ArborX_TreeQuality.hpp>
 #include <ArborX_IndexableGetter.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_Point.hpp>
+#include <ArborX_Sphere.hpp>
+#include <ArborX_TraversalStatistics.hpp>
+#include <ArborX_VersionedBVH.hpp>
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
 #include <array>
 #include <bitset>
 #include <functional>
@@ -269,3 +277,727 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(example_tree_construction, DeviceType,
 
   BOOST_TEST(sol.str() == ref.str());
 }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(example_tree_construction_128, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  if (!Kokkos::SpaceAccessibility<
+          Kokkos::HostSpace, typename DeviceType::memory_space>::accessible)
+    return;
+
+  // The Karras example again, with the codes carried in the
+  // extended-precision 128-bit word and straddling the word boundary. The
+  // hierarchy only depends on the relative distance of adjacent codes, so it
+  // must come out identical to example_tree_construction above.
+  int const n = 8;
+  Kokkos::View<ArborX::Details::MortonCode128 *, DeviceType>
+      sorted_morton_codes("sorted_morton_codes", n);
+  std::vector<std::string> s{
+      "00001", "00010", "00100", "00101", "10011", "11000", "11001", "11110",
+  };
+  for (int i = 0; i < n; ++i)
+  {
+    std::bitset<6> b(s[i]);
+    sorted_morton_codes(i) =
+        ArborX::Details::MortonCode128{b.to_ullong(), 123456789llu};
+  }
+
+  Kokkos::View<Test::FakePrimitive *, DeviceType> primitives(
+      "Testing::primitives", n);
+
+  std::ostringstream ref;
+  // clang-format off
+  ref << "I0" << "I3" << "I1" << "L0" << "L1" << "I2" << "L2" << "L3"
+      << "I4" << "L4" << "I5" << "I6" << "L5" << "L6" << "L7";
+  // clang-format on
+
+  using LeafNode = ArborX::Details::LeafNode<
+      ArborX::PairValueIndex<Test::FakeBoundingVolume>>;
+  using InternalNode = ArborX::Details::InternalNode<Test::FakeBoundingVolume>;
+
+  Kokkos::View<LeafNode *, DeviceType> leaf_nodes("Testing::leaf_nodes", 0);
+  Kokkos::View<InternalNode *, DeviceType> internal_nodes(
+      "Testing::internal_nodes", 0);
+  generateHierarchy(primitives, sorted_morton_codes, leaf_nodes,
+                    internal_nodes);
+
+  std::ostringstream sol;
+  traverse(leaf_nodes, internal_nodes, n, sol);
+
+  BOOST_TEST(sol.str() == ref.str());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(ploc_tree_construction, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  ExecutionSpace space;
+
+  int const n = 64;
+  Kokkos::View<ArborX::PairValueIndex<ArborX::Point> *, MemorySpace> points(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "Testing::points"), n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        points(i) = {ArborX::Point{(float)i, (float)i, (float)i},
+                     (unsigned)i};
+      });
+
+  ArborX::BoundingVolumeHierarchy<MemorySpace,
+                                  ArborX::PairValueIndex<ArborX::Point>>
+      tree(space, points, ArborX::Experimental::PLOC{4});
+
+  BOOST_TEST(tree.size() == n);
+
+  auto const bounds = tree.bounds();
+  decltype(tree.bounds()) expected_bounds{{0, 0, 0},
+                                          {n - 1.f, n - 1.f, n - 1.f}};
+  using ArborX::Details::equals;
+  BOOST_TEST(equals(bounds, expected_bounds));
+
+  // Every sphere encloses exactly one point, so the query results identify
+  // the permutation and exercise both the topology and the ropes
+  Kokkos::View<decltype(ArborX::intersects(ArborX::Sphere{})) *, MemorySpace>
+      queries("Testing::queries", n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        queries(i) = ArborX::intersects(
+            ArborX::Sphere{{(float)i, (float)i, (float)i}, .1f});
+      });
+
+  Kokkos::View<int *, MemorySpace> indices("Testing::indices", 0);
+  Kokkos::View<int *, MemorySpace> offsets("Testing::offsets", 0);
+  tree.query(space, queries, indices, offsets);
+
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  auto offsets_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets);
+  BOOST_TEST(offsets_host.extent_int(0) == n + 1);
+  for (int i = 0; i < n; ++i)
+  {
+    BOOST_TEST(offsets_host(i) == i);
+    BOOST_TEST(indices_host(i) == i);
+  }
+  BOOST_TEST(offsets_host(n) == n);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(fused_small_tree_construction, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  using Value = ArborX::PairValueIndex<ArborX::Point>;
+
+  ExecutionSpace space;
+
+  // Non-power-of-two size so that the bitonic phase pads with sentinels
+  int const n = 100;
+  Kokkos::View<Value *, MemorySpace> points(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "Testing::points"), n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        // Scrambled positions so that the sort phase actually permutes
+        points(i) = {ArborX::Point{(float)((i * 37) % n), (float)(i % 10),
+                                   (float)(i % 7)},
+                     (unsigned)i};
+      });
+
+  Kokkos::View<ArborX::Details::LeafNode<Value> *, MemorySpace> leaf_nodes(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "Testing::leaf_nodes"),
+      n);
+  Kokkos::View<ArborX::Details::InternalNode<ArborX::Box> *, MemorySpace>
+      internal_nodes(Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                                        "Testing::internal_nodes"),
+                     n - 1);
+  Kokkos::View<unsigned int *, MemorySpace> leaf_permutation(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                         "Testing::leaf_permutation"),
+      n);
+
+  ArborX::Box bounds;
+  ArborX::Details::TreeConstruction::buildSmallTreeFused(
+      space, points, ArborX::Details::DefaultIndexableGetter{},
+      ArborX::Experimental::Morton64{}, leaf_permutation, leaf_nodes,
+      internal_nodes, bounds);
+
+  BOOST_TEST(ArborX::Details::equals(bounds, {{0, 0, 0}, {99, 9, 6}}));
+
+  auto points_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, points);
+  auto leaf_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, leaf_nodes);
+  auto internal_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, internal_nodes);
+  auto permutation_host = Kokkos::create_mirror_view_and_copy(
+      Kokkos::HostSpace{}, leaf_permutation);
+
+  // The leaves store the values in the order given by the permutation, and
+  // that order is sorted along the space-filling curve
+  ArborX::Experimental::Morton64 curve;
+  unsigned long long previous_code = 0;
+  for (int i = 0; i < n; ++i)
+  {
+    BOOST_TEST(leaf_host(i).value.index == permutation_host(i));
+    auto const code =
+        curve(bounds, points_host(permutation_host(i)).value);
+    BOOST_TEST(code >= previous_code);
+    previous_code = code;
+  }
+
+  // Following the ropes from the root reaches every leaf exactly once
+  std::vector<char> seen(n, 0);
+  int node = n; // root
+  int num_visited = 0;
+  while (true)
+  {
+    if (node < n)
+    {
+      BOOST_TEST(!seen[node]);
+      seen[node] = 1;
+      ++num_visited;
+      node = leaf_host(node).rope;
+      if (node == ArborX::Details::ROPE_SENTINEL)
+        break;
+    }
+    else
+      node = internal_host(node - n).left_child;
+  }
+  BOOST_TEST(num_visited == n);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(treelet_restructuring, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  ExecutionSpace space;
+
+  int const n = 100;
+  Kokkos::View<ArborX::PairValueIndex<ArborX::Point> *, MemorySpace> points(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "Testing::points"), n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        // Scrambled positions so that the restructuring actually moves
+        // subtrees around
+        float const x = (float)((i * 37) % n);
+        points(i) = {ArborX::Point{x, (float)(i % 10), (float)(i % 7)},
+                     (unsigned)i};
+      });
+
+  ArborX::BoundingVolumeHierarchy<MemorySpace,
+                                  ArborX::PairValueIndex<ArborX::Point>>
+      tree(space, points);
+  auto const bounds_before = tree.bounds();
+
+  tree.optimize(space);
+
+  // The restructuring permutes the topology but not the values: the root
+  // bounds are unchanged and every query still finds exactly its own point
+  using ArborX::Details::equals;
+  BOOST_TEST(equals(tree.bounds(), bounds_before));
+
+  Kokkos::View<decltype(ArborX::intersects(ArborX::Sphere{})) *, MemorySpace>
+      queries("Testing::queries", n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        float const x = (float)((i * 37) % n);
+        queries(i) = ArborX::intersects(
+            ArborX::Sphere{{x, (float)(i % 10), (float)(i % 7)}, .1f});
+      });
+
+  Kokkos::View<int *, MemorySpace> indices("Testing::indices", 0);
+  Kokkos::View<int *, MemorySpace> offsets("Testing::offsets", 0);
+  tree.query(space, queries, indices, offsets);
+
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  auto offsets_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets);
+  BOOST_TEST(offsets_host.extent_int(0) == n + 1);
+  for (int i = 0; i < n; ++i)
+  {
+    BOOST_TEST(offsets_host(i) == i);
+    BOOST_TEST(indices_host(i) == i);
+  }
+  BOOST_TEST(offsets_host(n) == n);
+}
+
+template <typename MemorySpace>
+struct PointAtIndex
+{
+  Kokkos::View<ArborX::Point *, MemorySpace> _points;
+
+  KOKKOS_FUNCTION ArborX::Point const &operator()(int i) const
+  {
+    return _points(i);
+  }
+};
+
+template <typename ExecutionSpace, typename Tree, typename Points>
+void checkEveryPointFindsItself(ExecutionSpace const &space, Tree const &tree,
+                                Points const &points)
+{
+  using MemorySpace = typename Points::memory_space;
+
+  int const n = points.extent_int(0);
+  Kokkos::View<decltype(ArborX::intersects(ArborX::Sphere{})) *, MemorySpace>
+      queries(Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                                 "Testing::queries"),
+              n + 1);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        queries(i) = ArborX::intersects(ArborX::Sphere{points(i), .1f});
+        if (i == 0)
+          queries(n) = ArborX::intersects(ArborX::Sphere{points(0), 100.f});
+      });
+
+  Kokkos::View<int *, MemorySpace> indices("Testing::indices", 0);
+  Kokkos::View<int *, MemorySpace> offsets("Testing::offsets", 0);
+  tree.query(space, queries, indices, offsets);
+
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  auto offsets_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets);
+  BOOST_TEST(offsets_host.extent_int(0) == n + 2);
+  for (int i = 0; i < n; ++i)
+  {
+    BOOST_TEST(offsets_host(i) == i);
+    BOOST_TEST(indices_host(i) == i);
+  }
+  BOOST_TEST(offsets_host(n) == n);
+
+  // The all-covering query returns every value exactly once
+  BOOST_TEST(offsets_host(n + 1) - offsets_host(n) == n);
+  std::vector<int> all(indices_host.data() + offsets_host(n),
+                       indices_host.data() + offsets_host(n + 1));
+  std::sort(all.begin(), all.end());
+  for (int i = 0; i < (int)all.size(); ++i)
+    BOOST_TEST(all[i] == i);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(partial_rebuild, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  ExecutionSpace space;
+
+  // 10x10 grid of points referenced through the indexable getter, so that
+  // moving them in place is visible to the tree
+  int const n = 100;
+  Kokkos::View<ArborX::Point *, MemorySpace> points(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "Testing::points"), n);
+  Kokkos::View<int *, MemorySpace> values(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "Testing::values"), n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        points(i) = {(float)(i % 10), (float)(i / 10), 0};
+        values(i) = i;
+      });
+
+  ArborX::BoundingVolumeHierarchy<MemorySpace, int, PointAtIndex<MemorySpace>>
+      tree(space, values, PointAtIndex<MemorySpace>{points});
+
+  // Scramble the lower-left 3x3 block of the grid in place, off the grid
+  // positions so that the moved points change their relative curve order
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        int const x = i % 10;
+        int const y = i / 10;
+        if (x < 3 && y < 3)
+          points(i) = {(float)((x + 1) % 3) + .25f, (float)((y + 2) % 3) + .25f,
+                       0};
+      });
+
+  tree.partialRebuild(space, ArborX::Box{{-1, -1, -1}, {3.5f, 3.5f, 1}});
+  checkEveryPointFindsItself(space, tree, points);
+
+  // Repeat on a tree whose slot layout the restructuring scrambled
+  tree.optimize(space);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        int const x = i % 10;
+        int const y = i / 10;
+        if (x >= 6 && x < 9 && y >= 6 && y < 9)
+          points(i) = {(float)(6 + (x - 5) % 3) + .25f,
+                       (float)(6 + (y - 4) % 3) + .25f, 0};
+      });
+
+  tree.partialRebuild(space, ArborX::Box{{5.5f, 5.5f, -1}, {9.5f, 9.5f, 1}});
+  checkEveryPointFindsItself(space, tree, points);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(rebuild, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  ExecutionSpace space;
+
+  int const n = 100;
+  Kokkos::View<ArborX::Point *, MemorySpace> coords(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "Testing::coords"), n);
+  Kokkos::View<ArborX::PairValueIndex<ArborX::Point> *, MemorySpace> points(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "Testing::points"), n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        coords(i) = {(float)(i % 10), (float)(i / 10), 0};
+        points(i) = {coords(i), (unsigned)i};
+      });
+
+  ArborX::BoundingVolumeHierarchy<MemorySpace,
+                                  ArborX::PairValueIndex<ArborX::Point>>
+      tree(space, points);
+  checkEveryPointFindsItself(space, tree, coords);
+
+  // Same cardinality reuses the node storage; mirror the grid so that the
+  // rebuild cannot get away with the previous curve order
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        coords(i) = {(float)(9 - i % 10), (float)(i / 10), 0};
+        points(i) = {coords(i), (unsigned)i};
+      });
+  tree.rebuild(space, points);
+  BOOST_TEST(tree.size() == n);
+  checkEveryPointFindsItself(space, tree, coords);
+
+  // Changing the cardinality reallocates, both ways
+  auto fewer_points = Kokkos::subview(points, Kokkos::make_pair(0, 60));
+  auto fewer_coords = Kokkos::subview(coords, Kokkos::make_pair(0, 60));
+  tree.rebuild(space, fewer_points);
+  BOOST_TEST(tree.size() == 60);
+  checkEveryPointFindsItself(space, tree, fewer_coords);
+
+  tree.rebuild(space, points);
+  BOOST_TEST(tree.size() == n);
+  checkEveryPointFindsItself(space, tree, coords);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(tree_quality, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  ExecutionSpace space;
+
+  int const n = 256;
+  Kokkos::View<ArborX::PairValueIndex<ArborX::Point> *, MemorySpace> points(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "Testing::points"), n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        points(i) = {ArborX::Point{(float)(i % 16), (float)(i / 16), 0},
+                     (unsigned)i};
+      });
+
+  ArborX::BoundingVolumeHierarchy<MemorySpace,
+                                  ArborX::PairValueIndex<ArborX::Point>>
+      tree(space, points);
+
+  auto const metrics = ArborX::Experimental::computeTreeQuality(space, tree);
+
+  BOOST_TEST(metrics.sah_cost > 0.);
+  BOOST_TEST(metrics.mean_sibling_overlap >= 0.);
+  BOOST_TEST(metrics.max_sibling_overlap >= metrics.mean_sibling_overlap);
+  // A binary tree over n leaves cannot be shallower than log2(n)
+  BOOST_TEST(metrics.max_leaf_depth >= 8);
+  long long num_leaves = 0;
+  for (auto count : metrics.depth_histogram)
+    num_leaves += count;
+  BOOST_TEST(num_leaves == n);
+
+  // Restructuring must not make the tree worse
+  tree.optimize(space);
+  auto const optimized = ArborX::Experimental::computeTreeQuality(space, tree);
+  BOOST_TEST(optimized.sah_cost <= metrics.sah_cost);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(profile_guided_optimize, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  ExecutionSpace space;
+
+  // 16x16 grid of points
+  int const n = 256;
+  Kokkos::View<ArborX::Point *, MemorySpace> coords(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "Testing::coords"), n);
+  Kokkos::View<ArborX::PairValueIndex<ArborX::Point> *, MemorySpace> points(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "Testing::points"), n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        coords(i) = {(float)(i % 16), (float)(i / 16), 0};
+        points(i) = {coords(i), (unsigned)i};
+      });
+
+  ArborX::BoundingVolumeHierarchy<MemorySpace,
+                                  ArborX::PairValueIndex<ArborX::Point>>
+      tree(space, points);
+
+  // Record an epoch concentrated on the left quarter of the grid
+  int const n_queries = 64;
+  Kokkos::View<decltype(ArborX::intersects(ArborX::Sphere{})) *, MemorySpace>
+      queries(Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                                 "Testing::queries"),
+              n_queries);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int i) {
+        queries(i) = ArborX::intersects(
+            ArborX::Sphere{{(float)(i % 4), (float)(i / 4) / 4, 0}, 1.5f});
+      });
+
+  Kokkos::View<long long *, MemorySpace> visits("Testing::visits", 0);
+  ArborX::Experimental::recordNodeVisits(tree, space, queries, visits);
+  auto visits_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, visits);
+  BOOST_TEST(visits_host.extent_int(0) == 2 * n - 1);
+  // Every query walks through the root (internal counters follow the leaves)
+  BOOST_TEST(visits_host(n) == n_queries);
+
+  // A second batch accumulates into the same epoch instead of resetting
+  ArborX::Experimental::recordNodeVisits(tree, space, queries, visits);
+  Kokkos::deep_copy(visits_host, visits);
+  BOOST_TEST(visits_host(n) == 2 * n_queries);
+
+  // The frequency-weighted restructuring must keep the tree consistent
+  tree.optimize(space, visits);
+  checkEveryPointFindsItself(space, tree, coords);
+
+  auto const metrics = ArborX::Experimental::computeTreeQuality(space, tree);
+  BOOST_TEST(metrics.sah_cost > 0.);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(graft, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  ExecutionSpace space;
+
+  auto make_points = [&space](int first, int count) {
+    Kokkos::View<ArborX::PairValueIndex<ArborX::Point> *, MemorySpace> points(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "Testing::points"),
+        count);
+    Kokkos::parallel_for(
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, count),
+        KOKKOS_LAMBDA(int i) {
+          int const id = first + i;
+          points(i) = {ArborX::Point{(float)id, (float)(id % 10),
+                                     (float)(id % 7)},
+                       (unsigned)id};
+        });
+    return points;
+  };
+
+  using Tree =
+      ArborX::BoundingVolumeHierarchy<MemorySpace,
+                                      ArborX::PairValueIndex<ArborX::Point>>;
+
+  int const n1 = 60;
+  int const n2 = 9;
+  Tree tree(space, make_points(0, n1));
+  Tree batch(space, make_points(n1, n2));
+
+  tree.graft(space, batch);
+  // A second batch of one point exercises the single-leaf graft path
+  Tree single(space, make_points(n1 + n2, 1));
+  tree.graft(space, single);
+
+  int const n = n1 + n2 + 1;
+  BOOST_TEST((int)tree.size() == n);
+
+  decltype(tree.bounds()) expected_bounds;
+  using ArborX::Details::expand;
+  expand(expected_bounds, batch.bounds());
+  expand(expected_bounds, single.bounds());
+  for (int i = 0; i < n1; ++i)
+    expand(expected_bounds,
+           ArborX::Point{(float)i, (float)(i % 10), (float)(i % 7)});
+  BOOST_TEST(ArborX::Details::equals(tree.bounds(), expected_bounds));
+
+  // Every original and every grafted point is found by exactly its own query
+  Kokkos::View<decltype(ArborX::intersects(ArborX::Sphere{})) *, MemorySpace>
+      queries("Testing::queries", n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        queries(i) = ArborX::intersects(
+            ArborX::Sphere{{(float)i, (float)(i % 10), (float)(i % 7)}, .1f});
+      });
+
+  Kokkos::View<int *, MemorySpace> indices("Testing::indices", 0);
+  Kokkos::View<int *, MemorySpace> offsets("Testing::offsets", 0);
+  tree.query(space, queries, indices, offsets);
+
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  auto offsets_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets);
+  BOOST_TEST(offsets_host.extent_int(0) == n + 1);
+  for (int i = 0; i < n; ++i)
+  {
+    BOOST_TEST(offsets_host(i) == i);
+    BOOST_TEST(indices_host(i) == i);
+  }
+  BOOST_TEST(offsets_host(n) == n);
+
+  // Grafting into an empty tree adopts the other tree wholesale
+  Tree empty_tree;
+  empty_tree.graft(space, batch);
+  BOOST_TEST(empty_tree.size() == batch.size());
+  BOOST_TEST(ArborX::Details::equals(empty_tree.bounds(), batch.bounds()));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(remove_and_compact, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  using Value = ArborX::PairValueIndex<ArborX::Point>;
+
+  ExecutionSpace space;
+
+  int const n = 100;
+  Kokkos::View<Value *, MemorySpace> points(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "Testing::points"), n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        points(i) = {ArborX::Point{(float)i, 0, 0}, (unsigned)i};
+      });
+
+  ArborX::BoundingVolumeHierarchy<MemorySpace, Value> tree(space, points);
+
+  auto const num_removed = tree.remove_if(
+      space, KOKKOS_LAMBDA(Value const &value) { return value.index % 2 == 1; });
+  BOOST_TEST((int)num_removed == n / 2);
+  BOOST_TEST((int)tree.numRemoved() == n / 2);
+  // Tombstoned values keep their slots until compaction
+  BOOST_TEST((int)tree.size() == n);
+
+  // Removing the same values again is a no-op
+  BOOST_TEST(
+      (int)tree.remove_if(space, KOKKOS_LAMBDA(Value const &value) {
+        return value.index % 2 == 1;
+      }) == 0);
+
+  Kokkos::View<decltype(ArborX::intersects(ArborX::Sphere{})) *, MemorySpace>
+      queries("Testing::queries", n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        queries(i) = ArborX::intersects(ArborX::Sphere{{(float)i, 0, 0}, .1f});
+      });
+  auto run_queries = [&space, &queries](auto const &bvh) {
+    Kokkos::View<int *, MemorySpace> indices("Testing::indices", 0);
+    Kokkos::View<int *, MemorySpace> offsets("Testing::offsets", 0);
+    bvh.query(space, queries, indices, offsets);
+    return std::make_pair(
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices),
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets));
+  };
+
+  // Only the live values are found, both before and after compaction
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    auto const [indices_host, offsets_host] = run_queries(tree);
+    BOOST_TEST(offsets_host(n) == n / 2);
+    for (int i = 0; i < n; ++i)
+    {
+      BOOST_TEST(offsets_host(i + 1) - offsets_host(i) == (i % 2 == 0 ? 1 : 0));
+      if (i % 2 == 0)
+        BOOST_TEST(indices_host(offsets_host(i)) == i);
+    }
+
+    if (pass == 0)
+    {
+      // A nearest query next to a tombstoned value must skip it
+      Kokkos::View<decltype(ArborX::nearest(ArborX::Point{})) *, MemorySpace>
+          nearest_queries("Testing::nearest_queries", 1);
+      Kokkos::parallel_for(
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, 1), KOKKOS_LAMBDA(int) {
+            nearest_queries(0) = ArborX::nearest(ArborX::Point{51.2f, 0, 0}, 1);
+          });
+      Kokkos::View<int *, MemorySpace> indices("Testing::indices", 0);
+      Kokkos::View<int *, MemorySpace> offsets("Testing::offsets", 0);
+      tree.query(space, nearest_queries, indices, offsets);
+      auto indices_host =
+          Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+      BOOST_TEST(indices_host.extent_int(0) == 1);
+      BOOST_TEST(indices_host(0) == 52);
+
+      tree.compact(space);
+      BOOST_TEST((int)tree.size() == n / 2);
+      BOOST_TEST((int)tree.numRemoved() == 0);
+    }
+  }
+
+  // Removing everything leaves an effectively empty tree that compacts to an
+  // actually empty one
+  tree.remove_if(
+      space, KOKKOS_LAMBDA(Value const &) { return true; });
+  auto const [indices_host, offsets_host] = run_queries(tree);
+  BOOST_TEST(offsets_host(n) == 0);
+  tree.compact(space);
+  BOOST_TEST(tree.empty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(versioned_tree, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  using Value = ArborX::PairValueIndex<ArborX::Point>;
+
+  ExecutionSpace space;
+
+  int const n = 100;
+  Kokkos::View<Value *, MemorySpace> points(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "Testing::points"), n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        points(i) = {ArborX::Point{(float)i, 0, 0}, (unsigned)i};
+      });
+
+  ArborX::Experimental::VersionedBVH<MemorySpace, Value> tree(space, points);
+  BOOST_TEST((int)tree.size() == n);
+  BOOST_TEST(tree.epoch() == 0u);
+
+  Kokkos::View<decltype(ArborX::intersects(ArborX::Sphere{})) *, MemorySpace>
+      queries("Testing::queries", 1);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, 1), KOKKOS_LAMBDA(int) {
+        queries(0) = ArborX::intersects(ArborX::Sphere{{0, 0, 0}, 1000.f});
+      });
+  auto count_matches = [&space, &queries](auto const &t) {
+    Kokkos::View<int *, MemorySpace> indices("Testing::indices", 0);
+    Kokkos::View<int *, MemorySpace> offsets("Testing::offsets", 0);
+    t.query(space, queries, indices, offsets);
+    auto offsets_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets);
+    return offsets_host(1);
+  };
+
+  // An in-flight query is modeled by a snapshot held across publishes
+  auto const before = tree.snapshot();
+
+  auto const num_removed = tree.remove_if(
+      space, KOKKOS_LAMBDA(Value const &value) { return value.index % 2 == 1; });
+  BOOST_TEST((int)num_removed == n / 2);
+  BOOST_TEST(tree.epoch() == 1u);
+
+  // The wrapper answers from the new generation, the snapshot from the
+  // generation it captured
+  BOOST_TEST(count_matches(tree) == n / 2);
+  BOOST_TEST(count_matches(before) == n);
+
+  // A publish that replaces the node arrays wholesale leaves the snapshot
+  // just as untouched as the tombstone marking did
+  tree.compact(space);
+  BOOST_TEST(tree.epoch() == 2u);
+  BOOST_TEST((int)tree.size() == n / 2);
+  BOOST_TEST(count_matches(tree) == n / 2);
+  BOOST_TEST(count_matches(before) == n);
+}
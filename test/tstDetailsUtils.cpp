@@ -12,6 +12,8 @@
 #include "ArborXTest_StdVectorToKokkosView.hpp"
 #include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
 #include "ArborX_EnableViewComparison.hpp"
+#include <ArborX_DetailsKokkosExtRadixSort.hpp>
+#include <ArborX_DetailsMortonCode.hpp> // MortonCode128
 #include <ArborX_DetailsSortUtils.hpp>
 #include <ArborX_DetailsUtils.hpp>
 #include <ArborX_Exception.hpp>
@@ -22,6 +24,7 @@
 
 #include <algorithm>
 #include <numeric>
+#include <random>
 #include <vector>
 
 #define BOOST_TEST_MODULE Utils
@@ -58,6 +61,165 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(sort_objects, DeviceType, ARBORX_DEVICE_TYPES)
   }
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(sort_objects_adaptive, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace space{};
+
+  // Exercise all three regimes: already sorted, nearly sorted (repaired in
+  // place), and far from sorted (falls through to the full sort)
+  for (auto const &values :
+       {std::vector<int>{1, 2, 3, 7, 9, 17, 19, 25, 36},
+        std::vector<int>{1, 3, 2, 7, 9, 17, 25, 19, 36},
+        std::vector<int>{36, 25, 19, 17, 9, 7, 3, 2, 1},
+        std::vector<int>{100, 19, 36, 17, 3, 25, 1, 2, 7}})
+  {
+    Kokkos::View<int *, Kokkos::HostSpace> host_view("data", values.size());
+    std::copy(values.begin(), values.end(), host_view.data());
+    auto device_view = Kokkos::create_mirror_view_and_copy(space, host_view);
+    auto device_permutation =
+        ArborX::Details::sortObjectsAdaptive(space, device_view);
+    Kokkos::deep_copy(space, host_view, device_view);
+
+    // Check that values were sorted properly
+    std::vector<int> values_copy = values;
+    std::sort(values_copy.begin(), values_copy.end());
+    auto host_permutation = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace{}, device_permutation);
+    BOOST_TEST(host_view == values_copy, tt::per_element());
+
+    // Check correctness of the permutation
+    for (unsigned int i = 0; i < values.size(); ++i)
+      values_copy[i] = values[host_permutation(i)];
+    BOOST_TEST(host_view == values_copy, tt::per_element());
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(sort_objects_fused, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space{};
+
+  std::vector<int> const keys_ref{36, 19, 25, 17, 3, 7, 1, 2, 9};
+  int const n = keys_ref.size();
+
+  Kokkos::View<int *, Kokkos::HostSpace> host_keys("keys", n);
+  std::copy(keys_ref.begin(), keys_ref.end(), host_keys.data());
+  auto keys = Kokkos::create_mirror_view_and_copy(space, host_keys);
+
+  // The values encode their original position so that the carried values can
+  // be checked against the keys after the sort
+  Kokkos::View<float *, MemorySpace> values(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "values"), n);
+  Kokkos::parallel_for(
+      "Testing::init_values", Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i) { values(i) = 2.f * i; });
+
+  ArborX::Details::sortObjects(space, keys, values);
+
+  Kokkos::deep_copy(space, host_keys, keys);
+  auto host_values =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, values);
+
+  std::vector<int> keys_sorted = keys_ref;
+  std::sort(keys_sorted.begin(), keys_sorted.end());
+  BOOST_TEST(host_keys == keys_sorted, tt::per_element());
+
+  // Each value must still sit next to the key it started with
+  for (int i = 0; i < n; ++i)
+    BOOST_TEST(keys_ref[(int)(host_values(i) / 2.f)] == host_keys(i));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(radix_sort_by_key, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space{};
+
+  int const n = 10007;
+
+  auto check = [&space, n](auto key_init) {
+    using Key = decltype(key_init);
+
+    // Small range guarantees duplicate keys so that stability is exercised;
+    // the upper bytes are uniform and must be skipped correctly
+    std::default_random_engine gen(12345);
+    std::uniform_int_distribution<Key> dist(0, 1023);
+    std::vector<Key> keys_ref(n);
+    for (auto &key : keys_ref)
+      key = dist(gen);
+
+    auto keys = ArborXTest::toView<ExecutionSpace>(keys_ref, "Test::keys");
+    Kokkos::View<unsigned int *, MemorySpace> values(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::values"),
+        n);
+    ArborX::Details::KokkosExt::iota(space, values);
+
+    ArborX::Details::KokkosExt::radixSortByKey(space, keys, values);
+
+    auto keys_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, keys);
+    auto values_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, values);
+
+    for (int i = 0; i < n; ++i)
+    {
+      // Keys are sorted and values carried along
+      BOOST_TEST(keys_host(i) == keys_ref[values_host(i)]);
+      if (i > 0)
+      {
+        BOOST_TEST(keys_host(i - 1) <= keys_host(i));
+        // Equal keys preserve their relative order (stable sort)
+        if (keys_host(i - 1) == keys_host(i))
+          BOOST_TEST(values_host(i - 1) < values_host(i));
+      }
+    }
+  };
+  check((unsigned int)0);
+  check((unsigned long long)0);
+
+  // 128-bit keys exercise the byte extraction through the operator interface
+  // of MortonCode128; small ranges in both words leave duplicate keys and
+  // uniform bytes on each side of the word boundary
+  {
+    using Key = ArborX::Details::MortonCode128;
+
+    std::default_random_engine gen(12345);
+    std::uniform_int_distribution<unsigned long long> dist(0, 31);
+    std::vector<Key> keys_ref(n);
+    for (auto &key : keys_ref)
+      key = Key{dist(gen), dist(gen)};
+
+    auto keys = ArborXTest::toView<ExecutionSpace>(keys_ref, "Test::keys");
+    Kokkos::View<unsigned int *, MemorySpace> values(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::values"),
+        n);
+    ArborX::Details::KokkosExt::iota(space, values);
+
+    ArborX::Details::KokkosExt::radixSortByKey(space, keys, values);
+
+    auto keys_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, keys);
+    auto values_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, values);
+
+    for (int i = 0; i < n; ++i)
+    {
+      BOOST_TEST((keys_host(i) == keys_ref[values_host(i)]));
+      if (i > 0)
+      {
+        BOOST_TEST(!(keys_host(i) < keys_host(i - 1)));
+        if (keys_host(i - 1) == keys_host(i))
+          BOOST_TEST(values_host(i - 1) < values_host(i));
+      }
+    }
+  }
+}
+
 namespace Test
 {
 using ArborXTest::toView;
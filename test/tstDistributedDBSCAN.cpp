@@ -0,0 +1,154 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_DistributedDBSCAN.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <mpi.h>
+
+#define BOOST_TEST_MODULE DistributedDBSCAN
+
+namespace tt = boost::test_tools;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(distributed_dbscan_single_cluster, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+
+  // Each rank owns three consecutive points of a uniformly spaced global
+  // chain:
+  // rank 0:  0---1---2
+  // rank 1:              3---4---5
+  // rank 2:                          6---7---8
+  // With eps > 1 every point is within eps of its chain neighbor, including
+  // the neighbor living on the adjacent rank, so the chain forms a single
+  // global cluster.
+  int const n = 3;
+  Kokkos::View<ArborX::Point *, MemorySpace> points("Testing::points", n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(0, n), KOKKOS_LAMBDA(int i) {
+        points(i) = {{(float)(3 * comm_rank + i), 0.f, 0.f}};
+      });
+
+  auto labels =
+      ArborX::dbscan(comm, ExecutionSpace{}, points, /*eps=*/1.5f,
+                     /*core_min_size=*/2);
+
+  auto labels_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, labels);
+  BOOST_TEST(labels_host.size() == (unsigned)n);
+  // The smallest global id in the cluster, which belongs to rank 0, wins
+  for (int i = 0; i < n; ++i)
+    BOOST_TEST(labels_host(i) == 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(distributed_dbscan_all_noise, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+
+  // Same chain as above, but eps < 1 leaves every point isolated
+  int const n = 3;
+  Kokkos::View<ArborX::Point *, MemorySpace> points("Testing::points", n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(0, n), KOKKOS_LAMBDA(int i) {
+        points(i) = {{(float)(3 * comm_rank + i), 0.f, 0.f}};
+      });
+
+  auto labels =
+      ArborX::dbscan(comm, ExecutionSpace{}, points, /*eps=*/0.9f,
+                     /*core_min_size=*/2);
+
+  auto labels_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, labels);
+  for (int i = 0; i < n; ++i)
+    BOOST_TEST(labels_host(i) == -1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(distributed_dbscan_cluster_per_rank, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+
+  // Each rank owns a tight pair far away from the pairs of the other ranks,
+  // producing one purely local cluster per rank. Checks that global ids are
+  // assigned consistently without any cross-rank merging.
+  int const n = 2;
+  Kokkos::View<ArborX::Point *, MemorySpace> points("Testing::points", n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(0, n), KOKKOS_LAMBDA(int i) {
+        points(i) = {{10.f * comm_rank + 0.1f * i, 0.f, 0.f}};
+      });
+
+  auto labels =
+      ArborX::dbscan(comm, ExecutionSpace{}, points, /*eps=*/0.5f,
+                     /*core_min_size=*/2);
+
+  auto labels_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, labels);
+  // The label of each cluster is the global id of its first point
+  for (int i = 0; i < n; ++i)
+    BOOST_TEST(labels_host(i) == (long long)n * comm_rank);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(distributed_dbscan_border_points, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+
+  // Exercise the general (core_min_size > 2) path on the uniform chain. With
+  // eps = 1.1 and core_min_size = 3 every interior point of the global chain
+  // has three neighbors (including itself) and is core, while the two global
+  // endpoints only have two and are border points. The core status of the
+  // points at the rank interfaces depends on their ghost copies on the
+  // neighboring ranks, and the chain still collapses into a single global
+  // cluster through the cross-rank core-core merges.
+  int const n = 3;
+  Kokkos::View<ArborX::Point *, MemorySpace> points("Testing::points", n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(0, n), KOKKOS_LAMBDA(int i) {
+        points(i) = {{(float)(3 * comm_rank + i), 0.f, 0.f}};
+      });
+
+  auto labels =
+      ArborX::dbscan(comm, ExecutionSpace{}, points, /*eps=*/1.1f,
+                     /*core_min_size=*/3);
+
+  auto labels_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, labels);
+  // A single-rank run has only three points, leaving the middle one core and
+  // the endpoints its border points; either way the cluster label is the
+  // smallest global id in it
+  for (int i = 0; i < n; ++i)
+    BOOST_TEST(labels_host(i) == 0);
+}
@@ -0,0 +1,102 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_DistributedMinimumSpanningTree.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <mpi.h>
+
+#define BOOST_TEST_MODULE DistributedMinimumSpanningTree
+
+namespace tt = boost::test_tools;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(distributed_mst_chain, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+  int comm_size;
+  MPI_Comm_size(comm, &comm_size);
+
+  // Each rank owns three consecutive points of a uniformly spaced global
+  // chain, so every MST edge, including the ones crossing the rank
+  // boundaries, has unit weight
+  int const n = 3;
+  Kokkos::View<ArborX::Point *, MemorySpace> points("Testing::points", n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(0, n), KOKKOS_LAMBDA(int i) {
+        points(i) = {{(float)(3 * comm_rank + i), 0.f, 0.f}};
+      });
+
+  ArborX::Details::DistributedMinimumSpanningTree<MemorySpace> mst(
+      comm, ExecutionSpace{}, points);
+
+  auto edges_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, mst.edges);
+
+  long long const num_global = (long long)n * comm_size;
+  for (unsigned e = 0; e < edges_host.size(); ++e)
+  {
+    auto const &edge = edges_host(e);
+    BOOST_TEST(edge.source >= 0);
+    BOOST_TEST(edge.source < num_global);
+    BOOST_TEST(edge.target >= 0);
+    BOOST_TEST(edge.target < num_global);
+    BOOST_TEST(edge.weight == 1.f);
+  }
+
+  // The slices form a spanning tree of the global chain
+  long long num_edges = edges_host.size();
+  long long total_num_edges;
+  MPI_Allreduce(&num_edges, &total_num_edges, 1, MPI_LONG_LONG, MPI_SUM, comm);
+  BOOST_TEST(total_num_edges == num_global - 1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(distributed_mst_mutual_reachability, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+  int comm_size;
+  MPI_Comm_size(comm, &comm_size);
+
+  // Same chain with k = 2. Every core distance is the unit chain spacing,
+  // so the mutual reachability weights coincide with the Euclidean ones.
+  int const n = 3;
+  Kokkos::View<ArborX::Point *, MemorySpace> points("Testing::points", n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(0, n), KOKKOS_LAMBDA(int i) {
+        points(i) = {{(float)(3 * comm_rank + i), 0.f, 0.f}};
+      });
+
+  ArborX::Details::DistributedMinimumSpanningTree<MemorySpace> mst(
+      comm, ExecutionSpace{}, points, /*k=*/2);
+
+  auto edges_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, mst.edges);
+  for (unsigned e = 0; e < edges_host.size(); ++e)
+    BOOST_TEST(edges_host(e).weight == 1.f);
+
+  long long num_edges = edges_host.size();
+  long long total_num_edges;
+  MPI_Allreduce(&num_edges, &total_num_edges, 1, MPI_LONG_LONG, MPI_SUM, comm);
+  BOOST_TEST(total_num_edges == (long long)n * comm_size - 1);
+}
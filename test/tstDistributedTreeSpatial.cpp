@@ -12,11 +12,18 @@
 #include "ArborXTest_Cloud.hpp"
 #include "ArborX_BoostRTreeHelpers.hpp"
 #include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_AttachIndices.hpp>
+#include <ArborX_BruteForce.hpp>
 #include <ArborX_DistributedTree.hpp>
+#include <ArborX_DistributedTreeSerialization.hpp>
+#include <ArborX_Ray.hpp>
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <cstdio>
 #include <iostream>
+#include <numeric>
 #include <random>
 
 #include "Search_UnitTestHelpers.hpp"
@@ -92,6 +99,524 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(hello_world_spatial, DeviceType,
   }
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(checkpoint_round_trip, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using Tree = ArborX::DistributedTree<typename DeviceType::memory_space>;
+  using ExecutionSpace = typename DeviceType::execution_space;
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+  int comm_size;
+  MPI_Comm_size(comm, &comm_size);
+
+  // Same layout and query as hello_world_spatial, but answered by a tree
+  // that went through a checkpoint/restart cycle
+  int const n = 4;
+  Kokkos::View<ArborX::Point *, DeviceType> points("Testing::points", n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(0, n), KOKKOS_LAMBDA(int i) {
+        points(i) = {{(float)i / n + comm_rank, 0., 0.}};
+      });
+
+  Tree tree(comm, ExecutionSpace{}, points);
+
+  std::string const filename = "ArborX_Test_DistributedTree_checkpoint.bin";
+  ArborX::Experimental::saveDistributedTree(tree, filename);
+  auto const loaded_tree = ArborX::Experimental::loadDistributedTree<Tree>(
+      comm, ExecutionSpace{}, filename);
+  MPI_Barrier(comm);
+  if (comm_rank == 0)
+    std::remove(filename.c_str());
+
+  BOOST_TEST(loaded_tree.size() == tree.size());
+
+  Kokkos::View<decltype(ArborX::intersects(ArborX::Sphere{})) *, DeviceType>
+      queries("Testing::queries", 1);
+  auto queries_host = Kokkos::create_mirror_view(queries);
+  queries_host(0) = ArborX::intersects(
+      ArborX::Sphere{{{0.5f + comm_size - 1 - comm_rank, 0., 0.}}, 0.5});
+  deep_copy(queries, queries_host);
+
+  std::vector<PairIndexRank> values;
+  values.reserve(n + 1);
+  for (int i = 0; i < n; ++i)
+    values.push_back({n - 1 - i, comm_size - 1 - comm_rank});
+
+  if (comm_rank > 0)
+  {
+    values.push_back({0, comm_size - comm_rank});
+    ARBORX_TEST_QUERY_TREE(ExecutionSpace{}, loaded_tree, queries,
+                           make_reference_solution(values, {0, n + 1}));
+  }
+  else
+  {
+    ARBORX_TEST_QUERY_TREE(ExecutionSpace{}, loaded_tree, queries,
+                           make_reference_solution(values, {0, n}));
+  }
+}
+
+namespace Test
+{
+// Convert the index-carrying values of a non-legacy bottom tree into the
+// index/rank pairs the legacy interface returns
+struct PairIndexRankCallback
+{
+  int rank;
+
+  template <typename Predicate, typename Value, typename Output>
+  KOKKOS_FUNCTION void operator()(Predicate const &, Value const &value,
+                                  Output const &out) const
+  {
+    out({(int)value.index, rank});
+  }
+};
+} // namespace Test
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(bottom_tree_brute_force, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  using BottomTree =
+      ArborX::BruteForce<MemorySpace, ArborX::PairValueIndex<ArborX::Point>>;
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+  int comm_size;
+  MPI_Comm_size(comm, &comm_size);
+
+  // Same layout and query as hello_world_spatial, with BruteForce backing
+  // each rank instead of a BVH
+  int const n = 4;
+  Kokkos::View<ArborX::Point *, DeviceType> points("Testing::points", n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(0, n), KOKKOS_LAMBDA(int i) {
+        points(i) = {{(float)i / n + comm_rank, 0., 0.}};
+      });
+
+  ArborX::DistributedTreeBase<BottomTree> tree(
+      comm, ExecutionSpace{}, ArborX::Experimental::attach_indices(points));
+
+  BOOST_TEST(tree.size() == (unsigned)comm_size * n);
+
+  Kokkos::View<decltype(ArborX::intersects(ArborX::Sphere{})) *, DeviceType>
+      queries("Testing::queries", 1);
+  auto queries_host = Kokkos::create_mirror_view(queries);
+  queries_host(0) = ArborX::intersects(
+      ArborX::Sphere{{{0.5f + comm_size - 1 - comm_rank, 0., 0.}}, 0.5});
+  deep_copy(queries, queries_host);
+
+  Kokkos::View<PairIndexRank *, DeviceType> values("Testing::values", 0);
+  Kokkos::View<int *, DeviceType> offset("Testing::offset", 0);
+  tree.query(ExecutionSpace{}, queries, Test::PairIndexRankCallback{comm_rank},
+             values, offset);
+
+  auto values_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, values);
+  auto offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+
+  BOOST_TEST(offset_host.size() == 2);
+
+  // BruteForce reports matches in storage order rather than the BVH leaf
+  // order, so compare the segment as a set
+  std::vector<PairIndexRank> result(values_host.data(),
+                                    values_host.data() + values_host.size());
+  std::sort(result.begin(), result.end());
+
+  std::vector<PairIndexRank> expected;
+  for (int i = 0; i < n; ++i)
+    expected.push_back({i, comm_size - 1 - comm_rank});
+  if (comm_rank > 0)
+    expected.push_back({0, comm_size - comm_rank});
+  std::sort(expected.begin(), expected.end());
+
+  BOOST_TEST(result == expected, tt::per_element());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(query_async, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using Tree = ArborX::DistributedTree<typename DeviceType::memory_space>;
+  using ExecutionSpace = typename DeviceType::execution_space;
+
+  int provided;
+  MPI_Query_thread(&provided);
+  if (provided != MPI_THREAD_MULTIPLE)
+    // The MPI implementation did not grant the thread support queryAsync
+    // requires
+    return;
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+
+  int const n = 4;
+  Kokkos::View<ArborX::Point *, DeviceType> points("Testing::points", n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(0, n), KOKKOS_LAMBDA(int i) {
+        points(i) = {{(float)i / n + comm_rank, 0., 0.}};
+      });
+
+  Tree tree(comm, ExecutionSpace{}, points);
+
+  Kokkos::View<decltype(ArborX::intersects(ArborX::Sphere{})) *, DeviceType>
+      queries("Testing::queries", 1);
+  auto queries_host = Kokkos::create_mirror_view(queries);
+  queries_host(0) =
+      ArborX::intersects(ArborX::Sphere{{{0.5f + comm_rank, 0., 0.}}, 0.5});
+  deep_copy(queries, queries_host);
+
+  Kokkos::View<PairIndexRank *, DeviceType> values_ref("Testing::values_ref",
+                                                       0);
+  Kokkos::View<int *, DeviceType> offset_ref("Testing::offset_ref", 0);
+  tree.query(ExecutionSpace{}, queries, values_ref, offset_ref);
+
+  Kokkos::View<PairIndexRank *, DeviceType> values("Testing::values", 0);
+  Kokkos::View<int *, DeviceType> offset("Testing::offset", 0);
+  auto future = ArborX::Experimental::queryAsync(tree, ExecutionSpace{},
+                                                 queries, values, offset);
+  future.wait();
+  BOOST_TEST(future.ready());
+
+  auto offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+  auto offset_ref_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset_ref);
+  BOOST_TEST(offset_host == offset_ref_host, tt::per_element());
+
+  auto values_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, values);
+  auto values_ref_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, values_ref);
+  BOOST_TEST(values_host == values_ref_host, tt::per_element());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(query_streaming, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using Tree = ArborX::DistributedTree<typename DeviceType::memory_space>;
+  using ExecutionSpace = typename DeviceType::execution_space;
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+
+  ExecutionSpace space;
+
+  int const n = 4;
+  Kokkos::View<ArborX::Point *, DeviceType> points("Testing::points", n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        points(i) = {{(float)i / n + comm_rank, 0., 0.}};
+      });
+
+  Tree tree(comm, space, points);
+
+  // The sphere straddles the boundary with the left neighbor, so on every
+  // rank but the first one segment comes from another rank
+  Kokkos::View<decltype(ArborX::intersects(ArborX::Sphere{})) *, DeviceType>
+      queries("Testing::queries", 1);
+  auto queries_host = Kokkos::create_mirror_view(queries);
+  queries_host(0) =
+      ArborX::intersects(ArborX::Sphere{{{(float)comm_rank, 0., 0.}}, 0.5});
+  deep_copy(queries, queries_host);
+
+  Kokkos::View<PairIndexRank *, DeviceType> values_ref("Testing::values_ref",
+                                                       0);
+  Kokkos::View<int *, DeviceType> offset_ref("Testing::offset_ref", 0);
+  tree.query(space, queries, values_ref, offset_ref);
+
+  std::vector<PairIndexRank> streamed;
+  Kokkos::View<PairIndexRank *, DeviceType> values("Testing::values", 0);
+  Kokkos::View<int *, DeviceType> offset("Testing::offset", 0);
+  tree.queryStreaming(
+      space, queries, values, offset,
+      [&](int source_rank, auto const &segment_ids,
+          auto const &segment_values) {
+        space.fence();
+        auto ids_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{},
+                                                            segment_ids);
+        auto values_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace{}, segment_values);
+        for (unsigned i = 0; i < values_host.size(); ++i)
+        {
+          // There is a single query, and each segment carries the results
+          // that were computed on its source rank
+          BOOST_TEST(ids_host(i) == 0);
+          BOOST_TEST(values_host(i).rank == source_rank);
+          streamed.push_back(values_host(i));
+        }
+      });
+
+  // The merged output matches the regular query
+  auto offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+  auto offset_ref_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset_ref);
+  BOOST_TEST(offset_host == offset_ref_host, tt::per_element());
+
+  auto values_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, values);
+  auto values_ref_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, values_ref);
+  BOOST_TEST(values_host == values_ref_host, tt::per_element());
+
+  // The streamed segments collectively cover the same results, in whatever
+  // order the messages happened to land
+  std::vector<PairIndexRank> expected(values_ref_host.data(),
+                                      values_ref_host.data() +
+                                          values_ref_host.size());
+  std::sort(streamed.begin(), streamed.end());
+  std::sort(expected.begin(), expected.end());
+  BOOST_TEST(streamed == expected, tt::per_element());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(query_plan_caching, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using Tree = ArborX::DistributedTree<typename DeviceType::memory_space>;
+  using ExecutionSpace = typename DeviceType::execution_space;
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+
+  int const n = 4;
+  Kokkos::View<ArborX::Point *, DeviceType> points("Testing::points", n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(0, n), KOKKOS_LAMBDA(int i) {
+        points(i) = {{(float)i / n + comm_rank, 0., 0.}};
+      });
+
+  Tree tree(comm, ExecutionSpace{}, points);
+
+  Kokkos::View<decltype(ArborX::intersects(ArborX::Sphere{})) *, DeviceType>
+      queries("Testing::queries", 1);
+  auto queries_host = Kokkos::create_mirror_view(queries);
+  queries_host(0) =
+      ArborX::intersects(ArborX::Sphere{{{0.5f + comm_rank, 0., 0.}}, 0.5});
+  deep_copy(queries, queries_host);
+
+  Kokkos::View<PairIndexRank *, DeviceType> values_ref("Testing::values_ref",
+                                                       0);
+  Kokkos::View<int *, DeviceType> offset_ref("Testing::offset_ref", 0);
+  tree.query(ExecutionSpace{}, queries, values_ref, offset_ref);
+
+  auto offset_ref_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset_ref);
+  auto values_ref_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, values_ref);
+
+  tree.enablePlanCaching();
+
+  // Repeating the same query must produce identical results. The first
+  // repetition populates the plan cache, the second one reuses the cached
+  // communication plans.
+  for (int repeat = 0; repeat < 2; ++repeat)
+  {
+    Kokkos::View<PairIndexRank *, DeviceType> values("Testing::values", 0);
+    Kokkos::View<int *, DeviceType> offset("Testing::offset", 0);
+    tree.query(ExecutionSpace{}, queries, values, offset);
+
+    auto offset_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+    BOOST_TEST(offset_host == offset_ref_host, tt::per_element());
+
+    auto values_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, values);
+    BOOST_TEST(values_host == values_ref_host, tt::per_element());
+  }
+
+  // Changing the query invalidates the cached plans and must still produce
+  // correct results.
+  queries_host(0) =
+      ArborX::intersects(ArborX::Sphere{{{(float)comm_rank, 0., 0.}}, 0.3});
+  deep_copy(queries, queries_host);
+
+  tree.query(ExecutionSpace{}, queries, values_ref, offset_ref);
+
+  tree.disablePlanCaching();
+  tree.enablePlanCaching();
+  Kokkos::View<PairIndexRank *, DeviceType> values("Testing::values", 0);
+  Kokkos::View<int *, DeviceType> offset("Testing::offset", 0);
+  tree.query(ExecutionSpace{}, queries, values, offset);
+
+  offset_ref_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset_ref);
+  auto offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+  BOOST_TEST(offset_host == offset_ref_host, tt::per_element());
+
+  values_ref_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, values_ref);
+  auto values_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, values);
+  BOOST_TEST(values_host == values_ref_host, tt::per_element());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(query_distributor_telemetry, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using Tree = ArborX::DistributedTree<typename DeviceType::memory_space>;
+  using ExecutionSpace = typename DeviceType::execution_space;
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+  int comm_size;
+  MPI_Comm_size(comm, &comm_size);
+
+  int const n = 4;
+  Kokkos::View<ArborX::Point *, DeviceType> points("Testing::points", n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(0, n), KOKKOS_LAMBDA(int i) {
+        points(i) = {{(float)i / n + comm_rank, 0., 0.}};
+      });
+
+  Tree tree(comm, ExecutionSpace{}, points);
+
+  // A sphere covering every rank so that, with more than one rank, every
+  // rank both sends and receives forwarded predicates and results
+  Kokkos::View<decltype(ArborX::intersects(ArborX::Sphere{})) *, DeviceType>
+      queries("Testing::queries", 1);
+  auto queries_host = Kokkos::create_mirror_view(queries);
+  queries_host(0) =
+      ArborX::intersects(ArborX::Sphere{{{0., 0., 0.}}, (float)comm_size + 1});
+  deep_copy(queries, queries_host);
+
+  Kokkos::View<PairIndexRank *, DeviceType> values_ref("Testing::values_ref",
+                                                       0);
+  Kokkos::View<int *, DeviceType> offset_ref("Testing::offset_ref", 0);
+  tree.query(ExecutionSpace{}, queries, values_ref, offset_ref);
+
+  ArborX::Experimental::DistributorTelemetry telemetry;
+  tree.attachDistributorTelemetry(telemetry);
+
+  // Recording must not change the results
+  Kokkos::View<PairIndexRank *, DeviceType> values("Testing::values", 0);
+  Kokkos::View<int *, DeviceType> offset("Testing::offset", 0);
+  tree.query(ExecutionSpace{}, queries, values, offset);
+
+  auto offset_ref_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset_ref);
+  auto offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+  BOOST_TEST(offset_host == offset_ref_host, tt::per_element());
+  auto values_ref_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, values_ref);
+  auto values_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, values);
+  BOOST_TEST(values_host == values_ref_host, tt::per_element());
+
+  // A spatial query forwards the predicates and communicates the results
+  // back, so it performs several exchanges
+  BOOST_TEST(telemetry.exchanges.size() >= 2u);
+  BOOST_TEST(telemetry.totalWaitTime() >= 0.);
+  if (comm_size > 1)
+  {
+    BOOST_TEST(telemetry.numMessagesSent() > 0);
+    BOOST_TEST(telemetry.numMessagesReceived() > 0);
+    BOOST_TEST(telemetry.totalBytesSent() > 0);
+    BOOST_TEST(telemetry.totalBytesReceived() > 0);
+  }
+  for (auto const &exchange : telemetry.exchanges)
+  {
+    BOOST_TEST(exchange.destinations.size() == exchange.bytes_sent.size());
+    BOOST_TEST(exchange.sources.size() == exchange.bytes_received.size());
+  }
+
+  // Every byte sent is received by somebody
+  long long sent = telemetry.totalBytesSent();
+  long long received = telemetry.totalBytesReceived();
+  long long sent_global;
+  long long received_global;
+  MPI_Allreduce(&sent, &sent_global, 1, MPI_LONG_LONG, MPI_SUM, comm);
+  MPI_Allreduce(&received, &received_global, 1, MPI_LONG_LONG, MPI_SUM, comm);
+  BOOST_TEST(sent_global == received_global);
+
+  // Repeating an identical query overwrites the record instead of
+  // accumulating
+  auto const num_exchanges = telemetry.exchanges.size();
+  tree.query(ExecutionSpace{}, queries, values, offset);
+  BOOST_TEST(telemetry.exchanges.size() == num_exchanges);
+
+  // After detaching, further queries leave the telemetry untouched
+  tree.detachDistributorTelemetry();
+  telemetry.exchanges.clear();
+  tree.query(ExecutionSpace{}, queries, values, offset);
+  BOOST_TEST(telemetry.exchanges.empty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(repartitioning_hints, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using Tree = ArborX::DistributedTree<typename DeviceType::memory_space>;
+  using ExecutionSpace = typename DeviceType::execution_space;
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+  int comm_size;
+  MPI_Comm_size(comm, &comm_size);
+
+  ExecutionSpace space;
+
+  int const n = 4;
+  Kokkos::View<ArborX::Point *, DeviceType> points("Testing::points", n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        points(i) = {{(float)i / n + comm_rank, 0., 0.}};
+      });
+
+  Tree tree(comm, space, points);
+
+  ArborX::Experimental::QueryLoadTelemetry load;
+  tree.attachLoadTelemetry(load);
+
+  // Same layout as in hello_world_spatial: rank k queries the region of rank
+  // comm_size-1-k, touching the first point of the next rank when it exists
+  Kokkos::View<decltype(ArborX::intersects(ArborX::Sphere{})) *, DeviceType>
+      queries("Testing::queries", 1);
+  auto queries_host = Kokkos::create_mirror_view(queries);
+  queries_host(0) = ArborX::intersects(
+      ArborX::Sphere{{{0.5f + comm_size - 1 - comm_rank, 0., 0.}}, 0.5});
+  deep_copy(queries, queries_host);
+
+  Kokkos::View<PairIndexRank *, DeviceType> values("Testing::values", 0);
+  Kokkos::View<int *, DeviceType> offset("Testing::offset", 0);
+  tree.query(space, queries, values, offset);
+
+  auto hints = tree.repartitioningHints(load);
+
+  BOOST_TEST(hints.served_cost.size() == (unsigned)comm_size);
+  BOOST_TEST(hints.primitive_counts.size() == (unsigned)comm_size);
+  BOOST_TEST(hints.weights.size() == (unsigned)comm_size);
+  for (int r = 0; r < comm_size; ++r)
+  {
+    // Rank r serves one predicate producing n results; every rank but the
+    // first additionally serves the boundary predicate of its left
+    // neighbor's querier, producing one more result
+    BOOST_TEST(hints.served_cost[r] == n + 1 + (r > 0 ? 2 : 0));
+    BOOST_TEST(hints.primitive_counts[r] == n);
+    BOOST_TEST(hints.weights[r] > 0.);
+  }
+  BOOST_TEST(hints.imbalance >= 1.);
+
+  // The load accumulates across queries until reset
+  tree.query(space, queries, values, offset);
+  auto accumulated = tree.repartitioningHints(load);
+  BOOST_TEST(accumulated.served_cost[comm_rank] ==
+             2 * hints.served_cost[comm_rank]);
+
+  // After detaching, further queries leave the telemetry untouched
+  tree.detachLoadTelemetry();
+  auto const snapshot = load.results_received;
+  tree.query(space, queries, values, offset);
+  BOOST_TEST(load.results_received == snapshot, tt::per_element());
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(empty_tree_spatial, DeviceType,
                               ARBORX_DEVICE_TYPES)
 {
@@ -525,3 +1050,141 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(boost_comparison, DeviceType, ARBORX_DEVICE_TYPES)
   ARBORX_TEST_QUERY_TREE(ExecutionSpace{}, distributed_tree, within_queries,
                          query(ExecutionSpace{}, rtree, within_queries_host));
 }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(ordered_ray, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  using Value = ArborX::PairValueIndex<ArborX::Point, int>;
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+  int comm_size;
+  MPI_Comm_size(comm, &comm_size);
+
+  // Points regularly spaced on a line, four per rank, tagged with their
+  // global index
+  int const n = 4;
+  Kokkos::View<Value *, DeviceType> values("Testing::values", n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(0, n), KOKKOS_LAMBDA(int i) {
+        values(i) = {ArborX::Point{(float)i / n + comm_rank, 0, 0},
+                     n * comm_rank + i};
+      });
+
+  ArborX::DistributedTree<MemorySpace, Value> tree(comm, ExecutionSpace{},
+                                                   values);
+
+  // Rays along the line starting just before the first local point, with
+  // match limits that resolve within the local rank (2), cross into the next
+  // rank (6), and report every crossing to the end of the line (0)
+  using Ray = ArborX::Experimental::Ray;
+  Kokkos::View<
+      decltype(ArborX::Experimental::ordered_intersects(Ray{})) *, DeviceType>
+      queries("Testing::queries", 3);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(0, 3), KOKKOS_LAMBDA(int q) {
+        int const limits[3] = {2, 6, 0};
+        queries(q) = ArborX::Experimental::ordered_intersects(
+            Ray{{comm_rank - .1f, 0, 0}, {1, 0, 0}}, limits[q]);
+      });
+
+  Kokkos::View<Value *, DeviceType> out("Testing::out", 0);
+  Kokkos::View<int *, DeviceType> offset("Testing::offset", 0);
+  tree.query(ExecutionSpace{}, queries, out, offset);
+
+  auto out_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, out);
+  auto offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+
+  int const limits[3] = {2, 6, 0};
+  int const start = n * comm_rank;
+  int const total = n * comm_size;
+  for (int q = 0; q < 3; ++q)
+  {
+    int const count =
+        (limits[q] > 0 ? std::min(limits[q], total - start) : total - start);
+
+    std::vector<int> expected(count);
+    std::iota(expected.begin(), expected.end(), start);
+
+    // The matches must come out in ray order, so no sorting here
+    std::vector<int> found;
+    for (int i = offset_host(q); i < offset_host(q + 1); ++i)
+      found.push_back(out_host(i).index);
+
+    BOOST_TEST(found == expected, tt::per_element());
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(halo_replication, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  using Value = ArborX::PairValueIndex<ArborX::Point, int>;
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+  int comm_size;
+  MPI_Comm_size(comm, &comm_size);
+
+  // Points regularly spaced on a line, four per rank, tagged with their
+  // global index
+  // [  rank 0       [  rank 1       [  rank 2       ...
+  // x---x---x---x---x---x---x---x---x---x---x---x---
+  // 0   1   2   3   4   5   6   7   8   9   10  11
+  int const n = 4;
+  Kokkos::View<Value *, DeviceType> values("Testing::values", n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(0, n), KOKKOS_LAMBDA(int i) {
+        values(i) = {ArborX::Point{(float)i / n + comm_rank, 0, 0},
+                     n * comm_rank + i};
+      });
+
+  ArborX::DistributedTree<MemorySpace, Value> tree(
+      comm, ExecutionSpace{}, values, ArborX::Experimental::HaloReplication{.3f});
+
+  auto run_and_check = [&](float radius, int reach) {
+    // A sphere of the given radius around every local point matches the
+    // `reach` nearest global indices on each side
+    Kokkos::View<decltype(ArborX::intersects(ArborX::Sphere{})) *, DeviceType>
+        queries("Testing::queries", n);
+    Kokkos::parallel_for(
+        Kokkos::RangePolicy<ExecutionSpace>(0, n), KOKKOS_LAMBDA(int i) {
+          queries(i) = ArborX::intersects(
+              ArborX::Sphere{{{(float)i / n + comm_rank, 0, 0}}, radius});
+        });
+
+    Kokkos::View<Value *, DeviceType> out("Testing::out", 0);
+    Kokkos::View<int *, DeviceType> offset("Testing::offset", 0);
+    tree.query(ExecutionSpace{}, queries, out, offset);
+
+    auto out_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, out);
+    auto offset_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+
+    for (int q = 0; q < n; ++q)
+    {
+      int const global = n * comm_rank + q;
+      std::vector<int> expected;
+      for (int g = std::max(global - reach, 0);
+           g <= std::min(global + reach, n * comm_size - 1); ++g)
+        expected.push_back(g);
+
+      std::vector<int> found;
+      for (int i = offset_host(q); i < offset_host(q + 1); ++i)
+        found.push_back(out_host(i).index);
+      std::sort(found.begin(), found.end());
+
+      BOOST_TEST(found == expected, tt::per_element());
+    }
+  };
+
+  // Within the halo: answered locally from the ghosted neighbor values
+  run_and_check(.26f, 1);
+  // Beyond the halo: falls back to the regular forwarding path
+  run_and_check(.6f, 2);
+}
@@ -0,0 +1,102 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_AttachIndices.hpp>
+#include <ArborX_HalfPrecisionBox.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_PredicateHelpers.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(HalfPrecisionBox)
+
+BOOST_AUTO_TEST_CASE(half_precision_box_conservative_rounding)
+{
+  using ArborX::Details::expand;
+  using ArborX::Details::intersects;
+  using ArborX::Experimental::HalfPrecisionBox;
+  using Box = ArborX::ExperimentalHyperGeometry::Box<3>;
+  using Point = ArborX::ExperimentalHyperGeometry::Point<3>;
+
+  // Corners that are not representable in half precision must be rounded
+  // outward
+  Box box{{0.1f, 0.2f, 0.3f}, {1.1f, 1.2f, 1.3f}};
+  HalfPrecisionBox<3> hbox(box);
+  for (int d = 0; d < 3; ++d)
+  {
+    BOOST_TEST(hbox.minCorner()[d] <= box.minCorner()[d]);
+    BOOST_TEST(hbox.maxCorner()[d] >= box.maxCorner()[d]);
+    // ~2^-11 relative resolution of half precision
+    BOOST_TEST(box.minCorner()[d] - hbox.minCorner()[d] <= 1e-3f);
+    BOOST_TEST(hbox.maxCorner()[d] - box.maxCorner()[d] <= 1e-3f);
+  }
+  BOOST_TEST(intersects(box, hbox));
+
+  // Expansion starting from an empty box stays conservative
+  HalfPrecisionBox<3> expanded;
+  expand(expanded, box);
+  expand(expanded, Point{-0.7f, 0.f, 2.3f});
+  BOOST_TEST(expanded.minCorner()[0] <= -0.7f);
+  BOOST_TEST(expanded.minCorner()[1] <= 0.f);
+  BOOST_TEST(expanded.maxCorner()[2] >= 2.3f);
+  BOOST_TEST(intersects(Point{-0.7f, 0.f, 2.3f}, expanded));
+  BOOST_TEST(intersects(box, expanded));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(half_precision_bvh, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  using Point = ArborX::ExperimentalHyperGeometry::Point<3>;
+
+  ExecutionSpace space;
+
+  int const n = 100;
+  Kokkos::View<Point *, MemorySpace> points(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Testing::points"),
+      n);
+  Kokkos::parallel_for(
+      "Testing::fill_points", Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        points(i) = {(float)i / 10, (float)i / 10, (float)i / 10};
+      });
+
+  // Internal nodes in half precision, leaves in full precision
+  ArborX::BoundingVolumeHierarchy<
+      MemorySpace, ArborX::PairValueIndex<Point>,
+      ArborX::Details::DefaultIndexableGetter,
+      ArborX::Experimental::HalfPrecisionBox<3>>
+      bvh(space, ArborX::Experimental::attach_indices(points));
+  BOOST_TEST(bvh.size() == n);
+
+  Kokkos::View<int *, MemorySpace> counts("Testing::counts", n);
+  bvh.query(
+      space,
+      ArborX::Experimental::attach_indices(
+          ArborX::Experimental::make_intersects(points, 0.05f)),
+      KOKKOS_LAMBDA(auto const &predicate, auto const &) {
+        Kokkos::atomic_increment(&counts(ArborX::getData(predicate)));
+      });
+
+  // Each sphere contains exactly its own point; half-precision boxes may
+  // produce false positives during traversal but never false negatives
+  int errors;
+  Kokkos::parallel_reduce(
+      "Testing::check_counts", Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i, int &update) { update += (counts(i) != 1); },
+      errors);
+  BOOST_TEST(errors == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,92 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_LinearBVH.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(ImplicitIndex)
+
+BOOST_AUTO_TEST_CASE(implicit_index_tree)
+{
+  using ExecutionSpace = Kokkos::DefaultHostExecutionSpace;
+  using MemorySpace = Kokkos::HostSpace;
+
+  ExecutionSpace space;
+
+  int const n = 10;
+  Kokkos::View<ArborX::Point *, MemorySpace> points("Testing::points", n);
+  for (int i = 0; i < n; ++i)
+    points(i) = {{(float)i, 0.f, 0.f}};
+
+  // The leaves store the bare points; queries still produce indexed pairs
+  // with the index recovered from the construction permutation
+  using Tree = ArborX::BoundingVolumeHierarchy<
+      MemorySpace, ArborX::Experimental::ImplicitIndex<ArborX::Point>>;
+  static_assert(std::is_same_v<Tree::value_type,
+                               ArborX::PairValueIndex<ArborX::Point>>);
+
+  Tree bvh(space, points);
+  BOOST_TEST(bvh.size() == (unsigned)n);
+
+  Kokkos::View<decltype(ArborX::intersects(ArborX::Point{})) *, MemorySpace>
+      predicates("Testing::predicates", n);
+  for (int i = 0; i < n; ++i)
+    predicates(i) = ArborX::intersects(ArborX::Point{{(float)i, 0.f, 0.f}});
+
+  Kokkos::View<unsigned *, MemorySpace> indices("Testing::indices", 0);
+  Kokkos::View<int *, MemorySpace> offsets("Testing::offsets", 0);
+  bvh.query(space, predicates, indices, offsets);
+
+  BOOST_TEST(offsets(n) == n);
+  for (int i = 0; i < n; ++i)
+  {
+    BOOST_TEST(offsets(i) == i);
+    BOOST_TEST(indices(i) == (unsigned)i);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(implicit_index_callback)
+{
+  using ExecutionSpace = Kokkos::DefaultHostExecutionSpace;
+  using MemorySpace = Kokkos::HostSpace;
+
+  ExecutionSpace space;
+
+  int const n = 7;
+  Kokkos::View<ArborX::Point *, MemorySpace> points("Testing::points", n);
+  for (int i = 0; i < n; ++i)
+    points(i) = {{2.f * i, 0.f, 0.f}};
+
+  ArborX::BoundingVolumeHierarchy<
+      MemorySpace, ArborX::Experimental::ImplicitIndex<ArborX::Point, int>>
+      bvh(space, points);
+
+  Kokkos::View<decltype(ArborX::intersects(ArborX::Sphere{})) *, MemorySpace>
+      predicates("Testing::predicates", 1);
+  predicates(0) = ArborX::intersects(ArborX::Sphere{{6.f, 0.f, 0.f}, 2.5f});
+
+  // The callback sees the reconstructed pair: both the geometry and the
+  // original index must be consistent
+  Kokkos::View<int *, MemorySpace> matched("Testing::matched", n);
+  bvh.query(space, predicates,
+            [matched](auto const &,
+                      ArborX::PairValueIndex<ArborX::Point, int> const &value) {
+              if (value.value[0] == 2.f * value.index)
+                matched(value.index) = 1;
+            });
+
+  for (int i = 0; i < n; ++i)
+    BOOST_TEST(matched(i) == int(i >= 2 && i <= 4));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,81 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#include "ArborXTest_StdVectorToKokkosView.hpp"
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_DBSCANVerification.hpp>
+#include <ArborX_IncrementalDBSCAN.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+using ArborXTest::toView;
+
+BOOST_AUTO_TEST_SUITE(IncrementalDBSCAN)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(incremental_dbscan, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  using ArborX::Point;
+  using ArborX::Experimental::verifyDBSCAN;
+
+  ExecutionSpace space;
+
+  // Same point set as the bridging check in the DBSCAN verifier test
+  std::vector<Point> all_points{{-1, 0.5, 0}, {-1, -0.5, 0}, {-1, 0, 0},
+                                {0, 0, 0},    {1, 0, 0},     {1, 0.5, 0},
+                                {1, -0.5, 0}};
+  auto all_points_view = toView<DeviceType, Point>(all_points);
+
+  float const eps = 1.f;
+  int const core_min_size = 4;
+
+  {
+    // Inserting everything in a single batch matches regular DBSCAN
+    ArborX::Experimental::IncrementalDBSCAN<MemorySpace, Point> dbscan(
+        eps, core_min_size);
+    dbscan.insert(space, all_points_view);
+    BOOST_TEST(dbscan.size() == all_points.size());
+    BOOST_TEST(verifyDBSCAN(space, all_points_view, eps, core_min_size,
+                            dbscan.labels(space)));
+  }
+
+  {
+    // Incremental insertion must match as well. The second batch promotes
+    // points of the first batch to core status, exercising the re-query of
+    // promoted points.
+    ArborX::Experimental::IncrementalDBSCAN<MemorySpace, Point> dbscan(
+        eps, core_min_size);
+    dbscan.insert(space, toView<DeviceType, Point>(std::vector<Point>(
+                             all_points.begin(), all_points.begin() + 3)));
+    dbscan.insert(space, toView<DeviceType, Point>(std::vector<Point>(
+                             all_points.begin() + 3, all_points.end())));
+    BOOST_TEST(dbscan.size() == all_points.size());
+    BOOST_TEST(verifyDBSCAN(space, all_points_view, eps, core_min_size,
+                            dbscan.labels(space)));
+  }
+
+  {
+    // One point at a time
+    ArborX::Experimental::IncrementalDBSCAN<MemorySpace, Point> dbscan(
+        eps, core_min_size);
+    for (std::size_t i = 0; i < all_points.size(); ++i)
+      dbscan.insert(space, toView<DeviceType, Point>(
+                               std::vector<Point>{all_points[i]}));
+    BOOST_TEST(verifyDBSCAN(space, all_points_view, eps, core_min_size,
+                            dbscan.labels(space)));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
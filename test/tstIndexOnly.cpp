@@ -0,0 +1,66 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_IndexOnly.hpp>
+#include <ArborX_LinearBVH.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(IndexOnly)
+
+BOOST_AUTO_TEST_CASE(index_only_primitives)
+{
+  using ArborX::Details::AccessValues;
+  using ArborX::Experimental::index_only;
+
+  Kokkos::View<ArborX::Point *, Kokkos::HostSpace> p("Testing::p", 10);
+  auto p_indices = index_only(p);
+  AccessValues<decltype(p_indices), ArborX::PrimitivesTag> p_values{p_indices};
+  static_assert(std::is_same_v<decltype(p_values(0)), unsigned>);
+  BOOST_TEST(p_values(0) == 0u);
+  BOOST_TEST(p_values(9) == 9u);
+}
+
+BOOST_AUTO_TEST_CASE(index_only_tree)
+{
+  using ExecutionSpace = Kokkos::DefaultHostExecutionSpace;
+  using MemorySpace = Kokkos::HostSpace;
+
+  ExecutionSpace space;
+
+  int const n = 10;
+  Kokkos::View<ArborX::Point *, MemorySpace> points("Testing::points", n);
+  for (int i = 0; i < n; ++i)
+    points(i) = {{(float)i, 0.f, 0.f}};
+
+  // The leaves store bare 32-bit indices, and the geometry is fetched
+  // through the user's view
+  using IndexableGetter =
+      ArborX::Experimental::IndexedIndexableGetter<decltype(points)>;
+  ArborX::BoundingVolumeHierarchy<MemorySpace, unsigned, IndexableGetter> bvh(
+      space, ArborX::Experimental::index_only(points),
+      IndexableGetter{points});
+  BOOST_TEST(bvh.size() == (unsigned)n);
+
+  Kokkos::View<decltype(ArborX::intersects(ArborX::Point{})) *, MemorySpace>
+      predicates("Testing::predicates", 1);
+  predicates(0) = ArborX::intersects(ArborX::Point{{4.f, 0.f, 0.f}});
+
+  Kokkos::View<unsigned *, MemorySpace> indices("Testing::indices", 0);
+  Kokkos::View<int *, MemorySpace> offsets("Testing::offsets", 0);
+  bvh.query(space, predicates, indices, offsets);
+
+  BOOST_TEST(offsets(1) == 1);
+  BOOST_TEST(indices(0) == 4u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,92 @@
+/****************************************************************************
+ * Copyright (c) 2023 by the ArborX authors                                 *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include "ArborX_EnableViewComparison.hpp"
+#include <ArborX_InterpDistributedMovingLeastSquares.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <mpi.h>
+
+#define BOOST_TEST_MODULE DistributedMovingLeastSquares
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(distributed_moving_least_squares, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space{};
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+  int comm_size;
+  MPI_Comm_size(comm, &comm_size);
+
+  // f(x) = 2x - 1, 2 neighbors, linear. Each rank owns a segment of a line:
+  //
+  //  [    rank r      [    rank r+1
+  // SRC: 0   2   4   6   8  ...
+  // TGT:   1   3   5   7
+  //
+  // The last target of each rank is closer to the first source point of the
+  // next rank than to any other local one, so (except on the last rank) one
+  // of its neighbors is remote and its value is fetched over the wire.
+  using Point = ArborX::ExperimentalHyperGeometry::Point<1, double>;
+  int const n = 4;
+  double const origin = 2. * n * comm_rank;
+  Kokkos::View<Point *, MemorySpace> srcp("Testing::srcp", n);
+  Kokkos::View<Point *, MemorySpace> tgtp("Testing::tgtp", n);
+  Kokkos::View<double *, MemorySpace> srcv("Testing::srcv", n);
+  Kokkos::View<double *, MemorySpace> tgtv("Testing::tgtv", n);
+  Kokkos::View<double *, MemorySpace> eval("Testing::eval", n);
+  Kokkos::parallel_for(
+      "Testing::distributed_moving_least_squares::fill",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int const i) {
+        auto f = [](const Point &p) { return 2 * p[0] - 1; };
+
+        srcp(i) = {{origin + 2. * i}};
+        srcv(i) = f(srcp(i));
+        tgtp(i) = {{origin + 2. * i + 1}};
+        tgtv(i) = f(tgtp(i));
+      });
+
+  ArborX::Interpolation::DistributedMovingLeastSquares<MemorySpace, double> mls(
+      comm, space, srcp, tgtp, ArborX::Interpolation::CRBF::Wendland<0>{},
+      ArborX::Interpolation::PolynomialDegree<1>{}, 2);
+  mls.interpolate(space, srcv, eval);
+  ARBORX_MDVIEW_TEST_TOL(eval, tgtv, Kokkos::Experimental::epsilon_v<float>);
+
+  // Same setup with two fields interpolated through the fused overload,
+  // exercising the plan reuse across fields
+  Kokkos::View<double **, MemorySpace> srcv2("Testing::srcv2", n, 2);
+  Kokkos::View<double **, MemorySpace> tgtv2("Testing::tgtv2", n, 2);
+  Kokkos::View<double **, MemorySpace> eval2("Testing::eval2", n, 2);
+  Kokkos::parallel_for(
+      "Testing::distributed_moving_least_squares::fill_fields",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int const i) {
+        auto f = [](const Point &p) { return 2 * p[0] - 1; };
+        auto g = [](const Point &p) { return 3 - p[0]; };
+
+        srcv2(i, 0) = f(srcp(i));
+        srcv2(i, 1) = g(srcp(i));
+        tgtv2(i, 0) = f(tgtp(i));
+        tgtv2(i, 1) = g(tgtp(i));
+      });
+  mls.interpolate(space, srcv2, eval2);
+  ARBORX_MDVIEW_TEST_TOL(eval2, tgtv2, Kokkos::Experimental::epsilon_v<float>);
+}
@@ -108,6 +108,112 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(moving_least_squares, DeviceType,
   ARBORX_MDVIEW_TEST_TOL(eval1, tgtv1, Kokkos::Experimental::epsilon_v<float>);
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(moving_least_squares_mixed_precision, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  // FIXME_HIP: the CI fails with:
+  // fatal error: in "mls_coefficients_edge_cases<Kokkos__Device<Kokkos__HIP_
+  // Kokkos__HIPSpace>>": std::runtime_error: Kokkos::Impl::ParallelFor/Reduce<
+  // HIP > could not find a valid team size.
+  // The error seems similar to https://github.com/kokkos/kokkos/issues/6743
+#ifdef KOKKOS_ENABLE_HIP
+  if (std::is_same_v<typename DeviceType::execution_space, Kokkos::HIP>)
+  {
+    return;
+  }
+#endif
+
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space{};
+
+  // Same setup as case 2 above, but with single-precision points, values and
+  // coefficients while the setup arithmetic runs in double. A polynomial of
+  // matching degree must still be reproduced to single-precision accuracy.
+  using Point = ArborX::ExperimentalHyperGeometry::Point<2, float>;
+  Kokkos::View<Point *, MemorySpace> srcp("Testing::srcp", 9);
+  Kokkos::View<Point *, MemorySpace> tgtp("Testing::tgtp", 4);
+  Kokkos::View<float *, MemorySpace> srcv("Testing::srcv", 9);
+  Kokkos::View<float *, MemorySpace> tgtv("Testing::tgtv", 4);
+  Kokkos::View<float *, MemorySpace> eval("Testing::eval", 4);
+  Kokkos::parallel_for(
+      "Testing::moving_least_squares_mixed_precision::fill",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, 9),
+      KOKKOS_LAMBDA(int const i) {
+        int u = (i / 2) * 2 - 1;
+        int v = (i % 2) * 2 - 1;
+        int x = (i / 3) - 1;
+        int y = (i % 3) - 1;
+        auto f = [](const Point &p) { return p[0] * p[1] + 4 * p[0]; };
+
+        srcp(i) = {{x * 2.f, y * 2.f}};
+        srcv(i) = f(srcp(i));
+        if (i < 4)
+        {
+          tgtp(i) = {{u * 1.f, v * 1.f}};
+          tgtv(i) = f(tgtp(i));
+        }
+      });
+  ArborX::Interpolation::MovingLeastSquares<MemorySpace, float, double> mls(
+      space, srcp, tgtp, ArborX::Interpolation::CRBF::Wendland<2>{},
+      ArborX::Interpolation::PolynomialDegree<2>{}, 8);
+  mls.interpolate(space, srcv, eval);
+  ARBORX_MDVIEW_TEST_TOL(eval, tgtv,
+                         10 * Kokkos::Experimental::epsilon_v<float>);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(moving_least_squares_multiple_fields, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  // FIXME_HIP: the CI fails with:
+  // fatal error: in "mls_coefficients_edge_cases<Kokkos__Device<Kokkos__HIP_
+  // Kokkos__HIPSpace>>": std::runtime_error: Kokkos::Impl::ParallelFor/Reduce<
+  // HIP > could not find a valid team size.
+  // The error seems similar to https://github.com/kokkos/kokkos/issues/6743
+#ifdef KOKKOS_ENABLE_HIP
+  if (std::is_same_v<typename DeviceType::execution_space, Kokkos::HIP>)
+  {
+    return;
+  }
+#endif
+
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space{};
+
+  // Same as case 1 of the first test, but two fields interpolated at once
+  // through the fused multi-field overload
+  using Point0 = ArborX::ExperimentalHyperGeometry::Point<1, double>;
+  Kokkos::View<Point0 *, MemorySpace> srcp0("Testing::srcp0", 4);
+  Kokkos::View<Point0 *, MemorySpace> tgtp0("Testing::tgtp0", 3);
+  Kokkos::View<double **, MemorySpace> srcv0("Testing::srcv0", 4, 2);
+  Kokkos::View<double **, MemorySpace> tgtv0("Testing::tgtv0", 3, 2);
+  Kokkos::View<double **, MemorySpace> eval0("Testing::eval0", 3, 2);
+  Kokkos::parallel_for(
+      "Testing::moving_least_squares_multiple_fields::for0",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, 4),
+      KOKKOS_LAMBDA(int const i) {
+        auto f = [](const Point0 &) { return 3.; };
+        auto g = [](const Point0 &p) { return 2 * p[0] - 1; };
+
+        srcp0(i) = {{2. * i}};
+        srcv0(i, 0) = f(srcp0(i));
+        srcv0(i, 1) = g(srcp0(i));
+
+        if (i < 3)
+        {
+          tgtp0(i) = {{2. * i + 1}};
+          tgtv0(i, 0) = f(tgtp0(i));
+          tgtv0(i, 1) = g(tgtp0(i));
+        }
+      });
+  ArborX::Interpolation::MovingLeastSquares<MemorySpace, double> mls0(
+      space, srcp0, tgtp0, ArborX::Interpolation::CRBF::Wendland<0>{},
+      ArborX::Interpolation::PolynomialDegree<1>{}, 2);
+  mls0.interpolate(space, srcv0, eval0);
+  ARBORX_MDVIEW_TEST_TOL(eval0, tgtv0, Kokkos::Experimental::epsilon_v<float>);
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(moving_least_squares_edge_cases, DeviceType,
                               ARBORX_DEVICE_TYPES)
 {
@@ -186,3 +292,89 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(moving_least_squares_edge_cases, DeviceType,
   mls1.interpolate(space, srcv1, eval1);
   ARBORX_MDVIEW_TEST_TOL(eval1, tgtv1, Kokkos::Experimental::epsilon_v<float>);
 }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(moving_least_squares_update, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  // FIXME_HIP: the CI fails with:
+  // fatal error: in "mls_coefficients_edge_cases<Kokkos__Device<Kokkos__HIP_
+  // Kokkos__HIPSpace>>": std::runtime_error: Kokkos::Impl::ParallelFor/Reduce<
+  // HIP > could not find a valid team size.
+  // The error seems similar to https://github.com/kokkos/kokkos/issues/6743
+#ifdef KOKKOS_ENABLE_HIP
+  if (std::is_same_v<typename DeviceType::execution_space, Kokkos::HIP>)
+  {
+    return;
+  }
+#endif
+
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space{};
+
+  // f(x) = 2x + 3 is reproduced exactly at degree 1, so after the update both
+  // kinds of rows must return f: the stale ones because they were recomputed
+  // on the moved cloud, the reused ones because their points did not move
+  //      -------0--------------->
+  // SRC:  0  2  4  ...  12  14~  16~  18~     (~ shifted by +.6)
+  // TGT:    1  3  ...  13  15  17~
+  using Point = ArborX::ExperimentalHyperGeometry::Point<1, double>;
+  int const n_src = 10;
+  int const n_tgt = 9;
+  Kokkos::View<Point *, MemorySpace> srcp_prev("Testing::srcp_prev", n_src);
+  Kokkos::View<Point *, MemorySpace> srcp("Testing::srcp", n_src);
+  Kokkos::View<Point *, MemorySpace> tgtp_prev("Testing::tgtp_prev", n_tgt);
+  Kokkos::View<Point *, MemorySpace> tgtp("Testing::tgtp", n_tgt);
+  Kokkos::View<double *, MemorySpace> srcv("Testing::srcv", n_src);
+  Kokkos::View<double *, MemorySpace> tgtv("Testing::tgtv", n_tgt);
+  Kokkos::View<double *, MemorySpace> eval("Testing::eval", n_tgt);
+  Kokkos::parallel_for(
+      "Testing::moving_least_squares_update::fill",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_src),
+      KOKKOS_LAMBDA(int const i) {
+        srcp_prev(i) = {{2. * i}};
+        srcp(i) = {{2. * i + (i >= 7 ? .6 : 0.)}};
+        if (i < n_tgt)
+        {
+          tgtp_prev(i) = {{2. * i + 1}};
+          tgtp(i) = {{2. * i + 1 + (i == n_tgt - 1 ? .6 : 0.)}};
+        }
+      });
+  ArborX::Interpolation::MovingLeastSquares<MemorySpace, double> mls(
+      space, srcp_prev, tgtp_prev, ArborX::Interpolation::CRBF::Wendland<0>{},
+      ArborX::Interpolation::PolynomialDegree<1>{}, 2);
+
+  // An update where nothing moved must be a no-op
+  mls.update(space, srcp_prev, srcp_prev, tgtp_prev, tgtp_prev, .25,
+             ArborX::Interpolation::CRBF::Wendland<0>{},
+             ArborX::Interpolation::PolynomialDegree<1>{});
+  Kokkos::parallel_for(
+      "Testing::moving_least_squares_update::fill_values_prev",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_src),
+      KOKKOS_LAMBDA(int const i) {
+        auto f = [](const Point &p) { return 2 * p[0] + 3; };
+
+        srcv(i) = f(srcp_prev(i));
+        if (i < n_tgt)
+          tgtv(i) = f(tgtp_prev(i));
+      });
+  mls.interpolate(space, srcv, eval);
+  ARBORX_MDVIEW_TEST_TOL(eval, tgtv, Kokkos::Experimental::epsilon_v<float>);
+
+  // Move the tail of both clouds past the tolerance and refresh
+  mls.update(space, srcp_prev, srcp, tgtp_prev, tgtp, .25,
+             ArborX::Interpolation::CRBF::Wendland<0>{},
+             ArborX::Interpolation::PolynomialDegree<1>{});
+  Kokkos::parallel_for(
+      "Testing::moving_least_squares_update::fill_values",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_src),
+      KOKKOS_LAMBDA(int const i) {
+        auto f = [](const Point &p) { return 2 * p[0] + 3; };
+
+        srcv(i) = f(srcp(i));
+        if (i < n_tgt)
+          tgtv(i) = f(tgtp(i));
+      });
+  mls.interpolate(space, srcv, eval);
+  ARBORX_MDVIEW_TEST_TOL(eval, tgtv, Kokkos::Experimental::epsilon_v<float>);
+}
@@ -0,0 +1,94 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_HyperBox.hpp>
+#include <ArborX_HyperPoint.hpp>
+#include <ArborX_MaskedGeometry.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <limits>
+
+using ArborX::Experimental::Masked;
+using ArborX::Details::distance;
+using ArborX::Details::expand;
+using ArborX::Details::intersects;
+using ArborX::Details::returnCentroid;
+
+using Point = ArborX::ExperimentalHyperGeometry::Point<3>;
+using Box = ArborX::ExperimentalHyperGeometry::Box<3>;
+
+BOOST_AUTO_TEST_SUITE(MaskedGeometries)
+
+BOOST_AUTO_TEST_CASE(expand_masked_masked)
+{
+  Masked<Box> a{Box{{0, 0, 0}, {1, 1, 1}}, 0b01u};
+  Masked<Box> const b{Box{{2, 2, 2}, {3, 3, 3}}, 0b10u};
+  expand(a, b);
+  // masks aggregate by OR, the geometry expands as usual
+  BOOST_TEST(a._mask == 0b11u);
+  BOOST_TEST(intersects(Point{2.5f, 2.5f, 2.5f}, a._geometry));
+
+  // a default-constructed masked geometry is the neutral element
+  Masked<Box> c;
+  expand(c, b);
+  BOOST_TEST(c._mask == 0b10u);
+  BOOST_TEST(intersects(Point{2.5f, 2.5f, 2.5f}, c._geometry));
+}
+
+BOOST_AUTO_TEST_CASE(intersects_masked_masked)
+{
+  Masked<Box> const fluid{Box{{0, 0, 0}, {1, 1, 1}}, 0b01u};
+  Masked<Box> const solid{Box{{0, 0, 0}, {1, 1, 1}}, 0b10u};
+
+  // overlapping geometries, but no common category
+  BOOST_TEST(!intersects(fluid, solid));
+  BOOST_TEST(intersects(fluid, fluid));
+  BOOST_TEST(intersects(Masked<Box>{Box{{0, 0, 0}, {1, 1, 1}}, 0b11u}, solid));
+  // common category, disjoint geometries
+  BOOST_TEST(!intersects(Masked<Box>{Box{{2, 2, 2}, {3, 3, 3}}, 0b01u}, fluid));
+}
+
+BOOST_AUTO_TEST_CASE(intersects_masked_plain)
+{
+  Masked<Box> const solid{Box{{0, 0, 0}, {1, 1, 1}}, 0b10u};
+
+  // an unmasked geometry ignores the mask and sees all categories
+  BOOST_TEST(intersects(Box{{0.5f, 0.5f, 0.5f}, {2, 2, 2}}, solid));
+  BOOST_TEST(!intersects(Box{{2, 2, 2}, {3, 3, 3}}, solid));
+  BOOST_TEST(intersects(Point{0.5f, 0.5f, 0.5f}, solid));
+  BOOST_TEST(intersects(solid, Box{{0.5f, 0.5f, 0.5f}, {2, 2, 2}}));
+}
+
+BOOST_AUTO_TEST_CASE(distance_masked_masked)
+{
+  Masked<Box> const fluid{Box{{0, 0, 0}, {1, 1, 1}}, 0b01u};
+
+  BOOST_TEST(distance(Masked<Point>{Point{2, 1, 1}, 0b01u}, fluid) == 1.f);
+  // no common category pushes the distance to infinity, pruning the subtree
+  // in nearest traversals
+  BOOST_TEST(distance(Masked<Point>{Point{2, 1, 1}, 0b10u}, fluid) ==
+             std::numeric_limits<float>::infinity());
+  BOOST_TEST(distance(Point{2, 1, 1}, fluid) == 1.f);
+}
+
+BOOST_AUTO_TEST_CASE(centroid_masked)
+{
+  Masked<Box> const fluid{Box{{0, 0, 0}, {1, 1, 1}}, 0b01u};
+  auto const centroid = returnCentroid(fluid);
+  BOOST_TEST(centroid[0] == 0.5f);
+  BOOST_TEST(centroid[1] == 0.5f);
+  BOOST_TEST(centroid[2] == 0.5f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
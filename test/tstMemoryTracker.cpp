@@ -0,0 +1,73 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <ArborX_MemoryTracker.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+
+BOOST_AUTO_TEST_SUITE(MemoryTracker)
+
+BOOST_AUTO_TEST_CASE(phase_attribution)
+{
+  using ArborX::Experimental::MemoryTracker;
+
+  MemoryTracker::reset();
+  MemoryTracker::start();
+
+  int const n = 1000;
+  {
+    Kokkos::Profiling::pushRegion("Testing::phase_a");
+    Kokkos::View<int *, Kokkos::HostSpace> a("Testing::a", n);
+    Kokkos::Profiling::popRegion();
+
+    Kokkos::Profiling::pushRegion("Testing::phase_b");
+    Kokkos::View<int *, Kokkos::HostSpace> b("Testing::b", 2 * n);
+    Kokkos::Profiling::popRegion();
+  }
+
+  MemoryTracker::stop();
+
+  auto phases = MemoryTracker::phases();
+  BOOST_TEST(phases.count("Testing::phase_a") == 1);
+  BOOST_TEST(phases.count("Testing::phase_b") == 1);
+
+  auto const &phase_a = phases["Testing::phase_a"];
+  BOOST_TEST(phase_a.peak_bytes >= n * sizeof(int));
+  // Both views were destroyed, so nothing is charged anymore
+  BOOST_TEST(phase_a.current_bytes == 0u);
+
+  // The peak was reached while both views were live
+  BOOST_TEST(MemoryTracker::peakTotalBytes() >= 3u * n * sizeof(int));
+
+  std::stringstream ss;
+  MemoryTracker::report(ss);
+  BOOST_TEST(!ss.str().empty());
+
+  MemoryTracker::reset();
+}
+
+BOOST_AUTO_TEST_CASE(untracked_without_start)
+{
+  using ArborX::Experimental::MemoryTracker;
+
+  MemoryTracker::reset();
+  {
+    Kokkos::View<int *, Kokkos::HostSpace> a("Testing::untracked", 100);
+  }
+  BOOST_TEST(MemoryTracker::phases().empty());
+  BOOST_TEST(MemoryTracker::peakTotalBytes() == 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -54,12 +54,13 @@ using ArborXTest::toView;
 template <class ExecutionSpace>
 auto build_minimum_spanning_tree(ExecutionSpace const &exec_space,
                                  std::vector<ArborX::Point> const &points_host,
-                                 int k)
+                                 int k, float epsilon = 0.f)
 {
   auto points = toView<ExecutionSpace>(points_host, "Test::points");
 
   using MemorySpace = typename ExecutionSpace::memory_space;
-  ArborX::Details::MinimumSpanningTree<MemorySpace> mst{exec_space, points, k};
+  ArborX::Details::MinimumSpanningTree<MemorySpace> mst{exec_space, points, k,
+                                                        epsilon};
 
   auto edges_host =
       Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, mst.edges);
@@ -157,3 +158,53 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(minimum_spanning_tree, DeviceType,
             {0, 1, 10}, {1, 2, 9}, {2, 3, 8}, {3, 4, 7}, {0, 5, 10}}));
   }
 }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(approximate_minimum_spanning_tree, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace exec_space;
+
+  std::vector<ArborX::Point> points;
+  for (int i = 0; i < 32; ++i)
+    points.push_back({(float)(i % 8), (float)(i / 8) * 1.5f, 0});
+  int const n = (int)points.size();
+
+  // With a zero quality knob the approximate mode must degenerate to the
+  // exact tree
+  BOOST_TEST(Test::build_minimum_spanning_tree(exec_space, points, 1, 0.f) ==
+                 Test::build_minimum_spanning_tree(exec_space, points, 1),
+             boost::test_tools::per_element());
+
+  float const epsilon = 0.5f;
+  auto edges =
+      Test::build_minimum_spanning_tree(exec_space, points, 1, epsilon);
+  BOOST_TEST(edges.extent_int(0) == n - 1);
+
+  // The result must still span all the points
+  std::vector<int> parent(n);
+  for (int i = 0; i < n; ++i)
+    parent[i] = i;
+  auto representative = [&parent](int i) {
+    while (parent[i] != i)
+      i = parent[i] = parent[parent[i]];
+    return i;
+  };
+  float total_weight = 0;
+  for (int e = 0; e < n - 1; ++e)
+  {
+    auto const &edge = edges(e);
+    BOOST_TEST(representative(edge.source) != representative(edge.target));
+    parent[representative(edge.source)] = representative(edge.target);
+    total_weight += edge.weight;
+  }
+
+  // Every edge is within the quality factor of the exact choice of its
+  // round, bounding the total weight as well
+  auto exact_edges = Test::build_minimum_spanning_tree(exec_space, points, 1);
+  float exact_weight = 0;
+  for (int e = 0; e < n - 1; ++e)
+    exact_weight += exact_edges(e).weight;
+  BOOST_TEST(total_weight >= exact_weight);
+  BOOST_TEST(total_weight <= (1 + epsilon) * exact_weight);
+}
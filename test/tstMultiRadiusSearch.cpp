@@ -0,0 +1,164 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborXTest_Cloud.hpp"
+#include "ArborXTest_StdVectorToKokkosView.hpp"
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_AttachIndices.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_MultiRadiusSearch.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(MultiRadiusSearch)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(multi_radius_query_degenerate, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace exec_space;
+
+  auto points = ArborXTest::toView<ExecutionSpace>(
+      std::vector<ArborX::Point>{{0.f, 0.f, 0.f}, {1.f, 0.f, 0.f}},
+      "Test::points");
+  ArborX::BoundingVolumeHierarchy<
+      MemorySpace, ArborX::PairValueIndex<ArborX::Point>>
+      bvh(exec_space, ArborX::Experimental::attach_indices(points));
+
+  auto no_query = ArborXTest::toView<ExecutionSpace>(
+      std::vector<ArborX::Point>{}, "Test::no_query");
+
+  Kokkos::View<int *, MemorySpace> offsets("Test::offsets", 0);
+  Kokkos::View<int *, MemorySpace> indices("Test::indices", 0);
+  ArborX::Experimental::multiRadiusQuery(exec_space, bvh, no_query,
+                                         {0.5f, 1.5f}, offsets, indices);
+  BOOST_TEST(offsets.size() == 1);
+  BOOST_TEST(indices.size() == 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(multi_radius_query_binning, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace exec_space;
+
+  // Points on a line so that the bin of every match is known by construction
+  auto points = ArborXTest::toView<ExecutionSpace>(
+      std::vector<ArborX::Point>{{0.f, 0.f, 0.f},
+                                 {1.f, 0.f, 0.f},
+                                 {2.f, 0.f, 0.f},
+                                 {3.f, 0.f, 0.f},
+                                 {4.f, 0.f, 0.f}},
+      "Test::points");
+  ArborX::BoundingVolumeHierarchy<
+      MemorySpace, ArborX::PairValueIndex<ArborX::Point>>
+      bvh(exec_space, ArborX::Experimental::attach_indices(points));
+
+  auto queries = ArborXTest::toView<ExecutionSpace>(
+      std::vector<ArborX::Point>{{0.f, 0.f, 0.f}, {4.f, 0.f, 0.f}},
+      "Test::queries");
+
+  std::vector<float> const radii = {1.5f, 2.5f};
+  int const num_radii = radii.size();
+
+  Kokkos::View<int *, MemorySpace> offsets("Test::offsets", 0);
+  Kokkos::View<int *, MemorySpace> indices("Test::indices", 0);
+  ArborX::Experimental::multiRadiusQuery(exec_space, bvh, queries, radii,
+                                         offsets, indices);
+
+  auto offsets_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets);
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+
+  BOOST_TEST(offsets_host.size() == queries.size() * num_radii + 1);
+
+  auto segment = [&](int query, int bin) {
+    std::vector<int> result(
+        indices_host.data() + offsets_host(query * num_radii + bin),
+        indices_host.data() + offsets_host(query * num_radii + bin + 1));
+    std::sort(result.begin(), result.end());
+    return result;
+  };
+
+  BOOST_TEST(segment(0, 0) == (std::vector<int>{0, 1}),
+             boost::test_tools::per_element());
+  BOOST_TEST(segment(0, 1) == (std::vector<int>{2}),
+             boost::test_tools::per_element());
+  BOOST_TEST(segment(1, 0) == (std::vector<int>{3, 4}),
+             boost::test_tools::per_element());
+  BOOST_TEST(segment(1, 1) == (std::vector<int>{2}),
+             boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(multi_radius_query_vs_single_radius, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace exec_space;
+
+  auto points =
+      ArborXTest::make_random_cloud<ArborX::Point>(exec_space, 100);
+  auto queries = ArborXTest::make_random_cloud<ArborX::Point>(
+      exec_space, 20, 1.f, 1.f, 1.f, /*seed*/ 1234);
+
+  ArborX::BoundingVolumeHierarchy<
+      MemorySpace, ArborX::PairValueIndex<ArborX::Point>>
+      bvh(exec_space, ArborX::Experimental::attach_indices(points));
+
+  std::vector<float> const radii = {0.2f, 0.4f, 0.8f};
+  int const num_radii = radii.size();
+
+  Kokkos::View<int *, MemorySpace> offsets("Test::offsets", 0);
+  Kokkos::View<int *, MemorySpace> indices("Test::indices", 0);
+  ArborX::Experimental::multiRadiusQuery(exec_space, bvh, queries, radii,
+                                         offsets, indices);
+
+  auto offsets_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets);
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  auto points_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, points);
+  auto queries_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, queries);
+
+  int const n_points = points.size();
+  int const n_queries = queries.size();
+
+  // The union of a query's segments 0 through l must match the plain radius
+  // search at radii[l], computed here by brute force
+  for (int i = 0; i < n_queries; ++i)
+    for (int l = 0; l < num_radii; ++l)
+    {
+      std::vector<int> result(
+          indices_host.data() + offsets_host(i * num_radii),
+          indices_host.data() + offsets_host(i * num_radii + l + 1));
+      std::sort(result.begin(), result.end());
+
+      std::vector<int> reference;
+      for (int j = 0; j < n_points; ++j)
+        if (ArborX::Details::distance(queries_host(i), points_host(j)) <=
+            radii[l])
+          reference.push_back(j);
+
+      BOOST_TEST(result == reference, boost::test_tools::per_element());
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
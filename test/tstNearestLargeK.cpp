@@ -0,0 +1,116 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborXTest_Cloud.hpp"
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_AttachIndices.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_NearestLargeK.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(NearestLargeK)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(large_k_nearest_degenerate, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace exec_space;
+
+  using Value = ArborX::PairValueIndex<ArborX::Point>;
+
+  auto points =
+      ArborXTest::make_random_cloud<ArborX::Point>(exec_space, 10);
+  ArborX::BoundingVolumeHierarchy<MemorySpace, Value> bvh(
+      exec_space, ArborX::Experimental::attach_indices(points));
+
+  Kokkos::View<decltype(ArborX::nearest(ArborX::Point{}, 0)) *, MemorySpace>
+      no_query("Test::no_query", 0);
+
+  Kokkos::View<Value *, MemorySpace> values("Test::values", 0);
+  Kokkos::View<int *, MemorySpace> offsets("Test::offsets", 0);
+  ArborX::Experimental::largeKNearestQuery(exec_space, bvh, no_query, values,
+                                           offsets);
+  BOOST_TEST(offsets.size() == 1);
+  BOOST_TEST(values.size() == 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(large_k_nearest, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace exec_space;
+
+  using Value = ArborX::PairValueIndex<ArborX::Point>;
+
+  int const n = 1000;
+  auto points = ArborXTest::make_random_cloud<ArborX::Point>(exec_space, n);
+  ArborX::BoundingVolumeHierarchy<MemorySpace, Value> bvh(
+      exec_space, ArborX::Experimental::attach_indices(points));
+
+  // A spread of k values: large ones where the engine pays off, small ones
+  // exercising the radius growth, and one exceeding the tree size to force
+  // the under-filled fallback
+  int const n_queries = 50;
+  Kokkos::View<decltype(ArborX::nearest(ArborX::Point{}, 0)) *, MemorySpace>
+      queries(Kokkos::view_alloc(Kokkos::WithoutInitializing, "Test::queries"),
+              n_queries);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n_queries),
+      KOKKOS_LAMBDA(int i) {
+        int const k = (i == 0 ? 2 * n : (i % 3 == 0 ? 1 + i : 100 + i));
+        queries(i) = ArborX::nearest(points((i * 13) % n), k);
+      });
+
+  Kokkos::View<Value *, MemorySpace> ref_values("Test::ref_values", 0);
+  Kokkos::View<int *, MemorySpace> ref_offsets("Test::ref_offsets", 0);
+  bvh.query(exec_space, queries, ref_values, ref_offsets);
+
+  Kokkos::View<Value *, MemorySpace> values("Test::values", 0);
+  Kokkos::View<int *, MemorySpace> offsets("Test::offsets", 0);
+  ArborX::Experimental::largeKNearestQuery(exec_space, bvh, queries, values,
+                                           offsets);
+
+  auto ref_offsets_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, ref_offsets);
+  auto ref_values_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, ref_values);
+  auto offsets_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets);
+  auto values_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, values);
+
+  BOOST_TEST(offsets_host.size() == ref_offsets_host.size());
+  for (int q = 0; q < n_queries; ++q)
+  {
+    BOOST_TEST(offsets_host(q + 1) == ref_offsets_host(q + 1));
+
+    // Both paths emit by increasing distance; compare the neighbor sets by
+    // index to stay robust against ties
+    std::vector<unsigned> expected;
+    std::vector<unsigned> actual;
+    for (int j = offsets_host(q); j < offsets_host(q + 1); ++j)
+    {
+      expected.push_back(ref_values_host(j).index);
+      actual.push_back(values_host(j).index);
+    }
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    BOOST_TEST(actual == expected, boost::test_tools::per_element());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
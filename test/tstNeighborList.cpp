@@ -21,6 +21,7 @@
 #include "ArborX_EnableViewComparison.hpp"
 #include <ArborX_DetailsExpandHalfToFull.hpp>
 #include <ArborX_NeighborList.hpp>
+#include <ArborX_PredicateHelpers.hpp>
 #include <ArborX_Sphere.hpp>
 
 #include <Kokkos_Random.hpp>
@@ -28,6 +29,8 @@
 #include "BoostTest_CUDA_clang_workarounds.hpp"
 #include <boost/test/unit_test.hpp>
 
+#include <set>
+
 namespace Test
 {
 using ArborXTest::toView;
@@ -175,3 +178,112 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(
           Test::compute_reference<MemorySpace>(exec_space, points, radius),
       boost::test_tools::per_element());
 }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(find_neighbor_list_verlet, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using MemorySpace = typename DeviceType::memory_space;
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace exec_space;
+
+  float const radius = 1.1f;
+  float const skin = .7f;
+
+  ArborX::Experimental::VerletListCache<MemorySpace, ArborX::Point> cache;
+  Kokkos::View<int *, MemorySpace> offsets("Test::offsets", 0);
+  Kokkos::View<int *, MemorySpace> indices("Test::indices", 0);
+
+  auto verlet_list = [&](auto const &points) {
+    ArborX::Experimental::findFullNeighborList(exec_space, points, radius,
+                                               skin, offsets, indices, cache);
+    return make_compressed_storage(
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets),
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices));
+  };
+
+  auto points = ArborXTest::toView<ExecutionSpace>(
+      std::vector<ArborX::Point>{
+          {0.f, 0.f, 0.f}, {1.f, 0.f, 0.f}, {2.f, 0.f, 0.f}, {3.f, 0.f, 0.f}},
+      "Test::points");
+  BOOST_TEST(verlet_list(points) ==
+                 make_compressed_storage(std::vector<int>{0, 1, 3, 5, 6},
+                                         std::vector<int>{1, 0, 2, 1, 3, 2}),
+             boost::test_tools::per_element());
+
+  // Everything drifted less than skin / 2 from the snapshot: the cached list
+  // comes back unchanged even though a rebuild at radius + skin would now
+  // find additional pairs
+  auto drifted = ArborXTest::toView<ExecutionSpace>(
+      std::vector<ArborX::Point>{
+          {.3f, 0.f, 0.f}, {1.f, 0.f, 0.f}, {2.f, 0.f, 0.f}, {2.7f, 0.f, 0.f}},
+      "Test::drifted");
+  BOOST_TEST(verlet_list(drifted) ==
+                 make_compressed_storage(std::vector<int>{0, 1, 3, 5, 6},
+                                         std::vector<int>{1, 0, 2, 1, 3, 2}),
+             boost::test_tools::per_element());
+
+  // The first point moved farther than skin / 2, forcing a rebuild
+  auto moved = ArborXTest::toView<ExecutionSpace>(
+      std::vector<ArborX::Point>{
+          {.9f, 0.f, 0.f}, {1.f, 0.f, 0.f}, {2.f, 0.f, 0.f}, {3.f, 0.f, 0.f}},
+      "Test::moved");
+  BOOST_TEST(verlet_list(moved) ==
+                 make_compressed_storage(
+                     std::vector<int>{0, 2, 4, 7, 8},
+                     std::vector<int>{1, 2, 0, 2, 0, 1, 3, 2}),
+             boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(find_k_nearest_neighbor_list, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using MemorySpace = typename DeviceType::memory_space;
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace exec_space;
+
+  auto points = ArborXTest::make_random_cloud<ArborX::Point>(exec_space, 100);
+  int const k = 5;
+
+  Kokkos::View<int *, MemorySpace> offsets("Test::offsets", 0);
+  Kokkos::View<int *, MemorySpace> indices("Test::indices", 0);
+  ArborX::Experimental::findKNearestNeighborList(exec_space, points, k,
+                                                 offsets, indices);
+
+  // Reference: generic nearest query excluding the query point itself
+  ArborX::BoundingVolumeHierarchy<MemorySpace,
+                                  ArborX::PairValueIndex<ArborX::Point>>
+      bvh(exec_space, ArborX::Experimental::attach_indices(points));
+  Kokkos::View<int *, MemorySpace> offsets_ref("Test::offsets_ref", 0);
+  Kokkos::View<ArborX::PairValueIndex<ArborX::Point> *, MemorySpace>
+      values_ref("Test::values_ref", 0);
+  bvh.query(exec_space, ArborX::Experimental::make_nearest(points, k + 1),
+            values_ref, offsets_ref);
+
+  auto offsets_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets);
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  auto offsets_ref_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets_ref);
+  auto values_ref_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, values_ref);
+
+  int const n = points.size();
+  for (int i = 0; i < n; ++i)
+  {
+    BOOST_TEST(offsets_host(i + 1) - offsets_host(i) == k);
+    std::set<int> neighbors(&indices_host(offsets_host(i)),
+                            &indices_host(offsets_host(i)) + k);
+    std::set<int> reference;
+    for (int j = offsets_ref_host(i); j < offsets_ref_host(i + 1); ++j)
+      if ((int)values_ref_host(j).index != i)
+        reference.insert(values_ref_host(j).index);
+    // The (k+1)-nearest reference contains the point itself plus its k
+    // neighbors (up to ties on the k-th distance)
+    BOOST_TEST((int)reference.size() >= k);
+    int matched = 0;
+    for (auto neighbor : neighbors)
+      matched += reference.count(neighbor);
+    BOOST_TEST(matched == k);
+  }
+}
@@ -0,0 +1,206 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_HyperBox.hpp>
+#include <ArborX_HyperPoint.hpp>
+#include <ArborX_HyperSphere.hpp>
+#include <ArborX_OBB.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+
+using ArborX::Experimental::OBB;
+using ArborX::Details::distance;
+using ArborX::Details::expand;
+using ArborX::Details::intersects;
+using ArborX::Details::returnCentroid;
+
+namespace tt = boost::test_tools;
+
+BOOST_AUTO_TEST_SUITE(OrientedBoundingBoxes)
+
+// Unit square rotated by 45 degrees: the diamond with corners (0.5,0),
+// (1,0.5), (0.5,1), and (0,0.5)
+auto makeDiamond()
+{
+  using Vector = ArborX::Details::Vector<2>;
+  auto const s = (float)(1 / std::sqrt(2.));
+  OBB<2> obb(Kokkos::Array<Vector, 2>{Vector{s, s}, Vector{-s, s}});
+  using Point = ArborX::ExperimentalHyperGeometry::Point<2>;
+  expand(obb, Point{0.5f, 0});
+  expand(obb, Point{1, 0.5f});
+  expand(obb, Point{0.5f, 1});
+  expand(obb, Point{0, 0.5f});
+  return obb;
+}
+
+BOOST_AUTO_TEST_CASE(expand_point_identity_frame)
+{
+  using Point = ArborX::ExperimentalHyperGeometry::Point<2>;
+
+  // With the default identity frame the OBB behaves like an axis-aligned box
+  OBB<2> obb;
+  BOOST_TEST(!intersects(Point{0, 0}, obb));
+  expand(obb, Point{1, 0});
+  expand(obb, Point{0, 1});
+  BOOST_TEST(intersects(Point{0, 0}, obb));
+  BOOST_TEST(intersects(Point{0.5f, 0.5f}, obb));
+  BOOST_TEST(intersects(Point{1, 1}, obb));
+  BOOST_TEST(!intersects(Point{1.5f, 0.5f}, obb));
+}
+
+BOOST_AUTO_TEST_CASE(intersects_point_obb)
+{
+  using Point = ArborX::ExperimentalHyperGeometry::Point<2>;
+
+  auto const obb = makeDiamond();
+  // the rotated frame fits the diamond exactly, so unlike the axis-aligned
+  // bounding box the unit square corners are not inside
+  BOOST_TEST(!intersects(Point{0, 0}, obb));
+  BOOST_TEST(!intersects(Point{1, 0}, obb));
+  BOOST_TEST(!intersects(Point{0, 1}, obb));
+  BOOST_TEST(!intersects(Point{1, 1}, obb));
+  // diamond corners
+  BOOST_TEST(intersects(Point{0.5f, 0}, obb));
+  BOOST_TEST(intersects(Point{1, 0.5f}, obb));
+  BOOST_TEST(intersects(Point{0.5f, 1}, obb));
+  BOOST_TEST(intersects(Point{0, 0.5f}, obb));
+  // center and mid diagonals
+  BOOST_TEST(intersects(Point{0.5f, 0.5f}, obb));
+  BOOST_TEST(intersects(Point{0.75f, 0.25f}, obb));
+  BOOST_TEST(intersects(Point{0.25f, 0.75f}, obb));
+  // slightly outside of the diagonals
+  BOOST_TEST(!intersects(Point{0.8f, 0.2f}, obb));
+  BOOST_TEST(!intersects(Point{0.2f, 0.8f}, obb));
+}
+
+BOOST_AUTO_TEST_CASE(intersects_box_obb)
+{
+  using Box = ArborX::ExperimentalHyperGeometry::Box<2>;
+
+  auto const obb = makeDiamond();
+  BOOST_TEST(!intersects(Box{}, obb));
+  BOOST_TEST(intersects(Box{{0.4f, 0.4f}, {0.6f, 0.6f}}, obb));
+  BOOST_TEST(intersects(Box{{0, 0}, {1, 1}}, obb));
+  // overlaps the axis-aligned bounding box of the diamond but not the
+  // diamond itself
+  BOOST_TEST(!intersects(Box{{0.85f, 0.85f}, {1, 1}}, obb));
+  BOOST_TEST(!intersects(Box{{2, 2}, {3, 3}}, obb));
+}
+
+BOOST_AUTO_TEST_CASE(intersects_sphere_obb)
+{
+  using Sphere = ArborX::ExperimentalHyperGeometry::Sphere<2>;
+
+  auto const obb = makeDiamond();
+  // closest diamond edge lies on the line x + y = 3/2, at distance
+  // 1/(2*sqrt(2)) from (1,1)
+  BOOST_TEST(!intersects(Sphere{{1, 1}, 0.3f}, obb));
+  BOOST_TEST(intersects(Sphere{{1, 1}, 0.4f}, obb));
+  BOOST_TEST(intersects(Sphere{{0.5f, 0.5f}, 0.1f}, obb));
+}
+
+BOOST_AUTO_TEST_CASE(intersects_obb_obb)
+{
+  using Point = ArborX::ExperimentalHyperGeometry::Point<2>;
+
+  auto const diamond = makeDiamond();
+  BOOST_TEST(intersects(diamond, diamond));
+  BOOST_TEST(!intersects(diamond, OBB<2>{}));
+  BOOST_TEST(!intersects(OBB<2>{}, diamond));
+
+  OBB<2> center;
+  expand(center, Point{0.45f, 0.45f});
+  expand(center, Point{0.55f, 0.55f});
+  BOOST_TEST(intersects(center, diamond));
+  BOOST_TEST(intersects(diamond, center));
+
+  OBB<2> corner;
+  expand(corner, Point{0.9f, 0.9f});
+  expand(corner, Point{1, 1});
+  BOOST_TEST(!intersects(corner, diamond));
+  BOOST_TEST(!intersects(diamond, corner));
+}
+
+BOOST_AUTO_TEST_CASE(expand_obb_obb)
+{
+  using Point = ArborX::ExperimentalHyperGeometry::Point<2>;
+
+  // An empty OBB adopts the incoming one, frame included
+  OBB<2> obb;
+  expand(obb, makeDiamond());
+  BOOST_TEST(!intersects(Point{0, 0}, obb));
+  BOOST_TEST(intersects(Point{0.5f, 0.5f}, obb));
+
+  // Further expansion keeps the adopted frame
+  OBB<2> other;
+  expand(other, Point{0, 0});
+  expand(other, Point{0.2f, 0.2f});
+  expand(obb, other);
+  BOOST_TEST(intersects(Point{0, 0}, obb));
+  BOOST_TEST(intersects(Point{0.1f, 0.1f}, obb));
+  BOOST_TEST(!intersects(Point{1, 1}, obb));
+}
+
+BOOST_AUTO_TEST_CASE(expand_box_obb)
+{
+  using Box = ArborX::ExperimentalHyperGeometry::Box<2>;
+
+  Box box;
+  expand(box, makeDiamond());
+  BOOST_TEST(std::abs(box.minCorner()[0]) < 1e-6f);
+  BOOST_TEST(std::abs(box.minCorner()[1]) < 1e-6f);
+  BOOST_TEST(box.maxCorner()[0] == 1.f, tt::tolerance(1e-6f));
+  BOOST_TEST(box.maxCorner()[1] == 1.f, tt::tolerance(1e-6f));
+}
+
+BOOST_AUTO_TEST_CASE(distance_point_obb)
+{
+  using Point = ArborX::ExperimentalHyperGeometry::Point<2>;
+
+  auto const obb = makeDiamond();
+  BOOST_TEST(distance(Point{0.5f, 0.5f}, obb) == 0.f);
+  BOOST_TEST(distance(Point{1, 1}, obb) == (float)(0.5 / std::sqrt(2.)),
+             tt::tolerance(1e-6f));
+}
+
+BOOST_AUTO_TEST_CASE(centroid_obb)
+{
+  auto const centroid = returnCentroid(makeDiamond());
+  BOOST_TEST(centroid[0] == 0.5f, tt::tolerance(1e-6f));
+  BOOST_TEST(centroid[1] == 0.5f, tt::tolerance(1e-6f));
+}
+
+BOOST_AUTO_TEST_CASE(intersects_point_obb_3D)
+{
+  using Point = ArborX::ExperimentalHyperGeometry::Point<3>;
+  using Vector = ArborX::Details::Vector<3>;
+
+  // unit square rotated by 45 degrees around the z axis, extruded along z
+  auto const s = (float)(1 / std::sqrt(2.));
+  OBB<3> obb(Kokkos::Array<Vector, 3>{Vector{s, s, 0}, Vector{-s, s, 0},
+                                      Vector{0, 0, 1}});
+  expand(obb, Point{0.5f, 0, 0});
+  expand(obb, Point{1, 0.5f, 0});
+  expand(obb, Point{0.5f, 1, 0});
+  expand(obb, Point{0, 0.5f, 0});
+  expand(obb, Point{0.5f, 0.5f, 1});
+
+  BOOST_TEST(intersects(Point{0.5f, 0.5f, 0.5f}, obb));
+  BOOST_TEST(intersects(Point{0.5f, 0.5f, 1}, obb));
+  BOOST_TEST(!intersects(Point{1, 1, 0.5f}, obb));
+  BOOST_TEST(!intersects(Point{0.5f, 0.5f, 1.5f}, obb));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
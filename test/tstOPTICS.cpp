@@ -0,0 +1,73 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborXTest_StdVectorToKokkosView.hpp"
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include "ArborX_EnableViewComparison.hpp"
+#include <ArborX_HyperPoint.hpp>
+#include <ArborX_OPTICS.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <limits>
+
+BOOST_AUTO_TEST_SUITE(OPTICS)
+
+namespace tt = boost::test_tools;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(optics_ordering, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using Point = ArborX::ExperimentalHyperGeometry::Point<2, float>;
+
+  ExecutionSpace space;
+
+  float const inf = std::numeric_limits<float>::infinity();
+
+  // Points on a line with growing gaps and a far away straggler. The
+  // integer coordinates keep all distances and core distances exact, so the
+  // reachability values can be compared without tolerance.
+  auto points = ArborXTest::toView<DeviceType>(
+      std::vector<Point>{{0, 0}, {1, 0}, {3, 0}, {7, 0}, {30, 0}},
+      "Testing::points");
+
+  {
+    // Plain Euclidean distances: the expansion walks down the line and the
+    // reachabilities are the consecutive gaps
+    auto optics = ArborX::Experimental::optics(space, points);
+    auto ordering = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{},
+                                                        optics._ordering);
+    auto reachability = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace{}, optics._reachability);
+    BOOST_TEST(ordering == (std::vector<int>{0, 1, 2, 3, 4}),
+               tt::per_element());
+    BOOST_TEST(reachability == (std::vector<float>{inf, 1, 2, 4, 23}),
+               tt::per_element());
+  }
+
+  {
+    // Mutual reachability with core_min_size = 3 lifts every distance to the
+    // core distances of its endpoints (distance to the third neighbor,
+    // counting the point itself)
+    auto optics = ArborX::Experimental::optics(space, points, 3);
+    auto ordering = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{},
+                                                        optics._ordering);
+    auto reachability = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace{}, optics._reachability);
+    BOOST_TEST(ordering == (std::vector<int>{0, 1, 2, 3, 4}),
+               tt::per_element());
+    BOOST_TEST(reachability == (std::vector<float>{inf, 3, 4, 6, 27}),
+               tt::per_element());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,83 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_HyperBox.hpp>
+#include <ArborX_HyperPoint.hpp>
+#include <ArborX_PeriodicSphere.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+using ArborX::Experimental::PeriodicSphere;
+using ArborX::Details::distance;
+using ArborX::Details::intersects;
+using ArborX::Details::returnCentroid;
+
+using Point = ArborX::ExperimentalHyperGeometry::Point<3>;
+using Box = ArborX::ExperimentalHyperGeometry::Box<3>;
+
+BOOST_AUTO_TEST_SUITE(PeriodicSpheres)
+
+BOOST_AUTO_TEST_CASE(intersects_periodic_sphere_point)
+{
+  // unit cube domain, sphere near the x=0 face
+  PeriodicSphere<3> const sphere{{0.1f, 0.5f, 0.5f}, 0.25f, {1, 1, 1}};
+
+  BOOST_TEST(intersects(sphere, Point{0.2f, 0.5f, 0.5f}));
+  // the wrapped image across the x boundary is only 0.2 away
+  BOOST_TEST(intersects(sphere, Point{0.9f, 0.5f, 0.5f}));
+  BOOST_TEST(!intersects(sphere, Point{0.5f, 0.5f, 0.5f}));
+  BOOST_TEST(intersects(Point{0.9f, 0.5f, 0.5f}, sphere));
+
+  // period 0 in x disables wrapping in that dimension
+  PeriodicSphere<3> const open_x{{0.1f, 0.5f, 0.5f}, 0.25f, {0, 1, 1}};
+  BOOST_TEST(!intersects(open_x, Point{0.9f, 0.5f, 0.5f}));
+  BOOST_TEST(intersects(open_x, Point{0.1f, 0.9f, 0.5f}));
+}
+
+BOOST_AUTO_TEST_CASE(intersects_periodic_sphere_box)
+{
+  PeriodicSphere<3> const sphere{{0.05f, 0.5f, 0.5f}, 0.1f, {1, 1, 1}};
+
+  BOOST_TEST(intersects(sphere, Box{{0, 0, 0}, {0.2f, 1, 1}}));
+  // a box flush against the opposite face is reached through the boundary
+  BOOST_TEST(intersects(sphere, Box{{0.9f, 0, 0}, {1, 1, 1}}));
+  BOOST_TEST(!intersects(sphere, Box{{0.4f, 0, 0}, {0.6f, 1, 1}}));
+  BOOST_TEST(intersects(Box{{0.9f, 0, 0}, {1, 1, 1}}, sphere));
+
+  // wrap in two dimensions at once, near a domain corner
+  PeriodicSphere<3> const corner{{0.05f, 0.05f, 0.5f}, 0.15f, {1, 1, 1}};
+  BOOST_TEST(intersects(corner, Box{{0.95f, 0.95f, 0.4f}, {1, 1, 0.6f}}));
+  BOOST_TEST(!intersects(corner, Box{{0.8f, 0.8f, 0.4f}, {0.85f, 0.85f, 0.6f}}));
+}
+
+BOOST_AUTO_TEST_CASE(distance_periodic_sphere)
+{
+  PeriodicSphere<3> const sphere{{0.1f, 0.5f, 0.5f}, 0.1f, {1, 1, 1}};
+
+  BOOST_TEST(distance(Point{0.4f, 0.5f, 0.5f}, sphere) == 0.2f);
+  // minimum image: through the boundary the center is 0.2 away
+  BOOST_TEST(distance(Point{0.9f, 0.5f, 0.5f}, sphere) == 0.1f);
+  BOOST_TEST(distance(Point{0.15f, 0.5f, 0.5f}, sphere) == 0.f);
+  BOOST_TEST(distance(sphere, Box{{0.85f, 0, 0}, {0.9f, 1, 1}}) == 0.1f);
+}
+
+BOOST_AUTO_TEST_CASE(centroid_periodic_sphere)
+{
+  PeriodicSphere<3> const sphere{{0.1f, 0.5f, 0.5f}, 0.1f, {1, 1, 1}};
+  auto const centroid = returnCentroid(sphere);
+  BOOST_TEST(centroid[0] == 0.1f);
+  BOOST_TEST(centroid[1] == 0.5f);
+  BOOST_TEST(centroid[2] == 0.5f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
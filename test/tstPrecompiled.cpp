@@ -0,0 +1,79 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <ArborX_Precompiled.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(Precompiled)
+
+// The entry points are pinned to the default execution space, so this test
+// is not templated on the device type
+BOOST_AUTO_TEST_CASE(precompiled_radius_and_nearest)
+{
+  using MemorySpace = Kokkos::DefaultExecutionSpace::memory_space;
+  using Point = ArborX::Experimental::PrecompiledPoint<3, float>;
+
+  Kokkos::DefaultExecutionSpace space;
+
+  int const n = 4;
+  Kokkos::View<Point *, MemorySpace> points(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::points"),
+      n);
+  auto points_host = Kokkos::create_mirror_view(points);
+  for (int i = 0; i < n; ++i)
+    points_host(i) = {(float)i, 0.f, 0.f};
+  Kokkos::deep_copy(space, points, points_host);
+
+  auto tree = ArborX::Experimental::buildTree<3, float>(space, points);
+  BOOST_TEST(tree.size() == n);
+
+  Kokkos::View<int *, MemorySpace> indices("Test::indices", 0);
+  Kokkos::View<int *, MemorySpace> offsets("Test::offsets", 0);
+
+  ArborX::Experimental::radiusSearch<3, float>(space, tree, points, 1.1f,
+                                               indices, offsets);
+  auto offsets_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets);
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  BOOST_TEST(offsets_host.size() == n + 1);
+  auto segment = [&](int i) {
+    std::vector<int> result(indices_host.data() + offsets_host(i),
+                            indices_host.data() + offsets_host(i + 1));
+    std::sort(result.begin(), result.end());
+    return result;
+  };
+  BOOST_TEST(segment(0) == (std::vector<int>{0, 1}));
+  BOOST_TEST(segment(1) == (std::vector<int>{0, 1, 2}));
+  BOOST_TEST(segment(2) == (std::vector<int>{1, 2, 3}));
+  BOOST_TEST(segment(3) == (std::vector<int>{2, 3}));
+
+  ArborX::Experimental::nearestSearch<3, float>(space, tree, points, 1,
+                                                indices, offsets);
+  offsets_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets);
+  indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  BOOST_TEST(offsets_host.size() == n + 1);
+  for (int i = 0; i < n; ++i)
+  {
+    BOOST_TEST(offsets_host(i) == i);
+    // The nearest neighbor of a stored point is itself
+    BOOST_TEST(indices_host(i) == i);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,89 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_PredicateHelpers.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+template <typename MemorySpace>
+struct PointIntersectsGenerator
+{
+  Kokkos::View<ArborX::Point *, MemorySpace> points;
+
+  KOKKOS_FUNCTION auto operator()(int i) const
+  {
+    return ArborX::intersects(points(i));
+  }
+};
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(PredicateGenerator)
+
+BOOST_AUTO_TEST_CASE(generated_predicates_access)
+{
+  using ArborX::Details::AccessValues;
+  using ArborX::Experimental::make_predicates;
+
+  int const n = 10;
+  Kokkos::View<ArborX::Point *, Kokkos::HostSpace> points("Testing::points",
+                                                          n);
+  for (int i = 0; i < n; ++i)
+    points(i) = {{(float)i, 0.f, 0.f}};
+
+  auto predicates = make_predicates(
+      Kokkos::HostSpace{}, PointIntersectsGenerator<Kokkos::HostSpace>{points},
+      n);
+  AccessValues<decltype(predicates), ArborX::PredicatesTag> q_values{
+      predicates};
+  BOOST_TEST(q_values.size() == n);
+
+  using ArborX::Details::equals;
+  BOOST_TEST(equals(getGeometry(q_values(0)), points(0)));
+  BOOST_TEST(equals(getGeometry(q_values(9)), points(9)));
+}
+
+BOOST_AUTO_TEST_CASE(generated_predicates_tree)
+{
+  using ExecutionSpace = Kokkos::DefaultHostExecutionSpace;
+  using MemorySpace = Kokkos::HostSpace;
+
+  ExecutionSpace space;
+
+  int const n = 10;
+  Kokkos::View<ArborX::Point *, MemorySpace> points("Testing::points", n);
+  for (int i = 0; i < n; ++i)
+    points(i) = {{(float)i, 0.f, 0.f}};
+
+  ArborX::BVH<MemorySpace> bvh(space, points);
+  BOOST_TEST(bvh.size() == n);
+
+  // No predicate view is ever materialized; each predicate is generated on
+  // the fly during the traversal (and during the predicate sorting)
+  auto predicates = ArborX::Experimental::make_predicates(
+      MemorySpace{}, PointIntersectsGenerator<MemorySpace>{points}, n);
+
+  Kokkos::View<int *, MemorySpace> indices("Testing::indices", 0);
+  Kokkos::View<int *, MemorySpace> offsets("Testing::offsets", 0);
+  bvh.query(space, predicates, indices, offsets);
+
+  for (int i = 0; i < n; ++i)
+  {
+    BOOST_TEST(offsets(i) == i);
+    BOOST_TEST(indices(i) == i);
+  }
+  BOOST_TEST(offsets(n) == n);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
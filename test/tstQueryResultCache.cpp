@@ -0,0 +1,107 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_QueryResultCache.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include "Search_UnitTestHelpers.hpp"
+
+BOOST_AUTO_TEST_SUITE(QueryResultCache)
+
+namespace tt = boost::test_tools;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(query_result_cache, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  ExecutionSpace space;
+
+  auto const tree = make<ArborX::BVH<MemorySpace>>(
+      space, {
+                 {{{0., 0., 0.}}, {{0., 0., 0.}}},
+                 {{{1., 0., 0.}}, {{1., 0., 0.}}},
+                 {{{2., 0., 0.}}, {{2., 0., 0.}}},
+                 {{{3., 0., 0.}}, {{3., 0., 0.}}},
+             });
+  // Same size, different primitives: tells a replayed output from a fresh
+  // traversal apart
+  auto const other_tree = make<ArborX::BVH<MemorySpace>>(
+      space, {
+                 {{{10., 0., 0.}}, {{10., 0., 0.}}},
+                 {{{1., 0., 0.}}, {{1., 0., 0.}}},
+                 {{{2., 0., 0.}}, {{2., 0., 0.}}},
+                 {{{3., 0., 0.}}, {{3., 0., 0.}}},
+             });
+
+  // Each query overlaps exactly one primitive so that the expected output
+  // does not depend on the within-query emission order
+  auto const queries = makeIntersectsBoxQueries<DeviceType>({
+      {{{-.5, -.5, -.5}}, {{.5, .5, .5}}},
+      {{{1.5, -.5, -.5}}, {{2.5, .5, .5}}},
+      {{{2.5, -.5, -.5}}, {{3.5, .5, .5}}},
+  });
+
+  using ViewType = Kokkos::View<int *, DeviceType>;
+  ViewType indices("indices", 0);
+  ViewType offset("offset", 0);
+
+  auto checkResults = [&indices, &offset](std::vector<int> const &offset_ref,
+                                          std::vector<int> const &indices_ref) {
+    auto indices_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+    auto offset_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+    BOOST_TEST(make_compressed_storage(offset_host, indices_host) ==
+                   make_compressed_storage(offset_ref, indices_ref),
+               tt::per_element());
+  };
+
+  ArborX::Experimental::QueryResultCache<ViewType> cache;
+
+  cache.query(space, tree, queries, indices, offset);
+  checkResults({0, 1, 2, 3}, {0, 2, 3});
+
+  // Same batch again: replayed from the cache, and the outputs handed back
+  // on the previous call may be modified without corrupting it
+  Kokkos::deep_copy(indices, -1);
+  cache.query(space, tree, queries, indices, offset);
+  checkResults({0, 1, 2, 3}, {0, 2, 3});
+
+  // The tree is not part of the key: without invalidation the cache replays
+  // the stale output for the other tree
+  cache.query(space, other_tree, queries, indices, offset);
+  checkResults({0, 1, 2, 3}, {0, 2, 3});
+
+  // Explicit invalidation forces a fresh traversal
+  cache.clear();
+  cache.query(space, other_tree, queries, indices, offset);
+  checkResults({0, 0, 1, 2}, {2, 3});
+
+  // A different predicate batch misses and refreshes the cache by itself
+  auto const other_queries = makeIntersectsBoxQueries<DeviceType>({
+      {{{2.5, -.5, -.5}}, {{3.5, .5, .5}}},
+      {{{1.5, -.5, -.5}}, {{2.5, .5, .5}}},
+      {{{-.5, -.5, -.5}}, {{.5, .5, .5}}},
+  });
+  cache.query(space, other_tree, other_queries, indices, offset);
+  checkResults({0, 1, 2, 2}, {3, 2});
+  cache.query(space, other_tree, other_queries, indices, offset);
+  checkResults({0, 1, 2, 2}, {3, 2});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -208,7 +208,18 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(callback_early_exit, TreeTypeTraits,
   auto counts_host =
       Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, counts);
 
+#ifdef ARBORX_TEST_RELAXED_CALLBACK_EARLY_EXIT
+  // Early exit is best effort when a predicate is processed by several
+  // threads concurrently (brute force): a few extra callback invocations may
+  // race with raising the exit flag, so only check the bounds.
+  for (int i = 0; i < 4; ++i)
+  {
+    BOOST_TEST(counts_host(i) >= counts_ref[i]);
+    BOOST_TEST(counts_host(i) <= 4);
+  }
+#else
   BOOST_TEST(counts_host == counts_ref, tt::per_element());
+#endif
 }
 #endif
 
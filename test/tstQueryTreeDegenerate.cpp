@@ -301,6 +301,39 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(couple_leaves_tree_nearest_predicate,
 }
 #endif
 
+#ifndef ARBORX_TEST_DISABLE_NEAREST_QUERY
+BOOST_AUTO_TEST_CASE_TEMPLATE(approximate_nearest_predicate, TreeTypeTraits,
+                              TreeTypeTraitsList)
+{
+  using Tree = typename TreeTypeTraits::type;
+  using ExecutionSpace = typename TreeTypeTraits::execution_space;
+  using DeviceType = typename TreeTypeTraits::device_type;
+
+  // The points are separated by much more than the requested slack, so the
+  // approximate traversal must return the exact answer
+  auto const tree =
+      make<Tree>(ExecutionSpace{}, {
+                                       {{{0., 0., 0.}}, {{0., 0., 0.}}},
+                                       {{{10., 10., 10.}}, {{10., 10., 10.}}},
+                                       {{{20., 20., 20.}}, {{20., 20., 20.}}},
+                                   });
+
+  ARBORX_TEST_QUERY_TREE(ExecutionSpace{}, tree,
+                         makeApproxNearestQueries<DeviceType>({
+                             {{{0., 0., 0.}}, 1, 0.05f},
+                             {{{11., 11., 11.}}, 2, 0.05f},
+                         }),
+                         make_reference_solution<int>({0, 1, 2}, {0, 1, 3}));
+
+  // eps = 0 must behave exactly like the exact nearest predicate
+  ARBORX_TEST_QUERY_TREE(ExecutionSpace{}, tree,
+                         makeApproxNearestQueries<DeviceType>({
+                             {{{20., 20., 20.}}, 3, 0.f},
+                         }),
+                         make_reference_solution<int>({2, 1, 0}, {0, 3}));
+}
+#endif
+
 #ifndef ARBORX_TEST_DISABLE_SPATIAL_QUERY_INTERSECTS_SPHERE
 BOOST_AUTO_TEST_CASE_TEMPLATE(duplicated_leaves_spatial_predicate,
                               TreeTypeTraits, TreeTypeTraitsList)
@@ -80,6 +80,62 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_ray_box_intersection, DeviceType,
       exec_space, tree, ArborX::Experimental::make_intersects(device_rays),
       make_reference_solution<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}, {0, 10}));
 }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_ray_mixed_octants, DeviceType,
+                              ARBORX_TEST_DEVICE_TYPES)
+{
+  using memory_space = typename DeviceType::memory_space;
+  typename DeviceType::execution_space exec_space;
+
+  std::vector<ArborX::Box> boxes;
+  for (unsigned int i = 0; i < 10; ++i)
+    boxes.emplace_back(ArborX::Point{(float)i, (float)i, (float)i},
+                       ArborX::Point{(float)i + 1, (float)i + 1, (float)i + 1});
+  Kokkos::View<ArborX::Box *, DeviceType> device_boxes("boxes", 10);
+  Kokkos::deep_copy(exec_space, device_boxes,
+                    Kokkos::View<ArborX::Box *, Kokkos::HostSpace>(
+                        boxes.data(), boxes.size()));
+
+  ArborX::BVH<memory_space> const tree(exec_space, device_boxes);
+
+  // Rays pointing in different octants exercise the octant bucketing done
+  // when sorting ray predicates; results must not depend on it
+  std::vector<ArborX::Experimental::Ray> rays;
+  rays.push_back({{-1, .5f, .5f}, {1, 0, 0}});
+  rays.push_back({{11, 10.5f, 10.5f}, {-1, 0, 0}});
+  rays.push_back({{.5f, .5f, -1}, {0, 0, 1}});
+  rays.push_back({{.5f, .5f, 2}, {0, 0, -1}});
+  Kokkos::View<ArborX::Experimental::Ray *, DeviceType> device_rays("rays", 4);
+  Kokkos::deep_copy(exec_space, device_rays,
+                    Kokkos::View<ArborX::Experimental::Ray *, Kokkos::HostSpace>(
+                        rays.data(), rays.size()));
+
+  auto predicates = ArborX::Experimental::make_intersects(device_rays);
+
+  Kokkos::View<int *, DeviceType> indices_sorted("indices", 0);
+  Kokkos::View<int *, DeviceType> offset_sorted("offset", 0);
+  tree.query(exec_space, predicates, indices_sorted, offset_sorted,
+             ArborX::Experimental::TraversalPolicy().setPredicateSorting(true));
+
+  Kokkos::View<int *, DeviceType> indices_unsorted("indices", 0);
+  Kokkos::View<int *, DeviceType> offset_unsorted("offset", 0);
+  tree.query(
+      exec_space, predicates, indices_unsorted, offset_unsorted,
+      ArborX::Experimental::TraversalPolicy().setPredicateSorting(false));
+
+  auto indices_sorted_host = Kokkos::create_mirror_view_and_copy(
+      Kokkos::HostSpace{}, indices_sorted);
+  auto offset_sorted_host = Kokkos::create_mirror_view_and_copy(
+      Kokkos::HostSpace{}, offset_sorted);
+  auto indices_unsorted_host = Kokkos::create_mirror_view_and_copy(
+      Kokkos::HostSpace{}, indices_unsorted);
+  auto offset_unsorted_host = Kokkos::create_mirror_view_and_copy(
+      Kokkos::HostSpace{}, offset_unsorted);
+  BOOST_TEST(offset_sorted_host == offset_unsorted_host,
+             boost::test_tools::per_element());
+  BOOST_TEST(indices_sorted_host == indices_unsorted_host,
+             boost::test_tools::per_element());
+}
 BOOST_AUTO_TEST_SUITE_END()
 
 template <typename DeviceType>
@@ -246,4 +302,54 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(single_leaf_tree_ordered_spatial_predicate,
                          make_reference_solution<int>({0}, {0, 1, 1}));
 }
 
+template <typename DeviceType>
+auto makeFirstKOrderedIntersectsQueries(
+    std::vector<ArborX::Experimental::Ray> const &rays, int k)
+{
+  int const n = rays.size();
+  Kokkos::View<decltype(ArborX::Experimental::ordered_intersects(
+                   ArborX::Experimental::Ray{})) *,
+               DeviceType>
+      queries("Testing::first_k_ordered_intersects_predicates", n);
+  auto queries_host = Kokkos::create_mirror_view(queries);
+  for (int i = 0; i < n; ++i)
+    queries_host(i) = ArborX::Experimental::ordered_intersects(rays[i], k);
+  Kokkos::deep_copy(queries, queries_host);
+  return queries;
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(first_k_ordered_spatial_predicate, DeviceType,
+                              ARBORX_TEST_DEVICE_TYPES)
+{
+  using MemorySpace = typename DeviceType::memory_space;
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using Tree = ArborX::BVH<MemorySpace>;
+
+  // Ten unit boxes along the main diagonal
+  std::vector<ArborX::Box> boxes;
+  int const n = 10;
+  for (int i = 0; i < n; ++i)
+    boxes.emplace_back(ArborX::Point{(float)i, (float)i, (float)i},
+                       ArborX::Point{(float)i + 1, (float)i + 1, (float)i + 1});
+  auto device_boxes = ArborXTest::toView<DeviceType>(boxes, "Testing::boxes");
+  Tree const tree(ExecutionSpace{}, device_boxes);
+
+  // Only the k closest crossings along each ray are reported
+  ARBORX_TEST_QUERY_TREE(ExecutionSpace{}, tree,
+                         makeFirstKOrderedIntersectsQueries<DeviceType>(
+                             {{{0, 0, 0}, {1, 1, 1}},
+                              {{(float)n, (float)n, (float)n}, {-1, -1, -1}}},
+                             4),
+                         make_reference_solution<int>(
+                             {0, 1, 2, 3, n - 1, n - 2, n - 3, n - 4},
+                             {0, 4, 8}));
+
+  // A limit larger than the number of crossings reports all of them
+  ARBORX_TEST_QUERY_TREE(
+      ExecutionSpace{}, tree,
+      makeFirstKOrderedIntersectsQueries<DeviceType>({{{0, 0, 0}, {1, 1, 1}}},
+                                                     2 * n),
+      make_reference_solution<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}, {0, n}));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -10,16 +10,22 @@
  ****************************************************************************/
 
 #include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_AttachIndices.hpp>
 #include <ArborX_DetailsKokkosExtMinMaxReduce.hpp>
 #include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
 #include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DetailsLaunchTuner.hpp>
 #include <ArborX_LinearBVH.hpp>
+#include <ArborX_PredicateSortingAutoTuner.hpp>
+#include <ArborX_PredicateSortingCache.hpp>
+#include <ArborX_TraversalStatistics.hpp>
 
 #include <boost/test/unit_test.hpp>
 
 #include <algorithm>
 #include <iostream>
 #include <random>
+#include <sstream>
 #include <tuple>
 
 #include "Search_UnitTestHelpers.hpp"
@@ -183,4 +189,479 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(unsorted_predicates, DeviceType,
   }
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(sorting_cache, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+
+  auto const bvh = make<ArborX::BVH<typename DeviceType::memory_space>>(
+      ExecutionSpace{}, {
+                            {{{0., 0., 0.}}, {{0., 0., 0.}}},
+                            {{{1., 1., 1.}}, {{1., 1., 1.}}},
+                            {{{2., 2., 2.}}, {{2., 2., 2.}}},
+                            {{{3., 3., 3.}}, {{3., 3., 3.}}},
+                        });
+
+  auto const queries = makeIntersectsBoxQueries<DeviceType>({
+      {{{2., 2., 2.}}, {{3., 3., 3.}}},
+      {{{0., 0., 0.}}, {{1., 1., 1.}}},
+  });
+
+  using ViewType = Kokkos::View<int *, DeviceType>;
+  ViewType indices("indices", 0);
+  ViewType offset("offset", 0);
+
+  std::vector<int> indices_ref = {2, 3, 0, 1};
+  std::vector<int> offset_ref = {0, 2, 4};
+  auto checkResultsAreFine = [&indices, &offset, &indices_ref,
+                              &offset_ref]() -> void {
+    auto indices_host = Kokkos::create_mirror_view(indices);
+    Kokkos::deep_copy(indices_host, indices);
+    auto offset_host = Kokkos::create_mirror_view(offset);
+    Kokkos::deep_copy(offset_host, offset);
+    BOOST_TEST(make_compressed_storage(offset_host, indices_host) ==
+                   make_compressed_storage(offset_ref, indices_ref),
+               tt::per_element());
+  };
+
+  ArborX::Experimental::PredicateSortingCache<DeviceType> cache;
+  auto const policy =
+      ArborX::Experimental::TraversalPolicy().setSortingCache(cache);
+
+  // The first call fills the cache
+  BOOST_CHECK_NO_THROW(
+      ArborX::query(bvh, ExecutionSpace{}, queries, indices, offset, policy));
+  checkResultsAreFine();
+  BOOST_TEST(cache._permute.size() == queries.size());
+
+  // The second call reuses the stored permutation instead of recomputing it
+  auto const *cached_data = cache._permute.data();
+  BOOST_CHECK_NO_THROW(
+      ArborX::query(bvh, ExecutionSpace{}, queries, indices, offset, policy));
+  checkResultsAreFine();
+  BOOST_TEST(cache._permute.data() == cached_data);
+
+  // Clearing invalidates the cache and the next call recomputes
+  cache.clear();
+  BOOST_CHECK_NO_THROW(
+      ArborX::query(bvh, ExecutionSpace{}, queries, indices, offset, policy));
+  checkResultsAreFine();
+  BOOST_TEST(cache._permute.size() == queries.size());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(sorting_auto_tuner, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+
+  auto const bvh = make<ArborX::BVH<typename DeviceType::memory_space>>(
+      ExecutionSpace{}, {
+                            {{{0., 0., 0.}}, {{0., 0., 0.}}},
+                            {{{1., 1., 1.}}, {{1., 1., 1.}}},
+                            {{{2., 2., 2.}}, {{2., 2., 2.}}},
+                            {{{3., 3., 3.}}, {{3., 3., 3.}}},
+                        });
+
+  auto const queries = makeIntersectsBoxQueries<DeviceType>({
+      {{{2., 2., 2.}}, {{3., 3., 3.}}},
+      {{{0., 0., 0.}}, {{1., 1., 1.}}},
+  });
+
+  using ViewType = Kokkos::View<int *, DeviceType>;
+  ViewType indices("indices", 0);
+  ViewType offset("offset", 0);
+
+  std::vector<int> indices_ref = {2, 3, 0, 1};
+  std::vector<int> offset_ref = {0, 2, 4};
+  auto checkResultsAreFine = [&indices, &offset, &indices_ref,
+                              &offset_ref]() -> void {
+    auto indices_host = Kokkos::create_mirror_view(indices);
+    Kokkos::deep_copy(indices_host, indices);
+    auto offset_host = Kokkos::create_mirror_view(offset);
+    Kokkos::deep_copy(offset_host, offset);
+    BOOST_TEST(make_compressed_storage(offset_host, indices_host) ==
+                   make_compressed_storage(offset_ref, indices_ref),
+               tt::per_element());
+  };
+
+  ArborX::Experimental::PredicateSortingAutoTuner tuner;
+  auto const policy =
+      ArborX::Experimental::TraversalPolicy().setPredicateSorting(tuner);
+
+  // Results are correct in both sampled configurations, and the tuner stays
+  // undecided until it has timed each one sample_rounds times
+  int const num_sampled_calls = 2 * tuner.sample_rounds;
+  for (int i = 0; i < num_sampled_calls; ++i)
+  {
+    BOOST_TEST(!tuner.decided());
+    BOOST_CHECK_NO_THROW(
+        ArborX::query(bvh, ExecutionSpace{}, queries, indices, offset, policy));
+    checkResultsAreFine();
+  }
+  BOOST_TEST(tuner.decided());
+  BOOST_TEST((tuner._decision == 0 || tuner._decision == 1));
+
+  // Decided calls keep using the locked-in configuration
+  BOOST_CHECK_NO_THROW(
+      ArborX::query(bvh, ExecutionSpace{}, queries, indices, offset, policy));
+  checkResultsAreFine();
+  BOOST_TEST(tuner.decided());
+
+  // A different number of predicates restarts the sampling
+  auto const other_queries = makeIntersectsBoxQueries<DeviceType>({
+      {{{0., 0., 0.}}, {{3., 3., 3.}}},
+  });
+  BOOST_CHECK_NO_THROW(ArborX::query(bvh, ExecutionSpace{}, other_queries,
+                                     indices, offset, policy));
+  BOOST_TEST(!tuner.decided());
+}
+
+namespace
+{
+struct ExtractIndex
+{
+  template <typename Predicate, typename Value, typename Output>
+  KOKKOS_FUNCTION void operator()(Predicate const &, Value const &value,
+                                  Output const &out) const
+  {
+    out((int)value.index);
+  }
+};
+} // namespace
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(seeded_nearest, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  using Point = ArborX::Point;
+  using Value = ArborX::PairValueIndex<Point>;
+
+  ExecutionSpace space;
+
+  int const n = 10;
+  Kokkos::View<Point *, MemorySpace> points(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Testing::points"),
+      n);
+  auto points_host = Kokkos::create_mirror_view(points);
+  for (int i = 0; i < n; ++i)
+    points_host(i) = {(float)i, 0.f, 0.f};
+  Kokkos::deep_copy(space, points, points_host);
+
+  ArborX::BoundingVolumeHierarchy<MemorySpace, Value> const bvh(
+      space, ArborX::Experimental::attach_indices(points));
+
+  using Seeded =
+      ArborX::PredicateWithInitialCandidate<ArborX::Nearest<Point>, Value>;
+
+  Kokkos::View<Seeded *, DeviceType> queries("Testing::seeded_nearest_queries",
+                                             3);
+  auto queries_host = Kokkos::create_mirror_view(queries);
+  // Seed from "last step" is still the answer
+  queries_host(0) = ArborX::Experimental::seeded_nearest(
+      Point{3.4f, 0.f, 0.f}, Value{Point{3.f, 0.f, 0.f}, 3}, 0.4f);
+  // Exact tie: nothing is strictly closer, so the seed itself is reported
+  queries_host(1) = ArborX::Experimental::seeded_nearest(
+      Point{5.f, 0.f, 0.f}, Value{Point{5.f, 0.f, 0.f}, 5}, 0.f);
+  // Stale seed: a strictly closer point exists and must win
+  queries_host(2) = ArborX::Experimental::seeded_nearest(
+      Point{7.4f, 0.f, 0.f}, Value{Point{9.f, 0.f, 0.f}, 9}, 1.6f);
+  Kokkos::deep_copy(space, queries, queries_host);
+
+  using ViewType = Kokkos::View<int *, DeviceType>;
+  ViewType indices("indices", 0);
+  ViewType offset("offset", 0);
+  bvh.query(space, queries, ExtractIndex{}, indices, offset);
+
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  auto offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+  BOOST_TEST(make_compressed_storage(offset_host, indices_host) ==
+                 make_compressed_storage(std::vector<int>{0, 1, 2, 3},
+                                         std::vector<int>{3, 5, 7}),
+             tt::per_element());
+
+  // A mixed-k batch leaves the k = 1 fast path: larger k ignore the seed,
+  // and a tied k = 1 seed is still reported
+  Kokkos::View<Seeded *, DeviceType> mixed("Testing::mixed_k_seeded_queries",
+                                           2);
+  auto mixed_host = Kokkos::create_mirror_view(mixed);
+  mixed_host(0) = Seeded{ArborX::nearest(Point{0.4f, 0.f, 0.f}, 2),
+                         Value{Point{0.f, 0.f, 0.f}, 0}, 0.4f};
+  mixed_host(1) = ArborX::Experimental::seeded_nearest(
+      Point{5.f, 0.f, 0.f}, Value{Point{5.f, 0.f, 0.f}, 5}, 0.f);
+  Kokkos::deep_copy(space, mixed, mixed_host);
+
+  bvh.query(space, mixed, ExtractIndex{}, indices, offset);
+
+  indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+  BOOST_TEST(make_compressed_storage(offset_host, indices_host) ==
+                 make_compressed_storage(std::vector<int>{0, 2, 3},
+                                         std::vector<int>{0, 1, 5}),
+             tt::per_element());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(ordered_nearest_output, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  // Each nearest query's results are emitted in ascending distance: the
+  // traversal drains its priority queue in order, so no separate segmented
+  // sort over the CRS output is ever needed. Lock in that guarantee for
+  // every k dispatch regime (single-nearest, register heap, buffered).
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  using Point = ArborX::Point;
+  using Value = ArborX::PairValueIndex<Point>;
+
+  ExecutionSpace space;
+
+  int const n = 20;
+  Kokkos::View<Point *, MemorySpace> points(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Testing::points"),
+      n);
+  auto points_host = Kokkos::create_mirror_view(points);
+  for (int i = 0; i < n; ++i)
+    points_host(i) = {(float)i, 0.f, 0.f};
+  Kokkos::deep_copy(space, points, points_host);
+
+  ArborX::BoundingVolumeHierarchy<MemorySpace, Value> const bvh(
+      space, ArborX::Experimental::attach_indices(points));
+
+  // Off-lattice query points make every candidate distance distinct, so the
+  // ascending-distance order is unique and fully determined
+  ArborX::Point const q0{5.3f, 0.f, 0.f};
+  ArborX::Point const q1{13.8f, 0.f, 0.f};
+  std::vector<int> const expected0 = {5, 6, 4, 7, 3, 8, 2, 9, 1, 10, 0, 11};
+  std::vector<int> const expected1 = {14, 13, 15, 12, 16, 11, 17, 10,
+                                      18, 9,  19, 8};
+
+  using ViewType = Kokkos::View<int *, DeviceType>;
+  ViewType indices("indices", 0);
+  ViewType offset("offset", 0);
+
+  for (int k : {1, 8, 12})
+  {
+    auto const queries = makeNearestQueries<DeviceType>({{q0, k}, {q1, k}});
+    bvh.query(space, queries, ExtractIndex{}, indices, offset);
+
+    std::vector<int> expected(expected0.begin(), expected0.begin() + k);
+    expected.insert(expected.end(), expected1.begin(), expected1.begin() + k);
+
+    auto indices_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+    auto offset_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+    BOOST_TEST(make_compressed_storage(offset_host, indices_host) ==
+                   make_compressed_storage(std::vector<int>{0, k, 2 * k},
+                                           expected),
+               tt::per_element());
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(launch_tuner, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using ArborX::Details::LaunchTuner;
+
+  ExecutionSpace space;
+
+  // Problem sizes are bucketed by their power of two
+  BOOST_TEST(LaunchTuner::makeKey("kernel", "backend", 1000) ==
+             LaunchTuner::makeKey("kernel", "backend", 1023));
+  BOOST_TEST(LaunchTuner::makeKey("kernel", "backend", 1024) !=
+             LaunchTuner::makeKey("kernel", "backend", 1023));
+  BOOST_TEST(LaunchTuner::makeKey("kernel", "backend", 1000) !=
+             LaunchTuner::makeKey("other_kernel", "backend", 1000));
+
+  // The cache is global, so use a key no traversal launch can produce
+  std::string const key =
+      std::string("tstQueryTreeTraversalPolicy::launch_tuner/") +
+      ExecutionSpace::name();
+  int const num_usable = 3;
+
+  // Sampling cycles through the usable candidates round-robin
+  std::vector<int> sampled;
+  int const num_sampled_calls = num_usable * LaunchTuner::sample_rounds;
+  for (int i = 0; i < num_sampled_calls; ++i)
+    LaunchTuner::run(space, key, num_usable,
+                     [&sampled](int candidate) { sampled.push_back(candidate); });
+  BOOST_TEST(sampled.size() == num_sampled_calls);
+  for (int i = 0; i < num_sampled_calls; ++i)
+    BOOST_TEST(sampled[i] == i % num_usable);
+
+  // Afterwards every call replays the locked-in candidate
+  int decision = -1;
+  LaunchTuner::run(space, key, num_usable,
+                   [&decision](int candidate) { decision = candidate; });
+  BOOST_TEST((decision >= 0 && decision < num_usable));
+  int replay = -1;
+  LaunchTuner::run(space, key, num_usable,
+                   [&replay](int candidate) { replay = candidate; });
+  BOOST_TEST(replay == decision);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(packet_traversal, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+
+  ExecutionSpace space;
+
+  auto const bvh = make<ArborX::BVH<typename DeviceType::memory_space>>(
+      space, {
+                 {{{0., 0., 0.}}, {{0., 0., 0.}}},
+                 {{{1., 1., 1.}}, {{1., 1., 1.}}},
+                 {{{2., 2., 2.}}, {{2., 2., 2.}}},
+                 {{{3., 3., 3.}}, {{3., 3., 3.}}},
+             });
+
+  auto const queries = makeIntersectsBoxWithAttachmentQueries<DeviceType, int>(
+      {
+          {{{2., 2., 2.}}, {{3., 3., 3.}}},
+          {{{0., 0., 0.}}, {{1., 1., 1.}}},
+          {{{5., 5., 5.}}, {{6., 6., 6.}}},
+      },
+      {0, 1, 2});
+
+  Kokkos::View<int *, DeviceType> counts("Testing::counts", 3);
+  bvh.query(
+      space, queries,
+      KOKKOS_LAMBDA(auto const &query, auto const &) {
+        Kokkos::atomic_increment(&counts(ArborX::getData(query)));
+      },
+      ArborX::Experimental::TraversalPolicy().setPacketTraversal(true));
+
+  auto counts_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, counts);
+  BOOST_TEST(counts_host(0) == 2);
+  BOOST_TEST(counts_host(1) == 2);
+  BOOST_TEST(counts_host(2) == 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(traversal_statistics, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  ExecutionSpace space;
+
+  auto const bvh = make<ArborX::BVH<MemorySpace>>(
+      space, {
+                 {{{0., 0., 0.}}, {{0., 0., 0.}}},
+                 {{{1., 1., 1.}}, {{1., 1., 1.}}},
+                 {{{2., 2., 2.}}, {{2., 2., 2.}}},
+                 {{{3., 3., 3.}}, {{3., 3., 3.}}},
+             });
+
+  auto const queries = makeIntersectsBoxWithAttachmentQueries<DeviceType, int>(
+      {
+          {{{2., 2., 2.}}, {{3., 3., 3.}}},
+          {{{0., 0., 0.}}, {{1., 1., 1.}}},
+          {{{5., 5., 5.}}, {{6., 6., 6.}}},
+      },
+      {0, 1, 2});
+
+  ArborX::Experimental::TraversalStatistics<MemorySpace> stats;
+
+  Kokkos::View<int *, DeviceType> counts("Testing::counts", 3);
+  ArborX::Experimental::queryWithStatistics(
+      bvh, space, queries,
+      KOKKOS_LAMBDA(auto const &query, auto const &) {
+        Kokkos::atomic_increment(&counts(ArborX::getData(query)));
+      },
+      stats);
+
+  // The instrumented traversal must produce the same results
+  auto counts_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, counts);
+  BOOST_TEST(counts_host(0) == 2);
+  BOOST_TEST(counts_host(1) == 2);
+  BOOST_TEST(counts_host(2) == 0);
+
+  auto internal_host = Kokkos::create_mirror_view_and_copy(
+      Kokkos::HostSpace{}, stats.internal_nodes_visited);
+  auto leaf_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{},
+                                                       stats.leaf_tests);
+  BOOST_TEST(internal_host.extent(0) == 3u);
+  // Matching queries at least visit the root and test their two leaves;
+  // the miss is pruned at the root without any leaf test
+  BOOST_TEST(internal_host(0) >= 1);
+  BOOST_TEST(leaf_host(0) >= 2);
+  BOOST_TEST(internal_host(1) >= 1);
+  BOOST_TEST(leaf_host(1) >= 2);
+  BOOST_TEST(leaf_host(2) == 0);
+
+  std::ostringstream report;
+  stats.report(report);
+  BOOST_TEST(!report.str().empty());
+
+  // Nearest path accumulates heap pushes
+  ArborX::Experimental::queryWithStatistics(
+      bvh, space,
+      makeNearestQueries<DeviceType>({
+          {{{0., 0., 0.}}, 3},
+          {{{2.5, 2.5, 2.5}}, 2},
+      }),
+      KOKKOS_LAMBDA(auto const &, auto const &) {}, stats);
+
+  auto pushes_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{},
+                                                         stats.heap_pushes);
+  BOOST_TEST(pushes_host.extent(0) == 2u);
+  BOOST_TEST(pushes_host(0) >= 3);
+  BOOST_TEST(pushes_host(1) >= 2);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(record_node_visits, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  ExecutionSpace space;
+
+  auto const bvh = make<ArborX::BVH<MemorySpace>>(
+      space, {
+                 {{{0., 0., 0.}}, {{0., 0., 0.}}},
+                 {{{1., 1., 1.}}, {{1., 1., 1.}}},
+                 {{{2., 2., 2.}}, {{2., 2., 2.}}},
+                 {{{3., 3., 3.}}, {{3., 3., 3.}}},
+             });
+
+  auto const queries = makeIntersectsBoxQueries<DeviceType>({
+      {{{2., 2., 2.}}, {{3., 3., 3.}}},
+      {{{0., 0., 0.}}, {{1., 1., 1.}}},
+      {{{5., 5., 5.}}, {{6., 6., 6.}}},
+  });
+
+  Kokkos::View<int *, MemorySpace> visits("Testing::visits", 0);
+  ArborX::Experimental::recordNodeVisits(bvh, space, queries, visits);
+
+  // One counter per node, leaves first, the root at entry size()
+  auto visits_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, visits);
+  BOOST_TEST(visits_host.extent(0) == 7u);
+  // Every query walks through the root
+  BOOST_TEST(visits_host(4) == 3);
+  // The two matching queries test two leaves each; the miss is pruned at
+  // the root without reaching any leaf
+  int leaf_tests = 0;
+  for (int i = 0; i < 4; ++i)
+    leaf_tests += visits_host(i);
+  BOOST_TEST(leaf_tests >= 4);
+
+  // A second batch accumulates into the same counters instead of resetting
+  ArborX::Experimental::recordNodeVisits(bvh, space, queries, visits);
+  Kokkos::deep_copy(visits_host, visits);
+  BOOST_TEST(visits_host(4) == 6);
+
+  // The nearest path records into the same view
+  ArborX::Experimental::recordNodeVisits(
+      bvh, space, makeNearestQueries<DeviceType>({{{{0., 0., 0.}}, 3}}),
+      visits);
+  Kokkos::deep_copy(visits_host, visits);
+  BOOST_TEST(visits_host(4) == 7);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -14,6 +14,9 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <cmath>
+#include <vector>
+
 BOOST_AUTO_TEST_CASE(intersects_box)
 {
   using ArborX::Box;
@@ -276,6 +279,100 @@ BOOST_AUTO_TEST_CASE(ray_box_distance)
   BOOST_TEST(ArborX::Experimental::distance(Ray{{.5, .5, -.5}, {0, 0, -1}}, unit_box) == inf);
 }
 
+BOOST_AUTO_TEST_CASE(precomputed_ray_box)
+{
+  using ArborX::Box;
+  using ArborX::Experimental::PrecomputedRay;
+  using ArborX::Experimental::Ray;
+
+  constexpr Box unit_box{{0, 0, 0}, {1, 1, 1}};
+
+  // The precomputed form must agree with the plain ray on every box test,
+  // including the axis-aligned directions and origin-on-face cases where the
+  // division-based slab test produces infinities and NaNs
+  std::vector<Ray> rays = {
+      {{.5, .5, .5}, {1, 0, 0}},    {{.5, .5, .5}, {1, 1, 1}},
+      {{-1, .5, .5}, {1, 0, 0}},    {{-1, .5, .5}, {-1, 0, 0}},
+      {{-1, .5, .5}, {0, 1, 1}},    {{-1, 1.5, .5}, {1, -1, 0}},
+      {{2, -.5, 1.5}, {-1, 1, -1}}, {{1, 2, 3}, {4, 5, 6}},
+      {{1, 2, 3}, {-1, -2, -3}},    {{0, 0, 0}, {1, 1, 1}},
+      {{0, 0, 0}, {0, 1, -1}},      {{0, 0, 0}, {-1, 0, -1}},
+      {{0, 0, 0}, {0, 0, 1}},       {{1, 1, 1}, {0, -1, -1}},
+      {{1, 1, 1}, {1, 0, 0}},       {{0, 1, 1}, {0, 0, 1}},
+      {{.5, .5, -.5}, {0, 0, 1}},   {{.5, .5, -.5}, {0, 0, -1}},
+  };
+
+  // Multiplying by the reciprocal may differ from the division by an ulp, so
+  // finite values are compared with a tolerance; infinities are compared
+  // exactly, as the relative comparison does not handle them
+  namespace tt = boost::test_tools;
+  for (auto const &ray : rays)
+  {
+    PrecomputedRay precomputed(ray);
+    BOOST_TEST(equals(static_cast<Ray const &>(precomputed), ray));
+
+    BOOST_TEST(intersects(precomputed, unit_box) == intersects(ray, unit_box));
+
+    auto const d_ref = ArborX::Experimental::distance(ray, unit_box);
+    auto const d = ArborX::Experimental::distance(precomputed, unit_box);
+    if (std::isfinite(d_ref))
+      BOOST_TEST(d == d_ref, tt::tolerance(1e-5f));
+    else
+      BOOST_TEST(d == d_ref);
+
+    float tmin_ref;
+    float tmax_ref;
+    float tmin;
+    float tmax;
+    bool const hit_ref =
+        ArborX::Experimental::intersection(ray, unit_box, tmin_ref, tmax_ref);
+    bool const hit =
+        ArborX::Experimental::intersection(precomputed, unit_box, tmin, tmax);
+    BOOST_TEST(hit == hit_ref);
+    if (hit_ref)
+    {
+      BOOST_TEST(tmin == tmin_ref, tt::tolerance(1e-5f));
+      BOOST_TEST(tmax == tmax_ref, tt::tolerance(1e-5f));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(bounded_ray_intersects)
+{
+  using ArborX::Box;
+  using ArborX::Experimental::BoundedRay;
+  using Point = BoundedRay::Point;
+
+  constexpr Box unit_box{{0, 0, 0}, {1, 1, 1}};
+
+  // The interval starts inside or crosses into the box
+  BOOST_TEST(intersects(BoundedRay{{.5, .5, .5}, {1, 0, 0}, 10.f}, unit_box));
+  BOOST_TEST(intersects(BoundedRay{{-1, .5, .5}, {1, 0, 0}, 1.f}, unit_box));
+  BOOST_TEST(intersects(BoundedRay{{-1, .5, .5}, {1, 0, 0}, 1.5f}, unit_box));
+  // The interval ends before reaching the box
+  BOOST_TEST(!intersects(BoundedRay{{-1, .5, .5}, {1, 0, 0}, .5f}, unit_box));
+  // The box is behind the ray
+  BOOST_TEST(!intersects(BoundedRay{{2, .5, .5}, {1, 0, 0}, 10.f}, unit_box));
+  // Would miss regardless of the interval
+  BOOST_TEST(!intersects(BoundedRay{{-1, 1.5, .5}, {1, 0, 0}, 10.f}, unit_box));
+
+  // Segment between two points
+  BOOST_TEST(intersects(BoundedRay{Point{-1, .5, .5}, Point{2, .5, .5}},
+                        unit_box));
+  BOOST_TEST(intersects(BoundedRay{Point{-1, .5, .5}, Point{.5, .5, .5}},
+                        unit_box));
+  BOOST_TEST(!intersects(BoundedRay{Point{-1, .5, .5}, Point{-.5, .5, .5}},
+                         unit_box));
+  BOOST_TEST(!intersects(BoundedRay{Point{2, .5, .5}, Point{3, .5, .5}},
+                         unit_box));
+
+  using ArborX::ExperimentalHyperGeometry::Triangle;
+  constexpr Triangle<3> triangle{{0, 0, 1}, {1, 0, 1}, {0, 1, 1}};
+  BOOST_TEST(intersects(BoundedRay{{.25, .25, 0}, {0, 0, 1}, 2.f}, triangle));
+  BOOST_TEST(!intersects(BoundedRay{{.25, .25, 0}, {0, 0, 1}, .5f}, triangle));
+  BOOST_TEST(!intersects(BoundedRay{{.25, .25, 2}, {0, 0, 1}, 2.f}, triangle));
+}
+
 // NOTE until boost 1.70 need to cast both operands when comparing floating
 // points
 BOOST_AUTO_TEST_CASE(overlap_distance_sphere,
@@ -0,0 +1,59 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborXTest_StdVectorToKokkosView.hpp"
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include "ArborX_EnableViewComparison.hpp"
+#include <ArborX_Reorder.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(Reorder)
+
+namespace tt = boost::test_tools;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(reorder_along_space_filling_curve, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using ArborX::Details::equals;
+
+  ExecutionSpace space;
+
+  // Points on the diagonal of the scene bounding box, where every
+  // space-filling curve is monotone, listed out of order
+  std::vector<ArborX::Point> points_v{
+      {3, 3, 3}, {0, 0, 0}, {2, 2, 2}, {1, 1, 1}};
+  auto points = ArborXTest::toView<DeviceType>(points_v, "Testing::points");
+
+  auto permutation =
+      ArborX::Experimental::reorderAlongSpaceFillingCurve(space, points);
+
+  auto points_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, points);
+  auto permutation_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, permutation);
+
+  BOOST_TEST(permutation_host == (std::vector<unsigned>{1, 3, 2, 0}),
+             tt::per_element());
+
+  // The values are physically in curve order and consistent with the
+  // returned permutation
+  for (int i = 0; i < (int)points_v.size(); ++i)
+  {
+    BOOST_TEST(equals(points_host(i), ArborX::Point{(float)i, (float)i,
+                                                    (float)i}));
+    BOOST_TEST(equals(points_host(i), points_v[permutation_host(i)]));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
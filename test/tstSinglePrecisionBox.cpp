@@ -0,0 +1,112 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_AttachIndices.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_PredicateHelpers.hpp>
+#include <ArborX_SinglePrecisionBox.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <limits>
+
+BOOST_AUTO_TEST_SUITE(SinglePrecisionBox)
+
+BOOST_AUTO_TEST_CASE(single_precision_box_conservative_rounding)
+{
+  using ArborX::Details::expand;
+  using ArborX::Details::intersects;
+  using ArborX::Experimental::SinglePrecisionBox;
+  using Box = ArborX::ExperimentalHyperGeometry::Box<3, double>;
+  using Point = ArborX::ExperimentalHyperGeometry::Point<3, double>;
+
+  // Corners that are not representable in single precision must be rounded
+  // outward
+  Box box{{0.1, 0.2, 0.3}, {1.1, 1.2, 1.3}};
+  SinglePrecisionBox<3> sbox(box);
+  for (int d = 0; d < 3; ++d)
+  {
+    BOOST_TEST(sbox.minCorner()[d] <= box.minCorner()[d]);
+    BOOST_TEST(sbox.maxCorner()[d] >= box.maxCorner()[d]);
+    // ~2^-24 relative resolution of single precision
+    BOOST_TEST(box.minCorner()[d] - sbox.minCorner()[d] <= 1e-6);
+    BOOST_TEST(sbox.maxCorner()[d] - box.maxCorner()[d] <= 1e-6);
+  }
+  BOOST_TEST(intersects(box, sbox));
+
+  // Values outside the single-precision range must round to the largest
+  // finite float instead of infinity
+  BOOST_TEST(SinglePrecisionBox<3>::roundDown(1e300) ==
+             std::numeric_limits<float>::max());
+  BOOST_TEST(SinglePrecisionBox<3>::roundUp(-1e300) ==
+             -std::numeric_limits<float>::max());
+
+  // Expansion starting from an empty box stays conservative
+  SinglePrecisionBox<3> expanded;
+  expand(expanded, box);
+  expand(expanded, Point{-0.7, 0., 2.3});
+  BOOST_TEST(expanded.minCorner()[0] <= -0.7);
+  BOOST_TEST(expanded.minCorner()[1] <= 0.);
+  BOOST_TEST(expanded.maxCorner()[2] >= 2.3);
+  BOOST_TEST(intersects(Point{-0.7, 0., 2.3}, expanded));
+  BOOST_TEST(intersects(box, expanded));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(single_precision_bvh, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  using Point = ArborX::ExperimentalHyperGeometry::Point<3, double>;
+
+  ExecutionSpace space;
+
+  int const n = 100;
+  Kokkos::View<Point *, MemorySpace> points(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Testing::points"),
+      n);
+  Kokkos::parallel_for(
+      "Testing::fill_points", Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        points(i) = {(double)i / 10, (double)i / 10, (double)i / 10};
+      });
+
+  // Internal nodes in single precision, leaves in double precision
+  ArborX::BoundingVolumeHierarchy<
+      MemorySpace, ArborX::PairValueIndex<Point>,
+      ArborX::Details::DefaultIndexableGetter,
+      ArborX::Experimental::SinglePrecisionBox<3>>
+      bvh(space, ArborX::Experimental::attach_indices(points));
+  BOOST_TEST(bvh.size() == n);
+
+  Kokkos::View<int *, MemorySpace> counts("Testing::counts", n);
+  bvh.query(
+      space,
+      ArborX::Experimental::attach_indices(
+          ArborX::Experimental::make_intersects(points, 0.05)),
+      KOKKOS_LAMBDA(auto const &predicate, auto const &) {
+        Kokkos::atomic_increment(&counts(ArborX::getData(predicate)));
+      });
+
+  // Each sphere contains exactly its own point; the looser internal boxes
+  // may cause extra node visits but the leaf test against the exact
+  // double-precision point filters out any false positive
+  int errors;
+  Kokkos::parallel_reduce(
+      "Testing::check_counts", Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i, int &update) { update += (counts(i) != 1); },
+      errors);
+  BOOST_TEST(errors == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,110 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_TreeSerialization.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+#include "Search_UnitTestHelpers.hpp"
+
+BOOST_AUTO_TEST_SUITE(TreeSerialization)
+
+namespace tt = boost::test_tools;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(round_trip, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using Tree = ArborX::BVH<typename DeviceType::memory_space>;
+
+  ExecutionSpace space;
+
+  auto const tree = make<Tree>(space, {
+                                          {{{0., 0., 0.}}, {{0., 0., 0.}}},
+                                          {{{1., 1., 1.}}, {{1., 1., 1.}}},
+                                          {{{2., 2., 2.}}, {{2., 2., 2.}}},
+                                          {{{3., 3., 3.}}, {{3., 3., 3.}}},
+                                      });
+
+  std::stringstream buffer;
+  ArborX::Experimental::saveTree(tree, buffer);
+
+  auto const loaded_tree =
+      ArborX::Experimental::loadTree<Tree>(space, buffer);
+  BOOST_TEST(loaded_tree.size() == tree.size());
+
+  auto const queries = makeIntersectsBoxQueries<DeviceType>({
+      {{{2., 2., 2.}}, {{3., 3., 3.}}},
+      {{{0., 0., 0.}}, {{1., 1., 1.}}},
+      {{{5., 5., 5.}}, {{6., 6., 6.}}},
+  });
+
+  ARBORX_TEST_QUERY_TREE(space, loaded_tree, queries,
+                         make_reference_solution<int>({2, 3, 0, 1},
+                                                      {0, 2, 4, 4}));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(round_trip_empty, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using Tree = ArborX::BVH<typename DeviceType::memory_space>;
+
+  ExecutionSpace space;
+
+  std::stringstream buffer;
+  ArborX::Experimental::saveTree(Tree{}, buffer);
+  auto const loaded_tree =
+      ArborX::Experimental::loadTree<Tree>(space, buffer);
+  BOOST_TEST(loaded_tree.empty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(round_trip_direct, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using Tree = ArborX::BVH<typename DeviceType::memory_space>;
+
+  ExecutionSpace space;
+
+  auto const tree = make<Tree>(space, {
+                                          {{{0., 0., 0.}}, {{0., 0., 0.}}},
+                                          {{{1., 1., 1.}}, {{1., 1., 1.}}},
+                                          {{{2., 2., 2.}}, {{2., 2., 2.}}},
+                                          {{{3., 3., 3.}}, {{3., 3., 3.}}},
+                                      });
+
+  // loadTreeDirect goes through GPUDirect Storage when ArborX is configured
+  // with cuFile support and through the regular stream load otherwise; both
+  // paths must reproduce the tree from the same file
+  std::string const filename = "arborx_tst_tree_serialization_direct.bin";
+  ArborX::Experimental::saveTree(tree, filename);
+  auto const loaded_tree =
+      ArborX::Experimental::loadTreeDirect<Tree>(space, filename);
+  std::remove(filename.c_str());
+
+  BOOST_TEST(loaded_tree.size() == tree.size());
+
+  auto const queries = makeIntersectsBoxQueries<DeviceType>({
+      {{{2., 2., 2.}}, {{3., 3., 3.}}},
+      {{{0., 0., 0.}}, {{1., 1., 1.}}},
+      {{{5., 5., 5.}}, {{6., 6., 6.}}},
+  });
+
+  ARBORX_TEST_QUERY_TREE(space, loaded_tree, queries,
+                         make_reference_solution<int>({2, 3, 0, 1},
+                                                      {0, 2, 4, 4}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
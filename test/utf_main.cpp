@@ -23,7 +23,10 @@ struct ExecutionEnvironmentScopeGuard
   ExecutionEnvironmentScopeGuard(int &argc, char *argv[])
   {
 #if defined(ARBORX_MPI_UNIT_TEST)
-    MPI_Init(&argc, &argv);
+    // Ask for the full thread support so that asynchronous queries can be
+    // tested; tests requiring it check the provided level and opt out
+    int provided;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
 #endif
     Kokkos::initialize(argc, argv);
   }